@@ -16,7 +16,13 @@ bool Helium::CommandLine::SimpleOption<T>::Parse( std::vector< std::string >::co
 		std::stringstream str ( arg );
 		str >> *m_Data;
 
-		return str.fail();
+		if ( str.fail() )
+		{
+			error = std::string( TXT("Invalid parameter for option: ") ) + m_Token;
+			return false;
+		}
+
+		return true;
 	}
 				
 	error = std::string( TXT("Missing parameter for option: ") ) + m_Token;
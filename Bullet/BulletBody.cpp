@@ -38,6 +38,15 @@ Helium::BulletBody::BulletBody()
 
 }
 
+/// A body lives in exactly one physics world, so copies start out empty and must be initialized into a world of their
+/// own (i.e. when a world is cloned, see BulletBodyComponent::OnCloned()).
+Helium::BulletBody::BulletBody( const BulletBody &rSource )
+	: m_Body(0),
+	  m_MotionState(0)
+{
+
+}
+
 Helium::BulletBody::~BulletBody()
 {
 	// If this trips, you probably didn't call Destruct. Destruct needs to be called explicitly so that
@@ -27,10 +27,12 @@ namespace Helium
 	{
 	public:
 		BulletBody();
+		BulletBody( const BulletBody &rSource );
 		~BulletBody();
 
 		bool HasBody() { return m_Body != NULL; }
 		btRigidBody *GetBody() { return m_Body; }
+		const btRigidBody *GetBody() const { return m_Body; }
 
 		void Initialize( 
 			BulletWorld &rWorld,
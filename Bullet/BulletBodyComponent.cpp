@@ -86,6 +86,7 @@ void BulletBodyComponent::PopulateMetaType( Reflect::MetaStruct& comp )
 
 void BulletBodyComponent::Finalize( const BulletBodyComponentDefinition &definition )
 {
+	m_Definition = &definition;
 	definition.CacheFlags();
 	BulletWorldComponent *pBulletWorldComponent = GetWorld()->GetComponents().GetFirst<BulletWorldComponent>();
 	HELIUM_ASSERT( pBulletWorldComponent );
@@ -108,6 +109,43 @@ void BulletBodyComponent::Finalize( const BulletBodyComponentDefinition &definit
 	m_TrackPhysicalContactGroupMask = definition.m_TrackPhysicalContactGroupMask;
 }
 
+/// The copy has no body of its own (see BulletBody's copy constructor). The cloned physics world has already been built
+/// by BulletWorldComponent::OnCloned(), so the body is rebuilt in it where the transform says the source body is, and
+/// picks up the source body's motion.
+void BulletBodyComponent::OnCloned( const Components::CloneContext &rContext )
+{
+	m_HasPhysicalContactsComponent = rContext.Remap( m_HasPhysicalContactsComponent.Get() );
+
+	HELIUM_ASSERT( m_Definition );
+	BulletWorldComponent *pBulletWorldComponent = GetWorld()->GetComponents().GetFirst<BulletWorldComponent>();
+	HELIUM_ASSERT( pBulletWorldComponent );
+
+	TransformComponent *pTransform = GetComponentCollection()->GetFirst<TransformComponent>();
+	HELIUM_ASSERT( pTransform );
+
+	m_Body.Initialize(
+		*pBulletWorldComponent->GetBulletWorld(), 
+		m_Definition->m_BodyDefinition, 
+		pTransform ? pTransform->GetPosition() : Simd::Vector3::Zero, 
+		pTransform ? pTransform->GetRotation() : Simd::Quat::IDENTITY);
+
+	if (!m_Body.HasBody())
+	{
+		return;
+	}
+
+	const BulletBodyComponent *pSource = rContext.GetSource( this );
+	HELIUM_ASSERT( pSource );
+	const btRigidBody *pSourceBody = pSource->m_Body.GetBody();
+	if (pSourceBody)
+	{
+		m_Body.GetBody()->setLinearVelocity( pSourceBody->getLinearVelocity() );
+		m_Body.GetBody()->setAngularVelocity( pSourceBody->getAngularVelocity() );
+	}
+
+	m_Body.GetBody()->setUserPointer( this );
+}
+
 BulletBodyComponent::~BulletBodyComponent()
 {
 	if (m_Body.HasBody())
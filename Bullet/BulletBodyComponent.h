@@ -22,6 +22,7 @@ namespace Helium
 		~BulletBodyComponent();
 
 		void Finalize( const BulletBodyComponentDefinition &definition );
+		void OnCloned( const Components::CloneContext &rContext );
 		
 		bool ShouldTrackCollisions() { return m_TrackCollisions; }
 
@@ -42,6 +43,7 @@ namespace Helium
 		};
 
 	private:
+		Helium::StrongPtr< const BulletBodyComponentDefinition > m_Definition;
 		BulletBody m_Body;
 		uint16_t m_AssignedGroups;
 		uint16_t m_TrackPhysicalContactGroupMask;
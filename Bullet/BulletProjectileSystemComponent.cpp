@@ -0,0 +1,377 @@
+#include "BulletPch.h"
+#include "Bullet/BulletProjectileSystemComponent.h"
+#include "Reflect/TranslatorDeduction.h"
+#include "Framework/WorldManager.h"
+#include "Framework/World.h"
+#include "Framework/ComponentQuery.h"
+#include "Bullet/BulletWorld.h"
+#include "Bullet/BulletWorldComponent.h"
+#include "Bullet/BulletBodyComponent.h"
+#include "Bullet/BulletUtilities.h"
+
+using namespace Helium;
+
+namespace
+{
+	// Number of float32 lanes in a SIMD register
+	const uint32_t SIMD_LANE_COUNT = HELIUM_SIMD_SIZE / sizeof( float32_t );
+
+	// Projectiles are swept against the broadphase in batches of this many. Stream capacity is rounded up to a whole
+	// number of batches so integration never needs a scalar tail loop.
+	const uint32_t SWEEP_BATCH_SIZE = 64;
+	HELIUM_COMPILE_ASSERT( SWEEP_BATCH_SIZE % ( HELIUM_SIMD_SIZE / sizeof( float32_t ) ) == 0 );
+
+	const uint32_t STREAM_COUNT = 8;
+
+	// Size of the single block holding every stream for the given capacity
+	size_t GetStreamMemorySize( uint32_t capacity )
+	{
+		const uint32_t streamLength = ( ( capacity + SWEEP_BATCH_SIZE - 1 ) / SWEEP_BATCH_SIZE ) * SWEEP_BATCH_SIZE;
+		return streamLength * sizeof( float32_t ) * STREAM_COUNT;
+	}
+
+	struct BroadphaseOverlapCallback : public btBroadphaseAabbCallback
+	{
+		BroadphaseOverlapCallback( int32_t collisionFilterMask )
+			: m_CollisionFilterMask( collisionFilterMask )
+			, m_bOverlap( false )
+		{
+
+		}
+
+		virtual bool process( const btBroadphaseProxy* proxy )
+		{
+			if ( proxy->m_collisionFilterGroup & m_CollisionFilterMask )
+			{
+				m_bOverlap = true;
+				return false;
+			}
+
+			return true;
+		}
+
+		int32_t m_CollisionFilterMask;
+		bool m_bOverlap;
+	};
+}
+
+HELIUM_DEFINE_CLASS(Helium::BulletProjectileSystemComponentDefinition);
+
+void Helium::BulletProjectileSystemComponentDefinition::PopulateMetaType( Reflect::MetaStruct& comp )
+{
+	comp.AddField(&BulletProjectileSystemComponentDefinition::m_MaxProjectiles, "m_MaxProjectiles");
+	comp.AddField(&BulletProjectileSystemComponentDefinition::m_CollisionFilterMask, "m_CollisionFilterMask");
+}
+
+Helium::BulletProjectileSystemComponentDefinition::BulletProjectileSystemComponentDefinition()
+	: m_MaxProjectiles( 4096 )
+	, m_CollisionFilterMask( btBroadphaseProxy::AllFilter )
+{
+
+}
+
+HELIUM_DEFINE_COMPONENT(Helium::BulletProjectileSystemComponent, 8);
+
+void Helium::BulletProjectileSystemComponent::PopulateMetaType( Reflect::MetaStruct& comp )
+{
+
+}
+
+Helium::BulletProjectileSystemComponent::BulletProjectileSystemComponent()
+	: m_pStreamMemory( NULL )
+	, m_pPositionX( NULL )
+	, m_pPositionY( NULL )
+	, m_pPositionZ( NULL )
+	, m_pVelocityX( NULL )
+	, m_pVelocityY( NULL )
+	, m_pVelocityZ( NULL )
+	, m_pLifetime( NULL )
+	, m_pUserData( NULL )
+	, m_Count( 0 )
+	, m_Capacity( 0 )
+	, m_CollisionFilterMask( btBroadphaseProxy::AllFilter )
+{
+
+}
+
+Helium::BulletProjectileSystemComponent::~BulletProjectileSystemComponent()
+{
+	if ( m_pStreamMemory )
+	{
+		DefaultAllocator().FreeAligned( m_pStreamMemory );
+		m_pStreamMemory = NULL;
+	}
+}
+
+/// Stream memory is not shared with the source, so the copy gets its own block holding the same projectiles.
+Helium::BulletProjectileSystemComponent::BulletProjectileSystemComponent( const BulletProjectileSystemComponent &rSource )
+	: Component( rSource )
+	, m_pStreamMemory( NULL )
+	, m_pPositionX( NULL )
+	, m_pPositionY( NULL )
+	, m_pPositionZ( NULL )
+	, m_pVelocityX( NULL )
+	, m_pVelocityY( NULL )
+	, m_pVelocityZ( NULL )
+	, m_pLifetime( NULL )
+	, m_pUserData( NULL )
+	, m_Count( rSource.m_Count )
+	, m_Capacity( rSource.m_Capacity )
+	, m_CollisionFilterMask( rSource.m_CollisionFilterMask )
+	, m_Hits( rSource.m_Hits )
+{
+	AllocateStreams();
+
+	if ( m_pStreamMemory )
+	{
+		MemoryCopy( m_pStreamMemory, rSource.m_pStreamMemory, GetStreamMemorySize( m_Capacity ) );
+	}
+}
+
+void Helium::BulletProjectileSystemComponent::Initialize( const BulletProjectileSystemComponentDefinition &definition )
+{
+	HELIUM_ASSERT( !m_pStreamMemory );
+
+	m_Capacity = definition.m_MaxProjectiles;
+	m_CollisionFilterMask = definition.m_CollisionFilterMask;
+	m_Count = 0;
+
+	AllocateStreams();
+}
+
+/// Hits of the current frame still point at bodies of the source world.
+void Helium::BulletProjectileSystemComponent::OnCloned( const Components::CloneContext &rContext )
+{
+	for ( size_t i = 0; i < m_Hits.GetSize(); ++i )
+	{
+		m_Hits[ i ].m_pBody = rContext.Remap( m_Hits[ i ].m_pBody );
+	}
+}
+
+void Helium::BulletProjectileSystemComponent::AllocateStreams()
+{
+	HELIUM_ASSERT( !m_pStreamMemory );
+
+	const size_t memorySize = GetStreamMemorySize( m_Capacity );
+	if ( !memorySize )
+	{
+		return;
+	}
+
+	// One block for all streams. Every stream length is a multiple of the batch size, so each one starts aligned.
+	const size_t streamSize = memorySize / STREAM_COUNT;
+	m_pStreamMemory = DefaultAllocator().AllocateAligned( HELIUM_SIMD_ALIGNMENT, memorySize );
+	HELIUM_ASSERT( m_pStreamMemory );
+	MemoryZero( m_pStreamMemory, memorySize );
+
+	uint8_t *pStream = static_cast< uint8_t * >( m_pStreamMemory );
+	m_pPositionX = reinterpret_cast< float32_t * >( pStream );
+	m_pPositionY = reinterpret_cast< float32_t * >( pStream += streamSize );
+	m_pPositionZ = reinterpret_cast< float32_t * >( pStream += streamSize );
+	m_pVelocityX = reinterpret_cast< float32_t * >( pStream += streamSize );
+	m_pVelocityY = reinterpret_cast< float32_t * >( pStream += streamSize );
+	m_pVelocityZ = reinterpret_cast< float32_t * >( pStream += streamSize );
+	m_pLifetime = reinterpret_cast< float32_t * >( pStream += streamSize );
+	m_pUserData = reinterpret_cast< uint32_t * >( pStream += streamSize );
+}
+
+bool Helium::BulletProjectileSystemComponent::Spawn( const Simd::Vector3 &rPosition, const Simd::Vector3 &rVelocity, float32_t lifetime, uint32_t userData )
+{
+	if ( m_Count >= m_Capacity || lifetime <= 0.0f )
+	{
+		return false;
+	}
+
+	const uint32_t index = m_Count++;
+	m_pPositionX[ index ] = rPosition.GetElement( 0 );
+	m_pPositionY[ index ] = rPosition.GetElement( 1 );
+	m_pPositionZ[ index ] = rPosition.GetElement( 2 );
+	m_pVelocityX[ index ] = rVelocity.GetElement( 0 );
+	m_pVelocityY[ index ] = rVelocity.GetElement( 1 );
+	m_pVelocityZ[ index ] = rVelocity.GetElement( 2 );
+	m_pLifetime[ index ] = lifetime;
+	m_pUserData[ index ] = userData;
+
+	return true;
+}
+
+void Helium::BulletProjectileSystemComponent::Clear()
+{
+	if ( m_pStreamMemory )
+	{
+		MemoryZero( m_pStreamMemory, GetStreamMemorySize( m_Capacity ) );
+	}
+
+	m_Count = 0;
+	m_Hits.Resize( 0 );
+}
+
+void Helium::BulletProjectileSystemComponent::Remove( uint32_t index )
+{
+	HELIUM_ASSERT( index < m_Count );
+
+	const uint32_t last = --m_Count;
+	if ( index != last )
+	{
+		m_pPositionX[ index ] = m_pPositionX[ last ];
+		m_pPositionY[ index ] = m_pPositionY[ last ];
+		m_pPositionZ[ index ] = m_pPositionZ[ last ];
+		m_pVelocityX[ index ] = m_pVelocityX[ last ];
+		m_pVelocityY[ index ] = m_pVelocityY[ last ];
+		m_pVelocityZ[ index ] = m_pVelocityZ[ last ];
+		m_pLifetime[ index ] = m_pLifetime[ last ];
+		m_pUserData[ index ] = m_pUserData[ last ];
+	}
+
+	// Unused lanes are still integrated with the rest of their register, so keep them from drifting off forever
+	m_pVelocityX[ last ] = 0.0f;
+	m_pVelocityY[ last ] = 0.0f;
+	m_pVelocityZ[ last ] = 0.0f;
+	m_pLifetime[ last ] = 0.0f;
+}
+
+void Helium::BulletProjectileSystemComponent::Simulate( BulletWorld &rWorld, float32_t dt )
+{
+	m_Hits.Resize( 0 );
+
+	if ( !m_Count )
+	{
+		return;
+	}
+
+	HELIUM_SIMD_ALIGN_PRE float32_t nextX[ SWEEP_BATCH_SIZE ] HELIUM_SIMD_ALIGN_POST;
+	HELIUM_SIMD_ALIGN_PRE float32_t nextY[ SWEEP_BATCH_SIZE ] HELIUM_SIMD_ALIGN_POST;
+	HELIUM_SIMD_ALIGN_PRE float32_t nextZ[ SWEEP_BATCH_SIZE ] HELIUM_SIMD_ALIGN_POST;
+
+	const Simd::Register dtSplat = Simd::SetSplatF32( dt );
+
+	for ( uint32_t batchStart = 0; batchStart < m_Count; batchStart += SWEEP_BATCH_SIZE )
+	{
+		const uint32_t batchEnd = Min( batchStart + SWEEP_BATCH_SIZE, m_Count );
+
+		// Integrate into scratch space first; the sweep needs both the old and the new positions
+		for ( uint32_t lane = 0; lane < SWEEP_BATCH_SIZE; lane += SIMD_LANE_COUNT )
+		{
+			const uint32_t index = batchStart + lane;
+
+			Simd::StoreAligned( nextX + lane, Simd::AddF32( Simd::LoadAligned( m_pPositionX + index ), Simd::MultiplyF32( Simd::LoadAligned( m_pVelocityX + index ), dtSplat ) ) );
+			Simd::StoreAligned( nextY + lane, Simd::AddF32( Simd::LoadAligned( m_pPositionY + index ), Simd::MultiplyF32( Simd::LoadAligned( m_pVelocityY + index ), dtSplat ) ) );
+			Simd::StoreAligned( nextZ + lane, Simd::AddF32( Simd::LoadAligned( m_pPositionZ + index ), Simd::MultiplyF32( Simd::LoadAligned( m_pVelocityZ + index ), dtSplat ) ) );
+			Simd::StoreAligned( m_pLifetime + index, Simd::SubtractF32( Simd::LoadAligned( m_pLifetime + index ), dtSplat ) );
+		}
+
+		SweepBatch( rWorld, batchStart, batchEnd, nextX, nextY, nextZ );
+
+		for ( uint32_t lane = 0; lane < SWEEP_BATCH_SIZE; lane += SIMD_LANE_COUNT )
+		{
+			const uint32_t index = batchStart + lane;
+
+			Simd::StoreAligned( m_pPositionX + index, Simd::LoadAligned( nextX + lane ) );
+			Simd::StoreAligned( m_pPositionY + index, Simd::LoadAligned( nextY + lane ) );
+			Simd::StoreAligned( m_pPositionZ + index, Simd::LoadAligned( nextZ + lane ) );
+		}
+	}
+
+	// Walk backwards so the projectile swapped into a removed slot has always been checked already
+	for ( uint32_t index = m_Count; index-- > 0; )
+	{
+		if ( !( m_pLifetime[ index ] > 0.0f ) )
+		{
+			Remove( index );
+		}
+	}
+}
+
+void Helium::BulletProjectileSystemComponent::SweepBatch(
+	BulletWorld &rWorld,
+	uint32_t start,
+	uint32_t end,
+	float32_t *pNextX,
+	float32_t *pNextY,
+	float32_t *pNextZ )
+{
+	btDynamicsWorld *pDynamicsWorld = rWorld.GetBulletWorld();
+	HELIUM_ASSERT( pDynamicsWorld );
+
+	// Bounds of every segment in the batch
+	btVector3 aabbMin( m_pPositionX[ start ], m_pPositionY[ start ], m_pPositionZ[ start ] );
+	btVector3 aabbMax( aabbMin );
+
+	for ( uint32_t index = start; index < end; ++index )
+	{
+		const uint32_t lane = index - start;
+		aabbMin.setMin( btVector3( m_pPositionX[ index ], m_pPositionY[ index ], m_pPositionZ[ index ] ) );
+		aabbMax.setMax( btVector3( m_pPositionX[ index ], m_pPositionY[ index ], m_pPositionZ[ index ] ) );
+		aabbMin.setMin( btVector3( pNextX[ lane ], pNextY[ lane ], pNextZ[ lane ] ) );
+		aabbMax.setMax( btVector3( pNextX[ lane ], pNextY[ lane ], pNextZ[ lane ] ) );
+	}
+
+	// Most batches are in open space, so one broadphase query usually lets us skip all of the ray casts
+	BroadphaseOverlapCallback overlapCallback( m_CollisionFilterMask );
+	pDynamicsWorld->getBroadphase()->aabbTest( aabbMin, aabbMax, overlapCallback );
+	if ( !overlapCallback.m_bOverlap )
+	{
+		return;
+	}
+
+	for ( uint32_t index = start; index < end; ++index )
+	{
+		if ( !( m_pLifetime[ index ] > 0.0f ) )
+		{
+			continue;
+		}
+
+		const uint32_t lane = index - start;
+		btVector3 from( m_pPositionX[ index ], m_pPositionY[ index ], m_pPositionZ[ index ] );
+		btVector3 to( pNextX[ lane ], pNextY[ lane ], pNextZ[ lane ] );
+
+		btCollisionWorld::ClosestRayResultCallback rayCallback( from, to );
+		rayCallback.m_collisionFilterMask = m_CollisionFilterMask;
+		pDynamicsWorld->rayTest( from, to, rayCallback );
+
+		if ( !rayCallback.hasHit() )
+		{
+			continue;
+		}
+
+		ProjectileHit &rHit = *m_Hits.New();
+		ConvertFromBullet( rayCallback.m_hitPointWorld, rHit.m_Position );
+		ConvertFromBullet( rayCallback.m_hitNormalWorld, rHit.m_Normal );
+		rHit.m_pBody = static_cast< BulletBodyComponent * >( rayCallback.m_collisionObject->getUserPointer() );
+		rHit.m_UserData = m_pUserData[ index ];
+
+		// Stop at the hit and let the compaction pass remove it
+		m_pLifetime[ index ] = 0.0f;
+		pNextX[ lane ] = rayCallback.m_hitPointWorld.x();
+		pNextY[ lane ] = rayCallback.m_hitPointWorld.y();
+		pNextZ[ lane ] = rayCallback.m_hitPointWorld.z();
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+void DoSimulateProjectiles( World *pWorld )
+{
+	BulletWorldComponent *pBulletWorldComponent = pWorld->GetComponents().GetFirst<BulletWorldComponent>();
+	if ( !pBulletWorldComponent || !pBulletWorldComponent->GetBulletWorld() )
+	{
+		return;
+	}
+
+	ComponentManager *pComponentManager = pWorld->GetComponentManager();
+	HELIUM_ASSERT( pComponentManager );
+
+	const float32_t dt = WorldManager::GetStaticInstance().GetFrameDeltaSeconds();
+	for (ComponentIteratorT<BulletProjectileSystemComponent> iter( *pComponentManager ); iter.GetBaseComponent(); iter.Advance())
+	{
+		iter->Simulate( *pBulletWorldComponent->GetBulletWorld(), dt );
+	}
+}
+
+HELIUM_DEFINE_TASK( SimulateProjectiles, (ForEachWorld< DoSimulateProjectiles >), TickTypes::Gameplay )
+
+void SimulateProjectiles::DefineContract( Helium::TaskContract &rContract )
+{
+	rContract.ExecuteAfter<Helium::ProcessPhysics>();
+	rContract.ExecuteBefore<Helium::StandardDependencies::PostPhysicsGameplay>();
+}
@@ -0,0 +1,101 @@
+
+#pragma once
+
+#include "Bullet/Bullet.h"
+#include "Framework/ComponentDefinition.h"
+#include "Framework/TaskScheduler.h"
+#include "Foundation/DynamicArray.h"
+#include "MathSimd/Vector3.h"
+
+namespace Helium
+{
+	class BulletWorld;
+	class BulletBodyComponent;
+	class BulletProjectileSystemComponentDefinition;
+
+	struct ProjectileHit
+	{
+		Simd::Vector3 m_Position;
+		Simd::Vector3 m_Normal;
+		BulletBodyComponent *m_pBody; // May be null if the hit object was not created by a BulletBodyComponent
+		uint32_t m_UserData;
+	};
+
+	// Simulates large numbers of simple projectiles without giving each one an entity or a physics body. Projectile
+	// state is stored as a structure of arrays so integration runs a full SIMD register of projectiles at a time.
+	// Collision is found by sweeping each batch's bounding box through the physics broadphase and only ray casting the
+	// projectiles of batches that could have hit something. Hits are collected for the frame and read by game code
+	// (for example to apply damage) with GetHits().
+	class HELIUM_BULLET_API BulletProjectileSystemComponent : public Component
+	{
+	public:
+		HELIUM_DECLARE_COMPONENT( Helium::BulletProjectileSystemComponent, Helium::Component );
+		static void PopulateMetaType( Reflect::MetaStruct& comp );
+
+		BulletProjectileSystemComponent();
+		BulletProjectileSystemComponent( const BulletProjectileSystemComponent &rSource );
+		~BulletProjectileSystemComponent();
+
+		void Initialize( const BulletProjectileSystemComponentDefinition &definition );
+		void OnCloned( const Components::CloneContext &rContext );
+
+		bool Spawn( const Simd::Vector3 &rPosition, const Simd::Vector3 &rVelocity, float32_t lifetime, uint32_t userData );
+		void Simulate( BulletWorld &rWorld, float32_t dt );
+		void Clear();
+
+		inline uint32_t GetCount() const { return m_Count; }
+		inline uint32_t GetCapacity() const { return m_Capacity; }
+		inline Simd::Vector3 GetPosition( uint32_t index ) const;
+		inline Simd::Vector3 GetVelocity( uint32_t index ) const;
+		inline uint32_t GetUserData( uint32_t index ) const;
+
+		// Hits from the most recent Simulate() call
+		inline const DynamicArray< ProjectileHit > &GetHits() const { return m_Hits; }
+
+	private:
+		void AllocateStreams();
+		void Remove( uint32_t index );
+		void SweepBatch( BulletWorld &rWorld, uint32_t start, uint32_t end, float32_t *pNextX, float32_t *pNextY, float32_t *pNextZ );
+
+		void *m_pStreamMemory;
+		float32_t *m_pPositionX;
+		float32_t *m_pPositionY;
+		float32_t *m_pPositionZ;
+		float32_t *m_pVelocityX;
+		float32_t *m_pVelocityY;
+		float32_t *m_pVelocityZ;
+		float32_t *m_pLifetime;
+		uint32_t *m_pUserData;
+		uint32_t m_Count;
+		uint32_t m_Capacity;
+		int32_t m_CollisionFilterMask;
+
+		DynamicArray< ProjectileHit > m_Hits;
+	};
+
+	class HELIUM_BULLET_API BulletProjectileSystemComponentDefinition : public Helium::ComponentDefinitionHelper<BulletProjectileSystemComponent, BulletProjectileSystemComponentDefinition>
+	{
+		HELIUM_DECLARE_CLASS( Helium::BulletProjectileSystemComponentDefinition, Helium::ComponentDefinition );
+		static void PopulateMetaType( Reflect::MetaStruct& comp );
+
+		BulletProjectileSystemComponentDefinition();
+
+		// Spawns beyond this many live projectiles fail
+		uint32_t m_MaxProjectiles;
+
+		// Bullet collision filter mask used for the ray casts
+		int32_t m_CollisionFilterMask;
+	};
+	typedef StrongPtr<BulletProjectileSystemComponentDefinition> BulletProjectileSystemComponentDefinitionPtr;
+
+	// Moves projectiles and gathers hits. Runs after physics so projectiles see this frame's body positions, and
+	// before damage and rendering so both see this frame's hits and positions.
+	struct HELIUM_BULLET_API SimulateProjectiles : public Helium::TaskDefinition
+	{
+		HELIUM_DECLARE_TASK(SimulateProjectiles)
+
+		virtual void DefineContract(Helium::TaskContract &rContract);
+	};
+}
+
+#include "Bullet/BulletProjectileSystemComponent.inl"
@@ -0,0 +1,21 @@
+
+namespace Helium
+{
+	Simd::Vector3 BulletProjectileSystemComponent::GetPosition( uint32_t index ) const
+	{
+		HELIUM_ASSERT( index < m_Count );
+		return Simd::Vector3( m_pPositionX[ index ], m_pPositionY[ index ], m_pPositionZ[ index ] );
+	}
+
+	Simd::Vector3 BulletProjectileSystemComponent::GetVelocity( uint32_t index ) const
+	{
+		HELIUM_ASSERT( index < m_Count );
+		return Simd::Vector3( m_pVelocityX[ index ], m_pVelocityY[ index ], m_pVelocityZ[ index ] );
+	}
+
+	uint32_t BulletProjectileSystemComponent::GetUserData( uint32_t index ) const
+	{
+		HELIUM_ASSERT( index < m_Count );
+		return m_pUserData[ index ];
+	}
+}
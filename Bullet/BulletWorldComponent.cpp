@@ -34,11 +34,33 @@ Helium::BulletWorldComponent::~BulletWorldComponent()
 	m_World = 0;
 }
 
+/// The physics world can't be shared with the source, so the copy starts without one and builds its own in OnCloned().
+Helium::BulletWorldComponent::BulletWorldComponent( const BulletWorldComponent &rSource )
+	: Component( rSource )
+	, m_Definition( rSource.m_Definition )
+	, m_World(0)
+{
+
+}
+
 void Helium::BulletWorldComponent::Initialize( const BulletWorldComponentDefinition &definition )
+{
+	m_Definition = &definition;
+	CreateBulletWorld();
+}
+
+/// Bodies are added to the new physics world by BulletBodyComponent::OnCloned(), which runs after this.
+void Helium::BulletWorldComponent::OnCloned( const Components::CloneContext &rContext )
+{
+	CreateBulletWorld();
+}
+
+void Helium::BulletWorldComponent::CreateBulletWorld()
 {
 	HELIUM_ASSERT(!m_World);
+	HELIUM_ASSERT(m_Definition);
 	m_World = new BulletWorld();
-	m_World->Initialize(definition.m_WorldDefinition);
+	m_World->Initialize(m_Definition->m_WorldDefinition);
 	m_World->GetBulletWorld()->setWorldUserInfo(this);
 }
 
@@ -15,19 +15,24 @@ namespace Helium
 	{
 	public:
 		BulletWorldComponent();
+		BulletWorldComponent( const BulletWorldComponent &rSource );
 		~BulletWorldComponent();
 
 		HELIUM_DECLARE_COMPONENT( Helium::BulletWorldComponent, Helium::Component );
 		static void PopulateMetaType( Reflect::MetaStruct& comp );
 
 		void Initialize( const BulletWorldComponentDefinition &definition);
+		void OnCloned( const Components::CloneContext &rContext );
 
 		void Simulate(float dt);
 
 		BulletWorld *GetBulletWorld() { return m_World; }
 
 	private:
-		
+		void CreateBulletWorld();
+
+		Helium::StrongPtr< const BulletWorldComponentDefinition > m_Definition;
+
 		// I would love to use an auto_ptr here but microsoft's compiler breaks when I try to do that. 
 		// http://www.youtube.com/watch?v=1ytCEuuW2_A
 		BulletWorld *m_World;
@@ -7,6 +7,38 @@
 
 using namespace Helium;
 
+namespace
+{
+	void RemapEntities( DynamicArray<EntityWPtr> &rEntities, const Components::CloneContext &rContext )
+	{
+		for (size_t i = 0; i < rEntities.GetSize(); ++i)
+		{
+			Entity *pEntity = rEntities[ i ];
+			rEntities[ i ] = rContext.RemapOwner( pEntity );
+		}
+	}
+
+	void RemapEntities( Set<EntityWPtr> &rEntities, const Components::CloneContext &rContext )
+	{
+		DynamicArray<Entity *> sourceEntities;
+		sourceEntities.Reserve( rEntities.GetSize() );
+		for (Set<EntityWPtr>::Iterator iter = rEntities.Begin(); iter != rEntities.End(); ++iter)
+		{
+			Entity *pEntity = *iter;
+			if (pEntity)
+			{
+				sourceEntities.Push( pEntity );
+			}
+		}
+
+		rEntities.Clear();
+		for (size_t i = 0; i < sourceEntities.GetSize(); ++i)
+		{
+			rEntities.Insert( rContext.RemapOwner( sourceEntities[ i ] ) );
+		}
+	}
+}
+
 HELIUM_DEFINE_COMPONENT(Helium::HasPhysicalContactsComponent, 128);
 
 void Helium::HasPhysicalContactsComponent::PopulateMetaType( Reflect::MetaStruct& comp )
@@ -22,3 +54,12 @@ Helium::HasPhysicalContactsComponent::~HasPhysicalContactsComponent()
 	m_BeginFrameTouching.Clear();
 	m_EverTouchedThisFrame.Clear();
 }
+
+void Helium::HasPhysicalContactsComponent::OnCloned( const Components::CloneContext &rContext )
+{
+	RemapEntities( m_BeginTouch, rContext );
+	RemapEntities( m_EndTouch, rContext );
+	RemapEntities( m_BeginFrameTouching, rContext );
+	RemapEntities( m_EndFrameTouching, rContext );
+	RemapEntities( m_EverTouchedThisFrame, rContext );
+}
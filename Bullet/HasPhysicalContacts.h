@@ -22,6 +22,8 @@ namespace Helium
 
 		~HasPhysicalContactsComponent();
 
+		void OnCloned( const Components::CloneContext &rContext );
+
 		// TODO: There's a lot of dynamic allocation here.. maybe there's a clever way we could just have a wad of Entity* or some shorter
 		// handle used as a ringbuffer? BeginFrameTouching, then intermediate ticks, then EndFrameTouching? EndFrameTouching would be 
 		// BeginFrameTouching on next frame.
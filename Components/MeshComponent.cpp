@@ -37,6 +37,17 @@ void MeshComponent::Initialize( const MeshComponentDefinition& definition )
 	}
 }
 
+/// The scene objects of the source belong to the source world's graphics scene, so the clone drops them and attaches
+/// itself to the cloned world's scene on its next update.
+void MeshComponent::OnCloned( const Components::CloneContext &rContext )
+{
+	SetInvalid( m_graphicsSceneObjectId );
+	m_graphicsSceneObjectSubMeshDataIds.Resize( 0 );
+	m_MeshSceneObjectTransformComponent.Reset();
+
+	DeferredReattach();
+}
+
 HELIUM_DEFINE_CLASS(Helium::MeshComponentDefinition);
 
 void MeshComponentDefinition::PopulateMetaType( Reflect::MetaStruct& comp )
@@ -56,6 +67,7 @@ void MeshComponentDefinition::PopulateMetaType( Reflect::MetaStruct& comp )
 /// Constructor.
 MeshComponent::MeshComponent()
 : m_graphicsSceneObjectId( Invalid< size_t >() )
+, m_NeedsReattach( false )
 {
 }
 
@@ -298,6 +310,7 @@ void Helium::MeshComponent::Update( GraphicsScene *pGraphicsScene, TransformComp
 	{
 		Detach(pGraphicsScene);
 		Attach(pGraphicsScene, pTransform);
+		m_NeedsReattach = false;
 	}
 
 	if (pTransform->IsDirty())
@@ -315,6 +328,7 @@ Helium::MeshSceneObjectTransform::MeshSceneObjectTransform()
 }
 
 Helium::MeshSceneObjectTransform::MeshSceneObjectTransform( const MeshSceneObjectTransform &rRhs )
+	: SceneObjectTransform( rRhs )
 {
 	m_TransformComponent = rRhs.m_TransformComponent;
 	m_MeshComponent = rRhs.m_MeshComponent;
@@ -322,6 +336,15 @@ Helium::MeshSceneObjectTransform::MeshSceneObjectTransform( const MeshSceneObjec
 	m_graphicsSceneObjectId = rRhs.m_graphicsSceneObjectId;
 }
 
+/// Transforms only live for one scene update and refer to a scene object of the source world, so the cloned mesh
+/// component allocates a new one once it has reattached (see MeshComponent::OnCloned()).
+void Helium::MeshSceneObjectTransform::OnCloned( const Components::CloneContext &rContext )
+{
+	m_TransformComponent.Reset();
+	m_MeshComponent.Reset();
+	FreeComponentDeferred();
+}
+
 void Helium::MeshSceneObjectTransform::Setup( class TransformComponent *pTransform, class MeshComponent *pMesh, GraphicsSceneObject::EUpdate updateMode, size_t graphicsSceneObjectId )
 {
 	m_TransformComponent = pTransform;
@@ -27,6 +27,7 @@ namespace Helium
 		virtual ~MeshComponent();
 
 		void Initialize( const Helium::MeshComponentDefinition& definition );
+		void OnCloned( const Components::CloneContext &rContext );
 
 		/// @name Entity Registration
 		//@{
@@ -109,6 +110,8 @@ namespace Helium
 
 		HELIUM_DECLARE_COMPONENT( Helium::MeshSceneObjectTransform, SceneObjectTransform );
 
+		void OnCloned( const Components::CloneContext &rContext );
+
 		void Setup(TransformComponent *pTransform, MeshComponent *pMesh, GraphicsSceneObject::EUpdate updateMode, size_t graphicsSceneObjectId);
 		void Update(GraphicsSceneObject::EUpdate updateMode);
 
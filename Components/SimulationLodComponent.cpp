@@ -0,0 +1,177 @@
+#include "ComponentsPch.h"
+#include "Components/SimulationLodComponent.h"
+
+#include "Reflect/TranslatorDeduction.h"
+#include "Platform/Timer.h"
+
+#include "Components/TransformComponent.h"
+#include "Foundation/Numeric.h"
+
+using namespace Helium;
+
+//////////////////////////////////////////////////////////////////////////
+// SimulationLodComponent
+
+HELIUM_DEFINE_COMPONENT(Helium::SimulationLodComponent, 128);
+
+void Helium::SimulationLodComponent::PopulateMetaType( Reflect::MetaStruct& comp )
+{
+
+}
+
+void Helium::SimulationLodComponent::Initialize( const SimulationLodComponentDefinition &definition )
+{
+	SetInvalid( m_LastUpdateTickCount );
+
+	// We start out due. If UpdateSimulationLodTask already ran this frame it won't set a time step for us until the
+	// next one, so assume a single frame has passed rather than handing the first update a zero time step.
+	m_DeltaSeconds = WorldManager::GetStaticInstance().GetFrameDeltaSeconds();
+	m_FullRateDistanceSquared = definition.m_FullRateDistance * definition.m_FullRateDistance;
+	m_Bucket = SimulationLodBuckets::EveryFrame;
+	m_MaxBucket = static_cast< uint8_t >( definition.m_MaxBucket < SimulationLodBuckets::Count ? definition.m_MaxBucket : SimulationLodBuckets::Count - 1 );
+
+	// Spread entities in the same bucket over different frames so they don't all land on the same one. The pool slot
+	// only depends on the allocation history of this world, so the phase is the same every time the world is run.
+	const Components::Pool *pPool = Components::Pool::GetPool( this );
+	m_Phase = static_cast< uint8_t >( pPool->GetComponentIndex( this ) );
+	m_bDue = true;
+}
+
+void Helium::SimulationLodComponent::Advance( uint32_t frameIndex, uint64_t frameTickCount, float32_t closestRelevanceDistanceSquared )
+{
+	const uint32_t frameMask = ( 1u << m_Bucket ) - 1;
+	m_bDue = ( ( frameIndex + m_Phase ) & frameMask ) == 0;
+
+	if ( !m_bDue )
+	{
+		return;
+	}
+
+	if ( IsInvalid( m_LastUpdateTickCount ) )
+	{
+		m_DeltaSeconds = WorldManager::GetStaticInstance().GetFrameDeltaSeconds();
+	}
+	else
+	{
+		m_DeltaSeconds = static_cast< float32_t >(
+			static_cast< float64_t >( frameTickCount - m_LastUpdateTickCount ) * Timer::GetSecondsPerTick() );
+	}
+
+	m_LastUpdateTickCount = frameTickCount;
+
+	// Only move between buckets on frames we are updated, so the time step above always matches the bucket we were in
+	m_Bucket = static_cast< uint8_t >( CalculateBucket( closestRelevanceDistanceSquared ) );
+}
+
+SimulationLodBucket Helium::SimulationLodComponent::CalculateBucket( float32_t distanceSquared ) const
+{
+	float32_t thresholdSquared = m_FullRateDistanceSquared;
+	uint8_t bucket = SimulationLodBuckets::EveryFrame;
+
+	// Each bucket covers twice the distance of the previous one (four times the squared distance)
+	while ( bucket < m_MaxBucket && distanceSquared > thresholdSquared )
+	{
+		thresholdSquared *= 4.0f;
+		++bucket;
+	}
+
+	return static_cast< SimulationLodBucket >( bucket );
+}
+
+//////////////////////////////////////////////////////////////////////////
+// SimulationLodComponentDefinition
+
+HELIUM_DEFINE_CLASS(Helium::SimulationLodComponentDefinition);
+
+void Helium::SimulationLodComponentDefinition::PopulateMetaType( Reflect::MetaStruct& comp )
+{
+	comp.AddField(&SimulationLodComponentDefinition::m_FullRateDistance, "m_FullRateDistance");
+	comp.AddField(&SimulationLodComponentDefinition::m_MaxBucket, "m_MaxBucket");
+}
+
+SimulationLodComponentDefinition::SimulationLodComponentDefinition()
+	: m_FullRateDistance( 50.0f )
+	, m_MaxBucket( SimulationLodBuckets::Every8thFrame )
+{
+
+}
+
+//////////////////////////////////////////////////////////////////////////
+// SimulationLodRelevanceComponent
+
+HELIUM_DEFINE_COMPONENT(Helium::SimulationLodRelevanceComponent, 16);
+
+void Helium::SimulationLodRelevanceComponent::PopulateMetaType( Reflect::MetaStruct& comp )
+{
+
+}
+
+void Helium::SimulationLodRelevanceComponent::Initialize( const SimulationLodRelevanceComponentDefinition &definition )
+{
+
+}
+
+HELIUM_DEFINE_CLASS(Helium::SimulationLodRelevanceComponentDefinition);
+
+void Helium::SimulationLodRelevanceComponentDefinition::PopulateMetaType( Reflect::MetaStruct& comp )
+{
+
+}
+
+//////////////////////////////////////////////////////////////////////////
+// UpdateSimulationLodTask
+
+static DynamicArray< Simd::Vector3 > g_RelevancePoints;
+static uint32_t g_FrameIndex = 0;
+static uint64_t g_FrameTickCount = 0;
+
+void GatherSimulationLodRelevancePoint( SimulationLodRelevanceComponent *pRelevance, TransformComponent *pTransform )
+{
+	g_RelevancePoints.Push( pTransform->GetPosition() );
+}
+
+void AdvanceSimulationLod( SimulationLodComponent *pLod )
+{
+	// With nothing to be relevant to, everything runs at full rate
+	float32_t closestDistanceSquared = 0.0f;
+
+	if ( !g_RelevancePoints.IsEmpty() )
+	{
+		TransformComponent *pTransform = pLod->GetComponentCollection()->GetFirst<TransformComponent>();
+		if ( pTransform )
+		{
+			closestDistanceSquared = NumericLimits<float32_t>::Maximum;
+
+			const Simd::Vector3 &rPosition = pTransform->GetPosition();
+			for ( DynamicArray< Simd::Vector3 >::ConstIterator iter = g_RelevancePoints.Begin(); iter != g_RelevancePoints.End(); ++iter )
+			{
+				float32_t distanceSquared = ( *iter - rPosition ).GetMagnitudeSquared();
+				if ( distanceSquared < closestDistanceSquared )
+				{
+					closestDistanceSquared = distanceSquared;
+				}
+			}
+		}
+	}
+
+	pLod->Advance( g_FrameIndex, g_FrameTickCount, closestDistanceSquared );
+}
+
+void UpdateSimulationLod( World *pWorld )
+{
+	WorldManager &rWorldManager = WorldManager::GetStaticInstance();
+	g_FrameIndex = rWorldManager.GetFrameIndex();
+	g_FrameTickCount = rWorldManager.GetFrameTickCount();
+
+	g_RelevancePoints.Resize( 0 );
+	QueryComponents< SimulationLodRelevanceComponent, TransformComponent, GatherSimulationLodRelevancePoint >( pWorld );
+	QueryComponents< SimulationLodComponent, AdvanceSimulationLod >( pWorld );
+}
+
+void Helium::UpdateSimulationLodTask::DefineContract( TaskContract &rContract )
+{
+	rContract.ExecuteAfter<StandardDependencies::ReceiveInput>();
+	rContract.ExecuteBefore<StandardDependencies::PrePhysicsGameplay>();
+}
+
+HELIUM_DEFINE_TASK( UpdateSimulationLodTask, (ForEachWorld< UpdateSimulationLod >), TickTypes::Gameplay )
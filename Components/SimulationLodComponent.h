@@ -0,0 +1,153 @@
+
+#pragma once
+
+#include "Components/Components.h"
+#include "Framework/ComponentDefinition.h"
+#include "Framework/TaskScheduler.h"
+#include "Framework/World.h"
+#include "Framework/WorldManager.h"
+
+namespace Helium
+{
+	class SimulationLodComponentDefinition;
+	class SimulationLodRelevanceComponentDefinition;
+
+	namespace SimulationLodBuckets
+	{
+		enum SimulationLodBucket
+		{
+			EveryFrame,
+			Every2ndFrame,
+			Every4thFrame,
+			Every8thFrame,
+			Every16thFrame,
+
+			Count
+		};
+	}
+	typedef SimulationLodBuckets::SimulationLodBucket SimulationLodBucket;
+
+	// Controls how often an entity's simulation is updated. The bucket is reassigned from the distance to the nearest
+	// relevance point (players, cameras) whenever the entity is updated, so distant entities update less often and
+	// receive a correspondingly larger time step when they do.
+	class HELIUM_COMPONENTS_API SimulationLodComponent : public Component
+	{
+		HELIUM_DECLARE_COMPONENT( Helium::SimulationLodComponent, Helium::Component );
+		static void PopulateMetaType( Reflect::MetaStruct& comp );
+
+		void Initialize( const SimulationLodComponentDefinition &definition );
+
+		// Called once per frame by UpdateSimulationLodTask
+		void Advance( uint32_t frameIndex, uint64_t frameTickCount, float32_t closestRelevanceDistanceSquared );
+
+		inline bool IsDue() const { return m_bDue; }
+		inline float32_t GetDeltaSeconds() const { return m_DeltaSeconds; }
+		inline SimulationLodBucket GetBucket() const { return static_cast< SimulationLodBucket >( m_Bucket ); }
+
+		SimulationLodBucket CalculateBucket( float32_t distanceSquared ) const;
+
+		uint64_t m_LastUpdateTickCount;
+		float32_t m_DeltaSeconds;
+		float32_t m_FullRateDistanceSquared;
+		uint8_t m_Bucket;
+		uint8_t m_MaxBucket;
+		uint8_t m_Phase;
+		bool m_bDue;
+	};
+
+	class HELIUM_COMPONENTS_API SimulationLodComponentDefinition : public Helium::ComponentDefinitionHelper<SimulationLodComponent, SimulationLodComponentDefinition>
+	{
+		HELIUM_DECLARE_CLASS( Helium::SimulationLodComponentDefinition, Helium::ComponentDefinition );
+		static void PopulateMetaType( Reflect::MetaStruct& comp );
+
+		SimulationLodComponentDefinition();
+
+		// Entities within this distance of a relevance point update every frame. Each bucket after that covers twice
+		// the distance of the previous one.
+		float32_t m_FullRateDistance;
+
+		// Slowest bucket this entity may be placed in (see SimulationLodBuckets)
+		uint32_t m_MaxBucket;
+	};
+	typedef StrongPtr<SimulationLodComponentDefinition> SimulationLodComponentDefinitionPtr;
+
+	// Marks an entity (usually a player avatar or camera) as a point around which simulation runs at full rate.
+	class HELIUM_COMPONENTS_API SimulationLodRelevanceComponent : public Component
+	{
+		HELIUM_DECLARE_COMPONENT( Helium::SimulationLodRelevanceComponent, Helium::Component );
+		static void PopulateMetaType( Reflect::MetaStruct& comp );
+
+		void Initialize( const SimulationLodRelevanceComponentDefinition &definition );
+	};
+
+	class HELIUM_COMPONENTS_API SimulationLodRelevanceComponentDefinition : public Helium::ComponentDefinitionHelper<SimulationLodRelevanceComponent, SimulationLodRelevanceComponentDefinition>
+	{
+		HELIUM_DECLARE_CLASS( Helium::SimulationLodRelevanceComponentDefinition, Helium::ComponentDefinition );
+		static void PopulateMetaType( Reflect::MetaStruct& comp );
+	};
+
+	// Assigns buckets and works out which entities are due this frame. Tasks that use QueryComponentsLod should
+	// ExecuteAfter this task.
+	struct HELIUM_COMPONENTS_API UpdateSimulationLodTask : public TaskDefinition
+	{
+		HELIUM_DECLARE_TASK(UpdateSimulationLodTask)
+		virtual void DefineContract(TaskContract &rContract);
+	};
+
+	// LOD-aware flavors of QueryComponents. Tuples belonging to entities whose bucket is not due this frame are
+	// skipped, and F receives the time elapsed since the entity was last updated rather than the frame delta.
+	// Entities without a SimulationLodComponent are always due.
+	template <class A, void (*F)(A *, float32_t)>
+	inline void QueryComponentsLod( World *pWorld )
+	{
+		ComponentManager *pComponentManager = pWorld->GetComponentManager();
+		HELIUM_ASSERT( pComponentManager );
+
+		const float32_t frameDeltaSeconds = WorldManager::GetStaticInstance().GetFrameDeltaSeconds();
+
+		for (ImplementingComponentIterator<A> iter( *pComponentManager ); iter.GetBaseComponent(); iter.Advance())
+		{
+			SimulationLodComponent *pLod = iter->GetComponentCollection()->template GetFirst<SimulationLodComponent>();
+			if ( !pLod )
+			{
+				F( *iter, frameDeltaSeconds );
+			}
+			else if ( pLod->IsDue() )
+			{
+				F( *iter, pLod->GetDeltaSeconds() );
+			}
+		}
+	}
+
+	template <class A, class B, void (*F)(A *, B *, float32_t)>
+	inline void QueryComponentsLod( World *pWorld )
+	{
+		ComponentManager *pComponentManager = pWorld->GetComponentManager();
+		HELIUM_ASSERT( pComponentManager );
+
+		const float32_t frameDeltaSeconds = WorldManager::GetStaticInstance().GetFrameDeltaSeconds();
+
+		for (ImplementingComponentIterator<A> iter( *pComponentManager ); iter.GetBaseComponent(); iter.Advance())
+		{
+			ComponentCollection *pCollection = iter->GetComponentCollection();
+
+			float32_t deltaSeconds = frameDeltaSeconds;
+			SimulationLodComponent *pLod = pCollection->template GetFirst<SimulationLodComponent>();
+			if ( pLod )
+			{
+				if ( !pLod->IsDue() )
+				{
+					continue;
+				}
+
+				deltaSeconds = pLod->GetDeltaSeconds();
+			}
+
+			B *pB = pCollection->template GetFirst<B>();
+			if ( pB )
+			{
+				F( *iter, pB, deltaSeconds );
+			}
+		}
+	}
+}
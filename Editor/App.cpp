@@ -36,6 +36,8 @@
 #include "Framework/SystemDefinition.h"
 
 #include "PcSupport/AssetPreprocessor.h"
+#include "PcSupport/DerivedDataCache.h"
+#include "PcSupport/CookRecordTable.h"
 #include "PcSupport/ConfigPc.h"
 #include "PcSupport/LooseAssetLoader.h"
 #include "PcSupport/PlatformPreprocessor.h"
@@ -60,6 +62,7 @@
 #include "Editor/Vault/VaultSettings.h"
 
 #include "Editor/Commands/ProfileDumpCommand.h"
+#include "Editor/Commands/CookCommand.h"
 
 #include "Editor/Clipboard/ClipboardDataWrapper.h"
 #include "Editor/Clipboard/ClipboardFileList.h"
@@ -239,7 +242,7 @@ bool App::OnInit()
 	m_InitializerStack.Push( Editor::Initialize,  Editor::Cleanup );
 
 	// Asset loader and preprocessor.
-	HELIUM_VERIFY( LooseAssetLoader::InitializeStaticInstance() );
+	HELIUM_VERIFY( LooseAssetLoader::InitializeStaticInstance( true ) );
 	m_InitializerStack.Push( LooseAssetLoader::DestroyStaticInstance );
 
 	AssetLoader* pAssetLoader = AssetLoader::GetStaticInstance();
@@ -251,6 +254,17 @@ bool App::OnInit()
 	HELIUM_ASSERT( pPlatformPreprocessor );
 	pAssetPreprocessor->SetPlatformPreprocessor( Cache::PLATFORM_PC, pPlatformPreprocessor );
 
+	Helium::FilePath derivedDataPath;
+	if ( FileLocations::GetUserDataDirectory( derivedDataPath ) )
+	{
+		derivedDataPath += TXT( "DerivedDataCache/" );
+		pAssetPreprocessor->SetDerivedDataCache( new DerivedDataCache( String( derivedDataPath.c_str() ) ) );
+	}
+
+	String cookRecordFileName = CacheManager::GetStaticInstance().GetPlatformDataDirectory( Cache::PLATFORM_PC );
+	cookRecordFileName += TXT( "CookRecords.dat" );
+	pAssetPreprocessor->SetCookRecordTable( new CookRecordTable( cookRecordFileName ) );
+
 	m_InitializerStack.Push( AssetPreprocessor::DestroyStaticInstance );
 	m_InitializerStack.Push( ThreadSafeAssetTrackerListener::DestroyStaticInstance );
 	m_InitializerStack.Push( AssetTracker::DestroyStaticInstance );
@@ -621,6 +635,10 @@ int Main( int argc, const char** argv )
 	success &= profileDumpCommand.Initialize( error );
 	success &= processor.RegisterCommand( &profileDumpCommand, error );
 
+	CookCommand cookCommand;
+	success &= cookCommand.Initialize( error );
+	success &= processor.RegisterCommand( &cookCommand, error );
+
 	Helium::CommandLine::HelpCommand helpCommand;
 	helpCommand.SetOwner( &processor );
 	success &= helpCommand.Initialize( error );
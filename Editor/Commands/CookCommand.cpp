@@ -0,0 +1,369 @@
+#include "EditorPch.h"
+#include "CookCommand.h"
+
+#include "Platform/Timer.h"
+
+#include "Foundation/Log.h"
+
+#include "Reflect/Registry.h"
+
+#include "Application/InitializerStack.h"
+
+#include "Engine/FileLocations.h"
+#include "Engine/AsyncLoader.h"
+#include "Engine/AssetLoader.h"
+#include "Engine/CacheManager.h"
+#include "Engine/CachePackageLoader.h"
+#include "Engine/Config.h"
+#include "Engine/Asset.h"
+#include "Engine/PackageLoader.h"
+
+#include "EngineJobs/EngineJobs.h"
+
+#include "GraphicsJobs/GraphicsJobs.h"
+
+#include "Framework/Components.h"
+
+#include "PcSupport/AssetPreprocessor.h"
+#include "PcSupport/DerivedDataCache.h"
+#include "PcSupport/CookRecordTable.h"
+#include "PcSupport/LooseAssetLoader.h"
+
+#include "PreprocessingPc/PcPreprocessor.h"
+
+#include "EditorSupport/EditorSupportPch.h"
+
+#include "Bullet/BulletPch.h"
+#include "ExampleGame/ExampleGamePch.h"
+#include "Components/ComponentsPch.h"
+
+#include <sstream>
+#include <thread>
+
+using namespace Helium;
+using namespace Helium::CommandLine;
+using namespace Helium::Editor;
+
+CookCommand::CookCommand()
+	: Command( TXT( "cook" ), TXT( "[OPTIONS]" ), TXT( "Cache all assets in the project data directory without starting the editor" ) )
+	, m_WorkerCount( 0 )
+	, m_DryRun( false )
+{
+
+}
+
+bool CookCommand::Initialize( std::string& error )
+{
+	bool success = true;
+	success &= AddOption( new SimpleOption< uint32_t >( &m_WorkerCount, TXT( "j|jobs" ), TXT( "<COUNT>" ), TXT( "number of resource preprocessing threads (defaults to one per hardware thread)" ) ), error );
+	success &= AddOption( new FlagOption( &m_DryRun, TXT( "n|dry_run" ), TXT( "list the assets that would be recooked and why, without cooking anything" ) ), error );
+	return success;
+}
+
+static float64_t TicksToMilliseconds( uint64_t ticks )
+{
+	return static_cast< float64_t >( ticks ) * Timer::GetSecondsPerTick() * 1000.0;
+}
+
+bool CookCommand::Process( std::vector< std::string >::const_iterator& argsBegin, const std::vector< std::string >::const_iterator& argsEnd, std::string& error )
+{
+	if ( !ParseOptions( argsBegin, argsEnd, error ) )
+	{
+		return false;
+	}
+
+	size_t workerCount = m_WorkerCount;
+	if ( workerCount == 0 )
+	{
+		workerCount = Max( std::thread::hardware_concurrency(), 1u );
+	}
+
+	uint64_t startTickCount = Timer::GetTickCount();
+
+	ForceLoadBulletDll();
+	ForceLoadComponentsDll();
+	ForceLoadExampleGameDll();
+	ForceLoadEditorSupportDll();
+
+	// Make sure various module-specific heaps are initialized from the main thread before use.
+	InitEngineJobsDefaultHeap();
+	InitGraphicsJobsDefaultHeap();
+
+	InitializerStack initializerStack( true );
+
+	// Register shutdown for general systems.
+	initializerStack.Push( FileLocations::Shutdown );
+	initializerStack.Push( Name::Shutdown );
+	initializerStack.Push( AssetPath::Shutdown );
+
+	// Async I/O.
+	AsyncLoader& asyncLoader = AsyncLoader::GetStaticInstance();
+	HELIUM_VERIFY( asyncLoader.Initialize() );
+	initializerStack.Push( AsyncLoader::DestroyStaticInstance );
+
+	// Asset cache management.
+	FilePath baseDirectory;
+	if ( !FileLocations::GetBaseDirectory( baseDirectory ) )
+	{
+		error = TXT( "Could not get base directory." );
+		return false;
+	}
+
+	HELIUM_VERIFY( CacheManager::InitializeStaticInstance( baseDirectory ) );
+	initializerStack.Push( CacheManager::DestroyStaticInstance );
+
+	initializerStack.Push( Reflect::ObjectRefCountSupport::Shutdown );
+	initializerStack.Push( Asset::Shutdown );
+	initializerStack.Push( AssetType::Shutdown );
+	initializerStack.Push( Reflect::Initialize, Reflect::Cleanup );
+
+	// Asset loader and preprocessor.
+	HELIUM_VERIFY( LooseAssetLoader::InitializeStaticInstance() );
+	initializerStack.Push( LooseAssetLoader::DestroyStaticInstance );
+
+	AssetLoader* pAssetLoader = AssetLoader::GetStaticInstance();
+	HELIUM_ASSERT( pAssetLoader );
+
+	AssetPreprocessor* pAssetPreprocessor = AssetPreprocessor::CreateStaticInstance();
+	HELIUM_ASSERT( pAssetPreprocessor );
+	PlatformPreprocessor* pPlatformPreprocessor = new PcPreprocessor;
+	HELIUM_ASSERT( pPlatformPreprocessor );
+	pAssetPreprocessor->SetPlatformPreprocessor( Cache::PLATFORM_PC, pPlatformPreprocessor );
+
+	Helium::FilePath derivedDataPath;
+	if ( FileLocations::GetUserDataDirectory( derivedDataPath ) )
+	{
+		derivedDataPath += TXT( "DerivedDataCache/" );
+		pAssetPreprocessor->SetDerivedDataCache( new DerivedDataCache( String( derivedDataPath.c_str() ) ) );
+	}
+
+	// Assets are only recooked when the contents of one of the files they were last cooked from have changed.
+	String cookRecordFileName = CacheManager::GetStaticInstance().GetPlatformDataDirectory( Cache::PLATFORM_PC );
+	cookRecordFileName += TXT( "CookRecords.dat" );
+	pAssetPreprocessor->SetCookRecordTable( new CookRecordTable( cookRecordFileName ) );
+	pAssetPreprocessor->SetDryRun( m_DryRun );
+
+	initializerStack.Push( AssetPreprocessor::DestroyStaticInstance );
+
+	Helium::Components::Initialize( NULL );
+	initializerStack.Push( Components::Cleanup );
+
+	// Engine configuration.
+	Config& rConfig = Config::GetStaticInstance();
+	rConfig.BeginLoad();
+	while( !rConfig.TryFinishLoad() )
+	{
+		pAssetLoader->Tick();
+	}
+
+	initializerStack.Push( Config::DestroyStaticInstance );
+
+	pAssetPreprocessor->ResetHandlerStats();
+	uint32_t initialCacheFailureCount = pAssetPreprocessor->GetCacheFailureCount();
+
+	// Resources with handlers that can run concurrently are queued while loading, and preprocessed on the worker pool
+	// once each batch of assets has loaded.  Everything else is preprocessed as it loads, after the asset loader has finished
+	// loading the assets it depends on.
+	pAssetPreprocessor->BeginDeferredPreprocessing();
+
+	size_t loadFailureCount = 0;
+
+	// Find all packages and the assets they contain.  Child packages are appended to the package list as they are
+	// found, so the whole tree is visited.
+	DynamicArray< AssetPath > packagePaths;
+	DynamicArray< AssetPath > assetPaths;
+	pAssetLoader->EnumerateRootPackages( packagePaths );
+	size_t rootPackageCount = packagePaths.GetSize();
+
+	DynamicArray< AssetPath > childPaths;
+	for ( size_t packageIndex = 0; packageIndex < packagePaths.GetSize(); ++packageIndex )
+	{
+		AssetPath packagePath = packagePaths[ packageIndex ];
+
+		AssetPtr spPackage;
+		pAssetLoader->LoadObject( packagePath, spPackage );
+
+		Package* pPackage = Reflect::SafeCast< Package >( spPackage.Get() );
+		if ( !pPackage || !pPackage->GetLoader() )
+		{
+			Log::Error( TXT( "Failed to load package '%s'.\n" ), *packagePath.ToString() );
+			++loadFailureCount;
+			continue;
+		}
+
+		childPaths.Resize( 0 );
+		pPackage->GetLoader()->EnumerateChildren( childPaths );
+
+		for ( size_t childIndex = 0; childIndex < childPaths.GetSize(); ++childIndex )
+		{
+			const AssetPath& rChildPath = childPaths[ childIndex ];
+			if ( rChildPath.IsPackage() )
+			{
+				packagePaths.Push( rChildPath );
+			}
+			else
+			{
+				assetPaths.Push( rChildPath );
+			}
+		}
+	}
+
+	Log::Print(
+		TXT( "%s %" ) PRIuSZ TXT( " assets in %" ) PRIuSZ TXT( " packages...\n" ),
+		m_DryRun ? TXT( "Checking" ) : TXT( "Cooking" ),
+		assetPaths.GetSize(),
+		packagePaths.GetSize() );
+
+	// Load the assets in batches, so the asset loader can work on several at once without every asset in the project
+	// being held in memory at the same time.  Resources queued for preprocessing are flushed after each batch, as they
+	// are held in memory until they have been cached.
+	bool bDeferredSucceeded = true;
+	uint64_t preprocessTicks = 0;
+
+	DynamicArray< size_t > loadIds;
+	for ( size_t batchStart = 0; batchStart < assetPaths.GetSize(); batchStart += LOAD_BATCH_SIZE )
+	{
+		size_t batchEnd = Min( batchStart + LOAD_BATCH_SIZE, assetPaths.GetSize() );
+
+		loadIds.Resize( 0 );
+		for ( size_t assetIndex = batchStart; assetIndex < batchEnd; ++assetIndex )
+		{
+			loadIds.Push( pAssetLoader->BeginLoadObject( assetPaths[ assetIndex ] ) );
+		}
+
+		for ( size_t assetIndex = batchStart; assetIndex < batchEnd; ++assetIndex )
+		{
+			AssetPtr spAsset;
+			size_t loadId = loadIds[ assetIndex - batchStart ];
+			if ( IsValid( loadId ) )
+			{
+				pAssetLoader->FinishLoad( loadId, spAsset );
+			}
+
+			if ( !spAsset || spAsset->GetAnyFlagSet( Asset::FLAG_BROKEN ) )
+			{
+				Log::Error( TXT( "Failed to load asset '%s'.\n" ), *assetPaths[ assetIndex ].ToString() );
+				++loadFailureCount;
+			}
+		}
+
+		uint64_t preprocessStartTickCount = Timer::GetTickCount();
+		if ( !pAssetPreprocessor->FlushDeferredPreprocessing( workerCount ) )
+		{
+			bDeferredSucceeded = false;
+		}
+
+		preprocessTicks += Timer::GetTickCount() - preprocessStartTickCount;
+	}
+
+	// Everything queued was flushed with the last batch, so this only stops deferring preprocessing.
+	if ( !pAssetPreprocessor->EndDeferredPreprocessing( workerCount ) )
+	{
+		bDeferredSucceeded = false;
+	}
+
+	if ( m_DryRun )
+	{
+		DynamicArray< AssetPreprocessor::StaleAsset > staleAssets;
+		pAssetPreprocessor->GetStaleAssets( staleAssets );
+
+		Log::Print( TXT( "\n" ) );
+		for ( size_t staleIndex = 0; staleIndex < staleAssets.GetSize(); ++staleIndex )
+		{
+			const AssetPreprocessor::StaleAsset& rStaleAsset = staleAssets[ staleIndex ];
+			Log::Print( TXT( "  %s: %s\n" ), *rStaleAsset.path.ToString(), *rStaleAsset.reason );
+		}
+
+		Log::Print(
+			TXT( "\n%" ) PRIuSZ TXT( " of %" ) PRIuSZ TXT( " assets would be recooked.\n" ),
+			staleAssets.GetSize(),
+			assetPaths.GetSize() );
+
+		initializerStack.Cleanup();
+
+		if ( loadFailureCount != 0 )
+		{
+			std::stringstream str;
+			str << "Dry run failed: " << loadFailureCount << " load failures.";
+			error = str.str();
+			return false;
+		}
+
+		return true;
+	}
+
+	// Report the time spent by each resource handler.
+	DynamicArray< AssetPreprocessor::HandlerStats > handlerStats;
+	pAssetPreprocessor->GetHandlerStats( handlerStats );
+
+	size_t preprocessFailureCount = 0;
+
+	Log::Print( TXT( "\nResource preprocessing by type (times summed across all threads):\n" ) );
+	Log::Print( TXT( "  %-32s %8s %8s %8s %12s %12s\n" ), TXT( "Type" ), TXT( "Count" ), TXT( "Reused" ), TXT( "Failed" ), TXT( "Total (ms)" ), TXT( "Avg (ms)" ) );
+	for ( size_t statsIndex = 0; statsIndex < handlerStats.GetSize(); ++statsIndex )
+	{
+		const AssetPreprocessor::HandlerStats& rStats = handlerStats[ statsIndex ];
+		float64_t totalMilliseconds = TicksToMilliseconds( rStats.ticks );
+
+		Log::Print(
+			TXT( "  %-32s %8" ) PRIu32 TXT( " %8" ) PRIu32 TXT( " %8" ) PRIu32 TXT( " %12.2f %12.2f\n" ),
+			*rStats.resourceTypeName,
+			rStats.resourceCount,
+			rStats.derivedDataHitCount,
+			rStats.failureCount,
+			totalMilliseconds,
+			rStats.resourceCount != 0 ? totalMilliseconds / static_cast< float64_t >( rStats.resourceCount ) : 0.0 );
+
+		preprocessFailureCount += rStats.failureCount;
+	}
+
+	uint32_t cacheFailureCount = pAssetPreprocessor->GetCacheFailureCount() - initialCacheFailureCount;
+
+	// Write a cooked index for each cache so that runtime builds can skip replaying the TOC journals.
+	if ( !CacheManager::GetStaticInstance().WriteCacheIndices( Cache::PLATFORM_PC ) )
+	{
+		Log::Error( TXT( "Failed to write cooked cache indices.\n" ) );
+		++cacheFailureCount;
+	}
+
+	// Bundle the objects of each root package in load order, so that runtime builds can stream them in with a few
+	// large reads when the package is loaded.  Bundles are only an optimization, so failing to write one is not fatal.
+	CachePackageLoader bundleWriter;
+	if ( bundleWriter.Initialize( Name( TXT( "Asset" ) ) ) )
+	{
+		for ( size_t packageIndex = 0; packageIndex < rootPackageCount; ++packageIndex )
+		{
+			AssetPath packagePath = packagePaths[ packageIndex ];
+			if ( rConfig.IsAssetPathInConfigContainerPackage( packagePath ) )
+			{
+				continue;
+			}
+
+			if ( !bundleWriter.WriteBundle( packagePath, CachePackageLoader::GetBundleName( packagePath ) ) )
+			{
+				Log::Warning( TXT( "Failed to write the bundle for package '%s'.\n" ), *packagePath.ToString() );
+			}
+		}
+
+		bundleWriter.Shutdown();
+	}
+
+	Log::Print(
+		TXT( "\nCooked %" ) PRIuSZ TXT( " assets in %.2f seconds (%.2f seconds of deferred preprocessing on %" ) PRIuSZ TXT( " threads).\n" ),
+		assetPaths.GetSize(),
+		TicksToMilliseconds( Timer::GetTickCount() - startTickCount ) / 1000.0,
+		TicksToMilliseconds( preprocessTicks ) / 1000.0,
+		workerCount );
+
+	initializerStack.Cleanup();
+
+	if ( loadFailureCount != 0 || preprocessFailureCount != 0 || cacheFailureCount != 0 || !bDeferredSucceeded )
+	{
+		std::stringstream str;
+		str << "Cook failed: " << loadFailureCount << " load failures, " << preprocessFailureCount << " preprocessing failures, " << cacheFailureCount << " cache failures.";
+		error = str.str();
+		return false;
+	}
+
+	return true;
+}
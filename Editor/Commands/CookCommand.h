@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Application/CmdLineProcessor.h"
+
+namespace Helium
+{
+    namespace Editor
+    {
+        /// Headless cook of all assets in the project data directory.
+        ///
+        /// Every package found through the loose asset loader is loaded along with its assets, which caches any
+        /// out-of-date assets.  Resources whose handlers support concurrent caching are preprocessed on a pool of
+        /// worker threads once all loads have finished, while the rest are preprocessed on the main thread as they
+        /// load, after the assets they depend on.  A cooked index is written for each cache once cooking is done, along
+        /// with a bundle of the objects in each root package, which is streamed in when the package is loaded.  A
+        /// per-handler timing report is printed at the end, and the command fails if any asset could not be loaded,
+        /// preprocessed, or cached.
+        ///
+        /// Assets are only recooked when the contents of the files they were last cooked from, or the versions of their
+        /// resource handlers, have changed.  With the dry-run option, the assets that would be recooked are listed along
+        /// with the reason for each, and nothing is cooked.
+        class CookCommand : public Helium::CommandLine::Command
+        {
+        public:
+            /// Number of asset loads to have in flight at once.
+            static const size_t LOAD_BATCH_SIZE = 256;
+
+            CookCommand();
+
+            virtual bool Initialize( std::string& error ) HELIUM_OVERRIDE;
+            virtual bool Process( std::vector< std::string >::const_iterator& argsBegin, const std::vector< std::string >::const_iterator& argsEnd, std::string& error ) HELIUM_OVERRIDE;
+
+        private:
+            /// Number of preprocessing worker threads (zero to use one per hardware thread).
+            uint32_t m_WorkerCount;
+            /// True to only list the assets that would be recooked.
+            bool m_DryRun;
+        };
+    }
+}
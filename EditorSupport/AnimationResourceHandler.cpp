@@ -48,6 +48,24 @@ void AnimationResourceHandler::GetSourceExtensions(
     rExtensionCount = HELIUM_ARRAY_COUNT( extensions );
 }
 
+/// @copydoc ResourceHandler::GetCookVersion()
+uint32_t AnimationResourceHandler::GetCookVersion() const
+{
+    return 1;
+}
+
+/// @copydoc ResourceHandler::GetDerivedDataVersion()
+uint32_t AnimationResourceHandler::GetDerivedDataVersion() const
+{
+    return 1;
+}
+
+/// @copydoc ResourceHandler::CanCacheConcurrently()
+bool AnimationResourceHandler::CanCacheConcurrently() const
+{
+    return true;
+}
+
 /// @copydoc ResourceHandler::CacheResource()
 bool AnimationResourceHandler::CacheResource(
     AssetPreprocessor* pAssetPreprocessor,
@@ -311,6 +311,8 @@ bool FbxSupport::LoadMesh(
 						  DynamicArray< uint8_t >& rSkinningPaletteMap,
 						  bool bStripNamespaces )
 {
+	MutexScopeLock scopeLock( m_loadLock );
+
 	LazyInitialize();
 
 #if HELIUM_OS_WIN
@@ -407,6 +409,8 @@ bool FbxSupport::LoadAnimation(
 							   uint_fast32_t& rSamplesPerSecond,
 							   bool bStripNamespaces )
 {
+	MutexScopeLock scopeLock( m_loadLock );
+
 	LazyInitialize();
 
 #if HELIUM_OS_WIN
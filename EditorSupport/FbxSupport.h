@@ -4,6 +4,7 @@
 
 #if HELIUM_TOOLS
 
+#include "Platform/Locks.h"
 #include "MathSimd/Matrix44.h"
 #include "MathSimd/Quat.h"
 #include "GraphicsTypes/VertexTypes.h"
@@ -161,6 +162,8 @@ namespace Helium
         FbxIOSettings* m_pIoSettings;
         /// Import handler.
         FbxImporter* m_pImporter;
+        /// Lock serializing use of the SDK manager and importer by resource handlers running on several threads.
+        Mutex m_loadLock;
 
 #if HELIUM_ENABLE_FBX_MEMORY_ALLOCATOR
         /// Memory allocation handler.
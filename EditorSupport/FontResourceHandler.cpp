@@ -160,6 +160,18 @@ void FontResourceHandler::GetSourceExtensions( const char* const*& rppExtensions
     rExtensionCount = HELIUM_ARRAY_COUNT( extensions );
 }
 
+/// @copydoc ResourceHandler::GetCookVersion()
+uint32_t FontResourceHandler::GetCookVersion() const
+{
+    return 1;
+}
+
+/// @copydoc ResourceHandler::GetDerivedDataVersion()
+uint32_t FontResourceHandler::GetDerivedDataVersion() const
+{
+    return 1;
+}
+
 /// @copydoc ResourceHandler::CacheResource()
 bool FontResourceHandler::CacheResource(
     AssetPreprocessor* pAssetPreprocessor,
@@ -30,6 +30,9 @@ namespace Helium
         virtual const AssetType* GetResourceType() const;
         virtual void GetSourceExtensions( const char* const*& rppExtensions, size_t& rExtensionCount ) const;
 
+        virtual uint32_t GetCookVersion() const;
+        virtual uint32_t GetDerivedDataVersion() const;
+
         virtual bool CacheResource(
             AssetPreprocessor* pAssetPreprocessor, Resource* pResource, const String& rSourceFilePath );
         //@}
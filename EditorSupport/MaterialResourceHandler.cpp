@@ -28,6 +28,12 @@ const AssetType* MaterialResourceHandler::GetResourceType() const
     return Material::GetStaticType();
 }
 
+/// @copydoc ResourceHandler::GetCookVersion()
+uint32_t MaterialResourceHandler::GetCookVersion() const
+{
+    return 1;
+}
+
 /// @copydoc ResourceHandler::CacheResource()
 bool MaterialResourceHandler::CacheResource(
     AssetPreprocessor* pAssetPreprocessor,
@@ -71,6 +77,11 @@ bool MaterialResourceHandler::CacheResource(
     size_t float4ParameterCount = pMaterial->GetFloat4ParameterCount();
 
     Name parameterConstantBufferName = Material::GetParameterConstantBufferName();
+
+    // The material sub-data is built from the compiled shader variants, so the material has to be recooked whenever any
+    // of the files a variant was compiled from change.
+    bool bVariantInputsAdded[ RShader::TYPE_MAX ] = {};
+    DynamicArray< String > variantInputFileNames;
     
     for( size_t platformIndex = 0; platformIndex < static_cast< size_t >( Cache::PLATFORM_MAX ); ++platformIndex )
     {
@@ -121,6 +132,17 @@ bool MaterialResourceHandler::CacheResource(
                     continue;
                 }
 
+                if( !bVariantInputsAdded[ shaderTypeIndex ] )
+                {
+                    bVariantInputsAdded[ shaderTypeIndex ] = true;
+
+                    pAssetPreprocessor->GetResourceInputs( pVariant->GetPath(), variantInputFileNames );
+                    for( size_t inputIndex = 0; inputIndex < variantInputFileNames.GetSize(); ++inputIndex )
+                    {
+                        pAssetPreprocessor->AddResourceInput( pMaterial->GetPath(), variantInputFileNames[ inputIndex ] );
+                    }
+                }
+
                 const Resource::PreprocessedData& rVariantData = pVariant->GetPreprocessedData(
                     static_cast< Cache::EPlatform >( platformIndex ) );
                 HELIUM_ASSERT( rVariantData.bLoaded );
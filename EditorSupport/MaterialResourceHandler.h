@@ -24,6 +24,8 @@ namespace Helium
         //@{
         virtual const AssetType* GetResourceType() const;
 
+        virtual uint32_t GetCookVersion() const;
+
         virtual bool CacheResource(
             AssetPreprocessor* pAssetPreprocessor, Resource* pResource, const String& rSourceFilePath );
         //@}
@@ -43,6 +43,24 @@ void MeshResourceHandler::GetSourceExtensions( const char* const*& rppExtensions
 	rExtensionCount = HELIUM_ARRAY_COUNT( extensions );
 }
 
+/// @copydoc ResourceHandler::GetCookVersion()
+uint32_t MeshResourceHandler::GetCookVersion() const
+{
+	return 1;
+}
+
+/// @copydoc ResourceHandler::GetDerivedDataVersion()
+uint32_t MeshResourceHandler::GetDerivedDataVersion() const
+{
+	return 1;
+}
+
+/// @copydoc ResourceHandler::CanCacheConcurrently()
+bool MeshResourceHandler::CanCacheConcurrently() const
+{
+	return true;
+}
+
 /// @copydoc ResourceHandler::CacheResource()
 bool MeshResourceHandler::CacheResource(
 										AssetPreprocessor* pAssetPreprocessor,
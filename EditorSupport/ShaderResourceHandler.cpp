@@ -43,6 +43,12 @@ void ShaderResourceHandler::GetSourceExtensions(
     rExtensionCount = HELIUM_ARRAY_COUNT( extensions );
 }
 
+/// @copydoc ResourceHandler::GetCookVersion()
+uint32_t ShaderResourceHandler::GetCookVersion() const
+{
+    return 1;
+}
+
 /// @copydoc ResourceHandler::CacheResource()
 bool ShaderResourceHandler::CacheResource(
     AssetPreprocessor* pAssetPreprocessor,
@@ -42,6 +42,12 @@ const AssetType* ShaderVariantResourceHandler::GetResourceType() const
 	return ShaderVariant::GetStaticType();
 }
 
+/// @copydoc ResourceHandler::GetCookVersion()
+uint32_t ShaderVariantResourceHandler::GetCookVersion() const
+{
+	return 1;
+}
+
 /// @copydoc ResourceHandler::CacheResource()
 bool ShaderVariantResourceHandler::CacheResource(
 	AssetPreprocessor* pAssetPreprocessor,
@@ -667,6 +673,8 @@ bool ShaderVariantResourceHandler::CompileShader(
 
 	shaderFilePath += pVariant->GetPath().GetParent().ToFilePathString().GetData();
 
+	DynamicArray< String > includeFileNames;
+
 	bool bCompileResult = pPreprocessor->CompileShader(
 		shaderFilePath,
 		shaderProfileIndex,
@@ -681,7 +689,19 @@ bool ShaderVariantResourceHandler::CompileShader(
 #else
 		, NULL
 #endif
+		, &includeFileNames
 		);
+
+	// Track the included files as inputs of the variant, so that it is recooked when any of them change.
+	AssetPreprocessor* pAssetPreprocessor = AssetPreprocessor::GetStaticInstance();
+	HELIUM_ASSERT( pAssetPreprocessor );
+
+	size_t includeFileCount = includeFileNames.GetSize();
+	for( size_t includeFileIndex = 0; includeFileIndex < includeFileCount; ++includeFileIndex )
+	{
+		pAssetPreprocessor->AddResourceInput( pVariant->GetPath(), includeFileNames[ includeFileIndex ] );
+	}
+
 	if( !bCompileResult )
 	{
 		rCompiledCodeBuffer.Resize( 0 );
@@ -49,6 +49,24 @@ void Texture2dResourceHandler::GetSourceExtensions(
     rExtensionCount = HELIUM_ARRAY_COUNT( extensions );
 }
 
+/// @copydoc ResourceHandler::GetCookVersion()
+uint32_t Texture2dResourceHandler::GetCookVersion() const
+{
+    return 1;
+}
+
+/// @copydoc ResourceHandler::GetDerivedDataVersion()
+uint32_t Texture2dResourceHandler::GetDerivedDataVersion() const
+{
+    return 1;
+}
+
+/// @copydoc ResourceHandler::CanCacheConcurrently()
+bool Texture2dResourceHandler::CanCacheConcurrently() const
+{
+    return true;
+}
+
 /// @copydoc ResourceHandler::CacheResource()
 bool Texture2dResourceHandler::CacheResource(
     AssetPreprocessor* pAssetPreprocessor,
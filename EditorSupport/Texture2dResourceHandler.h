@@ -26,6 +26,10 @@ namespace Helium
         virtual const AssetType* GetResourceType() const;
         virtual void GetSourceExtensions( const char* const*& rppExtensions, size_t& rExtensionCount ) const;
 
+        virtual uint32_t GetCookVersion() const;
+        virtual uint32_t GetDerivedDataVersion() const;
+        virtual bool CanCacheConcurrently() const;
+
         virtual bool CacheResource(
             AssetPreprocessor* pAssetPreprocessor, Resource* pResource, const String& rSourceFilePath );
         //@}
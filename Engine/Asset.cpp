@@ -4,6 +4,7 @@
 #include "Foundation/ObjectPool.h"
 #include "Engine/Asset.h"
 #include "Engine/PackageLoader.h"
+#include "Engine/AtomicLoad.h"
 
 HELIUM_DEFINE_CLASS_NO_REGISTRAR( Helium::Asset )
 
@@ -110,7 +111,8 @@ void AssetAwareThreadSynchronizer::DecrementLockedThreadCount()
 
 //////////////////////////////////////////////////////////////////////////
 
-SparseArray< AssetWPtr > Asset::sm_objects;
+Asset::RegistryShard* volatile Asset::sm_pRegistryShards = NULL;
+Mutex Asset::sm_registryShardsLock;
 AssetWPtr Asset::sm_wpFirstTopLevelObject;
 
 Asset::ChildNameInstanceIndexMap* Asset::sm_pNameInstanceIndexMap = NULL;
@@ -668,7 +670,7 @@ bool Helium::Asset::SaveAsset()
 
 struct AssetFixup
 {
-	Asset *pAsset;
+	AssetWPtr wpAsset;
 };
 
 void Asset::ReplaceAsset( Asset* pNewAsset, const AssetPath &objectToReplace )
@@ -682,17 +684,31 @@ void Asset::ReplaceAsset( Asset* pNewAsset, const AssetPath &objectToReplace )
 	Asset *pOldAsset = Asset::FindObject( objectToReplace );
 	HELIUM_ASSERT( pNewAsset->GetMetaClass()->IsType( pOldAsset->GetMetaClass() ) );
 
-	DynamicArray<AssetFixup> fixups;
-
-	// For every asset in existence
-	for ( SparseArray< AssetWPtr >::Iterator iter = sm_objects.Begin();
-		iter != sm_objects.End(); ++iter)
+	// Gather every asset in existence, releasing each registry shard before walking template chains.  Weak references
+	// are kept so that assets destroyed once the shard locks are released are skipped rather than dereferenced.
+	DynamicArray< AssetWPtr > assets;
+	RegistryShard* pShards = GetRegistryShards();
+	for ( size_t shardIndex = 0; shardIndex < REGISTRY_SHARD_COUNT; ++shardIndex )
 	{
-		if ( !iter )
+		RegistryShard& rShard = pShards[ shardIndex ];
+		RegistryScopeReadLock shardLock( rShard );
+
+		for ( SparseArray< AssetWPtr >::Iterator iter = rShard.objects.Begin();
+			iter != rShard.objects.End(); ++iter)
 		{
-			continue;
+			if ( iter )
+			{
+				assets.Push( *iter );
+			}
 		}
+	}
 
+	DynamicArray<AssetFixup> fixups;
+
+	// For every asset in existence
+	for ( DynamicArray< AssetWPtr >::Iterator iter = assets.Begin();
+		iter != assets.End(); ++iter)
+	{
 		Asset* pPossibleFixupAsset = iter->Get();
 		if ( !pPossibleFixupAsset || pPossibleFixupAsset->IsDefaultTemplate() )
 		{
@@ -716,7 +732,7 @@ void Asset::ReplaceAsset( Asset* pNewAsset, const AssetPath &objectToReplace )
 				// TODO: Does order matter? Right now we probably want bases first so that changes ripple down the template
 				// tree but in future we should probably have a flag of some sort to say if a field is set or not. Maybe in tools only.
 				AssetFixup &fixup = *fixups.New();
-				fixup.pAsset = pPossibleFixupAsset;
+				fixup.wpAsset = pPossibleFixupAsset;
 				break;
 			}
 
@@ -739,7 +755,11 @@ void Asset::ReplaceAsset( Asset* pNewAsset, const AssetPath &objectToReplace )
 		iter != fixups.End(); ++iter)
 	{
 		// Get the template (old) asset's type
-		Asset *pAsset = iter->pAsset;
+		Asset *pAsset = iter->wpAsset.Get();
+		if ( !pAsset )
+		{
+			continue;
+		}
 
 		// Get all the fields that should be modified due to the base template changing
 		// TODO: Declare a max count for fields to save heap allocs -geoff
@@ -1005,42 +1025,18 @@ Asset* Asset::FindObject( AssetPath path )
 		return NULL;
 	}
 
-	// Assemble a list of object names and instance indices, from the top level on down.
-	size_t pathDepth = 0;
-	size_t packageDepth = 0;
-	for( AssetPath testPath = path; !testPath.IsEmpty(); testPath = testPath.GetParent() )
-	{
-		++pathDepth;
+	// Named objects are indexed by path in the registry shard selected by the path hash, so only that shard needs to
+	// be locked for the lookup.
+	RegistryShard& rShard = GetRegistryShards()[ GetPathShardIndex( path ) ];
+	RegistryScopeReadLock scopeLock( rShard );
 
-		if( testPath.IsPackage() )
-		{
-			++packageDepth;
-		}
-	}
-
-	StackMemoryHeap<>& rStackHeap = ThreadLocalStackAllocator::GetMemoryHeap();
-	StackMemoryHeap<>::Marker stackMarker( rStackHeap );
-
-	Name* pPathNames = static_cast< Name* >( rStackHeap.Allocate( sizeof( Name ) * pathDepth ) );
-	HELIUM_ASSERT( pPathNames );
-
-	uint32_t* pInstanceIndices = static_cast< uint32_t* >( rStackHeap.Allocate( sizeof( uint32_t ) * pathDepth ) );
-	HELIUM_ASSERT( pInstanceIndices );
-
-	size_t pathIndex = pathDepth;
-	for( AssetPath testPath = path; !testPath.IsEmpty(); testPath = testPath.GetParent() )
+	PathMap::Iterator pathIterator = rShard.pathMap.Find( path );
+	if( pathIterator == rShard.pathMap.End() )
 	{
-		HELIUM_ASSERT( pathIndex != 0 );
-		--pathIndex;
-
-		pPathNames[ pathIndex ] = testPath.GetName();
-		pInstanceIndices[ pathIndex ] = testPath.GetInstanceIndex();
+		return NULL;
 	}
 
-	HELIUM_ASSERT( pathIndex == 0 );
-
-	// Search from the root.
-	return FindChildOf( NULL, pPathNames, pInstanceIndices, pathDepth, packageDepth );
+	return pathIterator->Second().Get();
 }
 
 /// Search for a direct child of the specified object with the given name.
@@ -1151,13 +1147,15 @@ bool Asset::RegisterObject( Asset* pObject )
 {
 	HELIUM_ASSERT( pObject );
 
-	ScopeWriteLock scopeLock( sm_objectListLock );
-
 	// Check if the object has already been registered.
 	if( IsValid( pObject->m_id ) )
 	{
-		HELIUM_ASSERT( sm_objects.IsElementValid( pObject->m_id ) );
-		HELIUM_ASSERT( sm_objects[ pObject->m_id ].Get() == pObject );
+#if HELIUM_ASSERT_ENABLED
+		RegistryShard& rShard = GetRegistryShards()[ pObject->m_id & ( REGISTRY_SHARD_COUNT - 1 ) ];
+		RegistryScopeReadLock scopeLock( rShard );
+		HELIUM_ASSERT( rShard.objects.IsElementValid( pObject->m_id / REGISTRY_SHARD_COUNT ) );
+		HELIUM_ASSERT( rShard.objects[ pObject->m_id / REGISTRY_SHARD_COUNT ].Get() == pObject );
+#endif
 
 		HELIUM_TRACE(
 			TraceLevels::Warning,
@@ -1171,8 +1169,12 @@ bool Asset::RegisterObject( Asset* pObject )
 	HELIUM_ASSERT( !pObject->m_spOwner );
 	HELIUM_ASSERT( IsInvalid( pObject->m_instanceIndex ) );
 
-	// Register the object.
-	size_t objectId = sm_objects.Add( AssetWPtr( pObject ) );
+	// Register the object, interleaving object IDs across shards so that the shard can be found from the ID alone.
+	size_t shardIndex = GetObjectShardIndex( pObject );
+	RegistryShard& rShard = GetRegistryShards()[ shardIndex ];
+	RegistryScopeWriteLock scopeLock( rShard );
+
+	size_t objectId = rShard.objects.Add( AssetWPtr( pObject ) ) * REGISTRY_SHARD_COUNT + shardIndex;
 	HELIUM_ASSERT( objectId < UINT32_MAX );
 
 	pObject->m_id = static_cast< uint32_t >( objectId );
@@ -1189,8 +1191,6 @@ void Asset::UnregisterObject( Asset* pObject )
 {
 	HELIUM_ASSERT( pObject );
 
-	ScopeWriteLock scopeLock( sm_objectListLock );
-
 	// Check if the object has already been unregistered.
 	uint32_t objectId = pObject->m_id;
 	if( IsInvalid( objectId ) )
@@ -1203,17 +1203,21 @@ void Asset::UnregisterObject( Asset* pObject )
 		return;
 	}
 
-	if ( sm_objects.GetSize() ) // will be empty if already shutdown
+	if ( sm_pRegistryShards ) // will be null if already shutdown
 	{
-		HELIUM_ASSERT( sm_objects.IsElementValid( objectId ) );
-		HELIUM_ASSERT( sm_objects[ objectId ].HasObjectProxy( pObject ) );
+		RegistryShard& rShard = sm_pRegistryShards[ objectId & ( REGISTRY_SHARD_COUNT - 1 ) ];
+		RegistryScopeWriteLock scopeLock( rShard );
+
+		size_t shardObjectIndex = objectId / REGISTRY_SHARD_COUNT;
+		HELIUM_ASSERT( rShard.objects.IsElementValid( shardObjectIndex ) );
+		HELIUM_ASSERT( rShard.objects[ shardObjectIndex ].HasObjectProxy( pObject ) );
 
 		HELIUM_ASSERT( pObject->m_name.IsEmpty() );
 		HELIUM_ASSERT( !pObject->m_spOwner );
 		HELIUM_ASSERT( IsInvalid( pObject->m_instanceIndex ) );
 
-		// Remove the object from the global list.
-		sm_objects.Remove( objectId );
+		// Remove the object from its registry shard.
+		rShard.objects.Remove( shardObjectIndex );
 	}
 
 	SetInvalid( pObject->m_id );
@@ -1230,7 +1234,10 @@ void Asset::Shutdown()
 	HELIUM_TRACE( TraceLevels::Info, TXT( "Shutting down Asset system.\n" ) );
 	
 #if !HELIUM_RELEASE
-	size_t objectCountActual = sm_objects.GetUsedSize();
+	RegistryStats registryStats;
+	GetRegistryStats( registryStats );
+
+	size_t objectCountActual = registryStats.objectCount;
 	if( objectCountActual != 0 )
 	{
 		HELIUM_TRACE(
@@ -1238,39 +1245,45 @@ void Asset::Shutdown()
 			TXT( "%" ) PRIuSZ TXT( " asset(s) still referenced during shutdown!\n" ),
 			objectCountActual );
 
-		size_t objectCount = sm_objects.GetSize();
-		for( size_t objectIndex = 0; objectIndex < objectCount; ++objectIndex )
+		for( size_t shardIndex = 0; shardIndex < REGISTRY_SHARD_COUNT; ++shardIndex )
 		{
-			if( !sm_objects.IsElementValid( objectIndex ) )
+			const SparseArray< AssetWPtr >& rObjects = sm_pRegistryShards[ shardIndex ].objects;
+			size_t objectCount = rObjects.GetSize();
+			for( size_t objectIndex = 0; objectIndex < objectCount; ++objectIndex )
 			{
-				continue;
-			}
+				if( !rObjects.IsElementValid( objectIndex ) )
+				{
+					continue;
+				}
 
-			Asset* pObject = sm_objects[ objectIndex ];
-			if( !pObject )
-			{
-				continue;
-			}
-			
+				Asset* pObject = rObjects[ objectIndex ];
+				if( !pObject )
+				{
+					continue;
+				}
+				
 #if HELIUM_ENABLE_MEMORY_TRACKING
-			Helium::RefCountProxy<Reflect::Object> *pProxy = pObject->GetRefCountProxy();
-			HELIUM_ASSERT(pProxy);
-
-			HELIUM_TRACE(
-					TraceLevels::Error,
-					TXT( "   - 0x%p: %s (%" ) PRIu16 TXT( " strong ref(s), %" ) PRIu16 TXT( " weak ref(s))\n" ),
-					 pProxy,
-					( pObject ? *pObject->GetPath().ToString() : TXT( "(cleared reference)" ) ),
-					pProxy->GetStrongRefCount(),
-					pProxy->GetWeakRefCount() );
+				Helium::RefCountProxy<Reflect::Object> *pProxy = pObject->GetRefCountProxy();
+				HELIUM_ASSERT(pProxy);
+
+				HELIUM_TRACE(
+						TraceLevels::Error,
+						TXT( "   - 0x%p: %s (%" ) PRIu16 TXT( " strong ref(s), %" ) PRIu16 TXT( " weak ref(s))\n" ),
+						 pProxy,
+						( pObject ? *pObject->GetPath().ToString() : TXT( "(cleared reference)" ) ),
+						pProxy->GetStrongRefCount(),
+						pProxy->GetWeakRefCount() );
 #else
-			HELIUM_TRACE( TraceLevels::Error, TXT( "- %s\n" ), *pObject->GetPath().ToString() );
+				HELIUM_TRACE( TraceLevels::Error, TXT( "- %s\n" ), *pObject->GetPath().ToString() );
 #endif
+			}
 		}
 	}
 #endif  // !HELIUM_RELEASE
 
-	sm_objects.Clear();
+	delete [] sm_pRegistryShards;
+	sm_pRegistryShards = NULL;
+
 	sm_wpFirstTopLevelObject.Release();
 
 	delete sm_pNameInstanceIndexMap;
@@ -1285,6 +1298,64 @@ void Asset::Shutdown()
 	sm_serializationBuffer.Clear();
 }
 
+/// Get statistics for the global object registry.
+///
+/// Lock counters are gathered without synchronization, so they may be slightly out of date if other threads are
+/// accessing the registry at the same time.
+///
+/// @param[out] rStats  Registry statistics.
+///
+/// @see ResetRegistryStats()
+void Asset::GetRegistryStats( RegistryStats& rStats )
+{
+	MemoryZero( &rStats, sizeof( rStats ) );
+	rStats.shardCount = REGISTRY_SHARD_COUNT;
+
+	if( !sm_pRegistryShards )
+	{
+		return;
+	}
+
+	for( size_t shardIndex = 0; shardIndex < REGISTRY_SHARD_COUNT; ++shardIndex )
+	{
+		RegistryShard& rShard = sm_pRegistryShards[ shardIndex ];
+
+		// Read the lock counters before locking the shard so that gathering statistics doesn't count itself.
+		rStats.readLockCount += static_cast< uint32_t >( rShard.readLockCount );
+		rStats.contendedReadLockCount += static_cast< uint32_t >( rShard.contendedReadLockCount );
+		rStats.writeLockCount += static_cast< uint32_t >( rShard.writeLockCount );
+		rStats.contendedWriteLockCount += static_cast< uint32_t >( rShard.contendedWriteLockCount );
+
+		ScopeReadLock scopeLock( rShard.lock );
+
+		rStats.objectCount += rShard.objects.GetUsedSize();
+
+		size_t pathCount = rShard.pathMap.GetSize();
+		rStats.pathCount += pathCount;
+		rStats.pathCountMax = Max( rStats.pathCountMax, pathCount );
+	}
+}
+
+/// Reset the lock counters of the global object registry.
+///
+/// @see GetRegistryStats()
+void Asset::ResetRegistryStats()
+{
+	if( !sm_pRegistryShards )
+	{
+		return;
+	}
+
+	for( size_t shardIndex = 0; shardIndex < REGISTRY_SHARD_COUNT; ++shardIndex )
+	{
+		RegistryShard& rShard = sm_pRegistryShards[ shardIndex ];
+		AtomicExchangeRelease( rShard.readLockCount, 0 );
+		AtomicExchangeRelease( rShard.contendedReadLockCount, 0 );
+		AtomicExchangeRelease( rShard.writeLockCount, 0 );
+		AtomicExchangeRelease( rShard.contendedWriteLockCount, 0 );
+	}
+}
+
 /// Initialize the static type information for the "Asset" class.
 ///
 /// @return  Static "Asset" type.
@@ -1383,6 +1454,8 @@ void Asset::SetCustomDestroyCallback( CUSTOM_DESTROY_CALLBACK* pDestroyCallback
 /// This should be called whenever the name of this object or one of its parents changes.
 void Asset::UpdatePath()
 {
+	AssetPath oldPath = m_path;
+
 	// Update this object's path first.
 	HELIUM_VERIFY( m_path.Set(
 		m_name,
@@ -1390,6 +1463,35 @@ void Asset::UpdatePath()
 		( m_spOwner ? m_spOwner->m_path : AssetPath( NULL_NAME ) ),
 		m_instanceIndex ) );
 
+	// Move this object's entry in the path lookup.  Paths are unique, but only remove the old entry if it still refers
+	// to this object in case another object has already taken over the path.
+	if( m_path != oldPath )
+	{
+		if( !oldPath.IsEmpty() && sm_pRegistryShards )
+		{
+			RegistryShard& rShard = sm_pRegistryShards[ GetPathShardIndex( oldPath ) ];
+			RegistryScopeWriteLock scopeLock( rShard );
+
+			PathMap::Iterator pathIterator = rShard.pathMap.Find( oldPath );
+			if( pathIterator != rShard.pathMap.End() && pathIterator->Second().HasObjectProxy( this ) )
+			{
+				rShard.pathMap.Remove( pathIterator );
+			}
+		}
+
+		if( !m_path.IsEmpty() )
+		{
+			RegistryShard& rShard = GetRegistryShards()[ GetPathShardIndex( m_path ) ];
+			RegistryScopeWriteLock scopeLock( rShard );
+
+			PathMap::Iterator pathIterator;
+			if( !rShard.pathMap.Insert( pathIterator, KeyValue< AssetPath, AssetWPtr >( m_path, AssetWPtr( this ) ) ) )
+			{
+				pathIterator->Second() = this;
+			}
+		}
+	}
+
 	// Update the path of each child object.
 	for( Asset* pChild = m_wpFirstChild; pChild != NULL; pChild = pChild->m_wpNextSibling )
 	{
@@ -1434,6 +1536,98 @@ Asset::ChildNameInstanceIndexMap& Asset::GetNameInstanceIndexMap()
 	return *sm_pNameInstanceIndexMap;
 }
 
+/// Get the global object registry shards, creating them if necessary.
+///
+/// As with the name instance lookup map, the shards are constructed dynamically so that their hash tables can be
+/// destroyed during shutdown.  Creation is guarded by a once-lock, as the first objects may be registered
+/// concurrently from loader worker threads.
+///
+/// @return  Array of REGISTRY_SHARD_COUNT registry shards.
+Asset::RegistryShard* Asset::GetRegistryShards()
+{
+	RegistryShard* pShards = AtomicLoadAcquire( sm_pRegistryShards );
+	if( pShards )
+	{
+		return pShards;
+	}
+
+	MutexScopeLock scopeLock( sm_registryShardsLock );
+
+	pShards = sm_pRegistryShards;
+	if( !pShards )
+	{
+		pShards = new RegistryShard [ REGISTRY_SHARD_COUNT ];
+		HELIUM_ASSERT( pShards );
+
+		for( size_t shardIndex = 0; shardIndex < REGISTRY_SHARD_COUNT; ++shardIndex )
+		{
+			RegistryShard& rShard = pShards[ shardIndex ];
+			rShard.readerCount = 0;
+			rShard.writerCount = 0;
+			rShard.readLockCount = 0;
+			rShard.contendedReadLockCount = 0;
+			rShard.writeLockCount = 0;
+			rShard.contendedWriteLockCount = 0;
+		}
+
+		// Publish the shards only once they are fully initialized.
+		AtomicExchangeRelease( sm_pRegistryShards, pShards );
+	}
+
+	return pShards;
+}
+
+/// Constructor.
+///
+/// A read lock acquisition is counted as contended if any thread holds or is waiting on a write lock.
+///
+/// @param[in] rShard  Registry shard to lock for reading.
+Asset::RegistryScopeReadLock::RegistryScopeReadLock( RegistryShard& rShard )
+	: m_rShard( rShard )
+{
+	AtomicIncrement( m_rShard.readerCount );
+	AtomicIncrement( m_rShard.readLockCount );
+	if( m_rShard.writerCount != 0 )
+	{
+		AtomicIncrement( m_rShard.contendedReadLockCount );
+	}
+
+	m_rShard.lock.LockRead();
+}
+
+/// Destructor.
+Asset::RegistryScopeReadLock::~RegistryScopeReadLock()
+{
+	m_rShard.lock.UnlockRead();
+	AtomicDecrement( m_rShard.readerCount );
+}
+
+/// Constructor.
+///
+/// A write lock acquisition is counted as contended if any other thread holds or is waiting on either a read or a
+/// write lock.
+///
+/// @param[in] rShard  Registry shard to lock for writing.
+Asset::RegistryScopeWriteLock::RegistryScopeWriteLock( RegistryShard& rShard )
+	: m_rShard( rShard )
+{
+	int32_t writerCount = AtomicIncrement( m_rShard.writerCount );
+	AtomicIncrement( m_rShard.writeLockCount );
+	if( writerCount > 1 || m_rShard.readerCount != 0 )
+	{
+		AtomicIncrement( m_rShard.contendedWriteLockCount );
+	}
+
+	m_rShard.lock.LockWrite();
+}
+
+/// Destructor.
+Asset::RegistryScopeWriteLock::~RegistryScopeWriteLock()
+{
+	m_rShard.lock.UnlockWrite();
+	AtomicDecrement( m_rShard.writerCount );
+}
+
 AssetRegistrar< Asset, void > Asset::s_Registrar(TXT("Helium::Asset"));
 
 
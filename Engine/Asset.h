@@ -195,6 +195,31 @@ namespace Helium
 		/// Reserved instance index value for auto-assigning an instance index during Rename() calls.
 		static const uint32_t INSTANCE_INDEX_AUTO = static_cast< uint32_t >( -2 );
 
+		/// Number of independently locked shards the global object registry is split into (must be a power of two).
+		static const size_t REGISTRY_SHARD_COUNT = 16;
+
+		/// Global object registry statistics, summed over all registry shards.
+		struct RegistryStats
+		{
+			/// Number of registry shards.
+			size_t shardCount;
+			/// Number of registered objects.
+			size_t objectCount;
+			/// Number of objects in the path lookup.
+			size_t pathCount;
+			/// Largest number of objects in the path lookup of a single shard.
+			size_t pathCountMax;
+
+			/// Number of shard read lock acquisitions.
+			uint64_t readLockCount;
+			/// Number of shard read lock acquisitions made while a writer held or was waiting on the lock.
+			uint64_t contendedReadLockCount;
+			/// Number of shard write lock acquisitions.
+			uint64_t writeLockCount;
+			/// Number of shard write lock acquisitions made while another thread held or was waiting on the lock.
+			uint64_t contendedWriteLockCount;
+		};
+
 		/// Object flags.
 		enum EFlag
 		{
@@ -351,6 +376,12 @@ namespace Helium
 		static void Shutdown();
 		//@}
 
+		/// @name Registry Statistics
+		//@{
+		static void GetRegistryStats( RegistryStats& rStats );
+		static void ResetRegistryStats();
+		//@}
+
 		/// @name Static Interface
 		//@{
 		static const AssetType* InitStaticType();
@@ -375,6 +406,63 @@ namespace Helium
 		typedef ConcurrentHashMap< Name, InstanceIndexSet > NameInstanceIndexMap;
 		/// Child object name instance lookup map type.
 		typedef ConcurrentHashMap< AssetPath, NameInstanceIndexMap > ChildNameInstanceIndexMap;
+		/// Object path lookup map type.
+		typedef HashMap< AssetPath, AssetWPtr > PathMap;
+
+		/// Global object registry shard.
+		struct RegistryShard
+		{
+			/// Objects registered with this shard (object IDs are interleaved across shards).
+			SparseArray< AssetWPtr > objects;
+			/// Named objects whose paths hash to this shard.
+			PathMap pathMap;
+
+			/// Read-write lock for synchronizing access to this shard.
+			ReadWriteLock lock;
+
+			/// Number of threads holding or waiting on a read lock.
+			volatile int32_t readerCount;
+			/// Number of threads holding or waiting on a write lock.
+			volatile int32_t writerCount;
+
+			/// @name Lock Statistics
+			//@{
+			volatile int32_t readLockCount;
+			volatile int32_t contendedReadLockCount;
+			volatile int32_t writeLockCount;
+			volatile int32_t contendedWriteLockCount;
+			//@}
+		};
+
+		/// Scoped registry shard read lock, counting contention.
+		class RegistryScopeReadLock : NonCopyable
+		{
+		public:
+			/// @name Construction/Destruction
+			//@{
+			explicit RegistryScopeReadLock( RegistryShard& rShard );
+			~RegistryScopeReadLock();
+			//@}
+
+		private:
+			/// Locked shard.
+			RegistryShard& m_rShard;
+		};
+
+		/// Scoped registry shard write lock, counting contention.
+		class RegistryScopeWriteLock : NonCopyable
+		{
+		public:
+			/// @name Construction/Destruction
+			//@{
+			explicit RegistryScopeWriteLock( RegistryShard& rShard );
+			~RegistryScopeWriteLock();
+			//@}
+
+		private:
+			/// Locked shard.
+			RegistryShard& m_rShard;
+		};
 
 		/// Object name.
 		Name m_name;
@@ -401,8 +489,10 @@ namespace Helium
 		/// (provided for custom object allocation schemes).
 		CUSTOM_DESTROY_CALLBACK* m_pCustomDestroyCallback;
 
-		/// Global object list.
-		static SparseArray< AssetWPtr > sm_objects;
+		/// Global object registry shards.
+		static RegistryShard* volatile sm_pRegistryShards;
+		/// Mutex guarding creation of the global object registry shards.
+		static Mutex sm_registryShardsLock;
 		/// First object in the list of top-level objects.
 		static AssetWPtr sm_wpFirstTopLevelObject;
 
@@ -413,7 +503,7 @@ namespace Helium
 		/// Empty name instance index lookup set.
 		static Pair< Name, InstanceIndexSet >* sm_pEmptyInstanceIndexSet;
 
-		/// Read-write lock for synchronizing access to the object lists.
+		/// Read-write lock for synchronizing changes to the object hierarchy (child object lists and object paths).
 		static ReadWriteLock sm_objectListLock;
 
 		/// Cached serialization buffer.
@@ -432,6 +522,10 @@ namespace Helium
 		/// @name Static Asset Management
 		//@{
 		static ChildNameInstanceIndexMap& GetNameInstanceIndexMap();
+
+		static RegistryShard* GetRegistryShards();
+		inline static size_t GetPathShardIndex( AssetPath path );
+		inline static size_t GetObjectShardIndex( const Asset* pObject );
 		//@}
 	};
 
@@ -103,6 +103,8 @@ uint32_t Helium::Asset::GetInstanceIndex() const
 
 /// Get the unique ID for this object.
 ///
+/// Object IDs are interleaved across the global object registry shards, so they are not necessarily contiguous.
+///
 /// @return  Object ID.
 uint32_t Helium::Asset::GetId() const
 {
@@ -296,6 +298,32 @@ T* Helium::Asset::Find( AssetPath path )
 	return static_cast< T* >( pObject );
 }
 
+/// Get the index of the registry shard holding the path lookup entry for an object path.
+///
+/// @param[in] path  Object path.
+///
+/// @return  Registry shard index.
+size_t Helium::Asset::GetPathShardIndex( AssetPath path )
+{
+	// Path hashes are entry addresses, so skip the low bits that are the same for all entries due to alignment.
+	size_t hash = path.ComputeHash();
+
+	return ( ( hash >> 4 ) ^ ( hash >> 12 ) ) & ( REGISTRY_SHARD_COUNT - 1 );
+}
+
+/// Get the index of the registry shard with which to register an object.
+///
+/// @param[in] pObject  Object to register.
+///
+/// @return  Registry shard index.
+size_t Helium::Asset::GetObjectShardIndex( const Asset* pObject )
+{
+	// Objects have no path information when registered, so spread them out by address instead.
+	size_t address = static_cast< size_t >( reinterpret_cast< uintptr_t >( pObject ) );
+
+	return ( ( address >> 6 ) ^ ( address >> 14 ) ) & ( REGISTRY_SHARD_COUNT - 1 );
+}
+
 /// Constructor.
 Helium::Asset::RenameParameters::RenameParameters()
 	: name( NULL_NAME )
@@ -3,7 +3,11 @@
 
 #include "Platform/Thread.h"
 #include "Engine/Asset.h"
+#include "Engine/AsyncLoader.h"
+#include "Engine/CacheManager.h"
+#include "Engine/LoadProfiler.h"
 #include "Engine/PackageLoader.h"
+#include "Engine/Resource.h"
 #include "Engine/FileLocations.h"
 
 /// Asset cache name.
@@ -19,12 +23,24 @@ AssetTracker* AssetTracker::sm_pInstance = NULL;
 /// Constructor.
 AssetLoader::AssetLoader()
 : m_loadRequestPool( LOAD_REQUEST_POOL_BLOCK_SIZE )
+, m_progressCounter( 0 )
+, m_polledCompletionCount( 0 )
+, m_pRecordingManifest( NULL )
+, m_pPrefetchManifest( NULL )
+, m_prefetchRecordIndex( 0 )
+, m_prefetchReadSize( 0 )
 {
 }
 
 /// Destructor.
 AssetLoader::~AssetLoader()
 {
+	// Prefetch loads can only be synced while the package loaders still exist, so prefetching must have been ended
+	// before getting here (DestroyStaticInstance() takes care of this).
+	HELIUM_ASSERT( !m_pPrefetchManifest );
+
+	delete m_pRecordingManifest;
+	m_pRecordingManifest = NULL;
 }
 
 /// Begin asynchronous loading of an object.
@@ -35,6 +51,28 @@ AssetLoader::~AssetLoader()
 ///
 /// @see TryFinishLoad(), FinishLoad()
 size_t AssetLoader::BeginLoadObject( AssetPath path, bool forceReload )
+{
+	size_t id = BeginLoadRequest( path, forceReload );
+
+	// The request now holds its own reference to the object (or will once loaded), so a prefetched reference to it no
+	// longer needs to be kept around.
+	if( IsValid( id ) )
+	{
+		ReleasePrefetchedObject( path );
+	}
+
+	return id;
+}
+
+/// Create or reuse the load request for an object, without releasing any prefetched reference to it.
+///
+/// @param[in] path         Asset path.
+/// @param[in] forceReload  True to reload the object even if it is already loaded.
+///
+/// @return  ID for the load request if started successfully, invalid index if not.
+///
+/// @see BeginLoadObject()
+size_t AssetLoader::BeginLoadRequest( AssetPath path, bool forceReload )
 {
 	HELIUM_TRACE( TraceLevels::Info, TXT(" AssetLoader::BeginLoadObject - Loading path %s\n"), *path.ToString() );
 	HELIUM_ASSERT( !path.GetName().IsEmpty() );
@@ -72,6 +110,8 @@ size_t AssetLoader::BeginLoadObject( AssetPath path, bool forceReload )
 				TraceLevels::Info,
 				TXT( "AssetLoader::BeginLoadObject(): Object \"%s\" already loaded.\n" ),
 				*path.ToString() );
+
+			m_residencyManager.Touch( pAsset );
 	} 
 	else
 	{
@@ -104,9 +144,32 @@ size_t AssetLoader::BeginLoadObject( AssetPath path, bool forceReload )
 	ConcurrentHashMap< AssetPath, LoadRequest* >::Accessor requestAccessor;
 	if( m_loadRequestMap.Insert( requestAccessor, KeyValue< AssetPath, LoadRequest* >( path, pRequest ) ) )
 	{
-		// New load request was created, so tick it once to get the load process running.
+		if( pPackageLoader )
+		{
+			LoadProfiler* pLoadProfiler = LoadProfiler::GetStaticInstance();
+			if( pLoadProfiler )
+			{
+				pLoadProfiler->BeginLoad( path );
+			}
+		}
+
+		// Record the load before updating the request, so that it precedes the loads of its dependencies.
+		if( pPackageLoader && m_pRecordingManifest )
+		{
+			MutexScopeLock recordingLock( m_recordingLock );
+			if( m_pRecordingManifest )
+			{
+				m_pRecordingManifest->AddObjectLoad( path );
+			}
+		}
+
+		// New load request was created, so update it once to get the load process running.  Hold an extra reference
+		// while doing so, as the request may otherwise be released once it has been scheduled.
+		AtomicIncrementRelease( pRequest->requestCount );
 		requestAccessor.Release();
-		TickLoadRequest( pRequest );
+
+		UpdateLoadRequest( pRequest );
+		ReleaseLoadRequest( pRequest );
 	}
 	else
 	{
@@ -204,10 +267,21 @@ bool AssetLoader::TryFinishLoad( size_t id, AssetPtr& rspObject )
 /// @see TryFinishLoad(), BeginLoadObject(), BeginPreloadPackage()
 void AssetLoader::FinishLoad( size_t id, AssetPtr& rspObject )
 {
+	AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
+
 	while( !TryFinishLoad( id, rspObject ) )
 	{
+		int32_t progressCount = m_progressCounter;
+		int32_t completionCount = rAsyncLoader.GetCompletionCount();
+
 		Tick();
-		Thread::Yield();
+
+		// If nothing advanced during the update, sleep until a file read completes instead of spinning.  Fall back
+		// to yielding if no reads are pending, as we may be waiting on work done by other threads.
+		if( m_progressCounter == progressCount && !rAsyncLoader.WaitForCompletion( completionCount ) )
+		{
+			Thread::Yield();
+		}
 	}
 }
 
@@ -263,65 +337,532 @@ bool AssetLoader::CacheObject( Asset* /*pObject*/, bool /*bEvictPlatformPreproce
 #endif  // HELIUM_TOOLS
 
 /// Update object loading.
+///
+/// Only load requests able to make progress are updated: requests woken up by the requests they were blocked on, by
+/// the package loaders they were waiting on (while the package loaders are ticked), or by the completion of their
+/// own resource sub-data reads.
+///
+/// @see WakeLoadRequest(), WakePackageLoadRequests(), BeginSubDataWait()
 void AssetLoader::Tick()
 {
+	// Keep any prefetching running ahead of the requested loads.
+	TickPrefetch();
+
 	// Tick package loaders first.
 	TickPackageLoaders();
 
-	// Build the list of object load requests to update this tick, incrementing the request count on each to prevent
-	// them from being released while we don't have a lock on the request hash map.
-	//HELIUM_ASSERT( m_loadRequestTickArray.IsEmpty() );
-	/// List of load requests to update in the current tick.
-	DynamicArray< LoadRequest* > m_loadRequestTickArray;
+	int32_t completionCount = AsyncLoader::GetStaticInstance().GetCompletionCount();
+	if( completionCount != m_polledCompletionCount )
+	{
+		m_polledCompletionCount = completionCount;
+		WakeSubDataRequests();
+	}
 
-	ConcurrentHashMap< AssetPath, LoadRequest* >::ConstAccessor loadRequestConstAccessor;
-	if( m_loadRequestMap.First( loadRequestConstAccessor ) )
+	// Update ready requests until none are left, picking up any requests woken up along the way.  The ready queue is
+	// swapped out before updating, as requests may load other objects (and tick the loader) while being updated.
+	DynamicArray< LoadRequest* > tickRequests;
+	for( ; ; )
 	{
-		do
 		{
-			LoadRequest* pRequest = loadRequestConstAccessor->Second();
+			MutexScopeLock waitLock( m_waitLock );
+			if( m_readyRequests.IsEmpty() )
+			{
+				break;
+			}
+
+			tickRequests = m_readyRequests;
+			m_readyRequests.Resize( 0 );
+		}
+
+		size_t tickRequestCount = tickRequests.GetSize();
+		for( size_t requestIndex = 0; requestIndex < tickRequestCount; ++requestIndex )
+		{
+			LoadRequest* pRequest = tickRequests[ requestIndex ];
 			HELIUM_ASSERT( pRequest );
-			AtomicIncrementUnsafe( pRequest->requestCount );
-			m_loadRequestTickArray.Add( pRequest );
 
-			++loadRequestConstAccessor;
-		} while( loadRequestConstAccessor.IsValid() );
+			AtomicAndRelease( pRequest->stateFlags, ~LOAD_FLAG_QUEUED );
+
+			UpdateLoadRequest( pRequest );
+			ReleaseLoadRequest( pRequest );
+		}
 	}
 
-	// Tick object load requests.
-	size_t loadRequestCount = m_loadRequestTickArray.GetSize();
-	for( size_t requestIndex = 0; requestIndex < loadRequestCount; ++requestIndex )
+	// Evict resources left unreferenced, now that this update's loads have taken the references they need.
+	m_residencyManager.Tick();
+}
+
+/// Wake up the load request for an object waiting on its package loader.
+///
+/// Package loaders should call this whenever an object load request they manage is ready to be synced, so that the
+/// load request for the object is updated during the next Tick().  If the load request is still being updated, it is
+/// queued again as soon as it is done instead of waiting.
+///
+/// @param[in] path  Path of the object whose package loader request has made progress.
+///
+/// @see WakePackageLoadRequests()
+void AssetLoader::WakeLoadRequest( AssetPath path )
+{
+	AtomicIncrementRelease( m_progressCounter );
+
+	MutexScopeLock waitLock( m_waitLock );
+
+	// If syncing the object with the package loader still fails after this, it is waiting on other loads.
+	ConcurrentHashMap< AssetPath, LoadRequest* >::ConstAccessor requestConstAccessor;
+	if( m_loadRequestMap.Find( requestConstAccessor, path ) )
 	{
-		LoadRequest* pRequest = m_loadRequestTickArray[ requestIndex ];
+		LoadRequest* pRequest = requestConstAccessor->Second();
 		HELIUM_ASSERT( pRequest );
+		AtomicOrRelease( pRequest->stateFlags, LOAD_FLAG_PACKAGE_READY );
+	}
 
-		//HELIUM_TRACE( TraceLevels::Info, TXT(  "Ticking pRequest %s %x\n"), *pRequest->path.ToString(), pRequest->stateFlags );
+	requestConstAccessor.Release();
 
-		TickLoadRequest( pRequest );
+	WakePolledRequest( path );
+}
 
-		int32_t newRequestCount = AtomicDecrementRelease( pRequest->requestCount );
-		if( newRequestCount == 0 )
+/// Wake up all load requests waiting for a package loader to finish preloading.
+///
+/// Package loaders should call this once their own preloading has completed, so that the load requests waiting to
+/// begin loading objects from them are updated during the next Tick().
+///
+/// @param[in] pPackageLoader  Package loader that has finished preloading.
+///
+/// @see WakeLoadRequest()
+void AssetLoader::WakePackageLoadRequests( PackageLoader* pPackageLoader )
+{
+	HELIUM_ASSERT( pPackageLoader );
+
+	AtomicIncrementRelease( m_progressCounter );
+
+	MutexScopeLock waitLock( m_waitLock );
+
+	DynamicArray< AssetPath > paths;
+	HashMap< AssetPath, LoadRequest* >::ConstIterator requestEnd = m_pollRequests.End();
+	for( HashMap< AssetPath, LoadRequest* >::ConstIterator requestIterator = m_pollRequests.Begin();
+		requestIterator != requestEnd;
+		++requestIterator )
+	{
+		const LoadRequest* pRequest = requestIterator->Second();
+		HELIUM_ASSERT( pRequest );
+		if( pRequest->pPackageLoader == pPackageLoader && IsInvalid( pRequest->packageLoadRequestId ) )
 		{
-			ConcurrentHashMap< AssetPath, LoadRequest* >::Accessor loadRequestAccessor;
-			if( m_loadRequestMap.Find( loadRequestAccessor, pRequest->path ) )
-			{
-				pRequest = loadRequestAccessor->Second();
-				HELIUM_ASSERT( pRequest );
-				if( pRequest->requestCount == 0 )
-				{
-					HELIUM_ASSERT( ( pRequest->stateFlags & LOAD_FLAG_FULLY_LOADED ) == LOAD_FLAG_FULLY_LOADED );
+			paths.Push( requestIterator->First() );
+		}
+	}
 
-					pRequest->spObject.Release();
-					pRequest->resolver.Clear();
+	size_t pathCount = paths.GetSize();
+	for( size_t pathIndex = 0; pathIndex < pathCount; ++pathIndex )
+	{
+		WakePolledRequest( paths[ pathIndex ] );
+	}
+}
 
-					m_loadRequestMap.Remove( loadRequestAccessor );
-					m_loadRequestPool.Release( pRequest );
-				}
-			}
+/// Wake up the load request for a resource once a sub-data read it has issued completes.
+///
+/// Resources should call this for each sub-data read issued while precaching, and call EndSubDataWait() once the read
+/// has been synced.
+///
+/// @param[in] path         Path of the resource.
+/// @param[in] asyncLoadId  AsyncLoader ID of the read.
+///
+/// @see EndSubDataWait()
+void AssetLoader::BeginSubDataWait( AssetPath path, size_t asyncLoadId )
+{
+	HELIUM_ASSERT( IsValid( asyncLoadId ) );
+
+	MutexScopeLock waitLock( m_waitLock );
+
+	// The read may have completed before we got here, in which case there is nothing left to wait for.
+	if( AsyncLoader::GetStaticInstance().IsRequestComplete( asyncLoadId ) )
+	{
+		WakePolledRequest( path );
+
+		return;
+	}
+
+	HashMap< size_t, AssetPath >::Iterator waitIterator;
+	if( !m_subDataWaits.Insert( waitIterator, KeyValue< size_t, AssetPath >( asyncLoadId, path ) ) )
+	{
+		waitIterator->Second() = path;
+	}
+}
+
+/// Stop waking up a resource load request for a sub-data read that has been synced.
+///
+/// @param[in] asyncLoadId  AsyncLoader ID of the read.
+///
+/// @see BeginSubDataWait()
+void AssetLoader::EndSubDataWait( size_t asyncLoadId )
+{
+	MutexScopeLock waitLock( m_waitLock );
+
+	HashMap< size_t, AssetPath >::Iterator waitIterator = m_subDataWaits.Find( asyncLoadId );
+	if( waitIterator != m_subDataWaits.End() )
+	{
+		m_subDataWaits.Remove( waitIterator );
+	}
+}
+
+/// Begin recording the object loads and resource sub-data reads started from here on into a prefetch manifest.
+///
+/// Any manifest already being recorded is discarded.
+///
+/// @see EndRecordingManifest(), BeginPrefetch()
+void AssetLoader::BeginRecordingManifest()
+{
+	MutexScopeLock recordingLock( m_recordingLock );
+
+	if( m_pRecordingManifest )
+	{
+		m_pRecordingManifest->Clear();
+	}
+	else
+	{
+		m_pRecordingManifest = new LoadManifest;
+		HELIUM_ASSERT( m_pRecordingManifest );
+	}
+}
+
+/// Stop recording a prefetch manifest and save it.
+///
+/// @param[in] rFileName  Name of the file to which the manifest should be saved.
+///
+/// @return  True if the manifest was saved successfully, false if not or no manifest was being recorded.
+///
+/// @see BeginRecordingManifest()
+bool AssetLoader::EndRecordingManifest( const String& rFileName )
+{
+	LoadManifest* pManifest;
+	{
+		MutexScopeLock recordingLock( m_recordingLock );
+		pManifest = m_pRecordingManifest;
+		m_pRecordingManifest = NULL;
+	}
+
+	if( !pManifest )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "AssetLoader::EndRecordingManifest(): No manifest is being recorded.\n" ) );
+
+		return false;
+	}
+
+	bool bSaved = pManifest->Save( rFileName );
+	delete pManifest;
+
+	return bSaved;
+}
+
+/// Get whether a prefetch manifest is being recorded.
+///
+/// @return  True if recording, false if not.
+///
+/// @see BeginRecordingManifest()
+bool AssetLoader::IsRecordingManifest() const
+{
+	return ( m_pRecordingManifest != NULL );
+}
+
+/// Record a resource sub-data read in the prefetch manifest being recorded, if any.
+///
+/// @param[in] cacheName     Name of the cache from which the sub-data is read.
+/// @param[in] path          Path of the resource.
+/// @param[in] subDataIndex  Resource sub-data index.
+void AssetLoader::RecordSubDataLoad( Name cacheName, AssetPath path, uint32_t subDataIndex )
+{
+	MutexScopeLock recordingLock( m_recordingLock );
+
+	if( m_pRecordingManifest )
+	{
+		m_pRecordingManifest->AddSubDataLoad( cacheName, path, subDataIndex );
+	}
+}
+
+/// Begin prefetching the data listed in a prefetch manifest recorded with BeginRecordingManifest().
+///
+/// Manifest records are replayed in order, as object loads and resource sub-data reads, while the loader is ticked.
+/// This runs ahead of the dependency resolution of regular loads, so that data is already loaded or on its way by the
+/// time it is requested.  The number of prefetch loads and reads in progress at once is limited by
+/// PREFETCH_LOAD_COUNT_MAX and PREFETCH_READ_SIZE_MAX.  Each prefetched object is held until a regular
+/// BeginLoadObject() call for it takes its own reference.  Prefetching ends on its own once every record has been
+/// issued and completed, releasing any prefetched objects that were never requested.
+///
+/// @param[in] rFileName  Manifest file name.
+///
+/// @return  True if prefetching was started, false if the manifest could not be loaded.
+///
+/// @see EndPrefetch(), IsPrefetching()
+bool AssetLoader::BeginPrefetch( const String& rFileName )
+{
+	EndPrefetch();
+
+	LoadManifest* pManifest = new LoadManifest;
+	HELIUM_ASSERT( pManifest );
+	if( !pManifest->Load( rFileName ) )
+	{
+		delete pManifest;
+
+		return false;
+	}
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		TXT( "AssetLoader::BeginPrefetch(): Prefetching %" ) PRIuSZ TXT( " records from \"%s\".\n" ),
+		pManifest->GetRecordCount(),
+		*rFileName );
+
+	m_pPrefetchManifest = pManifest;
+	m_prefetchRecordIndex = 0;
+
+	TickPrefetch();
+
+	return true;
+}
+
+/// Stop prefetching and release any prefetched objects.
+///
+/// This blocks until any prefetch loads and reads still in progress have completed.
+///
+/// @see BeginPrefetch()
+void AssetLoader::EndPrefetch()
+{
+	if( !m_pPrefetchManifest )
+	{
+		return;
+	}
+
+	// Detach the prefetch state first, as syncing the remaining loads ticks the loader.
+	delete m_pPrefetchManifest;
+	m_pPrefetchManifest = NULL;
+
+	DynamicArray< PrefetchLoad > prefetchLoads;
+	{
+		MutexScopeLock prefetchLock( m_prefetchLock );
+		prefetchLoads.Swap( m_prefetchLoads );
+	}
+
+	size_t loadCount = prefetchLoads.GetSize();
+	for( size_t loadIndex = 0; loadIndex < loadCount; ++loadIndex )
+	{
+		AssetPtr spObject;
+		FinishLoad( prefetchLoads[ loadIndex ].loadId, spObject );
+	}
+
+	{
+		MutexScopeLock prefetchLock( m_prefetchLock );
+		m_prefetchedObjects.Clear();
+	}
+
+	AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
+
+	size_t readCount = m_prefetchReads.GetSize();
+	for( size_t readIndex = 0; readIndex < readCount; ++readIndex )
+	{
+		PrefetchRead& rRead = m_prefetchReads[ readIndex ];
+		rAsyncLoader.SyncRequest( rRead.asyncLoadId );
+		DefaultAllocator().Free( rRead.pBuffer );
+	}
+
+	m_prefetchReads.Clear();
+	m_prefetchReadSize = 0;
+}
+
+/// Get whether a prefetch manifest is being replayed.
+///
+/// @return  True if prefetching, false if not.
+///
+/// @see BeginPrefetch()
+bool AssetLoader::IsPrefetching() const
+{
+	return ( m_pPrefetchManifest != NULL );
+}
+
+/// Get the manager keeping loaded resources resident within the memory budget.
+///
+/// Resources are only kept resident once a budget has been set with ResidencyManager::SetBudget().
+///
+/// @return  Residency manager.
+ResidencyManager& AssetLoader::GetResidencyManager()
+{
+	return m_residencyManager;
+}
+
+/// Sync completed prefetch loads and reads, and issue further prefetch manifest records as room becomes available.
+void AssetLoader::TickPrefetch()
+{
+	if( !m_pPrefetchManifest )
+	{
+		return;
+	}
+
+	// Only this thread adds or removes prefetch loads, so the load IDs can be read without holding the lock.
+	for( size_t loadIndex = 0; loadIndex < m_prefetchLoads.GetSize(); )
+	{
+		AssetPtr spObject;
+		if( !TryFinishLoad( m_prefetchLoads[ loadIndex ].loadId, spObject ) )
+		{
+			++loadIndex;
+
+			continue;
+		}
+
+		MutexScopeLock prefetchLock( m_prefetchLock );
+
+		// Hold the object until it is requested, unless it already was while its prefetch load was in progress.
+		if( spObject && !m_prefetchLoads[ loadIndex ].bRequested )
+		{
+			HashMap< AssetPath, AssetPtr >::Iterator objectIterator;
+			m_prefetchedObjects.Insert( objectIterator, KeyValue< AssetPath, AssetPtr >( spObject->GetPath(), spObject ) );
+		}
+
+		m_prefetchLoads.RemoveSwap( loadIndex );
+	}
+
+	AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
+
+	for( size_t readIndex = 0; readIndex < m_prefetchReads.GetSize(); )
+	{
+		PrefetchRead& rRead = m_prefetchReads[ readIndex ];
+
+		size_t bytesRead;
+		if( !rAsyncLoader.TrySyncRequest( rRead.asyncLoadId, bytesRead ) )
+		{
+			++readIndex;
+
+			continue;
 		}
+
+		// The data only needed to be read for it to be in the file cache when the resource requests it.
+		DefaultAllocator().Free( rRead.pBuffer );
+		m_prefetchReadSize -= rRead.size;
+
+		m_prefetchReads.RemoveSwap( readIndex );
 	}
 
-	//m_loadRequestTickArray.Resize( 0 );
+	size_t recordCount = m_pPrefetchManifest->GetRecordCount();
+	while( m_prefetchRecordIndex < recordCount &&
+		m_prefetchLoads.GetSize() < PREFETCH_LOAD_COUNT_MAX &&
+		m_prefetchReadSize < PREFETCH_READ_SIZE_MAX )
+	{
+		const LoadManifest::Record& rRecord = m_pPrefetchManifest->GetRecord( m_prefetchRecordIndex );
+		++m_prefetchRecordIndex;
+
+		BeginPrefetchRecord( rRecord );
+	}
+
+	// Once everything in the manifest has been issued and completed, there is nothing left to run ahead of, so stop
+	// holding on to prefetched objects that were never requested.
+	if( m_prefetchRecordIndex >= recordCount && m_prefetchLoads.IsEmpty() && m_prefetchReads.IsEmpty() )
+	{
+		HELIUM_TRACE( TraceLevels::Info, TXT( "AssetLoader::TickPrefetch(): Prefetching complete.\n" ) );
+
+		EndPrefetch();
+	}
+}
+
+/// Release the reference held to an object by prefetching, if any.
+///
+/// If the object's prefetch load is still in progress, the object is flagged so that it is not held once the load
+/// completes.
+///
+/// @param[in] path  Asset path.
+void AssetLoader::ReleasePrefetchedObject( AssetPath path )
+{
+	MutexScopeLock prefetchLock( m_prefetchLock );
+
+	HashMap< AssetPath, AssetPtr >::Iterator objectIterator = m_prefetchedObjects.Find( path );
+	if( objectIterator != m_prefetchedObjects.End() )
+	{
+		m_prefetchedObjects.Remove( objectIterator );
+
+		return;
+	}
+
+	size_t loadCount = m_prefetchLoads.GetSize();
+	for( size_t loadIndex = 0; loadIndex < loadCount; ++loadIndex )
+	{
+		PrefetchLoad& rLoad = m_prefetchLoads[ loadIndex ];
+		if( rLoad.path == path )
+		{
+			rLoad.bRequested = true;
+
+			break;
+		}
+	}
+}
+
+/// Issue the object load or resource sub-data read for a prefetch manifest record.
+///
+/// @param[in] rRecord  Manifest record.
+///
+/// @return  True if a load or read was issued, false if the record no longer refers to anything that can be loaded.
+bool AssetLoader::BeginPrefetchRecord( const LoadManifest::Record& rRecord )
+{
+	if( IsInvalid( rRecord.subDataIndex ) )
+	{
+		// Bypass BeginLoadObject(), as prefetch loads must not count as requests for previously prefetched objects.
+		size_t loadId = BeginLoadRequest( rRecord.path, false );
+		if( IsInvalid( loadId ) )
+		{
+			return false;
+		}
+
+		MutexScopeLock prefetchLock( m_prefetchLock );
+
+		PrefetchLoad* pLoad = m_prefetchLoads.New();
+		HELIUM_ASSERT( pLoad );
+		pLoad->loadId = loadId;
+		pLoad->path = rRecord.path;
+		pLoad->bRequested = false;
+
+		return true;
+	}
+
+	Cache* pCache = CacheManager::GetStaticInstance().GetCache( rRecord.cacheName );
+	if( !pCache )
+	{
+		return false;
+	}
+
+	pCache->EnforceTocLoad();
+
+	const Cache::Entry* pEntry = pCache->FindEntry( rRecord.path, rRecord.subDataIndex );
+	if( !pEntry || pEntry->storedSize == 0 )
+	{
+		return false;
+	}
+
+	// Memory mapped caches just need a readahead hint, as do file reads where the platform supports it.
+	if( pCache->IsCacheFileMapped() )
+	{
+		pCache->AdviseMappedRange( pEntry->offset, pEntry->storedSize );
+
+		return true;
+	}
+
+	if( pCache->AdviseFileRange( pEntry->offset, pEntry->storedSize ) )
+	{
+		return true;
+	}
+
+	// Otherwise, read the data as stored, at low priority so that reads for requested data are not held up behind it.
+	PrefetchRead* pRead = m_prefetchReads.New();
+	HELIUM_ASSERT( pRead );
+	pRead->size = pEntry->storedSize;
+	pRead->pBuffer = DefaultAllocator().Allocate( pRead->size );
+	HELIUM_ASSERT( pRead->pBuffer );
+	pRead->asyncLoadId = AsyncLoader::GetStaticInstance().QueueRequest(
+		pRead->pBuffer,
+		pCache->GetCacheFileName(),
+		pEntry->offset,
+		pRead->size,
+		AsyncLoader::PRIORITY_LOW );
+	HELIUM_ASSERT( IsValid( pRead->asyncLoadId ) );
+
+	m_prefetchReadSize += pRead->size;
+
+	return true;
 }
 
 /// Get the global object loader instance.
@@ -341,6 +882,12 @@ AssetLoader* AssetLoader::GetStaticInstance()
 /// @see GetStaticInstance()
 void AssetLoader::DestroyStaticInstance()
 {
+	if( sm_pInstance )
+	{
+		sm_pInstance->EndPrefetch();
+		sm_pInstance->m_residencyManager.Clear();
+	}
+
 	delete sm_pInstance;
 	sm_pInstance = NULL;
 }
@@ -355,6 +902,16 @@ void AssetLoader::DestroyStaticInstance()
 /// @fn void AssetLoader::TickPackageLoaders()
 /// Tick all package loaders for the current AssetLoader tick.
 
+/// Perform work once the references of an object have been linked, before resource precaching and load finalization
+/// have had a chance to modify it.
+///
+/// @param[in] path            Asset path.
+/// @param[in] pObject         Asset instance.
+/// @param[in] pPackageLoader  Package loader used to load the given object.
+void AssetLoader::OnLinkComplete( const AssetPath & /*path*/, Asset* /*pObject*/, PackageLoader* /*pPackageLoader*/ )
+{
+}
+
 /// Perform work immediately prior to initiating resource precaching.
 ///
 /// @param[in] pObject         Asset instance.
@@ -372,12 +929,308 @@ void AssetLoader::OnLoadComplete( const AssetPath & /*path*/, Asset* /*pObject*/
 {
 }
 
-/// Update the given load request.
+/// Update the given load request, then schedule it to be updated again once whatever it is blocked on has made
+/// progress.
+///
+/// The caller must hold a reference to the request.
 ///
 /// @param[in] pRequest  Load request to update.
+void AssetLoader::UpdateLoadRequest( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	const int32_t stageFlags = LOAD_FLAG_FULLY_LOADED | LOAD_FLAG_ERROR;
+	int32_t previousStateFlags = pRequest->stateFlags;
+
+	// Any wake-up from here on means the request may be able to make further progress after this update.
+	AtomicAndRelease( pRequest->stateFlags, ~LOAD_FLAG_WAKE_PENDING );
+
+	size_t blockingRequestId;
+	SetInvalid( blockingRequestId );
+	int32_t blockingFlags = 0;
+	bool bFinished = TickLoadRequest( pRequest, blockingRequestId, blockingFlags );
+
+	if( ( pRequest->stateFlags ^ previousStateFlags ) & stageFlags )
+	{
+		AtomicIncrementRelease( m_progressCounter );
+		WakeWaitingRequests( pRequest );
+	}
+
+	// Requests waiting on objects loaded by their package loader or resource may have been waiting on this one.
+	if( ( pRequest->stateFlags & ~previousStateFlags ) & LOAD_FLAG_LOADED )
+	{
+		MutexScopeLock waitLock( m_waitLock );
+
+		size_t loadWaitRequestCount = m_loadWaitRequests.GetSize();
+		for( size_t requestIndex = 0; requestIndex < loadWaitRequestCount; ++requestIndex )
+		{
+			PushReadyRequest( m_loadWaitRequests[ requestIndex ] );
+		}
+
+		m_loadWaitRequests.Resize( 0 );
+	}
+
+	if( bFinished )
+	{
+		return;
+	}
+
+	if( IsValid( blockingRequestId ) )
+	{
+		LoadRequest* pBlockingRequest = m_loadRequestPool.GetObject( blockingRequestId );
+		HELIUM_ASSERT( pBlockingRequest );
+		WaitOnLoadRequest( pRequest, pBlockingRequest, blockingFlags );
+
+		return;
+	}
+
+	// Otherwise, the request is waiting on its package loader or on resource data, and is woken up by whichever it is
+	// waiting on.
+	AtomicIncrementRelease( pRequest->requestCount );
+
+	bool bWaitingOnPreload =
+		!( pRequest->stateFlags & LOAD_FLAG_PRELOADED ) && IsInvalid( pRequest->packageLoadRequestId );
+
+	{
+		MutexScopeLock waitLock( m_waitLock );
+
+		if( AtomicAndAcquire( pRequest->stateFlags, ~LOAD_FLAG_WAKE_PENDING ) & LOAD_FLAG_WAKE_PENDING )
+		{
+			PushReadyRequest( pRequest );
+
+			return;
+		}
+
+		// Once the package loader has reported the object ready, or once precaching has started without any sub-data
+		// reads left in progress, only other loads can be holding the request up.
+		bool bWaitingOnLoads = ( pRequest->stateFlags & LOAD_FLAG_PRELOADED )
+			? !HasSubDataWait( pRequest->path )
+			: ( pRequest->stateFlags & LOAD_FLAG_PACKAGE_READY ) != 0;
+		if( bWaitingOnLoads )
+		{
+			m_loadWaitRequests.Push( pRequest );
+
+			return;
+		}
+
+		HashMap< AssetPath, LoadRequest* >::Iterator requestIterator;
+		if( !m_pollRequests.Insert( requestIterator, KeyValue< AssetPath, LoadRequest* >( pRequest->path, pRequest ) ) )
+		{
+			// Already waiting, in which case the existing entry holds its own reference.
+			int32_t newRequestCount = AtomicDecrementRelease( pRequest->requestCount );
+			HELIUM_ASSERT( newRequestCount > 0 );
+			HELIUM_UNREF( newRequestCount );
+		}
+	}
+
+	// The package loader may have finished preloading since we checked it, after waking up the requests waiting on it
+	// at the time.
+	if( bWaitingOnPreload && pRequest->pPackageLoader->TryFinishPreload() )
+	{
+		WakePackageLoadRequests( pRequest->pPackageLoader );
+	}
+}
+
+/// Block a load request until another request has reached a given state.
+///
+/// The caller must hold a reference to the request, and a reference to the blocking request must be held for as long
+/// as the request is waiting on it.
+///
+/// @param[in] pRequest          Load request to block.
+/// @param[in] pBlockingRequest  Load request being waited on.
+/// @param[in] blockingFlags     State flags that must all be set on the blocking request before the request can make
+///                              progress.
+void AssetLoader::WaitOnLoadRequest( LoadRequest* pRequest, LoadRequest* pBlockingRequest, int32_t blockingFlags )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( pBlockingRequest );
+
+	AtomicIncrementRelease( pRequest->requestCount );
+
+	LoadProfiler* pLoadProfiler = LoadProfiler::GetStaticInstance();
+	if( pLoadProfiler )
+	{
+		pLoadProfiler->AddDependency( pRequest->path, pBlockingRequest->path );
+	}
+
+	// Requests only wake their waiters after updating their state, so checking the state while holding the lock
+	// ensures the wake-up can't be missed.
+	MutexScopeLock waitLock( m_waitLock );
+	if( ( pBlockingRequest->stateFlags & blockingFlags ) == blockingFlags )
+	{
+		PushReadyRequest( pRequest );
+	}
+	else
+	{
+		pBlockingRequest->waitingRequests.Push( pRequest );
+	}
+}
+
+/// Queue all requests waiting on the given load request for updating.
+///
+/// @param[in] pRequest  Load request that has made progress.
+void AssetLoader::WakeWaitingRequests( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	MutexScopeLock waitLock( m_waitLock );
+
+	size_t waitingRequestCount = pRequest->waitingRequests.GetSize();
+	for( size_t requestIndex = 0; requestIndex < waitingRequestCount; ++requestIndex )
+	{
+		PushReadyRequest( pRequest->waitingRequests[ requestIndex ] );
+	}
+
+	pRequest->waitingRequests.Resize( 0 );
+}
+
+/// Queue the load request waiting on its package loader or resource data with the given path for updating.
+///
+/// The wait lock must be held when calling this.  If the request is not waiting, it is flagged so that it is queued
+/// again once its current update is done instead of waiting.
+///
+/// @param[in] path  Path of the load request to wake up.
+void AssetLoader::WakePolledRequest( AssetPath path )
+{
+	HashMap< AssetPath, LoadRequest* >::Iterator requestIterator = m_pollRequests.Find( path );
+	if( requestIterator != m_pollRequests.End() )
+	{
+		LoadRequest* pRequest = requestIterator->Second();
+		HELIUM_ASSERT( pRequest );
+		m_pollRequests.Remove( requestIterator );
+
+		// The poll list reference is passed on to the ready queue.
+		PushReadyRequest( pRequest );
+
+		return;
+	}
+
+	ConcurrentHashMap< AssetPath, LoadRequest* >::ConstAccessor requestConstAccessor;
+	if( m_loadRequestMap.Find( requestConstAccessor, path ) )
+	{
+		LoadRequest* pRequest = requestConstAccessor->Second();
+		HELIUM_ASSERT( pRequest );
+		AtomicOrRelease( pRequest->stateFlags, LOAD_FLAG_WAKE_PENDING );
+	}
+}
+
+/// Wake up the load requests whose resource sub-data reads have completed.
+void AssetLoader::WakeSubDataRequests()
+{
+	AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
+
+	MutexScopeLock waitLock( m_waitLock );
+
+	DynamicArray< size_t > completedLoadIds;
+	HashMap< size_t, AssetPath >::ConstIterator waitEnd = m_subDataWaits.End();
+	for( HashMap< size_t, AssetPath >::ConstIterator waitIterator = m_subDataWaits.Begin();
+		waitIterator != waitEnd;
+		++waitIterator )
+	{
+		if( rAsyncLoader.IsRequestComplete( waitIterator->First() ) )
+		{
+			completedLoadIds.Push( waitIterator->First() );
+		}
+	}
+
+	size_t completedCount = completedLoadIds.GetSize();
+	for( size_t loadIndex = 0; loadIndex < completedCount; ++loadIndex )
+	{
+		HashMap< size_t, AssetPath >::Iterator waitIterator = m_subDataWaits.Find( completedLoadIds[ loadIndex ] );
+		HELIUM_ASSERT( waitIterator != m_subDataWaits.End() );
+		AssetPath path = waitIterator->Second();
+		m_subDataWaits.Remove( waitIterator );
+
+		WakePolledRequest( path );
+	}
+}
+
+/// Get whether a resource still has sub-data reads in progress that will wake up its load request.
+///
+/// The wait lock must be held when calling this.
+///
+/// @param[in] path  Path of the resource.
+///
+/// @return  True if a read issued for the resource has yet to complete, false if not.
+bool AssetLoader::HasSubDataWait( AssetPath path ) const
+{
+	HashMap< size_t, AssetPath >::ConstIterator waitEnd = m_subDataWaits.End();
+	for( HashMap< size_t, AssetPath >::ConstIterator waitIterator = m_subDataWaits.Begin();
+		waitIterator != waitEnd;
+		++waitIterator )
+	{
+		if( waitIterator->Second() == path )
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/// Add a load request to the ready queue, taking over a reference held by the caller.
+///
+/// The wait lock must be held when calling this.  If the request is already queued, the reference is dropped instead.
+///
+/// @param[in] pRequest  Load request to queue.
+void AssetLoader::PushReadyRequest( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	if( AtomicOrAcquire( pRequest->stateFlags, LOAD_FLAG_QUEUED ) & LOAD_FLAG_QUEUED )
+	{
+		// The existing queue entry holds its own reference, so this can't be the last one.
+		int32_t newRequestCount = AtomicDecrementRelease( pRequest->requestCount );
+		HELIUM_ASSERT( newRequestCount > 0 );
+		HELIUM_UNREF( newRequestCount );
+
+		return;
+	}
+
+	m_readyRequests.Push( pRequest );
+}
+
+/// Release a reference to a load request held by the loader itself, freeing the request if no references remain.
+///
+/// @param[in] pRequest  Load request to release.
+void AssetLoader::ReleaseLoadRequest( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+
+	int32_t newRequestCount = AtomicDecrementRelease( pRequest->requestCount );
+	if( newRequestCount != 0 )
+	{
+		return;
+	}
+
+	ConcurrentHashMap< AssetPath, LoadRequest* >::Accessor loadRequestAccessor;
+	if( m_loadRequestMap.Find( loadRequestAccessor, pRequest->path ) )
+	{
+		pRequest = loadRequestAccessor->Second();
+		HELIUM_ASSERT( pRequest );
+		if( pRequest->requestCount == 0 )
+		{
+			HELIUM_ASSERT( ( pRequest->stateFlags & LOAD_FLAG_FULLY_LOADED ) == LOAD_FLAG_FULLY_LOADED );
+			HELIUM_ASSERT( pRequest->waitingRequests.IsEmpty() );
+
+			pRequest->spObject.Release();
+			pRequest->resolver.Clear();
+
+			m_loadRequestMap.Remove( loadRequestAccessor );
+			m_loadRequestPool.Release( pRequest );
+		}
+	}
+}
+
+/// Update the given load request.
+///
+/// @param[in]  pRequest            Load request to update.
+/// @param[out] rBlockingRequestId  Set to the ID of another load request if this request cannot make progress until
+///                                 that request has reached the state given by rBlockingFlags.
+/// @param[out] rBlockingFlags      State flags the blocking request must reach.
 ///
 /// @return  True if the load request has completed, false if it still requires time to process.
-bool AssetLoader::TickLoadRequest( LoadRequest* pRequest )
+bool AssetLoader::TickLoadRequest( LoadRequest* pRequest, size_t& rBlockingRequestId, int32_t& rBlockingFlags )
 {
 	HELIUM_ASSERT( pRequest );
 
@@ -401,6 +1254,7 @@ bool AssetLoader::TickLoadRequest( LoadRequest* pRequest )
 	{
 		LOCK_TICK();
 
+		LoadProfiler::PhaseScope profileScope( pRequest->path, LoadProfiler::PHASE_PRELOAD );
 		if( !TickPreload( pRequest ) )
 		{
 			UNLOCK_TICK();
@@ -417,8 +1271,10 @@ bool AssetLoader::TickLoadRequest( LoadRequest* pRequest )
 	{
 		LOCK_TICK();
 
-		if( !TickLink( pRequest ) )
+		LoadProfiler::PhaseScope profileScope( pRequest->path, LoadProfiler::PHASE_LINK );
+		if( !TickLink( pRequest, rBlockingRequestId ) )
 		{
+			rBlockingFlags = LOAD_FLAG_PRELOADED;
 			UNLOCK_TICK();
 
 			return false;
@@ -433,8 +1289,10 @@ bool AssetLoader::TickLoadRequest( LoadRequest* pRequest )
 	{
 		LOCK_TICK();
 
-		if( !TickPrecache( pRequest ) )
+		LoadProfiler::PhaseScope profileScope( pRequest->path, LoadProfiler::PHASE_PRECACHE );
+		if( !TickPrecache( pRequest, rBlockingRequestId ) )
 		{
+			rBlockingFlags = LOAD_FLAG_FULLY_LOADED;
 			UNLOCK_TICK();
 
 			return false;
@@ -449,6 +1307,7 @@ bool AssetLoader::TickLoadRequest( LoadRequest* pRequest )
 	{
 		LOCK_TICK();
 
+		LoadProfiler::PhaseScope profileScope( pRequest->path, LoadProfiler::PHASE_FINALIZE );
 		if( !TickFinalizeLoad( pRequest ) )
 		{
 			UNLOCK_TICK();
@@ -548,17 +1407,19 @@ bool AssetLoader::TickPreload( LoadRequest* pRequest )
 
 /// Update object reference linking for the given object load request.
 ///
-/// @param[in] pRequest  Load request to update.
+/// @param[in]  pRequest            Load request to update.
+/// @param[out] rBlockingRequestId  Set to the ID of a referenced object's load request if linking is waiting for it to
+///                                 be preloaded.
 ///
 /// @return  True if linking still requires processing, false if it is complete.
-bool AssetLoader::TickLink( LoadRequest* pRequest )
+bool AssetLoader::TickLink( LoadRequest* pRequest, size_t& rBlockingRequestId )
 {
 	HELIUM_ASSERT( pRequest );
 	HELIUM_ASSERT( !( pRequest->stateFlags & ( LOAD_FLAG_PRECACHED | LOAD_FLAG_LOADED ) ) );
 
 	if ( pRequest->spObject.ReferencesObject() )
 	{
-		if( !pRequest->resolver.ReadyToApplyFixups() )
+		if( !pRequest->resolver.ReadyToApplyFixups( rBlockingRequestId ) )
 		{
 			return false;
 		}
@@ -567,6 +1428,8 @@ bool AssetLoader::TickLink( LoadRequest* pRequest )
 
 		pRequest->resolver.ApplyFixups();
 		pRequest->spObject->SetFlags( Asset::FLAG_LINKED );
+
+		OnLinkComplete( pRequest->path, pRequest->spObject, pRequest->pPackageLoader );
 	}
 
 	AtomicOrRelease( pRequest->stateFlags, LOAD_FLAG_LINKED );
@@ -576,10 +1439,12 @@ bool AssetLoader::TickLink( LoadRequest* pRequest )
 
 /// Update resource precaching for the given object load request.
 ///
-/// @param[in] pRequest  Load request to update.
+/// @param[in]  pRequest            Load request to update.
+/// @param[out] rBlockingRequestId  Set to the ID of a referenced object's load request if precaching is waiting for
+///                                 it to be fully loaded.
 ///
 /// @return  True if resource precaching still requires processing, false if not.
-bool AssetLoader::TickPrecache( LoadRequest* pRequest )
+bool AssetLoader::TickPrecache( LoadRequest* pRequest, size_t& rBlockingRequestId )
 {
 	HELIUM_ASSERT( pRequest );
 	HELIUM_ASSERT( !( pRequest->stateFlags & LOAD_FLAG_LOADED ) );
@@ -588,7 +1453,7 @@ bool AssetLoader::TickPrecache( LoadRequest* pRequest )
 	if( pObject )
 	{
 		// TODO: SHouldn't this be in the linking phase?
-		if ( !pRequest->resolver.TryFinishPrecachingDependencies() )
+		if ( !pRequest->resolver.TryFinishPrecachingDependencies( rBlockingRequestId ) )
 		{
 			return false;
 		}
@@ -648,9 +1513,34 @@ bool AssetLoader::TickFinalizeLoad( LoadRequest* pRequest )
 	if( pObject )
 	{
 		pObject->ConditionalFinalizeLoad();
+
+#if HELIUM_TOOLS
+		// Reloads are loaded into a fresh instance, which replaces the live object only now that it is complete, so
+		// that the swap happens on the loading thread rather than while a worker is deserializing into it.
+		if( pRequest->forceReload && !pObject->GetAnyFlagSet( Asset::FLAG_BROKEN ) && pObject->GetPath() != pRequest->path )
+		{
+			Asset* pLiveObject = Asset::FindObject( pRequest->path );
+			if( pLiveObject && pLiveObject != pObject )
+			{
+				Asset::ReplaceAsset( pObject, pRequest->path );
+			}
+		}
+#endif
+
+		Resource* pResource = Reflect::SafeCast< Resource >( pObject );
+		if( pResource )
+		{
+			m_residencyManager.Track( pResource );
+		}
 	}
 
 	// Loading now complete.
+	LoadProfiler* pLoadProfiler = LoadProfiler::GetStaticInstance();
+	if( pLoadProfiler && pRequest->pPackageLoader )
+	{
+		pLoadProfiler->EndLoad( pRequest->path, pObject );
+	}
+
 	OnLoadComplete( pRequest->path, pObject, pRequest->pPackageLoader );
 	AtomicOrRelease( pRequest->stateFlags, LOAD_FLAG_LOADED );
 
@@ -737,16 +1627,23 @@ bool Helium::AssetResolver::Resolve( const Name& identity, Reflect::ObjectPtr& p
 	return false;
 }
 
-bool Helium::AssetResolver::ReadyToApplyFixups()
+Helium::AssetResolver::AssetResolver()
+	: m_PreloadedFixupCount( 0 )
 {
-	for ( DynamicArray< Fixup >::Iterator iter = m_Fixups.Begin();
-		iter != m_Fixups.End(); ++iter)
+}
+
+bool Helium::AssetResolver::ReadyToApplyFixups( size_t& rBlockingLoadRequestId )
+{
+	// Requests never lose their preloaded state, so fixups found ready by earlier calls don't need to be checked again
+	for ( ; m_PreloadedFixupCount < m_Fixups.GetSize(); ++m_PreloadedFixupCount )
 	{
 		// Retrieve the load request and test whether it has completed.
-		AssetLoader::LoadRequest* pRequest = AssetLoader::GetStaticInstance()->m_loadRequestPool.GetObject( iter->m_LoadRequestId );
+		size_t loadRequestId = m_Fixups[ m_PreloadedFixupCount ].m_LoadRequestId;
+		AssetLoader::LoadRequest* pRequest = AssetLoader::GetStaticInstance()->m_loadRequestPool.GetObject( loadRequestId );
 
 		if ( !( pRequest->stateFlags & AssetLoader::LOAD_FLAG_PRELOADED ) )
 		{
+			rBlockingLoadRequestId = loadRequestId;
 			return false;
 		}
 	}
@@ -776,9 +1673,10 @@ void Helium::AssetResolver::ApplyFixups()
 void Helium::AssetResolver::Clear()
 {
 	m_Fixups.Clear();
+	m_PreloadedFixupCount = 0;
 }
 
-bool Helium::AssetResolver::TryFinishPrecachingDependencies()
+bool Helium::AssetResolver::TryFinishPrecachingDependencies( size_t& rBlockingLoadRequestId )
 {
 	for ( DynamicArray< Fixup >::Iterator iter = m_Fixups.Begin();
 		iter != m_Fixups.End(); ++iter)
@@ -788,6 +1686,7 @@ bool Helium::AssetResolver::TryFinishPrecachingDependencies()
 			AssetPtr asset;
 			if( !AssetLoader::GetStaticInstance()->TryFinishLoad( iter->m_LoadRequestId, asset ) )
 			{
+				rBlockingLoadRequestId = iter->m_LoadRequestId;
 				return false;
 			}
 		
@@ -799,6 +1698,41 @@ bool Helium::AssetResolver::TryFinishPrecachingDependencies()
 	return true;
 }
 
+bool Helium::DeferredAssetResolver::Resolve( const Name& identity, Reflect::ObjectPtr& pointer, const Reflect::MetaClass* pointerClass )
+{
+	// Only paths are resolved by AssetResolver, everything else is left to the archive
+	if (!identity.IsEmpty() && (*identity)[0] == '/')
+	{
+		Reference reference;
+		reference.m_Identity = identity;
+		reference.m_pPointer = &pointer;
+		reference.m_PointerClass = pointerClass;
+		m_References.Push( reference );
+
+		return true;
+	}
+
+	return false;
+}
+
+void Helium::DeferredAssetResolver::ResolveDeferred( Reflect::ObjectResolver* pResolver )
+{
+	HELIUM_ASSERT( pResolver );
+
+	for ( DynamicArray< Reference >::Iterator iter = m_References.Begin();
+		iter != m_References.End(); ++iter)
+	{
+		pResolver->Resolve( iter->m_Identity, *iter->m_pPointer, iter->m_PointerClass );
+	}
+
+	m_References.Clear();
+}
+
+void Helium::DeferredAssetResolver::Clear()
+{
+	m_References.Clear();
+}
+
 #if HELIUM_TOOLS
 
 AssetTracker* AssetTracker::GetStaticInstance()
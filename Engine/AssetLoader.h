@@ -4,9 +4,13 @@
 
 #include "Reflect/Translator.h"
 #include "Foundation/ConcurrentHashMap.h"
+#include "Foundation/HashMap.h"
 #include "Foundation/ObjectPool.h"
+#include "Platform/Locks.h"
 #include "Engine/AssetPath.h"
 #include "Engine/Asset.h"
+#include "Engine/LoadManifest.h"
+#include "Engine/ResidencyManager.h"
 
 #define HELIUM_ASSET_CACHE_NAME TXT( "Asset" )
 #define HELIUM_CONFIG_CACHE_NAME TXT( "Config" )
@@ -28,9 +32,10 @@ namespace Helium
 		virtual bool Resolve( const Name& identity, Reflect::ObjectPtr& pointer, const Reflect::MetaClass* pointerClass );
 
 		// Called by AssetLoader
-		bool ReadyToApplyFixups();
+		AssetResolver();
+		bool ReadyToApplyFixups( size_t& rBlockingLoadRequestId );
 		void ApplyFixups();
-		bool TryFinishPrecachingDependencies();
+		bool TryFinishPrecachingDependencies( size_t& rBlockingLoadRequestId );
 		void Clear();
 
 		// Internal fixups that must be completed
@@ -53,14 +58,51 @@ namespace Helium
 			size_t                    m_LoadRequestId;
 		};
 		DynamicArray< Fixup >  m_Fixups;
+
+		// Number of leading fixups whose load requests are known to have been preloaded
+		size_t                 m_PreloadedFixupCount;
+	};
+
+	// Records the asset references found while deserializing on a worker thread, following the same rules as
+	// AssetResolver, so that they can be passed on to the actual resolver (which begins loading the referenced assets
+	// and is not thread-safe) once back on the loading thread
+	class HELIUM_ENGINE_API DeferredAssetResolver : public Reflect::ObjectResolver
+	{
+	public:
+		// Reflect::ObjectResolver interface
+		virtual bool Resolve( const Name& identity, Reflect::ObjectPtr& pointer, const Reflect::MetaClass* pointerClass );
+
+		// Called by package loaders
+		void ResolveDeferred( Reflect::ObjectResolver* pResolver );
+		void Clear();
+
+		// Reference recorded for later resolution
+		struct Reference
+		{
+			Name                      m_Identity;
+			Reflect::ObjectPtr*       m_pPointer;
+			const Reflect::MetaClass* m_PointerClass;
+		};
+		DynamicArray< Reference >  m_References;
 	};
 
 	/// Asynchronous object loading interface
+	///
+	/// Load requests are only updated when they are able to make progress.  A request blocked on another request (such
+	/// as a dependency that has yet to be preloaded) is woken up when that request advances.  A request waiting on a
+	/// package loader is woken up by the package loader once its object or the package itself has been preloaded, and
+	/// a request waiting on resource data is woken up once one of its own sub-data reads has completed.  Requests held
+	/// up by other objects their package loader or resource loads without going through a dependency (such as a
+	/// template, or an object a resource loads while precaching) are woken up whenever any request finishes loading.
 	class HELIUM_ENGINE_API AssetLoader : NonCopyable
 	{
 	public:
 		/// Number of request objects to allocate in each block of the request pool.
 		static const size_t LOAD_REQUEST_POOL_BLOCK_SIZE = 64;
+		/// Maximum number of object loads issued for prefetching that can be in progress at once.
+		static const size_t PREFETCH_LOAD_COUNT_MAX = 64;
+		/// Maximum number of bytes of resource sub-data prefetch reads that can be in progress at once.
+		static const size_t PREFETCH_READ_SIZE_MAX = 16 * 1024 * 1024;
 
 		friend AssetIdentifier;
 		friend AssetResolver;
@@ -98,6 +140,32 @@ namespace Helium
 		virtual void Tick();
 		//@}
 
+		/// @name Load Request Wake-Up
+		//@{
+		void WakeLoadRequest( AssetPath path );
+		void WakePackageLoadRequests( PackageLoader* pPackageLoader );
+
+		void BeginSubDataWait( AssetPath path, size_t asyncLoadId );
+		void EndSubDataWait( size_t asyncLoadId );
+		//@}
+
+		/// @name Prefetch Manifests
+		//@{
+		void BeginRecordingManifest();
+		bool EndRecordingManifest( const String& rFileName );
+		bool IsRecordingManifest() const;
+		void RecordSubDataLoad( Name cacheName, AssetPath path, uint32_t subDataIndex );
+
+		bool BeginPrefetch( const String& rFileName );
+		void EndPrefetch();
+		bool IsPrefetching() const;
+		//@}
+
+		/// @name Residency
+		//@{
+		ResidencyManager& GetResidencyManager();
+		//@}
+
 		/// @name Static Access
 		//@{
 		static AssetLoader* GetStaticInstance();
@@ -132,6 +200,13 @@ namespace Helium
 
 			/// Set if ticking is in progress.
 			LOAD_FLAG_IN_TICK = 1 << 6,
+
+			/// Set while the request is in the ready queue.
+			LOAD_FLAG_QUEUED = 1 << 7,
+			/// Set if the request was woken up while not waiting, so that it is queued again instead of waiting.
+			LOAD_FLAG_WAKE_PENDING = 1 << 8,
+			/// Set once the package loader has reported the object ready to be synced.
+			LOAD_FLAG_PACKAGE_READY = 1 << 9,
 		};
 
 		/// Asset load request information.
@@ -156,6 +231,9 @@ namespace Helium
 			AssetResolver resolver;
 
 			bool forceReload;
+
+			/// Requests blocked until this request makes progress (guarded by the AssetLoader wait lock).
+			DynamicArray< LoadRequest* > waitingRequests;
 		};
 
 		/// Load request hash map.
@@ -171,20 +249,104 @@ namespace Helium
 		virtual PackageLoader* GetPackageLoader( AssetPath path ) = 0;
 		virtual void TickPackageLoaders() = 0;
 
+		virtual void OnLinkComplete( const AssetPath &path, Asset* pObject, PackageLoader* pPackageLoader );
 		virtual void OnPrecacheReady( const AssetPath &path, Asset* pObject, PackageLoader* pPackageLoader );
 		virtual void OnLoadComplete( const AssetPath &path, Asset* pObject, PackageLoader* pPackageLoader );
 		//@}
 
 	private:
+		/// Object load issued for prefetching.
+		struct PrefetchLoad
+		{
+			/// Load request ID.
+			size_t loadId;
+			/// Path of the object being loaded.
+			AssetPath path;
+			/// True if the object was requested through BeginLoadObject() while the prefetch load was in progress.
+			bool bRequested;
+		};
+
+		/// Resource sub-data read issued for prefetching on platforms that cannot hint file readahead.
+		struct PrefetchRead
+		{
+			/// Async load ID.
+			size_t asyncLoadId;
+			/// Buffer into which the data is read (discarded once the read completes).
+			void* pBuffer;
+			/// Number of bytes read.
+			size_t size;
+		};
+
+		/// Requests ready to be updated.  Each entry holds a reference to its request.
+		DynamicArray< LoadRequest* > m_readyRequests;
+		/// Requests waiting on package loaders or resource sub-data reads, by path.  Each entry holds a reference to
+		/// its request.
+		HashMap< AssetPath, LoadRequest* > m_pollRequests;
+		/// Requests waiting on other objects loaded by their package loader or resource (such as templates, owners,
+		/// or objects loaded while precaching), woken up whenever any request finishes.  Each entry holds a reference
+		/// to its request.
+		DynamicArray< LoadRequest* > m_loadWaitRequests;
+		/// Paths of the requests waiting on resource sub-data reads, by AsyncLoader request ID.
+		HashMap< size_t, AssetPath > m_subDataWaits;
+		/// Lock guarding the ready queue, the waiting request lists, and request wait lists.
+		Mutex m_waitLock;
+
+		/// Incremented whenever a load request or package loader makes progress.
+		volatile int32_t m_progressCounter;
+		/// AsyncLoader completion count when sub-data reads were last checked.
+		int32_t m_polledCompletionCount;
+
+		/// Manifest being recorded, or null if no manifest is being recorded.
+		LoadManifest* m_pRecordingManifest;
+		/// Lock guarding the manifest being recorded.
+		Mutex m_recordingLock;
+
+		/// Manifest being replayed for prefetching, or null if not prefetching.
+		LoadManifest* m_pPrefetchManifest;
+		/// Index of the next prefetch manifest record to issue.
+		size_t m_prefetchRecordIndex;
+		/// Object loads issued for prefetching that have yet to be synced.
+		DynamicArray< PrefetchLoad > m_prefetchLoads;
+		/// Prefetched objects, each held until it is requested so that it is not destroyed before then.
+		HashMap< AssetPath, AssetPtr > m_prefetchedObjects;
+		/// Lock guarding the prefetch loads and prefetched objects.
+		Mutex m_prefetchLock;
+		/// Resource sub-data reads issued for prefetching that have yet to be synced.
+		DynamicArray< PrefetchRead > m_prefetchReads;
+		/// Number of bytes of prefetch reads in progress.
+		size_t m_prefetchReadSize;
+
+		/// Loaded resources kept resident within the memory budget.
+		ResidencyManager m_residencyManager;
+
+		/// @name Load Request Scheduling
+		//@{
+		size_t BeginLoadRequest( AssetPath path, bool forceReload );
+		void UpdateLoadRequest( LoadRequest* pRequest );
+		void WaitOnLoadRequest( LoadRequest* pRequest, LoadRequest* pBlockingRequest, int32_t blockingFlags );
+		void WakeWaitingRequests( LoadRequest* pRequest );
+		void WakePolledRequest( AssetPath path );
+		void WakeSubDataRequests();
+		bool HasSubDataWait( AssetPath path ) const;
+		void PushReadyRequest( LoadRequest* pRequest );
+		void ReleaseLoadRequest( LoadRequest* pRequest );
+		//@}
 
 		/// @name Load Process Updating
 		//@{
-		bool TickLoadRequest( LoadRequest* pRequest );
+		bool TickLoadRequest( LoadRequest* pRequest, size_t& rBlockingRequestId, int32_t& rBlockingFlags );
 		bool TickPreload( LoadRequest* pRequest );
-		bool TickLink( LoadRequest* pRequest );
-		bool TickPrecache( LoadRequest* pRequest );
+		bool TickLink( LoadRequest* pRequest, size_t& rBlockingRequestId );
+		bool TickPrecache( LoadRequest* pRequest, size_t& rBlockingRequestId );
 		bool TickFinalizeLoad( LoadRequest* pRequest );
 		//@}
+
+		/// @name Prefetching
+		//@{
+		void TickPrefetch();
+		bool BeginPrefetchRecord( const LoadManifest::Record& rRecord );
+		void ReleasePrefetchedObject( AssetPath path );
+		//@}
 	};
 
 	///////////////////////////////////////////////////////////////////////////
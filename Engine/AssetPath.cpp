@@ -5,6 +5,7 @@
 
 #include "Foundation/ReferenceCounting.h"
 #include "Engine/Asset.h"
+#include "Engine/AtomicLoad.h"
 
 struct Helium::AssetPath::PendingLink
 {
@@ -17,7 +18,8 @@ struct Helium::AssetPath::PendingLink
 
 using namespace Helium;
 
-AssetPath::TableBucket* AssetPath::sm_pTable = NULL;
+AssetPath::Table* volatile AssetPath::sm_pTable = NULL;
+Mutex* AssetPath::sm_pTableLock = NULL;
 StackMemoryHeap<>* AssetPath::sm_pEntryMemoryHeap = NULL;
 ObjectPool<AssetPath::PendingLink> *AssetPath::sm_pPendingLinksPool = NULL;
 
@@ -504,9 +506,20 @@ void AssetPath::Shutdown()
 {
 	HELIUM_TRACE( TraceLevels::Info, TXT( "Shutting down AssetPath table.\n" ) );
 
-	delete [] sm_pTable;
+	Table* pTable = sm_pTable;
+	while( pTable )
+	{
+		Table* pPreviousTable = pTable->pPrevious;
+		delete [] pTable->ppSlots;
+		delete pTable;
+		pTable = pPreviousTable;
+	}
+
 	sm_pTable = NULL;
 
+	delete sm_pTableLock;
+	sm_pTableLock = NULL;
+
 	delete sm_pEntryMemoryHeap;
 	sm_pEntryMemoryHeap = NULL;
 
@@ -834,7 +847,8 @@ bool AssetPath::Parse(
 
 /// Look up a table entry, adding it if it does not exist.
 ///
-/// This also handles lazy initialization of the path table and allocator.
+/// This also handles lazy initialization of the path table and allocator.  Looking up existing entries does not take
+/// any locks; only adding a new entry does.
 ///
 /// @param[in] rEntry  Entry to locate or add.
 ///
@@ -851,27 +865,140 @@ AssetPath::Entry* AssetPath::Add( const Entry& rEntry )
 		sm_pPendingLinksPool = new ObjectPool<PendingLink>( PENDING_LINKS_POOL_BLOCK_SIZE );
 		HELIUM_ASSERT( sm_pPendingLinksPool );
 
+		HELIUM_ASSERT( !sm_pTableLock );
+		sm_pTableLock = new Mutex;
+		HELIUM_ASSERT( sm_pTableLock );
+
 		HELIUM_ASSERT( !sm_pTable );
-		sm_pTable = new TableBucket [ TABLE_BUCKET_COUNT ];
+		sm_pTable = CreateTable( TABLE_INITIAL_CAPACITY );
 		HELIUM_ASSERT( sm_pTable );
 	}
 
-	HELIUM_ASSERT( sm_pTable );
+	size_t hash = ComputeEntryHash( rEntry );
+
+	// Search the current table without locking.  If the entry isn't found, it may have just been added by another
+	// thread (possibly to a newer table), so search again with the lock held before adding it.
+	Table* pTable = AtomicLoadAcquire( sm_pTable );
+	HELIUM_ASSERT( pTable );
+
+	size_t slotIndex;
+	Entry* pTableEntry = FindEntry( *pTable, rEntry, hash, slotIndex );
+	if( pTableEntry )
+	{
+		return pTableEntry;
+	}
+
+	MutexScopeLock tableLock( *sm_pTableLock );
+
+	pTable = sm_pTable;
+	pTableEntry = FindEntry( *pTable, rEntry, hash, slotIndex );
+	if( pTableEntry )
+	{
+		return pTableEntry;
+	}
+
+	// Grow the table once it is three quarters full to keep probe sequences short.
+	if( ( pTable->entryCount + 1 ) * 4 > pTable->capacity * 3 )
+	{
+		Table* pNewTable = CreateTable( pTable->capacity * 2 );
+		HELIUM_ASSERT( pNewTable );
+
+		size_t newSlotMask = pNewTable->capacity - 1;
+		for( size_t oldSlotIndex = 0; oldSlotIndex < pTable->capacity; ++oldSlotIndex )
+		{
+			Entry* pOldEntry = pTable->ppSlots[ oldSlotIndex ];
+			if( pOldEntry )
+			{
+				size_t newSlotIndex = pOldEntry->hash & newSlotMask;
+				while( pNewTable->ppSlots[ newSlotIndex ] )
+				{
+					newSlotIndex = ( newSlotIndex + 1 ) & newSlotMask;
+				}
+
+				pNewTable->ppSlots[ newSlotIndex ] = pOldEntry;
+			}
+		}
+
+		pNewTable->entryCount = pTable->entryCount;
+		pNewTable->pPrevious = pTable;
+
+		// Publish the new table only once it is completely filled in.
+		AtomicExchangeRelease( sm_pTable, pNewTable );
+		pTable = pNewTable;
+
+		pTableEntry = FindEntry( *pTable, rEntry, hash, slotIndex );
+		HELIUM_ASSERT( !pTableEntry );
+	}
+
+	HELIUM_ASSERT( sm_pEntryMemoryHeap );
+	Entry* pNewEntry = static_cast< Entry* >( sm_pEntryMemoryHeap->Allocate( sizeof( Entry ) ) );
+	HELIUM_ASSERT( pNewEntry );
+	new( pNewEntry ) Entry( rEntry );
+	pNewEntry->hash = hash;
+
+	// Publish the entry only once it is completely filled in.
+	++pTable->entryCount;
+	AtomicExchangeRelease( pTable->ppSlots[ slotIndex ], pNewEntry );
+
+	return pNewEntry;
+}
+
+/// Search a path table for an entry.
+///
+/// This is safe to call without holding the table lock.
+///
+/// @param[in]  rTable      Table to search.
+/// @param[in]  rEntry      Externally defined entry to match.
+/// @param[in]  hash        Entry hash, as computed by ComputeEntryHash().
+/// @param[out] rSlotIndex  If the entry is not found, set to the index of the empty slot at which it can be added.
+///
+/// @return  Table entry if found, null if not found.
+AssetPath::Entry* AssetPath::FindEntry( const Table& rTable, const Entry& rEntry, size_t hash, size_t& rSlotIndex )
+{
+	Entry* const volatile* ppSlots = rTable.ppSlots;
+	HELIUM_ASSERT( ppSlots );
+
+	size_t slotMask = rTable.capacity - 1;
+	for( size_t slotIndex = hash & slotMask; ; slotIndex = ( slotIndex + 1 ) & slotMask )
+	{
+		Entry* pTableEntry = AtomicLoadAcquire( ppSlots[ slotIndex ] );
+		if( !pTableEntry )
+		{
+			rSlotIndex = slotIndex;
+
+			return NULL;
+		}
+
+		if( pTableEntry->hash == hash && EntryContentsMatch( rEntry, *pTableEntry ) )
+		{
+			return pTableEntry;
+		}
+	}
+}
 
-	// Compute the entry's hash table index and retrieve the corresponding bucket.
-	uint32_t bucketIndex = ComputeEntryStringHash( rEntry ) % TABLE_BUCKET_COUNT;
-	TableBucket& rBucket = sm_pTable[ bucketIndex ];
+/// Allocate an empty path table.
+///
+/// @param[in] capacity  Number of slots (must be a power of two).
+///
+/// @return  Newly allocated table.
+AssetPath::Table* AssetPath::CreateTable( size_t capacity )
+{
+	HELIUM_ASSERT( capacity != 0 && ( capacity & ( capacity - 1 ) ) == 0 );
 
-	// Locate the entry in the table.  If it does not exist, add it.
-	size_t entryCount = 0;
-	Entry* pTableEntry = rBucket.Find( rEntry, entryCount );
-	if( !pTableEntry )
+	Table* pTable = new Table;
+	HELIUM_ASSERT( pTable );
+	pTable->ppSlots = new Entry* volatile [ capacity ];
+	HELIUM_ASSERT( pTable->ppSlots );
+	for( size_t slotIndex = 0; slotIndex < capacity; ++slotIndex )
 	{
-		pTableEntry = rBucket.Add( rEntry, entryCount );
-		HELIUM_ASSERT( pTableEntry );
+		pTable->ppSlots[ slotIndex ] = NULL;
 	}
 
-	return pTableEntry;
+	pTable->capacity = capacity;
+	pTable->entryCount = 0;
+	pTable->pPrevious = NULL;
+
+	return pTable;
 }
 
 /// Recursive function for building the string representation of an object path entry.
@@ -917,13 +1044,15 @@ void AssetPath::EntryToFilePathString( const Entry& rEntry, String& rString )
 	rString += rEntry.name.Get();
 }
 
-/// Compute a hash value for an object path entry based on the contents of the name strings (slow, should only be
-/// used internally when a string comparison is needed).
+/// Compute a hash value for an object path entry based on the contents of the name strings.
+///
+/// Parent entries are always in the table already, so their stored hashes are used instead of hashing the entire
+/// path again.
 ///
 /// @param[in] rEntry  Asset path entry.
 ///
 /// @return  Hash value.
-size_t AssetPath::ComputeEntryStringHash( const Entry& rEntry )
+size_t AssetPath::ComputeEntryHash( const Entry& rEntry )
 {
 	size_t hash = StringHash( rEntry.name.GetDirect() );
 	hash = ( ( hash * 33 ) ^ rEntry.instanceIndex );
@@ -935,8 +1064,7 @@ size_t AssetPath::ComputeEntryStringHash( const Entry& rEntry )
 	Entry* pParent = rEntry.pParent;
 	if( pParent )
 	{
-		size_t parentHash = ComputeEntryStringHash( *pParent );
-		hash = ( ( hash * 33 ) ^ parentHash );
+		hash = ( ( hash * 33 ) ^ pParent->hash );
 	}
 
 	return hash;
@@ -955,73 +1083,3 @@ bool AssetPath::EntryContentsMatch( const Entry& rEntry0, const Entry& rEntry1 )
 		( rEntry0.bPackage ? rEntry1.bPackage : !rEntry1.bPackage ) &&
 		rEntry0.pParent == rEntry1.pParent );
 }
-
-/// Find an existing object path entry in this table.
-///
-/// @param[in]  rEntry       Externally defined entry to match.
-/// @param[out] rEntryCount  Number of entries in this bucket when the search was performed.
-///
-/// @return  Table entry if found, null if not found.
-///
-/// @see Add()
-AssetPath::Entry* AssetPath::TableBucket::Find( const Entry& rEntry, size_t& rEntryCount )
-{
-	ScopeReadLock readLock( m_lock );
-
-	Entry* const * ppTableEntries = m_entries.GetData();
-	size_t entryCount = m_entries.GetSize();
-	HELIUM_ASSERT( ppTableEntries || entryCount == 0 );
-
-	rEntryCount = entryCount;
-
-	for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
-	{
-		Entry* pTableEntry = ppTableEntries[ entryIndex ];
-		HELIUM_ASSERT( pTableEntry );
-		if( EntryContentsMatch( rEntry, *pTableEntry ) )
-		{
-			return pTableEntry;
-		}
-	}
-
-	return NULL;
-}
-
-/// Add an object path entry to this table if it does not already exist.
-///
-/// @param[in] rEntry              Externally defined entry to locate or add.
-/// @param[in] previousEntryCount  Number of entries already checked during a previous Find() call (existing entries
-///                                are not expected to change).  In other words, the entry index from which to start
-///                                checking for any additional string entries that may have been added since the
-///                                previous Find() call.
-///
-/// @return  Pointer to the object path table entry.
-///
-/// @see Find()
-AssetPath::Entry* AssetPath::TableBucket::Add( const Entry& rEntry, size_t previousEntryCount )
-{
-	ScopeWriteLock writeLock( m_lock );
-
-	Entry* const * ppTableEntries = m_entries.GetData();
-	size_t entryCount = m_entries.GetSize();
-	HELIUM_ASSERT( ppTableEntries || entryCount == 0 );
-	HELIUM_ASSERT( previousEntryCount <= entryCount );
-	for( size_t entryIndex = previousEntryCount; entryIndex < entryCount; ++entryIndex )
-	{
-		Entry* pTableEntry = ppTableEntries[ entryIndex ];
-		HELIUM_ASSERT( pTableEntry );
-		if( EntryContentsMatch( rEntry, *pTableEntry ) )
-		{
-			return pTableEntry;
-		}
-	}
-
-	HELIUM_ASSERT( sm_pEntryMemoryHeap );
-	Entry* pNewEntry = static_cast< Entry* >( sm_pEntryMemoryHeap->Allocate( sizeof( Entry ) ) );
-	HELIUM_ASSERT( pNewEntry );
-	new( pNewEntry ) Entry( rEntry );
-
-	m_entries.Push( pNewEntry );
-
-	return pNewEntry;
-}
@@ -35,8 +35,8 @@ namespace Helium
 	class HELIUM_ENGINE_API AssetPath
 	{
 	public:
-		/// Number of object path hash table buckets (prime numbers are recommended).
-		static const size_t TABLE_BUCKET_COUNT = 37;
+		/// Initial number of object path hash table slots (must be a power of two).
+		static const size_t TABLE_INITIAL_CAPACITY = 1024;
 		/// Asset path stack memory heap block size.
 		static const size_t STACK_HEAP_BLOCK_SIZE = sizeof( char ) * 8192;
 		/// Block size for pool of pending links
@@ -110,31 +110,35 @@ namespace Helium
 			uint32_t instanceIndex;
 			/// True if the object is a package.
 			bool bPackage;
+			/// Hash of the entry contents (set when the entry is added to the table).
+			size_t hash;
 		};
 
-		/// Asset path hash table bucket.
-		class TableBucket
+		/// Open-addressed asset path hash table.
+		///
+		/// Entries are never removed, and slots are only ever changed from null to an entry, so lookups can probe the
+		/// table without any locking.  Adding entries and growing the table are serialized by the table lock.  A grown
+		/// table replaces the old one atomically, with old tables kept until shutdown for any lookups still using them.
+		struct Table
 		{
-		public:
-			/// @name Access
-			//@{
-			Entry* Find( const Entry& rEntry, size_t& rEntryCount );
-			Entry* Add( const Entry& rEntry, size_t previousEntryCount );
-			//@}
-
-		private:
-			/// Array of entry pointers.
-			DynamicArray< Entry* > m_entries;
-			/// Read-write lock for synchronizing access.
-			ReadWriteLock m_lock;
+			/// Entry slots (null if unused).
+			Entry* volatile* ppSlots;
+			/// Number of slots (always a power of two).
+			size_t capacity;
+			/// Number of used slots.
+			size_t entryCount;
+			/// Table replaced by this one when growing, or null if this is the initial table.
+			Table* pPrevious;
 		};
 
 		/// Asset path entry.
 		Entry* m_pEntry;
 
-		/// Asset path hash table.
-		static TableBucket* sm_pTable;
-		/// Stack-based memory heap for object path entry allocations.
+		/// Current asset path hash table.
+		static Table* volatile sm_pTable;
+		/// Lock serializing table additions.
+		static Mutex* sm_pTableLock;
+		/// Stack-based memory heap for object path entry allocations (guarded by the table lock).
 		static StackMemoryHeap<>* sm_pEntryMemoryHeap;
 		static ObjectPool<PendingLink> *sm_pPendingLinksPool;
 
@@ -150,11 +154,13 @@ namespace Helium
 			size_t& rNameCount, size_t& rPackageCount );
 
 		static Entry* Add( const Entry& rEntry );
+		static Entry* FindEntry( const Table& rTable, const Entry& rEntry, size_t hash, size_t& rSlotIndex );
+		static Table* CreateTable( size_t capacity );
 
 		static void EntryToString( const Entry& rEntry, String& rString );
 		static void EntryToFilePathString( const Entry& rEntry, String& rString );
 
-		static size_t ComputeEntryStringHash( const Entry& rEntry );
+		static size_t ComputeEntryHash( const Entry& rEntry );
 		static bool EntryContentsMatch( const Entry& rEntry0, const Entry& rEntry1 );
 		//@}
 	};
@@ -3,6 +3,7 @@
 
 #include "Engine/FileLocations.h"
 #include "Foundation/FileStream.h"
+#include "Platform/Timer.h"
 
 using namespace Helium;
 
@@ -11,9 +12,15 @@ AsyncLoader* AsyncLoader::sm_pInstance = NULL;
 /// Constructor.
 AsyncLoader::AsyncLoader()
 	: m_requestPool( REQUEST_POOL_BLOCK_SIZE )
-	, m_pThread( NULL )
-	, m_pWorker( NULL )
+	, m_pendingRequestCount( 0 )
+	, m_wakeUpCondition( false, false )
+	, m_idleCondition( true, true )
+	, m_completionCondition( false, false )
+	, m_completionCounter( 0 )
+	, m_stopCounter( 0 )
+	, m_fileGeneration( 0 )
 {
+	MemoryZero( &m_ioStats, sizeof( m_ioStats ) );
 }
 
 /// Destructor.
@@ -24,20 +31,49 @@ AsyncLoader::~AsyncLoader()
 
 /// Initialize the async loader.
 ///
+/// @param[in] workerCount  Number of worker threads used to service load requests.  Several workers allow reads to
+///                         overlap, which helps considerably on drives that handle deep request queues well.
+///
 /// @return  True if initialization was sucessful, false if not.
 ///
 /// @see Shutdown()
-bool AsyncLoader::Initialize()
+bool AsyncLoader::Initialize( size_t workerCount )
 {
 	Shutdown();
 
-	// Start up the async loading thread.
-	m_pWorker = new LoadWorker;
-	HELIUM_ASSERT( m_pWorker );
+	if( workerCount == 0 || workerCount > WORKER_COUNT_MAX )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			"AsyncLoader::Initialize(): Worker count %" PRIuSZ " is out of range, clamping to [1, %" PRIuSZ "].\n",
+			workerCount,
+			WORKER_COUNT_MAX );
+		workerCount = Clamp( workerCount, static_cast< size_t >( 1 ), WORKER_COUNT_MAX );
+	}
+
+	AtomicExchangeRelease( m_stopCounter, 0 );
+
+	// Start up the async loading threads.
+	m_workers.Reserve( workerCount );
+	m_threads.Reserve( workerCount );
+
+	// Split the open file budget between the workers.
+	size_t openFileLimit = Max( FILE_STREAM_LIMIT / workerCount, static_cast< size_t >( 1 ) );
+
+	String threadName;
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		LoadWorker* pWorker = new LoadWorker( *this, openFileLimit );
+		HELIUM_ASSERT( pWorker );
+		m_workers.Push( pWorker );
+
+		RunnableThread* pThread = new RunnableThread( pWorker );
+		HELIUM_ASSERT( pThread );
+		m_threads.Push( pThread );
 
-	m_pThread = new RunnableThread( m_pWorker );
-	HELIUM_ASSERT( m_pThread );
-	HELIUM_VERIFY( m_pThread->Start( TXT( "AsyncLoader - file loading" ) ) );
+		threadName.Format( TXT( "AsyncLoader - file loading %" ) PRIuSZ, workerIndex );
+		HELIUM_VERIFY( pThread->Start( threadName.GetData() ) );
+	}
 
 	return true;
 }
@@ -47,20 +83,32 @@ bool AsyncLoader::Initialize()
 /// @see Initialize()
 void AsyncLoader::Shutdown()
 {
-	if( m_pWorker )
+	AtomicExchangeRelease( m_stopCounter, 1 );
+
+	// Workers pass the wake-up on to each other as they exit, so one signal is enough to stop them all.
+	m_wakeUpCondition.Signal();
+
+	size_t threadCount = m_threads.GetSize();
+	for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
 	{
-		m_pWorker->Stop();
+		RunnableThread* pThread = m_threads[ threadIndex ];
+		HELIUM_ASSERT( pThread );
+		pThread->Join();
+		delete pThread;
 	}
 
-	if( m_pThread )
+	m_threads.Clear();
+
+	size_t workerCount = m_workers.GetSize();
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
 	{
-		m_pThread->Join();
-		delete m_pThread;
-		m_pThread = NULL;
+		delete m_workers[ workerIndex ];
 	}
 
-	delete m_pWorker;
-	m_pWorker = NULL;
+	m_workers.Clear();
+
+	// Consume any wake-up left over from the last worker to exit.
+	m_wakeUpCondition.Reset();
 }
 
 /// Queue an async load request.
@@ -80,12 +128,43 @@ size_t AsyncLoader::QueueRequest(
 	uint64_t offset,
 	size_t size,
 	EPriority priority )
+{
+	return QueueCompressedRequest( pBuffer, size, rFileName, offset, size, CompressionCodecs::None, priority );
+}
+
+/// Queue an async load request for compressed data.
+///
+/// The compressed data is read and then decompressed into the output buffer on the worker thread servicing the
+/// request.  If the output buffer is smaller than the decompressed data, only the leading bytes are kept.  The byte
+/// count reported when syncing the request is the number of decompressed bytes stored in the output buffer, or zero if
+/// the data could not be read in full or could not be decompressed.
+///
+/// @param[in] pBuffer      Buffer in which to store the decompressed data.
+/// @param[in] bufferSize   Size of the output buffer, in bytes.
+/// @param[in] rFileName    FilePath name of the file from which to load.
+/// @param[in] offset       Byte offset within the file from which to load.
+/// @param[in] size         Number of compressed bytes to read.
+/// @param[in] compression  Codec with which the data is compressed.
+/// @param[in] priority     Load priority.
+///
+/// @return  ID identifying the load request if queued successfully, invalid index if the request queue failed.
+///
+/// @see QueueRequest(), SyncRequest(), TrySyncRequest()
+size_t AsyncLoader::QueueCompressedRequest(
+	void* pBuffer,
+	size_t bufferSize,
+	const String& rFileName,
+	uint64_t offset,
+	size_t size,
+	CompressionCodec compression,
+	EPriority priority )
 {
 	HELIUM_ASSERT( pBuffer );
+	HELIUM_ASSERT( static_cast< size_t >( compression ) < static_cast< size_t >( CompressionCodecs::Count ) );
 	HELIUM_ASSERT( static_cast< size_t >( priority ) < static_cast< size_t >( PRIORITY_MAX ) );
 
-	// Make sure the load worker is running.
-	if( !m_pWorker )
+	// Make sure the load workers are running.
+	if( m_workers.IsEmpty() )
 	{
 		return Invalid< size_t >();
 	}
@@ -98,15 +177,88 @@ size_t AsyncLoader::QueueRequest(
 	pRequest->offset = offset;
 	pRequest->size = size;
 	pRequest->priority = priority;
+	pRequest->compression = compression;
+	pRequest->decompressedSize = bufferSize;
+	pRequest->pWorkCallback = NULL;
+	pRequest->pWorkData = NULL;
+
+	return EnqueueRequest( pRequest );
+}
+
+/// Queue work to be run on one of the worker threads.
+///
+/// Work requests are synced the same way as load requests, with the byte count reported always being zero.  Each
+/// work request runs on its own, so independent work queued together is spread across the available workers.
+///
+/// @param[in] pCallback  Function to run.
+/// @param[in] pData      Data to pass to the callback.
+/// @param[in] priority   Work priority.
+///
+/// @return  ID identifying the work request if queued successfully, invalid index if the request queue failed (in
+///          which case the caller should run the work itself).
+///
+/// @see SyncRequest(), TrySyncRequest()
+size_t AsyncLoader::QueueWork( WORK_CALLBACK* pCallback, void* pData, EPriority priority )
+{
+	HELIUM_ASSERT( pCallback );
+	HELIUM_ASSERT( static_cast< size_t >( priority ) < static_cast< size_t >( PRIORITY_MAX ) );
+
+	// Make sure the load workers are running.
+	if( m_workers.IsEmpty() )
+	{
+		return Invalid< size_t >();
+	}
+
+	Request* pRequest = m_requestPool.Allocate();
+	HELIUM_ASSERT( pRequest );
+	pRequest->pBuffer = NULL;
+	pRequest->fileName.Clear();
+	pRequest->offset = 0;
+	pRequest->size = 0;
+	pRequest->priority = priority;
+	pRequest->compression = CompressionCodecs::None;
+	pRequest->decompressedSize = 0;
+	pRequest->pWorkCallback = pCallback;
+	pRequest->pWorkData = pData;
+
+	return EnqueueRequest( pRequest );
+}
+
+/// Add an initialized request to the queue for its priority and wake up a worker to service it.
+///
+/// @param[in] pRequest  Request to queue.
+///
+/// @return  ID identifying the request.
+size_t AsyncLoader::EnqueueRequest( Request* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
 
 	pRequest->bytesRead = 0;
+	pRequest->queueTickCount = Timer::GetTickCount();
+	pRequest->completedCondition.Reset();
 	AtomicExchangeRelease( pRequest->processedCounter, 0 );
 
-	m_pWorker->QueueRequest( pRequest );
+	EPriority priority = pRequest->priority;
 
+	// Grab the ID while the request is still ours; once queued, a worker may pick it up at any time.
 	size_t requestIndex = m_requestPool.GetIndex( pRequest );
 	HELIUM_ASSERT( IsValid( requestIndex ) );
 
+	{
+		// Prevent access to the load queue while an exclusive write lock is held.
+		ScopeReadLock nonExclusiveLock( m_writeLock );
+
+		MutexScopeLock queueLock( m_queueLock );
+
+		m_requestQueues[ priority ].requests.Push( pRequest );
+		if( m_pendingRequestCount++ == 0 )
+		{
+			m_idleCondition.Reset();
+		}
+	}
+
+	m_wakeUpCondition.Signal();
+
 	return requestIndex;
 }
 
@@ -128,9 +280,10 @@ size_t AsyncLoader::SyncRequest( size_t id )
 	Request* pRequest = m_requestPool.GetObject( id );
 	HELIUM_ASSERT( pRequest );
 
+	// The condition is signaled just before the processed counter is set, so this may loop briefly.
 	while( pRequest->processedCounter == 0 )
 	{
-		Thread::Yield();
+		pRequest->completedCondition.Wait();
 	}
 
 	size_t bytesRead = pRequest->bytesRead;
@@ -169,15 +322,69 @@ bool AsyncLoader::TrySyncRequest( size_t id, size_t& rBytesRead )
 	return true;
 }
 
+/// Check whether the load request with the specified ID has completed, without releasing the request information.
+///
+/// The request must still be synced with SyncRequest() or TrySyncRequest() afterwards.
+///
+/// @param[in] id  Request ID.
+///
+/// @return  True if the request has completed, false if it is still pending or in progress.
+///
+/// @see TrySyncRequest()
+bool AsyncLoader::IsRequestComplete( size_t id )
+{
+	HELIUM_ASSERT( IsValid( id ) );
+
+	Request* pRequest = m_requestPool.GetObject( id );
+	HELIUM_ASSERT( pRequest );
+
+	return ( pRequest->processedCounter != 0 );
+}
+
 /// Block the current thread until all pending load requests have completed.
 ///
 /// Note that this does not release any requests.  SyncRequest() or TrySyncRequest() must still be called for all
 /// pending requests in order to free any associated resources.
 void AsyncLoader::Flush()
 {
-	if( m_pWorker )
+	if( !m_workers.IsEmpty() )
 	{
-		m_pWorker->Flush();
+		m_idleCondition.Wait();
+	}
+}
+
+/// Block the current thread until any load request completes.
+///
+/// @param[in] completionCount  Value previously returned by GetCompletionCount().  If any requests have completed
+///                             since that value was read, this returns immediately.
+///
+/// @return  True if requests have completed since the given completion count was read, false if there were no pending
+///          requests left to wait on.
+///
+/// @see GetCompletionCount()
+bool AsyncLoader::WaitForCompletion( int32_t completionCount )
+{
+	for( ; ; )
+	{
+		if( m_completionCounter != completionCount )
+		{
+			// Pass the wake-up on in case other threads are waiting as well.
+			m_completionCondition.Signal();
+
+			return true;
+		}
+
+		{
+			MutexScopeLock queueLock( m_queueLock );
+			if( m_pendingRequestCount == 0 )
+			{
+				// Completions are counted while the queue lock is held, so the request that emptied the queue after the
+				// check above is still reported.
+				return ( m_completionCounter != completionCount );
+			}
+		}
+
+		m_completionCondition.Wait();
 	}
 }
 
@@ -186,10 +393,10 @@ void AsyncLoader::Flush()
 /// @see Unlock()
 void AsyncLoader::Lock()
 {
-	if( m_pWorker )
-	{
-		m_pWorker->Lock();
-	}
+	// Prevent other threads from queueing requests or writing out data while we have a write lock.
+	m_writeLock.LockWrite();
+
+	Flush();
 }
 
 /// Unlock a previous loader lock.
@@ -197,173 +404,502 @@ void AsyncLoader::Lock()
 /// @see Lock()
 void AsyncLoader::Unlock()
 {
-	if( m_pWorker )
-	{
-		m_pWorker->Unlock();
-	}
+	// Files may have been replaced while we were locked, so make workers drop any handles they have cached.
+	AtomicIncrementRelease( m_fileGeneration );
+
+	m_writeLock.UnlockWrite();
 }
 
-/// Get the singleton AsyncLoader instance, creating it if necessary.
+/// Block the calling worker thread until requests are available.
+///
+/// The highest priority, oldest queued request is taken, along with any requests queued directly behind it that read
+/// the following bytes of the same file, so that they can be serviced by a single read.
+///
+/// @param[out] ppRequests  Array in which to store the requests taken.
+/// @param[in]  maxCount    Maximum number of requests to take.
 ///
-/// @return  Reference to the AsyncLoader instance.
+/// @return  Number of requests taken, or zero if the loader is shutting down.
 ///
-/// @see DestroyStaticInstance()
-AsyncLoader& AsyncLoader::GetStaticInstance()
+/// @see CompleteRequests()
+size_t AsyncLoader::WaitForRequests( Request** ppRequests, size_t maxCount )
 {
-	if( !sm_pInstance )
+	HELIUM_ASSERT( ppRequests );
+	HELIUM_ASSERT( maxCount != 0 );
+
+	for( ; ; )
 	{
-		sm_pInstance = new AsyncLoader;
-		HELIUM_ASSERT( sm_pInstance );
+		if( m_stopCounter != 0 )
+		{
+			// Pass the shutdown wake-up on to the next worker.
+			m_wakeUpCondition.Signal();
+
+			return 0;
+		}
+
+		size_t requestCount = 0;
+		bool bMoreQueued = false;
+		{
+			MutexScopeLock queueLock( m_queueLock );
+
+			for( size_t priorityIndex = PRIORITY_MAX; priorityIndex-- > 0; )
+			{
+				RequestQueue& rQueue = m_requestQueues[ priorityIndex ];
+				size_t queueSize = rQueue.requests.GetSize();
+				if( rQueue.head >= queueSize )
+				{
+					continue;
+				}
+
+				if( requestCount == 0 )
+				{
+					ppRequests[ requestCount++ ] = rQueue.requests[ rQueue.head++ ];
+
+					// Work requests are always run on their own.
+					while( requestCount < maxCount && rQueue.head < queueSize && !ppRequests[ 0 ]->pWorkCallback )
+					{
+						const Request* pPrevious = ppRequests[ requestCount - 1 ];
+						Request* pNext = rQueue.requests[ rQueue.head ];
+						if( pNext->pWorkCallback ||
+							pNext->offset != pPrevious->offset + pPrevious->size ||
+							pNext->fileName != pPrevious->fileName )
+						{
+							break;
+						}
+
+						ppRequests[ requestCount++ ] = pNext;
+						++rQueue.head;
+					}
+
+					if( rQueue.head == queueSize )
+					{
+						rQueue.requests.Resize( 0 );
+						rQueue.head = 0;
+						continue;
+					}
+				}
+
+				bMoreQueued = true;
+				break;
+			}
+		}
+
+		if( requestCount != 0 )
+		{
+			// Wake-ups can coalesce when several requests are queued at once, so make sure another worker picks up
+			// whatever is left.
+			if( bMoreQueued )
+			{
+				m_wakeUpCondition.Signal();
+			}
+
+			return requestCount;
+		}
+
+		// Queues are empty, so sleep until notified.
+		m_wakeUpCondition.Wait();
 	}
+}
 
-	return *sm_pInstance;
+/// Get the I/O statistics for all requests completed since the loader was created or ResetIoStats() was last
+/// called.
+///
+/// @param[out] rStats  Statistics.
+///
+/// @see ResetIoStats()
+void AsyncLoader::GetIoStats( IoStats& rStats ) const
+{
+	MutexScopeLock queueLock( m_queueLock );
+	rStats = m_ioStats;
 }
 
-/// Destroy the singleton AsyncLoader instance.
+/// Reset the I/O statistics.
 ///
-/// @see GetStaticInstance()
-void AsyncLoader::DestroyStaticInstance()
+/// @see GetIoStats()
+void AsyncLoader::ResetIoStats()
 {
-	if( sm_pInstance )
+	MutexScopeLock queueLock( m_queueLock );
+	MemoryZero( &m_ioStats, sizeof( m_ioStats ) );
+}
+
+/// Mark requests taken with WaitForRequests() as processed and wake up anything waiting on them.
+///
+/// @param[in] ppRequests       Processed requests.
+/// @param[in] requestCount     Number of processed requests.
+/// @param[in] startTickCount   Timer tick count when the worker started processing the requests.
+/// @param[in] processTicks     Time spent reading the requests or running the work request, in ticks.
+/// @param[in] decompressTicks  Time spent decompressing the data read, in ticks.
+///
+/// @see WaitForRequests()
+void AsyncLoader::CompleteRequests(
+	Request* const* ppRequests,
+	size_t requestCount,
+	uint64_t startTickCount,
+	uint64_t processTicks,
+	uint64_t decompressTicks )
+{
+	HELIUM_ASSERT( ppRequests || requestCount == 0 );
+
+	MutexScopeLock queueLock( m_queueLock );
+
+	if( requestCount != 0 )
+	{
+		if( ppRequests[ 0 ]->pWorkCallback )
+		{
+			++m_ioStats.workCount;
+			m_ioStats.workTicks += processTicks;
+		}
+		else
+		{
+			m_ioStats.readCount += requestCount;
+			++m_ioStats.readBatchCount;
+			m_ioStats.readTicks += processTicks;
+			m_ioStats.decompressTicks += decompressTicks;
+		}
+	}
+
+	for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+	{
+		Request* pRequest = ppRequests[ requestIndex ];
+		HELIUM_ASSERT( pRequest );
+
+		if( IsValid( pRequest->bytesRead ) )
+		{
+			m_ioStats.bytesRead += pRequest->bytesRead;
+		}
+
+		uint64_t queueWaitTicks = startTickCount - pRequest->queueTickCount;
+		m_ioStats.queueWaitTicks += queueWaitTicks;
+		m_ioStats.queueWaitTicksMax = Max( m_ioStats.queueWaitTicksMax, queueWaitTicks );
+
+		// The request may be released by another thread as soon as the processed counter is set, so it must be the
+		// last thing touched.
+		pRequest->completedCondition.Signal();
+		AtomicExchangeRelease( pRequest->processedCounter, 1 );
+	}
+
+	HELIUM_ASSERT( m_pendingRequestCount >= requestCount );
+	m_pendingRequestCount -= requestCount;
+	if( m_pendingRequestCount == 0 )
 	{
-		sm_pInstance->Shutdown();
-		delete sm_pInstance;
-		sm_pInstance = NULL;
+		m_idleCondition.Signal();
 	}
+
+	AtomicIncrementRelease( m_completionCounter );
+	m_completionCondition.Signal();
 }
 
 /// Constructor.
-AsyncLoader::LoadWorker::LoadWorker()
-	: m_wakeUpCondition( false, false )
-	, m_stopCounter( 0 )
-	, m_processingCounter( 0 )
+AsyncLoader::Request::Request()
+	: completedCondition( true, false )
 {
 }
 
+/// Constructor.
+AsyncLoader::RequestQueue::RequestQueue()
+	: head( 0 )
+{
+}
+
+/// Constructor.
+///
+/// @param[in] openFileLimit  Maximum number of files to keep open at once.
+AsyncLoader::FileReader::FileReader( size_t openFileLimit )
+	: m_openFileLimit( Max( openFileLimit, static_cast< size_t >( 1 ) ) )
+	, m_useCounter( 0 )
+{
+	m_openFiles.Reserve( m_openFileLimit );
+}
+
 /// Destructor.
-AsyncLoader::LoadWorker::~LoadWorker()
+AsyncLoader::FileReader::~FileReader()
 {
+	CloseAll();
 }
 
-/// Execute the async loading work.
-void AsyncLoader::LoadWorker::Run()
+/// Read a batch of requests.
+///
+/// All requests must be for the same file, with each one starting at the byte following the end of the previous one.
+/// The number of bytes read is stored in each request, or an invalid index if the file could not be opened.
+///
+/// @param[in] ppRequests    Requests to read.
+/// @param[in] requestCount  Number of requests.
+void AsyncLoader::FileReader::Read( Request* const* ppRequests, size_t requestCount )
 {
-	BufferedStream* pBufferedStream = new BufferedStream;
-	HELIUM_ASSERT( pBufferedStream );
+	HELIUM_ASSERT( ppRequests );
+	HELIUM_ASSERT( requestCount != 0 );
 
-	while( m_stopCounter == 0 )
-	{
-		AtomicExchangeAcquire( m_processingCounter, 1 );
+	const String& rFileName = ppRequests[ 0 ]->fileName;
 
-		Request* pRequest;
+	OpenFile* pOpenFile = NULL;
+	size_t openFileCount = m_openFiles.GetSize();
+	for( size_t fileIndex = 0; fileIndex < openFileCount; ++fileIndex )
+	{
+		if( m_openFiles[ fileIndex ].fileName == rFileName )
 		{
-			Locker< DynamicArray< Request* >, SpinLock >::Handle handle ( m_requestQueue );
-			pRequest = handle->IsEmpty() ? NULL : handle->Pop();
+			pOpenFile = &m_openFiles[ fileIndex ];
+			break;
 		}
-		if( !pRequest )
+	}
+
+	if( !pOpenFile )
+	{
+		void* pHandle = OpenHandle( rFileName );
+		if( !pHandle )
 		{
-			// Queue is empty, so sleep until notified.
-			AtomicExchangeRelease( m_processingCounter, 0 );
-			m_wakeUpCondition.Wait();
+			for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+			{
+				SetInvalid( ppRequests[ requestIndex ]->bytesRead );
+			}
 
-			continue;
+			return;
 		}
 
-		HELIUM_ASSERT( pRequest );
-
-		FileStream* pFileStream = FileStream::OpenFileStream( pRequest->fileName, FileStream::MODE_READ );
-		if( !pFileStream )
+		if( openFileCount < m_openFileLimit )
 		{
-			SetInvalid( pRequest->bytesRead );
+			pOpenFile = m_openFiles.New();
+			HELIUM_ASSERT( pOpenFile );
 		}
 		else
 		{
-			pRequest->bytesRead = 0;
-
-			pBufferedStream->Open( pFileStream );
-			int64_t offset = pBufferedStream->Seek( pRequest->offset, SeekOrigins::Begin );
-			if( static_cast< uint64_t >( offset ) == pRequest->offset )
+			// Evict the least recently used file.
+			pOpenFile = &m_openFiles[ 0 ];
+			for( size_t fileIndex = 1; fileIndex < openFileCount; ++fileIndex )
 			{
-				pRequest->bytesRead = pBufferedStream->Read( pRequest->pBuffer, 1, pRequest->size );
+				if( m_openFiles[ fileIndex ].lastUse < pOpenFile->lastUse )
+				{
+					pOpenFile = &m_openFiles[ fileIndex ];
+				}
 			}
 
-			pBufferedStream->Open( NULL );
-
-			delete pFileStream;
+			CloseHandle( pOpenFile->pHandle );
 		}
 
-		AtomicExchangeRelease( pRequest->processedCounter, 1 );
-
-		Thread::Yield();
+		pOpenFile->fileName = rFileName;
+		pOpenFile->pHandle = pHandle;
 	}
 
-	AtomicExchangeRelease( m_processingCounter, 0 );
+	pOpenFile->lastUse = ++m_useCounter;
 
-	delete pBufferedStream;
+	ReadHandle( pOpenFile->pHandle, ppRequests, requestCount );
 }
 
-/// Request the load worker to stop processing and return at the next possible opportunity.
-void AsyncLoader::LoadWorker::Stop()
+/// Close all files held open by this reader.
+void AsyncLoader::FileReader::CloseAll()
 {
-	AtomicExchangeRelease( m_stopCounter, 1 );
-	m_wakeUpCondition.Signal();
+	size_t openFileCount = m_openFiles.GetSize();
+	for( size_t fileIndex = 0; fileIndex < openFileCount; ++fileIndex )
+	{
+		CloseHandle( m_openFiles[ fileIndex ].pHandle );
+	}
+
+	m_openFiles.Resize( 0 );
 }
 
-/// Queue an async load request.
+#if !HELIUM_OS_LINUX
+
+/// Open a file for reading.
 ///
-/// @param[in] pRequest  Request to queue.  Note that the @c processedCounter value should be set to 0 prior to
-///                      calling this function (the worker thread will set it to 1 once the request has been
-///                      processed).
+/// @param[in] rFileName  Name of the file to open.
 ///
-/// @see Flush()
-void AsyncLoader::LoadWorker::QueueRequest( Request* pRequest )
+/// @return  Platform file handle, or null if the file could not be opened.
+void* AsyncLoader::FileReader::OpenHandle( const String& rFileName )
 {
-	HELIUM_ASSERT( pRequest );
-	HELIUM_ASSERT( pRequest->processedCounter == 0 );
+	return FileStream::OpenFileStream( rFileName, FileStream::MODE_READ );
+}
+
+/// Close a file opened with OpenHandle().
+///
+/// @param[in] pHandle  Platform file handle.
+void AsyncLoader::FileReader::CloseHandle( void* pHandle )
+{
+	delete static_cast< FileStream* >( pHandle );
+}
+
+/// Read a batch of adjacent requests from an open file.
+///
+/// @param[in] pHandle       Platform file handle.
+/// @param[in] ppRequests    Requests to read.
+/// @param[in] requestCount  Number of requests.
+void AsyncLoader::FileReader::ReadHandle( void* pHandle, Request* const* ppRequests, size_t requestCount )
+{
+	FileStream* pFileStream = static_cast< FileStream* >( pHandle );
+	HELIUM_ASSERT( pFileStream );
 
-	// Prevent access to the load queue while an exclusive write lock is held.
-	ScopeReadLock nonExclusiveLock( m_writeLock );
+	// The requests are adjacent, so one seek covers all of them.
+	int64_t offset = pFileStream->Seek( ppRequests[ 0 ]->offset, SeekOrigins::Begin );
+	bool bSeekSucceeded = ( static_cast< uint64_t >( offset ) == ppRequests[ 0 ]->offset );
 
+	for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
 	{
-		Locker< DynamicArray< Request* >, SpinLock >::Handle handle ( m_requestQueue );
-		handle->Push( pRequest );
-	}
+		Request* pRequest = ppRequests[ requestIndex ];
+		pRequest->bytesRead = 0;
 
-	m_wakeUpCondition.Signal();
+		if( bSeekSucceeded )
+		{
+			pRequest->bytesRead = pFileStream->Read( pRequest->pBuffer, 1, pRequest->size );
+
+			// Anything after a short read is past the end of the file.
+			bSeekSucceeded = ( pRequest->bytesRead == pRequest->size );
+		}
+	}
 }
 
-/// Block the current thread until all pending load requests have completed.
+#endif  // !HELIUM_OS_LINUX
+
+/// Constructor.
 ///
-/// @see QueueRequest()
-void AsyncLoader::LoadWorker::Flush()
+/// @param[in] rLoader        Loader from which to take requests.
+/// @param[in] openFileLimit  Maximum number of files this worker may keep open.
+AsyncLoader::LoadWorker::LoadWorker( AsyncLoader& rLoader, size_t openFileLimit )
+	: m_rLoader( rLoader )
+	, m_openFileLimit( openFileLimit )
 {
-	bool isEmpty;
-	{
-		Locker< DynamicArray< Request* >, SpinLock >::Handle handle ( m_requestQueue );
-		isEmpty = handle->IsEmpty();
-	}
+}
+
+/// Destructor.
+AsyncLoader::LoadWorker::~LoadWorker()
+{
+}
 
-	while( m_processingCounter != 0 && !isEmpty )
+/// Execute the async loading work.
+void AsyncLoader::LoadWorker::Run()
+{
+	FileReader reader( m_openFileLimit );
+	int32_t fileGeneration = m_rLoader.m_fileGeneration;
+
+	Request* requests[ REQUEST_BATCH_MAX ];
+	for( ; ; )
 	{
-		Thread::Yield();
+		size_t requestCount = m_rLoader.WaitForRequests( requests, HELIUM_ARRAY_COUNT( requests ) );
+		if( requestCount == 0 )
+		{
+			break;
+		}
+
+		if( fileGeneration != m_rLoader.m_fileGeneration )
+		{
+			fileGeneration = m_rLoader.m_fileGeneration;
+			reader.CloseAll();
+		}
+
+		uint64_t startTickCount = Timer::GetTickCount();
+		uint64_t processTicks;
+		uint64_t decompressTicks = 0;
+
+		Request* pFirstRequest = requests[ 0 ];
+		if( pFirstRequest->pWorkCallback )
+		{
+			HELIUM_ASSERT( requestCount == 1 );
+			pFirstRequest->pWorkCallback( pFirstRequest->pWorkData );
+
+			processTicks = Timer::GetTickCount() - startTickCount;
+		}
+		else
+		{
+			BeginDecompress( requests, requestCount );
+			reader.Read( requests, requestCount );
+
+			uint64_t readEndTickCount = Timer::GetTickCount();
+			processTicks = readEndTickCount - startTickCount;
+
+			FinishDecompress( requests, requestCount );
+
+			decompressTicks = Timer::GetTickCount() - readEndTickCount;
+		}
+
+		m_rLoader.CompleteRequests( requests, requestCount, startTickCount, processTicks, decompressTicks );
 	}
 }
 
-/// Acquire an exclusive lock for writing to files and flush the async loader queue.
+/// Redirect the reads of any compressed requests in a batch into scratch space.
 ///
-/// @see Unlock()
-void AsyncLoader::LoadWorker::Lock()
+/// @param[in] ppRequests    Requests about to be read.
+/// @param[in] requestCount  Number of requests.
+///
+/// @see FinishDecompress()
+void AsyncLoader::LoadWorker::BeginDecompress( Request* const* ppRequests, size_t requestCount )
 {
-	// Prevent other threads from queueing requests or writing out data while we have a write lock.
-	m_writeLock.LockWrite();
+	HELIUM_ASSERT( requestCount <= REQUEST_BATCH_MAX );
 
-	Flush();
+	size_t compressedSize = 0;
+	for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+	{
+		const Request* pRequest = ppRequests[ requestIndex ];
+		if( pRequest->compression != CompressionCodecs::None )
+		{
+			compressedSize += pRequest->size;
+		}
+	}
+
+	if( compressedSize == 0 )
+	{
+		return;
+	}
+
+	m_compressedData.Resize( compressedSize );
+
+	uint8_t* pCompressedData = m_compressedData.GetData();
+	for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+	{
+		Request* pRequest = ppRequests[ requestIndex ];
+		if( pRequest->compression != CompressionCodecs::None )
+		{
+			m_decompressBuffers[ requestIndex ] = pRequest->pBuffer;
+			pRequest->pBuffer = pCompressedData;
+			pCompressedData += pRequest->size;
+		}
+	}
 }
 
-/// Release an exclusive lock for writing to files.
+/// Decompress the data read for any compressed requests in a batch into their output buffers.
 ///
-/// @see Lock()
-void AsyncLoader::LoadWorker::Unlock()
+/// @param[in] ppRequests    Requests that have been read.
+/// @param[in] requestCount  Number of requests.
+///
+/// @see BeginDecompress()
+void AsyncLoader::LoadWorker::FinishDecompress( Request* const* ppRequests, size_t requestCount )
 {
-	m_writeLock.UnlockWrite();
+	for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+	{
+		Request* pRequest = ppRequests[ requestIndex ];
+		if( pRequest->compression == CompressionCodecs::None )
+		{
+			continue;
+		}
+
+		const void* pCompressedData = pRequest->pBuffer;
+		pRequest->pBuffer = m_decompressBuffers[ requestIndex ];
+
+		// Leave the result alone if the file couldn't be opened.
+		if( IsInvalid( pRequest->bytesRead ) )
+		{
+			continue;
+		}
+
+		size_t decompressedSize = 0;
+		if( pRequest->bytesRead == pRequest->size )
+		{
+			decompressedSize = Compression::DecompressBlock(
+				pRequest->compression,
+				pCompressedData,
+				pRequest->size,
+				pRequest->pBuffer,
+				pRequest->decompressedSize );
+		}
+
+		if( IsInvalid( decompressedSize ) || pRequest->bytesRead != pRequest->size )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				( TXT( "AsyncLoader: Failed to decompress %" ) PRIuSZ TXT( " bytes at offset %" ) PRIu64
+				TXT( " in \"%s\".\n" ) ),
+				pRequest->size,
+				pRequest->offset,
+				*pRequest->fileName );
+
+			decompressedSize = 0;
+		}
+
+		pRequest->bytesRead = decompressedSize;
+	}
 }
@@ -9,6 +9,7 @@
 #include "Foundation/String.h"
 
 #include "Engine/Engine.h"
+#include "Engine/Compression.h"
 
 #ifdef _MSC_VER
 #pragma warning( push )
@@ -22,13 +23,26 @@
 namespace Helium
 {
 	/// Async loading manager.
+	///
+	/// Requests are serviced by a pool of worker threads.  Each priority level has its own queue; workers always take
+	/// the oldest request from the highest priority queue that has one, so high priority loads never wait behind a
+	/// backlog of lower priority requests for anything more than the reads already in flight.
+	///
+	/// Besides file reads, CPU work such as deserializing loaded data can be queued with QueueWork() so that it runs on
+	/// the same worker threads and is synced through the same request interface.
 	class HELIUM_ENGINE_API AsyncLoader : NonCopyable
 	{
 	public:
 		/// Request pool block size.
 		static const size_t REQUEST_POOL_BLOCK_SIZE = 128;
-		/// Maximum number of open file streams.
+		/// Maximum number of open file streams (shared between all workers).
 		static const size_t FILE_STREAM_LIMIT = 16;
+		/// Maximum number of adjacent requests serviced by a single read.
+		static const size_t REQUEST_BATCH_MAX = 16;
+		/// Number of worker threads started if no count is given to Initialize().
+		static const size_t DEFAULT_WORKER_COUNT = 4;
+		/// Maximum number of worker threads.
+		static const size_t WORKER_COUNT_MAX = 32;
 
 		/// Load request priority.
 		enum EPriority
@@ -44,10 +58,41 @@ namespace Helium
 			PRIORITY_LAST = PRIORITY_MAX - 1
 		};
 
+		/// Callback run on a worker thread for work queued with QueueWork().
+		typedef void ( WORK_CALLBACK )( void* pData );
+
+		/// Aggregate statistics for all requests completed since the loader was created or the statistics were
+		/// last reset.  Times are in timer ticks.
+		struct IoStats
+		{
+			/// Number of read requests completed.
+			uint64_t readCount;
+			/// Number of batched reads issued to service the read requests.
+			uint64_t readBatchCount;
+			/// Number of bytes delivered to read requests (after decompression).
+			uint64_t bytesRead;
+			/// Time spent reading files.
+			uint64_t readTicks;
+			/// Time spent decompressing read data.
+			uint64_t decompressTicks;
+
+			/// Number of work requests completed.
+			uint64_t workCount;
+			/// Time spent running work requests.
+			uint64_t workTicks;
+
+			/// Total time requests spent queued before a worker picked them up.
+			uint64_t queueWaitTicks;
+			/// Longest time a single request spent queued.
+			uint64_t queueWaitTicksMax;
+		};
+
 		/// @name Initialization
 		//@{
-		bool Initialize();
+		bool Initialize( size_t workerCount = DEFAULT_WORKER_COUNT );
 		void Shutdown();
+
+		inline size_t GetWorkerCount() const;
 		//@}
 
 		/// @name Load Request Management
@@ -55,15 +100,29 @@ namespace Helium
 		size_t QueueRequest(
 			void* pBuffer, const String& rFileName, uint64_t offset, size_t size,
 			EPriority priority = PRIORITY_NORMAL );
+		size_t QueueCompressedRequest(
+			void* pBuffer, size_t bufferSize, const String& rFileName, uint64_t offset, size_t size,
+			CompressionCodec compression, EPriority priority = PRIORITY_NORMAL );
+		size_t QueueWork( WORK_CALLBACK* pCallback, void* pData, EPriority priority = PRIORITY_NORMAL );
 		size_t SyncRequest( size_t id );
 		bool TrySyncRequest( size_t id, size_t& rBytesRead );
+		bool IsRequestComplete( size_t id );
 
 		void Flush();
 
+		inline int32_t GetCompletionCount() const;
+		bool WaitForCompletion( int32_t completionCount );
+
 		void Lock();
 		void Unlock();
 		//@}
 
+		/// @name Statistics
+		//@{
+		void GetIoStats( IoStats& rStats ) const;
+		void ResetIoStats();
+		//@}
+
 		/// @name Static Access
 		//@{
 		static AsyncLoader& GetStaticInstance();
@@ -85,10 +144,77 @@ namespace Helium
 			/// Priority.
 			EPriority priority;
 
+			/// Codec with which the data in the file is compressed.
+			CompressionCodec compression;
+			/// Size of the output buffer for compressed requests (the data read is decompressed into the output buffer
+			/// once the read completes).
+			size_t decompressedSize;
+
+			/// Timer tick count when this request was queued.
+			uint64_t queueTickCount;
+
+			/// Callback to run instead of reading a file, or null if this is a read request.
+			WORK_CALLBACK* pWorkCallback;
+			/// Data passed to the work callback.
+			void* pWorkData;
+
 			/// Number of bytes read.
 			volatile size_t bytesRead;
 			/// Set to a non-zero value once this request has been processed.
 			volatile int32_t processedCounter;
+			/// Signaled once this request has been processed.
+			Condition completedCondition;
+
+			/// @name Construction/Destruction
+			//@{
+			Request();
+			//@}
+		};
+
+		/// Reads batches of requests, keeping the most recently used files open between batches.
+		///
+		/// The handle type and the read itself are platform specific.  On Linux, handles are file descriptors and each
+		/// batch is read straight into the request buffers with a single positional vector read.
+		class FileReader : NonCopyable
+		{
+		public:
+			/// @name Construction/Destruction
+			//@{
+			explicit FileReader( size_t openFileLimit );
+			~FileReader();
+			//@}
+
+			/// @name Reading
+			//@{
+			void Read( Request* const* ppRequests, size_t requestCount );
+			void CloseAll();
+			//@}
+
+		private:
+			/// Cached open file.
+			struct OpenFile
+			{
+				/// File name.
+				String fileName;
+				/// Platform file handle.
+				void* pHandle;
+				/// Value of the use counter when this file was last read.
+				uint64_t lastUse;
+			};
+
+			/// Open files.
+			DynamicArray< OpenFile > m_openFiles;
+			/// Maximum number of files to keep open.
+			size_t m_openFileLimit;
+			/// Incremented on each read, used to find the least recently used file.
+			uint64_t m_useCounter;
+
+			/// @name Platform Support
+			//@{
+			static void* OpenHandle( const String& rFileName );
+			static void CloseHandle( void* pHandle );
+			static void ReadHandle( void* pHandle, Request* const* ppRequests, size_t requestCount );
+			//@}
 		};
 
 		/// Async loading thread runnable.
@@ -97,7 +223,7 @@ namespace Helium
 		public:
 			/// @name Construction/Destruction
 			//@{
-			LoadWorker();
+			LoadWorker( AsyncLoader& rLoader, size_t openFileLimit );
 			virtual ~LoadWorker();
 			//@}
 
@@ -106,42 +232,71 @@ namespace Helium
 			virtual void Run();
 			//@}
 
-			/// @name External Thread Control
+		private:
+			/// Loader from which requests are taken.
+			AsyncLoader& m_rLoader;
+			/// Maximum number of files this worker keeps open.
+			size_t m_openFileLimit;
+
+			/// Scratch space into which compressed data is read.
+			DynamicArray< uint8_t > m_compressedData;
+			/// Output buffers of the compressed requests in the current batch.
+			void* m_decompressBuffers[ REQUEST_BATCH_MAX ];
+
+			/// @name Decompression
 			//@{
-			void Stop();
+			void BeginDecompress( Request* const* ppRequests, size_t requestCount );
+			void FinishDecompress( Request* const* ppRequests, size_t requestCount );
 			//@}
+		};
 
-			/// @name External Request Queue Control
-			//@{
-			void QueueRequest( Request* pRequest );
-			void Flush();
+		/// FIFO queue of requests sharing a single priority.
+		struct RequestQueue
+		{
+			/// Queued requests.  Entries before the head index have already been taken.
+			DynamicArray< Request* > requests;
+			/// Index of the oldest request still in the queue.
+			size_t head;
 
-			void Lock();
-			void Unlock();
+			/// @name Construction/Destruction
+			//@{
+			RequestQueue();
 			//@}
-
-		private:
-			/// Async load request queue.
-			Locker< DynamicArray< Request* >, SpinLock > m_requestQueue;
-			/// Condition used to wake up the worker thread when load requests are queued (or when it should shut down).
-			Condition m_wakeUpCondition;
-
-			/// Read-write lock used for synchronization of external file writes.
-			ReadWriteLock m_writeLock;
-
-			/// Non-zero if this thread should stop when next possible, zero if it should continue.
-			volatile int32_t m_stopCounter;
-			/// Non-zero if this thread is currently processing a load request.
-			volatile int32_t m_processingCounter;
 		};
 
 		/// Pool of async load request objects.
 		ObjectPool< Request > m_requestPool;
 
-		/// Async loading thread.
-		RunnableThread* m_pThread;
-		/// Async loading thread worker.
-		LoadWorker* m_pWorker;
+		/// Per-priority request queues.
+		RequestQueue m_requestQueues[ PRIORITY_MAX ];
+		/// Lock guarding the request queues, pending request count, and statistics.
+		mutable Mutex m_queueLock;
+		/// Number of requests queued or being processed.
+		size_t m_pendingRequestCount;
+		/// Statistics for completed requests.
+		IoStats m_ioStats;
+
+		/// Condition used to wake up a worker thread when load requests are queued (or when workers should shut down).
+		Condition m_wakeUpCondition;
+		/// Condition signaled while there are no queued or in-progress requests.
+		Condition m_idleCondition;
+		/// Condition signaled whenever requests complete.
+		Condition m_completionCondition;
+		/// Incremented whenever requests complete.
+		volatile int32_t m_completionCounter;
+
+		/// Read-write lock used for synchronization of external file writes.
+		ReadWriteLock m_writeLock;
+
+		/// Non-zero if worker threads should stop when next possible, zero if they should continue.
+		volatile int32_t m_stopCounter;
+		/// Incremented whenever files may have been rewritten, so workers know to reopen anything they hold open.
+		volatile int32_t m_fileGeneration;
+
+		/// Async loading threads.
+		DynamicArray< RunnableThread* > m_threads;
+		/// Async loading thread workers.
+		DynamicArray< LoadWorker* > m_workers;
 
 		/// Singleton instance.
 		static AsyncLoader* sm_pInstance;
@@ -151,5 +306,16 @@ namespace Helium
 		AsyncLoader();
 		~AsyncLoader();
 		//@}
+
+		/// @name Worker Support
+		//@{
+		size_t EnqueueRequest( Request* pRequest );
+		size_t WaitForRequests( Request** ppRequests, size_t maxCount );
+		void CompleteRequests(
+			Request* const* ppRequests, size_t requestCount, uint64_t startTickCount, uint64_t processTicks,
+			uint64_t decompressTicks );
+		//@}
 	};
 }
+
+#include "Engine/AsyncLoader.inl"
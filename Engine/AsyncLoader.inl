@@ -0,0 +1,22 @@
+/// Get the number of worker threads servicing load requests.
+///
+/// @return  Worker thread count, or zero if the loader is not initialized.
+///
+/// @see Initialize()
+size_t Helium::AsyncLoader::GetWorkerCount() const
+{
+	return m_workers.GetSize();
+}
+
+/// Get a counter that changes whenever load requests complete.
+///
+/// Comparing the value against one read earlier tells whether any requests have completed in the meantime, without
+/// needing to check each request individually.
+///
+/// @return  Request completion counter.
+///
+/// @see WaitForCompletion()
+int32_t Helium::AsyncLoader::GetCompletionCount() const
+{
+	return m_completionCounter;
+}
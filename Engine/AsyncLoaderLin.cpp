@@ -0,0 +1,119 @@
+#include "EnginePch.h"
+#include "Engine/AsyncLoader.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+using namespace Helium;
+
+// File descriptors are stored in the handle pointer offset by one so that descriptor zero is not mistaken for a
+// failed open.
+static inline int HandleToDescriptor( void* pHandle )
+{
+	return static_cast< int >( reinterpret_cast< intptr_t >( pHandle ) - 1 );
+}
+
+/// Open a file for reading.
+///
+/// @param[in] rFileName  Name of the file to open.
+///
+/// @return  Platform file handle, or null if the file could not be opened.
+void* AsyncLoader::FileReader::OpenHandle( const String& rFileName )
+{
+	int fd;
+	do
+	{
+		fd = open( rFileName.GetData(), O_RDONLY | O_CLOEXEC );
+	} while( fd < 0 && errno == EINTR );
+
+	if( fd < 0 )
+	{
+		return NULL;
+	}
+
+	// Most cache reads walk forward through the file.
+	posix_fadvise( fd, 0, 0, POSIX_FADV_SEQUENTIAL );
+
+	return reinterpret_cast< void* >( static_cast< intptr_t >( fd ) + 1 );
+}
+
+/// Close a file opened with OpenHandle().
+///
+/// @param[in] pHandle  Platform file handle.
+void AsyncLoader::FileReader::CloseHandle( void* pHandle )
+{
+	HELIUM_ASSERT( pHandle );
+	close( HandleToDescriptor( pHandle ) );
+}
+
+/// Read a batch of adjacent requests from an open file.
+///
+/// The whole batch is read with positional vector reads straight into the request buffers, so no file position is
+/// shared between workers and no intermediate copy is made.
+///
+/// @param[in] pHandle       Platform file handle.
+/// @param[in] ppRequests    Requests to read.
+/// @param[in] requestCount  Number of requests.
+void AsyncLoader::FileReader::ReadHandle( void* pHandle, Request* const* ppRequests, size_t requestCount )
+{
+	HELIUM_ASSERT( pHandle );
+	HELIUM_ASSERT( requestCount <= REQUEST_BATCH_MAX );
+
+	int fd = HandleToDescriptor( pHandle );
+
+	iovec vectors[ REQUEST_BATCH_MAX ];
+	for( size_t requestIndex = 0; requestIndex < requestCount; ++requestIndex )
+	{
+		Request* pRequest = ppRequests[ requestIndex ];
+		pRequest->bytesRead = 0;
+
+		vectors[ requestIndex ].iov_base = pRequest->pBuffer;
+		vectors[ requestIndex ].iov_len = pRequest->size;
+	}
+
+	// Keep reading until everything is in, the end of the file is hit, or an error occurs.  A short read advances
+	// through the vectors, marking each request with however much of it made it in.
+	size_t requestIndex = 0;
+	off_t offset = static_cast< off_t >( ppRequests[ 0 ]->offset );
+	while( requestIndex < requestCount )
+	{
+		ssize_t result = preadv( fd, vectors + requestIndex, static_cast< int >( requestCount - requestIndex ), offset );
+		if( result < 0 && errno == EINTR )
+		{
+			continue;
+		}
+
+		if( result <= 0 )
+		{
+			break;
+		}
+
+		offset += result;
+
+		size_t remaining = static_cast< size_t >( result );
+		while( remaining != 0 && requestIndex < requestCount )
+		{
+			Request* pRequest = ppRequests[ requestIndex ];
+			iovec& rVector = vectors[ requestIndex ];
+
+			size_t consumed = Min( remaining, rVector.iov_len );
+			pRequest->bytesRead += consumed;
+			rVector.iov_base = static_cast< uint8_t* >( rVector.iov_base ) + consumed;
+			rVector.iov_len -= consumed;
+			remaining -= consumed;
+
+			if( rVector.iov_len == 0 )
+			{
+				++requestIndex;
+			}
+		}
+
+		// Skip over any zero-sized requests so they don't stall the loop.
+		while( requestIndex < requestCount && vectors[ requestIndex ].iov_len == 0 )
+		{
+			++requestIndex;
+		}
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "Platform/Atomic.h"
+
+#include "Engine/Engine.h"
+
+namespace Helium
+{
+	/// Read a pointer published by another thread with AtomicExchangeRelease().
+	///
+	/// The read has acquire semantics, so the data the pointer refers to is visible once the pointer is.  Unlike the
+	/// compare-exchange based acquire operations, this does not write to the shared cache line.
+	///
+	/// @param[in] rAtomic  Pointer to read.
+	///
+	/// @return  Pointer value.
+	template< typename T >
+	T* AtomicLoadAcquire( T* const volatile& rAtomic )
+	{
+#if HELIUM_CC_CL
+		// Volatile reads have acquire semantics with Visual C++.
+		return rAtomic;
+#else
+		return __atomic_load_n( &rAtomic, __ATOMIC_ACQUIRE );
+#endif
+	}
+}
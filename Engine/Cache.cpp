@@ -4,10 +4,17 @@
 #include "Foundation/FileStream.h"
 #include "Foundation/MemoryStream.h"
 #include "Foundation/StringConverter.h"
+#include "Foundation/FilePath.h"
+#include "Platform/Atomic.h"
+#include "Platform/Thread.h"
 
 #include "Engine/Asset.h"
 #include "Engine/FileLocations.h"
 #include "Engine/AsyncLoader.h"
+#include "Engine/Fnv1aHasher.h"
+
+#include <algorithm>
+#include <cstring>
 
 #define USE_BSON_FOR_CACHE_FORMAT 0
 #define USE_JSON_FOR_CACHE_FORMAT 1
@@ -33,7 +40,53 @@ static const uint32_t TOC_MAGIC = 0xcac4e70c;
 /// TOC header magic number (byte-swapped).
 static const uint32_t TOC_MAGIC_SWAPPED = 0x0ce7c4ca;
 /// Cache format version number.
-const uint32_t Cache::sm_Version = 0;
+///
+/// Version 0 TOCs store an entry count followed by exactly that many entry records.  From version 1 onward, the TOC
+/// is a journal: the header is followed by any number of entry records, appended as entries are cached, with later
+/// records for an entry superseding earlier ones.  Version 2 adds the compression codec and stored size of each entry
+/// to its record.
+const uint32_t Cache::sm_Version = 2;
+
+/// Cooked index header magic number.
+static const uint32_t INDEX_MAGIC = 0xcac41d3c;
+/// Cooked index header magic number for indexes written on a platform with the opposite byte order.
+static const uint32_t INDEX_MAGIC_SWAPPED = 0x3c1dc4ca;
+/// Cooked index format version number.
+static const uint32_t INDEX_VERSION = 0;
+
+/// Extension appended to the cache file name for the temporary file written during compaction.
+#define HELIUM_CACHE_COMPACT_EXTENSION TXT( ".compact" )
+/// Extension appended to the cache file name for the temporary file written by Rebuild().
+#define HELIUM_CACHE_REBUILD_EXTENSION TXT( ".rebuild" )
+/// Extension appended to the cooked index file name for the temporary file written by WriteIndex().
+#define HELIUM_CACHE_INDEX_TEMP_EXTENSION TXT( ".tmp" )
+
+namespace Helium
+{
+	/// Runnable for compacting a cache on a background thread.
+	class Cache::CompactWorker : public Runnable
+	{
+	public:
+		/// Cache to compact.
+		Cache& m_rCache;
+		/// Number of bytes reclaimed by compaction.
+		uint64_t m_reclaimedBytes;
+		/// True if compaction succeeded.
+		bool m_bSucceeded;
+		/// Non-zero once compaction has finished.
+		volatile int32_t m_finishedCounter;
+
+		/// @name Construction/Destruction
+		//@{
+		explicit CompactWorker( Cache& rCache );
+		//@}
+
+		/// @name Runnable Interface
+		//@{
+		virtual void Run();
+		//@}
+	};
+}
 
 /// Constructor.
 Cache::Cache()
@@ -43,7 +96,17 @@ Cache::Cache()
 , m_asyncLoadId( Invalid< size_t >() )
 , m_pTocBuffer( NULL )
 , m_tocSize( Invalid< uint32_t >() )
+, m_bTocJournalValid( false )
+, m_pMappedData( NULL )
+, m_mappedSize( 0 )
+, m_pIndexData( NULL )
+, m_indexSize( 0 )
+, m_pIndexRecords( NULL )
+, m_pIndexStrings( NULL )
 , m_pEntryPool( NULL )
+, m_compression( CompressionCodecs::None )
+, m_pCompactWorker( NULL )
+, m_pCompactThread( NULL )
 {
 }
 
@@ -64,11 +127,17 @@ Cache::~Cache()
 /// @param[in] platform        Cache platform identifier.
 /// @param[in] pTocFileName    FilePath name of the table of contents file.
 /// @param[in] pCacheFileName  FilePath name of the cache file.
+/// @param[in] pIndexFileName  FilePath name of the cooked index file, or null if the cache has no cooked index.
 ///
 /// @return  True if initialization was successful, false if not.
 ///
 /// @see Shutdown(), BeginLoadToc()
-bool Cache::Initialize( Name name, EPlatform platform, const char* pTocFileName, const char* pCacheFileName )
+bool Cache::Initialize(
+	Name name,
+	EPlatform platform,
+	const char* pTocFileName,
+	const char* pCacheFileName,
+	const char* pIndexFileName )
 {
 	HELIUM_ASSERT( !name.IsEmpty() );
 	HELIUM_ASSERT( static_cast< size_t >( platform ) < static_cast< size_t >( PLATFORM_MAX ) );
@@ -95,6 +164,10 @@ bool Cache::Initialize( Name name, EPlatform platform, const char* pTocFileName,
 
 	m_tocFileName = pTocFileName;
 	m_cacheFileName = pCacheFileName;
+	if( pIndexFileName )
+	{
+		m_indexFileName = pIndexFileName;
+	}
 
 	m_tocSize = static_cast< uint32_t >( tocSize64 );
 
@@ -110,11 +183,24 @@ bool Cache::Initialize( Name name, EPlatform platform, const char* pTocFileName,
 /// @see Initialize()
 void Cache::Shutdown()
 {
+	if( m_pCompactWorker )
+	{
+		m_pCompactThread->Join();
+
+		bool bSucceeded;
+		uint64_t reclaimedBytes;
+		HELIUM_VERIFY( TryFinishCompact( bSucceeded, reclaimedBytes ) );
+	}
+
+	UnmapCacheFile();
+	UnmapIndex();
+
 	m_name = NULL_NAME;
 	m_platform = PLATFORM_INVALID;
 
 	m_tocFileName.Clear();
 	m_cacheFileName.Clear();
+	m_indexFileName.Clear();
 
 	if( IsValid( m_asyncLoadId ) )
 	{
@@ -127,6 +213,7 @@ void Cache::Shutdown()
 	SetInvalid( m_tocSize );
 
 	m_bTocLoaded = false;
+	m_bTocJournalValid = false;
 
 	m_entries.Clear();
 	m_entryMap.Clear();
@@ -139,9 +226,12 @@ void Cache::Shutdown()
 ///
 /// This must be called after calling Initialize() in order to begin using an existing cache.
 ///
+/// Outside of tools builds, caches are never modified, so if an up-to-date cooked index exists it is memory mapped
+/// and used in place of the TOC, and the TOC is considered loaded immediately.
+///
 /// @return  True if loading was started successfully, false if not.
 ///
-/// @see TryFinishLoadToc(), IsTocLoaded(), Initialize()
+/// @see TryFinishLoadToc(), IsTocLoaded(), Initialize(), WriteIndex()
 bool Cache::BeginLoadToc()
 {
 	if( IsValid( m_asyncLoadId ) )
@@ -161,6 +251,15 @@ bool Cache::BeginLoadToc()
 		return false;
 	}
 
+#if !HELIUM_TOOLS
+	if( MapIndex() )
+	{
+		m_bTocLoaded = true;
+
+		return true;
+	}
+#endif
+
 	if( IsInvalid( m_tocSize ) )
 	{
 		HELIUM_TRACE( TraceLevels::Info, TXT( "Cache::BeginLoadToc(): TOC file does not seem to exist.  MOVING ON...\n" ) );
@@ -216,6 +315,12 @@ bool Cache::TryFinishLoadToc()
 {
 	if( IsInvalid( m_asyncLoadId ) )
 	{
+		// Nothing is left to wait on if the TOC was loaded from a cooked index.
+		if( IsIndexMapped() )
+		{
+			return true;
+		}
+
 		HELIUM_TRACE( TraceLevels::Warning, TXT( "Cache::TryFinishLoadToc(): Called without a TOC load in progress.\n" ) );
 
 		return true;
@@ -315,7 +420,20 @@ const Cache::Entry* Cache::FindEntry( AssetPath path, uint32_t subDataIndex ) co
 	EntryMapType::ConstAccessor mapAccessor;
 	if( !m_entryMap.Find( mapAccessor, key ) )
 	{
-		return NULL;
+		if( !m_pIndexData )
+		{
+			return NULL;
+		}
+
+		// Look the entry up in the cooked index, creating an entry for it on its first lookup.
+		mapAccessor.Release();
+
+		String pathString;
+		path.ToString( pathString );
+
+		const IndexRecord* pRecord = FindIndexRecord( pathString, subDataIndex );
+
+		return ( pRecord ? MaterializeIndexEntry( *pRecord, path ) : NULL );
 	}
 
 	Entry* pEntry = mapAccessor->Second();
@@ -324,8 +442,154 @@ const Cache::Entry* Cache::FindEntry( AssetPath path, uint32_t subDataIndex ) co
 	return pEntry;
 }
 
+/// Get a pointer to an entry's data within the memory mapped cache file.
+///
+/// @param[in] rEntry  Cache entry.
+///
+/// @return  Pointer to the start of the entry's data, or null if the cache file is not mapped, the entry is
+///          compressed, or the entry does not lie entirely within the mapped file.
+///
+/// @see MapCacheFile(), AdviseMappedRange()
+const uint8_t* Cache::GetMappedEntryData( const Entry& rEntry ) const
+{
+	if( !m_pMappedData || rEntry.compression != CompressionCodecs::None || rEntry.offset > m_mappedSize ||
+		rEntry.storedSize > m_mappedSize - rEntry.offset )
+	{
+		return NULL;
+	}
+
+	return m_pMappedData + rEntry.offset;
+}
+
+#if !HELIUM_OS_LINUX
+
+/// Map the cache file into memory for read-only access.
+///
+/// While mapped, loaders can deserialize entries in place using GetMappedEntryData() instead of reading them into
+/// separate buffers.  The cache cannot be modified while it is mapped.
+///
+/// @return  True if the cache file is mapped, false if mapping failed or is not supported on this platform.
+///
+/// @see UnmapCacheFile(), GetMappedEntryData()
+bool Cache::MapCacheFile()
+{
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		TXT( "Cache::MapCacheFile(): Memory mapped cache files are not supported on this platform.\n" ) );
+
+	return false;
+}
+
+/// Unmap a cache file mapped with MapCacheFile().
+///
+/// Any pointers previously returned by GetMappedEntryData() become invalid.
+///
+/// @see MapCacheFile()
+void Cache::UnmapCacheFile()
+{
+	HELIUM_ASSERT( !m_pMappedData );
+}
+
+/// Hint that a range of the memory mapped cache file will be read soon.
+///
+/// @param[in] offset  Byte offset within the cache file.
+/// @param[in] size    Number of bytes.
+///
+/// @see MapCacheFile()
+void Cache::AdviseMappedRange( uint64_t /*offset*/, uint64_t /*size*/ ) const
+{
+}
+
+/// Hint that a range of the cache file will be read soon, so that it can be read into the file cache ahead of time.
+///
+/// @param[in] offset  Byte offset within the cache file.
+/// @param[in] size    Number of bytes.
+///
+/// @return  True if the hint was issued, false if it is not supported on this platform.
+///
+/// @see AdviseMappedRange()
+bool Cache::AdviseFileRange( uint64_t /*offset*/, uint64_t /*size*/ ) const
+{
+	return false;
+}
+
+/// Load the cooked index file for MapIndex().
+///
+/// Memory mapping is not supported on this platform, so the index is read in its entirety with a single read
+/// instead.  It is still used in place without being parsed.
+///
+/// @return  True if the index file was loaded, false if not.
+///
+/// @see UnmapIndexFile()
+bool Cache::MapIndexFile()
+{
+	HELIUM_ASSERT( !m_pIndexData );
+
+	Status status;
+	status.Read( m_indexFileName.GetData() );
+	if( status.m_Size <= 0 || static_cast< uint64_t >( status.m_Size ) > static_cast< uint64_t >( SIZE_MAX ) )
+	{
+		return false;
+	}
+
+	FileStream* pIndexStream = FileStream::OpenFileStream( m_indexFileName, FileStream::MODE_READ );
+	if( !pIndexStream )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "Cache::MapIndexFile(): Failed to open cooked index \"%s\" for reading.\n" ),
+			*m_indexFileName );
+
+		return false;
+	}
+
+	size_t indexSize = static_cast< size_t >( status.m_Size );
+
+	DefaultAllocator allocator;
+	uint8_t* pIndexData = static_cast< uint8_t* >( allocator.Allocate( indexSize ) );
+	HELIUM_ASSERT( pIndexData );
+
+	bool bReadSuccess = ( pIndexData && pIndexStream->Read( pIndexData, 1, indexSize ) == indexSize );
+
+	delete pIndexStream;
+
+	if( !bReadSuccess )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "Cache::MapIndexFile(): Failed to read cooked index \"%s\".\n" ),
+			*m_indexFileName );
+
+		allocator.Free( pIndexData );
+
+		return false;
+	}
+
+	m_pIndexData = pIndexData;
+	m_indexSize = indexSize;
+
+	return true;
+}
+
+/// Release the cooked index file contents loaded by MapIndexFile().
+///
+/// @see MapIndexFile()
+void Cache::UnmapIndexFile()
+{
+	if( m_pIndexData )
+	{
+		DefaultAllocator().Free( const_cast< uint8_t* >( m_pIndexData ) );
+		m_pIndexData = NULL;
+		m_indexSize = 0;
+	}
+}
+
+#endif  // !HELIUM_OS_LINUX
+
 /// Add or update an entry in the cache.
 ///
+/// The data is compressed with the cache's compression codec if doing so makes it smaller.
+///
 /// @param[in] path          Asset path.
 /// @param[in] subDataIndex  Sub-data index associated with the cached data.
 /// @param[in] pData         Data to cache.
@@ -342,6 +606,48 @@ bool Cache::CacheEntry(
 {
 	HELIUM_ASSERT( pData || size == 0 );
 
+	// Compress outside of the lock so that background compaction isn't held up by it.
+	DynamicArray< uint8_t > compressedData;
+	CompressionCodec compression = m_compression;
+	if( compression != CompressionCodecs::None &&
+		!Compression::CompressBlock( compression, pData, size, compressedData ) )
+	{
+		compression = CompressionCodecs::None;
+	}
+
+	const void* pStoredData = pData;
+	uint32_t storedSize = size;
+	if( compression != CompressionCodecs::None )
+	{
+		pStoredData = compressedData.GetData();
+		storedSize = static_cast< uint32_t >( compressedData.GetSize() );
+	}
+
+	MutexScopeLock writeLock( m_writeLock );
+
+	if( IsCacheFileMapped() )
+	{
+		// Loads may still be reading from the current mapping, so it can't be remapped out from under them.
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache::CacheEntry(): Cannot add \"%s\" to cache \"%s\" while the cache file is memory mapped.\n" ),
+			*path.ToString(),
+			*m_cacheFileName );
+
+		return false;
+	}
+
+	if( IsIndexMapped() )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache::CacheEntry(): Cannot add \"%s\" to cache \"%s\" while its cooked index is in use.\n" ),
+			*path.ToString(),
+			*m_cacheFileName );
+
+		return false;
+	}
+
 	Status status;
 	status.Read( m_cacheFileName.GetData() );
 	int64_t cacheFileSize = status.m_Size;
@@ -355,10 +661,14 @@ bool Cache::CacheEntry(
 	pEntryUpdate->path = path;
 	pEntryUpdate->subDataIndex = subDataIndex;
 	pEntryUpdate->size = size;
+	pEntryUpdate->storedSize = storedSize;
+	pEntryUpdate->compression = compression;
 
 	uint64_t originalOffset = 0;
 	int64_t originalTimestamp = 0;
 	uint32_t originalSize = 0;
+	uint32_t originalStoredSize = 0;
+	CompressionCodec originalCompression = CompressionCodecs::None;
 
 	EntryKey key;
 	key.path = path;
@@ -384,8 +694,10 @@ bool Cache::CacheEntry(
 		originalOffset = pEntryUpdate->offset;
 		originalTimestamp = pEntryUpdate->timestamp;
 		originalSize = pEntryUpdate->size;
+		originalStoredSize = pEntryUpdate->storedSize;
+		originalCompression = pEntryUpdate->compression;
 
-		if( originalSize < size )
+		if( originalStoredSize < storedSize )
 		{
 			pEntryUpdate->offset = entryOffset;
 		}
@@ -396,6 +708,8 @@ bool Cache::CacheEntry(
 
 		pEntryUpdate->timestamp = timestamp;
 		pEntryUpdate->size = size;
+		pEntryUpdate->storedSize = storedSize;
+		pEntryUpdate->compression = compression;
 	}
 
 	AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
@@ -418,7 +732,7 @@ bool Cache::CacheEntry(
 			TXT( "Cache: Caching \"%s\" to \"%s\" (%" ) PRIu32 TXT( " bytes @ offset %" ) PRIu64 TXT( ").\n" ),
 			*path.ToString(),
 			*m_cacheFileName,
-			size,
+			storedSize,
 			entryOffset );
 
 		uint64_t seekOffset = static_cast< uint64_t >( pCacheStream->Seek(
@@ -439,20 +753,22 @@ bool Cache::CacheEntry(
 				pEntryUpdate->offset = originalOffset;
 				pEntryUpdate->timestamp = originalTimestamp;
 				pEntryUpdate->size = originalSize;
+				pEntryUpdate->storedSize = originalStoredSize;
+				pEntryUpdate->compression = originalCompression;
 			}
 
 			bCacheSuccess = false;
 		}
 		else
 		{
-			size_t writeSize = pCacheStream->Write( pData, 1, size );
-			if( writeSize != size )
+			size_t writeSize = pCacheStream->Write( pStoredData, 1, storedSize );
+			if( writeSize != storedSize )
 			{
 				HELIUM_TRACE(
 					TraceLevels::Error,
 					( TXT( "Cache: Failed to write %" ) PRIu32 TXT( " bytes to cache \"%s\" (%" ) PRIuSZ
 					TXT( " bytes written).\n" ) ),
-					size,
+					storedSize,
 					*m_cacheFileName,
 					writeSize );
 
@@ -467,63 +783,128 @@ bool Cache::CacheEntry(
 					pEntryUpdate->offset = originalOffset;
 					pEntryUpdate->timestamp = originalTimestamp;
 					pEntryUpdate->size = originalSize;
+					pEntryUpdate->storedSize = originalStoredSize;
+					pEntryUpdate->compression = originalCompression;
 				}
 
 				bCacheSuccess = false;
 			}
 			else
 			{
-				HELIUM_TRACE( TraceLevels::Info, TXT( "Cache: Rewriting TOC file \"%s\".\n" ), *m_tocFileName );
-
-				FileStream* pTocStream = FileStream::OpenFileStream( m_tocFileName, FileStream::MODE_WRITE, true );
-				if( !pTocStream )
+				// Record the update in the TOC journal, rewriting the whole TOC if there is no journal to append to.
+				if( !m_bTocJournalValid || !AppendTocRecord( *pEntryUpdate ) )
 				{
-					HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Failed to open TOC \"%s\" for writing.\n" ), *m_tocFileName );
+					WriteToc();
 				}
-				else
-				{
-					BufferedStream* pBufferedStream = new BufferedStream( pTocStream );
-					HELIUM_ASSERT( pBufferedStream );
+			}
+		}
+
+		delete pCacheStream;
+	}
+
+	rLoader.Unlock();
 
-					pBufferedStream->Write( &TOC_MAGIC, sizeof( TOC_MAGIC ), 1 );
-					pBufferedStream->Write( &sm_Version, sizeof( sm_Version ), 1 );
+	return bCacheSuccess;
+}
 
-					uint32_t entryCount = static_cast< uint32_t >( m_entries.GetSize() );
-					pBufferedStream->Write( &entryCount, sizeof( entryCount ), 1 );
+/// Queue an asynchronous load of a cache entry's data.
+///
+/// Compressed entries are decompressed by the async loader worker thread that reads them.  The request is synced
+/// through the AsyncLoader as usual, with the byte count reported being the number of (decompressed) bytes stored in
+/// the buffer.
+///
+/// @param[in] rEntry      Entry to load.
+/// @param[in] pBuffer     Buffer in which to load the entry data.
+/// @param[in] bufferSize  Size of the buffer.  If smaller than the entry size, only the leading bytes are loaded.
+///
+/// @return  AsyncLoader request ID, or an invalid index if the request could not be queued.
+///
+/// @see ReadEntry()
+size_t Cache::QueueEntryLoad( const Entry& rEntry, void* pBuffer, size_t bufferSize ) const
+{
+	HELIUM_ASSERT( pBuffer );
 
-					String entryPath;
-					uint_fast32_t entryCountFast = entryCount;
-					for( uint_fast32_t entryIndex = 0; entryIndex < entryCountFast; ++entryIndex )
-					{
-						Entry* pEntry = m_entries[ entryIndex ];
-						HELIUM_ASSERT( pEntry );
+	AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
+	size_t loadSize = Min( bufferSize, static_cast< size_t >( rEntry.size ) );
 
-						pEntry->path.ToString( entryPath );
-						HELIUM_ASSERT( entryPath.GetSize() < UINT16_MAX );
-						uint16_t pathSize = static_cast< uint16_t >( entryPath.GetSize() );
-						pBufferedStream->Write( &pathSize, sizeof( pathSize ), 1 );
+	// Keep compaction from moving the entry until the request is in the loader queue, where the loader lock taken
+	// during compaction will drain it before the old cache file is replaced.
+	ScopeReadLock offsetLock( m_offsetLock );
 
-						pBufferedStream->Write( *entryPath, sizeof( char ), pathSize );
+	if( rEntry.compression == CompressionCodecs::None )
+	{
+		return rLoader.QueueRequest( pBuffer, m_cacheFileName, rEntry.offset, loadSize );
+	}
 
-						pBufferedStream->Write( &pEntry->subDataIndex, sizeof( pEntry->subDataIndex ), 1 );
+	return rLoader.QueueCompressedRequest(
+		pBuffer,
+		loadSize,
+		m_cacheFileName,
+		rEntry.offset,
+		rEntry.storedSize,
+		rEntry.compression );
+}
 
-						pBufferedStream->Write( &pEntry->offset, sizeof( pEntry->offset ), 1 );
-						pBufferedStream->Write( &pEntry->timestamp, sizeof( pEntry->timestamp ), 1 );
-						pBufferedStream->Write( &pEntry->size, sizeof( pEntry->size ), 1 );
-					}
+/// Synchronously read a cache entry's data, decompressing it if necessary.
+///
+/// @param[in]  rEntry  Entry to read.
+/// @param[out] rData   Entry data.
+///
+/// @return  True if the entry was read successfully, false if not.
+///
+/// @see QueueEntryLoad()
+bool Cache::ReadEntry( const Entry& rEntry, DynamicArray< uint8_t >& rData ) const
+{
+	rData.Resize( 0 );
 
-					delete pBufferedStream;
-					delete pTocStream;
-				}
-			}
-		}
+	FileStream* pCacheStream = FileStream::OpenFileStream( m_cacheFileName, FileStream::MODE_READ );
+	if( !pCacheStream )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Cache::ReadEntry(): Failed to open cache \"%s\" for reading.\n" ), *m_cacheFileName );
 
-		delete pCacheStream;
+		return false;
 	}
 
-	rLoader.Unlock();
+	DynamicArray< uint8_t > storedData;
+	DynamicArray< uint8_t >& rReadData = ( rEntry.compression == CompressionCodecs::None ? rData : storedData );
+	rReadData.Resize( rEntry.storedSize );
 
-	return bCacheSuccess;
+	ScopeReadLock offsetLock( m_offsetLock );
+
+	int64_t seekOffset = pCacheStream->Seek( static_cast< int64_t >( rEntry.offset ), SeekOrigins::Begin );
+	bool bReadSuccess = ( seekOffset == static_cast< int64_t >( rEntry.offset ) &&
+		pCacheStream->Read( rReadData.GetData(), 1, rEntry.storedSize ) == rEntry.storedSize );
+
+	delete pCacheStream;
+
+	if( bReadSuccess && rEntry.compression != CompressionCodecs::None )
+	{
+		rData.Resize( rEntry.size );
+
+		size_t decompressedSize = Compression::DecompressBlock(
+			rEntry.compression,
+			storedData.GetData(),
+			storedData.GetSize(),
+			rData.GetData(),
+			rData.GetSize() );
+		bReadSuccess = ( decompressedSize == rEntry.size );
+	}
+
+	if( !bReadSuccess )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache::ReadEntry(): Failed to read \"%s\" (sub-data %" ) PRIu32 TXT( ") from cache \"%s\".\n" ),
+			*rEntry.path.ToString(),
+			rEntry.subDataIndex,
+			*m_cacheFileName );
+
+		rData.Resize( 0 );
+
+		return false;
+	}
+
+	return true;
 }
 
 /// Finalize the TOC loading process.
@@ -538,8 +919,6 @@ bool Cache::FinalizeTocLoad()
 	const uint8_t* pTocCurrent = m_pTocBuffer;
 	const uint8_t* pTocMax = pTocCurrent + m_tocSize;
 
-	StackMemoryHeap<>& rStackHeap = ThreadLocalStackAllocator::GetMemoryHeap();
-
 	// Validate the TOC header.
 	uint32_t magic;
 	if( !CheckedTocRead( MemoryCopy, magic, TXT( "the header magic" ), pTocCurrent, pTocMax ) )
@@ -599,130 +978,1206 @@ bool Cache::FinalizeTocLoad()
 		return false;
 	}
 
-	// Read the numbers of entries in the cache.
-	uint32_t entryCount;
+	if( version == 0 )
+	{
+		// Read the numbers of entries in the cache.
+		uint32_t entryCount;
+		bool bReadResult = CheckedTocRead(
+			pLoadFunction,
+			entryCount,
+			TXT( "the number of entries in the cache" ),
+			pTocCurrent,
+			pTocMax );
+		if( !bReadResult )
+		{
+			return false;
+		}
+
+		// Load the entry information.
+		uint_fast32_t entryCountFast = entryCount;
+		m_entries.Reserve( entryCountFast );
+		for( uint_fast32_t entryIndex = 0; entryIndex < entryCountFast; ++entryIndex )
+		{
+			if( !ReplayTocRecord( pLoadFunction, version, pTocCurrent, pTocMax ) )
+			{
+				return false;
+			}
+		}
+
+		// Older TOCs can't be appended to, so the first update will convert this one to a journal.
+		m_bTocJournalValid = false;
+
+		return true;
+	}
+
+	// Replay the journal.  A record cut short by an interrupted update only loses that update, as everything before
+	// it is still intact.
+	bool bTocIntact = true;
+	while( pTocCurrent < pTocMax )
+	{
+		const uint8_t* pRecordStart = pTocCurrent;
+		if( !ReplayTocRecord( pLoadFunction, version, pTocCurrent, pTocMax ) )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				TXT( "Cache::FinalizeTocLoad(): Discarding %" ) PRIuSZ TXT( " bytes of incomplete records at the end of TOC \"%s\".\n" ),
+				static_cast< size_t >( pTocMax - pRecordStart ),
+				*m_tocFileName );
+
+			bTocIntact = false;
+
+			break;
+		}
+	}
+
+	// New records can only be appended if the journal ends cleanly, is in the current format, and doesn't need byte
+	// swapping.
+	m_bTocJournalValid = ( bTocIntact && version == sm_Version && pLoadFunction == MemoryCopy );
+
+	return true;
+}
+
+/// Read a single entry record from the TOC, adding the entry or updating it if it was already read from an earlier
+/// record.
+///
+/// @param[in]     pLoadFunction  Function to use for reading values.
+/// @param[in]     version        TOC format version.
+/// @param[in,out] rpTocCurrent   Pointer to the current offset within the TOC file buffer.
+/// @param[in]     pTocMax        Pointer to the end of the TOC file buffer.
+///
+/// @return  True if the record was read successfully, false if not.
+bool Cache::ReplayTocRecord(
+	LOAD_VALUE_CALLBACK* pLoadFunction,
+	uint32_t version,
+	const uint8_t*& rpTocCurrent,
+	const uint8_t* pTocMax )
+{
+	StackMemoryHeap<>& rStackHeap = ThreadLocalStackAllocator::GetMemoryHeap();
+
+	uint16_t entryPathSize;
 	bool bReadResult = CheckedTocRead(
 		pLoadFunction,
-		entryCount,
-		TXT( "the number of entries in the cache" ),
-		pTocCurrent,
+		entryPathSize,
+		TXT( "entry AssetPath string size" ),
+		rpTocCurrent,
 		pTocMax );
 	if( !bReadResult )
 	{
 		return false;
 	}
 
-	// Load the entry information.
-	EntryKey key;
+	uint_fast16_t entryPathSizeFast = entryPathSize;
 
-	uint_fast32_t entryCountFast = entryCount;
-	m_entries.Reserve( entryCountFast );
-	for( uint_fast32_t entryIndex = 0; entryIndex < entryCountFast; ++entryIndex )
+	StackMemoryHeap<>::Marker stackMarker( rStackHeap );
+	char* pPathString = static_cast< char* >( rStackHeap.Allocate(
+		sizeof( char ) * ( entryPathSizeFast + 1 ) ) );
+	HELIUM_ASSERT( pPathString );
+	pPathString[ entryPathSizeFast ] = TXT( '\0' );
+
+	for( uint_fast16_t characterIndex = 0; characterIndex < entryPathSizeFast; ++characterIndex )
 	{
-		uint16_t entryPathSize;
 		bReadResult = CheckedTocRead(
 			pLoadFunction,
-			entryPathSize,
-			TXT( "entry AssetPath string size" ),
-			pTocCurrent,
+			pPathString[ characterIndex ],
+			TXT( "entry AssetPath string character" ),
+			rpTocCurrent,
 			pTocMax );
 		if( !bReadResult )
 		{
 			return false;
 		}
+	}
+
+	AssetPath entryPath;
+	if( !entryPath.Set( pPathString ) )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache::FinalizeTocLoad(): Failed to set AssetPath for entry \"%s\".\n" ),
+			pPathString );
 
-		uint_fast16_t entryPathSizeFast = entryPathSize;
+		return false;
+	}
 
-		StackMemoryHeap<>::Marker stackMarker( rStackHeap );
-		char* pPathString = static_cast< char* >( rStackHeap.Allocate(
-			sizeof( char ) * ( entryPathSizeFast + 1 ) ) );
-		HELIUM_ASSERT( pPathString );
-		pPathString[ entryPathSizeFast ] = TXT( '\0' );
+	uint32_t entrySubDataIndex;
+	bReadResult = CheckedTocRead(
+		pLoadFunction,
+		entrySubDataIndex,
+		TXT( "entry sub-data index" ),
+		rpTocCurrent,
+		pTocMax );
+	if( !bReadResult )
+	{
+		return false;
+	}
 
-		for( uint_fast16_t characterIndex = 0; characterIndex < entryPathSizeFast; ++characterIndex )
-		{
-			bReadResult = CheckedTocRead(
-				pLoadFunction,
-				pPathString[ characterIndex ],
-				TXT( "entry AssetPath string character" ),
-				pTocCurrent,
-				pTocMax );
-			if( !bReadResult )
-			{
-				return false;
-			}
-		}
+	uint64_t entryOffset;
+	if( !CheckedTocRead( pLoadFunction, entryOffset, TXT( "entry offset" ), rpTocCurrent, pTocMax ) )
+	{
+		return false;
+	}
 
-		AssetPath entryPath;
-		if( !entryPath.Set( pPathString ) )
-		{
-			HELIUM_TRACE(
-				TraceLevels::Error,
-				TXT( "Cache::FinalizeTocLoad(): Failed to set AssetPath for entry %" ) PRIuFAST16 TXT( ".\n" ),
-				entryIndex );
+	int64_t entryTimestamp;
+	if( !CheckedTocRead( pLoadFunction, entryTimestamp, TXT( "entry timestamp" ), rpTocCurrent, pTocMax ) )
+	{
+		return false;
+	}
 
-			return false;
-		}
+	uint32_t entrySize;
+	if( !CheckedTocRead( pLoadFunction, entrySize, TXT( "entry size" ), rpTocCurrent, pTocMax ) )
+	{
+		return false;
+	}
 
-		uint32_t entrySubDataIndex;
+	// Entries were always stored uncompressed prior to version 2.
+	uint8_t entryCompression = CompressionCodecs::None;
+	uint32_t entryStoredSize = entrySize;
+	if( version >= 2 )
+	{
 		bReadResult = CheckedTocRead(
 			pLoadFunction,
-			entrySubDataIndex,
-			TXT( "entry sub-data index" ),
-			pTocCurrent,
+			entryCompression,
+			TXT( "entry compression codec" ),
+			rpTocCurrent,
 			pTocMax );
 		if( !bReadResult )
 		{
 			return false;
 		}
 
-		key.path = entryPath;
-		key.subDataIndex = entrySubDataIndex;
-
-		EntryMapType::ConstAccessor entryAccessor;
-		if( m_entryMap.Find( entryAccessor, key ) )
+		if( entryCompression >= CompressionCodecs::Count )
 		{
 			HELIUM_TRACE(
 				TraceLevels::Error,
-				( TXT( "Cache::FinalizeTocLoad(): Duplicate entry found for AssetPath \"%s\", sub-data %" ) PRIu32
-				TXT( ".\n" ) ),
+				TXT( "Cache::FinalizeTocLoad(): Entry \"%s\" uses unknown compression codec %" ) PRIu8 TXT( ".\n" ),
 				pPathString,
-				entrySubDataIndex );
+				entryCompression );
 
 			return false;
 		}
 
-		uint64_t entryOffset;
-		if( !CheckedTocRead( pLoadFunction, entryOffset, TXT( "entry offset" ), pTocCurrent, pTocMax ) )
-		{
+		bReadResult = CheckedTocRead(
+			pLoadFunction,
+			entryStoredSize,
+			TXT( "entry stored size" ),
+			rpTocCurrent,
+			pTocMax );
+		if( !bReadResult )
+		{
 			return false;
 		}
+	}
+
+	Entry* pEntry = m_pEntryPool->Allocate();
+	HELIUM_ASSERT( pEntry );
+	pEntry->path = entryPath;
+	pEntry->subDataIndex = entrySubDataIndex;
+
+	EntryKey key;
+	key.path = entryPath;
+	key.subDataIndex = entrySubDataIndex;
+
+	EntryMapType::Accessor entryAccessor;
+	if( m_entryMap.Insert( entryAccessor, KeyValue< EntryKey, Entry* >( key, pEntry ) ) )
+	{
+		m_entries.Add( pEntry );
+	}
+	else
+	{
+		// Later records for the same entry supersede earlier ones.
+		m_pEntryPool->Release( pEntry );
+
+		pEntry = entryAccessor->Second();
+		HELIUM_ASSERT( pEntry );
+	}
+
+	pEntry->offset = entryOffset;
+	pEntry->timestamp = entryTimestamp;
+	pEntry->size = entrySize;
+	pEntry->storedSize = entryStoredSize;
+	pEntry->compression = static_cast< CompressionCodec >( entryCompression );
+
+	return true;
+}
+
+/// Memory map the cooked index file and validate it for use in place of the TOC.
+///
+/// Validation only looks at the header, so it takes the same time regardless of the number of entries.  An index
+/// written from an older version of the TOC is ignored so that entries cached since it was cooked are not hidden.
+///
+/// @return  True if the cooked index is mapped and ready for lookups, false if the TOC needs to be loaded instead.
+///
+/// @see UnmapIndex(), WriteIndex()
+bool Cache::MapIndex()
+{
+	if( m_pIndexData )
+	{
+		return true;
+	}
+
+	if( m_indexFileName.IsEmpty() )
+	{
+		return false;
+	}
+
+	Status indexStatus;
+	indexStatus.Read( m_indexFileName.GetData() );
+	if( indexStatus.m_Size == -1 || !MapIndexFile() )
+	{
+		return false;
+	}
+
+	HELIUM_ASSERT( m_pIndexData );
+
+	const char* pProblem = NULL;
+	if( m_indexSize < sizeof( IndexHeader ) )
+	{
+		pProblem = TXT( "is truncated" );
+	}
+	else
+	{
+		const IndexHeader& rHeader = GetIndexHeader();
+		if( rHeader.magic == INDEX_MAGIC_SWAPPED )
+		{
+			// Records are used in place, so an index with the wrong byte order is of no use.
+			pProblem = TXT( "was written with the opposite byte order" );
+		}
+		else if( rHeader.magic != INDEX_MAGIC )
+		{
+			pProblem = TXT( "has invalid file magic" );
+		}
+		else if( rHeader.version != INDEX_VERSION )
+		{
+			pProblem = TXT( "uses an unsupported format version" );
+		}
+		else if( sizeof( IndexHeader ) + static_cast< uint64_t >( rHeader.entryCount ) * sizeof( IndexRecord ) +
+			rHeader.stringTableSize != m_indexSize )
+		{
+			pProblem = TXT( "does not match the size of its contents" );
+		}
+		else
+		{
+			for( size_t bucketIndex = 1; bucketIndex < HELIUM_ARRAY_COUNT( rHeader.fanout ); ++bucketIndex )
+			{
+				if( rHeader.fanout[ bucketIndex ] < rHeader.fanout[ bucketIndex - 1 ] )
+				{
+					pProblem = TXT( "has a corrupt fan-out table" );
+
+					break;
+				}
+			}
+
+			if( !pProblem && rHeader.fanout[ HELIUM_ARRAY_COUNT( rHeader.fanout ) - 1 ] != rHeader.entryCount )
+			{
+				pProblem = TXT( "has a corrupt fan-out table" );
+			}
+		}
+
+		if( !pProblem )
+		{
+			// Caches shipped without their TOC can always use the index.
+			Status tocStatus;
+			tocStatus.Read( m_tocFileName.GetData() );
+			if( tocStatus.m_Size != -1 &&
+				( static_cast< uint64_t >( tocStatus.m_Size ) != rHeader.tocSize ||
+				tocStatus.m_ModifiedTime != rHeader.tocTimestamp ) )
+			{
+				pProblem = TXT( "is out of date" );
+			}
+		}
+	}
+
+	if( pProblem )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "Cache::MapIndex(): Cooked index \"%s\" %s, loading TOC \"%s\" instead.\n" ),
+			*m_indexFileName,
+			pProblem,
+			*m_tocFileName );
+
+		UnmapIndexFile();
+
+		return false;
+	}
+
+	const IndexHeader& rHeader = GetIndexHeader();
+	m_pIndexRecords = reinterpret_cast< const IndexRecord* >( m_pIndexData + sizeof( IndexHeader ) );
+	m_pIndexStrings = reinterpret_cast< const char* >( m_pIndexRecords + rHeader.entryCount );
+
+	m_indexEntries.Resize( rHeader.entryCount );
+	if( rHeader.entryCount != 0 )
+	{
+		MemoryZero( m_indexEntries.GetData(), sizeof( Entry* ) * rHeader.entryCount );
+	}
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		TXT( "Cache::MapIndex(): Using cooked index \"%s\" (%" ) PRIu32 TXT( " entries).\n" ),
+		*m_indexFileName,
+		rHeader.entryCount );
+
+	return true;
+}
+
+/// Release the cooked index mapped by MapIndex().
+///
+/// Entries already looked up in the index remain valid until the cache is shut down.
+///
+/// @see MapIndex()
+void Cache::UnmapIndex()
+{
+	UnmapIndexFile();
+
+	m_pIndexRecords = NULL;
+	m_pIndexStrings = NULL;
+
+	m_indexEntries.Clear();
+}
+
+/// Search the cooked index for the record of an entry.
+///
+/// @param[in] rPath         Entry path string.
+/// @param[in] subDataIndex  Sub-data index.
+///
+/// @return  Index record if found, null if not.
+///
+/// @see MaterializeIndexEntry()
+const Cache::IndexRecord* Cache::FindIndexRecord( const String& rPath, uint32_t subDataIndex ) const
+{
+	HELIUM_ASSERT( m_pIndexRecords );
+
+	const IndexHeader& rHeader = GetIndexHeader();
+
+	IndexRecord key;
+	key.pathHash = ComputeIndexPathHash( rPath.GetData(), rPath.GetSize() );
+	key.subDataIndex = subDataIndex;
+
+	// Only the records sharing the top byte of the hash need to be searched.
+	size_t bucketIndex = static_cast< size_t >( key.pathHash >> 56 );
+	const IndexRecord* pRecord = m_pIndexRecords + ( bucketIndex == 0 ? 0 : rHeader.fanout[ bucketIndex - 1 ] );
+	const IndexRecord* pRecordEnd = m_pIndexRecords + rHeader.fanout[ bucketIndex ];
+
+	pRecord = std::lower_bound( pRecord, pRecordEnd, key, &Cache::IndexRecordLess );
+
+	// Compare path strings in case of hash collisions.
+	for( ; pRecord != pRecordEnd && pRecord->pathHash == key.pathHash && pRecord->subDataIndex == subDataIndex; ++pRecord )
+	{
+		if( pRecord->pathSize == rPath.GetSize() &&
+			pRecord->pathOffset <= rHeader.stringTableSize &&
+			pRecord->pathSize <= rHeader.stringTableSize - pRecord->pathOffset &&
+			memcmp( m_pIndexStrings + pRecord->pathOffset, rPath.GetData(), pRecord->pathSize ) == 0 )
+		{
+			return pRecord;
+		}
+	}
+
+	return NULL;
+}
+
+/// Get the entry for the cooked index record with the specified index.
+///
+/// The record's path string is only parsed the first time the record is accessed, so iterating over all entries more
+/// than once does not repeat the path lookups.
+///
+/// @param[in] index  Index record index.
+///
+/// @return  Asset entry information.
+///
+/// @see GetEntry()
+const Cache::Entry& Cache::GetIndexEntry( uint32_t index ) const
+{
+	HELIUM_ASSERT( m_pIndexRecords );
+
+	const IndexHeader& rHeader = GetIndexHeader();
+	HELIUM_ASSERT( index < rHeader.entryCount );
+
+	{
+		MutexScopeLock indexLock( m_indexLock );
+
+		Entry* pEntry = m_indexEntries[ index ];
+		if( pEntry )
+		{
+			return *pEntry;
+		}
+	}
+
+	const IndexRecord& rRecord = m_pIndexRecords[ index ];
+	HELIUM_ASSERT( rRecord.pathOffset <= rHeader.stringTableSize );
+	HELIUM_ASSERT( rRecord.pathSize <= rHeader.stringTableSize - rRecord.pathOffset );
+
+	StackMemoryHeap<>& rStackHeap = ThreadLocalStackAllocator::GetMemoryHeap();
+	StackMemoryHeap<>::Marker stackMarker( rStackHeap );
+
+	char* pPathString = static_cast< char* >( rStackHeap.Allocate( sizeof( char ) * ( rRecord.pathSize + 1 ) ) );
+	HELIUM_ASSERT( pPathString );
+	MemoryCopy( pPathString, m_pIndexStrings + rRecord.pathOffset, rRecord.pathSize );
+	pPathString[ rRecord.pathSize ] = TXT( '\0' );
+
+	AssetPath path;
+	HELIUM_VERIFY( path.Set( pPathString ) );
+
+	Entry* pEntry = MaterializeIndexEntry( rRecord, path );
+	HELIUM_ASSERT( pEntry );
+
+	return *pEntry;
+}
+
+/// Get the entry for a cooked index record, creating it if this is the first time it has been looked up.
+///
+/// @param[in] rRecord  Index record.
+/// @param[in] path     Asset path of the record.
+///
+/// @return  Asset entry information.
+///
+/// @see FindIndexRecord()
+Cache::Entry* Cache::MaterializeIndexEntry( const IndexRecord& rRecord, AssetPath path ) const
+{
+	EntryKey key;
+	key.path = path;
+	key.subDataIndex = rRecord.subDataIndex;
+
+	// Entries are only ever added here while the index is in use, so holding the lock across the lookup and insertion
+	// keeps concurrent lookups from creating the same entry twice.
+	MutexScopeLock indexLock( m_indexLock );
+
+	size_t recordIndex = static_cast< size_t >( &rRecord - m_pIndexRecords );
+	HELIUM_ASSERT( recordIndex < m_indexEntries.GetSize() );
+	Entry*& rpIndexEntry = m_indexEntries[ recordIndex ];
+	if( rpIndexEntry )
+	{
+		return rpIndexEntry;
+	}
+
+	EntryMapType::Accessor entryAccessor;
+	if( m_entryMap.Find( entryAccessor, key ) )
+	{
+		Entry* pEntry = entryAccessor->Second();
+		HELIUM_ASSERT( pEntry );
+		rpIndexEntry = pEntry;
+
+		return pEntry;
+	}
+
+	HELIUM_ASSERT( rRecord.compression < CompressionCodecs::Count );
+
+	HELIUM_ASSERT( m_pEntryPool );
+	Entry* pEntry = m_pEntryPool->Allocate();
+	HELIUM_ASSERT( pEntry );
+	pEntry->offset = rRecord.offset;
+	pEntry->timestamp = rRecord.timestamp;
+	pEntry->path = path;
+	pEntry->subDataIndex = rRecord.subDataIndex;
+	pEntry->size = rRecord.size;
+	pEntry->storedSize = rRecord.storedSize;
+	pEntry->compression = static_cast< CompressionCodec >( rRecord.compression );
+
+	HELIUM_VERIFY( m_entryMap.Insert( entryAccessor, KeyValue< EntryKey, Entry* >( key, pEntry ) ) );
+	rpIndexEntry = pEntry;
+
+	return pEntry;
+}
+
+/// Rewrite the TOC file from scratch with a single record for each loaded entry.
+///
+/// @return  True if the TOC was written successfully, false if not.
+///
+/// @see AppendTocRecord()
+bool Cache::WriteToc()
+{
+	HELIUM_TRACE( TraceLevels::Info, TXT( "Cache: Rewriting TOC file \"%s\".\n" ), *m_tocFileName );
+
+	// Until the new TOC is completely written, there is nothing that can safely be appended to.
+	m_bTocJournalValid = false;
+
+	FileStream* pTocStream = FileStream::OpenFileStream( m_tocFileName, FileStream::MODE_WRITE, true );
+	if( !pTocStream )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Failed to open TOC \"%s\" for writing.\n" ), *m_tocFileName );
+
+		return false;
+	}
+
+	BufferedStream* pBufferedStream = new BufferedStream( pTocStream );
+	HELIUM_ASSERT( pBufferedStream );
+
+	bool bWriteSuccess = WriteTocHeader( *pBufferedStream );
+
+	size_t entryCount = m_entries.GetSize();
+	for( size_t entryIndex = 0; bWriteSuccess && entryIndex < entryCount; ++entryIndex )
+	{
+		Entry* pEntry = m_entries[ entryIndex ];
+		HELIUM_ASSERT( pEntry );
+
+		bWriteSuccess = WriteTocRecord( *pBufferedStream, *pEntry );
+	}
+
+	delete pBufferedStream;
+	delete pTocStream;
+
+	if( !bWriteSuccess )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Cache: Failed to write TOC \"%s\".\n" ), *m_tocFileName );
+
+		return false;
+	}
+
+	m_bTocJournalValid = true;
+
+	return true;
+}
+
+/// Append a record for an added or updated entry to the end of the TOC journal.
+///
+/// @param[in] rEntry  Entry to record.
+///
+/// @return  True if the record was appended successfully, false if not.
+///
+/// @see WriteToc()
+bool Cache::AppendTocRecord( const Entry& rEntry )
+{
+	HELIUM_ASSERT( m_bTocJournalValid );
+
+	FileStream* pTocStream = FileStream::OpenFileStream( m_tocFileName, FileStream::MODE_WRITE, false );
+	if( !pTocStream )
+	{
+		HELIUM_TRACE( TraceLevels::Warning, TXT( "Cache: Failed to open TOC \"%s\" for appending.\n" ), *m_tocFileName );
+
+		return false;
+	}
+
+	bool bWriteSuccess = ( pTocStream->Seek( 0, SeekOrigins::End ) >= 0 );
+	if( bWriteSuccess )
+	{
+		BufferedStream* pBufferedStream = new BufferedStream( pTocStream );
+		HELIUM_ASSERT( pBufferedStream );
+
+		bWriteSuccess = WriteTocRecord( *pBufferedStream, rEntry );
+
+		delete pBufferedStream;
+	}
+
+	delete pTocStream;
+
+	if( !bWriteSuccess )
+	{
+		HELIUM_TRACE( TraceLevels::Warning, TXT( "Cache: Failed to append to TOC \"%s\".\n" ), *m_tocFileName );
+	}
+
+	return bWriteSuccess;
+}
+
+/// Rewrite the cache file with all live entries stored contiguously, dropping the space left behind by entries that
+/// have since been replaced, and rewrite the TOC journal with a single record per entry.
+///
+/// This blocks until compaction is complete.  BeginCompact() can be used to perform compaction on a background
+/// thread instead.  The cache cannot be compacted while the cache file is memory mapped.
+///
+/// Entries keep their addresses, so Entry pointers returned by FindEntry() remain valid, but their offsets are
+/// updated in place once the compacted file has been swapped in.  Before the swap, compaction waits for in-progress
+/// QueueEntryLoad() and ReadEntry() calls to finish and for every request already queued with the AsyncLoader to be
+/// serviced from the old file, and no new reads can be issued until the new offsets are in place.  Callers must
+/// therefore only read entry data through QueueEntryLoad() or ReadEntry() rather than caching entry offsets.
+///
+/// @param[out] rReclaimedBytes  Number of bytes freed from the cache and TOC files combined (set only if compaction
+///                              succeeds).
+///
+/// @return  True if compaction was successful, false if not.
+///
+/// @see BeginCompact()
+bool Cache::Compact( uint64_t& rReclaimedBytes )
+{
+	if( !IsTocLoaded() )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache::Compact(): Cannot compact cache \"%s\" before its TOC has been loaded.\n" ),
+			*m_cacheFileName );
+
+		return false;
+	}
+
+	MutexScopeLock writeLock( m_writeLock );
+
+	if( IsCacheFileMapped() )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache::Compact(): Cannot compact cache \"%s\" while the cache file is memory mapped.\n" ),
+			*m_cacheFileName );
+
+		return false;
+	}
+
+	if( IsIndexMapped() )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache::Compact(): Cannot compact cache \"%s\" while its cooked index is in use.\n" ),
+			*m_cacheFileName );
+
+		return false;
+	}
+
+	Status status;
+	status.Read( m_cacheFileName.GetData() );
+	int64_t cacheFileSize = status.m_Size;
+	if( cacheFileSize == -1 )
+	{
+		rReclaimedBytes = 0;
+
+		return true;
+	}
+
+	status.Read( m_tocFileName.GetData() );
+	int64_t tocFileSize = status.m_Size;
+
+	// Copy entries in file order so that the existing cache file is read front to back.
+	DynamicArray< Entry* > sortedEntries( m_entries );
+	std::sort( sortedEntries.GetData(), sortedEntries.GetData() + sortedEntries.GetSize(), &Cache::EntryOffsetLess );
+
+	String compactFileName( m_cacheFileName );
+	compactFileName += HELIUM_CACHE_COMPACT_EXTENSION;
+
+	FileStream* pSourceStream = FileStream::OpenFileStream( m_cacheFileName, FileStream::MODE_READ );
+	if( !pSourceStream )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Cache::Compact(): Failed to open cache \"%s\" for reading.\n" ), *m_cacheFileName );
+
+		return false;
+	}
+
+	FileStream* pCompactStream = FileStream::OpenFileStream( compactFileName, FileStream::MODE_WRITE, true );
+	if( !pCompactStream )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Cache::Compact(): Failed to open \"%s\" for writing.\n" ), *compactFileName );
+
+		delete pSourceStream;
+
+		return false;
+	}
+
+	size_t entryCount = sortedEntries.GetSize();
+	DynamicArray< uint64_t > compactOffsets;
+	compactOffsets.Reserve( entryCount );
+
+	DynamicArray< uint8_t > entryBuffer;
+	uint64_t compactSize = 0;
+	bool bCopySuccess = true;
+	for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		const Entry* pEntry = sortedEntries[ entryIndex ];
+		HELIUM_ASSERT( pEntry );
+
+		compactOffsets.Push( compactSize );
+
+		uint32_t size = pEntry->storedSize;
+		if( size == 0 )
+		{
+			continue;
+		}
+
+		entryBuffer.Resize( size );
+
+		int64_t seekOffset = pSourceStream->Seek( static_cast< int64_t >( pEntry->offset ), SeekOrigins::Begin );
+		if( seekOffset != static_cast< int64_t >( pEntry->offset ) ||
+			pSourceStream->Read( entryBuffer.GetData(), 1, size ) != size ||
+			pCompactStream->Write( entryBuffer.GetData(), 1, size ) != size )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				TXT( "Cache::Compact(): Failed to copy \"%s\" from cache \"%s\".\n" ),
+				*pEntry->path.ToString(),
+				*m_cacheFileName );
+
+			bCopySuccess = false;
+
+			break;
+		}
+
+		compactSize += size;
+	}
+
+	delete pCompactStream;
+	delete pSourceStream;
+
+	if( !bCopySuccess )
+	{
+		FilePath( compactFileName ).Delete();
+
+		return false;
+	}
+
+	// Swap in the compacted file while no load requests can be reading from the old one.  Holding the offset lock
+	// first waits out any QueueEntryLoad() or ReadEntry() call that has already read an old offset; locking the loader
+	// then drains the requests they queued before the file is replaced.
+	ScopeWriteLock offsetLock( m_offsetLock );
+
+	AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
+	rLoader.Lock();
+
+	bool bMoveSuccess = FilePath( compactFileName ).Move( FilePath( m_cacheFileName ) );
+	if( bMoveSuccess )
+	{
+		for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+		{
+			sortedEntries[ entryIndex ]->offset = compactOffsets[ entryIndex ];
+		}
+
+		// The journal still refers to the old offsets, so it must be rewritten in full.
+		WriteToc();
+	}
+
+	rLoader.Unlock();
+
+	if( !bMoveSuccess )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache::Compact(): Failed to replace cache \"%s\" with \"%s\".\n" ),
+			*m_cacheFileName,
+			*compactFileName );
+
+		FilePath( compactFileName ).Delete();
+
+		return false;
+	}
+
+	status.Read( m_tocFileName.GetData() );
+	int64_t compactTocFileSize = status.m_Size;
+
+	uint64_t reclaimedBytes = static_cast< uint64_t >( cacheFileSize ) - compactSize;
+	if( tocFileSize != -1 && compactTocFileSize != -1 && tocFileSize > compactTocFileSize )
+	{
+		reclaimedBytes += static_cast< uint64_t >( tocFileSize - compactTocFileSize );
+	}
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		TXT( "Cache::Compact(): Compacted cache \"%s\" to %" ) PRIu64 TXT( " bytes (%" ) PRIu64 TXT( " bytes reclaimed).\n" ),
+		*m_cacheFileName,
+		compactSize,
+		reclaimedBytes );
+
+	rReclaimedBytes = reclaimedBytes;
+
+	return true;
+}
+
+/// Begin compacting this cache on a background thread.
+///
+/// Entries can still be looked up while compaction is in progress.  Any calls to CacheEntry() will block until
+/// compaction has finished.
+///
+/// @return  True if compaction was started successfully, false if not.
+///
+/// @see TryFinishCompact(), IsCompacting(), Compact()
+bool Cache::BeginCompact()
+{
+	if( m_pCompactWorker )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "Cache::BeginCompact(): Compaction of cache \"%s\" already in progress.\n" ),
+			*m_cacheFileName );
+
+		return true;
+	}
+
+	if( !IsTocLoaded() )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache::BeginCompact(): Cannot compact cache \"%s\" before its TOC has been loaded.\n" ),
+			*m_cacheFileName );
+
+		return false;
+	}
+
+	m_pCompactWorker = new CompactWorker( *this );
+	HELIUM_ASSERT( m_pCompactWorker );
+	m_pCompactThread = new RunnableThread( m_pCompactWorker );
+	HELIUM_ASSERT( m_pCompactThread );
+
+	HELIUM_VERIFY( m_pCompactThread->Start( TXT( "Cache compaction" ) ) );
+
+	return true;
+}
+
+/// Test for and finalize background compaction in a non-blocking fashion.
+///
+/// @param[out] rbSucceeded      If compaction has finished, set to whether it was successful.
+/// @param[out] rReclaimedBytes  If compaction has finished successfully, set to the number of bytes reclaimed.
+///
+/// @return  True if compaction has finished or is not in progress, false if it is still in progress.
+///
+/// @see BeginCompact(), IsCompacting()
+bool Cache::TryFinishCompact( bool& rbSucceeded, uint64_t& rReclaimedBytes )
+{
+	if( !m_pCompactWorker )
+	{
+		HELIUM_TRACE( TraceLevels::Warning, TXT( "Cache::TryFinishCompact(): Called without a compaction in progress.\n" ) );
+
+		rbSucceeded = false;
+
+		return true;
+	}
+
+	if( m_pCompactWorker->m_finishedCounter == 0 )
+	{
+		return false;
+	}
+
+	m_pCompactThread->Join();
+
+	rbSucceeded = m_pCompactWorker->m_bSucceeded;
+	if( rbSucceeded )
+	{
+		rReclaimedBytes = m_pCompactWorker->m_reclaimedBytes;
+	}
+
+	delete m_pCompactThread;
+	m_pCompactThread = NULL;
+
+	delete m_pCompactWorker;
+	m_pCompactWorker = NULL;
+
+	return true;
+}
+
+/// Replace the contents of this cache with copies of entries from another cache, stored contiguously in the order
+/// given.
+///
+/// Entries are stored uncompressed regardless of the compression settings of either cache, so that the resulting
+/// cache file can be read in large chunks and deserialized in place.  This blocks until the new cache file and TOC
+/// have been written.  The cache cannot be rebuilt while the cache file is memory mapped.
+///
+/// @param[in] rSourceCache  Cache from which to copy the entries.
+/// @param[in] rEntries      Entries of the source cache to copy, in the order in which to store them.
+///
+/// @return  True if the cache was rebuilt successfully, false if not.
+///
+/// @see Compact()
+bool Cache::Rebuild( const Cache& rSourceCache, const DynamicArray< const Entry* >& rEntries )
+{
+	HELIUM_ASSERT( &rSourceCache != this );
+
+	if( !IsTocLoaded() )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache::Rebuild(): Cannot rebuild cache \"%s\" before its TOC has been loaded.\n" ),
+			*m_cacheFileName );
+
+		return false;
+	}
+
+	MutexScopeLock writeLock( m_writeLock );
+
+	if( IsCacheFileMapped() )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache::Rebuild(): Cannot rebuild cache \"%s\" while the cache file is memory mapped.\n" ),
+			*m_cacheFileName );
+
+		return false;
+	}
+
+	if( IsIndexMapped() )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache::Rebuild(): Cannot rebuild cache \"%s\" while its cooked index is in use.\n" ),
+			*m_cacheFileName );
+
+		return false;
+	}
+
+	String rebuildFileName( m_cacheFileName );
+	rebuildFileName += HELIUM_CACHE_REBUILD_EXTENSION;
+
+	FileStream* pRebuildStream = FileStream::OpenFileStream( rebuildFileName, FileStream::MODE_WRITE, true );
+	if( !pRebuildStream )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Cache::Rebuild(): Failed to open \"%s\" for writing.\n" ), *rebuildFileName );
+
+		return false;
+	}
+
+	size_t entryCount = rEntries.GetSize();
+	DynamicArray< uint64_t > rebuildOffsets;
+	rebuildOffsets.Reserve( entryCount );
+
+	DynamicArray< uint8_t > entryBuffer;
+	uint64_t rebuildSize = 0;
+	bool bCopySuccess = true;
+	for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		const Entry* pEntry = rEntries[ entryIndex ];
+		HELIUM_ASSERT( pEntry );
+
+		rebuildOffsets.Push( rebuildSize );
+
+		if( pEntry->size == 0 )
+		{
+			continue;
+		}
 
-		int64_t entryTimestamp;
-		if( !CheckedTocRead( pLoadFunction, entryTimestamp, TXT( "entry timestamp" ), pTocCurrent, pTocMax ) )
+		if( !rSourceCache.ReadEntry( *pEntry, entryBuffer ) ||
+			pRebuildStream->Write( entryBuffer.GetData(), 1, entryBuffer.GetSize() ) != entryBuffer.GetSize() )
 		{
-			return false;
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				TXT( "Cache::Rebuild(): Failed to copy \"%s\" from cache \"%s\".\n" ),
+				*pEntry->path.ToString(),
+				*rSourceCache.m_cacheFileName );
+
+			bCopySuccess = false;
+
+			break;
+		}
+
+		rebuildSize += entryBuffer.GetSize();
+	}
+
+	delete pRebuildStream;
+
+	if( !bCopySuccess )
+	{
+		FilePath( rebuildFileName ).Delete();
+
+		return false;
+	}
+
+	// Swap in the rebuilt file while no load requests can be reading from the old one (see Compact()).
+	ScopeWriteLock offsetLock( m_offsetLock );
+
+	AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
+	rLoader.Lock();
+
+	bool bMoveSuccess = FilePath( rebuildFileName ).Move( FilePath( m_cacheFileName ) );
+	if( bMoveSuccess )
+	{
+		HELIUM_ASSERT( m_pEntryPool );
+
+		size_t oldEntryCount = m_entries.GetSize();
+		for( size_t entryIndex = 0; entryIndex < oldEntryCount; ++entryIndex )
+		{
+			m_pEntryPool->Release( m_entries[ entryIndex ] );
 		}
 
-		uint32_t entrySize;
-		if( !CheckedTocRead( pLoadFunction, entrySize, TXT( "entry size" ), pTocCurrent, pTocMax ) )
+		m_entries.Resize( 0 );
+		m_entries.Reserve( entryCount );
+		m_entryMap.Clear();
+
+		for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
 		{
-			return false;
+			const Entry* pSourceEntry = rEntries[ entryIndex ];
+
+			Entry* pEntry = m_pEntryPool->Allocate();
+			HELIUM_ASSERT( pEntry );
+			pEntry->offset = rebuildOffsets[ entryIndex ];
+			pEntry->timestamp = pSourceEntry->timestamp;
+			pEntry->path = pSourceEntry->path;
+			pEntry->subDataIndex = pSourceEntry->subDataIndex;
+			pEntry->size = pSourceEntry->size;
+			pEntry->storedSize = pSourceEntry->size;
+			pEntry->compression = CompressionCodecs::None;
+
+			EntryKey key;
+			key.path = pEntry->path;
+			key.subDataIndex = pEntry->subDataIndex;
+
+			EntryMapType::Accessor entryAccessor;
+			if( m_entryMap.Insert( entryAccessor, KeyValue< EntryKey, Entry* >( key, pEntry ) ) )
+			{
+				m_entries.Push( pEntry );
+			}
+			else
+			{
+				// Only the first copy of a duplicated entry is referenced by the TOC.
+				m_pEntryPool->Release( pEntry );
+			}
 		}
 
-		Entry* pEntry = m_pEntryPool->Allocate();
+		WriteToc();
+	}
+
+	rLoader.Unlock();
+
+	if( !bMoveSuccess )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache::Rebuild(): Failed to replace cache \"%s\" with \"%s\".\n" ),
+			*m_cacheFileName,
+			*rebuildFileName );
+
+		FilePath( rebuildFileName ).Delete();
+
+		return false;
+	}
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		TXT( "Cache::Rebuild(): Rebuilt cache \"%s\" with %" ) PRIuSZ TXT( " entries (%" ) PRIu64 TXT( " bytes).\n" ),
+		*m_cacheFileName,
+		m_entries.GetSize(),
+		rebuildSize );
+
+	return true;
+}
+
+/// Write a cooked index of the current entries for use in place of the TOC.
+///
+/// The cooked index is a flat table of the entries sorted by path hash, which runtime builds memory map and search
+/// directly instead of parsing the TOC and allocating every entry up front.  The index records the state of the TOC it
+/// was written from and is ignored once the TOC changes, so it should be written once the cache is fully up to date
+/// (and compacted, if desired).
+///
+/// @return  True if the index was written successfully, false if not.
+///
+/// @see IsIndexMapped(), BeginLoadToc()
+bool Cache::WriteIndex()
+{
+	if( m_indexFileName.IsEmpty() )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache::WriteIndex(): Cache \"%s\" was initialized without a cooked index file name.\n" ),
+			*m_cacheFileName );
+
+		return false;
+	}
+
+	if( !IsTocLoaded() )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache::WriteIndex(): Cannot write the index for cache \"%s\" before its TOC has been loaded.\n" ),
+			*m_cacheFileName );
+
+		return false;
+	}
+
+	MutexScopeLock writeLock( m_writeLock );
+
+	if( IsIndexMapped() )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "Cache::WriteIndex(): Cannot rewrite cooked index \"%s\" while it is in use.\n" ),
+			*m_indexFileName );
+
+		return false;
+	}
+
+	size_t entryCount = m_entries.GetSize();
+	HELIUM_ASSERT( entryCount <= UINT32_MAX );
+
+	DynamicArray< IndexRecord > records;
+	records.Reserve( entryCount );
+
+	String stringTable;
+	String entryPath;
+	for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		const Entry* pEntry = m_entries[ entryIndex ];
 		HELIUM_ASSERT( pEntry );
-		pEntry->path = entryPath;
-		pEntry->subDataIndex = entrySubDataIndex;
-		pEntry->offset = entryOffset;
-		pEntry->timestamp = entryTimestamp;
-		pEntry->size = entrySize;
 
-		m_entries.Add( pEntry );
+		pEntry->path.ToString( entryPath );
+		HELIUM_ASSERT( entryPath.GetSize() < UINT16_MAX );
+		HELIUM_ASSERT( stringTable.GetSize() <= UINT32_MAX - entryPath.GetSize() );
+
+		IndexRecord record;
+		MemoryZero( &record, sizeof( record ) );
+		record.pathHash = ComputeIndexPathHash( entryPath.GetData(), entryPath.GetSize() );
+		record.offset = pEntry->offset;
+		record.timestamp = pEntry->timestamp;
+		record.subDataIndex = pEntry->subDataIndex;
+		record.size = pEntry->size;
+		record.storedSize = pEntry->storedSize;
+		record.pathOffset = static_cast< uint32_t >( stringTable.GetSize() );
+		record.pathSize = static_cast< uint16_t >( entryPath.GetSize() );
+		record.compression = static_cast< uint8_t >( pEntry->compression );
+		records.Push( record );
+
+		stringTable += entryPath;
+	}
+
+	std::sort( records.GetData(), records.GetData() + records.GetSize(), &Cache::IndexRecordLess );
+
+	IndexHeader header;
+	MemoryZero( &header, sizeof( header ) );
+	header.magic = INDEX_MAGIC;
+	header.version = INDEX_VERSION;
+	header.entryCount = static_cast< uint32_t >( entryCount );
+	header.stringTableSize = static_cast< uint32_t >( stringTable.GetSize() );
+
+	for( size_t recordIndex = 0; recordIndex < entryCount; ++recordIndex )
+	{
+		++header.fanout[ records[ recordIndex ].pathHash >> 56 ];
+	}
+
+	for( size_t bucketIndex = 1; bucketIndex < HELIUM_ARRAY_COUNT( header.fanout ); ++bucketIndex )
+	{
+		header.fanout[ bucketIndex ] += header.fanout[ bucketIndex - 1 ];
+	}
+
+	// Tie the index to the TOC as it currently stands so that later updates to the TOC invalidate it.
+	Status tocStatus;
+	tocStatus.Read( m_tocFileName.GetData() );
+	if( tocStatus.m_Size != -1 )
+	{
+		header.tocTimestamp = tocStatus.m_ModifiedTime;
+		header.tocSize = static_cast< uint32_t >( tocStatus.m_Size );
+	}
+
+	// Write to a temporary file first so that processes still mapping the old index are unaffected.
+	String tempFileName( m_indexFileName );
+	tempFileName += HELIUM_CACHE_INDEX_TEMP_EXTENSION;
+
+	FileStream* pIndexStream = FileStream::OpenFileStream( tempFileName, FileStream::MODE_WRITE, true );
+	if( !pIndexStream )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Cache::WriteIndex(): Failed to open \"%s\" for writing.\n" ), *tempFileName );
+
+		return false;
+	}
+
+	BufferedStream* pBufferedStream = new BufferedStream( pIndexStream );
+	HELIUM_ASSERT( pBufferedStream );
+
+	bool bWriteSuccess =
+		( pBufferedStream->Write( &header, sizeof( header ), 1 ) == 1 &&
+		( entryCount == 0 || pBufferedStream->Write( records.GetData(), sizeof( IndexRecord ), entryCount ) == entryCount ) &&
+		( stringTable.IsEmpty() ||
+		pBufferedStream->Write( stringTable.GetData(), sizeof( char ), stringTable.GetSize() ) == stringTable.GetSize() ) );
+
+	delete pBufferedStream;
+	delete pIndexStream;
 
-		HELIUM_VERIFY( m_entryMap.Insert( entryAccessor, KeyValue< EntryKey, Entry* >( key, pEntry ) ) );
+	if( bWriteSuccess )
+	{
+		bWriteSuccess = FilePath( tempFileName ).Move( FilePath( m_indexFileName ) );
+	}
+
+	if( !bWriteSuccess )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Cache::WriteIndex(): Failed to write cooked index \"%s\".\n" ), *m_indexFileName );
+
+		FilePath( tempFileName ).Delete();
+
+		return false;
 	}
 
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		TXT( "Cache::WriteIndex(): Wrote cooked index \"%s\" (%" ) PRIuSZ TXT( " entries).\n" ),
+		*m_indexFileName,
+		entryCount );
+
 	return true;
 }
 
@@ -790,6 +2245,108 @@ size_t Cache::EntryKeyHash::operator()( const EntryKey& rKey ) const
 	return hash;
 }
 
+/// Write the TOC file header.
+///
+/// @param[in] rStream  Stream to which the header should be written.
+///
+/// @return  True if the header was written successfully, false if not.
+bool Cache::WriteTocHeader( Stream& rStream )
+{
+	return ( rStream.Write( &TOC_MAGIC, sizeof( TOC_MAGIC ), 1 ) == 1 &&
+		rStream.Write( &sm_Version, sizeof( sm_Version ), 1 ) == 1 );
+}
+
+/// Write a TOC record for a cache entry.
+///
+/// @param[in] rStream  Stream to which the record should be written.
+/// @param[in] rEntry   Entry to record.
+///
+/// @return  True if the record was written successfully, false if not.
+bool Cache::WriteTocRecord( Stream& rStream, const Entry& rEntry )
+{
+	String entryPath;
+	rEntry.path.ToString( entryPath );
+	HELIUM_ASSERT( entryPath.GetSize() < UINT16_MAX );
+	uint16_t pathSize = static_cast< uint16_t >( entryPath.GetSize() );
+
+	HELIUM_ASSERT( static_cast< size_t >( rEntry.compression ) < static_cast< size_t >( CompressionCodecs::Count ) );
+	uint8_t compression = static_cast< uint8_t >( rEntry.compression );
+
+	return ( rStream.Write( &pathSize, sizeof( pathSize ), 1 ) == 1 &&
+		rStream.Write( *entryPath, sizeof( char ), pathSize ) == pathSize &&
+		rStream.Write( &rEntry.subDataIndex, sizeof( rEntry.subDataIndex ), 1 ) == 1 &&
+		rStream.Write( &rEntry.offset, sizeof( rEntry.offset ), 1 ) == 1 &&
+		rStream.Write( &rEntry.timestamp, sizeof( rEntry.timestamp ), 1 ) == 1 &&
+		rStream.Write( &rEntry.size, sizeof( rEntry.size ), 1 ) == 1 &&
+		rStream.Write( &compression, sizeof( compression ), 1 ) == 1 &&
+		rStream.Write( &rEntry.storedSize, sizeof( rEntry.storedSize ), 1 ) == 1 );
+}
+
+/// Compare two entries by their offset within the cache file.
+///
+/// @param[in] pEntry0  First entry.
+/// @param[in] pEntry1  Second entry.
+///
+/// @return  True if the first entry is stored before the second, false if not.
+bool Cache::EntryOffsetLess( const Entry* pEntry0, const Entry* pEntry1 )
+{
+	HELIUM_ASSERT( pEntry0 );
+	HELIUM_ASSERT( pEntry1 );
+
+	return ( pEntry0->offset < pEntry1->offset );
+}
+
+/// Compute the hash of an entry path string for use in the cooked index.
+///
+/// Unlike AssetPath::ComputeHash(), this depends only on the path string, so it is stable across runs.
+///
+/// @param[in] pPath     Path string.
+/// @param[in] pathSize  Length of the path string.
+///
+/// @return  64-bit FNV-1a hash of the path string.
+uint64_t Cache::ComputeIndexPathHash( const char* pPath, size_t pathSize )
+{
+	Fnv1aHasher hasher;
+	hasher.Add( pPath, pathSize * sizeof( char ) );
+
+	return hasher.GetHash();
+}
+
+/// Compare two cooked index records by path hash and sub-data index.
+///
+/// @param[in] rRecord0  First record.
+/// @param[in] rRecord1  Second record.
+///
+/// @return  True if the first record sorts before the second, false if not.
+bool Cache::IndexRecordLess( const IndexRecord& rRecord0, const IndexRecord& rRecord1 )
+{
+	if( rRecord0.pathHash != rRecord1.pathHash )
+	{
+		return ( rRecord0.pathHash < rRecord1.pathHash );
+	}
+
+	return ( rRecord0.subDataIndex < rRecord1.subDataIndex );
+}
+
+/// Constructor.
+///
+/// @param[in] rCache  Cache to compact.
+Cache::CompactWorker::CompactWorker( Cache& rCache )
+	: m_rCache( rCache )
+	, m_reclaimedBytes( 0 )
+	, m_bSucceeded( false )
+	, m_finishedCounter( 0 )
+{
+}
+
+/// Compact the cache.
+void Cache::CompactWorker::Run()
+{
+	m_bSucceeded = m_rCache.Compact( m_reclaimedBytes );
+
+	AtomicExchangeRelease( m_finishedCounter, 1 );
+}
+
 #if HELIUM_TOOLS
 void Helium::Cache::WriteCacheObjectToBuffer( Reflect::Object* _object, DynamicArray< uint8_t > &_buffer )
 {
@@ -5,11 +5,16 @@
 
 #include "Foundation/ConcurrentHashMap.h"
 #include "Foundation/ObjectPool.h"
+#include "Platform/Locks.h"
 #include "Engine/AssetPath.h"
+#include "Engine/Compression.h"
 #include "Reflect/Object.h"
 
 namespace Helium
 {
+	class RunnableThread;
+	class Stream;
+
 	/// Serialization cache interface.
 	class HELIUM_ENGINE_API Cache : NonCopyable
 	{
@@ -47,8 +52,13 @@ namespace Helium
 			/// Sub-data index.
 			uint32_t subDataIndex;
 
-			/// Entry size.
+			/// Entry size (after any decompression).
 			uint32_t size;
+
+			/// Number of bytes the entry occupies in the cache file.
+			uint32_t storedSize;
+			/// Codec with which the entry is compressed in the cache file.
+			CompressionCodec compression;
 		};
 
 		/// @name Construction/Destruction
@@ -59,7 +69,9 @@ namespace Helium
 
 		/// @name Initialization
 		//@{
-		bool Initialize( Name name, EPlatform platform, const char* pTocFileName, const char* pCacheFileName );
+		bool Initialize(
+			Name name, EPlatform platform, const char* pTocFileName, const char* pCacheFileName,
+			const char* pIndexFileName = NULL );
 		void Shutdown();
 		//@}
 
@@ -79,12 +91,53 @@ namespace Helium
 
 		inline const String& GetTocFileName() const;
 		inline const String& GetCacheFileName() const;
+		inline const String& GetIndexFileName() const;
 
 		inline uint32_t GetEntryCount() const;
 		inline const Entry& GetEntry( uint32_t index ) const;
 		const Entry* FindEntry( AssetPath path, uint32_t subDataIndex ) const;
 
 		bool CacheEntry( AssetPath path, uint32_t subDataIndex, const void* pData, int64_t timestamp, uint32_t size );
+
+		size_t QueueEntryLoad( const Entry& rEntry, void* pBuffer, size_t bufferSize ) const;
+		bool ReadEntry( const Entry& rEntry, DynamicArray< uint8_t >& rData ) const;
+		//@}
+
+		/// @name Compression
+		//@{
+		inline CompressionCodec GetCompression() const;
+		inline void SetCompression( CompressionCodec compression );
+		//@}
+
+		/// @name Compaction
+		//@{
+		bool Compact( uint64_t& rReclaimedBytes );
+
+		bool BeginCompact();
+		bool TryFinishCompact( bool& rbSucceeded, uint64_t& rReclaimedBytes );
+		inline bool IsCompacting() const;
+		//@}
+
+		/// @name Rebuilding
+		//@{
+		bool Rebuild( const Cache& rSourceCache, const DynamicArray< const Entry* >& rEntries );
+		//@}
+
+		/// @name Cooked Index
+		//@{
+		bool WriteIndex();
+		inline bool IsIndexMapped() const;
+		//@}
+
+		/// @name Memory Mapping
+		//@{
+		bool MapCacheFile();
+		void UnmapCacheFile();
+		inline bool IsCacheFileMapped() const;
+
+		const uint8_t* GetMappedEntryData( const Entry& rEntry ) const;
+		void AdviseMappedRange( uint64_t offset, uint64_t size ) const;
+		bool AdviseFileRange( uint64_t offset, uint64_t size ) const;
 		//@}
 
 #if HELIUM_TOOLS
@@ -94,6 +147,8 @@ namespace Helium
 		static Reflect::ObjectPtr ReadCacheObjectFromBuffer( const uint8_t *_buffer, const size_t _offset, const size_t _count, Reflect::ObjectResolver *pResolver = 0 );
 
 	private:
+		class CompactWorker;
+
 		/// Value read callback.
 		typedef void ( LOAD_VALUE_CALLBACK )( void* pDestination, const void* pSource, size_t byteCount );
 
@@ -124,6 +179,58 @@ namespace Helium
 		/// Cache entry hash map type.
 		typedef ConcurrentHashMap< EntryKey, Entry*, EntryKeyHash > EntryMapType;
 
+		/// Cooked index file header.  The header is followed by the index records, sorted by path hash and sub-data
+		/// index, and then by a table holding the path strings of all records.
+		struct IndexHeader
+		{
+			/// Index magic number.
+			uint32_t magic;
+			/// Index format version.
+			uint32_t version;
+			/// Number of index records.
+			uint32_t entryCount;
+			/// Size of the path string table, in bytes.
+			uint32_t stringTableSize;
+
+			/// Modification time of the TOC file from which the index was written.
+			int64_t tocTimestamp;
+			/// Size of the TOC file from which the index was written.
+			uint32_t tocSize;
+			/// Padding (always zero).
+			uint32_t reserved;
+
+			/// Number of records whose path hash has each possible value in its most significant byte or less, so
+			/// that lookups only need to search the records sharing the top byte of their hash.
+			uint32_t fanout[ 256 ];
+		};
+
+		/// Cooked index entry record.
+		struct IndexRecord
+		{
+			/// Hash of the entry path string.
+			uint64_t pathHash;
+			/// Entry offset.
+			uint64_t offset;
+			/// Entry timestamp.
+			int64_t timestamp;
+
+			/// Sub-data index.
+			uint32_t subDataIndex;
+			/// Entry size (after any decompression).
+			uint32_t size;
+			/// Number of bytes the entry occupies in the cache file.
+			uint32_t storedSize;
+
+			/// Offset of the entry path string within the string table.
+			uint32_t pathOffset;
+			/// Length of the entry path string.
+			uint16_t pathSize;
+			/// Codec with which the entry is compressed in the cache file.
+			uint8_t compression;
+			/// Padding (always zero).
+			uint8_t reserved[ 5 ];
+		};
+
 		/// Cache name.
 		Name m_name;
 		/// Cache platform.
@@ -133,6 +240,8 @@ namespace Helium
 		String m_tocFileName;
 		/// Cache file name.
 		String m_cacheFileName;
+		/// Cooked index file name.
+		String m_indexFileName;
 
 		/// True if a TOC load request has been fully processed and synced (not indicative of whether the cache files
 		/// actually exist, though).
@@ -144,17 +253,74 @@ namespace Helium
 		uint8_t* m_pTocBuffer;
 		/// Size of the TOC, in bytes.
 		uint32_t m_tocSize;
+		/// True if the TOC file holds a journal in the current format that matches the loaded entries, in which case
+		/// entry updates can be appended to it instead of rewriting it.
+		bool m_bTocJournalValid;
+
+		/// Read-only view of the cache file if it has been memory mapped, null if not.
+		const uint8_t* m_pMappedData;
+		/// Size of the memory mapped view, in bytes.
+		uint64_t m_mappedSize;
+
+		/// Cooked index file contents if the TOC was loaded from a cooked index, null if not.
+		const uint8_t* m_pIndexData;
+		/// Size of the cooked index file contents, in bytes.
+		uint64_t m_indexSize;
+		/// Cooked index records.
+		const IndexRecord* m_pIndexRecords;
+		/// Cooked index path string table.
+		const char* m_pIndexStrings;
+		/// Entries created for each cooked index record so far, in record order (null for records not yet looked up).
+		mutable DynamicArray< Entry* > m_indexEntries;
+		/// Lock serializing the creation of entries for cooked index records.
+		mutable Mutex m_indexLock;
 
 		/// Cache entry pool.
 		ObjectPool< Entry >* m_pEntryPool;
-		/// Cache entry information.
+		/// Cache entry information (not used when the TOC was loaded from a cooked index).
 		DynamicArray< Entry* > m_entries;
-		/// Entry lookup hash map.
-		EntryMapType m_entryMap;
+		/// Entry lookup hash map.  When the TOC was loaded from a cooked index, entries are only added to this as they
+		/// are first looked up.
+		mutable EntryMapType m_entryMap;
+
+		/// Codec with which new entries are compressed.
+		CompressionCodec m_compression;
+
+		/// Lock serializing updates to the cache and TOC files.
+		Mutex m_writeLock;
+		/// Lock held non-exclusively while an entry offset is read to issue a read, and exclusively while compaction
+		/// or a rebuild moves entries to new offsets.
+		mutable ReadWriteLock m_offsetLock;
+
+		/// Background compaction worker, or null if no background compaction is in progress.
+		CompactWorker* m_pCompactWorker;
+		/// Background compaction thread.
+		RunnableThread* m_pCompactThread;
 
 		/// @name Loading Utility Functions
 		//@{
 		bool FinalizeTocLoad();
+		bool ReplayTocRecord(
+			LOAD_VALUE_CALLBACK* pLoadFunction, uint32_t version, const uint8_t*& rpTocCurrent, const uint8_t* pTocMax );
+
+		bool MapIndex();
+		void UnmapIndex();
+		bool MapIndexFile();
+		void UnmapIndexFile();
+		//@}
+
+		/// @name Cooked Index Lookup
+		//@{
+		inline const IndexHeader& GetIndexHeader() const;
+		const IndexRecord* FindIndexRecord( const String& rPath, uint32_t subDataIndex ) const;
+		const Entry& GetIndexEntry( uint32_t index ) const;
+		Entry* MaterializeIndexEntry( const IndexRecord& rRecord, AssetPath path ) const;
+		//@}
+
+		/// @name Saving Utility Functions
+		//@{
+		bool WriteToc();
+		bool AppendTocRecord( const Entry& rEntry );
 		//@}
 
 		/// @name Private Static Utility Functions
@@ -162,6 +328,14 @@ namespace Helium
 		template< typename T > static bool CheckedTocRead(
 			LOAD_VALUE_CALLBACK* pLoadFunction, T& rValue, const char* pDescription, const uint8_t*& rpTocCurrent,
 			const uint8_t* pTocMax );
+
+		static bool WriteTocHeader( Stream& rStream );
+		static bool WriteTocRecord( Stream& rStream, const Entry& rEntry );
+
+		static bool EntryOffsetLess( const Entry* pEntry0, const Entry* pEntry1 );
+
+		static uint64_t ComputeIndexPathHash( const char* pPath, size_t pathSize );
+		static bool IndexRecordLess( const IndexRecord& rRecord0, const IndexRecord& rRecord1 );
 		//@}
 	};
 }
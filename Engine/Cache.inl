@@ -8,6 +8,59 @@ bool Helium::Cache::IsTocLoaded() const
     return m_bTocLoaded;
 }
 
+/// Get whether the cache file is currently memory mapped.
+///
+/// @return  True if the cache file is mapped, false if not.
+///
+/// @see MapCacheFile(), UnmapCacheFile()
+bool Helium::Cache::IsCacheFileMapped() const
+{
+    return m_pMappedData != NULL;
+}
+
+/// Get whether the table of contents was loaded from a memory mapped cooked index.
+///
+/// @return  True if the cooked index is in use, false if not.
+///
+/// @see WriteIndex(), GetIndexFileName()
+bool Helium::Cache::IsIndexMapped() const
+{
+    return m_pIndexData != NULL;
+}
+
+/// Get whether a background compaction started with BeginCompact() has yet to be finished.
+///
+/// @return  True if a background compaction is in progress, false if not.
+///
+/// @see BeginCompact(), TryFinishCompact()
+bool Helium::Cache::IsCompacting() const
+{
+    return m_pCompactWorker != NULL;
+}
+
+/// Get the codec with which new entries are compressed.
+///
+/// @return  Compression codec.
+///
+/// @see SetCompression()
+Helium::CompressionCodec Helium::Cache::GetCompression() const
+{
+    return m_compression;
+}
+
+/// Set the codec with which new entries are compressed.
+///
+/// Entries are only stored compressed if compression makes them smaller.  Existing entries are unaffected.
+///
+/// @param[in] compression  Compression codec.
+///
+/// @see GetCompression()
+void Helium::Cache::SetCompression( CompressionCodec compression )
+{
+    HELIUM_ASSERT( static_cast< size_t >( compression ) < static_cast< size_t >( CompressionCodecs::Count ) );
+    m_compression = compression;
+}
+
 /// Get the name used to identify this cache.
 ///
 /// @return  Cache name.
@@ -44,6 +97,16 @@ const Helium::String& Helium::Cache::GetCacheFileName() const
     return m_cacheFileName;
 }
 
+/// Get the path name of the cooked index file.
+///
+/// @return  Cooked index file path name, or an empty string if the cache has no cooked index.
+///
+/// @see GetTocFileName(), WriteIndex()
+const Helium::String& Helium::Cache::GetIndexFileName() const
+{
+    return m_indexFileName;
+}
+
 /// Get the number of object entries in this cache.
 ///
 /// @return  Asset entry count.
@@ -51,6 +114,11 @@ const Helium::String& Helium::Cache::GetCacheFileName() const
 /// @see GetEntry()
 uint32_t Helium::Cache::GetEntryCount() const
 {
+    if( m_pIndexData )
+    {
+        return GetIndexHeader().entryCount;
+    }
+
     size_t entryCount = m_entries.GetSize();
     HELIUM_ASSERT( entryCount <= UINT32_MAX );
 
@@ -66,6 +134,11 @@ uint32_t Helium::Cache::GetEntryCount() const
 /// @see GetEntryCount()
 const Helium::Cache::Entry& Helium::Cache::GetEntry( uint32_t index ) const
 {
+    if( m_pIndexData )
+    {
+        return GetIndexEntry( index );
+    }
+
     HELIUM_ASSERT( index < m_entries.GetSize() );
 
     Entry* pEntry = m_entries[ index ];
@@ -73,3 +146,15 @@ const Helium::Cache::Entry& Helium::Cache::GetEntry( uint32_t index ) const
 
     return *pEntry;
 }
+
+/// Get the header of the memory mapped cooked index.
+///
+/// @return  Cooked index header.
+///
+/// @see IsIndexMapped()
+const Helium::Cache::IndexHeader& Helium::Cache::GetIndexHeader() const
+{
+    HELIUM_ASSERT( m_pIndexData );
+
+    return *reinterpret_cast< const IndexHeader* >( m_pIndexData );
+}
@@ -6,17 +6,19 @@
 using namespace Helium;
 
 /// Constructor.
-CacheAssetLoader::CacheAssetLoader()
+///
+/// @param[in] bMapCacheFiles  True to memory map the cache files and deserialize directly from them.
+CacheAssetLoader::CacheAssetLoader( bool bMapCacheFiles )
 {
 	m_pAssetPackageLoader = new CachePackageLoader;
 	HELIUM_ASSERT( m_pAssetPackageLoader );
-	HELIUM_VERIFY( m_pAssetPackageLoader->Initialize( Name( TXT("Asset") ) ) );
+	HELIUM_VERIFY( m_pAssetPackageLoader->Initialize( Name( TXT("Asset") ), bMapCacheFiles ) );
 
 	HELIUM_VERIFY( m_pAssetPackageLoader->BeginPreload() );
 
 	m_pConfigPackageLoader = new CachePackageLoader;
 	HELIUM_ASSERT( m_pConfigPackageLoader );
-	HELIUM_VERIFY( m_pConfigPackageLoader->Initialize( Name( TXT("Config") ) ) );
+	HELIUM_VERIFY( m_pConfigPackageLoader->Initialize( Name( TXT("Config") ), bMapCacheFiles ) );
 
 	HELIUM_VERIFY( m_pConfigPackageLoader->BeginPreload() );
 }
@@ -33,21 +35,59 @@ CacheAssetLoader::~CacheAssetLoader()
 
 /// Initialize the static object loader instance as a CacheAssetLoader.
 ///
+/// @param[in] bMapCacheFiles  True to memory map the cache files and deserialize directly from them.
+///
 /// @return  True if the loader was initialized successfully, false if not or another object loader instance already
 ///          exists.
-bool CacheAssetLoader::InitializeStaticInstance()
+bool CacheAssetLoader::InitializeStaticInstance( bool bMapCacheFiles )
 {
 	if( sm_pInstance )
 	{
 		return false;
 	}
 
-	sm_pInstance = new CacheAssetLoader;
+	sm_pInstance = new CacheAssetLoader( bMapCacheFiles );
 	HELIUM_ASSERT( sm_pInstance );
 
 	return true;
 }
 
+/// Begin streaming a bundle of asset objects into memory.
+///
+/// @param[in] bundleName  Name of the bundle cache.
+///
+/// @return  True if the bundle is being loaded or has already been loaded, false if it could not be loaded.
+///
+/// @see CachePackageLoader::BeginLoadBundle()
+bool CacheAssetLoader::BeginLoadBundle( Name bundleName )
+{
+	return m_pAssetPackageLoader->BeginLoadBundle( bundleName );
+}
+
+/// Check whether a bundle of asset objects has finished streaming into memory.
+///
+/// @param[in] bundleName  Name of the bundle cache.
+///
+/// @return  True if the bundle is no longer being read, false if reads are still in progress.
+///
+/// @see CachePackageLoader::TryFinishLoadBundle()
+bool CacheAssetLoader::TryFinishLoadBundle( Name bundleName )
+{
+	return m_pAssetPackageLoader->TryFinishLoadBundle( bundleName );
+}
+
+/// Release the memory held by a bundle of asset objects.
+///
+/// @param[in] bundleName  Name of the bundle cache.
+///
+/// @return  True if the bundle was unloaded or was not loaded, false if it is still in use.
+///
+/// @see CachePackageLoader::UnloadBundle()
+bool CacheAssetLoader::UnloadBundle( Name bundleName )
+{
+	return m_pAssetPackageLoader->UnloadBundle( bundleName );
+}
+
 /// @copydoc AssetLoader::GetPackageLoader()
 PackageLoader* CacheAssetLoader::GetPackageLoader( AssetPath path )
 {
@@ -12,13 +12,20 @@ namespace Helium
 	public:
 		/// @name Construction/Destruction
 		//@{
-		CacheAssetLoader();
+		explicit CacheAssetLoader( bool bMapCacheFiles = false );
 		virtual ~CacheAssetLoader();
 		//@}
 
 		/// @name Static Initialization
 		//@{
-		static bool InitializeStaticInstance();
+		static bool InitializeStaticInstance( bool bMapCacheFiles = false );
+		//@}
+
+		/// @name Bundles
+		//@{
+		bool BeginLoadBundle( Name bundleName );
+		bool TryFinishLoadBundle( Name bundleName );
+		bool UnloadBundle( Name bundleName );
 		//@}
 
 	protected:
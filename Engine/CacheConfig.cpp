@@ -0,0 +1,63 @@
+#include "EnginePch.h"
+#include "Engine/CacheConfig.h"
+
+#include "Engine/CacheManager.h"
+#include "Reflect/TranslatorDeduction.h"
+
+HELIUM_DEFINE_ENUM( Helium::CacheCompressionPolicy::ECompression );
+HELIUM_DEFINE_BASE_STRUCT( Helium::CacheCompressionPolicy );
+HELIUM_IMPLEMENT_ASSET( Helium::CacheConfig, Engine, 0 );
+
+using namespace Helium;
+
+/// Constructor.
+CacheCompressionPolicy::CacheCompressionPolicy()
+: compression( ECompression::NONE )
+{
+}
+
+void CacheCompressionPolicy::PopulateMetaType( Reflect::MetaStruct& comp )
+{
+	comp.AddField( &CacheCompressionPolicy::cacheName,   TXT( "cacheName" ) );
+	comp.AddField( &CacheCompressionPolicy::compression, TXT( "compression" ) );
+}
+
+/// Constructor.
+CacheConfig::CacheConfig()
+{
+}
+
+/// Destructor.
+CacheConfig::~CacheConfig()
+{
+}
+
+void CacheConfig::PopulateMetaType( Reflect::MetaStruct& comp )
+{
+	comp.AddField( &CacheConfig::m_compressionPolicies, TXT( "m_CompressionPolicies" ) );
+}
+
+/// Register each configured compression policy with the cache manager.
+///
+/// Caches that have already been created are updated in place, so this can be called once configuration loading
+/// completes, after the asset loader has opened its caches.
+void CacheConfig::ApplyCompressionPolicies() const
+{
+	CacheManager& rCacheManager = CacheManager::GetStaticInstance();
+
+	size_t policyCount = m_compressionPolicies.GetSize();
+	for( size_t policyIndex = 0; policyIndex < policyCount; ++policyIndex )
+	{
+		const CacheCompressionPolicy& rPolicy = m_compressionPolicies[ policyIndex ];
+		if( rPolicy.cacheName.IsEmpty() )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				TXT( "CacheConfig::ApplyCompressionPolicies(): Skipping compression policy with no cache name.\n" ) );
+
+			continue;
+		}
+
+		rCacheManager.SetCompressionPolicy( rPolicy.cacheName, rPolicy.GetCodec() );
+	}
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Engine/Asset.h"
+#include "Engine/Compression.h"
+
+namespace Helium
+{
+	/// Compression codec selection for a single cache.
+	struct HELIUM_ENGINE_API CacheCompressionPolicy : Reflect::Struct
+	{
+		/// Compression codec (mirrors CompressionCodec for serialization).
+		struct ECompression : Reflect::Enum
+		{
+			enum Enum
+			{
+				NONE,
+				ZLIB,
+			};
+
+			HELIUM_DECLARE_ENUM( ECompression );
+
+			static void PopulateMetaType( Helium::Reflect::MetaEnum& info )
+			{
+				info.AddElement( NONE, TXT( "NONE" ) );
+				info.AddElement( ZLIB, TXT( "ZLIB" ) );
+			}
+		};
+
+		HELIUM_DECLARE_BASE_STRUCT( Helium::CacheCompressionPolicy );
+		CacheCompressionPolicy();
+		static void PopulateMetaType( Reflect::MetaStruct& comp );
+
+		inline bool operator==( const CacheCompressionPolicy& _rhs ) const;
+		inline bool operator!=( const CacheCompressionPolicy& _rhs ) const;
+
+		inline CompressionCodec GetCodec() const;
+
+		/// Cache name (i.e. "Mesh", "Texture").
+		Name cacheName;
+		/// Compression codec to use when writing entries to the cache.
+		ECompression compression;
+	};
+
+	/// Cache configuration data.
+	class HELIUM_ENGINE_API CacheConfig : public Asset
+	{
+		HELIUM_DECLARE_ASSET( CacheConfig, Asset );
+
+	public:
+		/// @name Construction/Destruction
+		//@{
+		CacheConfig();
+		virtual ~CacheConfig();
+		//@}
+
+		static void PopulateMetaType( Reflect::MetaStruct& comp );
+
+		/// @name Data Access
+		//@{
+		inline const DynamicArray< CacheCompressionPolicy >& GetCompressionPolicies() const;
+		//@}
+
+		/// @name Cache Setup
+		//@{
+		void ApplyCompressionPolicies() const;
+		//@}
+
+	public:
+		/// Per-cache compression codecs (caches not listed use CacheManager::DEFAULT_COMPRESSION).
+		DynamicArray< CacheCompressionPolicy > m_compressionPolicies;
+	};
+}
+
+#include "Engine/CacheConfig.inl"
@@ -0,0 +1,33 @@
+namespace Helium
+{
+	bool CacheCompressionPolicy::operator==( const CacheCompressionPolicy& _rhs ) const
+	{
+		return ( 
+			cacheName == _rhs.cacheName &&
+			compression == _rhs.compression
+			);
+	}
+
+	bool CacheCompressionPolicy::operator!=( const CacheCompressionPolicy& _rhs ) const
+	{
+		return !( *this == _rhs );
+	}
+
+	/// Get the compression codec selected by this policy.
+	///
+	/// @return  Compression codec.
+	CompressionCodec CacheCompressionPolicy::GetCodec() const
+	{
+		return ( compression == ECompression::ZLIB ? CompressionCodecs::Zlib : CompressionCodecs::None );
+	}
+
+	/// Get the per-cache compression policies.
+	///
+	/// @return  Compression policies.
+	///
+	/// @see ApplyCompressionPolicies()
+	const DynamicArray< CacheCompressionPolicy >& CacheConfig::GetCompressionPolicies() const
+	{
+		return m_compressionPolicies;
+	}
+}
@@ -0,0 +1,184 @@
+#include "EnginePch.h"
+#include "Engine/Cache.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace Helium;
+
+/// Map a whole file into memory for read-only access.
+///
+/// @param[in]  rFileName  Name of the file to map.
+/// @param[in]  advice     Expected access pattern, passed on to madvise().
+/// @param[out] rSize      Size of the mapping, in bytes.
+///
+/// @return  Start of the mapping, or null if the file could not be mapped.
+static const uint8_t* MapFile( const String& rFileName, int advice, uint64_t& rSize )
+{
+	int fd;
+	do
+	{
+		fd = open( rFileName.GetData(), O_RDONLY | O_CLOEXEC );
+	} while( fd < 0 && errno == EINTR );
+
+	if( fd < 0 )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "Cache: Failed to open \"%s\" for mapping (errno %d).\n" ),
+			*rFileName,
+			errno );
+
+		return NULL;
+	}
+
+	struct stat fileStatus;
+	if( fstat( fd, &fileStatus ) != 0 || fileStatus.st_size <= 0 )
+	{
+		close( fd );
+
+		return NULL;
+	}
+
+	void* pMapping = mmap( NULL, static_cast< size_t >( fileStatus.st_size ), PROT_READ, MAP_PRIVATE, fd, 0 );
+
+	// The mapping holds its own reference to the file.
+	close( fd );
+
+	if( pMapping == MAP_FAILED )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "Cache: Failed to map \"%s\" (errno %d).\n" ),
+			*rFileName,
+			errno );
+
+		return NULL;
+	}
+
+	madvise( pMapping, static_cast< size_t >( fileStatus.st_size ), advice );
+
+	rSize = static_cast< uint64_t >( fileStatus.st_size );
+
+	return static_cast< const uint8_t* >( pMapping );
+}
+
+/// Map the cache file into memory for read-only access.
+///
+/// While mapped, loaders can deserialize entries in place using GetMappedEntryData() instead of reading them into
+/// separate buffers.  The cache cannot be modified while it is mapped.
+///
+/// @return  True if the cache file is mapped, false if mapping failed or is not supported on this platform.
+///
+/// @see UnmapCacheFile(), GetMappedEntryData()
+bool Cache::MapCacheFile()
+{
+	if( m_pMappedData )
+	{
+		return true;
+	}
+
+	// Entries are requested in dependency order rather than file order, so leave readahead to AdviseMappedRange().
+	m_pMappedData = MapFile( m_cacheFileName, MADV_RANDOM, m_mappedSize );
+
+	return ( m_pMappedData != NULL );
+}
+
+/// Unmap a cache file mapped with MapCacheFile().
+///
+/// Any pointers previously returned by GetMappedEntryData() become invalid.
+///
+/// @see MapCacheFile()
+void Cache::UnmapCacheFile()
+{
+	if( m_pMappedData )
+	{
+		munmap( const_cast< uint8_t* >( m_pMappedData ), static_cast< size_t >( m_mappedSize ) );
+		m_pMappedData = NULL;
+		m_mappedSize = 0;
+	}
+}
+
+/// Hint that a range of the memory mapped cache file will be read soon.
+///
+/// @param[in] offset  Byte offset within the cache file.
+/// @param[in] size    Number of bytes.
+///
+/// @see MapCacheFile()
+void Cache::AdviseMappedRange( uint64_t offset, uint64_t size ) const
+{
+	if( !m_pMappedData || offset >= m_mappedSize || size == 0 )
+	{
+		return;
+	}
+
+	size = Min( size, m_mappedSize - offset );
+
+	// madvise() needs a page aligned start address.
+	const uint64_t pageSize = static_cast< uint64_t >( sysconf( _SC_PAGESIZE ) );
+	const uint64_t alignedOffset = offset - offset % pageSize;
+
+	madvise(
+		const_cast< uint8_t* >( m_pMappedData + alignedOffset ),
+		static_cast< size_t >( size + ( offset - alignedOffset ) ),
+		MADV_WILLNEED );
+}
+
+/// Hint that a range of the cache file will be read soon, so that it can be read into the file cache ahead of time.
+///
+/// @param[in] offset  Byte offset within the cache file.
+/// @param[in] size    Number of bytes.
+///
+/// @return  True if the hint was issued, false if it is not supported on this platform.
+///
+/// @see AdviseMappedRange()
+bool Cache::AdviseFileRange( uint64_t offset, uint64_t size ) const
+{
+	int fd;
+	do
+	{
+		fd = open( m_cacheFileName.GetData(), O_RDONLY | O_CLOEXEC );
+	} while( fd < 0 && errno == EINTR );
+
+	if( fd < 0 )
+	{
+		return false;
+	}
+
+	// The readahead is queued against the file itself, so it carries on after the descriptor is closed.
+	int result = posix_fadvise( fd, static_cast< off_t >( offset ), static_cast< off_t >( size ), POSIX_FADV_WILLNEED );
+	close( fd );
+
+	return ( result == 0 );
+}
+
+/// Map the cooked index file into memory for MapIndex().
+///
+/// @return  True if the index file was mapped, false if not.
+///
+/// @see UnmapIndexFile()
+bool Cache::MapIndexFile()
+{
+	HELIUM_ASSERT( !m_pIndexData );
+
+	// Lookups binary search the index, touching only a few pages each.
+	m_pIndexData = MapFile( m_indexFileName, MADV_RANDOM, m_indexSize );
+
+	return ( m_pIndexData != NULL );
+}
+
+/// Unmap the cooked index file mapped by MapIndexFile().
+///
+/// @see MapIndexFile()
+void Cache::UnmapIndexFile()
+{
+	if( m_pIndexData )
+	{
+		munmap( const_cast< uint8_t* >( m_pIndexData ), static_cast< size_t >( m_indexSize ) );
+		m_pIndexData = NULL;
+		m_indexSize = 0;
+	}
+}
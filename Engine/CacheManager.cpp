@@ -70,15 +70,20 @@ Cache* CacheManager::GetCache( Name name, Cache::EPlatform platform )
 	String tocFileName = cacheFileName;
 	tocFileName += TXT( "." ) HELIUM_CACHE_TOC_EXTENSION;
 
+	String indexFileName = cacheFileName;
+	indexFileName += TXT( "." ) HELIUM_CACHE_INDEX_EXTENSION;
+
 	cacheFileName += TXT( "." ) HELIUM_CACHE_EXTENSION;
 
-	if( !pCache->Initialize( name, platform, *tocFileName, *cacheFileName ) )
+	if( !pCache->Initialize( name, platform, *tocFileName, *cacheFileName, *indexFileName ) )
 	{
 		HELIUM_TRACE( TraceLevels::Error, TXT( "CacheManager: Failed to initialize cache \"%s\".\n" ), *name );
 
 		return NULL;
 	}
 
+	pCache->SetCompression( GetCompressionPolicy( name ) );
+
 	if( !m_cacheMaps[ platform ].Insert( cacheAccessor, KeyValue< Name, Cache* >( name, pCache ) ) )
 	{
 		// Cache instance was added while we were trying to create a new one, so release the one we allocated and
@@ -93,6 +98,102 @@ Cache* CacheManager::GetCache( Name name, Cache::EPlatform platform )
 	return pCache;
 }
 
+/// Write the cooked index of every cache of a platform that has been loaded through this manager.
+///
+/// This is intended to be called once cooking has finished, so that runtime builds can look entries up in the index
+/// instead of loading and replaying each TOC journal.
+///
+/// @param[in] platform  Target platform, or Cache::PLATFORM_INVALID to use the current platform.
+///
+/// @return  True if the index of every loaded cache was written successfully, false if any failed.
+///
+/// @see Cache::WriteIndex()
+bool CacheManager::WriteCacheIndices( Cache::EPlatform platform )
+{
+	HELIUM_ASSERT(
+		platform == Cache::PLATFORM_INVALID ||
+		static_cast< size_t >( platform ) < static_cast< size_t >( Cache::PLATFORM_MAX ) );
+
+	if( platform == Cache::PLATFORM_INVALID )
+	{
+		platform = GetCurrentPlatform();
+	}
+
+	bool bSuccess = true;
+
+	ConcurrentHashMap< Name, Cache* >::ConstAccessor cacheAccessor;
+	if( m_cacheMaps[ platform ].First( cacheAccessor ) )
+	{
+		do
+		{
+			Cache* pCache = cacheAccessor->Second();
+			HELIUM_ASSERT( pCache );
+
+			// Caches that were never loaded haven't been written to either.
+			if( pCache->IsTocLoaded() && !pCache->IsIndexMapped() && !pCache->WriteIndex() )
+			{
+				bSuccess = false;
+			}
+
+			++cacheAccessor;
+		} while( cacheAccessor.IsValid() );
+	}
+
+	return bSuccess;
+}
+
+/// Set the codec with which new entries are compressed in the caches with the given name.
+///
+/// Caches store entries uncompressed unless compression is enabled here.  Resource sub-data is stored in a separate
+/// cache for each resource type, so this allows compression to be enabled only for types that benefit from it; data
+/// that is already compressed (such as block compressed textures) gains little, and compressed entries are always
+/// read through the AsyncLoader rather than in place from a memory mapped cache file.  The policy applies to both
+/// existing and future instances of the cache on all platforms.
+///
+/// @param[in] name         Cache name.
+/// @param[in] compression  Compression codec.
+///
+/// @see GetCompressionPolicy()
+void CacheManager::SetCompressionPolicy( Name name, CompressionCodec compression )
+{
+	HELIUM_ASSERT( static_cast< size_t >( compression ) < static_cast< size_t >( CompressionCodecs::Count ) );
+
+	ConcurrentHashMap< Name, CompressionCodec >::Accessor policyAccessor;
+	if( !m_compressionPolicies.Insert( policyAccessor, KeyValue< Name, CompressionCodec >( name, compression ) ) )
+	{
+		policyAccessor->Second() = compression;
+	}
+
+	for( size_t platformIndex = 0; platformIndex < static_cast< size_t >( Cache::PLATFORM_MAX ); ++platformIndex )
+	{
+		ConcurrentHashMap< Name, Cache* >::Accessor cacheAccessor;
+		if( m_cacheMaps[ platformIndex ].Find( cacheAccessor, name ) )
+		{
+			Cache* pCache = cacheAccessor->Second();
+			HELIUM_ASSERT( pCache );
+			pCache->SetCompression( compression );
+		}
+	}
+}
+
+/// Get the codec with which new entries are compressed in the caches with the given name.
+///
+/// @param[in] name  Cache name.
+///
+/// @return  Compression codec.
+///
+/// @see SetCompressionPolicy()
+CompressionCodec CacheManager::GetCompressionPolicy( Name name ) const
+{
+	ConcurrentHashMap< Name, CompressionCodec >::ConstAccessor policyAccessor;
+	if( m_compressionPolicies.Find( policyAccessor, name ) )
+	{
+		return policyAccessor->Second();
+	}
+
+	return DEFAULT_COMPRESSION;
+}
+
 /// Get the cache data directory for the specified platform.
 ///
 /// @param[in] platform  Target platform, or Cache::PLATFORM_INVALID name to use the current platform.
@@ -8,6 +8,8 @@
 #define HELIUM_CACHE_TOC_EXTENSION TXT( "cachetoc" )
 /// Cache file extension.
 #define HELIUM_CACHE_EXTENSION TXT( "cache" )
+/// Cooked cache index file extension.
+#define HELIUM_CACHE_INDEX_EXTENSION TXT( "cacheidx" )
 
 namespace Helium
 {
@@ -17,12 +19,26 @@ namespace Helium
 	public:
 		/// Number of cache objects per cache pool block.
 		static const size_t CACHE_POOL_BLOCK_SIZE = 4;
+		/// Compression codec used by caches without a policy of their own.  Compression is opt-in, since compressed
+		/// entries can't be read in place from memory mapped cache files.
+		static const CompressionCodec DEFAULT_COMPRESSION = CompressionCodecs::None;
 
 		/// @name Cache Access
 		//@{
 		Cache* GetCache( Name name, Cache::EPlatform platform = Cache::PLATFORM_INVALID );
 		//@}
 
+		/// @name Cooked Indices
+		//@{
+		bool WriteCacheIndices( Cache::EPlatform platform = Cache::PLATFORM_INVALID );
+		//@}
+
+		/// @name Compression Policy
+		//@{
+		void SetCompressionPolicy( Name name, CompressionCodec compression );
+		CompressionCodec GetCompressionPolicy( Name name ) const;
+		//@}
+
 		/// @name Filesystem Information
 		//@{
 		const String& GetPlatformDataDirectory( Cache::EPlatform platform = Cache::PLATFORM_INVALID );
@@ -49,6 +65,9 @@ namespace Helium
 		/// Cache lookup tables.
 		ConcurrentHashMap< Name, Cache* > m_cacheMaps[ Cache::PLATFORM_MAX ];
 
+		/// Compression codecs for caches that don't use the default.
+		ConcurrentHashMap< Name, CompressionCodec > m_compressionPolicies;
+
 		/// Singleton instance.
 		static CacheManager* sm_pInstance;
 
@@ -5,6 +5,7 @@
 #include "Engine/AssetLoader.h"
 #include "Engine/AsyncLoader.h"
 #include "Engine/CacheManager.h"
+#include "Engine/LoadProfiler.h"
 #include "Engine/Resource.h"
 
 using namespace Helium;
@@ -13,6 +14,7 @@ using namespace Helium;
 CachePackageLoader::CachePackageLoader()
 : m_pCache( NULL )
 , m_bFinishedCacheTocLoad( false )
+, m_bMappedCacheFile( false )
 , m_loadRequestPool( LOAD_REQUEST_POOL_BLOCK_SIZE )
 {
 }
@@ -25,12 +27,15 @@ CachePackageLoader::~CachePackageLoader()
 
 /// Initialize this package loader for loading from the specified cache files.
 ///
-/// @param[in] cacheName  Name of the cache to use.
+/// @param[in] cacheName      Name of the cache to use.
+/// @param[in] bMapCacheFile  True to memory map the cache file and deserialize objects directly from the mapping
+///                           instead of reading each one into a separate buffer.  If mapping is not possible, objects
+///                           are read through the AsyncLoader as usual.
 ///
 /// @return  True if initialization was successful, false if not.
 ///
 /// @see Shutdown()
-bool CachePackageLoader::Initialize( Name cacheName )
+bool CachePackageLoader::Initialize( Name cacheName, bool bMapCacheFile )
 {
 	HELIUM_ASSERT( !cacheName.IsEmpty() );
 
@@ -50,6 +55,18 @@ bool CachePackageLoader::Initialize( Name cacheName )
 		return false;
 	}
 
+	if( bMapCacheFile )
+	{
+		m_bMappedCacheFile = m_pCache->MapCacheFile();
+		if( !m_bMappedCacheFile )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Info,
+				TXT( "CachePackageLoader::Initialize(): Could not map cache \"%s\", falling back to buffered reads.\n" ),
+				*cacheName );
+		}
+	}
+
 	return true;
 }
 
@@ -58,8 +75,6 @@ bool CachePackageLoader::Initialize( Name cacheName )
 /// @see Initialize()
 void CachePackageLoader::Shutdown()
 {
-	DefaultAllocator allocator;
-
 	AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
 
 	size_t loadRequestCount = m_loadRequests.GetSize();
@@ -74,7 +89,14 @@ void CachePackageLoader::Shutdown()
 				rAsyncLoader.SyncRequest( pRequest->asyncLoadId );
 			}
 
-			allocator.Free( pRequest->pAsyncLoadBuffer );
+			// Deserialization reads from the load buffer, so it must finish before the buffer is released.
+			if( IsValid( pRequest->deserializeWorkId ) )
+			{
+				rAsyncLoader.SyncRequest( pRequest->deserializeWorkId );
+				SetInvalid( pRequest->deserializeWorkId );
+			}
+
+			ReleaseLoadBuffer( pRequest );
 
 			m_loadRequestPool.Release( pRequest );
 		}
@@ -82,6 +104,22 @@ void CachePackageLoader::Shutdown()
 
 	m_loadRequests.Clear();
 
+	// Bundle data can only be released once no load requests are reading from it.
+	size_t bundleCount = m_bundles.GetSize();
+	for( size_t bundleIndex = 0; bundleIndex < bundleCount; ++bundleIndex )
+	{
+		DestroyBundle( m_bundles[ bundleIndex ] );
+	}
+
+	m_bundles.Clear();
+
+	if( m_bMappedCacheFile )
+	{
+		HELIUM_ASSERT( m_pCache );
+		m_pCache->UnmapCacheFile();
+		m_bMappedCacheFile = false;
+	}
+
 	m_pCache = NULL;
 	m_bFinishedCacheTocLoad = false;
 }
@@ -118,6 +156,13 @@ bool CachePackageLoader::TryFinishPreload()
 	{
 		bResult = ( m_pCache->IsTocLoaded() || m_pCache->TryFinishLoadToc() );
 		m_bFinishedCacheTocLoad = bResult;
+
+		// Let the asset loader know load requests waiting on the cache TOC can now proceed.
+		AssetLoader* pAssetLoader = AssetLoader::GetStaticInstance();
+		if( bResult && pAssetLoader )
+		{
+			pAssetLoader->WakePackageLoadRequests( this );
+		}
 	}
 
 	return bResult;
@@ -140,16 +185,27 @@ size_t CachePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 		LoadRequest* pRequest = m_loadRequestPool.Allocate();
 		HELIUM_ASSERT( pRequest );
 		pRequest->pEntry = NULL;
+		pRequest->pBundle = NULL;
 		pRequest->pResolver = pResolver;
 
 		ResolvePackage( pRequest->spObject, path );
 		HELIUM_ASSERT( pRequest->spObject );
 
+		// Start streaming in the bundle written for a root package by the cook, if any, so that the objects loaded
+		// from the package are read with a few large reads.
+		if( path.GetParent().IsEmpty() )
+		{
+			BeginLoadPackageBundle( path );
+		}
+
 		SetInvalid( pRequest->asyncLoadId );
 		pRequest->pAsyncLoadBuffer = NULL;
 		pRequest->pSerializedData = NULL;
 		pRequest->pPropertyStreamEnd = NULL;
 		pRequest->pPersistentResourceStreamEnd = NULL;
+		SetInvalid( pRequest->deserializeWorkId );
+		HELIUM_ASSERT( !pRequest->spCachedObject );
+		HELIUM_ASSERT( !pRequest->spCachedResourceData );
 		HELIUM_ASSERT( pRequest->typeLinkTable.IsEmpty() );
 		HELIUM_ASSERT( pRequest->objectLinkTable.IsEmpty() );
 		HELIUM_ASSERT( !pRequest->spType );
@@ -178,6 +234,15 @@ size_t CachePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 		return Invalid< size_t >();
 	}
 
+	// Prefer loading from any loaded bundle holding an up-to-date copy of the object, as its data is already on its
+	// way into memory.
+	Bundle* pBundle = NULL;
+	const Cache::Entry* pBundleEntry = FindBundleEntry( *pEntry, pBundle );
+	if( pBundleEntry )
+	{
+		pEntry = pBundleEntry;
+	}
+
 #ifndef NDEBUG
 	size_t loadRequestSize = m_loadRequests.GetSize();
 	for( size_t loadRequestIndex = 0; loadRequestIndex < loadRequestSize; ++loadRequestIndex )
@@ -206,12 +271,16 @@ size_t CachePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 	LoadRequest* pRequest = m_loadRequestPool.Allocate();
 	HELIUM_ASSERT( pRequest );
 	pRequest->pEntry = pEntry;
+	pRequest->pBundle = pBundle;
 	HELIUM_ASSERT( !pRequest->spObject );
 	SetInvalid( pRequest->asyncLoadId );
 	pRequest->pAsyncLoadBuffer = NULL;
 	pRequest->pSerializedData = NULL;
 	pRequest->pPropertyStreamEnd = NULL;
 	pRequest->pPersistentResourceStreamEnd = NULL;
+	SetInvalid( pRequest->deserializeWorkId );
+	HELIUM_ASSERT( !pRequest->spCachedObject );
+	HELIUM_ASSERT( !pRequest->spCachedResourceData );
 	HELIUM_ASSERT( pRequest->typeLinkTable.IsEmpty() );
 	HELIUM_ASSERT( pRequest->objectLinkTable.IsEmpty() );
 	HELIUM_ASSERT( !pRequest->spType );
@@ -242,22 +311,24 @@ size_t CachePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 	{
 		HELIUM_ASSERT( !pObject || !pObject->GetAnyFlagSet( Asset::FLAG_LOADED | Asset::FLAG_LINKED ) );
 
-		HELIUM_TRACE(
-			TraceLevels::Debug,
-			TXT( "CachePackageLoader::BeginLoadObject(): Issuing async load of property data for \"%s\".\n" ),
-			*path.ToString() );
-
-		size_t entrySize = pEntry->size;
-		pRequest->pAsyncLoadBuffer = static_cast< uint8_t* >( DefaultAllocator().Allocate( entrySize ) );
-		HELIUM_ASSERT( pRequest->pAsyncLoadBuffer );
+		if( pBundle )
+		{
+			// The data is picked up from the bundle by Tick() once the bundle read covering it has completed.
+			HELIUM_TRACE(
+				TraceLevels::Debug,
+				TXT( "CachePackageLoader::BeginLoadObject(): Loading property data for \"%s\" from bundle \"%s\".\n" ),
+				*path.ToString(),
+				*pBundle->name );
+		}
+		else
+		{
+			HELIUM_TRACE(
+				TraceLevels::Debug,
+				TXT( "CachePackageLoader::BeginLoadObject(): Issuing async load of property data for \"%s\".\n" ),
+				*path.ToString() );
 
-		AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
-		pRequest->asyncLoadId = rLoader.QueueRequest(
-			pRequest->pAsyncLoadBuffer,
-			m_pCache->GetCacheFileName(),
-			pEntry->offset,
-			entrySize );
-		HELIUM_ASSERT( IsValid( pRequest->asyncLoadId ) );
+			BeginCacheLoad( pRequest );
+		}
 	}
 
 	size_t requestId = m_loadRequests.Add( pRequest );
@@ -353,6 +424,14 @@ bool CachePackageLoader::TryFinishLoadObject( size_t requestId, AssetPtr& rspObj
 /// Update this package loader.
 void CachePackageLoader::Tick()
 {
+	// Pick up the cache TOC load completing even if no load request is checking on it.
+	if( !m_bFinishedCacheTocLoad )
+	{
+		TryFinishPreload();
+	}
+
+	TickBundles();
+
 	// Process pending load requests.
 	size_t loadRequestSize = m_loadRequests.GetSize();
 	for( size_t loadRequestIndex = 0; loadRequestIndex < loadRequestSize; ++loadRequestIndex )
@@ -374,6 +453,18 @@ void CachePackageLoader::Tick()
 					continue;
 				}
 			}
+			else if( pRequest->pBundle && !pRequest->pAsyncLoadBuffer )
+			{
+				if( !TickBundleLoad( pRequest ) )
+				{
+					continue;
+				}
+			}
+			else if( ( pRequest->flags & LOAD_FLAG_MAPPED ) && !pRequest->pSerializedData )
+			{
+				HELIUM_ASSERT( pRequest->pEntry );
+				FinishCacheLoad( pRequest, pRequest->pEntry->size );
+			}
 
 			// Preloaded flag may be set if the cache load step failed.
 			if( !( pRequest->flags & LOAD_FLAG_PRELOADED ) )
@@ -383,11 +474,17 @@ void CachePackageLoader::Tick()
 					continue;
 				}
 			}
+
+			// Let the asset loader know the request is ready to be synced.
+			AssetPath path = ( pRequest->pEntry ? pRequest->pEntry->path : pRequest->spObject->GetPath() );
+			AssetLoader::GetStaticInstance()->WakeLoadRequest( path );
 		}
 
 		HELIUM_ASSERT( IsInvalid( pRequest->asyncLoadId ) );
 		HELIUM_ASSERT( pRequest->pAsyncLoadBuffer == NULL );
 	}
+
+	UnloadIdleBundles();
 }
 
 /// @copydoc PackageLoader::GetObjectCount()
@@ -409,217 +506,1061 @@ AssetPath CachePackageLoader::GetAssetPath( size_t index ) const
 	return rEntry.path;
 }
 
-/// Tick the async loading of binary serialized data from the object cache for the given load request.
+/// Begin streaming a bundle into memory.
 ///
-/// @param[in] pRequest  Load request.
+/// Bundles are caches written by WriteBundle() holding all the objects of a package along with their dependencies,
+/// stored in the order in which they are loaded.  The whole bundle is read front to back with a few large sequential
+/// reads, and objects found in it are loaded from memory as soon as the part of the bundle holding them has been read
+/// instead of with separate reads from the main cache.
 ///
-/// @return  True if the cache load process has completed, false if it still requires processing.
-bool CachePackageLoader::TickCacheLoad( LoadRequest* pRequest )
+/// @param[in] bundleName  Name of the bundle cache.
+///
+/// @return  True if the bundle is being loaded or has already been loaded, false if it could not be loaded.
+///
+/// @see TryFinishLoadBundle(), UnloadBundle(), WriteBundle()
+bool CachePackageLoader::BeginLoadBundle( Name bundleName )
 {
-	HELIUM_ASSERT( pRequest );
-	HELIUM_ASSERT( !( pRequest->flags & LOAD_FLAG_PRELOADED ) );
+	HELIUM_ASSERT( m_pCache );
+	HELIUM_ASSERT( !bundleName.IsEmpty() );
 
-	AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
+	if( IsValid( FindBundle( bundleName ) ) )
+	{
+		return true;
+	}
 
-	size_t bytesRead = 0;
-	if( !rAsyncLoader.TrySyncRequest( pRequest->asyncLoadId, bytesRead ) )
+	Cache* pBundleCache = CacheManager::GetStaticInstance().GetCache( bundleName );
+	if( !pBundleCache || pBundleCache == m_pCache )
 	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "CachePackageLoader::BeginLoadBundle(): Failed to initialize bundle \"%s\".\n" ),
+			*bundleName );
+
 		return false;
 	}
 
-	SetInvalid( pRequest->asyncLoadId );
+	// Objects are looked up in the bundle as soon as it has been added, so its index must be available up front.  When
+	// a cooked index exists, this only maps it.
+	pBundleCache->EnforceTocLoad();
 
-	if( bytesRead == 0 || IsInvalid( bytesRead ) )
-	{
-		HELIUM_ASSERT( pRequest->pEntry );
+	const String& rBundleFileName = pBundleCache->GetCacheFileName();
 
+	Status status;
+	status.Read( rBundleFileName.GetData() );
+	int64_t bundleFileSize = status.m_Size;
+	if( bundleFileSize <= 0 || static_cast< uint64_t >( bundleFileSize ) > static_cast< uint64_t >( ~static_cast< size_t >( 0 ) ) )
+	{
 		HELIUM_TRACE(
 			TraceLevels::Error,
-			TXT( "CachePackageLoader: Failed to read cache data for object \"%s\".\n" ),
-			*pRequest->pEntry->path.ToString() );
-	}
-	else
-	{
-		uint8_t* pBufferEnd = pRequest->pAsyncLoadBuffer + bytesRead;
-		pRequest->pPropertyStreamEnd = pBufferEnd;
-		pRequest->pPersistentResourceStreamEnd = pBufferEnd;
+			TXT( "CachePackageLoader::BeginLoadBundle(): Bundle file \"%s\" is missing or cannot be loaded.\n" ),
+			*rBundleFileName );
 
-		//TODO: I am suspecting this doesn't work at all as we no longer use link tables for loading loose assets
-		if( DeserializeLinkTables( pRequest ) )
-		{
-			return true;
-		}
+		return false;
 	}
 
-	// An error occurred attempting to load the property data, so mark any existing object as fully loaded (nothing
-	// else will be done with the object itself from here on out).
-	DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
-	pRequest->pAsyncLoadBuffer = NULL;
+	size_t bundleSize = static_cast< size_t >( bundleFileSize );
 
-	Asset* pObject = pRequest->spObject;
-	if( pObject )
+	Bundle* pBundle = new Bundle;
+	HELIUM_ASSERT( pBundle );
+	pBundle->name = bundleName;
+	pBundle->pCache = pBundleCache;
+	pBundle->pData = static_cast< uint8_t* >( DefaultAllocator().Allocate( bundleSize ) );
+	HELIUM_ASSERT( pBundle->pData );
+	pBundle->size = bundleSize;
+	pBundle->syncedReadCount = 0;
+	pBundle->loadedSize = 0;
+	pBundle->bFailed = false;
+	pBundle->bAutoUnload = false;
+
+	AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
+
+	pBundle->readIds.Reserve( ( bundleSize + BUNDLE_READ_SIZE - 1 ) / BUNDLE_READ_SIZE );
+	for( size_t readOffset = 0; readOffset < bundleSize; readOffset += BUNDLE_READ_SIZE )
 	{
-		pObject->SetFlags( Asset::FLAG_PRELOADED | Asset::FLAG_LINKED );
-		pObject->ConditionalFinalizeLoad();
+		size_t readSize = Min( bundleSize - readOffset, BUNDLE_READ_SIZE );
+		size_t readId = rAsyncLoader.QueueRequest( pBundle->pData + readOffset, rBundleFileName, readOffset, readSize );
+		HELIUM_ASSERT( IsValid( readId ) );
+		pBundle->readIds.Push( readId );
 	}
 
-	pRequest->flags |= LOAD_FLAG_PRELOADED | LOAD_FLAG_ERROR;
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		( TXT( "CachePackageLoader::BeginLoadBundle(): Streaming bundle \"%s\" (%" ) PRIuSZ TXT( " bytes in %" )
+		PRIuSZ TXT( " reads).\n" ) ),
+		*bundleName,
+		bundleSize,
+		pBundle->readIds.GetSize() );
+
+	m_bundles.Push( pBundle );
 
 	return true;
 }
 
-/// Tick the object deserialization process for the given object load request.
+/// Check whether a bundle has finished streaming into memory.
 ///
-/// @param[in] pRequest  Load request.
+/// Objects can be loaded from a bundle while it is still streaming in, so syncing on this is only needed to know
+/// when all of the bundle reads have been issued and completed.
 ///
-/// @return  True if the deserialization process has completed, false if it still needs time to process.
-bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
+/// @param[in] bundleName  Name of the bundle cache.
+///
+/// @return  True if the bundle has been fully read (or could not be read, or is not loaded), false if reads are still
+///          in progress.
+///
+/// @see BeginLoadBundle()
+bool CachePackageLoader::TryFinishLoadBundle( Name bundleName )
 {
-	HELIUM_ASSERT( pRequest );
-	HELIUM_ASSERT( !( pRequest->flags & LOAD_FLAG_PRELOADED ) );
+	TickBundles();
 
-	Asset* pObject = pRequest->spObject;
-
-	const Cache::Entry* pCacheEntry = pRequest->pEntry;
-	HELIUM_ASSERT( pCacheEntry );
-
-	// Wait for the template and owner objects to load.
-	AssetLoader* pAssetLoader = AssetLoader::GetStaticInstance();
-	HELIUM_ASSERT( pAssetLoader );
-
-	if( IsValid( pRequest->templateLinkIndex ) )
+	size_t bundleIndex = FindBundle( bundleName );
+	if( IsInvalid( bundleIndex ) )
 	{
-		HELIUM_ASSERT( pRequest->templateLinkIndex < pRequest->objectLinkTable.GetSize() );
-		size_t templateLoadId = pRequest->objectLinkTable[ pRequest->templateLinkIndex ];
-		if( IsValid( templateLoadId ) && !pAssetLoader->TryFinishLoad( templateLoadId, pRequest->spTemplate ) )
-		{
-			return false;
-		}
-
-		SetInvalid( pRequest->templateLinkIndex );
-
-		if( !pRequest->spTemplate )
-		{
-			HELIUM_TRACE(
-				TraceLevels::Error,
-				TXT( "CachePackageLoader: Failed to load template object for \"%s\".\n" ),
-				*pCacheEntry->path.ToString() );
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "CachePackageLoader::TryFinishLoadBundle(): Bundle \"%s\" is not loaded.\n" ),
+			*bundleName );
 
-			if( pObject )
-			{
-				pObject->SetFlags( Asset::FLAG_PRELOADED | Asset::FLAG_LINKED );
-				pObject->ConditionalFinalizeLoad();
-			}
+		return true;
+	}
 
-			DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
-			pRequest->pAsyncLoadBuffer = NULL;
+	const Bundle* pBundle = m_bundles[ bundleIndex ];
+	HELIUM_ASSERT( pBundle );
 
-			pRequest->flags |= LOAD_FLAG_PRELOADED | LOAD_FLAG_ERROR;
+	return ( pBundle->syncedReadCount == pBundle->readIds.GetSize() );
+}
 
-			return true;
-		}
+/// Release the memory held by a bundle loaded with BeginLoadBundle().
+///
+/// A bundle cannot be unloaded while load requests are still using it.
+///
+/// @param[in] bundleName  Name of the bundle cache.
+///
+/// @return  True if the bundle was unloaded or was not loaded, false if it is still in use.
+///
+/// @see BeginLoadBundle()
+bool CachePackageLoader::UnloadBundle( Name bundleName )
+{
+	size_t bundleIndex = FindBundle( bundleName );
+	if( IsInvalid( bundleIndex ) )
+	{
+		return true;
 	}
 
-	Asset* pTemplate = pRequest->spTemplate;
+	Bundle* pBundle = m_bundles[ bundleIndex ];
+	HELIUM_ASSERT( pBundle );
 
-	if( IsValid( pRequest->ownerLinkIndex ) )
+	size_t loadRequestSize = m_loadRequests.GetSize();
+	for( size_t loadRequestIndex = 0; loadRequestIndex < loadRequestSize; ++loadRequestIndex )
 	{
-		HELIUM_ASSERT( pRequest->ownerLinkIndex < pRequest->objectLinkTable.GetSize() );
-		size_t ownerLoadId = pRequest->objectLinkTable[ pRequest->ownerLinkIndex ];
-		if( IsValid( ownerLoadId ) && !pAssetLoader->TryFinishLoad( ownerLoadId, pRequest->spOwner ) )
+		if( m_loadRequests.IsElementValid( loadRequestIndex ) && m_loadRequests[ loadRequestIndex ]->pBundle == pBundle )
 		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				TXT( "CachePackageLoader::UnloadBundle(): Bundle \"%s\" is still in use by pending load requests.\n" ),
+				*bundleName );
+
 			return false;
 		}
+	}
 
-		SetInvalid( pRequest->ownerLinkIndex );
+	DestroyBundle( pBundle );
+	m_bundles.Remove( bundleIndex );
 
-		if( !pRequest->spOwner )
-		{
-			HELIUM_TRACE(
-				TraceLevels::Error,
-				TXT( "CachePackageLoader: Failed to load owner object for \"%s\".\n" ),
-				*pCacheEntry->path.ToString() );
+	return true;
+}
 
-			if( pObject )
-			{
-				pObject->SetFlags( Asset::FLAG_PRELOADED | Asset::FLAG_LINKED );
-				pObject->ConditionalFinalizeLoad();
-			}
+/// Check whether an object would currently be loaded from one of the loaded bundles.
+///
+/// @param[in] path  Object path.
+///
+/// @return  True if an up-to-date copy of the object is held in a loaded bundle, false if it is loaded from the main
+///          cache.
+///
+/// @see BeginLoadBundle()
+bool CachePackageLoader::IsBundled( AssetPath path ) const
+{
+	HELIUM_ASSERT( m_pCache );
 
-			DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
-			pRequest->pAsyncLoadBuffer = NULL;
+	const Cache::Entry* pEntry = m_pCache->FindEntry( path, 0 );
+	if( !pEntry )
+	{
+		return false;
+	}
 
-			pRequest->flags |= LOAD_FLAG_PRELOADED | LOAD_FLAG_ERROR;
+	Bundle* pBundle = NULL;
 
-			return true;
-		}
-	}
+	return ( FindBundleEntry( *pEntry, pBundle ) != NULL );
+}
 
-	Asset* pOwner = pRequest->spOwner;
+/// Get the name of the bundle cache written for a root package by the cook.
+///
+/// @param[in] packagePath  Root package path.
+///
+/// @return  Bundle cache name.
+///
+/// @see WriteBundle(), BeginLoadBundle()
+Name CachePackageLoader::GetBundleName( AssetPath packagePath )
+{
+	HELIUM_ASSERT( !packagePath.IsEmpty() );
 
-	HELIUM_ASSERT( !pOwner || pOwner->IsFullyLoaded() );
-	HELIUM_ASSERT( !pTemplate || pTemplate->IsFullyLoaded() );
+	String bundleNameString( TXT( "Bundle_" ) );
+	bundleNameString += *packagePath.GetName();
 
-	AssetType* pType = pRequest->spType;
-	HELIUM_ASSERT( pType );
+	return Name( bundleNameString );
+}
 
-	// If we already had an existing object, make sure the type and template match.
-	if( pObject )
+#if HELIUM_TOOLS
+/// Read a value from the link table of a serialized cache entry.
+///
+/// @param[out]    rValue      Value read.
+/// @param[in,out] rpCurrent   Current read position, advanced past the value if it was read.
+/// @param[in]     pEnd        End of the link table data.
+///
+/// @return  True if the value was read, false if the end of the data was reached.
+static bool ReadLinkTableValue( uint32_t& rValue, const uint8_t*& rpCurrent, const uint8_t* pEnd )
+{
+	if( static_cast< size_t >( pEnd - rpCurrent ) < sizeof( rValue ) )
 	{
-		const AssetType* pExistingType = pObject->GetAssetType();
-		HELIUM_ASSERT( pExistingType );
-		if( pExistingType != pType )
-		{
-			HELIUM_TRACE(
-				TraceLevels::Error,
-				( TXT( "CachePackageLoader: Cannot load \"%s\" using the existing object as the types do not " )
-				TXT( "match (existing type: \"%s\"; serialized type: \"%s\".\n" ) ),
-				*pCacheEntry->path.ToString(),
-				*pExistingType->GetName(),
-				*pType->GetName() );
+		return false;
+	}
 
-			pObject->SetFlags( Asset::FLAG_PRELOADED | Asset::FLAG_LINKED );
-			pObject->ConditionalFinalizeLoad();
+	MemoryCopy( &rValue, rpCurrent, sizeof( rValue ) );
+	rpCurrent += sizeof( rValue );
 
-			DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
-			pRequest->pAsyncLoadBuffer = NULL;
+	return true;
+}
 
-			pRequest->flags |= LOAD_FLAG_PRELOADED | LOAD_FLAG_ERROR;
+/// Gather the paths of the objects referenced by a serialized cache entry, in the order in which their loads are
+/// begun when the entry is loaded.
+///
+/// @param[in]  rData          Serialized entry data.
+/// @param[out] rDependencies  Referenced object paths (appended to the array).
+///
+/// @return  True if the entry was parsed successfully, false if not.
+static bool GetEntryDependencies( const DynamicArray< uint8_t >& rData, DynamicArray< AssetPath >& rDependencies )
+{
+	const uint8_t* pCurrent = rData.GetData();
+	const uint8_t* pDataEnd = pCurrent + rData.GetSize();
 
-			return true;
-		}
-	}
-	else
+	uint32_t propertyStreamSize;
+	if( !ReadLinkTableValue( propertyStreamSize, pCurrent, pDataEnd ) )
 	{
-		// Create the object.
-		if( !Asset::CreateObject( pRequest->spObject, pType, pCacheEntry->path.GetName(), pOwner, pTemplate ) )
-		{
-			HELIUM_TRACE(
-				TraceLevels::Error,
-				TXT( "CachePackageLoader: Failed to create \"%s\" during loading.\n" ),
-				*pCacheEntry->path.ToString() );
+		return false;
+	}
 
-			DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
-			pRequest->pAsyncLoadBuffer = NULL;
+	const uint8_t* pPropertyStreamEnd = pCurrent + Min< size_t >( propertyStreamSize, pDataEnd - pCurrent );
 
-			pRequest->flags |= LOAD_FLAG_PRELOADED | LOAD_FLAG_ERROR;
+	// Skip the type link table.
+	uint32_t typeLinkTableSize;
+	if( !ReadLinkTableValue( typeLinkTableSize, pCurrent, pPropertyStreamEnd ) )
+	{
+		return false;
+	}
 
-			return true;
+	for( uint32_t linkTableIndex = 0; linkTableIndex < typeLinkTableSize; ++linkTableIndex )
+	{
+		uint32_t typeNameSize;
+		if( !ReadLinkTableValue( typeNameSize, pCurrent, pPropertyStreamEnd ) ||
+			typeNameSize > static_cast< size_t >( pPropertyStreamEnd - pCurrent ) )
+		{
+			return false;
 		}
 
-		pObject = pRequest->spObject;
-		HELIUM_ASSERT( pObject );
+		pCurrent += typeNameSize;
 	}
-		
-	Reflect::ObjectPtr cached_object = Cache::ReadCacheObjectFromBuffer(
-		pRequest->pSerializedData, 
-		0, 
-		pRequest->pPropertyStreamEnd - pRequest->pSerializedData, 
-		pRequest->pResolver);
 
-	if (!cached_object.ReferencesObject())
+	// Objects in the object link table are loaded first.
+	uint32_t objectLinkTableSize;
+	if( !ReadLinkTableValue( objectLinkTableSize, pCurrent, pPropertyStreamEnd ) )
 	{
-		HELIUM_TRACE(
+		return false;
+	}
+
+	DynamicArray< char > pathString;
+	for( uint32_t linkTableIndex = 0; linkTableIndex < objectLinkTableSize; ++linkTableIndex )
+	{
+		uint32_t pathStringSize;
+		if( !ReadLinkTableValue( pathStringSize, pCurrent, pPropertyStreamEnd ) ||
+			pathStringSize > static_cast< size_t >( pPropertyStreamEnd - pCurrent ) )
+		{
+			return false;
+		}
+
+		pathString.Resize( pathStringSize + 1 );
+		MemoryCopy( pathString.GetData(), pCurrent, pathStringSize );
+		pathString[ pathStringSize ] = TXT( '\0' );
+		pCurrent += pathStringSize;
+
+		AssetPath path;
+		if( path.Set( pathString.GetData() ) )
+		{
+			rDependencies.Push( path );
+		}
+	}
+
+	// Skip the type, template, and owner link indices.
+	uint32_t linkIndex;
+	if( !ReadLinkTableValue( linkIndex, pCurrent, pPropertyStreamEnd ) ||
+		!ReadLinkTableValue( linkIndex, pCurrent, pPropertyStreamEnd ) ||
+		!ReadLinkTableValue( linkIndex, pCurrent, pPropertyStreamEnd ) )
+	{
+		return false;
+	}
+
+	// Objects referenced by the property and persistent resource data are loaded once it has been deserialized.
+	DeferredAssetResolver resolver;
+	Reflect::ObjectPtr spCachedObject = Cache::ReadCacheObjectFromBuffer(
+		pCurrent,
+		0,
+		pPropertyStreamEnd - pCurrent,
+		&resolver );
+
+	const uint8_t* pResourceStreamEnd = pPropertyStreamEnd;
+	if( static_cast< size_t >( pDataEnd - pPropertyStreamEnd ) >= sizeof( uint32_t ) )
+	{
+		pResourceStreamEnd = pDataEnd - sizeof( uint32_t );
+	}
+
+	Reflect::ObjectPtr spCachedResourceData;
+	if( spCachedObject.ReferencesObject() && pResourceStreamEnd != pPropertyStreamEnd )
+	{
+		spCachedResourceData = Cache::ReadCacheObjectFromBuffer(
+			pPropertyStreamEnd,
+			0,
+			pResourceStreamEnd - pPropertyStreamEnd,
+			&resolver );
+	}
+
+	size_t referenceCount = resolver.m_References.GetSize();
+	for( size_t referenceIndex = 0; referenceIndex < referenceCount; ++referenceIndex )
+	{
+		AssetPath path;
+		if( path.Set( *resolver.m_References[ referenceIndex ].m_Identity ) )
+		{
+			rDependencies.Push( path );
+		}
+	}
+
+	return true;
+}
+
+/// Write a bundle holding all objects cached within a package along with all the objects they depend on.
+///
+/// Objects are stored in the order in which they are loaded, with each object followed by its dependencies, depth
+/// first, so that streaming the bundle front to back with BeginLoadBundle() provides objects roughly in the order in
+/// which they are requested.  Dependencies that are not in this loader's cache (such as packages, which are never
+/// cached) are skipped.  Only the main (sub-data 0) entry of each object is bundled, as sub-data is loaded on demand
+/// from the main cache.  The bundle is written as a cache of its own, along with its cooked index.
+///
+/// @param[in] packagePath  Path of the package to bundle.
+/// @param[in] bundleName   Name of the bundle cache to write.
+///
+/// @return  True if the bundle was written successfully, false if not.
+///
+/// @see BeginLoadBundle()
+bool CachePackageLoader::WriteBundle( AssetPath packagePath, Name bundleName )
+{
+	HELIUM_ASSERT( m_pCache );
+	HELIUM_ASSERT( !packagePath.IsEmpty() );
+	HELIUM_ASSERT( !bundleName.IsEmpty() );
+
+	if( IsValid( FindBundle( bundleName ) ) )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "CachePackageLoader::WriteBundle(): Cannot write bundle \"%s\" while it is loaded.\n" ),
+			*bundleName );
+
+		return false;
+	}
+
+	Cache* pBundleCache = CacheManager::GetStaticInstance().GetCache( bundleName );
+	if( !pBundleCache || pBundleCache == m_pCache )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "CachePackageLoader::WriteBundle(): Failed to initialize bundle \"%s\".\n" ),
+			*bundleName );
+
+		return false;
+	}
+
+	m_pCache->EnforceTocLoad();
+	pBundleCache->EnforceTocLoad();
+
+	// Walk the dependencies depth first from the objects in the package, storing each object the first time it is
+	// reached.  Paths are popped off the back of the pending list, so they are pushed in reverse to be visited in order.
+	DynamicArray< AssetPath > pendingPaths;
+
+	uint32_t entryCount = m_pCache->GetEntryCount();
+	for( uint32_t entryIndex = entryCount; entryIndex != 0; --entryIndex )
+	{
+		const Cache::Entry& rEntry = m_pCache->GetEntry( entryIndex - 1 );
+		if( rEntry.subDataIndex == 0 && rEntry.path.IsWithinAssetPath( packagePath ) )
+		{
+			pendingPaths.Push( rEntry.path );
+		}
+	}
+
+	HashMap< AssetPath, bool > visitedPaths;
+	DynamicArray< const Cache::Entry* > bundleEntries;
+	DynamicArray< uint8_t > entryData;
+	DynamicArray< AssetPath > dependencies;
+
+	while( !pendingPaths.IsEmpty() )
+	{
+		AssetPath path = pendingPaths.GetLast();
+		pendingPaths.Pop();
+
+		HashMap< AssetPath, bool >::Iterator visitedIterator;
+		if( !visitedPaths.Insert( visitedIterator, KeyValue< AssetPath, bool >( path, true ) ) )
+		{
+			continue;
+		}
+
+		const Cache::Entry* pEntry = m_pCache->FindEntry( path, 0 );
+		if( !pEntry )
+		{
+			continue;
+		}
+
+		bundleEntries.Push( pEntry );
+
+		if( !m_pCache->ReadEntry( *pEntry, entryData ) )
+		{
+			return false;
+		}
+
+		dependencies.Resize( 0 );
+		if( !GetEntryDependencies( entryData, dependencies ) )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				TXT( "CachePackageLoader::WriteBundle(): Failed to parse the dependencies of \"%s\".\n" ),
+				*path.ToString() );
+		}
+
+		for( size_t dependencyIndex = dependencies.GetSize(); dependencyIndex != 0; --dependencyIndex )
+		{
+			pendingPaths.Push( dependencies[ dependencyIndex - 1 ] );
+		}
+	}
+
+	if( bundleEntries.IsEmpty() )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "CachePackageLoader::WriteBundle(): No objects in package \"%s\" are cached.\n" ),
+			*packagePath.ToString() );
+
+		return false;
+	}
+
+	if( !pBundleCache->Rebuild( *m_pCache, bundleEntries ) )
+	{
+		return false;
+	}
+
+	if( !pBundleCache->WriteIndex() )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "CachePackageLoader::WriteBundle(): Failed to write the cooked index of bundle \"%s\".\n" ),
+			*bundleName );
+	}
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		TXT( "CachePackageLoader::WriteBundle(): Wrote %" ) PRIuSZ TXT( " objects for \"%s\" to bundle \"%s\".\n" ),
+		bundleEntries.GetSize(),
+		*packagePath.ToString(),
+		*bundleName );
+
+	return true;
+}
+#endif  // HELIUM_TOOLS
+
+/// Find a loaded bundle.
+///
+/// @param[in] bundleName  Name of the bundle cache.
+///
+/// @return  Index of the bundle in the loaded bundle list, or an invalid index if it is not loaded.
+size_t CachePackageLoader::FindBundle( Name bundleName ) const
+{
+	size_t bundleCount = m_bundles.GetSize();
+	for( size_t bundleIndex = 0; bundleIndex < bundleCount; ++bundleIndex )
+	{
+		if( m_bundles[ bundleIndex ]->name == bundleName )
+		{
+			return bundleIndex;
+		}
+	}
+
+	return Invalid< size_t >();
+}
+
+/// Find the entry for an object in the loaded bundles.
+///
+/// Only the main (sub-data 0) entry of each object is bundled.  Bundle entries older than the entry in the main cache
+/// are stale copies left over from before the object was last cached, and are skipped.
+///
+/// @param[in]  rCacheEntry  Main cache entry for the object.
+/// @param[out] rpBundle     Bundle holding the entry, if found.
+///
+/// @return  Bundle cache entry, or null if no usable entry for the object exists in any loaded bundle.
+const Cache::Entry* CachePackageLoader::FindBundleEntry( const Cache::Entry& rCacheEntry, Bundle*& rpBundle ) const
+{
+	HELIUM_ASSERT( rCacheEntry.subDataIndex == 0 );
+
+	size_t bundleCount = m_bundles.GetSize();
+	for( size_t bundleIndex = 0; bundleIndex < bundleCount; ++bundleIndex )
+	{
+		Bundle* pBundle = m_bundles[ bundleIndex ];
+		HELIUM_ASSERT( pBundle );
+		if( pBundle->bFailed )
+		{
+			continue;
+		}
+
+		const Cache::Entry* pEntry = pBundle->pCache->FindEntry( rCacheEntry.path, 0 );
+		if( pEntry &&
+			pEntry->timestamp >= rCacheEntry.timestamp &&
+			pEntry->compression == CompressionCodecs::None &&
+			pEntry->offset <= pBundle->size &&
+			pEntry->size <= pBundle->size - pEntry->offset )
+		{
+			rpBundle = pBundle;
+
+			return pEntry;
+		}
+	}
+
+	return NULL;
+}
+
+/// Begin streaming in the bundle written for a root package by the cook, if one exists.
+///
+/// Bundles loaded this way are unloaded automatically by UnloadIdleBundles().
+///
+/// @param[in] packagePath  Root package path.
+void CachePackageLoader::BeginLoadPackageBundle( AssetPath packagePath )
+{
+	Name bundleName = GetBundleName( packagePath );
+	if( IsValid( FindBundle( bundleName ) ) )
+	{
+		return;
+	}
+
+	CacheManager& rCacheManager = CacheManager::GetStaticInstance();
+
+	String bundleFileName = rCacheManager.GetPlatformDataDirectory( m_pCache->GetPlatform() );
+	bundleFileName += *bundleName;
+	bundleFileName += TXT( "." ) HELIUM_CACHE_EXTENSION;
+
+	Status status;
+	status.Read( bundleFileName.GetData() );
+	if( status.m_Size <= 0 )
+	{
+		return;
+	}
+
+	if( BeginLoadBundle( bundleName ) )
+	{
+		Bundle* pBundle = m_bundles.GetLast();
+		HELIUM_ASSERT( pBundle );
+		HELIUM_ASSERT( pBundle->name == bundleName );
+		pBundle->bAutoUnload = true;
+	}
+}
+
+/// Sync completed bundle reads, in file order.
+void CachePackageLoader::TickBundles()
+{
+	AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
+
+	size_t bundleCount = m_bundles.GetSize();
+	for( size_t bundleIndex = 0; bundleIndex < bundleCount; ++bundleIndex )
+	{
+		Bundle* pBundle = m_bundles[ bundleIndex ];
+		HELIUM_ASSERT( pBundle );
+
+		size_t readCount = pBundle->readIds.GetSize();
+		while( pBundle->syncedReadCount < readCount )
+		{
+			size_t& rReadId = pBundle->readIds[ pBundle->syncedReadCount ];
+
+			size_t bytesRead = 0;
+			if( !rAsyncLoader.TrySyncRequest( rReadId, bytesRead ) )
+			{
+				break;
+			}
+
+			SetInvalid( rReadId );
+			++pBundle->syncedReadCount;
+
+			if( pBundle->bFailed )
+			{
+				continue;
+			}
+
+			size_t readSize = Min( pBundle->size - pBundle->loadedSize, BUNDLE_READ_SIZE );
+			if( bytesRead != readSize )
+			{
+				HELIUM_TRACE(
+					TraceLevels::Warning,
+					( TXT( "CachePackageLoader: Failed to read bundle \"%s\" at offset %" ) PRIuSZ TXT( ".  Loading " )
+					TXT( "its objects from the cache instead.\n" ) ),
+					*pBundle->name,
+					pBundle->loadedSize );
+
+				pBundle->bFailed = true;
+
+				continue;
+			}
+
+			pBundle->loadedSize += readSize;
+		}
+	}
+}
+
+/// Unload the bundles loaded along with their packages once they have been read and no loads are pending.
+void CachePackageLoader::UnloadIdleBundles()
+{
+	size_t loadRequestSize = m_loadRequests.GetSize();
+	for( size_t loadRequestIndex = 0; loadRequestIndex < loadRequestSize; ++loadRequestIndex )
+	{
+		if( m_loadRequests.IsElementValid( loadRequestIndex ) )
+		{
+			return;
+		}
+	}
+
+	size_t bundleIndex = m_bundles.GetSize();
+	while( bundleIndex != 0 )
+	{
+		--bundleIndex;
+
+		Bundle* pBundle = m_bundles[ bundleIndex ];
+		HELIUM_ASSERT( pBundle );
+		if( pBundle->bAutoUnload && pBundle->syncedReadCount == pBundle->readIds.GetSize() )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Debug,
+				TXT( "CachePackageLoader: Unloading bundle \"%s\" now that its loads have finished.\n" ),
+				*pBundle->name );
+
+			DestroyBundle( pBundle );
+			m_bundles.Remove( bundleIndex );
+		}
+	}
+}
+
+/// Sync any outstanding reads for a bundle and free it.
+///
+/// @param[in] pBundle  Bundle to destroy.
+void CachePackageLoader::DestroyBundle( Bundle* pBundle )
+{
+	HELIUM_ASSERT( pBundle );
+
+	AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
+
+	size_t readCount = pBundle->readIds.GetSize();
+	for( size_t readIndex = pBundle->syncedReadCount; readIndex < readCount; ++readIndex )
+	{
+		rAsyncLoader.SyncRequest( pBundle->readIds[ readIndex ] );
+	}
+
+	DefaultAllocator().Free( pBundle->pData );
+
+	delete pBundle;
+}
+
+/// Begin loading the binary serialized data for the given load request from the main cache.
+///
+/// @param[in] pRequest  Load request.
+void CachePackageLoader::BeginCacheLoad( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( !pRequest->pBundle );
+	HELIUM_ASSERT( !pRequest->pAsyncLoadBuffer );
+
+	const Cache::Entry* pEntry = pRequest->pEntry;
+	HELIUM_ASSERT( pEntry );
+
+	size_t entrySize = pEntry->size;
+
+	const uint8_t* pMappedData = ( m_bMappedCacheFile ? m_pCache->GetMappedEntryData( *pEntry ) : NULL );
+	if( pMappedData )
+	{
+		// Deserialization only ever reads from the load buffer, so it can point straight into the read-only
+		// mapping.  The link tables are read on the next tick, by which time the readahead has had a head start.
+		// Requests arrive in dependency order rather than file order, so only the entry's own pages are worth
+		// faulting in ahead of time.
+		pRequest->pAsyncLoadBuffer = const_cast< uint8_t* >( pMappedData );
+		pRequest->flags |= LOAD_FLAG_MAPPED;
+
+		m_pCache->AdviseMappedRange( pEntry->offset, pEntry->storedSize );
+	}
+	else
+	{
+		pRequest->pAsyncLoadBuffer = static_cast< uint8_t* >( DefaultAllocator().Allocate( entrySize ) );
+		HELIUM_ASSERT( pRequest->pAsyncLoadBuffer );
+
+		pRequest->asyncLoadId = m_pCache->QueueEntryLoad( *pEntry, pRequest->pAsyncLoadBuffer, entrySize );
+		HELIUM_ASSERT( IsValid( pRequest->asyncLoadId ) );
+	}
+}
+
+/// Tick the async loading of binary serialized data from the object cache for the given load request.
+///
+/// @param[in] pRequest  Load request.
+///
+/// @return  True if the cache load process has completed, false if it still requires processing.
+bool CachePackageLoader::TickCacheLoad( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( !( pRequest->flags & LOAD_FLAG_PRELOADED ) );
+
+	AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
+
+	size_t bytesRead = 0;
+	if( !rAsyncLoader.TrySyncRequest( pRequest->asyncLoadId, bytesRead ) )
+	{
+		return false;
+	}
+
+	SetInvalid( pRequest->asyncLoadId );
+
+	FinishCacheLoad( pRequest, bytesRead );
+
+	return true;
+}
+
+/// Tick the loading of binary serialized data from a bundle for the given load request.
+///
+/// If the bundle could not be read, the data is loaded from the main cache instead.
+///
+/// @param[in] pRequest  Load request.
+///
+/// @return  True if the bundle load process has completed, false if it still requires processing.
+bool CachePackageLoader::TickBundleLoad( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( !( pRequest->flags & LOAD_FLAG_PRELOADED ) );
+
+	Bundle* pBundle = pRequest->pBundle;
+	HELIUM_ASSERT( pBundle );
+
+	const Cache::Entry* pEntry = pRequest->pEntry;
+	HELIUM_ASSERT( pEntry );
+
+	if( pBundle->bFailed )
+	{
+		pRequest->pBundle = NULL;
+
+		const Cache::Entry* pCacheEntry = m_pCache->FindEntry( pEntry->path, 0 );
+		if( !pCacheEntry )
+		{
+			FinishCacheLoad( pRequest, 0 );
+
+			return true;
+		}
+
+		pRequest->pEntry = pCacheEntry;
+		BeginCacheLoad( pRequest );
+
+		return false;
+	}
+
+	// Bundle entries are never compressed, so they can be deserialized in place once read.
+	HELIUM_ASSERT( pEntry->compression == CompressionCodecs::None );
+	HELIUM_ASSERT( pEntry->offset + pEntry->size <= pBundle->size );
+	if( pBundle->loadedSize < pEntry->offset + pEntry->size )
+	{
+		return false;
+	}
+
+	pRequest->pAsyncLoadBuffer = pBundle->pData + pEntry->offset;
+	pRequest->flags |= LOAD_FLAG_MAPPED;
+
+	FinishCacheLoad( pRequest, pEntry->size );
+
+	return true;
+}
+
+/// Process binary serialized data for the given load request once it is available in the load buffer.
+///
+/// @param[in] pRequest   Load request.
+/// @param[in] bytesRead  Number of bytes available in the load buffer, or an invalid index if the read failed.
+void CachePackageLoader::FinishCacheLoad( LoadRequest* pRequest, size_t bytesRead )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( !( pRequest->flags & LOAD_FLAG_PRELOADED ) );
+
+	if( bytesRead == 0 || IsInvalid( bytesRead ) )
+	{
+		HELIUM_ASSERT( pRequest->pEntry );
+
+		HELIUM_TRACE(
+			TraceLevels::Error,
+			TXT( "CachePackageLoader: Failed to read cache data for object \"%s\".\n" ),
+			*pRequest->pEntry->path.ToString() );
+	}
+	else
+	{
+		LoadProfiler* pLoadProfiler = LoadProfiler::GetStaticInstance();
+		if( pLoadProfiler )
+		{
+			HELIUM_ASSERT( pRequest->pEntry );
+			pLoadProfiler->AddObjectBytes( pRequest->pEntry->path, bytesRead );
+		}
+
+		uint8_t* pBufferEnd = pRequest->pAsyncLoadBuffer + bytesRead;
+		pRequest->pPropertyStreamEnd = pBufferEnd;
+		pRequest->pPersistentResourceStreamEnd = pBufferEnd;
+
+		//TODO: I am suspecting this doesn't work at all as we no longer use link tables for loading loose assets
+		if( DeserializeLinkTables( pRequest ) )
+		{
+			return;
+		}
+	}
+
+	// An error occurred attempting to load the property data, so mark any existing object as fully loaded (nothing
+	// else will be done with the object itself from here on out).
+	ReleaseLoadBuffer( pRequest );
+
+	Asset* pObject = pRequest->spObject;
+	if( pObject )
+	{
+		pObject->SetFlags( Asset::FLAG_PRELOADED | Asset::FLAG_LINKED );
+		pObject->ConditionalFinalizeLoad();
+	}
+
+	pRequest->flags |= LOAD_FLAG_PRELOADED | LOAD_FLAG_ERROR;
+}
+
+/// Release the load buffer for the given load request, along with any data deserialized from it.
+///
+/// @param[in] pRequest  Load request.
+void CachePackageLoader::ReleaseLoadBuffer( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( IsInvalid( pRequest->deserializeWorkId ) );
+
+	pRequest->spCachedObject.Release();
+	pRequest->spCachedResourceData.Release();
+	pRequest->propertyResolver.Clear();
+	pRequest->resourceResolver.Clear();
+
+	// Mapped buffers belong to the cache or bundle.
+	if( !( pRequest->flags & LOAD_FLAG_MAPPED ) )
+	{
+		DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
+	}
+
+	pRequest->pAsyncLoadBuffer = NULL;
+	pRequest->flags &= ~LOAD_FLAG_MAPPED;
+}
+
+/// Tick deserialization of the serialized property and persistent resource data for the given object load request.
+///
+/// The data is deserialized on an async loader worker thread so that independent objects are deserialized in
+/// parallel.  References to other objects found along the way are only recorded by the worker, and are passed on to
+/// the request resolver once deserialization has been synced, as beginning the loads of referenced objects is not
+/// thread-safe.
+///
+/// @param[in] pRequest  Load request.
+///
+/// @return  True if deserialization has completed, false if it still needs time to process.
+bool CachePackageLoader::TickDeserializeData( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( !( pRequest->flags & LOAD_FLAG_DESERIALIZED ) );
+
+	AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
+
+	if( IsValid( pRequest->deserializeWorkId ) )
+	{
+		size_t bytesRead;
+		if( !rAsyncLoader.TrySyncRequest( pRequest->deserializeWorkId, bytesRead ) )
+		{
+			return false;
+		}
+
+		SetInvalid( pRequest->deserializeWorkId );
+	}
+	else
+	{
+		pRequest->deserializeWorkId = rAsyncLoader.QueueWork( DeserializeData, pRequest );
+		if( IsValid( pRequest->deserializeWorkId ) )
+		{
+			return false;
+		}
+
+		// No workers are available, so deserialize on this thread.
+		DeserializeData( pRequest );
+	}
+
+	if( pRequest->pResolver )
+	{
+		pRequest->propertyResolver.ResolveDeferred( pRequest->pResolver );
+	}
+
+	pRequest->flags |= LOAD_FLAG_DESERIALIZED;
+
+	return true;
+}
+
+/// Tick the object deserialization process for the given object load request.
+///
+/// @param[in] pRequest  Load request.
+///
+/// @return  True if the deserialization process has completed, false if it still needs time to process.
+bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( !( pRequest->flags & LOAD_FLAG_PRELOADED ) );
+
+	Asset* pObject = pRequest->spObject;
+
+	const Cache::Entry* pCacheEntry = pRequest->pEntry;
+	HELIUM_ASSERT( pCacheEntry );
+
+	// The serialized data doesn't depend on the template and owner objects, so deserialize it while they load.
+	if( !( pRequest->flags & LOAD_FLAG_DESERIALIZED ) && !TickDeserializeData( pRequest ) )
+	{
+		return false;
+	}
+
+	// Wait for the template and owner objects to load.
+	AssetLoader* pAssetLoader = AssetLoader::GetStaticInstance();
+	HELIUM_ASSERT( pAssetLoader );
+
+	if( IsValid( pRequest->templateLinkIndex ) )
+	{
+		HELIUM_ASSERT( pRequest->templateLinkIndex < pRequest->objectLinkTable.GetSize() );
+		size_t templateLoadId = pRequest->objectLinkTable[ pRequest->templateLinkIndex ];
+		if( IsValid( templateLoadId ) && !pAssetLoader->TryFinishLoad( templateLoadId, pRequest->spTemplate ) )
+		{
+			return false;
+		}
+
+		SetInvalid( pRequest->templateLinkIndex );
+
+		if( !pRequest->spTemplate )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				TXT( "CachePackageLoader: Failed to load template object for \"%s\".\n" ),
+				*pCacheEntry->path.ToString() );
+
+			if( pObject )
+			{
+				pObject->SetFlags( Asset::FLAG_PRELOADED | Asset::FLAG_LINKED );
+				pObject->ConditionalFinalizeLoad();
+			}
+
+			ReleaseLoadBuffer( pRequest );
+
+			pRequest->flags |= LOAD_FLAG_PRELOADED | LOAD_FLAG_ERROR;
+
+			return true;
+		}
+	}
+
+	Asset* pTemplate = pRequest->spTemplate;
+
+	if( IsValid( pRequest->ownerLinkIndex ) )
+	{
+		HELIUM_ASSERT( pRequest->ownerLinkIndex < pRequest->objectLinkTable.GetSize() );
+		size_t ownerLoadId = pRequest->objectLinkTable[ pRequest->ownerLinkIndex ];
+		if( IsValid( ownerLoadId ) && !pAssetLoader->TryFinishLoad( ownerLoadId, pRequest->spOwner ) )
+		{
+			return false;
+		}
+
+		SetInvalid( pRequest->ownerLinkIndex );
+
+		if( !pRequest->spOwner )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				TXT( "CachePackageLoader: Failed to load owner object for \"%s\".\n" ),
+				*pCacheEntry->path.ToString() );
+
+			if( pObject )
+			{
+				pObject->SetFlags( Asset::FLAG_PRELOADED | Asset::FLAG_LINKED );
+				pObject->ConditionalFinalizeLoad();
+			}
+
+			ReleaseLoadBuffer( pRequest );
+
+			pRequest->flags |= LOAD_FLAG_PRELOADED | LOAD_FLAG_ERROR;
+
+			return true;
+		}
+	}
+
+	Asset* pOwner = pRequest->spOwner;
+
+	HELIUM_ASSERT( !pOwner || pOwner->IsFullyLoaded() );
+	HELIUM_ASSERT( !pTemplate || pTemplate->IsFullyLoaded() );
+
+	AssetType* pType = pRequest->spType;
+	HELIUM_ASSERT( pType );
+
+	// If we already had an existing object, make sure the type and template match.
+	if( pObject )
+	{
+		const AssetType* pExistingType = pObject->GetAssetType();
+		HELIUM_ASSERT( pExistingType );
+		if( pExistingType != pType )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				( TXT( "CachePackageLoader: Cannot load \"%s\" using the existing object as the types do not " )
+				TXT( "match (existing type: \"%s\"; serialized type: \"%s\".\n" ) ),
+				*pCacheEntry->path.ToString(),
+				*pExistingType->GetName(),
+				*pType->GetName() );
+
+			pObject->SetFlags( Asset::FLAG_PRELOADED | Asset::FLAG_LINKED );
+			pObject->ConditionalFinalizeLoad();
+
+			ReleaseLoadBuffer( pRequest );
+
+			pRequest->flags |= LOAD_FLAG_PRELOADED | LOAD_FLAG_ERROR;
+
+			return true;
+		}
+	}
+	else
+	{
+		// Create the object.
+		if( !Asset::CreateObject( pRequest->spObject, pType, pCacheEntry->path.GetName(), pOwner, pTemplate ) )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				TXT( "CachePackageLoader: Failed to create \"%s\" during loading.\n" ),
+				*pCacheEntry->path.ToString() );
+
+			ReleaseLoadBuffer( pRequest );
+
+			pRequest->flags |= LOAD_FLAG_PRELOADED | LOAD_FLAG_ERROR;
+
+			return true;
+		}
+
+		pObject = pRequest->spObject;
+		HELIUM_ASSERT( pObject );
+	}
+		
+	Reflect::Object* cached_object = pRequest->spCachedObject;
+
+	if (!cached_object)
+	{
+		HELIUM_TRACE(
 			TraceLevels::Error,
 			TXT( "CachePackageLoader: Failed to deserialize object \"%s\".\n" ),
 			*pCacheEntry->path.ToString() );
@@ -643,13 +1584,9 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
 			Resource* pResource = Reflect::SafeCast< Resource >( pObject );
 			if( pResource )
 			{
-				Reflect::ObjectPtr cached_prd = Cache::ReadCacheObjectFromBuffer(
-					pRequest->pPropertyStreamEnd, 
-					0, 
-					(pRequest->pPersistentResourceStreamEnd - pRequest->pPropertyStreamEnd),
-					pRequest->pResolver);
+				Reflect::Object* cached_prd = pRequest->spCachedResourceData;
 
-				if (!cached_prd.ReferencesObject())
+				if (!cached_prd)
 				{
 					HELIUM_TRACE(
 						TraceLevels::Error,
@@ -659,14 +1596,18 @@ bool CachePackageLoader::TickDeserialize( LoadRequest* pRequest )
 				}
 				else
 				{
+					if( pRequest->pResolver )
+					{
+						pRequest->resourceResolver.ResolveDeferred( pRequest->pResolver );
+					}
+
 					pResource->LoadPersistentResourceObject(cached_prd);
 				}
 			}
 		}
 	}
 
-	DefaultAllocator().Free( pRequest->pAsyncLoadBuffer );
-	pRequest->pAsyncLoadBuffer = NULL;
+	ReleaseLoadBuffer( pRequest );
 
 	pObject->SetFlags( Asset::FLAG_PRELOADED );
 
@@ -707,6 +1648,43 @@ void CachePackageLoader::ResolvePackage( AssetPtr& rspPackage, AssetPath package
 	rspPackage->SetFlags( Asset::FLAG_PRELOADED | Asset::FLAG_LINKED | Asset::FLAG_LOADED );
 }
 
+/// Deserialize the property and persistent resource data for an object load.
+///
+/// This runs on an async loader worker thread, so it must not touch anything other than the given request (and the
+/// thread-safe LoadProfiler).
+///
+/// @param[in] pData  Load request data.
+///
+/// @see TickDeserializeData()
+void CachePackageLoader::DeserializeData( void* pData )
+{
+	LoadRequest* pRequest = static_cast< LoadRequest* >( pData );
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( pRequest->pEntry );
+
+	LoadProfiler::PhaseScope profileScope( pRequest->pEntry->path, LoadProfiler::PHASE_DESERIALIZE );
+
+	// Only record references if the request has a resolver to pass them on to.
+	bool bResolve = ( pRequest->pResolver != NULL );
+
+	pRequest->spCachedObject = Cache::ReadCacheObjectFromBuffer(
+		pRequest->pSerializedData,
+		0,
+		pRequest->pPropertyStreamEnd - pRequest->pSerializedData,
+		bResolve ? &pRequest->propertyResolver : NULL );
+
+	// Persistent resource data is deserialized regardless of the object type (which isn't known until the object is
+	// created), but its references are only resolved if the object turns out to use it.
+	if( pRequest->spCachedObject.ReferencesObject() )
+	{
+		pRequest->spCachedResourceData = Cache::ReadCacheObjectFromBuffer(
+			pRequest->pPropertyStreamEnd,
+			0,
+			pRequest->pPersistentResourceStreamEnd - pRequest->pPropertyStreamEnd,
+			bResolve ? &pRequest->resourceResolver : NULL );
+	}
+}
+
 /// Deserialize the link tables for an object load.
 ///
 /// @param[in] pRequest  Load request data.
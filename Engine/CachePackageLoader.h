@@ -3,16 +3,19 @@
 #include "Engine/Asset.h"
 #include "Engine/PackageLoader.h"
 
+#include "Engine/AssetLoader.h"
 #include "Engine/Cache.h"
 
 namespace Helium
 {
 	/// Package loader for loading objects from a binary cache.
-	class CachePackageLoader : public PackageLoader
+	class HELIUM_ENGINE_API CachePackageLoader : public PackageLoader
 	{
 	public:
 		/// Load request pool block size.
 		static const size_t LOAD_REQUEST_POOL_BLOCK_SIZE = 16;
+		/// Size of each read issued when streaming a bundle into memory.
+		static const size_t BUNDLE_READ_SIZE = 8 * 1024 * 1024;
 
 		/// @name Construction/Destruction
 		//@{
@@ -22,7 +25,7 @@ namespace Helium
 
 		/// @name Initialization
 		//@{
-		bool Initialize( Name cacheName );
+		bool Initialize( Name cacheName, bool bMapCacheFile = false );
 		void Shutdown();
 		//@} 
 
@@ -45,6 +48,20 @@ namespace Helium
 		inline Cache* GetCache() const;
 		//@}
 
+		/// @name Bundles
+		//@{
+		bool BeginLoadBundle( Name bundleName );
+		bool TryFinishLoadBundle( Name bundleName );
+		bool UnloadBundle( Name bundleName );
+		bool IsBundled( AssetPath path ) const;
+
+		static Name GetBundleName( AssetPath packagePath );
+
+#if HELIUM_TOOLS
+		bool WriteBundle( AssetPath packagePath, Name bundleName );
+#endif
+		//@}
+
 	private:
 		/// Load request flags.
 		enum ELoadFlag
@@ -52,7 +69,39 @@ namespace Helium
 			/// Set once object preloading has completed.
 			LOAD_FLAG_PRELOADED = 1 << 0,
 			/// Set when an error has occurred in the load process.
-			LOAD_FLAG_ERROR = 1 << 1
+			LOAD_FLAG_ERROR = 1 << 1,
+			/// Set when the load buffer points into the memory mapped cache file or a bundle instead of an allocated
+			/// buffer.
+			LOAD_FLAG_MAPPED = 1 << 2,
+			/// Set once the serialized data has been deserialized.
+			LOAD_FLAG_DESERIALIZED = 1 << 3
+		};
+
+		/// Bundle streamed into memory with a few large sequential reads.
+		struct Bundle
+		{
+			/// Bundle name.
+			Name name;
+			/// Cache holding the bundle contents.
+			Cache* pCache;
+
+			/// Bundle cache file contents.
+			uint8_t* pData;
+			/// Size of the bundle cache file, in bytes.
+			size_t size;
+
+			/// Async load IDs of the bundle reads, in file order.
+			DynamicArray< size_t > readIds;
+			/// Number of leading reads that have been synced.
+			size_t syncedReadCount;
+			/// Number of leading bytes of the bundle that have been read.
+			size_t loadedSize;
+
+			/// True if a bundle read failed, in which case objects are loaded from the main cache instead.
+			bool bFailed;
+			/// True if the bundle was loaded along with its package, in which case it is unloaded once it has been
+			/// read and no loads are pending.
+			bool bAutoUnload;
 		};
 
 		/// Asset load request data.
@@ -60,6 +109,8 @@ namespace Helium
 		{
 			/// Cache entry.
 			const Cache::Entry* pEntry;
+			/// Bundle from which the entry is loaded, or null if it is loaded from the cache directly.
+			Bundle* pBundle;
 			/// Resolver from top-level request
 			Reflect::ObjectResolver *pResolver;
 			/// Temporary object reference (hold while loading is in progress).
@@ -67,7 +118,8 @@ namespace Helium
 
 			/// Async load ID.
 			size_t asyncLoadId;
-			/// Async load buffer.
+			/// Async load buffer (points into the cache file mapping or bundle data if LOAD_FLAG_MAPPED is set, and is
+			/// never written).
 			uint8_t* pAsyncLoadBuffer;
 			/// Binary serialized object property data (immediately past the link table).
 			uint8_t* pSerializedData;
@@ -76,6 +128,17 @@ namespace Helium
 			/// End of the serialized persistent resource data.
 			uint8_t* pPersistentResourceStreamEnd;
 
+			/// Async loader work ID for deserializing the serialized data.
+			size_t deserializeWorkId;
+			/// Deserialized object property data.
+			Reflect::ObjectPtr spCachedObject;
+			/// Deserialized persistent resource data.
+			Reflect::ObjectPtr spCachedResourceData;
+			/// References found while deserializing the property data.
+			DeferredAssetResolver propertyResolver;
+			/// References found while deserializing the persistent resource data.
+			DeferredAssetResolver resourceResolver;
+
 			/// Type link table (table stores type object instances).
 			DynamicArray< AssetTypePtr > typeLinkTable;
 			/// Object link table (table stores load request IDs for objects to link).
@@ -102,22 +165,44 @@ namespace Helium
 		Cache* m_pCache;
 		/// True if we've synced the cache TOC load process.
 		bool m_bFinishedCacheTocLoad;
+		/// True if this loader mapped the cache file and reads entries from the mapping.
+		bool m_bMappedCacheFile;
 
 		/// Pending load requests.
 		SparseArray< LoadRequest* > m_loadRequests;
 		/// Load request pool.
 		ObjectPool< LoadRequest > m_loadRequestPool;
 
+		/// Loaded bundles, searched in order before the main cache.
+		DynamicArray< Bundle* > m_bundles;
+
+		/// @name Bundle Functions
+		//@{
+		size_t FindBundle( Name bundleName ) const;
+		const Cache::Entry* FindBundleEntry( const Cache::Entry& rCacheEntry, Bundle*& rpBundle ) const;
+		void BeginLoadPackageBundle( AssetPath packagePath );
+		void TickBundles();
+		void UnloadIdleBundles();
+		static void DestroyBundle( Bundle* pBundle );
+		//@}
+
 		/// @name Load Ticking Functions
 		//@{
+		void BeginCacheLoad( LoadRequest* pRequest );
 		bool TickCacheLoad( LoadRequest* pRequest );
+		bool TickBundleLoad( LoadRequest* pRequest );
+		bool TickDeserializeData( LoadRequest* pRequest );
 		bool TickDeserialize( LoadRequest* pRequest );
+
+		void FinishCacheLoad( LoadRequest* pRequest, size_t bytesRead );
+		static void ReleaseLoadBuffer( LoadRequest* pRequest );
 		//@}
 
 		/// @name Static Private Utility Functions
 		//@{
 		static void ResolvePackage( AssetPtr& spPackage, AssetPath packagePath );
 		static bool DeserializeLinkTables( LoadRequest* pRequest );
+		static void DeserializeData( void* pData );
 		//@}
 	};
 }
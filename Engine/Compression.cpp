@@ -0,0 +1,114 @@
+#include "EnginePch.h"
+#include "Engine/Compression.h"
+
+#include "zlib.h"
+
+using namespace Helium;
+
+/// Compress a block of data.
+///
+/// Compression is only worthwhile if it actually saves space, so this fails if the compressed data would be no
+/// smaller than the source data.
+///
+/// @param[in]  codec        Codec with which to compress the data.
+/// @param[in]  pSource      Data to compress.
+/// @param[in]  sourceSize   Size of the data to compress, in bytes.
+/// @param[out] rCompressed  Compressed data.
+///
+/// @return  True if the data was compressed into fewer bytes than the source, false if not.
+///
+/// @see DecompressBlock()
+bool Compression::CompressBlock(
+	CompressionCodec codec,
+	const void* pSource,
+	size_t sourceSize,
+	DynamicArray< uint8_t >& rCompressed )
+{
+	HELIUM_ASSERT( pSource || sourceSize == 0 );
+
+	rCompressed.Resize( 0 );
+
+	if( codec != CompressionCodecs::Zlib || sourceSize == 0 || sourceSize > UINT32_MAX )
+	{
+		return false;
+	}
+
+	uLongf compressedSize = compressBound( static_cast< uLong >( sourceSize ) );
+	rCompressed.Resize( compressedSize );
+
+	int result = compress2(
+		rCompressed.GetData(),
+		&compressedSize,
+		static_cast< const Bytef* >( pSource ),
+		static_cast< uLong >( sourceSize ),
+		Z_DEFAULT_COMPRESSION );
+	if( result != Z_OK || compressedSize >= sourceSize )
+	{
+		rCompressed.Resize( 0 );
+
+		return false;
+	}
+
+	rCompressed.Resize( compressedSize );
+
+	return true;
+}
+
+/// Decompress a block of data compressed with CompressBlock().
+///
+/// The destination buffer may be smaller than the original data, in which case only the leading bytes that fit are
+/// decompressed.
+///
+/// @param[in] codec            Codec with which the data was compressed.
+/// @param[in] pSource          Compressed data.
+/// @param[in] sourceSize       Size of the compressed data, in bytes.
+/// @param[in] pDestination     Buffer in which to store the decompressed data.
+/// @param[in] destinationSize  Size of the destination buffer, in bytes.
+///
+/// @return  Number of bytes decompressed, or an invalid index if the data could not be decompressed.
+///
+/// @see CompressBlock()
+size_t Compression::DecompressBlock(
+	CompressionCodec codec,
+	const void* pSource,
+	size_t sourceSize,
+	void* pDestination,
+	size_t destinationSize )
+{
+	HELIUM_ASSERT( pSource || sourceSize == 0 );
+	HELIUM_ASSERT( pDestination || destinationSize == 0 );
+
+	if( codec == CompressionCodecs::None )
+	{
+		size_t copySize = Min( sourceSize, destinationSize );
+		MemoryCopy( pDestination, pSource, copySize );
+
+		return copySize;
+	}
+
+	if( codec != CompressionCodecs::Zlib || sourceSize > UINT32_MAX || destinationSize > UINT32_MAX )
+	{
+		return Invalid< size_t >();
+	}
+
+	z_stream stream;
+	MemoryZero( &stream, sizeof( stream ) );
+	if( inflateInit( &stream ) != Z_OK )
+	{
+		return Invalid< size_t >();
+	}
+
+	stream.next_in = static_cast< Bytef* >( const_cast< void* >( pSource ) );
+	stream.avail_in = static_cast< uInt >( sourceSize );
+	stream.next_out = static_cast< Bytef* >( pDestination );
+	stream.avail_out = static_cast< uInt >( destinationSize );
+
+	// Running out of output space before the end of the stream is fine, since the caller asked for no more.
+	int result = inflate( &stream, Z_FINISH );
+	bool bSucceeded = ( result == Z_STREAM_END || ( stream.avail_out == 0 && ( result == Z_OK || result == Z_BUF_ERROR ) ) );
+
+	size_t decompressedSize = destinationSize - stream.avail_out;
+	inflateEnd( &stream );
+
+	return ( bSucceeded ? decompressedSize : Invalid< size_t >() );
+}
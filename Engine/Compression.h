@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Foundation/DynamicArray.h"
+
+#include "Engine/Engine.h"
+
+namespace Helium
+{
+	/// Block compression codecs.
+	namespace CompressionCodecs
+	{
+		enum CompressionCodec
+		{
+			None,  ///< Data is stored uncompressed.
+			Zlib,  ///< Deflate, via zlib.
+
+			Count
+		};
+	}
+	typedef CompressionCodecs::CompressionCodec CompressionCodec;
+
+	/// Compression of independent blocks of data, such as cache entries.
+	class HELIUM_ENGINE_API Compression
+	{
+	public:
+		/// @name Block Compression
+		//@{
+		static bool CompressBlock(
+			CompressionCodec codec, const void* pSource, size_t sourceSize, DynamicArray< uint8_t >& rCompressed );
+		static size_t DecompressBlock(
+			CompressionCodec codec, const void* pSource, size_t sourceSize, void* pDestination,
+			size_t destinationSize );
+		//@}
+	};
+}
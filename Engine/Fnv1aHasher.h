@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Engine/Engine.h"
+
+namespace Helium
+{
+	/// Incremental 64-bit FNV-1a hasher.
+	///
+	/// FNV-1a is fast and well distributed for short keys and file contents, but is not cryptographically secure, so
+	/// it should only be used to detect changes and key caches, never to guard against deliberate collisions.
+	class Fnv1aHasher
+	{
+	public:
+		/// 64-bit FNV-1a offset basis (the hash of no data).
+		static const uint64_t OFFSET_BASIS = 14695981039346656037ULL;
+		/// 64-bit FNV-1a prime.
+		static const uint64_t PRIME = 1099511628211ULL;
+
+		/// @name Construction/Destruction
+		//@{
+		inline Fnv1aHasher();
+		//@}
+
+		/// @name Hashing
+		//@{
+		inline void Add( const void* pData, size_t size );
+		inline uint64_t GetHash() const;
+		//@}
+
+	private:
+		/// Running hash.
+		uint64_t m_hash;
+	};
+}
+
+#include "Engine/Fnv1aHasher.inl"
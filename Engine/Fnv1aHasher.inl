@@ -0,0 +1,32 @@
+/// Constructor.
+Helium::Fnv1aHasher::Fnv1aHasher()
+	: m_hash( OFFSET_BASIS )
+{
+}
+
+/// Add a block of data to the hash.
+///
+/// @param[in] pData  Data to add.
+/// @param[in] size   Size of the data, in bytes.
+void Helium::Fnv1aHasher::Add( const void* pData, size_t size )
+{
+	HELIUM_ASSERT( pData || size == 0 );
+
+	const uint8_t* pBytes = static_cast< const uint8_t* >( pData );
+	uint64_t hash = m_hash;
+	for( size_t byteIndex = 0; byteIndex < size; ++byteIndex )
+	{
+		hash ^= pBytes[ byteIndex ];
+		hash *= PRIME;
+	}
+
+	m_hash = hash;
+}
+
+/// Get the hash of all the data added so far.
+///
+/// @return  Hash value.
+uint64_t Helium::Fnv1aHasher::GetHash() const
+{
+	return m_hash;
+}
@@ -0,0 +1,241 @@
+#include "EnginePch.h"
+#include "Engine/LoadManifest.h"
+
+#include "Foundation/FileStream.h"
+#include "Foundation/Stream.h"
+#include "Engine/StreamString.h"
+
+using namespace Helium;
+
+/// Manifest file magic number.
+static const uint32_t MANIFEST_MAGIC = 0x10adf11e;
+/// Manifest file format version number.
+static const uint32_t MANIFEST_VERSION = 0;
+
+/// Constructor.
+LoadManifest::LoadManifest()
+{
+}
+
+/// Destructor.
+LoadManifest::~LoadManifest()
+{
+}
+
+/// Record the start of an object load.
+///
+/// Only the first load of each object is recorded.
+///
+/// @param[in] path  Path of the object being loaded.
+///
+/// @see AddSubDataLoad()
+void LoadManifest::AddObjectLoad( AssetPath path )
+{
+	HELIUM_ASSERT( !path.IsEmpty() );
+
+	Record record;
+	record.path = path;
+	record.cacheName = NULL_NAME;
+	SetInvalid( record.subDataIndex );
+	AddRecord( record );
+}
+
+/// Record the start of a resource sub-data read.
+///
+/// Only the first read of each piece of sub-data is recorded.
+///
+/// @param[in] cacheName     Name of the cache from which the sub-data is read.
+/// @param[in] path          Path of the resource.
+/// @param[in] subDataIndex  Resource sub-data index.
+///
+/// @see AddObjectLoad()
+void LoadManifest::AddSubDataLoad( Name cacheName, AssetPath path, uint32_t subDataIndex )
+{
+	HELIUM_ASSERT( !cacheName.IsEmpty() );
+	HELIUM_ASSERT( !path.IsEmpty() );
+	HELIUM_ASSERT( IsValid( subDataIndex ) );
+
+	Record record;
+	record.path = path;
+	record.cacheName = cacheName;
+	record.subDataIndex = subDataIndex;
+	AddRecord( record );
+}
+
+/// Remove all records from this manifest.
+void LoadManifest::Clear()
+{
+	m_records.Clear();
+	m_recordedLoads.Clear();
+}
+
+/// Add a record unless the same load has already been recorded.
+///
+/// @param[in] rRecord  Record to add.
+void LoadManifest::AddRecord( const Record& rRecord )
+{
+	HashMap< Record, bool, RecordHash >::Iterator recordedIterator;
+	if( m_recordedLoads.Insert( recordedIterator, KeyValue< Record, bool >( rRecord, true ) ) )
+	{
+		m_records.Push( rRecord );
+	}
+}
+
+/// Replace the contents of this manifest with a manifest file saved with Save().
+///
+/// @param[in] rFileName  Manifest file name.
+///
+/// @return  True if the manifest was loaded successfully, false if not.
+///
+/// @see Save()
+bool LoadManifest::Load( const String& rFileName )
+{
+	Clear();
+
+	FileStream* pFileStream = FileStream::OpenFileStream( rFileName, FileStream::MODE_READ );
+	if( !pFileStream )
+	{
+		HELIUM_TRACE( TraceLevels::Info, TXT( "LoadManifest: Manifest \"%s\" does not exist.\n" ), *rFileName );
+
+		return false;
+	}
+
+	BufferedStream* pBufferedStream = new BufferedStream( pFileStream );
+	HELIUM_ASSERT( pBufferedStream );
+
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	uint32_t recordCount = 0;
+	bool bReadSuccess = ( pBufferedStream->Read( &magic, sizeof( magic ), 1 ) == 1 &&
+		pBufferedStream->Read( &version, sizeof( version ), 1 ) == 1 &&
+		pBufferedStream->Read( &recordCount, sizeof( recordCount ), 1 ) == 1 &&
+		magic == MANIFEST_MAGIC &&
+		version == MANIFEST_VERSION );
+
+	DynamicArray< char > pathString;
+	DynamicArray< char > cacheNameString;
+	for( uint32_t recordIndex = 0; bReadSuccess && recordIndex < recordCount; ++recordIndex )
+	{
+		uint32_t subDataIndex;
+		bReadSuccess = ( pBufferedStream->Read( &subDataIndex, sizeof( subDataIndex ), 1 ) == 1 &&
+			ReadLengthPrefixedString( *pBufferedStream, pathString ) &&
+			ReadLengthPrefixedString( *pBufferedStream, cacheNameString ) );
+		if( !bReadSuccess )
+		{
+			break;
+		}
+
+		AssetPath path;
+		if( !path.Set( pathString.GetData() ) )
+		{
+			// Content may have been renamed since the manifest was recorded, so just skip the record.
+			continue;
+		}
+
+		if( IsInvalid( subDataIndex ) )
+		{
+			AddObjectLoad( path );
+		}
+		else if( cacheNameString[ 0 ] != TXT( '\0' ) )
+		{
+			AddSubDataLoad( Name( cacheNameString.GetData() ), path, subDataIndex );
+		}
+	}
+
+	delete pBufferedStream;
+	delete pFileStream;
+
+	if( !bReadSuccess )
+	{
+		HELIUM_TRACE( TraceLevels::Warning, TXT( "LoadManifest: Manifest \"%s\" is invalid or out of date.\n" ), *rFileName );
+
+		Clear();
+
+		return false;
+	}
+
+	return true;
+}
+
+/// Save this manifest to a file.
+///
+/// @param[in] rFileName  Manifest file name.
+///
+/// @return  True if the manifest was saved successfully, false if not.
+///
+/// @see Load()
+bool LoadManifest::Save( const String& rFileName ) const
+{
+	FileStream* pFileStream = FileStream::OpenFileStream( rFileName, FileStream::MODE_WRITE, true );
+	if( !pFileStream )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "LoadManifest: Failed to open \"%s\" for writing.\n" ), *rFileName );
+
+		return false;
+	}
+
+	BufferedStream* pBufferedStream = new BufferedStream( pFileStream );
+	HELIUM_ASSERT( pBufferedStream );
+
+	uint32_t recordCount = static_cast< uint32_t >( m_records.GetSize() );
+	bool bWriteSuccess = ( pBufferedStream->Write( &MANIFEST_MAGIC, sizeof( MANIFEST_MAGIC ), 1 ) == 1 &&
+		pBufferedStream->Write( &MANIFEST_VERSION, sizeof( MANIFEST_VERSION ), 1 ) == 1 &&
+		pBufferedStream->Write( &recordCount, sizeof( recordCount ), 1 ) == 1 );
+
+	String pathString;
+	String cacheNameString;
+	for( uint32_t recordIndex = 0; bWriteSuccess && recordIndex < recordCount; ++recordIndex )
+	{
+		const Record& rRecord = m_records[ recordIndex ];
+		rRecord.path.ToString( pathString );
+
+		cacheNameString.Clear();
+		if( !rRecord.cacheName.IsEmpty() )
+		{
+			cacheNameString = *rRecord.cacheName;
+		}
+
+		bWriteSuccess = ( pBufferedStream->Write( &rRecord.subDataIndex, sizeof( rRecord.subDataIndex ), 1 ) == 1 &&
+			WriteLengthPrefixedString( *pBufferedStream, pathString ) &&
+			WriteLengthPrefixedString( *pBufferedStream, cacheNameString ) );
+	}
+
+	delete pBufferedStream;
+	delete pFileStream;
+
+	if( !bWriteSuccess )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "LoadManifest: Failed to write manifest \"%s\".\n" ), *rFileName );
+
+		return false;
+	}
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		TXT( "LoadManifest: Saved %" ) PRIu32 TXT( " records to \"%s\".\n" ),
+		recordCount,
+		*rFileName );
+
+	return true;
+}
+
+/// Equality comparison operator.
+///
+/// @param[in] rOther  Record with which to compare.
+///
+/// @return  True if the records refer to the same load, false if not.
+bool LoadManifest::Record::operator==( const Record& rOther ) const
+{
+	return ( path == rOther.path && cacheName == rOther.cacheName && subDataIndex == rOther.subDataIndex );
+}
+
+/// Compute a hash value for a manifest record.
+///
+/// @param[in] rRecord  Manifest record.
+///
+/// @return  Hash value for the given record.
+size_t LoadManifest::RecordHash::operator()( const Record& rRecord ) const
+{
+	// Records of the same resource only differ in the sub-data index, so the cache name doesn't need to be hashed.
+	return ( ( static_cast< size_t >( rRecord.subDataIndex ) * 33 ) ^ rRecord.path.ComputeHash() );
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Engine/Engine.h"
+
+#include "Foundation/DynamicArray.h"
+#include "Foundation/HashMap.h"
+#include "Engine/AssetPath.h"
+
+namespace Helium
+{
+	/// Recorded sequence of the object loads and resource sub-data reads performed while loading, in the order in
+	/// which they were first started.
+	///
+	/// Manifests are recorded and replayed by the AssetLoader so that data for a load can be prefetched up front
+	/// instead of being discovered one level of dependencies at a time.
+	class HELIUM_ENGINE_API LoadManifest : NonCopyable
+	{
+	public:
+		/// Manifest record.
+		struct Record
+		{
+			/// Asset path.
+			AssetPath path;
+			/// Name of the cache holding the resource sub-data, or the null name for object loads.
+			Name cacheName;
+			/// Resource sub-data index (invalid for object loads).
+			uint32_t subDataIndex;
+
+			/// @name Overloaded Operators
+			//@{
+			bool operator==( const Record& rOther ) const;
+			//@}
+		};
+
+		/// Manifest record hasher.
+		class RecordHash
+		{
+		public:
+			/// @name Hash Calculation
+			//@{
+			size_t operator()( const Record& rRecord ) const;
+			//@}
+		};
+
+		/// @name Construction/Destruction
+		//@{
+		LoadManifest();
+		~LoadManifest();
+		//@}
+
+		/// @name Recording
+		//@{
+		void AddObjectLoad( AssetPath path );
+		void AddSubDataLoad( Name cacheName, AssetPath path, uint32_t subDataIndex );
+		void Clear();
+		//@}
+
+		/// @name Data Access
+		//@{
+		inline size_t GetRecordCount() const;
+		inline const Record& GetRecord( size_t index ) const;
+		//@}
+
+		/// @name Serialization
+		//@{
+		bool Load( const String& rFileName );
+		bool Save( const String& rFileName ) const;
+		//@}
+
+	private:
+		/// Records, in the order in which they were added.
+		DynamicArray< Record > m_records;
+		/// Loads that have been recorded (each object load and sub-data read is only recorded once).
+		HashMap< Record, bool, RecordHash > m_recordedLoads;
+
+		/// @name Recording Implementation
+		//@{
+		void AddRecord( const Record& rRecord );
+		//@}
+	};
+}
+
+#include "Engine/LoadManifest.inl"
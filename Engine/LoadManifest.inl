@@ -0,0 +1,23 @@
+/// Get the number of records in this manifest.
+///
+/// @return  Record count.
+///
+/// @see GetRecord()
+size_t Helium::LoadManifest::GetRecordCount() const
+{
+	return m_records.GetSize();
+}
+
+/// Get a record from this manifest.
+///
+/// @param[in] index  Record index.
+///
+/// @return  Manifest record.
+///
+/// @see GetRecordCount()
+const Helium::LoadManifest::Record& Helium::LoadManifest::GetRecord( size_t index ) const
+{
+	HELIUM_ASSERT( index < m_records.GetSize() );
+
+	return m_records[ index ];
+}
@@ -0,0 +1,853 @@
+#include "EnginePch.h"
+#include "Engine/LoadProfiler.h"
+
+#include "Foundation/FileStream.h"
+#include "Platform/Timer.h"
+#include "Engine/Asset.h"
+#include "Engine/AsyncLoader.h"
+
+using namespace Helium;
+
+LoadProfiler* LoadProfiler::sm_pInstance = NULL;
+
+/// Convert a timer tick count to milliseconds.
+///
+/// @param[in] ticks  Tick count.
+///
+/// @return  Milliseconds.
+static float64_t TicksToMilliseconds( uint64_t ticks )
+{
+	return static_cast< float64_t >( ticks ) * Timer::GetSecondsPerTick() * 1000.0;
+}
+
+/// Get the time a recorded load took from beginning to end.
+///
+/// @param[in] rRecord  Load record.
+///
+/// @return  Load time, in ticks, or zero if the load is still in progress.
+static uint64_t GetLoadTicks( const LoadProfiler::Record& rRecord )
+{
+	return ( rRecord.endTickCount != 0 ? rRecord.endTickCount - rRecord.beginTickCount : 0 );
+}
+
+/// Constructor.
+///
+/// @param[in] path   Asset path.
+/// @param[in] phase  Load phase to which to add the time spent within this scope.
+LoadProfiler::PhaseScope::PhaseScope( AssetPath path, EPhase phase )
+	: m_pProfiler( LoadProfiler::GetStaticInstance() )
+	, m_path( path )
+	, m_phase( phase )
+	, m_startTickCount( 0 )
+{
+	HELIUM_ASSERT( static_cast< size_t >( phase ) < static_cast< size_t >( PHASE_MAX ) );
+
+	if( m_pProfiler )
+	{
+		m_startTickCount = Timer::GetTickCount();
+	}
+}
+
+/// Destructor.
+LoadProfiler::PhaseScope::~PhaseScope()
+{
+	if( m_pProfiler )
+	{
+		m_pProfiler->AddPhaseTicks( m_path, m_phase, Timer::GetTickCount() - m_startTickCount );
+	}
+}
+
+/// Constructor.
+LoadProfiler::LoadProfiler()
+	: m_recordPool( RECORD_POOL_BLOCK_SIZE )
+{
+}
+
+/// Destructor.
+LoadProfiler::~LoadProfiler()
+{
+	Clear();
+}
+
+/// Record the start of an asset load.
+///
+/// If the asset was loaded before, the statistics of the previous load are discarded.
+///
+/// @param[in] path  Asset path.
+///
+/// @see EndLoad()
+void LoadProfiler::BeginLoad( AssetPath path )
+{
+	BeginLoad( path, Timer::GetTickCount() );
+}
+
+/// Record the start of an asset load at a given time.
+///
+/// If the asset was loaded before, the statistics of the previous load are discarded.
+///
+/// @param[in] path       Asset path.
+/// @param[in] tickCount  Timer tick count when the load began.
+///
+/// @see EndLoad()
+void LoadProfiler::BeginLoad( AssetPath path, uint64_t tickCount )
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	Record* pRecord = FindOrAddRecord( path );
+	HELIUM_ASSERT( pRecord );
+
+	uint32_t loadCount = pRecord->loadCount;
+	if( loadCount != 0 )
+	{
+		MemoryZero( pRecord->phaseTicks, sizeof( pRecord->phaseTicks ) );
+		pRecord->typeName = Name( NULL_NAME );
+		pRecord->endTickCount = 0;
+		pRecord->objectBytes = 0;
+		pRecord->subDataBytes = 0;
+		pRecord->subDataLoadCount = 0;
+		pRecord->subDataWaitTicks = 0;
+		pRecord->dependencies.Resize( 0 );
+	}
+
+	pRecord->loadCount = loadCount + 1;
+	pRecord->beginTickCount = tickCount;
+}
+
+/// Record the completion of an asset load.
+///
+/// @param[in] path    Asset path.
+/// @param[in] pAsset  Loaded asset, or null if the load failed.
+///
+/// @see BeginLoad()
+void LoadProfiler::EndLoad( AssetPath path, const Asset* pAsset )
+{
+	const AssetType* pType = ( pAsset ? pAsset->GetAssetType() : NULL );
+
+	EndLoad( path, ( pType ? pType->GetName() : Name( NULL_NAME ) ), Timer::GetTickCount() );
+}
+
+/// Record the completion of an asset load at a given time.
+///
+/// @param[in] path       Asset path.
+/// @param[in] typeName   Name of the loaded asset's type, or the null name if the load failed.
+/// @param[in] tickCount  Timer tick count when the load completed.
+///
+/// @see BeginLoad()
+void LoadProfiler::EndLoad( AssetPath path, Name typeName, uint64_t tickCount )
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	Record* pRecord = FindOrAddRecord( path );
+	HELIUM_ASSERT( pRecord );
+
+	pRecord->endTickCount = tickCount;
+	pRecord->typeName = typeName;
+}
+
+/// Add time spent in a load phase of an asset.
+///
+/// @param[in] path   Asset path.
+/// @param[in] phase  Load phase.
+/// @param[in] ticks  Time spent, in ticks.
+void LoadProfiler::AddPhaseTicks( AssetPath path, EPhase phase, uint64_t ticks )
+{
+	HELIUM_ASSERT( static_cast< size_t >( phase ) < static_cast< size_t >( PHASE_MAX ) );
+
+	MutexScopeLock scopeLock( m_lock );
+
+	Record* pRecord = FindOrAddRecord( path );
+	HELIUM_ASSERT( pRecord );
+	pRecord->phaseTicks[ phase ] += ticks;
+}
+
+/// Record that the load of an asset had to wait on the load of another asset.
+///
+/// @param[in] path            Path of the waiting asset.
+/// @param[in] dependencyPath  Path of the asset being waited on.
+void LoadProfiler::AddDependency( AssetPath path, AssetPath dependencyPath )
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	Record* pRecord = FindOrAddRecord( path );
+	HELIUM_ASSERT( pRecord );
+
+	DynamicArray< AssetPath >& rDependencies = pRecord->dependencies;
+	size_t dependencyCount = rDependencies.GetSize();
+	for( size_t dependencyIndex = 0; dependencyIndex < dependencyCount; ++dependencyIndex )
+	{
+		if( rDependencies[ dependencyIndex ] == dependencyPath )
+		{
+			return;
+		}
+	}
+
+	rDependencies.Push( dependencyPath );
+}
+
+/// Add serialized object data read for an asset.
+///
+/// @param[in] path   Asset path.
+/// @param[in] bytes  Number of bytes read.
+void LoadProfiler::AddObjectBytes( AssetPath path, size_t bytes )
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	Record* pRecord = FindOrAddRecord( path );
+	HELIUM_ASSERT( pRecord );
+	pRecord->objectBytes += bytes;
+}
+
+/// Record the start of a resource sub-data load.
+///
+/// @param[in] path    Resource path.
+/// @param[in] loadId  AsyncLoader request ID of the load.
+/// @param[in] bytes   Number of bytes being loaded.
+///
+/// @see EndSubDataLoad()
+void LoadProfiler::BeginSubDataLoad( AssetPath path, size_t loadId, size_t bytes )
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	Record* pRecord = FindOrAddRecord( path );
+	HELIUM_ASSERT( pRecord );
+	pRecord->subDataBytes += bytes;
+	++pRecord->subDataLoadCount;
+
+	// Loads synced without going through Resource::TryFinishLoadSubData() are never ended, so replace any stale entry
+	// left behind with the same request ID.
+	SubDataLoad load;
+	load.path = path;
+	load.beginTickCount = Timer::GetTickCount();
+
+	HashMap< size_t, SubDataLoad >::Iterator loadIterator;
+	if( !m_subDataLoads.Insert( loadIterator, KeyValue< size_t, SubDataLoad >( loadId, load ) ) )
+	{
+		loadIterator->Second() = load;
+	}
+}
+
+/// Record the completion of a resource sub-data load.
+///
+/// @param[in] loadId  AsyncLoader request ID of the load.
+///
+/// @see BeginSubDataLoad()
+void LoadProfiler::EndSubDataLoad( size_t loadId )
+{
+	uint64_t endTickCount = Timer::GetTickCount();
+
+	MutexScopeLock scopeLock( m_lock );
+
+	HashMap< size_t, SubDataLoad >::ConstIterator loadIterator = m_subDataLoads.Find( loadId );
+	if( loadIterator == m_subDataLoads.End() )
+	{
+		return;
+	}
+
+	const SubDataLoad& rLoad = loadIterator->Second();
+	Record* pRecord = FindOrAddRecord( rLoad.path );
+	HELIUM_ASSERT( pRecord );
+	pRecord->subDataWaitTicks += endTickCount - rLoad.beginTickCount;
+
+	m_subDataLoads.Remove( loadId );
+}
+
+/// Discard all records and reset the AsyncLoader I/O and Asset registry statistics.
+void LoadProfiler::Clear()
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	HashMap< AssetPath, Record* >::Iterator recordEnd = m_recordMap.End();
+	for( HashMap< AssetPath, Record* >::Iterator recordIterator = m_recordMap.Begin();
+		recordIterator != recordEnd;
+		++recordIterator )
+	{
+		Record* pRecord = recordIterator->Second();
+		HELIUM_ASSERT( pRecord );
+		m_recordPool.Release( pRecord );
+	}
+
+	m_recordMap.Clear();
+	m_subDataLoads.Clear();
+
+	AsyncLoader::GetStaticInstance().ResetIoStats();
+	Asset::ResetRegistryStats();
+}
+
+/// Get the number of recorded loads.
+///
+/// @return  Record count.
+size_t LoadProfiler::GetRecordCount() const
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	return m_recordMap.GetSize();
+}
+
+/// Get a copy of the record for an asset.
+///
+/// @param[in]  path     Asset path.
+/// @param[out] rRecord  Set to the record if one exists.
+///
+/// @return  True if a record exists for the asset, false if not.
+bool LoadProfiler::GetRecord( AssetPath path, Record& rRecord ) const
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	HashMap< AssetPath, Record* >::ConstIterator recordIterator = m_recordMap.Find( path );
+	if( recordIterator == m_recordMap.End() )
+	{
+		return false;
+	}
+
+	rRecord = *recordIterator->Second();
+
+	return true;
+}
+
+/// Get copies of the records of the slowest completed loads.
+///
+/// @param[out] rRecords  Records, slowest first.
+/// @param[in]  count     Maximum number of records to get.
+void LoadProfiler::GetSlowestRecords( DynamicArray< Record >& rRecords, size_t count ) const
+{
+	rRecords.Resize( 0 );
+
+	MutexScopeLock scopeLock( m_lock );
+
+	DynamicArray< const Record* > slowestRecords;
+	GetSlowestRecordsUnlocked( slowestRecords, count );
+
+	size_t recordCount = slowestRecords.GetSize();
+	rRecords.Reserve( recordCount );
+	for( size_t recordIndex = 0; recordIndex < recordCount; ++recordIndex )
+	{
+		rRecords.Push( *slowestRecords[ recordIndex ] );
+	}
+}
+
+/// Get copies of the records along the critical dependency chain of a load.
+///
+/// Starting with the given asset, each step of the chain is the dependency that finished loading last, which is
+/// the one that held up the load the longest.
+///
+/// @param[in]  path    Asset path.
+/// @param[out] rChain  Records along the chain, starting with the given asset (empty if it has no record).
+void LoadProfiler::GetCriticalChain( AssetPath path, DynamicArray< Record >& rChain ) const
+{
+	rChain.Resize( 0 );
+
+	MutexScopeLock scopeLock( m_lock );
+
+	DynamicArray< const Record* > chain;
+	GetCriticalChainUnlocked( path, chain );
+
+	size_t chainLength = chain.GetSize();
+	rChain.Reserve( chainLength );
+	for( size_t chainIndex = 0; chainIndex < chainLength; ++chainIndex )
+	{
+		rChain.Push( *chain[ chainIndex ] );
+	}
+}
+
+/// Get the totals of the completed loads by asset type.
+///
+/// @param[out] rTotals  Totals, one entry for each type in no particular order.
+void LoadProfiler::GetTypeTotals( DynamicArray< TypeTotals >& rTotals ) const
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	GetTypeTotalsUnlocked( rTotals );
+}
+
+/// Write a text report of the recorded loads.
+///
+/// The report lists totals by asset type, the slowest loads along with their critical dependency chains, the
+/// AsyncLoader I/O statistics, and the Asset registry lock statistics.
+///
+/// @param[out] rReport       Report text.
+/// @param[in]  slowestCount  Number of slowest loads to list.
+void LoadProfiler::WriteReport( String& rReport, size_t slowestCount ) const
+{
+	rReport.Clear();
+
+	AsyncLoader::IoStats ioStats;
+	AsyncLoader::GetStaticInstance().GetIoStats( ioStats );
+
+	Asset::RegistryStats registryStats;
+	Asset::GetRegistryStats( registryStats );
+
+	MutexScopeLock scopeLock( m_lock );
+
+	DynamicArray< TypeTotals > typeTotals;
+	size_t pendingCount = GetTypeTotalsUnlocked( typeTotals );
+
+	String line;
+	line.Format(
+		TXT( "Asset load profile: %" ) PRIuSZ TXT( " completed loads, %" ) PRIuSZ TXT( " in progress.\n\n" ),
+		m_recordMap.GetSize() - pendingCount,
+		pendingCount );
+	rReport += *line;
+
+	// Types with the most total load time first.
+	rReport += TXT( "Totals by type (times in ms, sizes in KB):\n" );
+	line.Format(
+		TXT( "  %-32s %8s %10s %10s %10s %10s %10s %10s %10s %10s\n" ),
+		TXT( "Type" ),
+		TXT( "Loads" ),
+		TXT( "Load" ),
+		GetPhaseName( PHASE_PRELOAD ),
+		GetPhaseName( PHASE_LINK ),
+		GetPhaseName( PHASE_PRECACHE ),
+		GetPhaseName( PHASE_FINALIZE ),
+		GetPhaseName( PHASE_DESERIALIZE ),
+		TXT( "Object" ),
+		TXT( "Sub-data" ) );
+	rReport += *line;
+
+	while( !typeTotals.IsEmpty() )
+	{
+		size_t typeCount = typeTotals.GetSize();
+		size_t slowestTypeIndex = 0;
+		for( size_t typeIndex = 1; typeIndex < typeCount; ++typeIndex )
+		{
+			if( typeTotals[ typeIndex ].loadTicks > typeTotals[ slowestTypeIndex ].loadTicks )
+			{
+				slowestTypeIndex = typeIndex;
+			}
+		}
+
+		const TypeTotals& rTotals = typeTotals[ slowestTypeIndex ];
+		line.Format(
+			TXT( "  %-32s %8" ) PRIuSZ TXT( " %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f %10.1f %10.1f\n" ),
+			rTotals.typeName.IsEmpty() ? TXT( "(failed)" ) : *rTotals.typeName,
+			rTotals.loadCount,
+			TicksToMilliseconds( rTotals.loadTicks ),
+			TicksToMilliseconds( rTotals.phaseTicks[ PHASE_PRELOAD ] ),
+			TicksToMilliseconds( rTotals.phaseTicks[ PHASE_LINK ] ),
+			TicksToMilliseconds( rTotals.phaseTicks[ PHASE_PRECACHE ] ),
+			TicksToMilliseconds( rTotals.phaseTicks[ PHASE_FINALIZE ] ),
+			TicksToMilliseconds( rTotals.phaseTicks[ PHASE_DESERIALIZE ] ),
+			static_cast< float64_t >( rTotals.objectBytes ) / 1024.0,
+			static_cast< float64_t >( rTotals.subDataBytes ) / 1024.0 );
+		rReport += *line;
+
+		typeTotals.RemoveSwap( slowestTypeIndex );
+	}
+
+	// Slowest loads and what held them up.
+	DynamicArray< const Record* > slowestRecords;
+	GetSlowestRecordsUnlocked( slowestRecords, slowestCount );
+
+	line.Format( TXT( "\nSlowest %" ) PRIuSZ TXT( " loads (times in ms):\n" ), slowestRecords.GetSize() );
+	rReport += *line;
+
+	String pathString;
+	DynamicArray< const Record* > chain;
+	size_t slowestRecordCount = slowestRecords.GetSize();
+	for( size_t recordIndex = 0; recordIndex < slowestRecordCount; ++recordIndex )
+	{
+		const Record* pRecord = slowestRecords[ recordIndex ];
+		HELIUM_ASSERT( pRecord );
+
+		pRecord->path.ToString( pathString );
+		line.Format(
+			TXT( "  %10.2f  %s (%s)\n" )
+			TXT( "              phases: %.2f / %.2f / %.2f / %.2f / %.2f, object: %" ) PRIu64
+			TXT( " bytes, sub-data: %" ) PRIu64 TXT( " bytes in %" ) PRIu32 TXT( " loads (%.2f waiting)\n" ),
+			TicksToMilliseconds( GetLoadTicks( *pRecord ) ),
+			*pathString,
+			pRecord->typeName.IsEmpty() ? TXT( "failed" ) : *pRecord->typeName,
+			TicksToMilliseconds( pRecord->phaseTicks[ PHASE_PRELOAD ] ),
+			TicksToMilliseconds( pRecord->phaseTicks[ PHASE_LINK ] ),
+			TicksToMilliseconds( pRecord->phaseTicks[ PHASE_PRECACHE ] ),
+			TicksToMilliseconds( pRecord->phaseTicks[ PHASE_FINALIZE ] ),
+			TicksToMilliseconds( pRecord->phaseTicks[ PHASE_DESERIALIZE ] ),
+			pRecord->objectBytes,
+			pRecord->subDataBytes,
+			pRecord->subDataLoadCount,
+			TicksToMilliseconds( pRecord->subDataWaitTicks ) );
+		rReport += *line;
+
+		GetCriticalChainUnlocked( pRecord->path, chain );
+		size_t chainLength = chain.GetSize();
+		for( size_t chainIndex = 1; chainIndex < chainLength; ++chainIndex )
+		{
+			const Record* pChainRecord = chain[ chainIndex ];
+			HELIUM_ASSERT( pChainRecord );
+
+			pChainRecord->path.ToString( pathString );
+			line.Format(
+				TXT( "              %*swaited on %s (%.2f)\n" ),
+				static_cast< int >( ( chainIndex - 1 ) * 2 ),
+				TXT( "" ),
+				*pathString,
+				TicksToMilliseconds( GetLoadTicks( *pChainRecord ) ) );
+			rReport += *line;
+		}
+	}
+
+	// I/O totals.
+	float64_t readMilliseconds = TicksToMilliseconds( ioStats.readTicks );
+	line.Format(
+		TXT( "\nAsyncLoader I/O:\n" )
+		TXT( "  reads: %" ) PRIu64 TXT( " requests in %" ) PRIu64 TXT( " batches, %" ) PRIu64
+		TXT( " bytes, %.2f ms reading (%.2f MB/s), %.2f ms decompressing\n" )
+		TXT( "  work: %" ) PRIu64 TXT( " requests, %.2f ms\n" )
+		TXT( "  queue wait: %.2f ms total, %.2f ms longest\n" ),
+		ioStats.readCount,
+		ioStats.readBatchCount,
+		ioStats.bytesRead,
+		readMilliseconds,
+		( readMilliseconds > 0.0
+			? static_cast< float64_t >( ioStats.bytesRead ) / ( 1024.0 * 1024.0 ) / ( readMilliseconds / 1000.0 )
+			: 0.0 ),
+		TicksToMilliseconds( ioStats.decompressTicks ),
+		ioStats.workCount,
+		TicksToMilliseconds( ioStats.workTicks ),
+		TicksToMilliseconds( ioStats.queueWaitTicks ),
+		TicksToMilliseconds( ioStats.queueWaitTicksMax ) );
+	rReport += *line;
+
+	// Asset registry lock contention.
+	line.Format(
+		TXT( "\nAsset registry (%" ) PRIuSZ TXT( " shards):\n" )
+		TXT( "  objects: %" ) PRIuSZ TXT( " registered, %" ) PRIuSZ TXT( " named (%" ) PRIuSZ
+		TXT( " in the largest shard)\n" )
+		TXT( "  read locks: %" ) PRIu64 TXT( ", %" ) PRIu64 TXT( " contended\n" )
+		TXT( "  write locks: %" ) PRIu64 TXT( ", %" ) PRIu64 TXT( " contended\n" ),
+		registryStats.shardCount,
+		registryStats.objectCount,
+		registryStats.pathCount,
+		registryStats.pathCountMax,
+		registryStats.readLockCount,
+		registryStats.contendedReadLockCount,
+		registryStats.writeLockCount,
+		registryStats.contendedWriteLockCount );
+	rReport += *line;
+}
+
+/// Write a text report of the recorded loads to a file.
+///
+/// @param[in] rFileName     Report file name.
+/// @param[in] slowestCount  Number of slowest loads to list.
+///
+/// @return  True if the report was written successfully, false if not.
+///
+/// @see WriteReport()
+bool LoadProfiler::SaveReport( const String& rFileName, size_t slowestCount ) const
+{
+	String report;
+	WriteReport( report, slowestCount );
+
+	FileStream* pFileStream = FileStream::OpenFileStream( rFileName, FileStream::MODE_WRITE, true );
+	if( !pFileStream )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "LoadProfiler: Failed to open \"%s\" for writing.\n" ), *rFileName );
+
+		return false;
+	}
+
+	size_t reportSize = report.GetSize();
+	bool bWriteSuccess = ( pFileStream->Write( *report, 1, reportSize ) == reportSize );
+
+	delete pFileStream;
+
+	if( !bWriteSuccess )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "LoadProfiler: Failed to write \"%s\".\n" ), *rFileName );
+
+		return false;
+	}
+
+	HELIUM_TRACE( TraceLevels::Info, TXT( "LoadProfiler: Saved load report to \"%s\".\n" ), *rFileName );
+
+	return true;
+}
+
+/// Write a text report of the recorded loads to the trace output.
+///
+/// @param[in] slowestCount  Number of slowest loads to list.
+///
+/// @see WriteReport()
+void LoadProfiler::TraceReport( size_t slowestCount ) const
+{
+	String report;
+	WriteReport( report, slowestCount );
+
+	HELIUM_TRACE( TraceLevels::Info, TXT( "%s" ), *report );
+}
+
+/// Get the name of a load phase.
+///
+/// @param[in] phase  Load phase.
+///
+/// @return  Phase name.
+const char* LoadProfiler::GetPhaseName( EPhase phase )
+{
+	static const char* const phaseNames[] =
+	{
+		TXT( "Preload" ),
+		TXT( "Link" ),
+		TXT( "Precache" ),
+		TXT( "Finalize" ),
+		TXT( "Deserialize" )
+	};
+
+	HELIUM_COMPILE_ASSERT( HELIUM_ARRAY_COUNT( phaseNames ) == PHASE_MAX );
+	HELIUM_ASSERT( static_cast< size_t >( phase ) < static_cast< size_t >( PHASE_MAX ) );
+
+	return phaseNames[ phase ];
+}
+
+/// Initialize the singleton LoadProfiler instance.
+///
+/// Loads are only profiled while the instance exists.  The AsyncLoader I/O and Asset registry statistics are reset so
+/// that reports cover the same period as the load records.
+///
+/// @return  True if the profiler was created, false if not.
+///
+/// @see GetStaticInstance(), DestroyStaticInstance()
+bool LoadProfiler::InitializeStaticInstance()
+{
+	HELIUM_ASSERT( !sm_pInstance );
+	sm_pInstance = new LoadProfiler;
+	HELIUM_ASSERT( sm_pInstance );
+
+	AsyncLoader::GetStaticInstance().ResetIoStats();
+	Asset::ResetRegistryStats();
+
+	return ( sm_pInstance != NULL );
+}
+
+/// Get the singleton LoadProfiler instance.
+///
+/// @return  Load profiler instance, or null if load profiling is not enabled.
+///
+/// @see InitializeStaticInstance(), DestroyStaticInstance()
+LoadProfiler* LoadProfiler::GetStaticInstance()
+{
+	return sm_pInstance;
+}
+
+/// Destroy the singleton LoadProfiler instance.
+///
+/// @see InitializeStaticInstance(), GetStaticInstance()
+void LoadProfiler::DestroyStaticInstance()
+{
+	delete sm_pInstance;
+	sm_pInstance = NULL;
+}
+
+/// Get the record for an asset, adding a new record if none exists.
+///
+/// The profiler lock must be held when calling this.
+///
+/// @param[in] path  Asset path.
+///
+/// @return  Record.
+LoadProfiler::Record* LoadProfiler::FindOrAddRecord( AssetPath path )
+{
+	HashMap< AssetPath, Record* >::Iterator recordIterator = m_recordMap.Find( path );
+	if( recordIterator != m_recordMap.End() )
+	{
+		return recordIterator->Second();
+	}
+
+	Record* pRecord = m_recordPool.Allocate();
+	HELIUM_ASSERT( pRecord );
+	pRecord->path = path;
+	pRecord->typeName = Name( NULL_NAME );
+	pRecord->loadCount = 0;
+	pRecord->beginTickCount = Timer::GetTickCount();
+	pRecord->endTickCount = 0;
+	MemoryZero( pRecord->phaseTicks, sizeof( pRecord->phaseTicks ) );
+	pRecord->objectBytes = 0;
+	pRecord->subDataBytes = 0;
+	pRecord->subDataLoadCount = 0;
+	pRecord->subDataWaitTicks = 0;
+	pRecord->dependencies.Resize( 0 );
+
+	HELIUM_VERIFY( m_recordMap.Insert( recordIterator, KeyValue< AssetPath, Record* >( path, pRecord ) ) );
+
+	return pRecord;
+}
+
+/// Get the records of the slowest completed loads.
+///
+/// The profiler lock must be held when calling this.
+///
+/// @param[out] rRecords  Records, slowest first.
+/// @param[in]  count     Maximum number of records to get.
+void LoadProfiler::GetSlowestRecordsUnlocked( DynamicArray< const Record* >& rRecords, size_t count ) const
+{
+	rRecords.Resize( 0 );
+	if( count == 0 )
+	{
+		return;
+	}
+
+	rRecords.Reserve( count );
+
+	HashMap< AssetPath, Record* >::ConstIterator recordEnd = m_recordMap.End();
+	for( HashMap< AssetPath, Record* >::ConstIterator recordIterator = m_recordMap.Begin();
+		recordIterator != recordEnd;
+		++recordIterator )
+	{
+		const Record* pRecord = recordIterator->Second();
+		HELIUM_ASSERT( pRecord );
+		if( pRecord->endTickCount == 0 )
+		{
+			continue;
+		}
+
+		// Insert into the sorted list, dropping the fastest entry if it is full.
+		uint64_t loadTicks = GetLoadTicks( *pRecord );
+		size_t insertIndex = rRecords.GetSize();
+		while( insertIndex != 0 && GetLoadTicks( *rRecords[ insertIndex - 1 ] ) < loadTicks )
+		{
+			--insertIndex;
+		}
+
+		if( insertIndex >= count )
+		{
+			continue;
+		}
+
+		if( rRecords.GetSize() >= count )
+		{
+			rRecords.Pop();
+		}
+
+		rRecords.Insert( insertIndex, pRecord );
+	}
+}
+
+/// Get the records along the critical dependency chain of a load.
+///
+/// The profiler lock must be held when calling this.
+///
+/// @param[in]  path    Asset path.
+/// @param[out] rChain  Records along the chain, starting with the given asset (empty if it has no record).
+///
+/// @see GetCriticalChain()
+void LoadProfiler::GetCriticalChainUnlocked( AssetPath path, DynamicArray< const Record* >& rChain ) const
+{
+	rChain.Resize( 0 );
+
+	HashMap< AssetPath, Record* >::ConstIterator recordEnd = m_recordMap.End();
+	HashMap< AssetPath, Record* >::ConstIterator recordIterator = m_recordMap.Find( path );
+	if( recordIterator == recordEnd )
+	{
+		return;
+	}
+
+	const Record* pRecord = recordIterator->Second();
+	while( pRecord )
+	{
+		rChain.Push( pRecord );
+
+		// Follow the dependency that finished last (or is still loading), skipping anything already in the chain in
+		// case of circular references.
+		const Record* pCriticalRecord = NULL;
+		const DynamicArray< AssetPath >& rDependencies = pRecord->dependencies;
+		size_t dependencyCount = rDependencies.GetSize();
+		for( size_t dependencyIndex = 0; dependencyIndex < dependencyCount; ++dependencyIndex )
+		{
+			recordIterator = m_recordMap.Find( rDependencies[ dependencyIndex ] );
+			if( recordIterator == recordEnd )
+			{
+				continue;
+			}
+
+			const Record* pDependencyRecord = recordIterator->Second();
+			HELIUM_ASSERT( pDependencyRecord );
+
+			size_t chainLength = rChain.GetSize();
+			size_t chainIndex;
+			for( chainIndex = 0; chainIndex < chainLength && rChain[ chainIndex ] != pDependencyRecord; ++chainIndex )
+			{
+			}
+
+			if( chainIndex < chainLength )
+			{
+				continue;
+			}
+
+			if( !pCriticalRecord ||
+				( pCriticalRecord->endTickCount != 0 &&
+				( pDependencyRecord->endTickCount == 0 ||
+				pDependencyRecord->endTickCount > pCriticalRecord->endTickCount ) ) )
+			{
+				pCriticalRecord = pDependencyRecord;
+			}
+		}
+
+		pRecord = pCriticalRecord;
+	}
+}
+
+/// Gather the totals of the completed loads by asset type.
+///
+/// The profiler lock must be held when calling this.
+///
+/// @param[out] rTotals  Totals, one entry for each type in no particular order.
+///
+/// @return  Number of loads still in progress.
+///
+/// @see GetTypeTotals()
+size_t LoadProfiler::GetTypeTotalsUnlocked( DynamicArray< TypeTotals >& rTotals ) const
+{
+	rTotals.Resize( 0 );
+	size_t pendingCount = 0;
+
+	HashMap< AssetPath, Record* >::ConstIterator recordEnd = m_recordMap.End();
+	for( HashMap< AssetPath, Record* >::ConstIterator recordIterator = m_recordMap.Begin();
+		recordIterator != recordEnd;
+		++recordIterator )
+	{
+		const Record* pRecord = recordIterator->Second();
+		HELIUM_ASSERT( pRecord );
+		if( pRecord->endTickCount == 0 )
+		{
+			++pendingCount;
+
+			continue;
+		}
+
+		TypeTotals* pTotals = NULL;
+		size_t typeCount = rTotals.GetSize();
+		for( size_t typeIndex = 0; typeIndex < typeCount; ++typeIndex )
+		{
+			if( rTotals[ typeIndex ].typeName == pRecord->typeName )
+			{
+				pTotals = &rTotals[ typeIndex ];
+
+				break;
+			}
+		}
+
+		if( !pTotals )
+		{
+			pTotals = rTotals.New();
+			HELIUM_ASSERT( pTotals );
+			pTotals->typeName = pRecord->typeName;
+			pTotals->loadCount = 0;
+			pTotals->loadTicks = 0;
+			MemoryZero( pTotals->phaseTicks, sizeof( pTotals->phaseTicks ) );
+			pTotals->objectBytes = 0;
+			pTotals->subDataBytes = 0;
+		}
+
+		++pTotals->loadCount;
+		pTotals->loadTicks += GetLoadTicks( *pRecord );
+		for( size_t phaseIndex = 0; phaseIndex < PHASE_MAX; ++phaseIndex )
+		{
+			pTotals->phaseTicks[ phaseIndex ] += pRecord->phaseTicks[ phaseIndex ];
+		}
+
+		pTotals->objectBytes += pRecord->objectBytes;
+		pTotals->subDataBytes += pRecord->subDataBytes;
+	}
+
+	return pendingCount;
+}
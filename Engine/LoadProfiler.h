@@ -0,0 +1,201 @@
+#pragma once
+
+#include "Engine/Engine.h"
+
+#include "Foundation/DynamicArray.h"
+#include "Foundation/HashMap.h"
+#include "Foundation/ObjectPool.h"
+#include "Foundation/String.h"
+#include "Platform/Locks.h"
+#include "Engine/AssetPath.h"
+
+namespace Helium
+{
+	class Asset;
+
+	/// Per-asset load timing and I/O statistics.
+	///
+	/// While a profiler instance exists, the AssetLoader records the time spent in each load phase of every asset it
+	/// loads, the package loaders record the serialized bytes read and the time spent deserializing them, and resources
+	/// record their sub-data loads.  Each asset also records the other loads it had to wait on, which is used to find
+	/// the critical dependency chain of a load: the chain of dependencies that each finished last, and therefore held
+	/// up the load the longest.
+	///
+	/// Reports combine the per-asset records into totals by asset type, list the slowest loads and their critical
+	/// chains, and include the AsyncLoader I/O and Asset registry lock statistics.  They can be written to a file or to
+	/// the trace output, so a headless run only needs to initialize the profiler before loading and save a report before
+	/// shutting down.
+	class HELIUM_ENGINE_API LoadProfiler : NonCopyable
+	{
+	public:
+		/// Number of records to allocate in each block of the record pool.
+		static const size_t RECORD_POOL_BLOCK_SIZE = 256;
+		/// Default number of slowest loads to list in reports.
+		static const size_t DEFAULT_SLOWEST_COUNT = 20;
+
+		/// Load phase.
+		enum EPhase
+		{
+			PHASE_FIRST   =  0,
+			PHASE_INVALID = -1,
+
+			/// AssetLoader preloading (including package loader object loads).
+			PHASE_PRELOAD,
+			/// AssetLoader linking.
+			PHASE_LINK,
+			/// AssetLoader resource precaching.
+			PHASE_PRECACHE,
+			/// AssetLoader load finalization.
+			PHASE_FINALIZE,
+			/// Package loader deserialization (possibly on an AsyncLoader worker thread).
+			PHASE_DESERIALIZE,
+
+			PHASE_MAX,
+			PHASE_LAST = PHASE_MAX - 1
+		};
+
+		/// Load statistics for a single asset.  Times are in timer ticks.
+		struct Record
+		{
+			/// Asset path.
+			AssetPath path;
+			/// Asset type name (empty until the load completes).
+			Name typeName;
+			/// Number of times the asset has been loaded (only the latest load is recorded).
+			uint32_t loadCount;
+
+			/// Timer tick count when the load began.
+			uint64_t beginTickCount;
+			/// Timer tick count when the load completed, or zero if it is still in progress.
+			uint64_t endTickCount;
+			/// Time spent in each load phase.
+			uint64_t phaseTicks[ PHASE_MAX ];
+
+			/// Number of serialized object bytes read.
+			uint64_t objectBytes;
+			/// Number of resource sub-data bytes read.
+			uint64_t subDataBytes;
+			/// Number of resource sub-data loads.
+			uint32_t subDataLoadCount;
+			/// Time spent between beginning resource sub-data loads and seeing them complete.
+			uint64_t subDataWaitTicks;
+
+			/// Paths of the loads this load had to wait on.
+			DynamicArray< AssetPath > dependencies;
+		};
+
+		/// Totals of the completed loads of a single asset type.  Times are in timer ticks.
+		struct TypeTotals
+		{
+			/// Type name (empty for failed loads).
+			Name typeName;
+			/// Number of completed loads.
+			size_t loadCount;
+			/// Total load time.
+			uint64_t loadTicks;
+			/// Total time spent in each phase.
+			uint64_t phaseTicks[ PHASE_MAX ];
+			/// Total serialized object bytes read.
+			uint64_t objectBytes;
+			/// Total resource sub-data bytes read.
+			uint64_t subDataBytes;
+		};
+
+		/// Adds the time spent within its scope to a load phase of an asset if a profiler instance exists.
+		class HELIUM_ENGINE_API PhaseScope : NonCopyable
+		{
+		public:
+			/// @name Construction/Destruction
+			//@{
+			PhaseScope( AssetPath path, EPhase phase );
+			~PhaseScope();
+			//@}
+
+		private:
+			/// Profiler instance, or null if profiling is disabled.
+			LoadProfiler* m_pProfiler;
+			/// Asset path.
+			AssetPath m_path;
+			/// Load phase.
+			EPhase m_phase;
+			/// Timer tick count when the scope was entered.
+			uint64_t m_startTickCount;
+		};
+
+		/// @name Recording
+		//@{
+		void BeginLoad( AssetPath path );
+		void BeginLoad( AssetPath path, uint64_t tickCount );
+		void EndLoad( AssetPath path, const Asset* pAsset );
+		void EndLoad( AssetPath path, Name typeName, uint64_t tickCount );
+
+		void AddPhaseTicks( AssetPath path, EPhase phase, uint64_t ticks );
+		void AddDependency( AssetPath path, AssetPath dependencyPath );
+		void AddObjectBytes( AssetPath path, size_t bytes );
+
+		void BeginSubDataLoad( AssetPath path, size_t loadId, size_t bytes );
+		void EndSubDataLoad( size_t loadId );
+
+		void Clear();
+		//@}
+
+		/// @name Reporting
+		//@{
+		size_t GetRecordCount() const;
+		bool GetRecord( AssetPath path, Record& rRecord ) const;
+		void GetSlowestRecords( DynamicArray< Record >& rRecords, size_t count ) const;
+		void GetCriticalChain( AssetPath path, DynamicArray< Record >& rChain ) const;
+		void GetTypeTotals( DynamicArray< TypeTotals >& rTotals ) const;
+
+		void WriteReport( String& rReport, size_t slowestCount = DEFAULT_SLOWEST_COUNT ) const;
+		bool SaveReport( const String& rFileName, size_t slowestCount = DEFAULT_SLOWEST_COUNT ) const;
+		void TraceReport( size_t slowestCount = DEFAULT_SLOWEST_COUNT ) const;
+
+		static const char* GetPhaseName( EPhase phase );
+		//@}
+
+		/// @name Static Access
+		//@{
+		static bool InitializeStaticInstance();
+		static LoadProfiler* GetStaticInstance();
+		static void DestroyStaticInstance();
+		//@}
+
+	private:
+		/// Sub-data load in progress.
+		struct SubDataLoad
+		{
+			/// Resource path.
+			AssetPath path;
+			/// Timer tick count when the load began.
+			uint64_t beginTickCount;
+		};
+
+		/// Records, by asset path.
+		HashMap< AssetPath, Record* > m_recordMap;
+		/// Record pool.
+		ObjectPool< Record > m_recordPool;
+		/// Sub-data loads in progress, by AsyncLoader request ID.
+		HashMap< size_t, SubDataLoad > m_subDataLoads;
+
+		/// Lock guarding all profiling state.
+		mutable Mutex m_lock;
+
+		/// Singleton instance.
+		static LoadProfiler* sm_pInstance;
+
+		/// @name Construction/Destruction
+		//@{
+		LoadProfiler();
+		~LoadProfiler();
+		//@}
+
+		/// @name Private Utility Functions
+		//@{
+		Record* FindOrAddRecord( AssetPath path );
+		void GetSlowestRecordsUnlocked( DynamicArray< const Record* >& rRecords, size_t count ) const;
+		void GetCriticalChainUnlocked( AssetPath path, DynamicArray< const Record* >& rChain ) const;
+		size_t GetTypeTotalsUnlocked( DynamicArray< TypeTotals >& rTotals ) const;
+		//@}
+	};
+}
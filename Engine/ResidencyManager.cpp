@@ -0,0 +1,444 @@
+#include "EnginePch.h"
+#include "Engine/ResidencyManager.h"
+
+#include "Engine/Resource.h"
+#include "Platform/Atomic.h"
+
+using namespace Helium;
+
+/// Constructor.
+ResidencyManager::ResidencyManager()
+: m_budget( Invalid< size_t >() )
+, m_bEnabled( 0 )
+, m_residentSize( 0 )
+, m_evictionCount( 0 )
+, m_entryPool( ENTRY_POOL_BLOCK_SIZE )
+, m_pNewest( NULL )
+, m_pOldest( NULL )
+{
+}
+
+/// Destructor.
+ResidencyManager::~ResidencyManager()
+{
+	Clear();
+}
+
+/// Set the global resident memory budget.
+///
+/// Setting a budget enables residency tracking.  Setting an invalid budget disables it and releases all resources
+/// kept resident so far.
+///
+/// @param[in] budget  Budget, in bytes, or an invalid value to disable residency tracking.
+///
+/// @see GetBudget(), SetTypeBudget()
+void ResidencyManager::SetBudget( size_t budget )
+{
+	{
+		MutexScopeLock scopeLock( m_lock );
+		m_budget = budget;
+		AtomicExchangeRelease( m_bEnabled, IsValid( budget ) ? 1 : 0 );
+	}
+
+	if( IsInvalid( budget ) )
+	{
+		Clear();
+	}
+}
+
+/// Get the global resident memory budget.
+///
+/// @return  Budget, in bytes, or an invalid value if residency tracking is disabled.
+///
+/// @see SetBudget(), IsEnabled()
+size_t ResidencyManager::GetBudget() const
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	return m_budget;
+}
+
+/// Set the resident memory budget for resources of a specific type.
+///
+/// Type budgets apply on top of the global budget, and only to resources whose type is exactly the given type.
+///
+/// @param[in] pType   Resource type.
+/// @param[in] budget  Budget, in bytes, or an invalid value to remove the type budget.
+///
+/// @see GetTypeBudget(), SetBudget()
+void ResidencyManager::SetTypeBudget( const AssetType* pType, size_t budget )
+{
+	HELIUM_ASSERT( pType );
+
+	MutexScopeLock scopeLock( m_lock );
+	GetTypeResidency( pType ).budget = budget;
+}
+
+/// Get the resident memory budget for resources of a specific type.
+///
+/// @param[in] pType  Resource type.
+///
+/// @return  Budget, in bytes, or an invalid value if the type has no budget of its own.
+///
+/// @see SetTypeBudget()
+size_t ResidencyManager::GetTypeBudget( const AssetType* pType ) const
+{
+	HELIUM_ASSERT( pType );
+
+	MutexScopeLock scopeLock( m_lock );
+	HashMap< Name, TypeResidency >::ConstIterator typeIterator = m_typeResidency.Find( pType->GetName() );
+
+	return ( typeIterator != m_typeResidency.End() ? typeIterator->Second().budget : Invalid< size_t >() );
+}
+
+/// Start keeping a loaded resource resident.
+///
+/// The resource becomes the most recently used one.  This has no effect if residency tracking is disabled or the
+/// resource failed to load.
+///
+/// @param[in] pResource  Loaded resource.
+///
+/// @see Touch(), UpdateResidentSize()
+void ResidencyManager::Track( Resource* pResource )
+{
+	HELIUM_ASSERT( pResource );
+
+	if( !IsEnabled() || pResource->GetAnyFlagSet( Asset::FLAG_BROKEN ) )
+	{
+		return;
+	}
+
+	// Query the size before locking, as it may need to look up cache entries.
+	size_t size = pResource->GetResidentSize();
+
+	MutexScopeLock scopeLock( m_lock );
+
+	// Tracking may have been disabled while the size was being queried.
+	if( IsInvalid( m_budget ) )
+	{
+		return;
+	}
+
+	Entry* pEntry = FindEntry( pResource );
+	if( pEntry )
+	{
+		TypeResidency& rTypeResidency = GetTypeResidency( pEntry->pType );
+		rTypeResidency.residentSize += size - pEntry->size;
+		m_residentSize += size - pEntry->size;
+		pEntry->size = size;
+
+		Unlink( pEntry );
+		LinkNewest( pEntry );
+
+		return;
+	}
+
+	pEntry = m_entryPool.Allocate();
+	HELIUM_ASSERT( pEntry );
+	pEntry->spResource = pResource;
+	pEntry->pType = pResource->GetAssetType();
+	pEntry->size = size;
+	LinkNewest( pEntry );
+
+	HashMap< AssetPath, Entry* >::Iterator entryIterator;
+	HELIUM_VERIFY( m_entryMap.Insert( entryIterator, KeyValue< AssetPath, Entry* >( pResource->GetPath(), pEntry ) ) );
+
+	GetTypeResidency( pEntry->pType ).residentSize += size;
+	m_residentSize += size;
+}
+
+/// Mark a resource as the most recently used one.
+///
+/// This has no effect if the asset is not a tracked resource.
+///
+/// @param[in] pAsset  Asset being used.
+///
+/// @see Track()
+void ResidencyManager::Touch( Asset* pAsset )
+{
+	HELIUM_ASSERT( pAsset );
+
+	if( !IsEnabled() )
+	{
+		return;
+	}
+
+	MutexScopeLock scopeLock( m_lock );
+
+	Entry* pEntry = FindEntry( pAsset );
+	if( pEntry && pEntry != m_pNewest )
+	{
+		Unlink( pEntry );
+		LinkNewest( pEntry );
+	}
+}
+
+/// Update the resident size of a tracked resource after its resident data has changed.
+///
+/// @param[in] pResource  Tracked resource.
+///
+/// @see Track()
+void ResidencyManager::UpdateResidentSize( Resource* pResource )
+{
+	HELIUM_ASSERT( pResource );
+
+	if( !IsEnabled() )
+	{
+		return;
+	}
+
+	size_t size = pResource->GetResidentSize();
+
+	MutexScopeLock scopeLock( m_lock );
+
+	Entry* pEntry = FindEntry( pResource );
+	if( pEntry )
+	{
+		GetTypeResidency( pEntry->pType ).residentSize += size - pEntry->size;
+		m_residentSize += size - pEntry->size;
+		pEntry->size = size;
+	}
+}
+
+/// Evict unreferenced resources, least recently used first, until all budgets are met or no unreferenced resources
+/// are left.
+///
+/// Evicted resources are destroyed, and will be loaded again through the AssetLoader when next requested.  Releasing
+/// a resource may in turn leave the resources it referenced unreferenced, which are then considered for eviction by
+/// the next update.
+void ResidencyManager::Tick()
+{
+	if( !IsEnabled() )
+	{
+		return;
+	}
+
+	// Released references are held until after unlocking, as destroying resources can release other resources.
+	DynamicArray< AssetPtr > evictedResources;
+	size_t residentSize = 0;
+	size_t budget = 0;
+
+	{
+		MutexScopeLock scopeLock( m_lock );
+
+		bool bOverBudget = ( m_residentSize > m_budget );
+		HashMap< Name, TypeResidency >::ConstIterator typeEnd = m_typeResidency.End();
+		for( HashMap< Name, TypeResidency >::ConstIterator typeIterator = m_typeResidency.Begin();
+			!bOverBudget && typeIterator != typeEnd;
+			++typeIterator )
+		{
+			bOverBudget = IsOverBudget( typeIterator->Second() );
+		}
+
+		if( !bOverBudget )
+		{
+			return;
+		}
+
+		Entry* pEntry = m_pOldest;
+		while( pEntry )
+		{
+			Entry* pNewer = pEntry->pNewer;
+
+			// Resources referenced from anywhere but this manager are still in use and cannot be evicted.
+			TypeResidency& rTypeResidency = GetTypeResidency( pEntry->pType );
+			if( IsOverBudget( rTypeResidency ) &&
+				pEntry->spResource->GetRefCountProxy()->GetStrongRefCount() == 1 )
+			{
+				HELIUM_TRACE(
+					TraceLevels::Debug,
+					TXT( "ResidencyManager: Evicting \"%s\" (%" ) PRIuSZ TXT( " bytes).\n" ),
+					*pEntry->spResource->GetPath().ToString(),
+					pEntry->size );
+
+				rTypeResidency.residentSize -= pEntry->size;
+				m_residentSize -= pEntry->size;
+				++m_evictionCount;
+
+				Unlink( pEntry );
+				m_entryMap.Remove( pEntry->spResource->GetPath() );
+
+				evictedResources.Push( pEntry->spResource );
+				pEntry->spResource.Release();
+				m_entryPool.Release( pEntry );
+			}
+
+			pEntry = pNewer;
+		}
+
+		residentSize = m_residentSize;
+		budget = m_budget;
+	}
+
+	if( !evictedResources.IsEmpty() )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			TXT( "ResidencyManager: Evicted %" ) PRIuSZ TXT( " resources (%" ) PRIuSZ TXT( " of %" ) PRIuSZ
+			TXT( " bytes resident).\n" ),
+			evictedResources.GetSize(),
+			residentSize,
+			budget );
+	}
+}
+
+/// Release all resources kept resident.
+///
+/// Resources no longer referenced from anywhere else are destroyed.  Type budgets are kept.
+void ResidencyManager::Clear()
+{
+	DynamicArray< AssetPtr > releasedResources;
+
+	{
+		MutexScopeLock scopeLock( m_lock );
+
+		releasedResources.Reserve( m_entryMap.GetSize() );
+		while( m_pOldest )
+		{
+			Entry* pEntry = m_pOldest;
+			Unlink( pEntry );
+
+			releasedResources.Push( pEntry->spResource );
+			pEntry->spResource.Release();
+			m_entryPool.Release( pEntry );
+		}
+
+		m_entryMap.Clear();
+		m_residentSize = 0;
+
+		HashMap< Name, TypeResidency >::Iterator typeEnd = m_typeResidency.End();
+		for( HashMap< Name, TypeResidency >::Iterator typeIterator = m_typeResidency.Begin();
+			typeIterator != typeEnd;
+			++typeIterator )
+		{
+			typeIterator->Second().residentSize = 0;
+		}
+	}
+}
+
+/// Get the resident size of all tracked resources of a specific type.
+///
+/// @param[in] pType  Resource type.
+///
+/// @return  Resident size, in bytes.
+///
+/// @see GetResidentSize()
+size_t ResidencyManager::GetTypeResidentSize( const AssetType* pType ) const
+{
+	HELIUM_ASSERT( pType );
+
+	MutexScopeLock scopeLock( m_lock );
+	HashMap< Name, TypeResidency >::ConstIterator typeIterator = m_typeResidency.Find( pType->GetName() );
+
+	return ( typeIterator != m_typeResidency.End() ? typeIterator->Second().residentSize : 0 );
+}
+
+/// Find the entry for a tracked asset.
+///
+/// This must be called with the residency lock held.
+///
+/// @param[in] pAsset  Asset to find.
+///
+/// @return  Asset entry, or null if the asset is not tracked.
+ResidencyManager::Entry* ResidencyManager::FindEntry( Asset* pAsset ) const
+{
+	HELIUM_ASSERT( pAsset );
+
+	HashMap< AssetPath, Entry* >::ConstIterator entryIterator = m_entryMap.Find( pAsset->GetPath() );
+	if( entryIterator == m_entryMap.End() )
+	{
+		return NULL;
+	}
+
+	// A different asset may have taken over the path of an asset that was renamed after being tracked.
+	Entry* pEntry = entryIterator->Second();
+	HELIUM_ASSERT( pEntry );
+
+	return ( pEntry->spResource.Get() == pAsset ? pEntry : NULL );
+}
+
+/// Add an entry to the most recently used end of the entry list.
+///
+/// @param[in] pEntry  Entry to add.
+///
+/// @see Unlink()
+void ResidencyManager::LinkNewest( Entry* pEntry )
+{
+	HELIUM_ASSERT( pEntry );
+
+	pEntry->pNewer = NULL;
+	pEntry->pOlder = m_pNewest;
+	if( m_pNewest )
+	{
+		m_pNewest->pNewer = pEntry;
+	}
+	else
+	{
+		m_pOldest = pEntry;
+	}
+
+	m_pNewest = pEntry;
+}
+
+/// Remove an entry from the entry list.
+///
+/// @param[in] pEntry  Entry to remove.
+///
+/// @see LinkNewest()
+void ResidencyManager::Unlink( Entry* pEntry )
+{
+	HELIUM_ASSERT( pEntry );
+
+	if( pEntry->pNewer )
+	{
+		pEntry->pNewer->pOlder = pEntry->pOlder;
+	}
+	else
+	{
+		HELIUM_ASSERT( m_pNewest == pEntry );
+		m_pNewest = pEntry->pOlder;
+	}
+
+	if( pEntry->pOlder )
+	{
+		pEntry->pOlder->pNewer = pEntry->pNewer;
+	}
+	else
+	{
+		HELIUM_ASSERT( m_pOldest == pEntry );
+		m_pOldest = pEntry->pNewer;
+	}
+
+	pEntry->pNewer = NULL;
+	pEntry->pOlder = NULL;
+}
+
+/// Get the budget and resident size for a type, adding them if necessary.
+///
+/// @param[in] pType  Resource type.
+///
+/// @return  Type residency information.
+ResidencyManager::TypeResidency& ResidencyManager::GetTypeResidency( const AssetType* pType )
+{
+	HELIUM_ASSERT( pType );
+
+	TypeResidency newTypeResidency;
+	SetInvalid( newTypeResidency.budget );
+	newTypeResidency.residentSize = 0;
+
+	HashMap< Name, TypeResidency >::Iterator typeIterator;
+	m_typeResidency.Insert( typeIterator, KeyValue< Name, TypeResidency >( pType->GetName(), newTypeResidency ) );
+
+	return typeIterator->Second();
+}
+
+/// Get whether either the global budget or the budget of a type is exceeded.
+///
+/// @param[in] rTypeResidency  Type residency information.
+///
+/// @return  True if over budget, false if not.
+bool ResidencyManager::IsOverBudget( const TypeResidency& rTypeResidency ) const
+{
+	return ( m_residentSize > m_budget ||
+		( IsValid( rTypeResidency.budget ) && rTypeResidency.residentSize > rTypeResidency.budget ) );
+}
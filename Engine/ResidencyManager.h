@@ -0,0 +1,124 @@
+#pragma once
+
+#include "Engine/Engine.h"
+
+#include "Foundation/HashMap.h"
+#include "Foundation/ObjectPool.h"
+#include "Platform/Locks.h"
+#include "Engine/Asset.h"
+
+namespace Helium
+{
+	class Resource;
+
+	/// Resident memory budget for loaded resources.
+	///
+	/// While a global budget is set, loaded resources are kept resident after their last outside reference is
+	/// released instead of being destroyed right away, so that loading them again is free.  Resources are kept in
+	/// least-recently-used order, and once the resident size of all resources (or of all resources of a type with its
+	/// own budget) exceeds the budget, unreferenced resources are evicted starting with the least recently used.  An
+	/// evicted resource is simply loaded again through the AssetLoader the next time it is requested.
+	///
+	/// Resources still referenced from outside are counted against the budgets, but are never evicted.
+	class HELIUM_ENGINE_API ResidencyManager : NonCopyable
+	{
+	public:
+		/// Number of entries to allocate in each block of the entry pool.
+		static const size_t ENTRY_POOL_BLOCK_SIZE = 256;
+
+		/// @name Construction/Destruction
+		//@{
+		ResidencyManager();
+		~ResidencyManager();
+		//@}
+
+		/// @name Budgets
+		//@{
+		void SetBudget( size_t budget );
+		size_t GetBudget() const;
+		inline bool IsEnabled() const;
+
+		void SetTypeBudget( const AssetType* pType, size_t budget );
+		size_t GetTypeBudget( const AssetType* pType ) const;
+		//@}
+
+		/// @name Residency Tracking
+		//@{
+		void Track( Resource* pResource );
+		void Touch( Asset* pAsset );
+		void UpdateResidentSize( Resource* pResource );
+
+		void Tick();
+		void Clear();
+		//@}
+
+		/// @name Statistics
+		//@{
+		inline size_t GetResidentSize() const;
+		size_t GetTypeResidentSize( const AssetType* pType ) const;
+		inline size_t GetTrackedCount() const;
+		inline uint64_t GetEvictionCount() const;
+		//@}
+
+	private:
+		/// Tracked resource.
+		struct Entry
+		{
+			/// Resource reference keeping the resource resident.
+			AssetPtr spResource;
+			/// Resource type.
+			const AssetType* pType;
+			/// Resident size, in bytes.
+			size_t size;
+
+			/// Next more recently used entry.
+			Entry* pNewer;
+			/// Next less recently used entry.
+			Entry* pOlder;
+		};
+
+		/// Per-type budget and resident size.
+		struct TypeResidency
+		{
+			/// Budget, in bytes (invalid if the type has no budget of its own).
+			size_t budget;
+			/// Resident size of all tracked resources of the type, in bytes.
+			size_t residentSize;
+		};
+
+		/// Global budget, in bytes (invalid if residency tracking is disabled).
+		size_t m_budget;
+		/// Non-zero if a global budget is set, for checking without taking the lock.
+		volatile int32_t m_bEnabled;
+		/// Resident size of all tracked resources, in bytes.
+		size_t m_residentSize;
+		/// Number of resources evicted so far.
+		uint64_t m_evictionCount;
+
+		/// Entries, by resource path.
+		HashMap< AssetPath, Entry* > m_entryMap;
+		/// Entry pool.
+		ObjectPool< Entry > m_entryPool;
+		/// Most recently used entry.
+		Entry* m_pNewest;
+		/// Least recently used entry.
+		Entry* m_pOldest;
+
+		/// Budgets and resident sizes, by type name.
+		HashMap< Name, TypeResidency > m_typeResidency;
+
+		/// Lock guarding all residency state other than the enabled flag.
+		mutable Mutex m_lock;
+
+		/// @name Private Utility Functions
+		//@{
+		Entry* FindEntry( Asset* pAsset ) const;
+		void LinkNewest( Entry* pEntry );
+		void Unlink( Entry* pEntry );
+		TypeResidency& GetTypeResidency( const AssetType* pType );
+		bool IsOverBudget( const TypeResidency& rTypeResidency ) const;
+		//@}
+	};
+}
+
+#include "Engine/ResidencyManager.inl"
@@ -0,0 +1,35 @@
+/// Get whether resources are being kept resident within a budget.
+///
+/// @return  True if a global budget is set, false if not.
+///
+/// @see SetBudget()
+bool Helium::ResidencyManager::IsEnabled() const
+{
+	return ( m_bEnabled != 0 );
+}
+
+/// Get the resident size of all tracked resources.
+///
+/// @return  Resident size, in bytes.
+///
+/// @see GetTypeResidentSize()
+size_t Helium::ResidencyManager::GetResidentSize() const
+{
+	return m_residentSize;
+}
+
+/// Get the number of resources currently tracked.
+///
+/// @return  Tracked resource count.
+size_t Helium::ResidencyManager::GetTrackedCount() const
+{
+	return m_entryMap.GetSize();
+}
+
+/// Get the number of resources evicted since this manager was created.
+///
+/// @return  Eviction count.
+uint64_t Helium::ResidencyManager::GetEvictionCount() const
+{
+	return m_evictionCount;
+}
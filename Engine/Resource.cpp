@@ -4,7 +4,9 @@
 #include "Engine/AsyncLoader.h"
 #include "Reflect/MetaClass.h"
 #include "Engine/Asset.h"
+#include "Engine/AssetLoader.h"
 #include "Engine/CacheManager.h"
+#include "Engine/LoadProfiler.h"
 
 HELIUM_IMPLEMENT_ASSET( Helium::Resource, Engine, 0 );
 
@@ -36,6 +38,37 @@ Name Resource::GetCacheName() const
 	return Name( NULL_NAME );
 }
 
+/// Get the number of bytes of memory this resource keeps resident while loaded.
+///
+/// By default, this is the size of the object itself plus the size of all of its cached sub-data.  Resources that
+/// only keep part of their sub-data loaded, or that hold on to other large allocations, should override this.
+///
+/// @return  Resident size, in bytes.
+///
+/// @see ResidencyManager
+size_t Resource::GetResidentSize() const
+{
+	size_t residentSize = GetInstanceSize();
+
+	if( GetCacheName().IsEmpty() )
+	{
+		return residentSize;
+	}
+
+	for( uint32_t subDataIndex = 0; ; ++subDataIndex )
+	{
+		size_t subDataSize = GetSubDataSize( subDataIndex );
+		if( IsInvalid( subDataSize ) )
+		{
+			break;
+		}
+
+		residentSize += subDataSize;
+	}
+
+	return residentSize;
+}
+
 /// Get the size of the specified sub-data of this resource.
 ///
 /// @param[in] subDataIndex  Resource sub-data index.
@@ -131,12 +164,27 @@ size_t Resource::BeginLoadSubData( void* pBuffer, uint32_t subDataIndex, size_t
 		return Invalid< size_t >();
 	}
 
+	AssetLoader* pAssetLoader = AssetLoader::GetStaticInstance();
+	if( pAssetLoader && pAssetLoader->IsRecordingManifest() )
+	{
+		pAssetLoader->RecordSubDataLoad( cacheName, resourcePath, subDataIndex );
+	}
+
 	// Begin an asynchronous load.
-	size_t subDataSize = pCacheEntry->size;
-	size_t loadSize = Min( subDataSize, loadSizeMax );
+	size_t loadId = pCache->QueueEntryLoad( *pCacheEntry, pBuffer, loadSizeMax );
 
-	AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
-	size_t loadId = rAsyncLoader.QueueRequest( pBuffer, pCache->GetCacheFileName(), pCacheEntry->offset, loadSize );
+	LoadProfiler* pLoadProfiler = LoadProfiler::GetStaticInstance();
+	if( pLoadProfiler && IsValid( loadId ) )
+	{
+		size_t loadSize = Min( static_cast< size_t >( pCacheEntry->size ), loadSizeMax );
+		pLoadProfiler->BeginSubDataLoad( resourcePath, loadId, loadSize );
+	}
+
+	// Have our load request woken up once the data arrives if we are precaching.
+	if( pAssetLoader && IsValid( loadId ) )
+	{
+		pAssetLoader->BeginSubDataWait( resourcePath, loadId );
+	}
 
 	return loadId;
 }
@@ -163,6 +211,20 @@ bool Resource::TryFinishLoadSubData( size_t loadId )
 
 	size_t bytesRead;
 	bool bFinished = rAsyncLoader.TrySyncRequest( loadId, bytesRead );
+	if( bFinished )
+	{
+		LoadProfiler* pLoadProfiler = LoadProfiler::GetStaticInstance();
+		if( pLoadProfiler )
+		{
+			pLoadProfiler->EndSubDataLoad( loadId );
+		}
+
+		AssetLoader* pAssetLoader = AssetLoader::GetStaticInstance();
+		if( pAssetLoader )
+		{
+			pAssetLoader->EndSubDataWait( loadId );
+		}
+	}
 
 	return bFinished;
 }
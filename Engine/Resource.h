@@ -52,6 +52,11 @@ namespace Helium
 		virtual Name GetCacheName() const;
 		//@}
 
+		/// @name Residency
+		//@{
+		virtual size_t GetResidentSize() const;
+		//@}
+
 #if HELIUM_TOOLS
 		/// @name Editor Support
 		//@{
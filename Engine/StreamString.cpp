@@ -0,0 +1,47 @@
+#include "EnginePch.h"
+#include "Engine/StreamString.h"
+
+using namespace Helium;
+
+/// Write a length-prefixed string to a stream.
+///
+/// @param[in] rStream  Stream to which the string should be written.
+/// @param[in] rString  String to write.
+///
+/// @return  True if the string was written successfully, false if not.
+///
+/// @see ReadLengthPrefixedString()
+bool Helium::WriteLengthPrefixedString( Stream& rStream, const String& rString )
+{
+	uint32_t stringSize = static_cast< uint32_t >( rString.GetSize() );
+
+	return ( rStream.Write( &stringSize, sizeof( stringSize ), 1 ) == 1 &&
+		rStream.Write( *rString, sizeof( char ), stringSize ) == stringSize );
+}
+
+/// Read a length-prefixed string from a stream.
+///
+/// @param[in]  rStream  Stream from which the string should be read.
+/// @param[out] rString  Buffer in which to store the null-terminated string.
+///
+/// @return  True if the string was read successfully, false if not.
+///
+/// @see WriteLengthPrefixedString()
+bool Helium::ReadLengthPrefixedString( Stream& rStream, DynamicArray< char >& rString )
+{
+	uint32_t stringSize;
+	if( rStream.Read( &stringSize, sizeof( stringSize ), 1 ) != 1 )
+	{
+		return false;
+	}
+
+	rString.Resize( stringSize + 1 );
+	if( rStream.Read( rString.GetData(), sizeof( char ), stringSize ) != stringSize )
+	{
+		return false;
+	}
+
+	rString[ stringSize ] = TXT( '\0' );
+
+	return true;
+}
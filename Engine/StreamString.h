@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Engine/Engine.h"
+
+#include "Foundation/DynamicArray.h"
+#include "Foundation/Stream.h"
+#include "Foundation/String.h"
+
+namespace Helium
+{
+	/// @defgroup streamstring Length-Prefixed Stream Strings
+	/// Strings stored in binary files as a 32-bit character count followed by the characters, without a terminator.
+	//@{
+	HELIUM_ENGINE_API bool WriteLengthPrefixedString( Stream& rStream, const String& rString );
+	HELIUM_ENGINE_API bool ReadLengthPrefixedString( Stream& rStream, DynamicArray< char >& rString );
+	//@}
+}
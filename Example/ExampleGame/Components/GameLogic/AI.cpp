@@ -6,6 +6,7 @@
 #include "ExampleGame/Components/GameLogic/PlayerManager.h"
 #include "Foundation/Numeric.h"
 #include "Framework/World.h"
+#include "Components/SimulationLodComponent.h"
 
 using namespace Helium;
 using namespace ExampleGame;
@@ -16,7 +17,7 @@ HELIUM_DEFINE_COMPONENT( ExampleGame::AIComponentChasePlayer, 16 )
 
 void AIComponentChasePlayer::Initialize( const AIComponentChasePlayerDefinition &definition )
 {
-
+	m_TurnRate = definition.m_TurnRate;
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -25,6 +26,12 @@ void AIComponentChasePlayer::Initialize( const AIComponentChasePlayerDefinition
 HELIUM_DEFINE_CLASS( ExampleGame::AIComponentChasePlayerDefinition )
 
 void AIComponentChasePlayerDefinition::PopulateMetaType( Helium::Reflect::MetaStruct& comp )
+{
+	comp.AddField( &AIComponentChasePlayerDefinition::m_TurnRate, "m_TurnRate" );
+}
+
+AIComponentChasePlayerDefinition::AIComponentChasePlayerDefinition()
+	: m_TurnRate( 8.0f )
 {
 
 }
@@ -36,7 +43,7 @@ void AIComponentChasePlayerDefinition::PopulateMetaType( Helium::Reflect::MetaSt
 typedef DynamicArray< Pair< PlayerComponent *, Simd::Vector3 > > PlayerList;
 static PlayerList g_PlayerList;
 
-void UpdateAI_ChasePlayer( AIComponentChasePlayer *pAiComponent, AvatarControllerComponent *pController )
+void UpdateAI_ChasePlayer( AIComponentChasePlayer *pAiComponent, AvatarControllerComponent *pController, float32_t deltaSeconds )
 {
 	PlayerComponent *pTarget = NULL;
 	float pTargetDistanceSquared = NumericLimits<float>::Maximum;
@@ -60,21 +67,30 @@ void UpdateAI_ChasePlayer( AIComponentChasePlayer *pAiComponent, AvatarControlle
 		}
 	}
 	
+	float32_t desiredX = 0.0f;
+	float32_t desiredY = 0.0f;
+
 	if ( pTarget )
 	{
 		Simd::Vector3 moveDir = (targetPosition - myPosition).GetNormalized();
-
-		pController->m_MoveDir.SetX( moveDir.GetElement(0));
-		pController->m_MoveDir.SetY( moveDir.GetElement(1));
-		pController->m_AimDir = Simd::Vector3::Zero;
-		pController->m_bShoot = false;
+		desiredX = moveDir.GetElement(0);
+		desiredY = moveDir.GetElement(1);
 	}
-	else
+
+	// Steer toward the desired direction rather than snapping to it. Entities on a slow simulation LOD bucket get a
+	// correspondingly larger time step, so they end up turning just as fast as ones updated every frame.
+	float32_t blend = pAiComponent->m_TurnRate * deltaSeconds;
+	if ( blend > 1.0f )
 	{
-		pController->m_MoveDir = Simd::Vector2::Zero;
-		pController->m_AimDir = Simd::Vector3::Zero;
-		pController->m_bShoot = false;
+		blend = 1.0f;
 	}
+
+	const float32_t currentX = pController->m_MoveDir.GetX();
+	const float32_t currentY = pController->m_MoveDir.GetY();
+	pController->m_MoveDir.SetX( currentX + ( desiredX - currentX ) * blend );
+	pController->m_MoveDir.SetY( currentY + ( desiredY - currentY ) * blend );
+	pController->m_AimDir = Simd::Vector3::Zero;
+	pController->m_bShoot = false;
 }
 
 void ProcessAI( World *pWorld )
@@ -94,7 +110,8 @@ void ProcessAI( World *pWorld )
 		}
 	}
 
-	QueryComponents< AIComponentChasePlayer, AvatarControllerComponent, UpdateAI_ChasePlayer >( pWorld );
+	// Distant enemies re-evaluate their target less often; the controller keeps the last move direction in between
+	QueryComponentsLod< AIComponentChasePlayer, AvatarControllerComponent, UpdateAI_ChasePlayer >( pWorld );
 }
 
 HELIUM_DEFINE_TASK( TaskProcessAI, ( ForEachWorld< ProcessAI > ), TickTypes::Gameplay )
@@ -102,5 +119,6 @@ HELIUM_DEFINE_TASK( TaskProcessAI, ( ForEachWorld< ProcessAI > ), TickTypes::Gam
 void TaskProcessAI::DefineContract( Helium::TaskContract &rContract )
 {
 	rContract.ExecuteAfter<Helium::StandardDependencies::ReceiveInput>();
+	rContract.ExecuteAfter<Helium::UpdateSimulationLodTask>();
 	rContract.ExecuteBefore<Helium::StandardDependencies::ProcessPhysics>();
 }
@@ -16,12 +16,20 @@ namespace ExampleGame
 		HELIUM_DECLARE_COMPONENT( ExampleGame::AIComponentChasePlayer, Helium::Component );
 
 		void Initialize( const AIComponentChasePlayerDefinition &definition);
+
+		float32_t m_TurnRate;
 	};
 
 	class EXAMPLE_GAME_API AIComponentChasePlayerDefinition : public Helium::ComponentDefinitionHelper<AIComponentChasePlayer, AIComponentChasePlayerDefinition>
 	{
 		HELIUM_DECLARE_CLASS( ExampleGame::AIComponentChasePlayerDefinition, Helium::ComponentDefinition );
 		static void PopulateMetaType( Helium::Reflect::MetaStruct& comp );
+
+		AIComponentChasePlayerDefinition();
+
+		// How quickly the chaser swings its move direction toward the player, as the fraction of the remaining
+		// correction applied per second (anything at or above 1/dt snaps straight to the target)
+		float32_t m_TurnRate;
 	};
 
 	struct EXAMPLE_GAME_API TaskProcessAI : public Helium::TaskDefinition
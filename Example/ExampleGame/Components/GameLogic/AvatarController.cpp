@@ -7,6 +7,7 @@
 
 
 #include "ExampleGame/Components/GameLogic/PlayerInput.h"
+#include "ExampleGame/Components/GameLogic/Projectiles.h"
 
 
 // TEMP
@@ -38,6 +39,12 @@ void AvatarControllerComponent::Finalize( const AvatarControllerComponentDefinit
 	HELIUM_ASSERT( m_PhysicsComponent.Get() );
 }
 
+void AvatarControllerComponent::OnCloned( const Components::CloneContext &rContext )
+{
+	m_TransformComponent = rContext.Remap( m_TransformComponent.Get() );
+	m_PhysicsComponent = rContext.Remap( m_PhysicsComponent.Get() );
+}
+
 HELIUM_DEFINE_CLASS(ExampleGame::AvatarControllerComponentDefinition);
 
 void AvatarControllerComponentDefinition::PopulateMetaType( Reflect::MetaStruct& comp )
@@ -122,12 +129,22 @@ void ControlAvatar( AvatarControllerComponent *pController )
 	}
 	else if ( pController->m_bShoot )
 	{
+		Simd::Vector3 bulletOrigin = pController->m_TransformComponent->GetPosition() + pController->m_AimDir * 45.0f;
+		Simd::Vector3 bulletVelocity = pController->m_AimDir * 400.0f;
+
+		// Prefer the world's projectile system when it has one; an entity per shot doesn't scale to bullet hell counts
+		World *pWorld = pController->GetWorld();
+		BulletProjectileSystemComponent *pProjectileSystem = pWorld->GetComponents().GetFirst<BulletProjectileSystemComponent>();
+		ProjectilesComponent *pProjectiles = pWorld->GetComponents().GetFirst<ProjectilesComponent>();
+
 		EntityDefinition* shotDefinition = pController->m_Definition->m_BulletDefinition;
-		if ( shotDefinition )
+		if ( pProjectileSystem && pProjectiles )
+		{
+			pProjectileSystem->Spawn( bulletOrigin, bulletVelocity, pProjectiles->m_Definition->m_Lifetime, 0 );
+			pController->m_ShootCooldown = pController->m_Definition->m_FireRepeatDelay;
+		}
+		else if ( shotDefinition )
 		{
-			Simd::Vector3 bulletOrigin = pController->m_TransformComponent->GetPosition() + pController->m_AimDir * 45.0f;
-			Simd::Vector3 bulletVelocity = pController->m_AimDir * 400.0f;
-
 			ParameterSetBuilder builder;
 			ParameterSet_InitLocated *pInitLocated = builder.AddParameterSet<ParameterSet_InitLocated>();
 			pInitLocated->m_Position = bulletOrigin;
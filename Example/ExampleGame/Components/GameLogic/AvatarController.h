@@ -24,6 +24,7 @@ namespace ExampleGame
 		static void PopulateMetaType( Helium::Reflect::MetaStruct& comp );
 		
 		void Finalize( const AvatarControllerComponentDefinition &definition );
+		void OnCloned( const Helium::Components::CloneContext &rContext );
 
 		Helium::StrongPtr< const AvatarControllerComponentDefinition > m_Definition;
 
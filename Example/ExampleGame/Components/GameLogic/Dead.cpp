@@ -56,7 +56,8 @@ void DoDestroyAllDead( DespawnOnDeathComponent *pDespawnOnDeathComponent, DeadCo
 	pDespawnOnDeathComponent->GetEntity()->DeferredDestroy();
 }
 
-HELIUM_DEFINE_TASK( TaskDestroyAllDead, ( ForEachWorld< QueryComponents< DespawnOnDeathComponent, DeadComponent, DoDestroyAllDead > > ), TickTypes::Gameplay )
+// Despawning the dead is cosmetic and can trail the kill by a frame or two, so let it yield to the rest of the frame
+HELIUM_DEFINE_TIME_SLICED_TASK( TaskDestroyAllDead, ( ForEachWorldTimeSliced< QueryComponentsTimeSliced< DespawnOnDeathComponent, DeadComponent, DoDestroyAllDead > > ), TickTypes::Gameplay, 200 )
 
 void TaskDestroyAllDead::DefineContract( Helium::TaskContract &rContract )
 {
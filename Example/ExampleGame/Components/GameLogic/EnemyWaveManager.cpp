@@ -129,6 +129,20 @@ void EnemyWaveManager::Initialize(World *pWorld)
 	m_pWorld = pWorld;
 }
 
+void EnemyWaveManager::OnCloned( const Components::CloneContext &rContext )
+{
+	m_pWorld = rContext.RemapOwner( m_pWorld );
+
+	for ( size_t waveIndex = 0; waveIndex < m_ActiveWaves.GetSize(); ++waveIndex )
+	{
+		DynamicArray< WaveEntityState > &rEntities = m_ActiveWaves[ waveIndex ].m_Entities;
+		for ( size_t entityIndex = 0; entityIndex < rEntities.GetSize(); ++entityIndex )
+		{
+			rEntities[ entityIndex ].m_Entity = rContext.RemapOwner( rEntities[ entityIndex ].m_Entity.Get() );
+		}
+	}
+}
+
 void EnemyWaveManager::Update( float dt )
 {
 	for (size_t i = m_ActiveWaves.GetSize() - 1; i < m_ActiveWaves.GetSize(); --i)
@@ -218,6 +232,11 @@ void EnemyWaveManagerComponent::Initialize( const EnemyWaveManagerComponentDefin
 	m_WaveManager.Initialize( GetWorld() );
 }
 
+void EnemyWaveManagerComponent::OnCloned( const Components::CloneContext &rContext )
+{
+	m_WaveManager.OnCloned( rContext );
+}
+
 //////////////////////////////////////////////////////////////////////////
 // EnemyWaveManagerComponentDefinition
 
@@ -86,6 +86,7 @@ namespace ExampleGame
 	{
 	public:
 		void Initialize(Helium::World *pWorld);
+		void OnCloned( const Helium::Components::CloneContext &rContext );
 		void Update(float dt);
 
 		void SpawnWave( EnemyWaveDefinition *pWave, ParameterSet_ActionSpawnEnemyWave *pParameters );
@@ -117,6 +118,7 @@ namespace ExampleGame
 		EnemyWaveManager &GetWaveManager() { return m_WaveManager; }
 
 		void Initialize(const EnemyWaveManagerComponentDefinition &pDefinition);
+		void OnCloned( const Helium::Components::CloneContext &rContext );
 
 		EnemyWaveManager &GetEnemyWaveManager() { return m_WaveManager; }
 
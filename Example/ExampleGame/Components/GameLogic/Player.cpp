@@ -24,6 +24,11 @@ void PlayerComponent::Initialize( const PlayerComponentDefinition &definition )
 	m_Definition.Set( &definition );
 }
 
+void PlayerComponent::OnCloned( const Components::CloneContext &rContext )
+{
+	m_Avatar = rContext.RemapOwner( m_Avatar.Get() );
+}
+
 void PlayerComponent::Tick()
 {
 	if ( !m_Avatar.ReferencesObject() )
@@ -28,6 +28,7 @@ namespace ExampleGame
 		static void PopulateMetaType( Helium::Reflect::MetaStruct& comp );
 		
 		void Initialize( const PlayerComponentDefinition &definition);
+		void OnCloned( const Helium::Components::CloneContext &rContext );
 
 		void Tick();
 		void Respawn();
@@ -22,6 +22,14 @@ void PlayerManagerComponent::Initialize( const PlayerManagerComponentDefinition
 	m_Definition.Set( &definition );
 }
 
+void PlayerManagerComponent::OnCloned( const Components::CloneContext &rContext )
+{
+	for ( size_t i = 0; i < m_Players.GetSize(); ++i )
+	{
+		m_Players[ i ].m_PlayerEntity = rContext.RemapOwner( m_Players[ i ].m_PlayerEntity.Get() );
+	}
+}
+
 void PlayerManagerComponent::Tick()
 {
 	// Create default player when we can
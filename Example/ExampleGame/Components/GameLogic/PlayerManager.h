@@ -27,6 +27,7 @@ namespace ExampleGame
 		static void PopulateMetaType( Helium::Reflect::MetaStruct& comp );
 		
 		void Initialize( const PlayerManagerComponentDefinition &definition);
+		void OnCloned( const Helium::Components::CloneContext &rContext );
 
 		void Tick();
 
@@ -0,0 +1,141 @@
+#include "ExampleGamePch.h"
+
+#include "ExampleGame/Components/GameLogic/Projectiles.h"
+#include "ExampleGame/Components/GameLogic/Health.h"
+#include "Reflect/TranslatorDeduction.h"
+#include "Framework/ComponentQuery.h"
+#include "Framework/World.h"
+#include "Graphics/BufferedDrawer.h"
+#include "Graphics/GraphicsManagerComponent.h"
+
+using namespace Helium;
+using namespace ExampleGame;
+
+//////////////////////////////////////////////////////////////////////////
+// ProjectilesComponent
+
+HELIUM_DEFINE_COMPONENT(ExampleGame::ProjectilesComponent, EXAMPLE_GAME_MAX_WORLDS);
+
+void ProjectilesComponent::PopulateMetaType( Reflect::MetaStruct& comp )
+{
+
+}
+
+void ProjectilesComponent::Initialize( const ProjectilesComponentDefinition &definition )
+{
+	m_Definition = &definition;
+}
+
+HELIUM_DEFINE_CLASS(ExampleGame::ProjectilesComponentDefinition);
+
+ExampleGame::ProjectilesComponentDefinition::ProjectilesComponentDefinition()
+	: m_DamageAmount( 0.0f )
+	, m_Lifetime( 2.0f )
+{
+
+}
+
+void ProjectilesComponentDefinition::PopulateMetaType( Reflect::MetaStruct& comp )
+{
+	comp.AddField( &ProjectilesComponentDefinition::m_Sprite, "m_Sprite" );
+	comp.AddField( &ProjectilesComponentDefinition::m_DamageAmount, "m_DamageAmount" );
+	comp.AddField( &ProjectilesComponentDefinition::m_Lifetime, "m_Lifetime" );
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+void ApplyProjectileDamageForWorld( World *pWorld )
+{
+	BulletProjectileSystemComponent *pProjectileSystem = pWorld->GetComponents().GetFirst<BulletProjectileSystemComponent>();
+	ProjectilesComponent *pProjectiles = pWorld->GetComponents().GetFirst<ProjectilesComponent>();
+	if ( !pProjectileSystem || !pProjectiles )
+	{
+		return;
+	}
+
+	const DynamicArray< ProjectileHit > &rHits = pProjectileSystem->GetHits();
+	for ( DynamicArray< ProjectileHit >::ConstIterator iter = rHits.Begin(); iter != rHits.End(); ++iter )
+	{
+		if ( !iter->m_pBody )
+		{
+			continue;
+		}
+
+		Entity *pOtherEntity = iter->m_pBody->GetEntity();
+		HealthComponent *pOtherHealthComponent = pOtherEntity ? pOtherEntity->GetComponents().GetFirst<HealthComponent>() : NULL;
+		if ( pOtherHealthComponent )
+		{
+			pOtherHealthComponent->ApplyDamage( pProjectiles->m_Definition->m_DamageAmount );
+		}
+	}
+}
+
+HELIUM_DEFINE_TASK( ApplyProjectileDamage, (ForEachWorld< ApplyProjectileDamageForWorld >), TickTypes::Gameplay )
+
+void ExampleGame::ApplyProjectileDamage::DefineContract( Helium::TaskContract &rContract )
+{
+	rContract.ExecuteAfter<Helium::SimulateProjectiles>();
+	rContract.ExecutesWithin<ExampleGame::DoDamage>();
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+void DrawProjectiles( World *pWorld )
+{
+#if !GRAPHICS_SCENE_BUFFERED_DRAWER
+	HELIUM_ASSERT( 0 );
+#else // GRAPHICS_SCENE_BUFFERED_DRAWER
+
+	BulletProjectileSystemComponent *pProjectileSystem = pWorld->GetComponents().GetFirst<BulletProjectileSystemComponent>();
+	ProjectilesComponent *pProjectiles = pWorld->GetComponents().GetFirst<ProjectilesComponent>();
+	if ( !pProjectileSystem || !pProjectiles || !pProjectileSystem->GetCount() )
+	{
+		return;
+	}
+
+	const SpriteComponentDefinition *pSprite = pProjectiles->m_Definition->m_Sprite;
+	Texture2d *pTexture = pSprite ? pSprite->GetTexture() : NULL;
+	if ( !pTexture )
+	{
+		return;
+	}
+
+	GraphicsManagerComponent *pGraphicsManager = pWorld->GetComponents().GetFirst<GraphicsManagerComponent>();
+	HELIUM_ASSERT( pGraphicsManager );
+	BufferedDrawer &rBufferedDrawer = pGraphicsManager->GetBufferedDrawer();
+
+	// Everything but the position is shared by every projectile, so work it out once
+	Simd::Vector2 uvTopLeft;
+	Simd::Vector2 uvBottomRight;
+	pSprite->GetUVCoordinates( 0, uvTopLeft, uvBottomRight );
+
+	const Simd::Quat rotation( 0.0f, 0.0f, pSprite->GetRotation() );
+	const Simd::Matrix44 scaling(
+		Simd::Matrix44::INIT_SCALING,
+		Simd::Vector3(
+			static_cast<float>( pTexture->GetWidth() ) * pSprite->GetScale().GetX(),
+			static_cast<float>( pTexture->GetHeight() ) * pSprite->GetScale().GetY(),
+			1.0f ) );
+
+	for ( uint32_t index = 0; index < pProjectileSystem->GetCount(); ++index )
+	{
+		Simd::Matrix44 matrix(
+			Simd::Matrix44::INIT_ROTATION_TRANSLATION,
+			rotation,
+			pProjectileSystem->GetPosition( index ) );
+
+		rBufferedDrawer.DrawTexturedQuad(
+			pTexture->GetRenderResource2d(),
+			scaling * matrix,
+			uvTopLeft,
+			uvBottomRight );
+	}
+#endif
+}
+
+HELIUM_DEFINE_TASK( DrawProjectilesTask, (ForEachWorld< DrawProjectiles >), TickTypes::Render )
+
+void ExampleGame::DrawProjectilesTask::DefineContract( Helium::TaskContract &rContract )
+{
+	rContract.ExecutesWithin<Helium::StandardDependencies::Render>();
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "Reflect/MetaStruct.h"
+#include "Framework/ComponentDefinition.h"
+#include "Framework/TaskScheduler.h"
+#include "Bullet/BulletProjectileSystemComponent.h"
+
+#include "ExampleGame/Components/Graphics/Sprite.h"
+
+namespace ExampleGame
+{
+	class ProjectilesComponentDefinition;
+
+	typedef Helium::StrongPtr<ProjectilesComponentDefinition> ProjectilesComponentDefinitionPtr;
+	typedef Helium::StrongPtr<const ProjectilesComponentDefinition> ConstProjectilesComponentDefinitionPtr;
+
+	//////////////////////////////////////////////////////////////////////////
+	// ProjectilesComponent
+	//
+	// - Game side of the world's BulletProjectileSystemComponent: how shots look and how much they hurt. When a world
+	//   has both, avatars fire into the projectile system instead of spawning an entity per shot.
+	struct EXAMPLE_GAME_API ProjectilesComponent : public Helium::Component
+	{
+		HELIUM_DECLARE_COMPONENT( ExampleGame::ProjectilesComponent, Helium::Component );
+		static void PopulateMetaType( Helium::Reflect::MetaStruct& comp );
+
+		void Initialize( const ProjectilesComponentDefinition &definition );
+
+		ConstProjectilesComponentDefinitionPtr m_Definition;
+	};
+
+	class EXAMPLE_GAME_API ProjectilesComponentDefinition : public Helium::ComponentDefinitionHelper<ProjectilesComponent, ProjectilesComponentDefinition>
+	{
+		HELIUM_DECLARE_CLASS( ExampleGame::ProjectilesComponentDefinition, Helium::ComponentDefinition );
+		static void PopulateMetaType( Helium::Reflect::MetaStruct& comp );
+
+		ProjectilesComponentDefinition();
+
+		SpriteComponentDefinitionPtr m_Sprite;
+		float m_DamageAmount;
+		float m_Lifetime;
+	};
+
+	struct EXAMPLE_GAME_API ApplyProjectileDamage : public Helium::TaskDefinition
+	{
+		HELIUM_DECLARE_TASK(ApplyProjectileDamage)
+
+		virtual void DefineContract(Helium::TaskContract &rContract);
+	};
+
+	struct EXAMPLE_GAME_API DrawProjectilesTask : public Helium::TaskDefinition
+	{
+		HELIUM_DECLARE_TASK(DrawProjectilesTask)
+
+		virtual void DefineContract(Helium::TaskContract &rContract);
+	};
+}
@@ -41,6 +41,19 @@ void CameraManagerComponent::Initialize( const CameraManagerComponentDefinition
 	HELIUM_ASSERT( m_GraphicsManager.IsGood() );
 }
 
+/// The cloned graphics manager has a scene view of its own, so the current camera is applied to it again next tick.
+void CameraManagerComponent::OnCloned( const Components::CloneContext &rContext )
+{
+	for ( Helium::Map<Helium::Name, CameraComponent *>::Iterator iter = m_Cameras.Begin(); iter != m_Cameras.End(); ++iter )
+	{
+		iter->Second() = rContext.Remap( iter->Second() );
+	}
+
+	m_CurrentCamera = rContext.Remap( m_CurrentCamera.Get() );
+	m_GraphicsManager = rContext.Remap( m_GraphicsManager.Get() );
+	m_CameraChanged = true;
+}
+
 bool CameraManagerComponent::RegisterNamedCamera( Helium::Name cameraName, CameraComponent *pCameraC )
 {
 	Helium::Map<Helium::Name, CameraComponent *>::Iterator iter = m_Cameras.Find( cameraName );
@@ -25,6 +25,7 @@ namespace ExampleGame
 		CameraManagerComponent();
 		
 		void Initialize( const CameraManagerComponentDefinition &definition);
+		void OnCloned( const Helium::Components::CloneContext &rContext );
 
 		void Tick();
 
@@ -107,6 +107,7 @@ int main( int argc, const char* argv[] )
 			Input::SetWindowSize( 
 				rendererInitialization.GetMainWindow()->GetWidth(),
 				rendererInitialization.GetMainWindow()->GetHeight());
+			Input::HandleCommandLine( pGameSystem->GetArguments() );
 
 			// Run the application.
 			result = pGameSystem->Run();
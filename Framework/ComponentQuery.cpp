@@ -1,6 +1,7 @@
 
 #include "FrameworkPch.h"
 #include "Framework/ComponentQuery.h"
+#include "Framework/TaskScheduler.h"
 #include <limits>
 #include <vector>
 
@@ -39,6 +40,27 @@ void EmitTuples(DynamicArray<Component *> &tuple, std::vector<FoundComponentList
 	while ( ( c = c->GetNextComponent() ) );
 }
 
+void EmitTuplesForComponent(Component *outer_component, std::vector<FoundComponentList> &found_components, ComponentTupleCallback emit_tuple_callback)
+{
+	ComponentCollection *collection = outer_component->GetComponentCollection();
+	HELIUM_ASSERT(collection);
+	
+	// Walk the other types we need components of
+	for (size_t type_index = 1; type_index < found_components.size(); ++type_index)
+	{
+		found_components[type_index].m_Component = collection->GetFirst( found_components[type_index].m_TypeId );
+		if ( !found_components[type_index].m_Component )
+		{
+			return;
+		}
+	}
+	
+	DynamicArray<Component *> tuple;
+	tuple.Resize(found_components.size());
+	tuple[found_components[0].m_TypeIndex] = outer_component;
+	EmitTuples(tuple, found_components, 1, emit_tuple_callback);
+}
+
 void Helium::QueryComponentsInternal(ComponentManager &rManager, const Components::TypeId *types, size_t typesCount, ComponentTupleCallback emit_tuple_callback)
 {
 	// If no types to query, do nothing
@@ -77,27 +99,55 @@ void Helium::QueryComponentsInternal(ComponentManager &rManager, const Component
 
 		found_components[0].m_Component = outer_component;
 
-		ComponentCollection *collection = outer_component->GetComponentCollection();
-		HELIUM_ASSERT(collection);
+		EmitTuplesForComponent(outer_component, found_components, emit_tuple_callback);
+	}
+}
+
+bool Helium::QueryComponentsInternalTimeSliced(ComponentManager &rManager, const Components::TypeId *types, size_t typesCount, ComponentTupleCallback emit_tuple_callback, TaskTimeSlice &rSlice)
+{
+	// If no types to query, there's nothing left to do
+	if (!typesCount)
+	{
+		return true;
+	}
+	
+	std::vector<FoundComponentList> found_components;
+	found_components.resize(typesCount);
+	
+	for (size_t index = 0; index < typesCount; ++index)
+	{
+		found_components[index].m_TypeIndex = index;
+		found_components[index].m_TypeId = types[index];
+		found_components[index].m_Count = rManager.CountAllocatedComponentsThatImplement(types[index]);
 		
-		// Walk the other types we need components of
-		bool emit_tuples = true;
-		for (size_t type_index = 1; type_index < found_components.size(); ++type_index)
+		// Bail if any component type doesn't exist
+		if (!found_components[index].m_Count)
 		{
-			found_components[type_index].m_Component = collection->GetFirst( found_components[type_index].m_TypeId );
-			if ( !found_components[type_index].m_Component )
-			{
-				emit_tuples = false;
-				break;
-			}
+			return true;
 		}
-		
-		if (emit_tuples)
+	}
+
+	const DynamicArray< Components::TypeId > &implementing_types = Components::GetTypeData( found_components[0].m_TypeId )->m_ImplementingTypes;
+
+	ComponentIteratorBase iterator(rManager, implementing_types);
+	iterator.SeekTo( rSlice.m_CursorTypeIndex, static_cast< Components::ComponentIndex >( rSlice.m_CursorComponentIndex ) );
+
+	for ( ; iterator.GetBaseComponent(); iterator.Advance() )
+	{
+		if ( rSlice.IsExpired() )
 		{
-			DynamicArray<Component *> tuple;
-			tuple.Resize(typesCount);
-			tuple[found_components[0].m_TypeIndex] = outer_component;
-			EmitTuples(tuple, found_components, 1, emit_tuple_callback);
+			rSlice.m_CursorTypeIndex = iterator.GetTypeIndex();
+			rSlice.m_CursorComponentIndex = iterator.GetIndex();
+			return false;
 		}
+
+		Component *outer_component = iterator.GetBaseComponent();
+		found_components[0].m_Component = outer_component;
+
+		EmitTuplesForComponent(outer_component, found_components, emit_tuple_callback);
 	}
+
+	rSlice.m_CursorTypeIndex = 0;
+	rSlice.m_CursorComponentIndex = 0;
+	return true;
 }
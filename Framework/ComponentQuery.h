@@ -9,7 +9,14 @@ namespace Helium
 {
 	typedef void (*ComponentTupleCallback)(DynamicArray<Component *> &tuple);
 	
+	struct TaskTimeSlice;
+
 	void HELIUM_FRAMEWORK_API QueryComponentsInternal(ComponentManager &rManager, const Components::TypeId *types, size_t typesCount, ComponentTupleCallback callback);
+
+	// Unlike QueryComponentsInternal, iteration is always driven by the first type (so the cursor stored in the time
+	// slice stays meaningful between frames), so list the rarest type first. Returns true once the query has visited
+	// every component.
+	bool HELIUM_FRAMEWORK_API QueryComponentsInternalTimeSliced(ComponentManager &rManager, const Components::TypeId *types, size_t typesCount, ComponentTupleCallback callback, TaskTimeSlice &rSlice);
 	
 	template <class A, class B, void (*F)(A *, B *)>
 	void TupleHandler(DynamicArray<Component *> &components)
@@ -2,6 +2,7 @@
 #include "FrameworkPch.h"
 #include "Framework/Components.h"
 #include "Framework/SystemDefinition.h"
+#include "Framework/World.h"
 
 #include "Foundation/Numeric.h"
 #include "Reflect/TranslatorDeduction.h"
@@ -398,6 +399,56 @@ void Pool::Free( Component *component )
 	}
 }
 
+void Pool::CloneFrom( const Pool &rSource, const CloneContext &rContext )
+{
+	HELIUM_ASSERT( m_TypeId == rSource.m_TypeId );
+	HELIUM_ASSERT( m_Roster.GetSize() == rSource.m_Roster.GetSize() );
+	HELIUM_ASSERT( !m_FirstUnallocatedIndex );
+
+	// Take on the source roster order so that every component lands in the same slot it has in the source pool. That
+	// keeps the chain indices in the inline data valid and makes remapping a component an index lookup.
+	for (ComponentIndex rosterIndex = 0; rosterIndex < rSource.m_Roster.GetSize(); ++rosterIndex)
+	{
+		ComponentIndex index = rSource.GetComponentIndex( rSource.m_Roster[ rosterIndex ] );
+		m_Roster[ rosterIndex ] = GetComponent( index );
+		m_ParallelData[ index ].m_RosterIndex = rosterIndex;
+	}
+
+	m_FirstUnallocatedIndex = rSource.m_FirstUnallocatedIndex;
+
+	for (ComponentIndex rosterIndex = 0; rosterIndex < m_FirstUnallocatedIndex; ++rosterIndex)
+	{
+		const Component *pSourceComponent = rSource.m_Roster[ rosterIndex ];
+		Component *pComponent = m_Roster[ rosterIndex ];
+		ComponentIndex index = GetComponentIndex( pComponent );
+
+		// The copy constructor brings the source's bookkeeping along with it, so only the parts that are not relative
+		// to the pool need to be put right afterward
+		uint16_t offsetToPoolStart = pComponent->m_InlineData.m_OffsetToPoolStart;
+		m_Type->CopyConstruct( pComponent, pSourceComponent );
+		pComponent->m_InlineData.m_OffsetToPoolStart = offsetToPoolStart;
+		pComponent->m_InlineData.m_Owner = rContext.RemapOwner( pSourceComponent->m_InlineData.m_Owner );
+
+		m_ParallelData[ index ].m_Collection = rContext.RemapCollection( rSource.m_ParallelData[ index ].m_Collection );
+		HELIUM_ASSERT( m_ParallelData[ index ].m_Collection );
+	}
+}
+
+void Pool::FinalizeClone( const CloneContext &rContext, bool bWorldComponents )
+{
+	// OnCloned() may allocate or free components of this type, so only visit the ones that were cloned
+	IHasComponents *pWorld = m_World;
+	ComponentIndex clonedCount = m_FirstUnallocatedIndex;
+	for (ComponentIndex rosterIndex = 0; rosterIndex < clonedCount; ++rosterIndex)
+	{
+		Component *pComponent = m_Roster[ rosterIndex ];
+		if ( ( pComponent->m_InlineData.m_Owner == pWorld ) == bWorldComponents )
+		{
+			m_Type->FinalizeClone( pComponent, rContext );
+		}
+	}
+}
+
 #if HELIUM_TOOLS
 void Helium::Components::Pool::SpewRosterToTty()
 {
@@ -502,6 +553,171 @@ void Helium::ComponentManager::RegisterComponentPtr( ComponentPtrBase &pPtr )
 	g_ComponentPtrRegistry[registry_index] = &pPtr;
 }
 
+/// Check whether every component allocated by this manager can be copied into a cloned world.
+///
+/// @return  True if the world owning this manager can be cloned, false if any allocated component type opted out.
+///
+/// @see Component::IsCloneable()
+bool Helium::ComponentManager::IsCloneable() const
+{
+	bool bCloneable = true;
+
+	for (DynamicArray<Pool *>::ConstIterator iter = m_Pools.Begin();
+		iter != m_Pools.End(); ++iter)
+	{
+		const Pool *pPool = *iter;
+
+		if ( pPool && pPool->GetAllocatedCount() > 0 && !g_ComponentTypes[ pPool->GetTypeId() ]->IsCloneable() )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				TXT( "ComponentManager::IsCloneable(): %d components of type %s are allocated, and the type cannot be cloned.\n" ),
+				pPool->GetAllocatedCount(),
+				g_ComponentTypes[ pPool->GetTypeId() ]->m_Structure->m_Name);
+
+			bCloneable = false;
+		}
+	}
+
+	return bCloneable;
+}
+
+/// Copy every component allocated by another manager into this one, which must not have allocated anything yet.
+///
+/// All owners (the world and its entities) must already be registered with rContext.  Components are copy
+/// constructed in bulk, pool by pool, and only once all of them are in place is Component::OnCloned() called, so
+/// components are free to remap references to each other from there.  OnCloned() is called on every component owned
+/// by the world before any component owned by an entity.
+///
+/// @param[in] rSource   Manager to copy components from.
+/// @param[in] rContext  Mapping from source owners to their clones.
+///
+/// @see IsCloneable()
+void Helium::ComponentManager::CloneFrom( const ComponentManager &rSource, const Components::CloneContext &rContext )
+{
+	HELIUM_ASSERT( m_Pools.GetSize() == rSource.m_Pools.GetSize() );
+
+	for (size_t i = 0; i < m_Pools.GetSize(); ++i)
+	{
+		if ( m_Pools[ i ] )
+		{
+			HELIUM_ASSERT( rSource.m_Pools[ i ] );
+			m_Pools[ i ]->CloneFrom( *rSource.m_Pools[ i ], rContext );
+		}
+	}
+
+	// Point the cloned collections at the heads of the cloned component chains
+	for (Map< const ComponentCollection *, ComponentCollection * >::ConstIterator collectionIter = rContext.m_Collections.Begin();
+		collectionIter != rContext.m_Collections.End(); ++collectionIter)
+	{
+		const ComponentCollection *pSourceCollection = collectionIter->First();
+		ComponentCollection *pCollection = collectionIter->Second();
+		HELIUM_ASSERT( pCollection->m_Components.IsEmpty() );
+
+		for (Map< TypeId, Component * >::ConstIterator componentIter = pSourceCollection->m_Components.Begin();
+			componentIter != pSourceCollection->m_Components.End(); ++componentIter)
+		{
+			pCollection->m_Components.Insert( Map< TypeId, Component * >::ValueType(
+				componentIter->First(),
+				rContext.RemapComponent( componentIter->Second() ) ) );
+		}
+	}
+
+	// Components owned by the world (physics world, graphics scene, ...) get to rebuild their resources before the
+	// entity components that depend on them
+	for (DynamicArray<Pool *>::Iterator iter = m_Pools.Begin();
+		iter != m_Pools.End(); ++iter)
+	{
+		if ( *iter )
+		{
+			(*iter)->FinalizeClone( rContext, true );
+		}
+	}
+
+	for (DynamicArray<Pool *>::Iterator iter = m_Pools.Begin();
+		iter != m_Pools.End(); ++iter)
+	{
+		if ( *iter )
+		{
+			(*iter)->FinalizeClone( rContext, false );
+		}
+	}
+}
+
+Components::CloneContext::CloneContext( const ComponentManager &rSourceManager, ComponentManager &rDestinationManager )
+	: m_SourceManager( rSourceManager )
+	, m_DestinationManager( rDestinationManager )
+{
+
+}
+
+void Components::CloneContext::AddOwner( IHasComponents *pSourceOwner, IHasComponents *pDestinationOwner )
+{
+	HELIUM_ASSERT( pSourceOwner );
+	HELIUM_ASSERT( pDestinationOwner );
+
+	m_Owners.Insert( Map< IHasComponents *, IHasComponents * >::ValueType( pSourceOwner, pDestinationOwner ) );
+	m_Collections.Insert( Map< const ComponentCollection *, ComponentCollection * >::ValueType(
+		&pSourceOwner->VirtualGetComponents(),
+		&pDestinationOwner->VirtualGetComponents() ) );
+}
+
+IHasComponents* Components::CloneContext::RemapOwner( IHasComponents *pSourceOwner ) const
+{
+	if ( !pSourceOwner )
+	{
+		return NULL;
+	}
+
+	Map< IHasComponents *, IHasComponents * >::ConstIterator iter = m_Owners.Find( pSourceOwner );
+	HELIUM_ASSERT( iter != m_Owners.End() );
+	return iter != m_Owners.End() ? iter->Second() : NULL;
+}
+
+ComponentCollection* Components::CloneContext::RemapCollection( const ComponentCollection *pSourceCollection ) const
+{
+	if ( !pSourceCollection )
+	{
+		return NULL;
+	}
+
+	Map< const ComponentCollection *, ComponentCollection * >::ConstIterator iter = m_Collections.Find( pSourceCollection );
+	HELIUM_ASSERT( iter != m_Collections.End() );
+	return iter != m_Collections.End() ? iter->Second() : NULL;
+}
+
+Component* Components::CloneContext::RemapComponent( const Component *pSourceComponent ) const
+{
+	if ( !pSourceComponent )
+	{
+		return NULL;
+	}
+
+	const Pool *pSourcePool = Pool::GetPool( pSourceComponent );
+	HELIUM_ASSERT( pSourcePool->GetComponentManager() == &m_SourceManager );
+
+	const Pool *pPool = m_DestinationManager.GetPool( pSourcePool->GetTypeId() );
+	HELIUM_ASSERT( pPool );
+
+	return pPool->GetComponent( pSourcePool->GetComponentIndex( pSourceComponent ) );
+}
+
+const Component* Components::CloneContext::GetSourceComponent( const Component *pComponent ) const
+{
+	if ( !pComponent )
+	{
+		return NULL;
+	}
+
+	const Pool *pPool = Pool::GetPool( pComponent );
+	HELIUM_ASSERT( pPool->GetComponentManager() == &m_DestinationManager );
+
+	const Pool *pSourcePool = m_SourceManager.GetPool( pPool->GetTypeId() );
+	HELIUM_ASSERT( pSourcePool );
+
+	return pSourcePool->GetComponent( pPool->GetComponentIndex( pComponent ) );
+}
+
 size_t Helium::ComponentManager::CountAllocatedComponentsThatImplement( Components::TypeId typeId ) const
 {
 	TypeData *pTypeData = g_ComponentTypes[ typeId ];
@@ -91,6 +91,8 @@ namespace Helium
 		typedef uint16_t ComponentSizeType;
 		typedef uint8_t GenerationIndex;
 
+		struct CloneContext;
+
 		const static uint32_t COMPONENT_PTR_CHECK_FREQUENCY = 256;
 		const static uintptr_t POOL_ALIGN_SIZE = 32;
 		const static uintptr_t POOL_ALIGN_SIZE_MASK = ~(POOL_ALIGN_SIZE-1);
@@ -116,6 +118,10 @@ namespace Helium
 			virtual void       Destruct(Component *ptr) const = 0;
 			virtual uintptr_t  GetOffsetOfComponent() const = 0;
 
+			virtual bool       IsCloneable() const = 0;
+			virtual void       CopyConstruct(Component *ptr, const Component *source) const = 0;
+			virtual void       FinalizeClone(Component *ptr, const CloneContext &rContext) const = 0;
+
 			inline ComponentSizeType  GetSize() const;
 		};
 
@@ -125,6 +131,10 @@ namespace Helium
 			virtual void      Construct(Component *ptr) const;
 			virtual void      Destruct(Component *ptr) const;
 			virtual uintptr_t GetOffsetOfComponent() const;
+
+			virtual bool      IsCloneable() const;
+			virtual void      CopyConstruct(Component *ptr, const Component *source) const;
+			virtual void      FinalizeClone(Component *ptr, const CloneContext &rContext) const;
 		};
 
 		struct IHasComponents
@@ -202,6 +212,9 @@ namespace Helium
 			void                       InsertIntoChain(Component *_insertee, ComponentIndex _insertee_index, Component *nextComponent);
 			void                       RemoveFromChain(Component *_component, ComponentIndex index);
 
+			void                       CloneFrom(const Pool &rSource, const CloneContext &rContext);
+			void                       FinalizeClone(const CloneContext &rContext, bool bWorldComponents);
+
 #if HELIUM_TOOLS
 			void SpewRosterToTty();
 #endif
@@ -221,6 +234,30 @@ namespace Helium
 			ComponentIndex             m_FirstUnallocatedIndex;
 		};
 		
+		//! Maps the objects of a world being cloned to their counterparts in the clone (see World::InitializeAsCloneOf()).
+		//! Every component is cloned into the same pool slot it occupies in the source world, so remapping a component
+		//! is only an index lookup.
+		struct HELIUM_FRAMEWORK_API CloneContext
+		{
+			CloneContext( const ComponentManager &rSourceManager, ComponentManager &rDestinationManager );
+
+			void                       AddOwner( IHasComponents *pSourceOwner, IHasComponents *pDestinationOwner );
+
+			IHasComponents*            RemapOwner( IHasComponents *pSourceOwner ) const;
+			ComponentCollection*       RemapCollection( const ComponentCollection *pSourceCollection ) const;
+			Component*                 RemapComponent( const Component *pSourceComponent ) const;
+			const Component*           GetSourceComponent( const Component *pComponent ) const;
+
+			template <class T> T*      RemapOwner( T *pSourceOwner ) const;
+			template <class T> T*      Remap( const T *pSourceComponent ) const;
+			template <class T> const T* GetSource( const T *pComponent ) const;
+
+			const ComponentManager                             &m_SourceManager;
+			ComponentManager                                   &m_DestinationManager;
+			Map< IHasComponents *, IHasComponents * >          m_Owners;
+			Map< const ComponentCollection *, ComponentCollection * >  m_Collections;
+		};
+
 		HELIUM_FRAMEWORK_API void                Initialize( SystemDefinition *pSystemDefinition );
 		HELIUM_FRAMEWORK_API void                Cleanup();
 		HELIUM_FRAMEWORK_API void                Tick();
@@ -244,7 +281,7 @@ namespace Helium
 
 		void                     RegisterComponentPtr( ComponentPtrBase &pPtr );
 		inline World*            GetWorld() const;
-		inline const Components::Pool*  GetPool( Components::TypeId typeId );
+		inline const Components::Pool*  GetPool( Components::TypeId typeId ) const;
 
 		inline Component*        Allocate(Components::TypeId type, Components::IHasComponents *pOwner, ComponentCollection &rCollection);
 		inline size_t            CountAllocatedComponents( Components::TypeId typeId ) const;
@@ -254,6 +291,9 @@ namespace Helium
 		template < class T > size_t    CountAllocatedComponents();
 		template < class T > size_t    CountAllocatedComponentsThatImplement();
 
+		bool                     IsCloneable() const;
+		void                     CloneFrom( const ComponentManager &rSource, const Components::CloneContext &rContext );
+
 	private:
 		friend ComponentManager* Helium::Components::CreateManager( World *pWorld );
 		ComponentManager(World *pWorld);
@@ -272,6 +312,11 @@ namespace Helium
 		inline void       Advance();
 		inline void       ResetToBeginning();
 
+		// Position support so that iteration can be resumed later (i.e. by time-sliced tasks)
+		inline size_t                      GetTypeIndex() const;
+		inline Components::ComponentIndex  GetIndex() const;
+		inline void                        SeekTo( size_t typeIndex, Components::ComponentIndex index );
+
 	protected:
 		inline ComponentIteratorBase(ComponentManager &rManager);
 		const DynamicArray<Components::TypeId> *m_Types;
@@ -281,6 +326,7 @@ namespace Helium
 		inline void  SkipToNextType();
 
 		DynamicArray<Components::TypeId>::ConstIterator m_TypesIterator;
+		size_t m_TypeIndex;
 		ComponentManager &m_Manager;
 		const Components::Pool *m_pPool;
 		Component *m_pComponent;
@@ -336,6 +382,7 @@ namespace Helium
 
 	private:
 		friend Components::Pool;
+		friend ComponentManager;
 		Map< Components::TypeId, Component * > m_Components;
 	};
 
@@ -356,6 +403,21 @@ namespace Helium
 		inline const Components::DataInline& GetInlineData() const;
 
 		template <class T> T* AllocateSiblingComponent();
+
+		/// @name Cloning
+		/// Components are copy constructed when the world they live in is cloned. Like PopulateMetaType, these are
+		/// hidden (not overridden) by component types that need different behavior:
+		/// - Types owning something that can't be shared with the copy (physics bodies, render scene objects) must give
+		///   the copy its own from a copy constructor or OnCloned(), or return false from IsCloneable() so that worlds
+		///   containing them are refused. OnCloned() is called on components owned by the world (e.g. the physics world)
+		///   before those owned by entities, so entity components can rebuild themselves against the cloned world.
+		/// - Types holding raw or ComponentPtr references to other components or entities must repoint them from
+		///   OnCloned() using rContext, as the copies still refer to the source world.
+		/// - Custom copy constructors must copy construct Component so the pool bookkeeping comes along.
+		//@{
+		static bool IsCloneable() { return true; }
+		void OnCloned( const Components::CloneContext &rContext ) { }
+		//@}
 		
 		static Components::ComponentRegistrar<Component, void> s_ComponentRegistrar;
 
@@ -40,6 +40,43 @@ namespace Helium
 			return reinterpret_cast<uintptr_t>( c ) - 0x80000000;
 		}
 
+		template <class T>
+		bool TypeDataT<T>::IsCloneable() const
+		{
+			return T::IsCloneable();
+		}
+
+		template <class T>
+		void TypeDataT<T>::CopyConstruct( Component *ptr, const Component *source ) const
+		{
+			T* t = static_cast<T *>( ptr );
+			new (t) T( *static_cast<const T *>( source ) );
+		}
+
+		template <class T>
+		void TypeDataT<T>::FinalizeClone( Component *ptr, const CloneContext &rContext ) const
+		{
+			static_cast<T *>( ptr )->OnCloned( rContext );
+		}
+
+		template <class T>
+		T* CloneContext::RemapOwner( T *pSourceOwner ) const
+		{
+			return static_cast<T *>( RemapOwner( static_cast<IHasComponents *>( pSourceOwner ) ) );
+		}
+
+		template <class T>
+		T* CloneContext::Remap( const T *pSourceComponent ) const
+		{
+			return static_cast<T *>( RemapComponent( pSourceComponent ) );
+		}
+
+		template <class T>
+		const T* CloneContext::GetSource( const T *pComponent ) const
+		{
+			return static_cast<const T *>( GetSourceComponent( pComponent ) );
+		}
+
 		template< class ClassT, class BaseT >
 		ComponentRegistrar<ClassT, BaseT>::ComponentRegistrar( const char* name, uint16_t _count ) 
 			: Reflect::MetaStructRegistrar<ClassT, BaseT>(name)
@@ -218,6 +255,7 @@ namespace Helium
 		: m_Index( 0 )
 		, m_pPool( NULL )
 		, m_Types( NULL )
+		, m_TypeIndex( 0 )
 		, m_Manager( rManager )
 	{
 	}
@@ -226,6 +264,7 @@ namespace Helium
 		: m_Index( 0 )
 		, m_pPool( NULL )
 		, m_Types( &types )
+		, m_TypeIndex( 0 )
 		, m_Manager( rManager )
 	{
 		ResetToBeginning();
@@ -241,6 +280,7 @@ namespace Helium
 		HELIUM_ASSERT( !m_Types->IsEmpty() );
 
 		m_TypesIterator = m_Types->Begin();
+		m_TypeIndex = 0;
 		m_pPool = m_Manager.GetPool( *m_TypesIterator );
 		m_Index = 0;
 		
@@ -280,6 +320,7 @@ namespace Helium
 		m_pPool = NULL;
 		while ( !m_pPool || !m_pPool->GetAllocatedCount() )
 		{
+			++m_TypeIndex;
 			if ( ++m_TypesIterator == m_Types->End() )
 			{
 				m_pPool = NULL;
@@ -302,6 +343,43 @@ namespace Helium
 		}
 	}
 	
+	size_t ComponentIteratorBase::GetTypeIndex() const
+	{
+		return m_TypeIndex;
+	}
+
+	Components::ComponentIndex ComponentIteratorBase::GetIndex() const
+	{
+		return m_Index;
+	}
+
+	void ComponentIteratorBase::SeekTo( size_t typeIndex, Components::ComponentIndex index )
+	{
+		ResetToBeginning();
+
+		// Skip whole pools until we reach the one we want
+		while ( m_pComponent && m_TypeIndex < typeIndex )
+		{
+			SkipToNextType();
+		}
+
+		// If that pool has emptied out, we land at the start of the next non-empty one
+		if ( !m_pComponent || m_TypeIndex != typeIndex )
+		{
+			return;
+		}
+
+		if ( index < m_pPool->GetAllocatedCount() )
+		{
+			m_Index = index;
+			m_pComponent = m_pPool->GetAllocatedComponents()[ m_Index ];
+		}
+		else
+		{
+			SkipToNextType();
+		}
+	}
+
 	template <class T>
 	ComponentIteratorBaseT<T>::ComponentIteratorBaseT( ComponentManager &rManager ) 
 		: ComponentIteratorBase( rManager )
@@ -369,7 +447,7 @@ namespace Helium
 		return CountAllocatedComponents( Components::GetType<T>() );
 	}
 
-	const Components::Pool * Helium::ComponentManager::GetPool( Components::TypeId typeId )
+	const Components::Pool * Helium::ComponentManager::GetPool( Components::TypeId typeId ) const
 	{
 		return m_Pools[ typeId ];
 	}
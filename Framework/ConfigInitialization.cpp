@@ -3,6 +3,7 @@
 
 #include "Engine/Config.h"
 #include "Engine/AssetLoader.h"
+#include "Engine/CacheConfig.h"
 
 using namespace Helium;
 
@@ -31,5 +32,13 @@ bool ConfigInitialization::Initialize()
 
     HELIUM_TRACE( TraceLevels::Debug, TXT( "Configuration settings loaded.\n" ) );
 
+    // Caches opened before the configuration finished loading are updated in place.
+    StrongPtr< CacheConfig > spCacheConfig(
+        rConfig.GetConfigObject< CacheConfig >( Name( TXT( "CacheConfig" ) ) ) );
+    if( spCacheConfig )
+    {
+        spCacheConfig->ApplyCompressionPolicies();
+    }
+
     return true;
 }
@@ -61,6 +61,12 @@ void Entity::ClearSliceInfo()
 	SetInvalid( m_sliceIndex );
 }
 
+void Entity::CopyStateFrom( const Entity &rSource )
+{
+	m_DefinitionPath = rSource.m_DefinitionPath;
+	m_DeferredDestroy = rSource.m_DeferredDestroy;
+}
+
 ComponentCollection& Helium::Entity::VirtualGetComponents()
 {
 	return GetComponents();
@@ -58,6 +58,9 @@ namespace Helium
 
 		void DeferredDestroy() { m_DeferredDestroy = true; }
 		bool IsDeferredDestroySet() { return m_DeferredDestroy; }
+
+		// Copies everything but components and slice info (used when cloning worlds)
+		void CopyStateFrom( const Entity &rSource );
 		
 	private:
 		// Avoid using these vfuncs if you can! Use GetComponents() and GetWorld
@@ -1,6 +1,7 @@
 #include "FrameworkPch.h"
 #include "Framework/GameSystem.h"
 
+#include "Engine/AssetLoader.h"
 #include "Engine/AsyncLoader.h"
 #include "Engine/FileLocations.h"
 #include "Foundation/FilePath.h"
@@ -8,6 +9,7 @@
 #include "Platform/Timer.h"
 #include "Engine/Config.h"
 #include "Engine/CacheManager.h"
+#include "Engine/LoadProfiler.h"
 #include "Framework/CommandLineInitialization.h"
 #include "Framework/MemoryHeapPreInitialization.h"
 #include "Framework/AssetLoaderInitialization.h"
@@ -76,6 +78,23 @@ bool GameSystem::Initialize(
 	}
 #endif
 
+	// "-loadprofile [file]" profiles all asset loads, writing a report to the given file (or the trace output if no
+	// file is given) on shutdown.
+	for( size_t argumentIndex = 0; argumentIndex < m_arguments.GetSize(); ++argumentIndex )
+	{
+		if( m_arguments[ argumentIndex ] == TXT( "-loadprofile" ) )
+		{
+			HELIUM_VERIFY( LoadProfiler::InitializeStaticInstance() );
+
+			size_t fileNameIndex = argumentIndex + 1;
+			if( fileNameIndex < m_arguments.GetSize() && ( *m_arguments[ fileNameIndex ] )[ 0 ] != TXT( '-' ) )
+			{
+				m_loadProfileFileName = m_arguments[ fileNameIndex ];
+			}
+
+			break;
+		}
+	}
 
 	// Initialize the async loading thread.
 	bool bAsyncLoaderInitSuccess = AsyncLoader::GetStaticInstance().Initialize();
@@ -115,6 +134,22 @@ bool GameSystem::Initialize(
 
 	m_pAssetLoaderInitialization = &rAssetLoaderInitialization;
 
+	// "-recordmanifest <file>" records the loads performed while running, saving them on shutdown as a prefetch
+	// manifest that "-prefetch <file>" replays ahead of the loads on later runs.
+	for( size_t argumentIndex = 0; argumentIndex + 1 < m_arguments.GetSize(); ++argumentIndex )
+	{
+		const String& rArgument = m_arguments[ argumentIndex ];
+		if( rArgument == TXT( "-recordmanifest" ) )
+		{
+			m_recordManifestFileName = m_arguments[ argumentIndex + 1 ];
+			pAssetLoader->BeginRecordingManifest();
+		}
+		else if( rArgument == TXT( "-prefetch" ) )
+		{
+			pAssetLoader->BeginPrefetch( m_arguments[ argumentIndex + 1 ] );
+		}
+	}
+
 	// Initialize system configuration.
 	bool bConfigInitSuccess = rConfigInitialization.Initialize();
 	HELIUM_ASSERT( bConfigInitSuccess );
@@ -203,12 +238,40 @@ void GameSystem::Shutdown()
 
 	Config::DestroyStaticInstance();
 
+	AssetLoader* pAssetLoader = AssetLoader::GetStaticInstance();
+	if( pAssetLoader )
+	{
+		if( pAssetLoader->IsRecordingManifest() )
+		{
+			pAssetLoader->EndRecordingManifest( m_recordManifestFileName );
+		}
+
+		// Prefetching normally ends on its own once the manifest has been replayed, unless we are shutting down first.
+		pAssetLoader->EndPrefetch();
+	}
+
+	LoadProfiler* pLoadProfiler = LoadProfiler::GetStaticInstance();
+	if( pLoadProfiler )
+	{
+		if( m_loadProfileFileName.IsEmpty() )
+		{
+			pLoadProfiler->TraceReport();
+		}
+		else
+		{
+			pLoadProfiler->SaveReport( m_loadProfileFileName );
+		}
+	}
+
 	if( m_pAssetLoaderInitialization )
 	{
 		m_pAssetLoaderInitialization->Shutdown();
 		m_pAssetLoaderInitialization = NULL;
 	}
 
+	// Loads still in flight during asset loader shutdown report to the profiler, so it has to outlive the loader.
+	LoadProfiler::DestroyStaticInstance();
+
 	Reflect::Cleanup();
 	AssetType::Shutdown();
 	Asset::Shutdown();
@@ -64,6 +64,10 @@ namespace Helium
 		SystemDefinitionPtr          m_spSystemDefinition;
 		AssetAwareThreadSynchronizer m_AssetSyncUtility;
 		TaskSchedule                 m_Schedule;
+		/// Load profile report file name (empty to write the report to the trace output).
+		String                       m_loadProfileFileName;
+		/// Prefetch manifest file name to save the loads recorded while running to (empty if not recording).
+		String                       m_recordManifestFileName;
 		bool                         m_bStopRunning;
 	};
 }
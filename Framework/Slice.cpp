@@ -117,6 +117,34 @@ bool Slice::DestroyEntity( Entity* pEntity )
 }
 
 
+/// Create a copy of each entity in another slice, without any components, and register it with rContext so that
+/// components owned by the source entity can be cloned onto the copy.
+///
+/// @param[in] rSource   Slice whose entities should be copied.
+/// @param[in] rContext  Clone context to register the entity copies with.
+///
+/// @see World::InitializeAsCloneOf()
+void Slice::CloneEntitiesFrom( const Slice &rSource, Components::CloneContext &rContext )
+{
+    m_entities.Reserve( m_entities.GetSize() + rSource.m_entities.GetSize() );
+
+    for( size_t entityIndex = 0; entityIndex < rSource.m_entities.GetSize(); ++entityIndex )
+    {
+        Entity* pSourceEntity = rSource.m_entities[ entityIndex ];
+        HELIUM_ASSERT( pSourceEntity );
+
+        EntityPtr spEntity = Reflect::AssertCast<Entity>( Entity::CreateObject() );
+        HELIUM_ASSERT( spEntity );
+        spEntity->CopyStateFrom( *pSourceEntity );
+
+        size_t sliceIndex = m_entities.Push( spEntity );
+        HELIUM_ASSERT( IsValid( sliceIndex ) );
+        spEntity->SetSliceInfo( this, sliceIndex );
+
+        rContext.AddOwner( pSourceEntity, spEntity );
+    }
+}
+
 /// Set the world to which this slice is currently bound, along with the index of this slice within the world.
 ///
 /// @param[in] pWorld      World to set.
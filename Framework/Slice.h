@@ -9,6 +9,11 @@ namespace Helium
 {
     class EntityDefinition;
 
+    namespace Components
+    {
+        struct CloneContext;
+    }
+
     class World;
     typedef Helium::WeakPtr< World > WorldWPtr;
     typedef Helium::WeakPtr< const World > ConstWorldWPtr;
@@ -40,6 +45,8 @@ namespace Helium
         //@{
 		virtual Helium::Entity* CreateEntity(EntityDefinition *pEntityDefinition, ParameterSet *pParameterSet = NULL);
         virtual bool DestroyEntity( Entity* pEntity );
+
+        void CloneEntitiesFrom( const Slice &rSource, Components::CloneContext &rContext );
         //@}
 
         /// @name EntityDefinition Access
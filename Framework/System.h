@@ -24,6 +24,9 @@ namespace Helium
 
 		virtual void StopRunning() = 0;
 
+		/// Command-line arguments (not including the module name).
+		const DynamicArray< String >& GetArguments() const { return m_arguments; }
+
 	protected:
 		/// Module file name.
 		String m_moduleName;
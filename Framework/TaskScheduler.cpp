@@ -2,12 +2,51 @@
 #include "FrameworkPch.h"
 #include "TaskScheduler.h"
 #include "Foundation/Map.h"
+#include "Platform/Timer.h"
 
 using namespace Helium;
 
+// How many IsExpired() calls go by between reads of the timer
+static const uint32_t TIME_SLICE_CHECK_FREQUENCY = 16;
+
+// A time-sliced task is never squeezed below this fraction of its nominal budget, so it always makes some progress
+static const uint32_t TIME_SLICE_MINIMUM_DIVISOR = 8;
 
 TaskDefinition *TaskDefinition::s_FirstTaskDefinition = NULL;
 bool TaskScheduler::m_ContractsDefined = false;
+uint32_t TaskScheduler::s_FrameBudgetMicroseconds = 0;
+uint64_t TaskScheduler::s_AverageFixedTaskTicks = 0;
+TaskTimeSlice *TaskScheduler::s_pCurrentTimeSlice = NULL;
+
+static inline uint64_t MicrosecondsToTicks( uint64_t microseconds )
+{
+	return ( microseconds * Timer::GetTicksPerSecond() ) / 1000000;
+}
+
+static inline uint64_t TicksToMicroseconds( uint64_t ticks )
+{
+	return static_cast< uint64_t >( static_cast< float64_t >( ticks ) * Timer::GetSecondsPerTick() * 1000000.0 );
+}
+
+bool TaskTimeSlice::IsExpired()
+{
+	if ( m_CheckCountdown )
+	{
+		--m_CheckCountdown;
+		return false;
+	}
+
+	m_CheckCountdown = TIME_SLICE_CHECK_FREQUENCY - 1;
+	return Timer::GetTickCount() >= m_DeadlineTickCount;
+}
+
+void TaskTimeSlice::ResetCursor()
+{
+	m_CursorWorld = NULL;
+	m_CursorWorldIndex = 0;
+	m_CursorTypeIndex = 0;
+	m_CursorComponentIndex = 0;
+}
 
 bool InsertToTaskList(A_TaskDefinitionPtr &rTaskInfoList, DynamicArray<TaskFunc> &rTaskFuncList, A_TaskDefinitionPtr &rTaskStack, const TaskDefinition *pTask, uint32_t tickType);
 
@@ -282,12 +321,115 @@ bool InsertToTaskList(A_TaskDefinitionPtr &rTaskInfoList, DynamicArray<TaskFunc>
 
 void TaskScheduler::ExecuteSchedule( const TaskSchedule &schedule, DynamicArray< WorldPtr > &rWorlds )
 {
-	int i = 0;
-	for (DynamicArray<TaskFunc>::ConstIterator iter = schedule.m_ScheduleFunc.Begin(); iter != schedule.m_ScheduleFunc.End(); ++iter)
+	const size_t taskCount = schedule.m_ScheduleFunc.GetSize();
+
+	size_t timeSlicedTasksRemaining = 0;
+	for (size_t i = 0; i < taskCount; ++i)
+	{
+		if (schedule.m_ScheduleInfo[i]->m_Contract.IsTimeSliced())
+		{
+			++timeSlicedTasksRemaining;
+		}
+	}
+
+	// Nothing to budget, so don't bother timing anything
+	if (!timeSlicedTasksRemaining)
+	{
+		for (size_t i = 0; i < taskCount; ++i)
+		{
+			schedule.m_ScheduleFunc[i]( rWorlds );
+			HELIUM_ASSERT(schedule.m_ScheduleInfo[i]->m_Func == schedule.m_ScheduleFunc[i]);
+		}
+
+		return;
+	}
+
+	const uint64_t frameStartTickCount = Timer::GetTickCount();
+	uint64_t fixedTicks = 0;
+
+	for (size_t i = 0; i < taskCount; ++i)
+	{
+		const TaskDefinition *pTask = schedule.m_ScheduleInfo[i];
+		HELIUM_ASSERT(pTask->m_Func == schedule.m_ScheduleFunc[i]);
+
+		const uint64_t taskStartTickCount = Timer::GetTickCount();
+
+		if (!pTask->m_Contract.IsTimeSliced())
+		{
+			schedule.m_ScheduleFunc[i]( rWorlds );
+			fixedTicks += Timer::GetTickCount() - taskStartTickCount;
+			continue;
+		}
+
+		// Leave room for the run-to-completion tasks that are still to come this frame
+		uint64_t fixedTicksRemaining = ( s_AverageFixedTaskTicks > fixedTicks ) ? ( s_AverageFixedTaskTicks - fixedTicks ) : 0;
+
+		TaskTimeSlice &rSlice = pTask->m_TimeSlice;
+		rSlice.m_GrantedMicroseconds = CalculateTimeSliceGrant( *pTask, frameStartTickCount, fixedTicksRemaining, timeSlicedTasksRemaining );
+		rSlice.m_DeadlineTickCount = taskStartTickCount + MicrosecondsToTicks( rSlice.m_GrantedMicroseconds );
+		rSlice.m_CheckCountdown = 0;
+
+		s_pCurrentTimeSlice = &rSlice;
+		schedule.m_ScheduleFunc[i]( rWorlds );
+		s_pCurrentTimeSlice = NULL;
+
+		rSlice.m_UsedMicroseconds = static_cast< uint32_t >( TicksToMicroseconds( Timer::GetTickCount() - taskStartTickCount ) );
+		--timeSlicedTasksRemaining;
+	}
+
+	// Smooth out the cost of the run-to-completion tasks so one spike doesn't starve the time-sliced tasks next frame
+	s_AverageFixedTaskTicks = ( s_AverageFixedTaskTicks * 7 + fixedTicks ) / 8;
+}
+
+uint32_t TaskScheduler::CalculateTimeSliceGrant( const TaskDefinition &rTask, uint64_t frameStartTickCount, uint64_t fixedTicksRemaining, size_t timeSlicedTasksRemaining )
+{
+	HELIUM_ASSERT( timeSlicedTasksRemaining > 0 );
+
+	const uint32_t nominalMicroseconds = rTask.m_Contract.m_TimeSliceBudgetMicroseconds;
+	if ( !s_FrameBudgetMicroseconds )
+	{
+		return nominalMicroseconds;
+	}
+
+	// Split whatever is left of the frame evenly between the time-sliced tasks that have yet to run
+	const uint64_t frameBudgetTicks = MicrosecondsToTicks( s_FrameBudgetMicroseconds );
+	const uint64_t committedTicks = ( Timer::GetTickCount() - frameStartTickCount ) + fixedTicksRemaining;
+	const uint64_t availableTicks = ( frameBudgetTicks > committedTicks ) ? ( frameBudgetTicks - committedTicks ) : 0;
+	const uint64_t shareMicroseconds = TicksToMicroseconds( availableTicks / timeSlicedTasksRemaining );
+
+	uint32_t minimumMicroseconds = nominalMicroseconds / TIME_SLICE_MINIMUM_DIVISOR;
+	if ( !minimumMicroseconds )
 	{
-		(*iter)( rWorlds );
-		HELIUM_ASSERT(schedule.m_ScheduleInfo[i++]->m_Func == *iter);
+		minimumMicroseconds = 1;
 	}
+
+	if ( shareMicroseconds < minimumMicroseconds )
+	{
+		return minimumMicroseconds;
+	}
+
+	if ( shareMicroseconds > nominalMicroseconds )
+	{
+		return nominalMicroseconds;
+	}
+
+	return static_cast< uint32_t >( shareMicroseconds );
+}
+
+void TaskScheduler::SetFrameBudget( uint32_t microseconds )
+{
+	s_FrameBudgetMicroseconds = microseconds;
+}
+
+uint32_t TaskScheduler::GetFrameBudget()
+{
+	return s_FrameBudgetMicroseconds;
+}
+
+TaskTimeSlice &TaskScheduler::GetCurrentTimeSlice()
+{
+	HELIUM_ASSERT( s_pCurrentTimeSlice );
+	return *s_pCurrentTimeSlice;
 }
 
 void Helium::TaskScheduler::ResetContracts()
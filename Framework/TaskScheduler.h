@@ -19,6 +19,19 @@
 		m_Contract.SetTickType( __TickType );               \
 	}
 
+// Time-sliced tasks do not need to finish every frame. They are granted a microsecond budget each frame (which the
+// scheduler may shrink when the frame is running long) and are expected to stop once it expires, resuming from the
+// cursor stored in their TaskTimeSlice on the next frame. Use ForEachWorldTimeSliced and QueryComponentsTimeSliced
+// to get this behavior for free.
+#define HELIUM_DEFINE_TIME_SLICED_TASK(__Type, __Function, __TickType, __BudgetMicroseconds) \
+	__Type __Type::m_This;                                  \
+	__Type::__Type()                                        \
+		: TaskDefinition(m_This, __Function, #__Type) \
+	{                                                       \
+		m_Contract.SetTickType( __TickType );               \
+		m_Contract.SetTimeSliceBudget( __BudgetMicroseconds ); \
+	}
+
 // Abstract tasks are used when you want a conceptual thing like "render" to be a dependency that other tasks
 // can say they go before, after, or fulfill. This allows us to generally define a few high-level stages and 
 // let client code non-intrusively hook their logic to run within these stages, or even
@@ -78,6 +91,7 @@ namespace Helium
 	{
 		TaskContract()
 			: m_TickType( TickTypes::Never )
+			, m_TimeSliceBudgetMicroseconds( 0 )
 		{
 
 		}
@@ -126,6 +140,17 @@ namespace Helium
 			m_TickType = tickType;
 		}
 
+		// Zero means run to completion every frame
+		void SetTimeSliceBudget(uint32_t microseconds)
+		{
+			m_TimeSliceBudgetMicroseconds = microseconds;
+		}
+
+		bool IsTimeSliced() const
+		{
+			return m_TimeSliceBudgetMicroseconds != 0;
+		}
+
 		// Every requirement to be before or after another dependency goes here
 		DynamicArray<OrderRequirement> m_OrderRequirements;
 
@@ -133,9 +158,58 @@ namespace Helium
 		DynamicArray<const TaskDefinition *> m_ContributedDependencies;
 
 		TickType m_TickType;
+
+		// Nominal per-frame budget for time-sliced tasks
+		uint32_t m_TimeSliceBudgetMicroseconds;
 	};
 
 	class World;
+
+	// Per-task state for time-sliced tasks. The cursor persists between frames so that work interrupted by an expired
+	// budget picks up where it left off.
+	struct HELIUM_FRAMEWORK_API TaskTimeSlice
+	{
+		TaskTimeSlice()
+			: m_DeadlineTickCount( 0 )
+			, m_GrantedMicroseconds( 0 )
+			, m_UsedMicroseconds( 0 )
+			, m_CompletedPasses( 0 )
+			, m_CursorWorld( NULL )
+			, m_CursorWorldIndex( 0 )
+			, m_CursorTypeIndex( 0 )
+			, m_CursorComponentIndex( 0 )
+			, m_CheckCountdown( 0 )
+		{
+
+		}
+
+		// True once the budget granted for this frame has been spent. Only reads the timer every few calls, so it is
+		// cheap enough to call once per component.
+		bool IsExpired();
+
+		// Forget where we were (i.e. the population changed in a way that invalidates the cursor)
+		void ResetCursor();
+
+		// Timer tick count at which this frame's budget runs out
+		uint64_t m_DeadlineTickCount;
+
+		// Budget granted for the current frame, and how much of it was actually used
+		uint32_t m_GrantedMicroseconds;
+		uint32_t m_UsedMicroseconds;
+
+		// Number of times the task has made it all the way through its population
+		uint32_t m_CompletedPasses;
+
+		// Position within the component population of the world being processed
+		const World *m_CursorWorld;
+		size_t m_CursorWorldIndex;
+		size_t m_CursorTypeIndex;
+		size_t m_CursorComponentIndex;
+
+		uint32_t m_CheckCountdown;
+	};
+
+
 	typedef Helium::StrongPtr< World > WorldPtr;
 	typedef void (*TaskFunc)( DynamicArray< WorldPtr > & );
 
@@ -174,6 +248,10 @@ namespace Helium
 
 		// The callback that will execute this task
 		TaskFunc m_Func;
+
+		// Only used if the contract specifies a time slice budget. The scheduler updates this while executing the
+		// (const) schedule, hence mutable.
+		mutable TaskTimeSlice m_TimeSlice;
 		
 		const TaskDefinition &m_DependencyReverseLookup;
 
@@ -197,7 +275,22 @@ namespace Helium
 
 		static void ResetContracts();
 
+		// Total time the frame is allowed to spend in tasks. When set, time-sliced tasks have their budgets reduced
+		// to whatever is left over after the tasks that must run to completion. Zero disables adaptation.
+		static void SetFrameBudget( uint32_t microseconds );
+		static uint32_t GetFrameBudget();
+
+		// Valid only while a time-sliced task is executing
+		static TaskTimeSlice &GetCurrentTimeSlice();
+
 		static bool m_ContractsDefined;
+
+	private:
+		static uint32_t CalculateTimeSliceGrant( const TaskDefinition &rTask, uint64_t frameStartTickCount, uint64_t fixedTicksRemaining, size_t timeSlicedTasksRemaining );
+
+		static uint32_t s_FrameBudgetMicroseconds;
+		static uint64_t s_AverageFixedTaskTicks;
+		static TaskTimeSlice *s_pCurrentTimeSlice;
 	};
 
 	namespace StandardDependencies
@@ -248,4 +341,53 @@ namespace Helium
 			Fn( iter->Get() );
 		}
 	}
+
+	// Runs Fn on each world until the current time slice expires. Fn returns true once it has finished with a world,
+	// after which the next world is started. At most one full pass is made per frame.
+	template < bool (*Fn)(World *, TaskTimeSlice &) >
+	void ForEachWorldTimeSliced(DynamicArray< WorldPtr > &rWorlds)
+	{
+		TaskTimeSlice &rSlice = TaskScheduler::GetCurrentTimeSlice();
+
+		const size_t worldCount = rWorlds.GetSize();
+		if ( !worldCount )
+		{
+			rSlice.ResetCursor();
+			return;
+		}
+
+		if ( rSlice.m_CursorWorldIndex >= worldCount )
+		{
+			rSlice.ResetCursor();
+		}
+
+		while ( !rSlice.IsExpired() )
+		{
+
+			World *pWorld = rWorlds[ rSlice.m_CursorWorldIndex ].Get();
+			if ( rSlice.m_CursorWorld != pWorld )
+			{
+				// Worlds were added or removed since we last ran, so the component cursor means nothing here
+				rSlice.m_CursorWorld = pWorld;
+				rSlice.m_CursorTypeIndex = 0;
+				rSlice.m_CursorComponentIndex = 0;
+			}
+
+			if ( !Fn( pWorld, rSlice ) )
+			{
+				return;
+			}
+
+			++rSlice.m_CursorWorldIndex;
+			rSlice.m_CursorWorld = NULL;
+
+			if ( rSlice.m_CursorWorldIndex >= worldCount )
+			{
+				// Never process the same components twice in one frame
+				rSlice.ResetCursor();
+				++rSlice.m_CompletedPasses;
+				return;
+			}
+		}
+	}
 }
@@ -55,6 +55,64 @@ bool World::Initialize()
 	return true;
 }
 
+/// Initialize this world instance as a copy of another, live world.
+///
+/// Slices and entities are recreated directly and every component is copy constructed pool by pool (see
+/// ComponentManager::CloneFrom()), so no definitions are touched and nothing is redeployed.  This makes starting a
+/// play session or instancing a match from an already loaded world cheap.  The clone is entirely independent of the
+/// source afterward and is torn down like any other world.
+///
+/// @param[in] rSource  World to copy.
+///
+/// @return  True if the world was cloned successfully, false if not (i.e. the source contains component types that
+///          cannot be cloned).
+///
+/// @see Initialize(), Component::IsCloneable()
+bool World::InitializeAsCloneOf( World &rSource )
+{
+	ComponentManager *pSourceComponentManager = rSource.GetComponentManager();
+	HELIUM_ASSERT( pSourceComponentManager );
+	if( !pSourceComponentManager->IsCloneable() )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "World::InitializeAsCloneOf(): Source world contains components that cannot be cloned.\n" ) );
+
+		return false;
+	}
+
+	if( !Initialize() )
+	{
+		return false;
+	}
+
+	Components::CloneContext context( *pSourceComponentManager, *GetComponentManager() );
+	context.AddOwner( &rSource, this );
+
+	for( size_t sliceIndex = 0; sliceIndex < rSource.GetSliceCount(); ++sliceIndex )
+	{
+		Slice *pSourceSlice = rSource.GetSlice( sliceIndex );
+		HELIUM_ASSERT( pSourceSlice );
+
+		SlicePtr spSlice;
+		if( pSourceSlice == rSource.GetRootSlice() )
+		{
+			spSlice = m_RootSlice;
+		}
+		else
+		{
+			spSlice = Reflect::AssertCast<Slice>( Slice::CreateObject() );
+			HELIUM_ASSERT( spSlice );
+			spSlice->Initialize( pSourceSlice->GetSceneDefinition() );
+			HELIUM_VERIFY( AddSlice( spSlice ) );
+		}
+
+		spSlice->CloneEntitiesFrom( *pSourceSlice, context );
+	}
+
+	m_ComponentManager->CloneFrom( *pSourceComponentManager, context );
+
+	return true;
+}
+
 /// Shut down this world instance.
 ///
 /// @see Initialize()
@@ -2,6 +2,7 @@
 
 #include "Framework/ComponentQuery.h"
 #include "Framework/Framework.h"
+#include "Framework/TaskScheduler.h"
 
 namespace Helium
 {
@@ -31,6 +32,8 @@ namespace Helium
 		//@{
 		virtual bool Initialize();
 		virtual void Shutdown();
+
+		bool InitializeAsCloneOf( World &rSource );
 		//@}
 		
 		/// @name Component API
@@ -119,6 +122,61 @@ namespace Helium
 		HELIUM_ASSERT( pComponentManager );
 		QueryComponentsInternal( *pComponentManager, types, HELIUM_ARRAY_COUNT(types), TupleHandler<A, B, C, F> );
 	}
+
+	// Time-sliced flavors of QueryComponents for use with ForEachWorldTimeSliced. They resume from the cursor stored in
+	// rSlice and return false if the slice expired before every component was visited.
+	template <class A, void (*F)(A *)>
+	inline bool QueryComponentsTimeSliced( World *pWorld, TaskTimeSlice &rSlice )
+	{
+		ComponentManager *pComponentManager = pWorld->GetComponentManager();
+		HELIUM_ASSERT( pComponentManager );
+
+		ImplementingComponentIterator<A> iter( *pComponentManager );
+		iter.SeekTo( rSlice.m_CursorTypeIndex, static_cast< Components::ComponentIndex >( rSlice.m_CursorComponentIndex ) );
+
+		for ( ; iter.GetBaseComponent(); iter.Advance() )
+		{
+			if ( rSlice.IsExpired() )
+			{
+				rSlice.m_CursorTypeIndex = iter.GetTypeIndex();
+				rSlice.m_CursorComponentIndex = iter.GetIndex();
+				return false;
+			}
+
+			F( *iter );
+		}
+
+		rSlice.m_CursorTypeIndex = 0;
+		rSlice.m_CursorComponentIndex = 0;
+		return true;
+	}
+
+	template <class A, class B, void (*F)(A *, B *)>
+	inline bool QueryComponentsTimeSliced( World *pWorld, TaskTimeSlice &rSlice )
+	{
+		static Components::TypeId types[] = {
+			Components::GetType<A>(),
+			Components::GetType<B>()
+		};
+
+		ComponentManager *pComponentManager = pWorld->GetComponentManager();
+		HELIUM_ASSERT( pComponentManager );
+		return QueryComponentsInternalTimeSliced( *pComponentManager, types, HELIUM_ARRAY_COUNT(types), TupleHandler<A, B, F>, rSlice );
+	}
+	
+	template <class A, class B, class C, void (*F)(A *, B *, C *)>
+	inline bool QueryComponentsTimeSliced( World *pWorld, TaskTimeSlice &rSlice )
+	{
+		static Components::TypeId types[] = {
+			Components::GetType<A>(),
+			Components::GetType<B>(),
+			Components::GetType<C>()
+		};
+
+		ComponentManager *pComponentManager = pWorld->GetComponentManager();
+		HELIUM_ASSERT( pComponentManager );
+		return QueryComponentsInternalTimeSliced( *pComponentManager, types, HELIUM_ARRAY_COUNT(types), TupleHandler<A, B, C, F>, rSlice );
+	}
 }
 
 #include "Framework/World.inl"
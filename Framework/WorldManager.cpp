@@ -18,6 +18,8 @@ WorldManager::WorldManager()
 , m_frameTickCount( 0 )
 , m_frameDeltaTickCount( 0 )
 , m_frameDeltaSeconds( 0.0f )
+, m_frameIndex( 0 )
+, m_fixedFrameDeltaTickCount( 0 )
 , m_bProcessedFirstFrame( false )
 {
 }
@@ -62,6 +64,7 @@ bool WorldManager::Initialize()
 	m_frameTickCount = 0;
 	m_frameDeltaTickCount = 0;
 	m_frameDeltaSeconds = 0.0f;
+	m_frameIndex = 0;
 
 	// First frame still needs to be processed.
 	m_bProcessedFirstFrame = false;
@@ -155,6 +158,32 @@ Helium::World* WorldManager::CreateWorld( SceneDefinition* pSceneDefinition )
 	return spWorld;
 }
 
+/// Create a new World instance as a copy of an existing one.
+///
+/// This is much faster than creating a world from its SceneDefinition, as nothing is redeployed from definitions.
+///
+/// @param[in] pSourceWorld  World to copy.
+///
+/// @return  Newly created world instance, or null if the world could not be cloned.
+///
+/// @see World::InitializeAsCloneOf()
+Helium::World* WorldManager::CloneWorld( World* pSourceWorld )
+{
+	HELIUM_ASSERT( pSourceWorld );
+
+	WorldPtr spWorld( new World() );
+	if ( !spWorld->InitializeAsCloneOf( *pSourceWorld ) )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "WorldManager::CloneWorld(): Failed to clone world.\n" ) );
+
+		return NULL;
+	}
+
+	m_worlds.Push( spWorld );
+
+	return spWorld;
+}
+
 /// Release a managed World instance.
 ///
 /// @param[in] pWorld  World to release.
@@ -258,8 +287,12 @@ void WorldManager::UpdateTime()
 	uint64_t deltaTickCount = newFrameTickCount - m_actualFrameTickCount;
 	m_actualFrameTickCount = newFrameTickCount;
 
-	// Clamp the timer delta based on the timer limit settings.
-	if( deltaTickCount == 0 )
+	// Clamp the timer delta based on the timer limit settings, or ignore it entirely if running at a fixed rate.
+	if( m_fixedFrameDeltaTickCount != 0 )
+	{
+		deltaTickCount = m_fixedFrameDeltaTickCount;
+	}
+	else if( deltaTickCount == 0 )
 	{
 		deltaTickCount = 1;
 	}
@@ -274,6 +307,7 @@ void WorldManager::UpdateTime()
 	}
 
 	// Update the clamped time values.
+	++m_frameIndex;
 	m_frameTickCount += deltaTickCount;
 	m_frameDeltaTickCount = deltaTickCount;
 	m_frameDeltaSeconds =
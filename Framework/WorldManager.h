@@ -27,6 +27,7 @@ namespace Helium
         /// @name World Creation and Destruction
         //@{
         World* CreateWorld( SceneDefinition* pSceneDefinition );
+        World* CloneWorld( World* pSourceWorld );
         bool ReleaseWorld( World* pWorld );
 
         AssetPath GetRootSceneDefinitionPackagePath() const;
@@ -43,6 +44,10 @@ namespace Helium
         inline uint64_t GetFrameTickCount() const;
         inline uint64_t GetFrameDeltaTickCount() const;
         inline float32_t GetFrameDeltaSeconds() const;
+        inline uint32_t GetFrameIndex() const;
+
+        inline void SetFixedFrameDeltaTickCount( uint64_t deltaTickCount );
+        inline uint64_t GetFixedFrameDeltaTickCount() const;
         //@}
 
         /// @name Static Access
@@ -65,6 +70,10 @@ namespace Helium
         uint64_t m_frameDeltaTickCount;
         /// Seconds elapsed since the previous frame (adjusted for frame rate limits).
         float32_t m_frameDeltaSeconds;
+        /// Number of frames processed so far.
+        uint32_t m_frameIndex;
+        /// Ticks to advance each frame instead of the actual elapsed time (zero to use the actual time).
+        uint64_t m_fixedFrameDeltaTickCount;
 
         /// True if the first frame has been processed.
         bool m_bProcessedFirstFrame;
@@ -35,4 +35,37 @@ namespace Helium
     {
         return m_frameDeltaSeconds;
     }
-}
\ No newline at end of file
+
+    /// Get the number of frames that have been processed, for work that runs every Nth frame.
+    ///
+    /// @return  Index of the current frame.
+    ///
+    /// @see GetFrameTickCount()
+    uint32_t WorldManager::GetFrameIndex() const
+    {
+        return m_frameIndex;
+    }
+
+    /// Run the world timer at a fixed rate, advancing by the same number of ticks every frame regardless of how much
+    /// time actually elapsed.  This is used for reproducible runs (i.e. input replays and benchmarks).
+    ///
+    /// The first frame processed still reports a delta of zero.
+    ///
+    /// @param[in] deltaTickCount  Ticks to advance each frame, or zero to go back to using the actual elapsed time.
+    ///
+    /// @see GetFixedFrameDeltaTickCount(), GetFrameDeltaTickCount()
+    void WorldManager::SetFixedFrameDeltaTickCount( uint64_t deltaTickCount )
+    {
+        m_fixedFrameDeltaTickCount = deltaTickCount;
+    }
+
+    /// Get the number of ticks the world timer is advanced each frame when running at a fixed rate.
+    ///
+    /// @return  Ticks advanced each frame, or zero if the actual elapsed time is used.
+    ///
+    /// @see SetFixedFrameDeltaTickCount()
+    uint64_t WorldManager::GetFixedFrameDeltaTickCount() const
+    {
+        return m_fixedFrameDeltaTickCount;
+    }
+}
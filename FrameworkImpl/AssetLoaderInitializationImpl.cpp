@@ -4,9 +4,12 @@
 #if HELIUM_TOOLS
 # include "PcSupport/LooseAssetLoader.h"
 # include "PcSupport/AssetPreprocessor.h"
+# include "PcSupport/DerivedDataCache.h"
+# include "Engine/FileLocations.h"
 # include "PreprocessingPc/PcPreprocessor.h"
 #else
 # include "Engine/CacheAssetLoader.h"
+# include "Framework/System.h"
 #endif
 
 using namespace Helium;
@@ -15,7 +18,14 @@ using namespace Helium;
 AssetLoader* AssetLoaderInitializationImpl::Initialize()
 {
 #if HELIUM_TOOLS
-    if( !LooseAssetLoader::InitializeStaticInstance() )
+    // Reload assets as they are edited.  Only Linux does so by default, as inotify makes watching free while nothing
+    // changes, whereas other platforms would have to poll the package directories.
+#if HELIUM_OS_LINUX
+    const bool bWatchFiles = true;
+#else
+    const bool bWatchFiles = false;
+#endif
+    if( !LooseAssetLoader::InitializeStaticInstance( bWatchFiles ) )
     {
         HELIUM_TRACE(
             TraceLevels::Error,
@@ -29,8 +39,35 @@ AssetLoader* AssetLoaderInitializationImpl::Initialize()
     PlatformPreprocessor* pPlatformPreprocessor = new PcPreprocessor;
     HELIUM_ASSERT( pPlatformPreprocessor );
     pAssetPreprocessor->SetPlatformPreprocessor( Cache::PLATFORM_PC, pPlatformPreprocessor );
+
+    // Reuse preprocessed resource data across branches and cache files through a shared local derived data cache.
+    FilePath derivedDataPath;
+    if( FileLocations::GetUserDataDirectory( derivedDataPath ) )
+    {
+        derivedDataPath += TXT( "DerivedDataCache/" );
+        pAssetPreprocessor->SetDerivedDataCache( new DerivedDataCache( String( derivedDataPath.c_str() ) ) );
+    }
 #else
-    if( !CacheAssetLoader::InitializeStaticInstance() )
+    // "-mapcache" memory maps the cache files and deserializes objects straight from the mappings instead of reading
+    // each object into a buffer of its own.
+    bool bMapCacheFiles = false;
+    System* pSystem = System::GetStaticInstance();
+    if( pSystem )
+    {
+        const DynamicArray< String >& rArguments = pSystem->GetArguments();
+        size_t argumentCount = rArguments.GetSize();
+        for( size_t argumentIndex = 0; argumentIndex < argumentCount; ++argumentIndex )
+        {
+            if( rArguments[ argumentIndex ] == TXT( "-mapcache" ) )
+            {
+                bMapCacheFiles = true;
+
+                break;
+            }
+        }
+    }
+
+    if( !CacheAssetLoader::InitializeStaticInstance( bMapCacheFiles ) )
     {
         HELIUM_TRACE(
             TraceLevels::Error,
@@ -1,6 +1,7 @@
 #include "FrameworkImplPch.h"
 #include "FrameworkImpl/RendererInitializationImpl.h"
 #include "Windowing/WindowManager.h"
+#include "Engine/AssetLoader.h"
 #include "Engine/Config.h"
 #include "Graphics/GraphicsConfig.h"
 
@@ -12,6 +13,7 @@
 
 #include "Graphics/RenderResourceManager.h"
 #include "Graphics/DynamicDrawer.h"
+#include "Graphics/TextureStreamer.h"
 
 using namespace Helium;
 
@@ -100,6 +102,21 @@ bool RendererInitializationImpl::Initialize()
 	RenderResourceManager& rRenderResourceManager = RenderResourceManager::GetStaticInstance();
 	rRenderResourceManager.Initialize();
 
+	// Enable texture mip streaming if a texture memory budget is configured.
+	uint32_t textureStreamingBudget = spGraphicsConfig->GetTextureStreamingBudget();
+	if( textureStreamingBudget != 0 )
+	{
+		TextureStreamer::InitializeStaticInstance( static_cast< size_t >( textureStreamingBudget ) * 1024 * 1024 );
+	}
+
+	// Keep released resources resident for reuse if a residency budget is configured.
+	uint32_t resourceResidencyBudget = spGraphicsConfig->GetResourceResidencyBudget();
+	AssetLoader* pAssetLoader = AssetLoader::GetStaticInstance();
+	if( resourceResidencyBudget != 0 && pAssetLoader )
+	{
+		pAssetLoader->GetResidencyManager().SetBudget( static_cast< size_t >( resourceResidencyBudget ) * 1024 * 1024 );
+	}
+
 	// Create and initialize the dynamic drawing interface.
 	DynamicDrawer& rDynamicDrawer = DynamicDrawer::GetStaticInstance();
 	if( !rDynamicDrawer.Initialize() )
@@ -134,6 +151,14 @@ void RendererInitializationImpl::OnMainWindowDestroyed( Window* pWindow )
 
 void Helium::RendererInitializationImpl::Shutdown()
 {
+	// Resources kept resident may hold render resources, so they have to be released while the renderer still exists.
+	AssetLoader* pAssetLoader = AssetLoader::GetStaticInstance();
+	if( pAssetLoader )
+	{
+		pAssetLoader->GetResidencyManager().SetBudget( Invalid< size_t >() );
+	}
+
+	TextureStreamer::DestroyStaticInstance();
 	DynamicDrawer::DestroyStaticInstance();
 	RenderResourceManager::DestroyStaticInstance();
 
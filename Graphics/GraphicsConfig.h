@@ -81,6 +81,9 @@ namespace Helium
         inline EShadowMode GetShadowMode() const;
         inline uint32_t GetShadowBufferSize() const;
 
+        inline uint32_t GetTextureStreamingBudget() const;
+        inline uint32_t GetResourceResidencyBudget() const;
+
         inline bool GetFullscreen() const;
         inline bool GetVsync() const;
         //@}
@@ -101,6 +104,12 @@ namespace Helium
         /// Shadow buffer size (width/height, in texels).
         uint32_t m_shadowBufferSize;
 
+        /// Texture memory budget for mip streaming, in megabytes (zero to load all mip levels up front).
+        uint32_t m_textureStreamingBudget;
+        /// Memory budget for keeping released resources resident, in megabytes (zero to destroy resources as soon as
+        /// they are released).
+        uint32_t m_resourceResidencyBudget;
+
         /// True to run in fullscreen mode, false to run in windowed mode.
         bool m_bFullscreen;
         /// True to enable vsync.
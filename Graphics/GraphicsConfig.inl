@@ -52,6 +52,22 @@ namespace Helium
         return m_shadowBufferSize;
     }
 
+    /// Get the texture memory budget for mip streaming.
+    ///
+    /// @return  Texture streaming budget, in megabytes, or zero if texture streaming is disabled.
+    uint32_t GraphicsConfig::GetTextureStreamingBudget() const
+    {
+        return m_textureStreamingBudget;
+    }
+
+    /// Get the memory budget for keeping released resources resident.
+    ///
+    /// @return  Resource residency budget, in megabytes, or zero if resources are not kept resident.
+    uint32_t GraphicsConfig::GetResourceResidencyBudget() const
+    {
+        return m_resourceResidencyBudget;
+    }
+
     /// Get whether fullscreen mode is enabled.
     ///
     /// @return  True if fullscreen mode is enabled, false if not.
@@ -29,7 +29,29 @@ void GraphicsManagerComponent::PopulateMetaType( Reflect::MetaStruct& comp )
 
 }
 
+GraphicsManagerComponent::GraphicsManagerComponent()
+{
+
+}
+
+/// The scene can't be shared with the source world, so the copy starts without one and builds its own in OnCloned().
+GraphicsManagerComponent::GraphicsManagerComponent( const GraphicsManagerComponent &rSource )
+	: Component( rSource )
+{
+
+}
+
 void GraphicsManagerComponent::Initialize( const GraphicsManagerComponentDefinition &definition)
+{
+	CreateGraphicsScene();
+}
+
+void GraphicsManagerComponent::OnCloned( const Components::CloneContext &rContext )
+{
+	CreateGraphicsScene();
+}
+
+void GraphicsManagerComponent::CreateGraphicsScene()
 {
 	m_spGraphicsScene = Reflect::AssertCast<GraphicsScene>(GraphicsScene::CreateObject());
 	HELIUM_ASSERT( m_spGraphicsScene );
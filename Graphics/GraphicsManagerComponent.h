@@ -19,7 +19,11 @@ namespace Helium
 		HELIUM_DECLARE_COMPONENT( Helium::GraphicsManagerComponent, Helium::Component );
 		static void PopulateMetaType( Reflect::MetaStruct& comp );
 
+		GraphicsManagerComponent();
+		GraphicsManagerComponent( const GraphicsManagerComponent &rSource );
+
 		void Initialize( const GraphicsManagerComponentDefinition &definition);
+		void OnCloned( const Components::CloneContext &rContext );
 
 	public:
 		inline GraphicsScene*  GetGraphicsScene() const;
@@ -30,6 +34,8 @@ namespace Helium
 #endif // GRAPHICS_SCENE_BUFFERED_DRAWER
 
 	private:
+		void                   CreateGraphicsScene();
+
 		/// Graphics scene instance.
 		GraphicsScenePtr m_spGraphicsScene;
 	};
@@ -21,6 +21,7 @@
 #include "Graphics/Material.h"
 #include "Graphics/RenderResourceManager.h"
 #include "Graphics/Texture.h"
+#include "Graphics/TextureStreamer.h"
 #include "Framework/World.h"
 #include "Framework/Entity.h"
 #include "Framework/Slice.h"
@@ -192,6 +193,13 @@ void GraphicsScene::Update( World *pWorld )
     // Finish drawing with the scene's buffered drawer.
     m_sceneBufferedDrawer.EndDrawing();
 #endif // GRAPHICS_SCENE_BUFFERED_DRAWER
+
+    // Update texture mip streaming now that the texture sizes for all views have been reported.
+    TextureStreamer* pTextureStreamer = TextureStreamer::GetStaticInstance();
+    if( pTextureStreamer )
+    {
+        pTextureStreamer->Tick();
+    }
 }
 
 /// Allocate a new scene view.
@@ -1191,6 +1199,8 @@ void GraphicsScene::DrawSceneView( uint_fast32_t viewIndex )
         }
     }
 
+    RequestTextureSizes( viewIndex );
+
     // Get the renderer interface and the main command proxy for the renderer.
     Renderer* pRenderer = Renderer::GetStaticInstance();
     HELIUM_ASSERT( pRenderer );
@@ -2147,6 +2157,69 @@ Name GraphicsScene::GetSkinningRigidOptionName()
     return skinningRigidOptionName;
 }
 
+/// Report the on-screen size of the textures used by the visible sub-meshes of a view to the texture streamer.
+///
+/// The texel density of a sub-mesh is estimated from the projected size of its scene object's bounding sphere,
+/// assuming each texture is mapped once across the object.
+///
+/// Note that this must be called after the list of visible sub-meshes for the view has been built.
+///
+/// @param[in] viewIndex  Index of the scene view.
+void GraphicsScene::RequestTextureSizes( uint_fast32_t viewIndex )
+{
+    TextureStreamer* pTextureStreamer = TextureStreamer::GetStaticInstance();
+    if( !pTextureStreamer )
+    {
+        return;
+    }
+
+    const GraphicsSceneView& rView = m_sceneViews[ viewIndex ];
+
+    // Number of pixels covered by one world unit at a distance of one world unit from the camera.
+    float32_t fovTangent = Tan( rView.GetHorizontalFov() * static_cast< float32_t >( HELIUM_DEG_TO_RAD ) * 0.5f );
+    if( fovTangent < HELIUM_EPSILON )
+    {
+        return;
+    }
+
+    float32_t pixelsPerUnit = static_cast< float32_t >( rView.GetViewportWidth() ) / ( 2.0f * fovTangent );
+
+    const Simd::Vector3& rViewOrigin = rView.GetOrigin();
+    const Simd::Vector3& rViewForward = rView.GetForward();
+    float32_t nearClip = rView.GetNearClip();
+
+    size_t subMeshIndexCount = m_sceneObjectSubMeshIndices.GetSize();
+    for( size_t subMeshIndexIndex = 0; subMeshIndexIndex < subMeshIndexCount; ++subMeshIndexIndex )
+    {
+        const GraphicsSceneObject::SubMeshData& rSubMesh =
+            m_sceneObjectSubMeshes[ m_sceneObjectSubMeshIndices[ subMeshIndexIndex ] ];
+
+        Material* pMaterial = rSubMesh.GetMaterial();
+        if( !pMaterial )
+        {
+            continue;
+        }
+
+        const Simd::Sphere& rBounds = m_sceneObjects[ rSubMesh.GetSceneObjectId() ].GetWorldSphere();
+        float32_t radius = rBounds.GetRadius();
+        float32_t distance = ( rBounds.GetCenter() - rViewOrigin ).Dot( rViewForward ) - radius;
+        distance = Max( distance, nearClip );
+
+        float32_t projectedSize = 2.0f * radius * pixelsPerUnit / distance;
+
+        size_t textureCount = pMaterial->GetTextureParameterCount();
+        for( size_t textureIndex = 0; textureIndex < textureCount; ++textureIndex )
+        {
+            const Material::TextureParameter& rTextureParameter = pMaterial->GetTextureParameter( textureIndex );
+            Texture2d* pTexture = Reflect::SafeCast< Texture2d >( rTextureParameter.value.Get() );
+            if( pTexture )
+            {
+                pTextureStreamer->RequestSize( pTexture, projectedSize );
+            }
+        }
+    }
+}
+
 /// Constructor.
 GraphicsScene::SubMeshFrontToBackCompare::SubMeshFrontToBackCompare()
 : m_cameraDirection( 0.0f )
@@ -230,6 +230,11 @@ namespace Helium
         void DrawBasePass( uint_fast32_t viewIndex );
         //@}
 
+        /// @name Texture Streaming
+        //@{
+        void RequestTextureSizes( uint_fast32_t viewIndex );
+        //@}
+
         /// @name Private Static Utility Functions
         //@{
         static Name GetNoneOptionName();
@@ -5,6 +5,8 @@
 #include "Rendering/Renderer.h"
 #include "Rendering/RTexture2d.h"
 #include "Reflect/TranslatorDeduction.h"
+#include "Engine/AssetLoader.h"
+#include "Graphics/TextureStreamer.h"
 
 HELIUM_IMPLEMENT_ASSET( Helium::Texture2d, Graphics, AssetType::FLAG_NO_TEMPLATE );
 
@@ -31,6 +33,9 @@ void Texture2d::PersistentResourceData::PopulateMetaType( Reflect::MetaStruct& c
 
 /// Constructor.
 Texture2d::Texture2d()
+: m_residentBaseMip( 0 )
+, m_streamingBaseMip( 0 )
+, m_streamingId( Invalid< size_t >() )
 {
 }
 
@@ -39,6 +44,22 @@ Texture2d::~Texture2d()
 {
 }
 
+/// @copydoc Asset::RefCountPreDestroy()
+void Texture2d::RefCountPreDestroy()
+{
+    // The streamer holds a reference to textures while their mip levels are being streamed.
+    HELIUM_ASSERT( !m_spStreamingTexture );
+
+    if( IsValid( m_streamingId ) )
+    {
+        TextureStreamer* pTextureStreamer = TextureStreamer::GetStaticInstance();
+        HELIUM_ASSERT( pTextureStreamer );
+        pTextureStreamer->Unregister( this );
+    }
+
+    Base::RefCountPreDestroy();
+}
+
 /// @copydoc Asset::NeedsPrecacheResourceData()
 bool Texture2d::NeedsPrecacheResourceData() const
 {
@@ -56,9 +77,179 @@ bool Texture2d::BeginPrecacheResourceData()
         return true;
     }
 
-    const uint32_t baseLevelWidth = m_persistentResourceData.m_baseLevelWidth;
-    const uint32_t baseLevelHeight = m_persistentResourceData.m_baseLevelHeight;
     const uint32_t mipCount = m_persistentResourceData.m_mipCount;
+
+    m_mipSizes.Reserve( mipCount );
+    m_mipSizes.Resize( mipCount );
+    m_mipSizes.Trim();
+    for ( uint32_t mipIndex = 0; mipIndex < mipCount; ++mipIndex )
+    {
+        m_mipSizes[ mipIndex ] = GetSubDataSize( mipIndex );
+    }
+
+    // When streaming, only the small mip levels are loaded up front, and the texture is usable as soon as they are.
+    uint32_t baseMip = 0;
+    TextureStreamer* pTextureStreamer = TextureStreamer::GetStaticInstance();
+    if ( pTextureStreamer )
+    {
+        baseMip = pTextureStreamer->GetMinResidentBaseMip( this );
+    }
+
+    RTexture2d* pTexture2d = CreateMipRenderResource( baseMip );
+    if ( !pTexture2d )
+    {
+        return false;
+    }
+
+    m_spTexture = pTexture2d;
+    m_residentBaseMip = baseMip;
+
+    BeginLoadMips( pTexture2d, baseMip );
+
+    return true;
+}
+
+/// @copydoc Asset::TryFinishPrecacheResourceData()
+bool Texture2d::TryFinishPrecacheResourceData()
+{
+    if( m_renderResourceLoadIds.IsEmpty() )
+    {
+        return true;
+    }
+
+    RTexture2d* pTexture2d = static_cast< RTexture2d* >( m_spTexture.Get() );
+    HELIUM_ASSERT( pTexture2d );
+    if( !TryFinishLoadMips( pTexture2d ) )
+    {
+        return false;
+    }
+
+    TextureStreamer* pTextureStreamer = TextureStreamer::GetStaticInstance();
+    if( pTextureStreamer && m_persistentResourceData.m_mipCount > 1 )
+    {
+        pTextureStreamer->Register( this );
+    }
+
+    return true;
+}
+
+/// Get the number of bytes of memory this texture keeps resident while loaded.
+///
+/// Only the resident mip levels are counted.
+///
+/// @return  Resident size, in bytes.
+size_t Texture2d::GetResidentSize() const
+{
+    if( m_mipSizes.IsEmpty() )
+    {
+        return Base::GetResidentSize();
+    }
+
+    return GetInstanceSize() + GetMipChainSize( m_residentBaseMip );
+}
+
+/// Get the cached size of a mip chain.
+///
+/// @param[in] baseMip  Index of the largest mip level in the chain.
+///
+/// @return  Total size of all mip levels from the given level down to the smallest, in bytes.
+size_t Texture2d::GetMipChainSize( uint32_t baseMip ) const
+{
+    size_t chainSize = 0;
+
+    size_t mipCount = m_mipSizes.GetSize();
+    for( size_t mipIndex = baseMip; mipIndex < mipCount; ++mipIndex )
+    {
+        size_t mipSize = m_mipSizes[ mipIndex ];
+        if( IsValid( mipSize ) )
+        {
+            chainSize += mipSize;
+        }
+    }
+
+    return chainSize;
+}
+
+/// Begin changing the set of resident mip levels.
+///
+/// A new render resource holding all mip levels from the given level down to the smallest is created and filled
+/// from the resource cache.  The current render resource remains in use until TryFinishStreamMips() reports that
+/// the new one is ready.
+///
+/// @param[in] baseMip  Index of the largest mip level to keep resident.
+///
+/// @return  True if streaming was started, false if not.
+///
+/// @see TryFinishStreamMips(), IsStreamingMips()
+bool Texture2d::BeginStreamMips( uint32_t baseMip )
+{
+    HELIUM_ASSERT( !m_spStreamingTexture );
+    HELIUM_ASSERT( m_renderResourceLoadIds.IsEmpty() );
+    HELIUM_ASSERT( baseMip < m_persistentResourceData.m_mipCount );
+
+    if( baseMip == m_residentBaseMip )
+    {
+        return false;
+    }
+
+    RTexture2d* pTexture2d = CreateMipRenderResource( baseMip );
+    if( !pTexture2d )
+    {
+        return false;
+    }
+
+    m_spStreamingTexture = pTexture2d;
+    m_streamingBaseMip = baseMip;
+
+    BeginLoadMips( pTexture2d, baseMip );
+
+    return true;
+}
+
+/// Check whether streaming started with BeginStreamMips() has completed, switching to the new render resource if so.
+///
+/// @return  True if streaming has completed (or none was in progress), false if it is still in progress.
+///
+/// @see BeginStreamMips(), IsStreamingMips()
+bool Texture2d::TryFinishStreamMips()
+{
+    RTexture2d* pTexture2d = static_cast< RTexture2d* >( m_spStreamingTexture.Get() );
+    if( !pTexture2d )
+    {
+        return true;
+    }
+
+    if( !TryFinishLoadMips( pTexture2d ) )
+    {
+        return false;
+    }
+
+    m_spTexture = pTexture2d;
+    m_spStreamingTexture.Release();
+    m_residentBaseMip = m_streamingBaseMip;
+
+    AssetLoader* pAssetLoader = AssetLoader::GetStaticInstance();
+    if( pAssetLoader )
+    {
+        pAssetLoader->GetResidencyManager().UpdateResidentSize( this );
+    }
+
+    return true;
+}
+
+/// Create a render resource for a mip chain of this texture.
+///
+/// @param[in] baseMip  Index of the largest mip level in the chain.
+///
+/// @return  Texture render resource, or null if creation failed.
+RTexture2d* Texture2d::CreateMipRenderResource( uint32_t baseMip ) const
+{
+    Renderer* pRenderer = Renderer::GetStaticInstance();
+    HELIUM_ASSERT( pRenderer );
+
+    const uint32_t baseLevelWidth = Max< uint32_t >( m_persistentResourceData.m_baseLevelWidth >> baseMip, 1 );
+    const uint32_t baseLevelHeight = Max< uint32_t >( m_persistentResourceData.m_baseLevelHeight >> baseMip, 1 );
+    const uint32_t mipCount = m_persistentResourceData.m_mipCount - baseMip;
     const int32_t pixelFormatIndex = m_persistentResourceData.m_pixelFormatIndex;
 
     RTexture2d* pTexture2d = pRenderer->CreateTexture2d(
@@ -72,24 +263,35 @@ bool Texture2d::BeginPrecacheResourceData()
     {
         HELIUM_TRACE(
             TraceLevels::Error,
-            ( TXT( "Texture2d::BeginPrecacheResourceData(): Failed to create texture render " )
-            TXT( "resource (width: %" ) PRIu32 TXT( "; height: %" ) PRIu32 TXT( "; mip count: %" )
-            PRIu32 TXT( "; pixel format index: %" ) PRId32 TXT( ").\n" ) ),
+            ( TXT( "Texture2d: Failed to create texture render resource (width: %" ) PRIu32 TXT( "; height: %" )
+            PRIu32 TXT( "; mip count: %" ) PRIu32 TXT( "; pixel format index: %" ) PRId32 TXT( ").\n" ) ),
             baseLevelWidth,
             baseLevelHeight,
             mipCount,
             pixelFormatIndex );
-
-        return false;
     }
 
-    m_spTexture = pTexture2d;
+    return pTexture2d;
+}
+
+/// Begin loading cached mip level data into a texture render resource.
+///
+/// @param[in] pTexture2d  Render resource created with CreateMipRenderResource().
+/// @param[in] baseMip     Index of the mip level corresponding to the largest mip level of the render resource.
+///
+/// @see TryFinishLoadMips()
+void Texture2d::BeginLoadMips( RTexture2d* pTexture2d, uint32_t baseMip )
+{
+    HELIUM_ASSERT( pTexture2d );
+    HELIUM_ASSERT( m_renderResourceLoadIds.IsEmpty() );
+
+    const uint32_t mipCount = pTexture2d->GetMipCount();
 
     m_renderResourceLoadIds.Reserve( mipCount );
     m_renderResourceLoadIds.Resize( mipCount );
     m_renderResourceLoadIds.Trim();
 
-    const ERendererPixelFormat format = static_cast< ERendererPixelFormat >( pixelFormatIndex );
+    const ERendererPixelFormat format = static_cast< ERendererPixelFormat >( m_persistentResourceData.m_pixelFormatIndex );
     HELIUM_ASSERT( static_cast< size_t >( format ) < static_cast< size_t >( RENDERER_PIXEL_FORMAT_MAX ) );
 
     for ( uint32_t mipIndex = 0; mipIndex < mipCount; ++mipIndex )
@@ -103,8 +305,8 @@ bool Texture2d::BeginPrecacheResourceData()
         {
             HELIUM_TRACE(
                 TraceLevels::Error,
-                TXT( "Texture2d::BeginPrecacheResourceData(): Failed to lock mip level %" ) PRIu32 TXT( ".\n" ),
-                mipIndex );
+                TXT( "Texture2d::BeginLoadMips(): Failed to lock mip level %" ) PRIu32 TXT( ".\n" ),
+                baseMip + mipIndex );
 
             continue;
         }
@@ -113,17 +315,17 @@ bool Texture2d::BeginPrecacheResourceData()
         size_t rowCount = RendererUtil::PixelToBlockRowCount( mipLevelHeight, format );
         size_t mipLevelSize = pitch * rowCount;
 
-        HELIUM_ASSERT( mipLevelSize == GetSubDataSize( mipIndex ) );
+        HELIUM_ASSERT( mipLevelSize == m_mipSizes[ baseMip + mipIndex ] );
 
-        size_t loadId = BeginLoadSubData( pMipData, mipIndex, mipLevelSize );
+        size_t loadId = BeginLoadSubData( pMipData, baseMip + mipIndex, mipLevelSize );
         HELIUM_ASSERT( IsValid( loadId ) );
         if ( IsInvalid( loadId ) )
         {
             HELIUM_TRACE(
                 TraceLevels::Error,
-                ( TXT( "Texture2d::BeginPrecacheResourceData(): Failed to begin loading of cached data for mip " )
-                TXT( "level %" ) PRIu32 TXT( ".\n" ) ),
-                mipIndex );
+                ( TXT( "Texture2d::BeginLoadMips(): Failed to begin loading of cached data for mip level %" )
+                PRIu32 TXT( ".\n" ) ),
+                baseMip + mipIndex );
 
             pTexture2d->Unmap( mipIndex );
 
@@ -132,22 +334,21 @@ bool Texture2d::BeginPrecacheResourceData()
 
         m_renderResourceLoadIds[ mipIndex ] = loadId;
     }
-
-    return true;
 }
 
-/// @copydoc Asset::TryFinishPrecacheResourceData()
-bool Texture2d::TryFinishPrecacheResourceData()
+/// Check whether loads started with BeginLoadMips() have completed.
+///
+/// @param[in] pTexture2d  Render resource being loaded.
+///
+/// @return  True if all mip level loads have completed, false if any are still in progress.
+///
+/// @see BeginLoadMips()
+bool Texture2d::TryFinishLoadMips( RTexture2d* pTexture2d )
 {
+    HELIUM_ASSERT( pTexture2d );
+
     // Check all pending load requests.
     size_t loadRequestCount = m_renderResourceLoadIds.GetSize();
-    if( loadRequestCount == 0 )
-    {
-        return true;
-    }
-
-    RTexture2d* pTexture2d = static_cast< RTexture2d* >( m_spTexture.Get() );
-    HELIUM_ASSERT( pTexture2d );
     HELIUM_ASSERT( loadRequestCount == pTexture2d->GetMipCount() );
 
     bool bHaveUnfinishedLoad = false;
@@ -36,6 +36,11 @@ namespace Helium
 		/// Persistent texture resource data.
 		PersistentResourceData m_persistentResourceData;
 
+		/// @name Asset Interface
+		//@{
+		virtual void RefCountPreDestroy();
+		//@}
+
 		/// @name Serialization
 		//@{
 		virtual bool NeedsPrecacheResourceData() const;
@@ -43,6 +48,11 @@ namespace Helium
 		virtual bool TryFinishPrecacheResourceData();
 		//@}
 
+		/// @name Residency
+		//@{
+		virtual size_t GetResidentSize() const;
+		//@}
+
 		inline uint32_t GetWidth() const;
 		inline uint32_t GetHeight() const;
 
@@ -56,9 +66,40 @@ namespace Helium
 		RTexture2d* GetRenderResource2d() const;
 		//@}
 
+		/// @name Mip Streaming
+		//@{
+		inline uint32_t GetMipCount() const;
+		inline uint32_t GetResidentBaseMip() const;
+		size_t GetMipChainSize( uint32_t baseMip ) const;
+
+		bool BeginStreamMips( uint32_t baseMip );
+		bool TryFinishStreamMips();
+		inline bool IsStreamingMips() const;
+		//@}
+
 	private:
 		/// Async load IDs for cached texture data.
 		DynamicArray< size_t > m_renderResourceLoadIds;
+		/// Cached data size of each mip level.
+		DynamicArray< size_t > m_mipSizes;
+
+		/// Render resource being filled with a different set of resident mip levels.
+		RTexturePtr m_spStreamingTexture;
+		/// Index of the largest mip level resident in the render resource.
+		uint32_t m_residentBaseMip;
+		/// Index of the largest mip level in the render resource being streamed in.
+		uint32_t m_streamingBaseMip;
+		/// Texture streamer registration ID (invalid if not registered).
+		size_t m_streamingId;
+
+		friend class TextureStreamer;
+
+		/// @name Private Utility Functions
+		//@{
+		RTexture2d* CreateMipRenderResource( uint32_t baseMip ) const;
+		void BeginLoadMips( RTexture2d* pTexture2d, uint32_t baseMip );
+		bool TryFinishLoadMips( RTexture2d* pTexture2d );
+		//@}
 	};
 }
 
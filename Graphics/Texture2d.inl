@@ -10,4 +10,36 @@ namespace Helium
 	{
 		return m_persistentResourceData.m_baseLevelHeight;
 	}
+
+	/// Get the number of mip levels in the full mip chain.
+	///
+	/// @return  Mip level count.
+	///
+	/// @see GetResidentBaseMip()
+	uint32_t Helium::Texture2d::GetMipCount() const
+	{
+		return m_persistentResourceData.m_mipCount;
+	}
+
+	/// Get the index of the largest mip level currently resident.
+	///
+	/// All mip levels from this one down to the smallest are resident.
+	///
+	/// @return  Resident base mip level index (zero if the full mip chain is resident).
+	///
+	/// @see GetMipCount(), BeginStreamMips()
+	uint32_t Helium::Texture2d::GetResidentBaseMip() const
+	{
+		return m_residentBaseMip;
+	}
+
+	/// Get whether a change in resident mip levels is in progress.
+	///
+	/// @return  True if mip levels are being streamed, false if not.
+	///
+	/// @see BeginStreamMips(), TryFinishStreamMips()
+	bool Helium::Texture2d::IsStreamingMips() const
+	{
+		return ( m_spStreamingTexture.Get() != NULL );
+	}
 }
@@ -0,0 +1,371 @@
+#include "GraphicsPch.h"
+#include "Graphics/TextureStreamer.h"
+
+#include "Platform/Thread.h"
+
+using namespace Helium;
+
+TextureStreamer* TextureStreamer::sm_pInstance = NULL;
+
+/// Constructor.
+///
+/// @param[in] budget  Texture memory budget, in bytes.
+TextureStreamer::TextureStreamer( size_t budget )
+: m_budget( budget )
+, m_residentSize( 0 )
+, m_updateCounter( 0 )
+{
+}
+
+/// Destructor.
+TextureStreamer::~TextureStreamer()
+{
+    // Mip level loads write directly into the render resources, so they need to finish before letting go of them.
+    size_t streamingTextureCount = m_streamingTextures.GetSize();
+    for( size_t textureIndex = 0; textureIndex < streamingTextureCount; ++textureIndex )
+    {
+        Texture2d* pTexture = m_streamingTextures[ textureIndex ];
+        HELIUM_ASSERT( pTexture );
+        while( !pTexture->TryFinishStreamMips() )
+        {
+            Thread::Yield();
+        }
+    }
+
+    size_t textureCount = m_textures.GetSize();
+    for( size_t textureIndex = 0; textureIndex < textureCount; ++textureIndex )
+    {
+        if( m_textures.IsElementValid( textureIndex ) )
+        {
+            Texture2d* pTexture = m_textures[ textureIndex ].pTexture;
+            HELIUM_ASSERT( pTexture );
+            SetInvalid( pTexture->m_streamingId );
+        }
+    }
+
+    m_textures.Clear();
+    m_streamingTextures.Clear();
+}
+
+/// Set the texture memory budget.
+///
+/// @param[in] budget  Budget, in bytes.
+///
+/// @see GetBudget()
+void TextureStreamer::SetBudget( size_t budget )
+{
+    m_budget = budget;
+}
+
+/// Get the index of the largest mip level a texture keeps resident regardless of visibility.
+///
+/// Textures are initially loaded with only these mip levels resident.
+///
+/// @param[in] pTexture  Texture.
+///
+/// @return  Mip level index.
+uint32_t TextureStreamer::GetMinResidentBaseMip( const Texture2d* pTexture ) const
+{
+    HELIUM_ASSERT( pTexture );
+
+    uint32_t mipCount = pTexture->GetMipCount();
+    uint32_t size = Max( pTexture->GetWidth(), pTexture->GetHeight() );
+
+    uint32_t baseMip = 0;
+    while( baseMip + 1 < mipCount && ( size >> baseMip ) > MIN_RESIDENT_SIZE_MAX )
+    {
+        ++baseMip;
+    }
+
+    return baseMip;
+}
+
+/// Start streaming the mip levels of a loaded texture.
+///
+/// @param[in] pTexture  Texture to register.
+///
+/// @see Unregister()
+void TextureStreamer::Register( Texture2d* pTexture )
+{
+    HELIUM_ASSERT( pTexture );
+    HELIUM_ASSERT( IsInvalid( pTexture->m_streamingId ) );
+
+    TextureInfo* pInfo = m_textures.New();
+    HELIUM_ASSERT( pInfo );
+    pInfo->pTexture = pTexture;
+    pInfo->requestedSize = 0.0f;
+    pInfo->requestUpdate = m_updateCounter - REQUEST_RETAIN_UPDATE_COUNT - 1;
+    pInfo->minResidentBaseMip = GetMinResidentBaseMip( pTexture );
+    pInfo->wantedBaseMip = pInfo->minResidentBaseMip;
+
+    pTexture->m_streamingId = m_textures.GetElementIndex( pInfo );
+}
+
+/// Stop streaming the mip levels of a texture.
+///
+/// @param[in] pTexture  Texture to unregister.
+///
+/// @see Register()
+void TextureStreamer::Unregister( Texture2d* pTexture )
+{
+    HELIUM_ASSERT( pTexture );
+
+    size_t id = pTexture->m_streamingId;
+    HELIUM_ASSERT( id < m_textures.GetSize() );
+    HELIUM_ASSERT( m_textures.IsElementValid( id ) );
+    HELIUM_ASSERT( m_textures[ id ].pTexture == pTexture );
+
+    m_textures.Remove( id );
+    SetInvalid( pTexture->m_streamingId );
+}
+
+/// Report the on-screen size at which a texture is being drawn for the current update.
+///
+/// @param[in] pTexture  Texture being drawn.
+/// @param[in] size      Approximate on-screen width covered by the full texture, in pixels.
+void TextureStreamer::RequestSize( Texture2d* pTexture, float32_t size )
+{
+    HELIUM_ASSERT( pTexture );
+
+    size_t id = pTexture->m_streamingId;
+    if( IsInvalid( id ) )
+    {
+        return;
+    }
+
+    HELIUM_ASSERT( m_textures.IsElementValid( id ) );
+    TextureInfo& rInfo = m_textures[ id ];
+
+    if( rInfo.requestUpdate != m_updateCounter )
+    {
+        rInfo.requestUpdate = m_updateCounter;
+        rInfo.requestedSize = size;
+    }
+    else
+    {
+        rInfo.requestedSize = Max( rInfo.requestedSize, size );
+    }
+}
+
+/// Update texture streaming.
+///
+/// This should be called once per frame, after the sizes of all visible textures have been reported with
+/// RequestSize().
+void TextureStreamer::Tick()
+{
+    // Switch over textures that have finished streaming.
+    size_t streamingTextureIndex = m_streamingTextures.GetSize();
+    while( streamingTextureIndex != 0 )
+    {
+        --streamingTextureIndex;
+
+        Texture2d* pTexture = m_streamingTextures[ streamingTextureIndex ];
+        HELIUM_ASSERT( pTexture );
+        if( pTexture->TryFinishStreamMips() )
+        {
+            m_streamingTextures.RemoveSwap( streamingTextureIndex );
+        }
+    }
+
+    // Pick the mip levels each texture should keep based on its requested size, keeping those of textures that have
+    // gone out of view for a while in case they come back.
+    size_t textureCount = m_textures.GetSize();
+    for( size_t textureIndex = 0; textureIndex < textureCount; ++textureIndex )
+    {
+        if( !m_textures.IsElementValid( textureIndex ) )
+        {
+            continue;
+        }
+
+        TextureInfo& rInfo = m_textures[ textureIndex ];
+        rInfo.wantedBaseMip = rInfo.minResidentBaseMip;
+        if( m_updateCounter - rInfo.requestUpdate > REQUEST_RETAIN_UPDATE_COUNT )
+        {
+            continue;
+        }
+
+        uint32_t size = Max( rInfo.pTexture->GetWidth(), rInfo.pTexture->GetHeight() );
+        rInfo.wantedBaseMip = SelectWantedBaseMip( size, rInfo.minResidentBaseMip, rInfo.requestedSize );
+    }
+
+    m_mipChains.Resize( 0 );
+    for( size_t textureIndex = 0; textureIndex < textureCount; ++textureIndex )
+    {
+        if( !m_textures.IsElementValid( textureIndex ) )
+        {
+            continue;
+        }
+
+        const TextureInfo& rInfo = m_textures[ textureIndex ];
+        Texture2d* pTexture = rInfo.pTexture;
+        HELIUM_ASSERT( pTexture );
+
+        MipChain* pChain = m_mipChains.New();
+        HELIUM_ASSERT( pChain );
+        pChain->pMipSizes = pTexture->m_mipSizes.GetData();
+        pChain->mipCount = static_cast< uint32_t >( pTexture->m_mipSizes.GetSize() );
+        pChain->wantedBaseMip = rInfo.wantedBaseMip;
+        pChain->minResidentBaseMip = rInfo.minResidentBaseMip;
+    }
+
+    uint32_t mipBias = ComputeMipBias( m_mipChains.GetData(), m_mipChains.GetSize(), m_budget );
+
+    // Start streaming textures toward their target mip levels, dropping mip levels before adding any so that memory
+    // is freed up first.
+    m_residentSize = 0;
+    for( size_t passIndex = 0; passIndex < 2; ++passIndex )
+    {
+        bool bDropPass = ( passIndex == 0 );
+
+        for( size_t textureIndex = 0; textureIndex < textureCount; ++textureIndex )
+        {
+            if( !m_textures.IsElementValid( textureIndex ) )
+            {
+                continue;
+            }
+
+            const TextureInfo& rInfo = m_textures[ textureIndex ];
+            Texture2d* pTexture = rInfo.pTexture;
+            HELIUM_ASSERT( pTexture );
+
+            uint32_t residentBaseMip = pTexture->GetResidentBaseMip();
+            if( bDropPass )
+            {
+                m_residentSize += pTexture->GetMipChainSize( residentBaseMip );
+            }
+
+            if( m_streamingTextures.GetSize() >= STREAMING_TEXTURE_COUNT_MAX || pTexture->IsStreamingMips() )
+            {
+                continue;
+            }
+
+            uint32_t targetBaseMip = GetTargetBaseMip( rInfo.wantedBaseMip, rInfo.minResidentBaseMip, mipBias );
+            if( bDropPass ? targetBaseMip > residentBaseMip : targetBaseMip < residentBaseMip )
+            {
+                if( pTexture->BeginStreamMips( targetBaseMip ) )
+                {
+                    m_streamingTextures.Push( pTexture );
+                }
+            }
+        }
+    }
+
+    ++m_updateCounter;
+}
+
+/// Initialize the singleton TextureStreamer instance.
+///
+/// Textures loaded before this is called keep all of their mip levels resident.
+///
+/// @param[in] budget  Texture memory budget, in bytes.
+///
+/// @return  True if the streamer was created, false if not.
+///
+/// @see GetStaticInstance(), DestroyStaticInstance()
+bool TextureStreamer::InitializeStaticInstance( size_t budget )
+{
+    HELIUM_ASSERT( !sm_pInstance );
+    sm_pInstance = new TextureStreamer( budget );
+    HELIUM_ASSERT( sm_pInstance );
+
+    return ( sm_pInstance != NULL );
+}
+
+/// Get the singleton TextureStreamer instance.
+///
+/// @return  Texture streamer instance, or null if texture streaming is not enabled.
+///
+/// @see InitializeStaticInstance(), DestroyStaticInstance()
+TextureStreamer* TextureStreamer::GetStaticInstance()
+{
+    return sm_pInstance;
+}
+
+/// Destroy the singleton TextureStreamer instance.
+///
+/// Textures keep the mip levels resident at the time, and are no longer streamed.
+///
+/// @see InitializeStaticInstance(), GetStaticInstance()
+void TextureStreamer::DestroyStaticInstance()
+{
+    delete sm_pInstance;
+    sm_pInstance = NULL;
+}
+
+/// Pick the mip level a texture needs for the size at which it is drawn.
+///
+/// @param[in] size                Larger of the width and height of the texture's largest mip level, in pixels.
+/// @param[in] minResidentBaseMip  Index of the largest mip level kept resident regardless of visibility.
+/// @param[in] requestedSize       Approximate on-screen width covered by the full texture, in pixels.
+///
+/// @return  Index of the smallest mip level that is still at least as large as the requested size, or the minimum
+///          resident level if that is larger.
+///
+/// @see ComputeMipBias()
+uint32_t TextureStreamer::SelectWantedBaseMip( uint32_t size, uint32_t minResidentBaseMip, float32_t requestedSize )
+{
+    uint32_t wantedBaseMip = 0;
+    while( wantedBaseMip < minResidentBaseMip &&
+        static_cast< float32_t >( size >> ( wantedBaseMip + 1 ) ) >= requestedSize )
+    {
+        ++wantedBaseMip;
+    }
+
+    return wantedBaseMip;
+}
+
+/// Compute the smallest number of mip levels to drop from all textures in order to meet a budget.
+///
+/// No texture drops below its minimum resident mip level, so the budget may still be exceeded if it is smaller than
+/// the minimum resident levels of all textures combined.
+///
+/// @param[in] pChains     Mip chains of the textures.
+/// @param[in] chainCount  Number of mip chains.
+/// @param[in] budget      Texture memory budget, in bytes.
+///
+/// @return  Mip bias.
+///
+/// @see SelectWantedBaseMip()
+uint32_t TextureStreamer::ComputeMipBias( const MipChain* pChains, size_t chainCount, size_t budget )
+{
+    HELIUM_ASSERT( pChains || chainCount == 0 );
+
+    for( uint32_t mipBias = 0; ; ++mipBias )
+    {
+        size_t totalSize = 0;
+        bool bCanDropMore = false;
+
+        for( size_t chainIndex = 0; chainIndex < chainCount; ++chainIndex )
+        {
+            const MipChain& rChain = pChains[ chainIndex ];
+            uint32_t targetBaseMip = GetTargetBaseMip( rChain.wantedBaseMip, rChain.minResidentBaseMip, mipBias );
+            for( uint32_t mipIndex = targetBaseMip; mipIndex < rChain.mipCount; ++mipIndex )
+            {
+                size_t mipSize = rChain.pMipSizes[ mipIndex ];
+                if( IsValid( mipSize ) )
+                {
+                    totalSize += mipSize;
+                }
+            }
+
+            bCanDropMore |= ( targetBaseMip < rChain.minResidentBaseMip );
+        }
+
+        if( totalSize <= budget || !bCanDropMore )
+        {
+            return mipBias;
+        }
+    }
+}
+
+/// Get the mip level a texture should keep resident.
+///
+/// @param[in] wantedBaseMip       Index of the largest mip level wanted for the texture's on-screen size.
+/// @param[in] minResidentBaseMip  Index of the largest mip level kept resident regardless of visibility.
+/// @param[in] mipBias             Number of additional mip levels to drop to meet the budget.
+///
+/// @return  Index of the largest mip level to keep resident.
+uint32_t TextureStreamer::GetTargetBaseMip( uint32_t wantedBaseMip, uint32_t minResidentBaseMip, uint32_t mipBias )
+{
+    return Min( wantedBaseMip + mipBias, minResidentBaseMip );
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "Graphics/Graphics.h"
+
+#include "Foundation/SparseArray.h"
+#include "Graphics/Texture2d.h"
+
+namespace Helium
+{
+    /// Texture mip level streaming manager.
+    ///
+    /// While a streamer exists, textures are loaded with only their small mip levels resident and become usable as
+    /// soon as those are loaded.  Each update, the graphics scene reports the on-screen size of each texture on a
+    /// visible sub-mesh, and the streamer picks the largest mip level worth keeping resident for each texture.  If
+    /// the total size of those mip levels exceeds the texture memory budget, the largest levels are dropped from all
+    /// textures evenly until it fits.  Changes are streamed in as resource sub-data loads, a few textures at a time.
+    class HELIUM_GRAPHICS_API TextureStreamer : NonCopyable
+    {
+    public:
+        /// Largest width or height of the mip levels kept resident regardless of visibility.
+        static const uint32_t MIN_RESIDENT_SIZE_MAX = 64;
+        /// Maximum number of textures streaming mip levels at once.
+        static const size_t STREAMING_TEXTURE_COUNT_MAX = 4;
+        /// Number of updates for which a texture keeps its mip levels after it was last reported as visible.
+        static const uint32_t REQUEST_RETAIN_UPDATE_COUNT = 120;
+
+        /// Mip chain of a texture, as considered when fitting textures into the budget.
+        struct MipChain
+        {
+            /// Size of each mip level, in bytes (invalid for levels with no data).
+            const size_t* pMipSizes;
+            /// Number of mip levels.
+            uint32_t mipCount;
+            /// Index of the largest mip level wanted for the texture's on-screen size.
+            uint32_t wantedBaseMip;
+            /// Index of the largest mip level kept resident regardless of visibility.
+            uint32_t minResidentBaseMip;
+        };
+
+        /// @name Budget
+        //@{
+        void SetBudget( size_t budget );
+        inline size_t GetBudget() const;
+        inline size_t GetResidentSize() const;
+        //@}
+
+        /// @name Texture Registration
+        //@{
+        uint32_t GetMinResidentBaseMip( const Texture2d* pTexture ) const;
+
+        void Register( Texture2d* pTexture );
+        void Unregister( Texture2d* pTexture );
+        //@}
+
+        /// @name Updating
+        //@{
+        void RequestSize( Texture2d* pTexture, float32_t size );
+        void Tick();
+        //@}
+
+        /// @name Mip Selection
+        //@{
+        static uint32_t SelectWantedBaseMip( uint32_t size, uint32_t minResidentBaseMip, float32_t requestedSize );
+        static uint32_t ComputeMipBias( const MipChain* pChains, size_t chainCount, size_t budget );
+        //@}
+
+        /// @name Static Access
+        //@{
+        static bool InitializeStaticInstance( size_t budget );
+        static TextureStreamer* GetStaticInstance();
+        static void DestroyStaticInstance();
+        //@}
+
+    private:
+        /// Registered texture information.
+        struct TextureInfo
+        {
+            /// Texture.
+            Texture2d* pTexture;
+            /// Largest on-screen size requested since the request update, in pixels.
+            float32_t requestedSize;
+            /// Update counter value when a size was last requested.
+            uint32_t requestUpdate;
+            /// Index of the largest mip level to keep resident, ignoring the budget.
+            uint32_t wantedBaseMip;
+            /// Index of the largest mip level kept resident regardless of visibility.
+            uint32_t minResidentBaseMip;
+        };
+
+        /// Registered textures.
+        SparseArray< TextureInfo > m_textures;
+        /// Textures streaming mip levels (references are held until streaming completes).
+        DynamicArray< Texture2dPtr > m_streamingTextures;
+        /// Mip chains of the registered textures, rebuilt each update to fit them into the budget.
+        DynamicArray< MipChain > m_mipChains;
+
+        /// Texture memory budget, in bytes.
+        size_t m_budget;
+        /// Total size of the resident mip levels of all registered textures, in bytes.
+        size_t m_residentSize;
+        /// Number of updates performed.
+        uint32_t m_updateCounter;
+
+        /// Singleton instance.
+        static TextureStreamer* sm_pInstance;
+
+        /// @name Construction/Destruction
+        //@{
+        explicit TextureStreamer( size_t budget );
+        ~TextureStreamer();
+        //@}
+
+        /// @name Private Utility Functions
+        //@{
+        static uint32_t GetTargetBaseMip( uint32_t wantedBaseMip, uint32_t minResidentBaseMip, uint32_t mipBias );
+        //@}
+    };
+}
+
+#include "Graphics/TextureStreamer.inl"
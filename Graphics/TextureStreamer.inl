@@ -0,0 +1,22 @@
+namespace Helium
+{
+    /// Get the texture memory budget.
+    ///
+    /// @return  Budget, in bytes.
+    ///
+    /// @see SetBudget(), GetResidentSize()
+    size_t TextureStreamer::GetBudget() const
+    {
+        return m_budget;
+    }
+
+    /// Get the total size of the resident mip levels of all streamed textures as of the last update.
+    ///
+    /// @return  Resident size, in bytes.
+    ///
+    /// @see GetBudget()
+    size_t TextureStreamer::GetResidentSize() const
+    {
+        return m_residentSize;
+    }
+}
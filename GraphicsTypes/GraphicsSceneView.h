@@ -79,6 +79,9 @@ namespace Helium
 		inline const Simd::Vector3& GetForward() const;
 		inline const Simd::Vector3& GetUp() const;
 
+		inline float32_t GetHorizontalFov() const;
+		inline float32_t GetNearClip() const;
+
 		inline const Simd::Matrix44& GetViewMatrix() const;
 		inline const Simd::Matrix44& GetInverseViewMatrix() const;
 		inline const Simd::Matrix44& GetInverseViewProjectionMatrix() const;
@@ -115,6 +115,26 @@ namespace Helium
         return m_up;
     }
 
+    /// Get the horizontal field-of-view angle.
+    ///
+    /// @return  Horizontal field-of-view angle, in degrees.
+    ///
+    /// @see SetHorizontalFov()
+    float32_t GraphicsSceneView::GetHorizontalFov() const
+    {
+        return m_horizontalFov;
+    }
+
+    /// Get the near clip plane distance.
+    ///
+    /// @return  Near clip distance.
+    ///
+    /// @see SetNearClip()
+    float32_t GraphicsSceneView::GetNearClip() const
+    {
+        return m_nearClip;
+    }
+
     /// Get the view matrix for this scene view.
     ///
     /// @return  View matrix.
@@ -401,6 +401,7 @@ Helium.DoExampleMainProjectSettings = function(demoName)
 		"bullet",
 		"mongo-c",
 		"ois",
+		"zlib",
 	}
 
 	if _OPTIONS[ "gfxapi" ] == "opengl" then
@@ -4,6 +4,11 @@
 
 #include "Dependencies/ois/includes/OIS.h"
 
+#include "Foundation/FileStream.h"
+#include "Foundation/Numeric.h"
+#include "Framework/WorldManager.h"
+#include "Platform/Timer.h"
+
 using namespace Helium;
 
 static int g_OisInitCount = 0;
@@ -12,19 +17,197 @@ static OIS::Keyboard *g_Keyboard = 0;
 static OIS::Mouse *g_Mouse = 0;
 
 #define MAX_KEY_STATES (256)
-char g_PreviousFrameKeyStates[MAX_KEY_STATES];
-int g_PreviousFrameMouseButtonState;
 
-void Input::Initialize(void *hWindow, bool bExclusive)
+// Everything the queries below can observe for one frame. Queries only ever read these (never the devices directly)
+// so that a replayed frame is indistinguishable from a live one.
+struct InputFrameState
 {
-	if (!g_OisInitCount++)
+	uint8_t m_KeyStates[ MAX_KEY_STATES / 8 ];
+	int32_t m_MouseButtons;
+	int32_t m_MouseX;
+	int32_t m_MouseY;
+	int32_t m_MouseRelX;
+	int32_t m_MouseRelY;
+	int32_t m_MouseWidth;
+	int32_t m_MouseHeight;
+
+	inline bool IsKeyDown( int keyCode ) const
+	{
+		return ( m_KeyStates[ keyCode >> 3 ] & ( 1 << ( keyCode & 7 ) ) ) != 0;
+	}
+
+	inline bool HasSameMouseState( const InputFrameState &rOther ) const
+	{
+		return m_MouseButtons == rOther.m_MouseButtons &&
+			m_MouseX == rOther.m_MouseX && m_MouseY == rOther.m_MouseY &&
+			m_MouseRelX == rOther.m_MouseRelX && m_MouseRelY == rOther.m_MouseRelY &&
+			m_MouseWidth == rOther.m_MouseWidth && m_MouseHeight == rOther.m_MouseHeight;
+	}
+};
+
+static InputFrameState g_CurrentFrameState;
+static InputFrameState g_PreviousFrameState;
+
+// Input recordings are a small header followed by one record per captured frame:
+//   uint8_t  flags (FRAME_FLAG_*)
+//   uint32_t frame delta, in ticks at the recorded tick rate
+//   uint8_t  key states[ MAX_KEY_STATES / 8 ]   (only if FRAME_FLAG_KEYS_CHANGED)
+//   int32_t  mouse buttons, x, y, rel x, rel y, width, height   (only if FRAME_FLAG_MOUSE_CHANGED)
+// Frames where nothing changed therefore cost five bytes.
+static const uint32_t INPUT_RECORDING_MAGIC = 0x48494e50;
+static const uint32_t INPUT_RECORDING_VERSION = 1;
+
+static const uint8_t FRAME_FLAG_KEYS_CHANGED  = 1 << 0;
+static const uint8_t FRAME_FLAG_MOUSE_CHANGED = 1 << 1;
+
+static FileStream *g_pRecordingFileStream = NULL;
+static BufferedStream *g_pRecordingStream = NULL;
+static bool g_bRecordingFirstFrame = false;
+
+static FileStream *g_pReplayFileStream = NULL;
+static BufferedStream *g_pReplayStream = NULL;
+static InputFrameState g_NextReplayFrameState;
+static uint64_t g_ReplayTicksPerSecond = 0;
+static uint64_t g_PreReplayFixedFrameDeltaTickCount = 0;
+
+static void CaptureDeviceState( InputFrameState &rState )
+{
+	HELIUM_ASSERT(g_Keyboard);
+	g_Keyboard->capture();
+
+	HELIUM_ASSERT(g_Mouse);
+	g_Mouse->capture();
+
+	char keyStates[ MAX_KEY_STATES ];
+	g_Keyboard->copyKeyStates( keyStates );
+
+	MemoryZero( rState.m_KeyStates, sizeof( rState.m_KeyStates ) );
+	for (int i = 0; i < MAX_KEY_STATES; ++i)
 	{
-		for (int i =0; i < MAX_KEY_STATES; ++i)
+		if ( keyStates[i] )
 		{
-			g_PreviousFrameKeyStates[i] = 0;
+			rState.m_KeyStates[ i >> 3 ] |= static_cast< uint8_t >( 1 << ( i & 7 ) );
 		}
+	}
+
+	const OIS::MouseState &mouseState = g_Mouse->getMouseState();
+	rState.m_MouseButtons = mouseState.buttons;
+	rState.m_MouseX = mouseState.X.abs;
+	rState.m_MouseY = mouseState.Y.abs;
+	rState.m_MouseRelX = mouseState.X.rel;
+	rState.m_MouseRelY = mouseState.Y.rel;
+	rState.m_MouseWidth = mouseState.width;
+	rState.m_MouseHeight = mouseState.height;
+}
 
-		g_PreviousFrameMouseButtonState = false;
+static void WriteMouseState( BufferedStream &rStream, const InputFrameState &rState )
+{
+	rStream.Write( &rState.m_MouseButtons, sizeof( rState.m_MouseButtons ), 1 );
+	rStream.Write( &rState.m_MouseX, sizeof( rState.m_MouseX ), 1 );
+	rStream.Write( &rState.m_MouseY, sizeof( rState.m_MouseY ), 1 );
+	rStream.Write( &rState.m_MouseRelX, sizeof( rState.m_MouseRelX ), 1 );
+	rStream.Write( &rState.m_MouseRelY, sizeof( rState.m_MouseRelY ), 1 );
+	rStream.Write( &rState.m_MouseWidth, sizeof( rState.m_MouseWidth ), 1 );
+	rStream.Write( &rState.m_MouseHeight, sizeof( rState.m_MouseHeight ), 1 );
+}
+
+static bool ReadMouseState( BufferedStream &rStream, InputFrameState &rState )
+{
+	return rStream.Read( &rState.m_MouseButtons, sizeof( rState.m_MouseButtons ), 1 ) == 1 &&
+		rStream.Read( &rState.m_MouseX, sizeof( rState.m_MouseX ), 1 ) == 1 &&
+		rStream.Read( &rState.m_MouseY, sizeof( rState.m_MouseY ), 1 ) == 1 &&
+		rStream.Read( &rState.m_MouseRelX, sizeof( rState.m_MouseRelX ), 1 ) == 1 &&
+		rStream.Read( &rState.m_MouseRelY, sizeof( rState.m_MouseRelY ), 1 ) == 1 &&
+		rStream.Read( &rState.m_MouseWidth, sizeof( rState.m_MouseWidth ), 1 ) == 1 &&
+		rStream.Read( &rState.m_MouseHeight, sizeof( rState.m_MouseHeight ), 1 ) == 1;
+}
+
+static void WriteRecordedFrame( const InputFrameState &rState, const InputFrameState &rPreviousState )
+{
+	HELIUM_ASSERT( g_pRecordingStream );
+
+	uint8_t flags = 0;
+	if ( g_bRecordingFirstFrame )
+	{
+		// Replays start from a blank state, so the first frame is always a keyframe
+		flags = FRAME_FLAG_KEYS_CHANGED | FRAME_FLAG_MOUSE_CHANGED;
+		g_bRecordingFirstFrame = false;
+	}
+	else if ( memcmp( rState.m_KeyStates, rPreviousState.m_KeyStates, sizeof( rState.m_KeyStates ) ) != 0 )
+	{
+		flags |= FRAME_FLAG_KEYS_CHANGED;
+	}
+
+	if ( !( flags & FRAME_FLAG_MOUSE_CHANGED ) && !rState.HasSameMouseState( rPreviousState ) )
+	{
+		flags |= FRAME_FLAG_MOUSE_CHANGED;
+	}
+
+	uint64_t deltaTickCount = WorldManager::GetStaticInstance().GetFrameDeltaTickCount();
+	HELIUM_ASSERT( deltaTickCount <= NumericLimits< uint32_t >::Maximum );
+	uint32_t recordedDeltaTickCount = static_cast< uint32_t >( deltaTickCount );
+
+	g_pRecordingStream->Write( &flags, sizeof( flags ), 1 );
+	g_pRecordingStream->Write( &recordedDeltaTickCount, sizeof( recordedDeltaTickCount ), 1 );
+
+	if ( flags & FRAME_FLAG_KEYS_CHANGED )
+	{
+		g_pRecordingStream->Write( rState.m_KeyStates, sizeof( rState.m_KeyStates ), 1 );
+	}
+
+	if ( flags & FRAME_FLAG_MOUSE_CHANGED )
+	{
+		WriteMouseState( *g_pRecordingStream, rState );
+	}
+}
+
+// Reads the next frame on top of rState (which must hold the previous frame, since unchanged state is omitted).
+static bool ReadReplayFrame( InputFrameState &rState, uint64_t &rDeltaTickCount )
+{
+	HELIUM_ASSERT( g_pReplayStream );
+
+	uint8_t flags = 0;
+	uint32_t recordedDeltaTickCount = 0;
+	if ( g_pReplayStream->Read( &flags, sizeof( flags ), 1 ) != 1 ||
+		g_pReplayStream->Read( &recordedDeltaTickCount, sizeof( recordedDeltaTickCount ), 1 ) != 1 )
+	{
+		return false;
+	}
+
+	if ( ( flags & FRAME_FLAG_KEYS_CHANGED ) &&
+		g_pReplayStream->Read( rState.m_KeyStates, sizeof( rState.m_KeyStates ), 1 ) != 1 )
+	{
+		return false;
+	}
+
+	if ( ( flags & FRAME_FLAG_MOUSE_CHANGED ) && !ReadMouseState( *g_pReplayStream, rState ) )
+	{
+		return false;
+	}
+
+	rDeltaTickCount = recordedDeltaTickCount;
+	if ( g_ReplayTicksPerSecond != Timer::GetTicksPerSecond() )
+	{
+		// Recorded on a machine with a different timer frequency; this is as close as we can get
+		rDeltaTickCount = static_cast< uint64_t >(
+			static_cast< float64_t >( recordedDeltaTickCount ) * static_cast< float64_t >( Timer::GetTicksPerSecond() ) / static_cast< float64_t >( g_ReplayTicksPerSecond ) + 0.5 );
+	}
+
+	// A fixed delta of zero means "use real time", so the (first frame only) zero delta has to be nudged
+	if ( rDeltaTickCount == 0 )
+	{
+		rDeltaTickCount = 1;
+	}
+
+	return true;
+}
+
+void Input::Initialize(void *hWindow, bool bExclusive)
+{
+	if (!g_OisInitCount++)
+	{
+		MemoryZero( &g_CurrentFrameState, sizeof( g_CurrentFrameState ) );
+		MemoryZero( &g_PreviousFrameState, sizeof( g_PreviousFrameState ) );
 
 		HELIUM_ASSERT(!g_InputSystem);
 
@@ -71,6 +254,9 @@ void Input::Cleanup()
 	--g_OisInitCount;
 	if (!g_OisInitCount)
 	{
+		StopRecording();
+		StopReplay();
+
 		HELIUM_ASSERT(g_InputSystem);
 		g_InputSystem->destroyInputSystem( g_InputSystem );
 		//mInputSystem->destroyInputSystem();
@@ -80,6 +266,11 @@ void Input::Cleanup()
 
 void Input::SetWindowSize(int x, int y)
 {
+	if ( !g_Mouse )
+	{
+		return;
+	}
+
 	const OIS::MouseState &mouseState = g_Mouse->getMouseState();
 	mouseState.width  = x;
 	mouseState.height = y;
@@ -87,57 +278,88 @@ void Input::SetWindowSize(int x, int y)
 
 void Input::Capture()
 {
-	g_Keyboard->copyKeyStates(g_PreviousFrameKeyStates);
-	g_PreviousFrameMouseButtonState = g_Mouse->getMouseState().buttons;
+	g_PreviousFrameState = g_CurrentFrameState;
 
-	HELIUM_ASSERT(g_Keyboard);
-	g_Keyboard->capture();
+	if ( g_pReplayStream )
+	{
+		// The next frame was read ahead so its delta could be handed to the WorldManager before this frame started
+		g_CurrentFrameState = g_NextReplayFrameState;
 
-	HELIUM_ASSERT(g_Mouse);
-	g_Mouse->capture();
+		uint64_t deltaTickCount = 0;
+		if ( ReadReplayFrame( g_NextReplayFrameState, deltaTickCount ) )
+		{
+			WorldManager::GetStaticInstance().SetFixedFrameDeltaTickCount( deltaTickCount );
+		}
+		else
+		{
+			HELIUM_TRACE( TraceLevels::Info, TXT( "Input::Capture(): Reached the end of the input replay.\n" ) );
+			StopReplay();
+		}
+	}
+	else
+	{
+		CaptureDeviceState( g_CurrentFrameState );
+	}
+
+	if ( g_pRecordingStream )
+	{
+		WriteRecordedFrame( g_CurrentFrameState, g_PreviousFrameState );
+	}
 }
 
 bool Input::IsKeyDown(Input::KeyCode keyCode)
 {
-	HELIUM_ASSERT(g_Keyboard);
-	return g_Keyboard->isKeyDown(static_cast<OIS::KeyCode>(keyCode));
+	return g_CurrentFrameState.IsKeyDown( keyCode );
 }
 
 bool Input::WasKeyPressedThisFrame(Input::KeyCode keyCode)
 {
-	HELIUM_ASSERT(g_Keyboard);
-	return !g_PreviousFrameKeyStates[keyCode] && g_Keyboard->isKeyDown(static_cast<OIS::KeyCode>(keyCode));
+	return !g_PreviousFrameState.IsKeyDown( keyCode ) && g_CurrentFrameState.IsKeyDown( keyCode );
 }
 
 bool Input::IsModifierDown(Input::KeyboardModifier keyCode)
 {
-	HELIUM_ASSERT(g_Keyboard);
-	return g_Keyboard->isModifierDown(static_cast< OIS::Keyboard::Modifier >(keyCode));
+	// Worked out from the key states (as OIS does) so replays don't need to store modifiers separately
+	switch ( keyCode )
+	{
+	case KeyboardModifiers::Shift:
+		return g_CurrentFrameState.IsKeyDown( KeyCodes::KC_LSHIFT ) || g_CurrentFrameState.IsKeyDown( KeyCodes::KC_RSHIFT );
+
+	case KeyboardModifiers::Ctrl:
+		return g_CurrentFrameState.IsKeyDown( KeyCodes::KC_LCONTROL ) || g_CurrentFrameState.IsKeyDown( KeyCodes::KC_RCONTROL );
+
+	case KeyboardModifiers::Alt:
+		return g_CurrentFrameState.IsKeyDown( KeyCodes::KC_LMENU ) || g_CurrentFrameState.IsKeyDown( KeyCodes::KC_RMENU );
+	}
+
+	return false;
 }
 
 bool Input::IsMouseButtonDown( MouseButton button )
 {
-	return (g_Mouse->getMouseState().buttons & button) != 0;
+	return (g_CurrentFrameState.m_MouseButtons & button) != 0;
 }
 
 bool Input::WasMouseButtonPressedThisFrame( MouseButton button )
 {
-	return IsMouseButtonDown( button ) && ( (g_PreviousFrameMouseButtonState & button) == 0 );
+	return IsMouseButtonDown( button ) && ( (g_PreviousFrameState.m_MouseButtons & button) == 0 );
 }
 
 Point Input::GetMousePos()
 {
-	HELIUM_ASSERT(g_Mouse);
-	return Point( g_Mouse->getMouseState().X.abs, g_Mouse->getMouseState().X.abs);
+	return Point( g_CurrentFrameState.m_MouseX, g_CurrentFrameState.m_MouseY );
 }
 
 Simd::Vector2 Input::GetMousePosNormalized()
 {
-	HELIUM_ASSERT(g_Mouse);
+	if ( !g_CurrentFrameState.m_MouseWidth || !g_CurrentFrameState.m_MouseHeight )
+	{
+		return Simd::Vector2::Zero;
+	}
 
 	Simd::Vector2 v2( 
-		(static_cast<float>(g_Mouse->getMouseState().X.abs) / static_cast<float>(g_Mouse->getMouseState().width) - 0.5f) * 2.0f, 
-		(static_cast<float>(g_Mouse->getMouseState().Y.abs) / static_cast<float>(g_Mouse->getMouseState().height) - 0.5f) * -2.0f
+		(static_cast<float>(g_CurrentFrameState.m_MouseX) / static_cast<float>(g_CurrentFrameState.m_MouseWidth) - 0.5f) * 2.0f, 
+		(static_cast<float>(g_CurrentFrameState.m_MouseY) / static_cast<float>(g_CurrentFrameState.m_MouseHeight) - 0.5f) * -2.0f
 		);
 
 	return v2;
@@ -146,6 +368,142 @@ Simd::Vector2 Input::GetMousePosNormalized()
 Simd::Vector2 Input::GetMousePosDelta()
 {
 	return Simd::Vector2(
-		static_cast<float>(g_Mouse->getMouseState().X.rel),
-		static_cast<float>(g_Mouse->getMouseState().Y.rel));
+		static_cast<float>(g_CurrentFrameState.m_MouseRelX),
+		static_cast<float>(g_CurrentFrameState.m_MouseRelY));
+}
+
+bool Input::StartRecording( const char *pFileName )
+{
+	HELIUM_ASSERT( pFileName );
+
+	StopRecording();
+
+	g_pRecordingFileStream = FileStream::OpenFileStream( pFileName, FileStream::MODE_WRITE, true );
+	if ( !g_pRecordingFileStream )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Input::StartRecording(): Failed to open \"%s\" for writing.\n" ), pFileName );
+		return false;
+	}
+
+	g_pRecordingStream = new BufferedStream( g_pRecordingFileStream );
+	HELIUM_ASSERT( g_pRecordingStream );
+
+	uint64_t ticksPerSecond = Timer::GetTicksPerSecond();
+	g_pRecordingStream->Write( &INPUT_RECORDING_MAGIC, sizeof( INPUT_RECORDING_MAGIC ), 1 );
+	g_pRecordingStream->Write( &INPUT_RECORDING_VERSION, sizeof( INPUT_RECORDING_VERSION ), 1 );
+	g_pRecordingStream->Write( &ticksPerSecond, sizeof( ticksPerSecond ), 1 );
+
+	g_bRecordingFirstFrame = true;
+
+	return true;
+}
+
+void Input::StopRecording()
+{
+	delete g_pRecordingStream;
+	g_pRecordingStream = NULL;
+
+	delete g_pRecordingFileStream;
+	g_pRecordingFileStream = NULL;
+}
+
+bool Input::IsRecording()
+{
+	return g_pRecordingStream != NULL;
+}
+
+bool Input::StartReplay( const char *pFileName )
+{
+	HELIUM_ASSERT( pFileName );
+
+	StopReplay();
+
+	WorldManager &rWorldManager = WorldManager::GetStaticInstance();
+	g_PreReplayFixedFrameDeltaTickCount = rWorldManager.GetFixedFrameDeltaTickCount();
+
+	g_pReplayFileStream = FileStream::OpenFileStream( pFileName, FileStream::MODE_READ );
+	if ( !g_pReplayFileStream )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Input::StartReplay(): Failed to open \"%s\" for reading.\n" ), pFileName );
+		return false;
+	}
+
+	g_pReplayStream = new BufferedStream( g_pReplayFileStream );
+	HELIUM_ASSERT( g_pReplayStream );
+
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	if ( g_pReplayStream->Read( &magic, sizeof( magic ), 1 ) != 1 ||
+		g_pReplayStream->Read( &version, sizeof( version ), 1 ) != 1 ||
+		g_pReplayStream->Read( &g_ReplayTicksPerSecond, sizeof( g_ReplayTicksPerSecond ), 1 ) != 1 ||
+		magic != INPUT_RECORDING_MAGIC ||
+		version != INPUT_RECORDING_VERSION ||
+		g_ReplayTicksPerSecond == 0 )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Input::StartReplay(): \"%s\" is not a valid input recording.\n" ), pFileName );
+		StopReplay();
+		return false;
+	}
+
+	if ( g_ReplayTicksPerSecond != Timer::GetTicksPerSecond() )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "Input::StartReplay(): \"%s\" was recorded with a different timer frequency, frame deltas will be rescaled and the replay may not be exact.\n" ),
+			pFileName );
+	}
+
+	MemoryZero( &g_NextReplayFrameState, sizeof( g_NextReplayFrameState ) );
+
+	uint64_t deltaTickCount = 0;
+	if ( !ReadReplayFrame( g_NextReplayFrameState, deltaTickCount ) )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "Input::StartReplay(): \"%s\" contains no frames.\n" ), pFileName );
+		StopReplay();
+		return false;
+	}
+
+	rWorldManager.SetFixedFrameDeltaTickCount( deltaTickCount );
+
+	return true;
+}
+
+void Input::StopReplay()
+{
+	if ( g_pReplayStream )
+	{
+		WorldManager::GetStaticInstance().SetFixedFrameDeltaTickCount( g_PreReplayFixedFrameDeltaTickCount );
+	}
+
+	delete g_pReplayStream;
+	g_pReplayStream = NULL;
+
+	delete g_pReplayFileStream;
+	g_pReplayFileStream = NULL;
+}
+
+bool Input::IsReplaying()
+{
+	return g_pReplayStream != NULL;
+}
+
+void Input::HandleCommandLine( const DynamicArray< String > &rArguments )
+{
+	const size_t argumentCount = rArguments.GetSize();
+	for ( size_t argumentIndex = 0; argumentIndex + 1 < argumentCount; ++argumentIndex )
+	{
+		const String &rArgument = rArguments[ argumentIndex ];
+		const String &rFileName = rArguments[ argumentIndex + 1 ];
+
+		if ( rArgument == TXT( "-recordinput" ) )
+		{
+			StartRecording( *rFileName );
+			++argumentIndex;
+		}
+		else if ( rArgument == TXT( "-replayinput" ) )
+		{
+			StartReplay( *rFileName );
+			++argumentIndex;
+		}
+	}
 }
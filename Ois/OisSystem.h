@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Ois/Ois.h"
+#include "Foundation/DynamicArray.h"
+#include "Foundation/String.h"
 #include "Math/Point.h"
 #include "MathSimd/Vector2.h"
 
@@ -210,5 +212,22 @@ namespace Helium
 		HELIUM_OIS_API Point GetMousePos();
 		HELIUM_OIS_API Simd::Vector2 GetMousePosNormalized();
 		HELIUM_OIS_API Simd::Vector2 GetMousePosDelta();
+
+		/// @name Recording and Replay
+		//@{
+		// Recording writes the device state seen by Capture() each frame, along with the frame delta, to a file.
+		// Replaying feeds that file back through Capture() instead of the devices (none need to exist, so this
+		// works headless) and drives the WorldManager at the recorded frame deltas, reproducing the session exactly.
+		HELIUM_OIS_API bool StartRecording( const char *pFileName );
+		HELIUM_OIS_API void StopRecording();
+		HELIUM_OIS_API bool IsRecording();
+
+		HELIUM_OIS_API bool StartReplay( const char *pFileName );
+		HELIUM_OIS_API void StopReplay();
+		HELIUM_OIS_API bool IsReplaying();
+
+		// Starts recording or replaying if "-recordinput <file>" or "-replayinput <file>" was passed
+		HELIUM_OIS_API void HandleCommandLine( const DynamicArray< String > &rArguments );
+		//@}
 	}
 }
\ No newline at end of file
@@ -2,6 +2,8 @@
 #include "AssetPreprocessor.h"
 
 #include "Platform/File.h"
+#include "Platform/Thread.h"
+#include "Platform/Timer.h"
 #include "Foundation/FilePath.h"
 #include "Foundation/FileStream.h"
 #include "Foundation/MemoryStream.h"
@@ -13,14 +15,60 @@
 #include "Engine/Config.h"
 #include "PcSupport/PlatformPreprocessor.h"
 #include "PcSupport/ResourceHandler.h"
+#include "PcSupport/DerivedDataCache.h"
+#include "PcSupport/CookRecordTable.h"
 #include "Engine/PackageLoader.h"
 
 using namespace Helium;
 
 AssetPreprocessor* AssetPreprocessor::sm_pInstance = NULL;
 
+#if HELIUM_TOOLS
+namespace Helium
+{
+	/// Runnable for preprocessing deferred resources on a worker thread.
+	class AssetPreprocessor::PreprocessWorker : public Runnable
+	{
+	public:
+		/// Preprocessor whose deferred resources are being preprocessed.
+		AssetPreprocessor& m_rPreprocessor;
+
+		/// @name Construction/Destruction
+		//@{
+		explicit PreprocessWorker( AssetPreprocessor& rPreprocessor );
+		//@}
+
+		/// @name Runnable Interface
+		//@{
+		virtual void Run();
+		//@}
+	};
+}
+
+/// Constructor.
+///
+/// @param[in] rPreprocessor  Preprocessor whose deferred resources are being preprocessed.
+AssetPreprocessor::PreprocessWorker::PreprocessWorker( AssetPreprocessor& rPreprocessor )
+	: m_rPreprocessor( rPreprocessor )
+{
+}
+
+/// Preprocess deferred resources until none are left.
+void AssetPreprocessor::PreprocessWorker::Run()
+{
+	m_rPreprocessor.PreprocessDeferredResources();
+}
+#endif  // HELIUM_TOOLS
+
 /// Constructor.
 AssetPreprocessor::AssetPreprocessor()
+	: m_pDerivedDataCache( NULL )
+	, m_pCookRecordTable( NULL )
+	, m_bDryRun( false )
+	, m_bDeferPreprocessing( false )
+	, m_deferredResourceCounter( 0 )
+	, m_preprocessedResourceCondition( false, false )
+	, m_cacheFailureCount( 0 )
 {
 	MemoryZero( m_pPlatformPreprocessors, sizeof( m_pPlatformPreprocessors ) );
 }
@@ -32,6 +80,19 @@ AssetPreprocessor::~AssetPreprocessor()
 	{
 		delete m_pPlatformPreprocessors[ platformIndex ];
 	}
+
+	delete m_pDerivedDataCache;
+
+	if( m_pCookRecordTable )
+	{
+		// Nothing is cooked in dry-run mode, so the table on disk must be left as is.
+		if( !m_bDryRun )
+		{
+			m_pCookRecordTable->Save();
+		}
+
+		delete m_pCookRecordTable;
+	}
 }
 
 /// Set the platform preprocessor to use for caching objects and processing resources for a specific platform.
@@ -50,6 +111,147 @@ void AssetPreprocessor::SetPlatformPreprocessor( Cache::EPlatform platform, Plat
 	m_pPlatformPreprocessors[ platform ] = pPreprocessor;
 }
 
+/// Set the derived data cache to consult before preprocessing resources.
+///
+/// @param[in] pDerivedDataCache  Derived data cache to use, or null to always preprocess resources from their source
+///                               data.  Note that this will assume ownership of the cache instance, deleting it
+///                               automatically once it is replaced or the asset preprocessor is destroyed.
+///
+/// @see GetDerivedDataCache()
+void AssetPreprocessor::SetDerivedDataCache( DerivedDataCache* pDerivedDataCache )
+{
+	if( pDerivedDataCache != m_pDerivedDataCache )
+	{
+		delete m_pDerivedDataCache;
+		m_pDerivedDataCache = pDerivedDataCache;
+	}
+}
+
+/// Set the table used to track the inputs from which each object was last cooked.
+///
+/// @param[in] pCookRecordTable  Cook record table to use, or null to compare cache entry timestamps instead.  Note
+///                              that this will assume ownership of the table, saving (unless in dry-run mode) and
+///                              deleting it automatically once it is replaced or the asset preprocessor is destroyed.
+///
+/// @see GetCookRecordTable()
+void AssetPreprocessor::SetCookRecordTable( CookRecordTable* pCookRecordTable )
+{
+	if( pCookRecordTable != m_pCookRecordTable )
+	{
+		if( m_pCookRecordTable )
+		{
+			if( !m_bDryRun )
+			{
+				m_pCookRecordTable->Save();
+			}
+
+			delete m_pCookRecordTable;
+		}
+
+		m_pCookRecordTable = pCookRecordTable;
+	}
+}
+
+/// Report an additional file read while preprocessing a resource (such as a shader include file), so that the
+/// resource is recooked when the file changes.
+///
+/// The resource's asset file and source file are tracked automatically, so this only needs to be called for any other
+/// files a resource handler reads.  This can be called from any preprocessing thread.
+///
+/// @param[in] path       Path of the resource being preprocessed.
+/// @param[in] rFileName  Name of the file read.
+void AssetPreprocessor::AddResourceInput( const AssetPath& path, const String& rFileName )
+{
+#if HELIUM_TOOLS
+	HELIUM_ASSERT( !path.IsEmpty() );
+
+	MutexScopeLock scopeLock( m_resourceInputLock );
+
+	HashMap< AssetPath, DynamicArray< String > >::Iterator inputIterator;
+	m_resourceInputs.Insert( inputIterator, KeyValue< AssetPath, DynamicArray< String > >( path, DynamicArray< String >() ) );
+	inputIterator->Second().Push( rFileName );
+#else
+	HELIUM_UNREF( path );
+	HELIUM_UNREF( rFileName );
+#endif
+}
+
+/// Get the files a resource is known to have been cooked from, for resource handlers whose output is built from the
+/// preprocessed data of other resources (such as materials, which are built from shader variants).
+///
+/// This includes the files reported through AddResourceInput() for a resource preprocessed in this session and not
+/// yet cached, along with the inputs recorded in the cook record table when it was last cooked.  This can be called
+/// from any preprocessing thread.
+///
+/// @param[in]  path        Path of the resource.
+/// @param[out] rFileNames  Input file names.
+///
+/// @see AddResourceInput()
+void AssetPreprocessor::GetResourceInputs( const AssetPath& path, DynamicArray< String >& rFileNames ) const
+{
+	rFileNames.Resize( 0 );
+
+#if HELIUM_TOOLS
+	HELIUM_ASSERT( !path.IsEmpty() );
+
+	{
+		MutexScopeLock scopeLock( m_resourceInputLock );
+
+		HashMap< AssetPath, DynamicArray< String > >::ConstIterator inputIterator = m_resourceInputs.Find( path );
+		if( inputIterator != m_resourceInputs.End() )
+		{
+			const DynamicArray< String >& rResourceInputs = inputIterator->Second();
+			rFileNames.AddArray( rResourceInputs.GetData(), rResourceInputs.GetSize() );
+		}
+	}
+
+	CookRecordTable::Record record;
+	if( m_pCookRecordTable && m_pCookRecordTable->GetRecord( path, record ) )
+	{
+		size_t inputCount = record.inputs.GetSize();
+		for( size_t inputIndex = 0; inputIndex < inputCount; ++inputIndex )
+		{
+			rFileNames.Push( record.inputs[ inputIndex ].fileName );
+		}
+	}
+#else
+	HELIUM_UNREF( path );
+#endif
+}
+
+/// Set whether out-of-date objects should only be recorded instead of being preprocessed and cached.
+///
+/// Enabling dry-run mode clears any objects previously recorded as out of date.
+///
+/// @param[in] bDryRun  True to enable dry-run mode, false to disable it.
+///
+/// @see IsDryRun(), GetStaleAssets()
+void AssetPreprocessor::SetDryRun( bool bDryRun )
+{
+	m_bDryRun = bDryRun;
+
+	if( bDryRun )
+	{
+		MutexScopeLock scopeLock( m_staleAssetLock );
+		m_staleAssets.Clear();
+		m_staleAssetPaths.Clear();
+	}
+}
+
+/// Get the objects found to be out of date in dry-run mode.
+///
+/// @param[out] rStaleAssets  Out-of-date objects, in the order in which they were found, along with the reason each
+///                           would be recooked.
+///
+/// @see SetDryRun(), IsDryRun()
+void AssetPreprocessor::GetStaleAssets( DynamicArray< StaleAsset >& rStaleAssets ) const
+{
+	MutexScopeLock scopeLock( m_staleAssetLock );
+
+	rStaleAssets.Resize( 0 );
+	rStaleAssets.AddArray( m_staleAssets.GetData(), m_staleAssets.GetSize() );
+}
+
 /// Cache an object for all registered platforms.
 ///
 /// @param[in] pObject                                 Asset to cache.
@@ -73,6 +275,16 @@ bool AssetPreprocessor::CacheObject(
 
 	HELIUM_ASSERT( pObject );
 
+	// Resources queued for deferred preprocessing are cached once their preprocessing has finished.
+	if( m_bDeferPreprocessing &&
+		m_deferredResourceIndices.Find( objectPath ) != m_deferredResourceIndices.End() )
+	{
+		return true;
+	}
+
+	// Cache writes are serialized, as the caches do not support being written to from several threads at once.
+	MutexScopeLock cacheLock( m_cacheLock );
+
 	bool bCacheFailure = false;
 
 	DynamicArray< uint8_t > objectStreamBuffer;
@@ -106,6 +318,10 @@ bool AssetPreprocessor::CacheObject(
 
 	bool bUpdatedAnyCache = false;
 
+	// With cook records, the object is only out of date if one of the inputs it was last cooked from has changed.
+	String staleReason;
+	bool bRecordUpToDate = ( m_pCookRecordTable && CheckCookRecord( objectPath, pObject, staleReason ) );
+
 	for( size_t platformIndex = 0; platformIndex < HELIUM_ARRAY_COUNT( m_pPlatformPreprocessors ); ++platformIndex )
 	{
 		// Don't cache on platforms for which we don't have a preprocessor.
@@ -122,15 +338,31 @@ bool AssetPreprocessor::CacheObject(
 
 		// Don't recache the object if an up-to-date cache entry already exists for it.
 		const Cache::Entry* pEntry = pCache->FindEntry( objectPath, 0 );
-		if( pEntry && pEntry->timestamp == timestamp )
+		if( !pEntry )
+		{
+			staleReason = TXT( "not in the cache" );
+		}
+		else if( m_pCookRecordTable ? bRecordUpToDate : pEntry->timestamp == timestamp )
+		{
+			continue;
+		}
+		else if( !m_pCookRecordTable )
+		{
+			staleReason = TXT( "timestamp changed" );
+		}
+
+		if( m_bDryRun )
 		{
+			AddStaleAsset( objectPath, staleReason );
+
 			continue;
 		}
 
 		HELIUM_TRACE(
 			TraceLevels::Info,
-			TXT( "AssetPreprocessor: Object \"%s\" is out of date.  Recaching...\n" ),
-			*objectPath.ToString() );
+			TXT( "AssetPreprocessor: Object \"%s\" is out of date (%s).  Recaching...\n" ),
+			*objectPath.ToString(),
+			*staleReason );
 
 		bUpdatedAnyCache = true;
 
@@ -270,10 +502,20 @@ bool AssetPreprocessor::CacheObject(
 		}
 	}
 
-	// Notify the object that it has been cached.
+	// Notify the object that it has been cached, and record the inputs it was cooked from.
 	if( bUpdatedAnyCache )
 	{
 		pObject->PostSave();
+
+		if( m_pCookRecordTable && !bCacheFailure )
+		{
+			SetCookRecord( objectPath, pObject );
+		}
+	}
+
+	if( bCacheFailure )
+	{
+		AtomicIncrement( m_cacheFailureCount );
 	}
 
 	return !bCacheFailure;
@@ -302,25 +544,9 @@ void AssetPreprocessor::LoadResourceData( const AssetPath &resourcePath, Resourc
 	HELIUM_ASSERT( pResource );
 
 	// Locate the source asset file of the source template resource and combine its timestamp with the object timestamp.
-	// This will be the asset that extends the default asset (i.e. test.png, which would have Helium::Texture2D as template)
-	Resource* pSourceResource = pResource;
-	Asset* pTestTemplate = Reflect::AssertCast< Asset >( pResource->GetTemplate() );
-	while( pTestTemplate && !pTestTemplate->IsDefaultTemplate() )
-	{
-		pSourceResource = Reflect::AssertCast< Resource >( pTestTemplate );
-		pTestTemplate = Reflect::AssertCast< Asset >( pSourceResource->GetTemplate() );
-	}
-
-	AssetPath parentPath = pSourceResource == pResource ? resourcePath : pSourceResource->GetPath();
+	String sourceFilePath;
 	AssetPath baseResourcePath;
-	do
-	{
-		baseResourcePath = parentPath;
-		parentPath = parentPath.GetParent();
-	} while( !parentPath.IsEmpty() && !parentPath.IsPackage() );
-
-	FilePath sourceFilePath;
-	if ( !FileLocations::GetDataDirectory( sourceFilePath ) )
+	if( !GetSourceFilePath( resourcePath, pResource, sourceFilePath, baseResourcePath ) )
 	{
 		HELIUM_TRACE(
 			TraceLevels::Error,
@@ -329,16 +555,18 @@ void AssetPreprocessor::LoadResourceData( const AssetPath &resourcePath, Resourc
 		return;
 	}
 
-	sourceFilePath += baseResourcePath.ToFilePathString().GetData();
-
 	Helium::Status stat;
-	stat.Read( sourceFilePath );
+	stat.Read( *sourceFilePath );
 
 	int64_t sourceFileTimestamp = stat.m_ModifiedTime;
 	int64_t assetFileTimestamp = AssetLoader::GetAssetFileTimestamp( baseResourcePath );
 
 	int64_t timestamp = Max( assetFileTimestamp, sourceFileTimestamp );
 
+	// With cook records, the resource is only out of date if one of the inputs it was last cooked from has changed.
+	String staleReason;
+	bool bRecordUpToDate = ( m_pCookRecordTable && CheckCookRecord( resourcePath, pResource, staleReason ) );
+
 	// Check if data is loaded for each supported platform, attempting to load the data from the cache if it exists
 	// and is up-to-date.
 	size_t platformIndex;
@@ -371,13 +599,23 @@ void AssetPreprocessor::LoadResourceData( const AssetPath &resourcePath, Resourc
 		pCache->EnforceTocLoad();
 
 		const Cache::Entry* pCacheEntry = pCache->FindEntry( resourcePath, 0 );
-		if( !pCacheEntry || pCacheEntry->timestamp != timestamp )
+		if( !pCacheEntry )
+		{
+			staleReason = TXT( "not in the cache" );
+		}
+		else if( !m_pCookRecordTable && pCacheEntry->timestamp != timestamp )
+		{
+			staleReason = TXT( "timestamp changed" );
+		}
+
+		if( !pCacheEntry || ( m_pCookRecordTable ? !bRecordUpToDate : pCacheEntry->timestamp != timestamp ) )
 		{
 			HELIUM_TRACE(
 				TraceLevels::Info,
 				( TXT( "AssetPreprocessor::LoadResourceData(): Cached resource data not found or is out-of-date " )
-				TXT( "for resource \"%s\".  Resource will be preprocessed.\n" ) ),
-				*resourcePath.ToString() );
+				TXT( "for resource \"%s\" (%s).  Resource will be preprocessed.\n" ) ),
+				*resourcePath.ToString(),
+				*staleReason );
 
 			break;
 		}
@@ -391,6 +629,8 @@ void AssetPreprocessor::LoadResourceData( const AssetPath &resourcePath, Resourc
 				TXT( "\"%s\".  Resource will be preprocessed again.\n" ) ),
 				*resourcePath.ToString() );
 
+			staleReason = TXT( "cached data could not be read" );
+
 			break;
 		}
 	}
@@ -401,8 +641,45 @@ void AssetPreprocessor::LoadResourceData( const AssetPath &resourcePath, Resourc
 		return;
 	}
 
+	// Only record that the resource would be preprocessed in dry-run mode.
+	if( m_bDryRun )
+	{
+		AddStaleAsset( resourcePath, staleReason );
+
+		return;
+	}
+
+	// Queue the resource for preprocessing on a worker thread if preprocessing is being deferred and its handler
+	// supports it.
+	if( m_bDeferPreprocessing )
+	{
+		ResourceHandler* pResourceHandler = ResourceHandler::FindResourceHandlerForType( pResource->GetAssetType() );
+		if( pResourceHandler && pResourceHandler->CanCacheConcurrently() )
+		{
+			HashMap< AssetPath, size_t >::Iterator indexIterator = m_deferredResourceIndices.Find( resourcePath );
+			if( indexIterator == m_deferredResourceIndices.End() )
+			{
+				size_t resourceIndex = m_deferredResources.GetSize();
+
+				DeferredResource* pDeferredResource = m_deferredResources.New();
+				HELIUM_ASSERT( pDeferredResource );
+				pDeferredResource->path = resourcePath;
+				pDeferredResource->spResource = pResource;
+				pDeferredResource->sourceFilePath = sourceFilePath;
+				pDeferredResource->timestamp = timestamp;
+				pDeferredResource->bSucceeded = false;
+
+				m_deferredResourceIndices.Insert(
+					indexIterator,
+					KeyValue< AssetPath, size_t >( resourcePath, resourceIndex ) );
+			}
+
+			return;
+		}
+	}
+
 	// Preprocess all resources for each supported platform.
-	if( !PreprocessResource( resourcePath, pResource, String( sourceFilePath.c_str() ) ) )
+	if( !PreprocessResource( resourcePath, pResource, sourceFilePath ) )
 	{
 		HELIUM_TRACE(
 			TraceLevels::Error,
@@ -418,6 +695,225 @@ void AssetPreprocessor::LoadResourceData( const AssetPath &resourcePath, Resourc
 }
 
 
+/// Begin deferring resource preprocessing.
+///
+/// Until EndDeferredPreprocessing() is called, LoadResourceData() queues out-of-date resources whose handlers support
+/// concurrent caching instead of preprocessing them immediately, and caching of the queued resources is postponed
+/// until they have been preprocessed.  Queued resources have no preprocessed data in the meantime, so this is only
+/// meant for cooking, where resources are loaded in order to cache them rather than to use them.
+///
+/// @see EndDeferredPreprocessing(), IsDeferringPreprocessing()
+void AssetPreprocessor::BeginDeferredPreprocessing()
+{
+#if HELIUM_TOOLS
+	HELIUM_ASSERT( !m_bDeferPreprocessing );
+	m_bDeferPreprocessing = true;
+#endif
+}
+
+/// Stop deferring resource preprocessing, preprocessing all queued resources on a pool of worker threads.
+///
+/// Resources are cached on the calling thread as they finish preprocessing, so only one thread writes to the caches
+/// at a time.  This blocks until all queued resources have been preprocessed and cached.
+///
+/// @param[in] workerCount  Number of worker threads to use.
+///
+/// @return  True if all queued resources were preprocessed and cached successfully, false if any failed.
+///
+/// @see BeginDeferredPreprocessing(), FlushDeferredPreprocessing(), IsDeferringPreprocessing()
+bool AssetPreprocessor::EndDeferredPreprocessing( size_t workerCount )
+{
+#if HELIUM_TOOLS
+
+	HELIUM_ASSERT( m_bDeferPreprocessing );
+	m_bDeferPreprocessing = false;
+
+	return PreprocessQueuedResources( workerCount );
+
+#else  // HELIUM_TOOLS
+
+	HELIUM_UNREF( workerCount );
+
+	return true;
+
+#endif  // HELIUM_TOOLS
+}
+
+/// Preprocess and cache all resources queued so far, while continuing to defer the preprocessing of resources loaded
+/// afterward.
+///
+/// Queued resources are held in memory until they have been cached, so this should be called periodically when
+/// loading a large number of resources (e.g. once per batch of loads) to bound memory use.  As with
+/// EndDeferredPreprocessing(), this blocks until the queued resources have been preprocessed and cached, and must not
+/// be called while resources are still being loaded.
+///
+/// @param[in] workerCount  Number of worker threads to use.
+///
+/// @return  True if all queued resources were preprocessed and cached successfully, false if any failed.
+///
+/// @see EndDeferredPreprocessing(), GetDeferredResourceCount()
+bool AssetPreprocessor::FlushDeferredPreprocessing( size_t workerCount )
+{
+#if HELIUM_TOOLS
+
+	HELIUM_ASSERT( m_bDeferPreprocessing );
+
+	// Queued resources are only cached by CacheObject() while preprocessing is not being deferred.
+	m_bDeferPreprocessing = false;
+	bool bSucceeded = PreprocessQueuedResources( workerCount );
+	m_bDeferPreprocessing = true;
+
+	return bSucceeded;
+
+#else  // HELIUM_TOOLS
+
+	HELIUM_UNREF( workerCount );
+
+	return true;
+
+#endif  // HELIUM_TOOLS
+}
+
+#if HELIUM_TOOLS
+/// Preprocess all queued resources on a pool of worker threads, caching them on the calling thread as they finish.
+///
+/// The queue is empty once this returns.
+///
+/// @param[in] workerCount  Number of worker threads to use.
+///
+/// @return  True if all queued resources were preprocessed and cached successfully, false if any failed.
+bool AssetPreprocessor::PreprocessQueuedResources( size_t workerCount )
+{
+	HELIUM_ASSERT( !m_bDeferPreprocessing );
+
+	size_t resourceCount = m_deferredResources.GetSize();
+	if( resourceCount == 0 )
+	{
+		return true;
+	}
+
+	workerCount = Clamp( workerCount, static_cast< size_t >( 1 ), resourceCount );
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		( TXT( "AssetPreprocessor::PreprocessQueuedResources(): Preprocessing %" ) PRIuSZ TXT( " resources on %" )
+		  PRIuSZ TXT( " worker threads.\n" ) ),
+		resourceCount,
+		workerCount );
+
+	AtomicExchangeRelease( m_deferredResourceCounter, 0 );
+	m_preprocessedResourceIndices.Resize( 0 );
+	m_preprocessedResourceCondition.Reset();
+
+	DynamicArray< PreprocessWorker* > workers;
+	DynamicArray< RunnableThread* > threads;
+	workers.Reserve( workerCount );
+	threads.Reserve( workerCount );
+
+	String threadName;
+	for( size_t workerIndex = 0; workerIndex < workerCount; ++workerIndex )
+	{
+		PreprocessWorker* pWorker = new PreprocessWorker( *this );
+		HELIUM_ASSERT( pWorker );
+		workers.Push( pWorker );
+
+		RunnableThread* pThread = new RunnableThread( pWorker );
+		HELIUM_ASSERT( pThread );
+		threads.Push( pThread );
+
+		threadName.Format( TXT( "AssetPreprocessor - preprocessing %" ) PRIuSZ, workerIndex );
+		HELIUM_VERIFY( pThread->Start( threadName.GetData() ) );
+	}
+
+	// Cache resources as they finish preprocessing.
+	bool bSucceeded = true;
+
+	DynamicArray< size_t > preprocessedIndices;
+	size_t cachedCount = 0;
+	while( cachedCount < resourceCount )
+	{
+		m_preprocessedResourceCondition.Wait();
+
+		preprocessedIndices.Resize( 0 );
+		{
+			MutexScopeLock scopeLock( m_preprocessedResourceLock );
+			preprocessedIndices.AddArray(
+				m_preprocessedResourceIndices.GetData(),
+				m_preprocessedResourceIndices.GetSize() );
+			m_preprocessedResourceIndices.Resize( 0 );
+		}
+
+		size_t preprocessedCount = preprocessedIndices.GetSize();
+		for( size_t preprocessedIndex = 0; preprocessedIndex < preprocessedCount; ++preprocessedIndex )
+		{
+			DeferredResource& rDeferredResource = m_deferredResources[ preprocessedIndices[ preprocessedIndex ] ];
+			Resource* pResource = Reflect::AssertCast< Resource >( rDeferredResource.spResource.Get() );
+			HELIUM_ASSERT( pResource );
+
+			if( !rDeferredResource.bSucceeded )
+			{
+				HELIUM_TRACE(
+					TraceLevels::Error,
+					TXT( "AssetPreprocessor::PreprocessQueuedResources(): Preprocessing of resource \"%s\" failed.\n" ),
+					*rDeferredResource.path.ToString() );
+
+				bSucceeded = false;
+			}
+			else if( !pResource->GetAnyFlagSet( Asset::FLAG_BROKEN ) &&
+				!CacheObject( rDeferredResource.path, pResource, rDeferredResource.timestamp ) )
+			{
+				bSucceeded = false;
+			}
+
+			rDeferredResource.spResource.Release();
+		}
+
+		cachedCount += preprocessedCount;
+	}
+
+	for( size_t threadIndex = 0; threadIndex < threads.GetSize(); ++threadIndex )
+	{
+		RunnableThread* pThread = threads[ threadIndex ];
+		HELIUM_ASSERT( pThread );
+		pThread->Join();
+		delete pThread;
+	}
+
+	for( size_t workerIndex = 0; workerIndex < workers.GetSize(); ++workerIndex )
+	{
+		delete workers[ workerIndex ];
+	}
+
+	m_deferredResources.Resize( 0 );
+	m_deferredResourceIndices.Clear();
+
+	return bSucceeded;
+}
+#endif  // HELIUM_TOOLS
+
+/// Get the resource preprocessing statistics for each resource handler used since the statistics were last reset.
+///
+/// @param[out] rStats  Statistics for each resource handler used.
+///
+/// @see ResetHandlerStats()
+void AssetPreprocessor::GetHandlerStats( DynamicArray< HandlerStats >& rStats ) const
+{
+	MutexScopeLock scopeLock( m_handlerStatsLock );
+
+	rStats.Resize( 0 );
+	rStats.AddArray( m_handlerStats.GetData(), m_handlerStats.GetSize() );
+}
+
+/// Reset all resource preprocessing statistics.
+///
+/// @see GetHandlerStats()
+void AssetPreprocessor::ResetHandlerStats()
+{
+	MutexScopeLock scopeLock( m_handlerStatsLock );
+
+	m_handlerStats.Clear();
+}
+
 #if HELIUM_TOOLS
 
 /// Load the persistent resource data for the specified resource from the object cache.
@@ -484,43 +980,27 @@ uint32_t AssetPreprocessor::LoadPersistentResourceData(
 		return Invalid< uint32_t >();
 	}
 
-	FileStream* pFileStream = FileStream::OpenFileStream( pCache->GetCacheFileName(), FileStream::MODE_READ );
-	if( !pFileStream )
+	// The entry may be compressed, so read it through the cache rather than straight from the cache file.
+	DynamicArray< uint8_t > entryData;
+	if( !pCache->ReadEntry( *pCacheEntry, entryData ) )
 	{
 		HELIUM_TRACE(
 			TraceLevels::Error,
-			( TXT( "AssetPreprocessor::LoadPersistentResourceData(): Failed to open cache file \"%s\" for " )
-			TXT( "retrieving cached object data for \"%s\".\n" ) ),
-			*pCache->GetCacheFileName(),
-			*resourcePath.ToString() );
+			( TXT( "AssetPreprocessor::LoadPersistentResourceData(): Failed to read cached object data for \"%s\" " )
+			TXT( "from cache file \"%s\".\n" ) ),
+			*resourcePath.ToString(),
+			*pCache->GetCacheFileName() );
 
 		return Invalid< uint32_t >();
 	}
 
-	BufferedStream bufferedStream( pFileStream );
-
-	int64_t seekLocation = bufferedStream.Seek( pCacheEntry->offset, SeekOrigins::Begin );
-	if( static_cast< uint64_t >( seekLocation ) != pCacheEntry->offset )
-	{
-		HELIUM_TRACE(
-			TraceLevels::Error,
-			( TXT( "AssetPreprocessor::LoadPersistentResourceData(): Failed to seek to byte offset %" ) PRIu64
-			TXT( " in cache file \"%s\" for retrieving cached object data for \"%s\".\n" ) ),
-			pCacheEntry->offset,
-			*pCache->GetCacheFileName(),
-			*resourcePath.ToString() );
-
-		bufferedStream.Close();
-		delete pFileStream;
-
-		return Invalid< uint32_t >();
-	}
+	StaticMemoryStream entryStream( entryData.GetData(), entryData.GetSize() );
 
-	ByteSwappingStream byteSwapStream( &bufferedStream );
+	ByteSwappingStream byteSwapStream( &entryStream );
 	Stream* pReadStream =
 		( pPreprocessor->SwapBytes()
 		? static_cast< Stream* >( &byteSwapStream )
-		: static_cast< Stream* >( &bufferedStream ) );
+		: static_cast< Stream* >( &entryStream ) );
 
 	uint32_t propertyDataSize = 0;
 	size_t readCount = pReadStream->Read( &propertyDataSize, sizeof( propertyDataSize ), 1 );
@@ -533,10 +1013,6 @@ uint32_t AssetPreprocessor::LoadPersistentResourceData(
 			*resourcePath.ToString(),
 			*pCache->GetCacheFileName() );
 
-		byteSwapStream.Close();
-		bufferedStream.Close();
-		delete pFileStream;
-
 		return Invalid< uint32_t >();
 	}
 
@@ -562,31 +1038,11 @@ uint32_t AssetPreprocessor::LoadPersistentResourceData(
 			TXT( "large enough to provide the resource sub-data count.\n" ) ),
 			*resourcePath.ToString() );
 
-		byteSwapStream.Close();
-		bufferedStream.Close();
-		delete pFileStream;
-
 		return Invalid< uint32_t >();
 	}
 
-	uint64_t newOffset = pCacheEntry->offset + sizeof( propertyDataSize ) + propertyDataSize;
-	seekLocation = bufferedStream.Seek( newOffset, SeekOrigins::Begin );
-	if( static_cast< uint64_t >( seekLocation ) != newOffset )
-	{
-		HELIUM_TRACE(
-			TraceLevels::Error,
-			( TXT( "AssetPreprocessor::LoadPersistentResourceData(): Failed to seek to byte offset %" ) PRIu64
-			TXT( " in cache file \"%s\" for the cached persistent resource data for \"%s\".\n" ) ),
-			newOffset,
-			*pCache->GetCacheFileName(),
-			*resourcePath.ToString() );
-
-		byteSwapStream.Close();
-		bufferedStream.Close();
-		delete pFileStream;
-
-		return Invalid< uint32_t >();
-	}
+	int64_t newOffset = static_cast< int64_t >( sizeof( propertyDataSize ) + propertyDataSize );
+	entryStream.Seek( newOffset, SeekOrigins::Begin );
 
 	size_t resourceDataStreamSize =
 		pCacheEntry->size - sizeof( propertyDataSize ) - propertyDataSize - sizeof( uint32_t );
@@ -594,26 +1050,14 @@ uint32_t AssetPreprocessor::LoadPersistentResourceData(
 	rPersistentDataBuffer.Reserve( resourceDataStreamSize );
 	rPersistentDataBuffer.Resize( resourceDataStreamSize );
 
-	size_t bytesRead = bufferedStream.Read( rPersistentDataBuffer.GetData(), 1, resourceDataStreamSize );
-	if( bytesRead != resourceDataStreamSize )
-	{
-		HELIUM_TRACE(
-			TraceLevels::Warning,
-			( TXT( "AssetPreprocessor::LoadPersistentResourceData(): Attempted to load %" ) PRIuSZ
-			TXT( " bytes from offset %" ) PRIu64 TXT( " in cache file \"%s\", but only %" ) PRIuSZ
-			TXT( " bytes could be read.\n" ) ),
-			resourceDataStreamSize,
-			newOffset,
-			*pCache->GetCacheFileName(),
-			bytesRead );
-
-		rPersistentDataBuffer.Resize( bytesRead );
-	}
+	size_t bytesRead = entryStream.Read( rPersistentDataBuffer.GetData(), 1, resourceDataStreamSize );
+	HELIUM_ASSERT( bytesRead == resourceDataStreamSize );
+	HELIUM_UNREF( bytesRead );
 
 	rPersistentDataBuffer.Trim();
 
 	uint32_t subDataCount = 0;
-	readCount = bufferedStream.Read( &subDataCount, sizeof( subDataCount ), 1 );
+	readCount = entryStream.Read( &subDataCount, sizeof( subDataCount ), 1 );
 	if( readCount != 1 )
 	{
 		HELIUM_TRACE(
@@ -623,10 +1067,6 @@ uint32_t AssetPreprocessor::LoadPersistentResourceData(
 			*resourcePath.ToString() );
 	}
 
-	byteSwapStream.Close();
-	bufferedStream.Close();
-	delete pFileStream;
-
 	return subDataCount;
 }
 #endif  // HELIUM_TOOLS
@@ -725,19 +1165,6 @@ bool AssetPreprocessor::LoadCachedResourceData( const AssetPath &path, Resource*
 			return false;
 		}
 
-		FileStream* pFileStream = FileStream::OpenFileStream( resourceCachePath.c_str(), FileStream::MODE_READ );
-		if( !pFileStream )
-		{
-			HELIUM_TRACE(
-				TraceLevels::Error,
-				( TXT( "AssetPreprocessor::LoadCachedResourceData(): Failed to open cache file for cache \"%s\" " )
-				TXT( "for resource \"%s\".\n" ) ),
-				*resourceCacheName,
-				*path.ToString() );
-
-			return false;
-		}
-
 		DynamicArray< DynamicArray< uint8_t > >& rSubDataBuffers = rPreprocessedData.subDataBuffers;
 		rSubDataBuffers.Reserve( subDataCount );
 		rSubDataBuffers.Resize( subDataCount );
@@ -755,56 +1182,26 @@ bool AssetPreprocessor::LoadCachedResourceData( const AssetPath &path, Resource*
 					*path.ToString(),
 					*resourceCacheName );
 
-				delete pFileStream;
-
 				return false;
 			}
 
-			int64_t newOffset = pFileStream->Seek( pResourceCacheEntry->offset, SeekOrigins::Begin );
-			if( static_cast< uint64_t >( newOffset ) != pResourceCacheEntry->offset )
-			{
-				HELIUM_TRACE(
-					TraceLevels::Error,
-					( TXT( "AssetPreprocessor::LoadCachedResourceData(): Failed to seek to offset %" ) PRIu64
-					TXT( " in cache \"%s\" when loading sub-data %" ) PRIu32 TXT( " of resource \"%s\".\n" ) ),
-					pResourceCacheEntry->offset,
-					*resourceCacheName,
-					subDataIndex,
-					*path.ToString() );
-
-				delete pFileStream;
-
-				return false;
-			}
-
-			uint32_t subDataSize = pResourceCacheEntry->size;
-
+			// Sub-data may be compressed in the cache, so let the cache read it.
 			DynamicArray< uint8_t >& rSubData = rSubDataBuffers[ subDataIndex ];
-			rSubData.Reserve( subDataSize );
-			rSubData.Resize( subDataSize );
-			rSubData.Trim();
-
-			size_t bytesRead = pFileStream->Read( rSubData.GetData(), 1, subDataSize );
-			if( bytesRead != subDataSize )
+			if( !pResourceCache->ReadEntry( *pResourceCacheEntry, rSubData ) )
 			{
 				HELIUM_TRACE(
 					TraceLevels::Error,
-					( TXT( "AssetPreprocessor::LoadCachedResourceData(): Failed to read %" ) PRIu32
-					TXT( " bytes from cache \"%s\" for sub-data %" ) PRIu32 TXT( " of resource \"%s\" (only %" )
-					PRIuSZ TXT( " bytes read).\n" ) ),
-					subDataSize,
-					*resourceCacheName,
+					( TXT( "AssetPreprocessor::LoadCachedResourceData(): Failed to read sub-data %" ) PRIu32
+					TXT( " of resource \"%s\" from cache \"%s\".\n" ) ),
 					subDataIndex,
 					*path.ToString(),
-					bytesRead );
-
-				delete pFileStream;
+					*resourceCacheName );
 
 				return false;
 			}
-		}
 
-		delete pFileStream;
+			rSubData.Trim();
+		}
 	}
 
 	// Loaded.
@@ -839,6 +1236,15 @@ bool AssetPreprocessor::PreprocessResource( const AssetPath &path, Resource* pRe
 		rPreprocessedData.bLoaded = false;
 	}
 
+	// Discard any inputs reported by an earlier attempt at preprocessing the resource.
+	{
+		MutexScopeLock scopeLock( m_resourceInputLock );
+		if( m_resourceInputs.Find( path ) != m_resourceInputs.End() )
+		{
+			m_resourceInputs.Remove( path );
+		}
+	}
+
 	// Locate a resource handler for the resource type.
 	const AssetType* pResourceType = pResource->GetAssetType();
 	HELIUM_ASSERT( pResourceType );
@@ -855,17 +1261,46 @@ bool AssetPreprocessor::PreprocessResource( const AssetPath &path, Resource* pRe
 		return false;
 	}
 
-	// Preprocess and cache the resource for the each enabled platform.
-	if( !pResourceHandler->CacheResource( this, pResource, rSourceFilePath ) )
+	uint64_t startTickCount = Timer::GetTickCount();
+	bool bDerivedDataHit = false;
+
+	// Reuse the preprocessed data from the derived data cache if the same inputs have been preprocessed before.
+	uint64_t derivedDataKey = 0;
+	bool bUseDerivedDataCache =
+		( m_pDerivedDataCache &&
+		  ComputeDerivedDataKey( pResourceHandler, pResource, rSourceFilePath, derivedDataKey ) );
+	if( bUseDerivedDataCache && LoadDerivedData( derivedDataKey, pResource ) )
 	{
+		bDerivedDataHit = true;
+
 		HELIUM_TRACE(
-			TraceLevels::Error,
-			TXT( "AssetPreprocessor::PreprocessResource(): Failed to preprocess resource \"%s\".\n" ),
+			TraceLevels::Info,
+			TXT( "AssetPreprocessor::PreprocessResource(): Reused derived data for resource \"%s\".\n" ),
 			*path.ToString() );
+	}
+	else
+	{
+		// Preprocess and cache the resource for the each enabled platform.
+		if( !pResourceHandler->CacheResource( this, pResource, rSourceFilePath ) )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Error,
+				TXT( "AssetPreprocessor::PreprocessResource(): Failed to preprocess resource \"%s\".\n" ),
+				*path.ToString() );
 
-		return false;
+			AddHandlerStats( pResourceType, false, false, Timer::GetTickCount() - startTickCount );
+
+			return false;
+		}
+
+		if( bUseDerivedDataCache )
+		{
+			StoreDerivedData( derivedDataKey, pResource );
+		}
 	}
 
+	AddHandlerStats( pResourceType, true, bDerivedDataHit, Timer::GetTickCount() - startTickCount );
+
 	// Reserialize the current platform's persistent resource data.
 	CacheManager& rCacheManager = CacheManager::GetStaticInstance();
 	Cache::EPlatform platform = rCacheManager.GetCurrentPlatform();
@@ -889,4 +1324,472 @@ bool AssetPreprocessor::PreprocessResource( const AssetPath &path, Resource* pRe
 
 	return true;
 }
+
+/// Preprocess queued resources on the calling worker thread until none are left to hand out.
+///
+/// @see EndDeferredPreprocessing()
+void AssetPreprocessor::PreprocessDeferredResources()
+{
+	size_t resourceCount = m_deferredResources.GetSize();
+	for( ; ; )
+	{
+		size_t resourceIndex = static_cast< size_t >( AtomicIncrement( m_deferredResourceCounter ) - 1 );
+		if( resourceIndex >= resourceCount )
+		{
+			break;
+		}
+
+		DeferredResource& rDeferredResource = m_deferredResources[ resourceIndex ];
+		Resource* pResource = Reflect::AssertCast< Resource >( rDeferredResource.spResource.Get() );
+		HELIUM_ASSERT( pResource );
+
+		rDeferredResource.bSucceeded = PreprocessResource(
+			rDeferredResource.path,
+			pResource,
+			rDeferredResource.sourceFilePath );
+
+		{
+			MutexScopeLock scopeLock( m_preprocessedResourceLock );
+			m_preprocessedResourceIndices.Push( resourceIndex );
+		}
+
+		m_preprocessedResourceCondition.Signal();
+	}
+}
+
+/// Add the results of preprocessing a resource to the statistics of its resource handler.
+///
+/// @param[in] pResourceType    Type of resource preprocessed.
+/// @param[in] bSucceeded       True if preprocessing succeeded, false if it failed.
+/// @param[in] bDerivedDataHit  True if the preprocessed data was reused from the derived data cache.
+/// @param[in] ticks            Time spent preprocessing the resource, in timer ticks.
+void AssetPreprocessor::AddHandlerStats(
+	const AssetType* pResourceType,
+	bool bSucceeded,
+	bool bDerivedDataHit,
+	uint64_t ticks )
+{
+	HELIUM_ASSERT( pResourceType );
+
+	Name resourceTypeName = pResourceType->GetName();
+
+	MutexScopeLock scopeLock( m_handlerStatsLock );
+
+	HandlerStats* pStats = NULL;
+	size_t statsCount = m_handlerStats.GetSize();
+	for( size_t statsIndex = 0; statsIndex < statsCount; ++statsIndex )
+	{
+		if( m_handlerStats[ statsIndex ].resourceTypeName == resourceTypeName )
+		{
+			pStats = &m_handlerStats[ statsIndex ];
+
+			break;
+		}
+	}
+
+	if( !pStats )
+	{
+		pStats = m_handlerStats.New();
+		HELIUM_ASSERT( pStats );
+		pStats->resourceTypeName = resourceTypeName;
+		pStats->resourceCount = 0;
+		pStats->derivedDataHitCount = 0;
+		pStats->failureCount = 0;
+		pStats->ticks = 0;
+	}
+
+	++pStats->resourceCount;
+	if( bDerivedDataHit )
+	{
+		++pStats->derivedDataHitCount;
+	}
+
+	if( !bSucceeded )
+	{
+		++pStats->failureCount;
+	}
+
+	pStats->ticks += ticks;
+}
+
+/// Compute the derived data cache key for preprocessing a resource.
+///
+/// The key covers the resource type and handler version, the contents of the source file, the serialized resource
+/// settings, and the set of platforms being preprocessed.
+///
+/// @param[in]  pResourceHandler  Handler for the resource type.
+/// @param[in]  pResource         Resource to preprocess.
+/// @param[in]  rSourceFilePath   FilePath name of the source resource data file.
+/// @param[out] rKey              Derived data cache key.
+///
+/// @return  True if a key was computed, false if the resource cannot be cached (the handler doesn't support caching
+///          or the source file couldn't be read).
+bool AssetPreprocessor::ComputeDerivedDataKey(
+	ResourceHandler* pResourceHandler,
+	Resource* pResource,
+	const String& rSourceFilePath,
+	uint64_t& rKey ) const
+{
+	HELIUM_ASSERT( pResourceHandler );
+	HELIUM_ASSERT( pResource );
+
+	uint32_t version = pResourceHandler->GetDerivedDataVersion();
+	if( IsInvalid( version ) )
+	{
+		return false;
+	}
+
+	DerivedDataCache::KeyBuilder keyBuilder;
+
+	const AssetType* pResourceType = pResource->GetAssetType();
+	HELIUM_ASSERT( pResourceType );
+	keyBuilder.Add( String( *pResourceType->GetName() ) );
+	keyBuilder.Add( version );
+
+	for( size_t platformIndex = 0; platformIndex < HELIUM_ARRAY_COUNT( m_pPlatformPreprocessors ); ++platformIndex )
+	{
+		PlatformPreprocessor* pPreprocessor = m_pPlatformPreprocessors[ platformIndex ];
+		if( pPreprocessor )
+		{
+			keyBuilder.Add( static_cast< uint32_t >( platformIndex ) );
+			keyBuilder.Add( static_cast< uint32_t >( pPreprocessor->SwapBytes() ) );
+		}
+	}
+
+	DynamicArray< uint8_t > settingsBuffer;
+	Cache::WriteCacheObjectToBuffer( pResource, settingsBuffer );
+	keyBuilder.Add( static_cast< uint32_t >( settingsBuffer.GetSize() ) );
+	keyBuilder.Add( settingsBuffer.GetData(), settingsBuffer.GetSize() );
+
+	if( !keyBuilder.AddFile( rSourceFilePath ) )
+	{
+		return false;
+	}
+
+	rKey = keyBuilder.GetKey();
+
+	return true;
+}
+
+/// Load the preprocessed data for all enabled platforms of a resource from the derived data cache.
+///
+/// @param[in] key        Derived data cache key.
+/// @param[in] pResource  Resource into which the preprocessed data should be loaded.
+///
+/// @return  True if the data was found and loaded for all enabled platforms, false if not.
+///
+/// @see StoreDerivedData()
+bool AssetPreprocessor::LoadDerivedData( uint64_t key, Resource* pResource )
+{
+	HELIUM_ASSERT( m_pDerivedDataCache );
+	HELIUM_ASSERT( pResource );
+
+	DynamicArray< uint8_t > data;
+	if( !m_pDerivedDataCache->Load( key, data ) )
+	{
+		return false;
+	}
+
+	StaticMemoryStream dataStream( data.GetData(), data.GetSize() );
+
+	bool bLoaded = true;
+	for( size_t platformIndex = 0;
+		bLoaded && platformIndex < HELIUM_ARRAY_COUNT( m_pPlatformPreprocessors );
+		++platformIndex )
+	{
+		if( !m_pPlatformPreprocessors[ platformIndex ] )
+		{
+			continue;
+		}
+
+		Resource::PreprocessedData& rPreprocessedData = pResource->GetPreprocessedData(
+			static_cast< Cache::EPlatform >( platformIndex ) );
+
+		uint32_t persistentDataSize = 0;
+		bLoaded = ( dataStream.Read( &persistentDataSize, sizeof( persistentDataSize ), 1 ) == 1 );
+		if( bLoaded )
+		{
+			rPreprocessedData.persistentDataBuffer.Resize( persistentDataSize );
+			bLoaded = ( persistentDataSize == 0 ||
+				dataStream.Read( rPreprocessedData.persistentDataBuffer.GetData(), 1, persistentDataSize ) ==
+				persistentDataSize );
+		}
+
+		uint32_t subDataCount = 0;
+		bLoaded = bLoaded && ( dataStream.Read( &subDataCount, sizeof( subDataCount ), 1 ) == 1 );
+		if( bLoaded )
+		{
+			rPreprocessedData.subDataBuffers.Resize( 0 );
+			rPreprocessedData.subDataBuffers.Resize( subDataCount );
+		}
+
+		for( uint32_t subDataIndex = 0; bLoaded && subDataIndex < subDataCount; ++subDataIndex )
+		{
+			DynamicArray< uint8_t >& rSubData = rPreprocessedData.subDataBuffers[ subDataIndex ];
+
+			uint32_t subDataSize = 0;
+			bLoaded = ( dataStream.Read( &subDataSize, sizeof( subDataSize ), 1 ) == 1 );
+			if( bLoaded )
+			{
+				rSubData.Resize( subDataSize );
+				bLoaded = ( subDataSize == 0 || dataStream.Read( rSubData.GetData(), 1, subDataSize ) == subDataSize );
+			}
+		}
+
+		rPreprocessedData.bLoaded = bLoaded;
+	}
+
+	if( !bLoaded )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "AssetPreprocessor::LoadDerivedData(): Derived data for \"%s\" is truncated and will be rebuilt.\n" ),
+			*pResource->GetPath().ToString() );
+
+		for( size_t platformIndex = 0; platformIndex < static_cast< size_t >( Cache::PLATFORM_MAX ); ++platformIndex )
+		{
+			Resource::PreprocessedData& rPreprocessedData = pResource->GetPreprocessedData(
+				static_cast< Cache::EPlatform >( platformIndex ) );
+			rPreprocessedData.persistentDataBuffer.Clear();
+			rPreprocessedData.subDataBuffers.Clear();
+			rPreprocessedData.bLoaded = false;
+		}
+	}
+
+	return bLoaded;
+}
+
+/// Store the preprocessed data for all enabled platforms of a resource in the derived data cache.
+///
+/// Nothing is stored unless the data has been preprocessed for every enabled platform.
+///
+/// @param[in] key        Derived data cache key.
+/// @param[in] pResource  Resource with the preprocessed data to store.
+///
+/// @return  True if the data was stored, false if not.
+///
+/// @see LoadDerivedData()
+bool AssetPreprocessor::StoreDerivedData( uint64_t key, Resource* pResource )
+{
+	HELIUM_ASSERT( m_pDerivedDataCache );
+	HELIUM_ASSERT( pResource );
+
+	DynamicArray< uint8_t > data;
+	DynamicMemoryStream dataStream( &data );
+
+	for( size_t platformIndex = 0; platformIndex < HELIUM_ARRAY_COUNT( m_pPlatformPreprocessors ); ++platformIndex )
+	{
+		if( !m_pPlatformPreprocessors[ platformIndex ] )
+		{
+			continue;
+		}
+
+		const Resource::PreprocessedData& rPreprocessedData = pResource->GetPreprocessedData(
+			static_cast< Cache::EPlatform >( platformIndex ) );
+		if( !rPreprocessedData.bLoaded )
+		{
+			return false;
+		}
+
+		const DynamicArray< uint8_t >& rPersistentDataBuffer = rPreprocessedData.persistentDataBuffer;
+		HELIUM_ASSERT( rPersistentDataBuffer.GetSize() <= UINT32_MAX );
+		uint32_t persistentDataSize = static_cast< uint32_t >( rPersistentDataBuffer.GetSize() );
+		dataStream.Write( &persistentDataSize, sizeof( persistentDataSize ), 1 );
+		dataStream.Write( rPersistentDataBuffer.GetData(), 1, persistentDataSize );
+
+		const DynamicArray< DynamicArray< uint8_t > >& rSubDataBuffers = rPreprocessedData.subDataBuffers;
+		uint32_t subDataCount = static_cast< uint32_t >( rSubDataBuffers.GetSize() );
+		dataStream.Write( &subDataCount, sizeof( subDataCount ), 1 );
+
+		for( uint32_t subDataIndex = 0; subDataIndex < subDataCount; ++subDataIndex )
+		{
+			const DynamicArray< uint8_t >& rSubData = rSubDataBuffers[ subDataIndex ];
+			HELIUM_ASSERT( rSubData.GetSize() <= UINT32_MAX );
+			uint32_t subDataSize = static_cast< uint32_t >( rSubData.GetSize() );
+			dataStream.Write( &subDataSize, sizeof( subDataSize ), 1 );
+			dataStream.Write( rSubData.GetData(), 1, subDataSize );
+		}
+	}
+
+	dataStream.Close();
+
+	return m_pDerivedDataCache->Store( key, data.GetData(), data.GetSize() );
+}
+
+/// Get the name of the source file from which a resource is preprocessed.
+///
+/// This is the file of the resource that derives directly from the default template of the resource type (i.e. the
+/// asset for test.png, which would have Helium::Texture2D as its template).
+///
+/// @param[in]  resourcePath       Resource path.
+/// @param[in]  pResource          Resource.
+/// @param[out] rSourceFilePath    Source file name.
+/// @param[out] rBaseResourcePath  Path of the top-level resource within its package that the source file belongs to.
+///
+/// @return  True if the source file name was retrieved, false if the data directory could not be determined.
+bool AssetPreprocessor::GetSourceFilePath(
+	const AssetPath& resourcePath,
+	Resource* pResource,
+	String& rSourceFilePath,
+	AssetPath& rBaseResourcePath ) const
+{
+	HELIUM_ASSERT( pResource );
+
+	Resource* pSourceResource = pResource;
+	Asset* pTestTemplate = Reflect::AssertCast< Asset >( pResource->GetTemplate() );
+	while( pTestTemplate && !pTestTemplate->IsDefaultTemplate() )
+	{
+		pSourceResource = Reflect::AssertCast< Resource >( pTestTemplate );
+		pTestTemplate = Reflect::AssertCast< Asset >( pSourceResource->GetTemplate() );
+	}
+
+	AssetPath parentPath = pSourceResource == pResource ? resourcePath : pSourceResource->GetPath();
+	do
+	{
+		rBaseResourcePath = parentPath;
+		parentPath = parentPath.GetParent();
+	} while( !parentPath.IsEmpty() && !parentPath.IsPackage() );
+
+	FilePath sourceFilePath;
+	if ( !FileLocations::GetDataDirectory( sourceFilePath ) )
+	{
+		return false;
+	}
+
+	sourceFilePath += rBaseResourcePath.ToFilePathString().GetData();
+	rSourceFilePath = sourceFilePath.c_str();
+
+	return true;
+}
+
+/// Get the version of the resource handler used to cook an object, for recording with the inputs it was cooked from.
+///
+/// @param[in] pObject  Object being cooked.
+///
+/// @return  Cook version of the handler for resources, or zero for objects with no resource data.
+uint32_t AssetPreprocessor::GetCookHandlerVersion( Asset* pObject ) const
+{
+	HELIUM_ASSERT( pObject );
+
+	Resource* pResource = ( !pObject->IsDefaultTemplate() ? Reflect::SafeCast< Resource >( pObject ) : NULL );
+	if( !pResource )
+	{
+		return 0;
+	}
+
+	ResourceHandler* pResourceHandler = ResourceHandler::FindResourceHandlerForType( pResource->GetAssetType() );
+
+	return ( pResourceHandler ? pResourceHandler->GetCookVersion() : 0 );
+}
+
+/// Get the files an object is known to be cooked from before it is cooked.
+///
+/// These are the asset files of the object and of each template it derives from (default templates have no asset
+/// file), plus the source file for resources.
+/// Files reported by resource handlers through AddResourceInput() while preprocessing are not included.
+///
+/// @param[in]  path        Object path.
+/// @param[in]  pObject     Object being cooked.
+/// @param[out] rFileNames  Input file names.
+void AssetPreprocessor::GetCookInputs( const AssetPath& path, Asset* pObject, DynamicArray< String >& rFileNames ) const
+{
+	HELIUM_ASSERT( pObject );
+
+	rFileNames.Resize( 0 );
+
+	for( Asset* pAsset = pObject;
+		pAsset && !pAsset->IsDefaultTemplate();
+		pAsset = Reflect::AssertCast< Asset >( pAsset->GetTemplate() ) )
+	{
+		const FilePath* pAssetFilePath = pAsset->GetAssetFileSystemPath();
+		if( pAssetFilePath && !pAssetFilePath->Get().empty() )
+		{
+			rFileNames.Push( String( pAssetFilePath->c_str() ) );
+		}
+	}
+
+	Resource* pResource = ( !pObject->IsDefaultTemplate() ? Reflect::SafeCast< Resource >( pObject ) : NULL );
+	if( pResource )
+	{
+		String sourceFilePath;
+		AssetPath baseResourcePath;
+		if( GetSourceFilePath( path, pResource, sourceFilePath, baseResourcePath ) )
+		{
+			rFileNames.Push( sourceFilePath );
+		}
+	}
+}
+
+/// Check an object against the inputs it was last cooked from.
+///
+/// @param[in]  path     Object path.
+/// @param[in]  pObject  Object being cooked.
+/// @param[out] rReason  Description of why the object is out of date, or an empty string if it is up to date.
+///
+/// @return  True if the object is up to date, false if it needs to be recooked.
+///
+/// @see SetCookRecord()
+bool AssetPreprocessor::CheckCookRecord( const AssetPath& path, Asset* pObject, String& rReason ) const
+{
+	HELIUM_ASSERT( m_pCookRecordTable );
+
+	DynamicArray< String > inputFileNames;
+	GetCookInputs( path, pObject, inputFileNames );
+
+	return m_pCookRecordTable->CheckRecord( path, GetCookHandlerVersion( pObject ), inputFileNames, rReason );
+}
+
+/// Record the inputs an object has just been cooked from, including any reported while preprocessing it.
+///
+/// @param[in] path     Object path.
+/// @param[in] pObject  Object that was cooked.
+///
+/// @see CheckCookRecord(), AddResourceInput()
+void AssetPreprocessor::SetCookRecord( const AssetPath& path, Asset* pObject )
+{
+	HELIUM_ASSERT( m_pCookRecordTable );
+
+	DynamicArray< String > inputFileNames;
+	GetCookInputs( path, pObject, inputFileNames );
+
+	{
+		MutexScopeLock scopeLock( m_resourceInputLock );
+
+		HashMap< AssetPath, DynamicArray< String > >::Iterator inputIterator = m_resourceInputs.Find( path );
+		if( inputIterator != m_resourceInputs.End() )
+		{
+			const DynamicArray< String >& rResourceInputs = inputIterator->Second();
+			inputFileNames.AddArray( rResourceInputs.GetData(), rResourceInputs.GetSize() );
+			m_resourceInputs.Remove( path );
+		}
+	}
+
+	m_pCookRecordTable->SetRecord( path, GetCookHandlerVersion( pObject ), inputFileNames );
+}
+
+/// Record an object found to be out of date in dry-run mode.  Only the first reason found for each object is kept.
+///
+/// @param[in] path     Object path.
+/// @param[in] rReason  Description of why the object is out of date.
+void AssetPreprocessor::AddStaleAsset( const AssetPath& path, const String& rReason )
+{
+	MutexScopeLock scopeLock( m_staleAssetLock );
+
+	HashMap< AssetPath, bool >::Iterator pathIterator;
+	if( !m_staleAssetPaths.Insert( pathIterator, KeyValue< AssetPath, bool >( path, true ) ) )
+	{
+		return;
+	}
+
+	StaleAsset* pStaleAsset = m_staleAssets.New();
+	HELIUM_ASSERT( pStaleAsset );
+	pStaleAsset->path = path;
+	pStaleAsset->reason = rReason;
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		TXT( "AssetPreprocessor: \"%s\" would be recooked (%s).\n" ),
+		*path.ToString(),
+		*rReason );
+}
 #endif  // HELIUM_TOOLS
@@ -2,6 +2,10 @@
 
 #include "PcSupport/PcSupport.h"
 
+#include "Platform/Condition.h"
+#include "Platform/Locks.h"
+#include "Foundation/HashMap.h"
+#include "Engine/Asset.h"
 #include "Engine/Cache.h"
 
 namespace Helium
@@ -9,25 +13,91 @@ namespace Helium
     class Asset;
     class Resource;
     class PlatformPreprocessor;
+    class ResourceHandler;
+    class DerivedDataCache;
+    class CookRecordTable;
 
     /// Asset caching and resource preprocessing interface.
+    ///
+    /// Resources are normally preprocessed one at a time as they are loaded.  While deferred preprocessing is enabled,
+    /// out-of-date resources whose handlers support concurrent caching are instead queued, and are preprocessed on a
+    /// pool of worker threads once FlushDeferredPreprocessing() or EndDeferredPreprocessing() is called.  Cache writes
+    /// are always performed by one thread at a time.
+    ///
+    /// If a cook record table is set, an object is only recached when the contents of one of the files it was last
+    /// cooked from, or the version of its resource handler, has changed.  Otherwise, the timestamps stored with the
+    /// cache entries are compared against the asset and source file timestamps.  In dry-run mode, out-of-date objects
+    /// are only recorded along with the reason they are out of date, and nothing is preprocessed or cached.
     class HELIUM_PC_SUPPORT_API AssetPreprocessor : NonCopyable
     {
     public:
+        /// Resource preprocessing statistics for a single resource handler.  Times are in timer ticks.
+        struct HandlerStats
+        {
+            /// Name of the resource type handled.
+            Name resourceTypeName;
+            /// Number of resources preprocessed.
+            uint32_t resourceCount;
+            /// Number of resources whose preprocessed data was reused from the derived data cache.
+            uint32_t derivedDataHitCount;
+            /// Number of resources that failed to preprocess.
+            uint32_t failureCount;
+            /// Time spent preprocessing resources (summed across all threads).
+            uint64_t ticks;
+        };
+
+        /// Object found to be out of date while in dry-run mode.
+        struct StaleAsset
+        {
+            /// Object path.
+            AssetPath path;
+            /// Description of why the object is out of date.
+            String reason;
+        };
+
         /// @name Platform Preprocessor Registration
         //@{
         void SetPlatformPreprocessor( Cache::EPlatform platform, PlatformPreprocessor* pPreprocessor );
         inline PlatformPreprocessor* GetPlatformPreprocessor( Cache::EPlatform platform ) const;
         //@}
 
+        /// @name Derived Data Cache
+        //@{
+        void SetDerivedDataCache( DerivedDataCache* pDerivedDataCache );
+        inline DerivedDataCache* GetDerivedDataCache() const;
+        //@}
+
+        /// @name Cook Records
+        //@{
+        void SetCookRecordTable( CookRecordTable* pCookRecordTable );
+        inline CookRecordTable* GetCookRecordTable() const;
+
+        void AddResourceInput( const AssetPath& path, const String& rFileName );
+        void GetResourceInputs( const AssetPath& path, DynamicArray< String >& rFileNames ) const;
+
+        void SetDryRun( bool bDryRun );
+        inline bool IsDryRun() const;
+        void GetStaleAssets( DynamicArray< StaleAsset >& rStaleAssets ) const;
+        //@}
+
         /// @name Asset Caching
         //@{
         bool CacheObject( const AssetPath &objectPath, Asset* pObject, int64_t timestamp, bool bEvictPlatformPreprocessedResourceData = true );
+        inline uint32_t GetCacheFailureCount() const;
         //@}
 
         /// @name Resource Preprocessing
         //@{
         void LoadResourceData( const AssetPath &path, Resource* pResource );
+
+        void BeginDeferredPreprocessing();
+        bool EndDeferredPreprocessing( size_t workerCount );
+        bool FlushDeferredPreprocessing( size_t workerCount );
+        inline bool IsDeferringPreprocessing() const;
+        inline size_t GetDeferredResourceCount() const;
+
+        void GetHandlerStats( DynamicArray< HandlerStats >& rStats ) const;
+        void ResetHandlerStats();
         //@}
 
         /// @name Static Access
@@ -39,8 +109,68 @@ namespace Helium
        //@}
 
     private:
+        class PreprocessWorker;
+
+        /// Resource queued for preprocessing on a worker thread.
+        struct DeferredResource
+        {
+            /// Resource path.
+            AssetPath path;
+            /// Resource reference (held until the resource has been cached).
+            AssetPtr spResource;
+            /// Source file path.
+            String sourceFilePath;
+            /// Timestamp with which to cache the resource.
+            int64_t timestamp;
+            /// True if preprocessing succeeded.
+            bool bSucceeded;
+        };
+
         /// Platform-specific preprocessing support.
         PlatformPreprocessor* m_pPlatformPreprocessors[ Cache::PLATFORM_MAX ];
+        /// Cache of preprocessed resource data keyed by content (null if not used).
+        DerivedDataCache* m_pDerivedDataCache;
+        /// Inputs from which each object was last cooked (null if cache entry timestamps are used instead).
+        CookRecordTable* m_pCookRecordTable;
+
+        /// Additional input files reported by resource handlers for resources being preprocessed, by resource path.
+        HashMap< AssetPath, DynamicArray< String > > m_resourceInputs;
+        /// Lock guarding the additional resource input lists.
+        mutable Mutex m_resourceInputLock;
+
+        /// True if out-of-date objects should only be recorded instead of being preprocessed and cached.
+        bool m_bDryRun;
+        /// Objects found to be out of date in dry-run mode, in the order in which they were found.
+        DynamicArray< StaleAsset > m_staleAssets;
+        /// Paths of the objects in the stale object list.
+        HashMap< AssetPath, bool > m_staleAssetPaths;
+        /// Lock guarding the stale object list.
+        mutable Mutex m_staleAssetLock;
+
+        /// True while resource preprocessing is being deferred.
+        bool m_bDeferPreprocessing;
+        /// Resources queued for deferred preprocessing.
+        DynamicArray< DeferredResource > m_deferredResources;
+        /// Indices of queued resources, by path.
+        HashMap< AssetPath, size_t > m_deferredResourceIndices;
+        /// Index of the next queued resource to hand out to a worker thread.
+        volatile int32_t m_deferredResourceCounter;
+        /// Indices of queued resources that have finished preprocessing but have yet to be cached.
+        DynamicArray< size_t > m_preprocessedResourceIndices;
+        /// Lock guarding the preprocessed resource index list.
+        Mutex m_preprocessedResourceLock;
+        /// Condition signaled when queued resources finish preprocessing.
+        Condition m_preprocessedResourceCondition;
+
+        /// Per-handler preprocessing statistics.
+        DynamicArray< HandlerStats > m_handlerStats;
+        /// Lock guarding the handler statistics.
+        mutable Mutex m_handlerStatsLock;
+
+        /// Lock serializing cache writes.
+        Mutex m_cacheLock;
+        /// Number of objects that have failed to cache.
+        volatile int32_t m_cacheFailureCount;
 
         /// Singleton instance.
         static AssetPreprocessor* sm_pInstance;
@@ -59,6 +189,25 @@ namespace Helium
 
         uint32_t LoadPersistentResourceData(
             AssetPath resourcePath, Cache::EPlatform platform, DynamicArray< uint8_t >& rPersistentDataBuffer );
+
+        bool ComputeDerivedDataKey(
+            ResourceHandler* pResourceHandler, Resource* pResource, const String& rSourceFilePath,
+            uint64_t& rKey ) const;
+        bool LoadDerivedData( uint64_t key, Resource* pResource );
+        bool StoreDerivedData( uint64_t key, Resource* pResource );
+
+        bool GetSourceFilePath(
+            const AssetPath& resourcePath, Resource* pResource, String& rSourceFilePath,
+            AssetPath& rBaseResourcePath ) const;
+        uint32_t GetCookHandlerVersion( Asset* pObject ) const;
+        void GetCookInputs( const AssetPath& path, Asset* pObject, DynamicArray< String >& rFileNames ) const;
+        bool CheckCookRecord( const AssetPath& path, Asset* pObject, String& rReason ) const;
+        void SetCookRecord( const AssetPath& path, Asset* pObject );
+        void AddStaleAsset( const AssetPath& path, const String& rReason );
+
+        bool PreprocessQueuedResources( size_t workerCount );
+        void PreprocessDeferredResources();
+        void AddHandlerStats( const AssetType* pResourceType, bool bSucceeded, bool bDerivedDataHit, uint64_t ticks );
 #endif
         //@}
     };
@@ -13,4 +13,63 @@ namespace Helium
 
         return m_pPlatformPreprocessors[ platform ];
     }
+
+    /// Get the derived data cache consulted before preprocessing resources.
+    ///
+    /// @return  Derived data cache, or null if preprocessed resource data is not being cached by content.
+    ///
+    /// @see SetDerivedDataCache()
+    DerivedDataCache* AssetPreprocessor::GetDerivedDataCache() const
+    {
+        return m_pDerivedDataCache;
+    }
+
+    /// Get the table of inputs from which each object was last cooked.
+    ///
+    /// @return  Cook record table, or null if cache entry timestamps are used to detect out-of-date objects.
+    ///
+    /// @see SetCookRecordTable()
+    CookRecordTable* AssetPreprocessor::GetCookRecordTable() const
+    {
+        return m_pCookRecordTable;
+    }
+
+    /// Get whether out-of-date objects are only being recorded instead of being preprocessed and cached.
+    ///
+    /// @return  True if in dry-run mode, false if not.
+    ///
+    /// @see SetDryRun(), GetStaleAssets()
+    bool AssetPreprocessor::IsDryRun() const
+    {
+        return m_bDryRun;
+    }
+
+    /// Get the number of objects that have failed to cache since the asset preprocessor was created.
+    ///
+    /// @return  Number of CacheObject() calls that have failed.
+    uint32_t AssetPreprocessor::GetCacheFailureCount() const
+    {
+        return static_cast< uint32_t >( m_cacheFailureCount );
+    }
+
+    /// Get whether resource preprocessing is currently being deferred.
+    ///
+    /// @return  True if out-of-date resources are being queued for preprocessing on worker threads, false if they are
+    ///          preprocessed immediately.
+    ///
+    /// @see BeginDeferredPreprocessing(), EndDeferredPreprocessing()
+    bool AssetPreprocessor::IsDeferringPreprocessing() const
+    {
+        return m_bDeferPreprocessing;
+    }
+
+    /// Get the number of resources queued for deferred preprocessing.
+    ///
+    /// @return  Number of queued resources.
+    ///
+    /// @see FlushDeferredPreprocessing()
+    size_t AssetPreprocessor::GetDeferredResourceCount() const
+    {
+        return m_deferredResources.GetSize();
+    }
 }
@@ -0,0 +1,507 @@
+#include "PcSupportPch.h"
+#include "PcSupport/CookRecordTable.h"
+
+#include "Platform/File.h"
+#include "Foundation/FileStream.h"
+#include "Foundation/Stream.h"
+#include "Engine/StreamString.h"
+#include "PcSupport/DerivedDataCache.h"
+
+using namespace Helium;
+
+/// Cook record file magic number.
+static const uint32_t COOK_RECORD_MAGIC = 0xc00c4ec0;
+/// Cook record file format version number.
+static const uint32_t COOK_RECORD_VERSION = 0;
+
+/// Constructor.
+///
+/// Any records previously saved to the given file are loaded.
+///
+/// @param[in] rFileName  Name of the file in which the table is stored.
+CookRecordTable::CookRecordTable( const String& rFileName )
+	: m_fileName( rFileName )
+	, m_bDirty( false )
+{
+	Load();
+}
+
+/// Destructor.
+CookRecordTable::~CookRecordTable()
+{
+}
+
+/// Check whether an asset is up to date with respect to its last cook.
+///
+/// An asset is out of date if it has no record, if it was cooked with a different handler version, if any of the
+/// given input files was not an input when it was last cooked, or if the contents of any input recorded for its last
+/// cook have changed or been deleted.
+///
+/// @param[in]  path             Asset path.
+/// @param[in]  handlerVersion   Current version of the resource handler for the asset.
+/// @param[in]  rInputFileNames  Files the asset is currently known to be cooked from.  Additional inputs recorded for
+///                              the last cook are checked as well.
+/// @param[out] rReason          Description of why the asset is out of date, or an empty string if it is up to date.
+///
+/// @return  True if the asset is up to date, false if it needs to be recooked.
+///
+/// @see SetRecord()
+bool CookRecordTable::CheckRecord(
+	const AssetPath& path,
+	uint32_t handlerVersion,
+	const DynamicArray< String >& rInputFileNames,
+	String& rReason )
+{
+	HELIUM_ASSERT( !path.IsEmpty() );
+
+	rReason.Clear();
+
+	// Take a copy of the record so that the lock isn't held while hashing files.
+	Record record;
+	{
+		MutexScopeLock scopeLock( m_lock );
+
+		HashMap< AssetPath, Record >::ConstIterator recordIterator = m_records.Find( path );
+		if( recordIterator == m_records.End() )
+		{
+			rReason = TXT( "not previously cooked" );
+
+			return false;
+		}
+
+		record = recordIterator->Second();
+	}
+
+	if( record.handlerVersion != handlerVersion )
+	{
+		rReason.Format(
+			TXT( "handler version changed from %" ) PRIu32 TXT( " to %" ) PRIu32,
+			record.handlerVersion,
+			handlerVersion );
+
+		return false;
+	}
+
+	size_t inputCount = record.inputs.GetSize();
+
+	size_t inputFileNameCount = rInputFileNames.GetSize();
+	for( size_t fileNameIndex = 0; fileNameIndex < inputFileNameCount; ++fileNameIndex )
+	{
+		const String& rFileName = rInputFileNames[ fileNameIndex ];
+
+		size_t inputIndex;
+		for( inputIndex = 0; inputIndex < inputCount; ++inputIndex )
+		{
+			if( record.inputs[ inputIndex ].fileName == rFileName )
+			{
+				break;
+			}
+		}
+
+		if( inputIndex >= inputCount )
+		{
+			rReason.Format( TXT( "new input \"%s\"" ), *rFileName );
+
+			return false;
+		}
+	}
+
+	for( size_t inputIndex = 0; inputIndex < inputCount; ++inputIndex )
+	{
+		const Input& rInput = record.inputs[ inputIndex ];
+
+		uint64_t hash;
+		if( !GetFileHash( rInput.fileName, hash ) )
+		{
+			rReason.Format( TXT( "input \"%s\" is missing" ), *rInput.fileName );
+
+			return false;
+		}
+
+		if( hash != rInput.hash )
+		{
+			rReason.Format( TXT( "input \"%s\" changed" ), *rInput.fileName );
+
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/// Record the inputs from which an asset has just been cooked.
+///
+/// @param[in] path             Asset path.
+/// @param[in] handlerVersion   Version of the resource handler used to cook the asset.
+/// @param[in] rInputFileNames  Files read while cooking the asset.  Duplicates are ignored.
+///
+/// @return  True if the record was stored, false if any of the input files could not be hashed (in which case any
+///          existing record for the asset is removed, so that it is recooked next time).
+///
+/// @see CheckRecord(), RemoveRecord()
+bool CookRecordTable::SetRecord(
+	const AssetPath& path,
+	uint32_t handlerVersion,
+	const DynamicArray< String >& rInputFileNames )
+{
+	HELIUM_ASSERT( !path.IsEmpty() );
+
+	Record record;
+	record.handlerVersion = handlerVersion;
+
+	size_t inputFileNameCount = rInputFileNames.GetSize();
+	record.inputs.Reserve( inputFileNameCount );
+	for( size_t fileNameIndex = 0; fileNameIndex < inputFileNameCount; ++fileNameIndex )
+	{
+		const String& rFileName = rInputFileNames[ fileNameIndex ];
+
+		size_t inputCount = record.inputs.GetSize();
+		size_t inputIndex;
+		for( inputIndex = 0; inputIndex < inputCount; ++inputIndex )
+		{
+			if( record.inputs[ inputIndex ].fileName == rFileName )
+			{
+				break;
+			}
+		}
+
+		if( inputIndex < inputCount )
+		{
+			continue;
+		}
+
+		Input* pInput = record.inputs.New();
+		HELIUM_ASSERT( pInput );
+		pInput->fileName = rFileName;
+		if( !GetFileHash( rFileName, pInput->hash ) )
+		{
+			HELIUM_TRACE(
+				TraceLevels::Warning,
+				TXT( "CookRecordTable: Failed to hash input \"%s\" of \"%s\".  It will be recooked next time.\n" ),
+				*rFileName,
+				*path.ToString() );
+
+			RemoveRecord( path );
+
+			return false;
+		}
+	}
+
+	MutexScopeLock scopeLock( m_lock );
+
+	HashMap< AssetPath, Record >::Iterator recordIterator;
+	if( !m_records.Insert( recordIterator, KeyValue< AssetPath, Record >( path, record ) ) )
+	{
+		recordIterator->Second() = record;
+	}
+
+	m_bDirty = true;
+
+	return true;
+}
+
+/// Remove the record for an asset, so that it is recooked the next time it is checked.
+///
+/// @param[in] path  Asset path.
+///
+/// @see SetRecord()
+void CookRecordTable::RemoveRecord( const AssetPath& path )
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	if( m_records.Find( path ) != m_records.End() )
+	{
+		m_records.Remove( path );
+		m_bDirty = true;
+	}
+}
+
+/// Get the record for an asset.
+///
+/// @param[in]  path     Asset path.
+/// @param[out] rRecord  Cook record.
+///
+/// @return  True if the asset has a record, false if not.
+///
+/// @see SetRecord()
+bool CookRecordTable::GetRecord( const AssetPath& path, Record& rRecord ) const
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	HashMap< AssetPath, Record >::ConstIterator recordIterator = m_records.Find( path );
+	if( recordIterator == m_records.End() )
+	{
+		return false;
+	}
+
+	rRecord = recordIterator->Second();
+
+	return true;
+}
+
+/// Get the number of assets with cook records.
+///
+/// @return  Record count.
+size_t CookRecordTable::GetRecordCount() const
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	return m_records.GetSize();
+}
+
+/// Get the hash of the contents of a file.
+///
+/// The hash is only computed if the file has changed size or modification time since it was last hashed.
+///
+/// @param[in]  rFileName  File name.
+/// @param[out] rHash      Hash of the file contents.
+///
+/// @return  True if the hash was retrieved, false if the file could not be read.
+bool CookRecordTable::GetFileHash( const String& rFileName, uint64_t& rHash )
+{
+	Status status;
+	status.Read( *rFileName );
+
+	Name fileName( *rFileName );
+
+	{
+		MutexScopeLock scopeLock( m_lock );
+
+		HashMap< Name, FileHash >::ConstIterator hashIterator = m_fileHashes.Find( fileName );
+		if( hashIterator != m_fileHashes.End() )
+		{
+			const FileHash& rFileHash = hashIterator->Second();
+			if( rFileHash.size == static_cast< int64_t >( status.m_Size ) &&
+				rFileHash.modifiedTime == static_cast< int64_t >( status.m_ModifiedTime ) )
+			{
+				rHash = rFileHash.hash;
+
+				return true;
+			}
+		}
+	}
+
+	DerivedDataCache::KeyBuilder keyBuilder;
+	if( !keyBuilder.AddFile( rFileName ) )
+	{
+		return false;
+	}
+
+	FileHash fileHash;
+	fileHash.size = static_cast< int64_t >( status.m_Size );
+	fileHash.modifiedTime = static_cast< int64_t >( status.m_ModifiedTime );
+	fileHash.hash = keyBuilder.GetKey();
+
+	rHash = fileHash.hash;
+
+	MutexScopeLock scopeLock( m_lock );
+
+	HashMap< Name, FileHash >::Iterator hashIterator;
+	if( !m_fileHashes.Insert( hashIterator, KeyValue< Name, FileHash >( fileName, fileHash ) ) )
+	{
+		hashIterator->Second() = fileHash;
+	}
+
+	m_bDirty = true;
+
+	return true;
+}
+
+/// Replace the contents of this table with the contents of its file.
+///
+/// @return  True if the table was loaded successfully, false if not (in which case the table is left empty, and
+///          every asset will be recooked).
+///
+/// @see Save()
+bool CookRecordTable::Load()
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	m_records.Clear();
+	m_fileHashes.Clear();
+	m_bDirty = false;
+
+	FileStream* pFileStream = FileStream::OpenFileStream( m_fileName, FileStream::MODE_READ );
+	if( !pFileStream )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Info,
+			TXT( "CookRecordTable: Cook record file \"%s\" does not exist.\n" ),
+			*m_fileName );
+
+		return false;
+	}
+
+	BufferedStream* pBufferedStream = new BufferedStream( pFileStream );
+	HELIUM_ASSERT( pBufferedStream );
+
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	uint32_t fileHashCount = 0;
+	bool bReadSuccess = ( pBufferedStream->Read( &magic, sizeof( magic ), 1 ) == 1 &&
+		pBufferedStream->Read( &version, sizeof( version ), 1 ) == 1 &&
+		pBufferedStream->Read( &fileHashCount, sizeof( fileHashCount ), 1 ) == 1 &&
+		magic == COOK_RECORD_MAGIC &&
+		version == COOK_RECORD_VERSION );
+
+	DynamicArray< char > fileNameString;
+	for( uint32_t fileHashIndex = 0; bReadSuccess && fileHashIndex < fileHashCount; ++fileHashIndex )
+	{
+		FileHash fileHash;
+		bReadSuccess = ( ReadLengthPrefixedString( *pBufferedStream, fileNameString ) &&
+			pBufferedStream->Read( &fileHash.size, sizeof( fileHash.size ), 1 ) == 1 &&
+			pBufferedStream->Read( &fileHash.modifiedTime, sizeof( fileHash.modifiedTime ), 1 ) == 1 &&
+			pBufferedStream->Read( &fileHash.hash, sizeof( fileHash.hash ), 1 ) == 1 );
+		if( bReadSuccess )
+		{
+			HashMap< Name, FileHash >::Iterator hashIterator;
+			m_fileHashes.Insert(
+				hashIterator,
+				KeyValue< Name, FileHash >( Name( fileNameString.GetData() ), fileHash ) );
+		}
+	}
+
+	uint32_t recordCount = 0;
+	bReadSuccess = bReadSuccess && pBufferedStream->Read( &recordCount, sizeof( recordCount ), 1 ) == 1;
+
+	DynamicArray< char > pathString;
+	for( uint32_t recordIndex = 0; bReadSuccess && recordIndex < recordCount; ++recordIndex )
+	{
+		Record record;
+		uint32_t inputCount = 0;
+		bReadSuccess = ( ReadLengthPrefixedString( *pBufferedStream, pathString ) &&
+			pBufferedStream->Read( &record.handlerVersion, sizeof( record.handlerVersion ), 1 ) == 1 &&
+			pBufferedStream->Read( &inputCount, sizeof( inputCount ), 1 ) == 1 );
+
+		record.inputs.Reserve( inputCount );
+		for( uint32_t inputIndex = 0; bReadSuccess && inputIndex < inputCount; ++inputIndex )
+		{
+			Input* pInput = record.inputs.New();
+			HELIUM_ASSERT( pInput );
+			bReadSuccess = ( ReadLengthPrefixedString( *pBufferedStream, fileNameString ) &&
+				pBufferedStream->Read( &pInput->hash, sizeof( pInput->hash ), 1 ) == 1 );
+			pInput->fileName = fileNameString.GetData();
+		}
+
+		if( !bReadSuccess )
+		{
+			break;
+		}
+
+		AssetPath path;
+		if( !path.Set( pathString.GetData() ) )
+		{
+			// Content may have been renamed since the record was written, so just skip the record.
+			continue;
+		}
+
+		HashMap< AssetPath, Record >::Iterator recordIterator;
+		m_records.Insert( recordIterator, KeyValue< AssetPath, Record >( path, record ) );
+	}
+
+	delete pBufferedStream;
+	delete pFileStream;
+
+	if( !bReadSuccess )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "CookRecordTable: Cook record file \"%s\" is invalid or out of date.  All assets will be recooked.\n" ),
+			*m_fileName );
+
+		m_records.Clear();
+		m_fileHashes.Clear();
+
+		return false;
+	}
+
+	return true;
+}
+
+/// Save this table to its file, if it has changed since it was loaded or last saved.
+///
+/// @return  True if the table was saved successfully or had no changes to save, false if saving failed.
+///
+/// @see Load()
+bool CookRecordTable::Save()
+{
+	MutexScopeLock scopeLock( m_lock );
+
+	if( !m_bDirty )
+	{
+		return true;
+	}
+
+	FileStream* pFileStream = FileStream::OpenFileStream( m_fileName, FileStream::MODE_WRITE, true );
+	if( !pFileStream )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "CookRecordTable: Failed to open \"%s\" for writing.\n" ), *m_fileName );
+
+		return false;
+	}
+
+	BufferedStream* pBufferedStream = new BufferedStream( pFileStream );
+	HELIUM_ASSERT( pBufferedStream );
+
+	uint32_t fileHashCount = static_cast< uint32_t >( m_fileHashes.GetSize() );
+	bool bWriteSuccess = ( pBufferedStream->Write( &COOK_RECORD_MAGIC, sizeof( COOK_RECORD_MAGIC ), 1 ) == 1 &&
+		pBufferedStream->Write( &COOK_RECORD_VERSION, sizeof( COOK_RECORD_VERSION ), 1 ) == 1 &&
+		pBufferedStream->Write( &fileHashCount, sizeof( fileHashCount ), 1 ) == 1 );
+
+	HashMap< Name, FileHash >::ConstIterator hashEnd = m_fileHashes.End();
+	for( HashMap< Name, FileHash >::ConstIterator hashIterator = m_fileHashes.Begin();
+		bWriteSuccess && hashIterator != hashEnd;
+		++hashIterator )
+	{
+		const FileHash& rFileHash = hashIterator->Second();
+		bWriteSuccess = ( WriteLengthPrefixedString( *pBufferedStream, String( *hashIterator->First() ) ) &&
+			pBufferedStream->Write( &rFileHash.size, sizeof( rFileHash.size ), 1 ) == 1 &&
+			pBufferedStream->Write( &rFileHash.modifiedTime, sizeof( rFileHash.modifiedTime ), 1 ) == 1 &&
+			pBufferedStream->Write( &rFileHash.hash, sizeof( rFileHash.hash ), 1 ) == 1 );
+	}
+
+	uint32_t recordCount = static_cast< uint32_t >( m_records.GetSize() );
+	bWriteSuccess = bWriteSuccess && pBufferedStream->Write( &recordCount, sizeof( recordCount ), 1 ) == 1;
+
+	String pathString;
+	HashMap< AssetPath, Record >::ConstIterator recordEnd = m_records.End();
+	for( HashMap< AssetPath, Record >::ConstIterator recordIterator = m_records.Begin();
+		bWriteSuccess && recordIterator != recordEnd;
+		++recordIterator )
+	{
+		recordIterator->First().ToString( pathString );
+
+		const Record& rRecord = recordIterator->Second();
+		uint32_t inputCount = static_cast< uint32_t >( rRecord.inputs.GetSize() );
+		bWriteSuccess = ( WriteLengthPrefixedString( *pBufferedStream, pathString ) &&
+			pBufferedStream->Write( &rRecord.handlerVersion, sizeof( rRecord.handlerVersion ), 1 ) == 1 &&
+			pBufferedStream->Write( &inputCount, sizeof( inputCount ), 1 ) == 1 );
+
+		for( uint32_t inputIndex = 0; bWriteSuccess && inputIndex < inputCount; ++inputIndex )
+		{
+			const Input& rInput = rRecord.inputs[ inputIndex ];
+			bWriteSuccess = ( WriteLengthPrefixedString( *pBufferedStream, rInput.fileName ) &&
+				pBufferedStream->Write( &rInput.hash, sizeof( rInput.hash ), 1 ) == 1 );
+		}
+	}
+
+	delete pBufferedStream;
+	delete pFileStream;
+
+	if( !bWriteSuccess )
+	{
+		HELIUM_TRACE( TraceLevels::Error, TXT( "CookRecordTable: Failed to write \"%s\".\n" ), *m_fileName );
+
+		return false;
+	}
+
+	m_bDirty = false;
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		TXT( "CookRecordTable: Saved %" ) PRIu32 TXT( " records to \"%s\".\n" ),
+		recordCount,
+		*m_fileName );
+
+	return true;
+}
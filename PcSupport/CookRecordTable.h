@@ -0,0 +1,102 @@
+#pragma once
+
+#include "PcSupport/PcSupport.h"
+
+#include "Platform/Locks.h"
+#include "Foundation/DynamicArray.h"
+#include "Foundation/HashMap.h"
+#include "Foundation/String.h"
+#include "Engine/AssetPath.h"
+
+namespace Helium
+{
+    /// Record of the inputs each asset was last cooked from.
+    ///
+    /// For every cooked asset, the table holds the version of the resource handler that preprocessed it along with
+    /// the content hash of each file read while cooking it (its asset file, the asset files of its templates, its
+    /// source file, and any other files reported by its resource handler, such as shader includes).  An asset only
+    /// needs to be recooked when one of those changes, so touching a file without changing its contents, or switching
+    /// between branches with the same content, does not cause a recook.
+    ///
+    /// File hashes are remembered along with the size and modification time of the file they were computed from, so
+    /// unchanged files are not read again.  All access is thread-safe.
+    class HELIUM_PC_SUPPORT_API CookRecordTable : NonCopyable
+    {
+    public:
+        /// Cook input.
+        struct Input
+        {
+            /// Input file name.
+            String fileName;
+            /// Hash of the file contents when the asset was cooked.
+            uint64_t hash;
+        };
+
+        /// Cook record.
+        struct Record
+        {
+            /// Version of the resource handler used to cook the asset.
+            uint32_t handlerVersion;
+            /// Files read while cooking the asset.
+            DynamicArray< Input > inputs;
+        };
+
+        /// @name Construction/Destruction
+        //@{
+        explicit CookRecordTable( const String& rFileName );
+        ~CookRecordTable();
+        //@}
+
+        /// @name Record Access
+        //@{
+        bool CheckRecord(
+            const AssetPath& path, uint32_t handlerVersion, const DynamicArray< String >& rInputFileNames,
+            String& rReason );
+        bool SetRecord( const AssetPath& path, uint32_t handlerVersion, const DynamicArray< String >& rInputFileNames );
+        void RemoveRecord( const AssetPath& path );
+        bool GetRecord( const AssetPath& path, Record& rRecord ) const;
+
+        size_t GetRecordCount() const;
+        //@}
+
+        /// @name File Hashing
+        //@{
+        bool GetFileHash( const String& rFileName, uint64_t& rHash );
+        //@}
+
+        /// @name Serialization
+        //@{
+        bool Load();
+        bool Save();
+
+        inline const String& GetFileName() const;
+        //@}
+
+    private:
+        /// Remembered file hash.
+        struct FileHash
+        {
+            /// File size when the hash was computed.
+            int64_t size;
+            /// File modification time when the hash was computed.
+            int64_t modifiedTime;
+            /// Hash of the file contents.
+            uint64_t hash;
+        };
+
+        /// Name of the file in which the table is stored.
+        String m_fileName;
+
+        /// Cook records, by asset path.
+        HashMap< AssetPath, Record > m_records;
+        /// Remembered file hashes, by file name.
+        HashMap< Name, FileHash > m_fileHashes;
+        /// True if the table has changed since it was last loaded or saved.
+        bool m_bDirty;
+
+        /// Lock for synchronizing access from multiple preprocessing threads.
+        mutable Mutex m_lock;
+    };
+}
+
+#include "PcSupport/CookRecordTable.inl"
@@ -0,0 +1,12 @@
+namespace Helium
+{
+    /// Get the name of the file in which this table is stored.
+    ///
+    /// @return  Table file name.
+    ///
+    /// @see Load(), Save()
+    const String& CookRecordTable::GetFileName() const
+    {
+        return m_fileName;
+    }
+}
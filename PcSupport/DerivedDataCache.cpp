@@ -0,0 +1,624 @@
+#include "PcSupportPch.h"
+#include "PcSupport/DerivedDataCache.h"
+
+#include "Platform/File.h"
+#include "Foundation/DirectoryIterator.h"
+#include "Foundation/FilePath.h"
+#include "Foundation/FileStream.h"
+
+#include <algorithm>
+#include <time.h>
+
+#if HELIUM_OS_WIN
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+/// Derived data cache entry file extension.
+#define HELIUM_DERIVED_DATA_CACHE_EXTENSION TXT( "ddc" )
+
+using namespace Helium;
+
+/// Derived data cache entry file signature ("HDDC").
+static const uint32_t DERIVED_DATA_SIGNATURE = 0x43444448;
+/// Derived data cache entry file format version.
+static const uint32_t DERIVED_DATA_FORMAT_VERSION = 1;
+
+/// Size of the buffer used when hashing file contents.
+static const size_t FILE_HASH_BUFFER_SIZE = 64 * 1024;
+
+/// Derived data cache entry file header.
+struct DerivedDataHeader
+{
+	/// File signature.
+	uint32_t signature;
+	/// File format version.
+	uint32_t version;
+	/// Cache key.
+	uint64_t key;
+	/// Size of the data following the header.
+	uint64_t dataSize;
+};
+
+/// Get the ID of the current process, for naming temporary files that must not collide with those of other processes
+/// sharing the cache directory.
+///
+/// @return  Current process ID.
+static uint32_t GetCurrentProcessIdentifier()
+{
+#if HELIUM_OS_WIN
+	return static_cast< uint32_t >( ::GetCurrentProcessId() );
+#else
+	return static_cast< uint32_t >( getpid() );
+#endif
+}
+
+/// Constructor.
+DerivedDataCache::KeyBuilder::KeyBuilder()
+{
+}
+
+/// Add a block of data to the key.
+///
+/// @param[in] pData  Data to add.
+/// @param[in] size   Size of the data, in bytes.
+void DerivedDataCache::KeyBuilder::Add( const void* pData, size_t size )
+{
+	m_hasher.Add( pData, size );
+}
+
+/// Add a string to the key.
+///
+/// The string length is included so that consecutive strings can't run together into the same key.
+///
+/// @param[in] rString  String to add.
+void DerivedDataCache::KeyBuilder::Add( const String& rString )
+{
+	uint32_t length = static_cast< uint32_t >( rString.GetSize() );
+	Add( length );
+	Add( rString.GetData(), length * sizeof( char ) );
+}
+
+/// Add an integer value to the key.
+///
+/// @param[in] value  Value to add.
+void DerivedDataCache::KeyBuilder::Add( uint32_t value )
+{
+	Add( &value, sizeof( value ) );
+}
+
+/// Add the size and contents of a file to the key.
+///
+/// @param[in] rFileName  Name of the file to add.
+///
+/// @return  True if the entire file was read and added successfully, false if not.
+bool DerivedDataCache::KeyBuilder::AddFile( const String& rFileName )
+{
+	FileStream* pStream = FileStream::OpenFileStream( rFileName, FileStream::MODE_READ );
+	if( !pStream )
+	{
+		return false;
+	}
+
+	int64_t fileSize = pStream->GetSize();
+	if( fileSize < 0 )
+	{
+		delete pStream;
+
+		return false;
+	}
+
+	Add( &fileSize, sizeof( fileSize ) );
+
+	DynamicArray< uint8_t > buffer;
+	buffer.Resize( FILE_HASH_BUFFER_SIZE );
+
+	uint64_t remainingSize = static_cast< uint64_t >( fileSize );
+	while( remainingSize != 0 )
+	{
+		size_t readSize = static_cast< size_t >( Min< uint64_t >( remainingSize, FILE_HASH_BUFFER_SIZE ) );
+		if( pStream->Read( buffer.GetData(), 1, readSize ) != readSize )
+		{
+			delete pStream;
+
+			return false;
+		}
+
+		Add( buffer.GetData(), readSize );
+		remainingSize -= readSize;
+	}
+
+	delete pStream;
+
+	return true;
+}
+
+/// Constructor.
+///
+/// This creates the cache directory if necessary and gathers information about the entries already in it.
+///
+/// @param[in] rDirectory  Directory in which to store cache entries.
+/// @param[in] sizeBudget  Total size the cache entries are allowed to take up, in bytes.
+DerivedDataCache::DerivedDataCache( const String& rDirectory, uint64_t sizeBudget )
+	: m_directory( rDirectory )
+	, m_sizeBudget( sizeBudget )
+	, m_entryPool( ENTRY_POOL_BLOCK_SIZE )
+	, m_pNewest( NULL )
+	, m_pOldest( NULL )
+	, m_tempFileCounter( 0 )
+{
+	MemoryZero( &m_stats, sizeof( m_stats ) );
+
+	if( !m_directory.IsEmpty() && !m_directory.EndsWith( TXT( "/" ) ) )
+	{
+		m_directory += TXT( '/' );
+	}
+
+	FilePath directoryPath( *m_directory );
+	if( !directoryPath.MakePath() )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "DerivedDataCache: Failed to create cache directory \"%s\".\n" ),
+			*m_directory );
+	}
+
+	ScanDirectory();
+
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		TXT( "DerivedDataCache: Using \"%s\" (%" ) PRIuSZ TXT( " entries, %" ) PRIu64 TXT( " of %" ) PRIu64
+		TXT( " bytes).\n" ),
+		*m_directory,
+		m_stats.entryCount,
+		m_stats.totalSize,
+		m_sizeBudget );
+
+	// Trim the cache in case the budget was lowered since the last run.
+	EvictEntries();
+}
+
+/// Destructor.
+DerivedDataCache::~DerivedDataCache()
+{
+	HELIUM_TRACE(
+		TraceLevels::Info,
+		TXT( "DerivedDataCache: %" ) PRIu32 TXT( " hits, %" ) PRIu32 TXT( " misses, %" ) PRIu32 TXT( " stores, %" )
+		PRIu32 TXT( " evictions.\n" ),
+		m_stats.hitCount,
+		m_stats.missCount,
+		m_stats.storeCount,
+		m_stats.evictCount );
+
+	while( m_pOldest )
+	{
+		Entry* pEntry = m_pOldest;
+		Unlink( pEntry );
+		m_entryPool.Release( pEntry );
+	}
+
+	m_entryMap.Clear();
+}
+
+/// Load the data for a cache entry.
+///
+/// @param[in]  key    Cache key.
+/// @param[out] rData  Entry data.
+///
+/// @return  True if the entry was found and loaded successfully, false if not.
+///
+/// @see Store()
+bool DerivedDataCache::Load( uint64_t key, DynamicArray< uint8_t >& rData )
+{
+	rData.Resize( 0 );
+
+	String fileName;
+	GetEntryFileName( key, fileName );
+
+	{
+		MutexScopeLock scopeLock( m_lock );
+
+		if( !FindEntry( key ) )
+		{
+			++m_stats.missCount;
+
+			return false;
+		}
+	}
+
+	// Read the entry outside the lock so that other preprocessing threads aren't held up by the I/O.
+	bool bLoaded = false;
+
+	FileStream* pStream = FileStream::OpenFileStream( fileName, FileStream::MODE_READ );
+	if( pStream )
+	{
+		DerivedDataHeader header;
+		if( pStream->Read( &header, sizeof( header ), 1 ) == 1 &&
+			header.signature == DERIVED_DATA_SIGNATURE &&
+			header.version == DERIVED_DATA_FORMAT_VERSION &&
+			header.key == key &&
+			header.dataSize <= static_cast< uint64_t >( pStream->GetSize() ) - sizeof( header ) )
+		{
+			size_t dataSize = static_cast< size_t >( header.dataSize );
+			rData.Resize( dataSize );
+			bLoaded = ( dataSize == 0 || pStream->Read( rData.GetData(), 1, dataSize ) == dataSize );
+		}
+
+		delete pStream;
+	}
+
+	MutexScopeLock scopeLock( m_lock );
+
+	if( !bLoaded )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "DerivedDataCache: Discarding unreadable entry \"%s\".\n" ),
+			*fileName );
+
+		rData.Resize( 0 );
+		RemoveEntry( key );
+		FilePath( *fileName ).Delete();
+		++m_stats.missCount;
+
+		return false;
+	}
+
+	Entry* pEntry = FindEntry( key );
+	if( pEntry && pEntry != m_pNewest )
+	{
+		Unlink( pEntry );
+		LinkNewest( pEntry );
+	}
+
+	++m_stats.hitCount;
+
+	return true;
+}
+
+/// Store the data for a cache entry, replacing any existing entry with the same key.
+///
+/// The entry is written to a temporary file first and then moved into place, so a partially written entry is never
+/// visible to other processes sharing the cache directory.  The temporary file name includes the process ID, so
+/// processes storing the same entry at the same time don't write to the same file.
+///
+/// @param[in] key    Cache key.
+/// @param[in] pData  Entry data.
+/// @param[in] size   Size of the entry data, in bytes.
+///
+/// @return  True if the entry was stored successfully, false if not.
+///
+/// @see Load()
+bool DerivedDataCache::Store( uint64_t key, const void* pData, size_t size )
+{
+	HELIUM_ASSERT( pData || size == 0 );
+
+	String fileName;
+	GetEntryFileName( key, fileName );
+
+	String tempFileName;
+	{
+		MutexScopeLock scopeLock( m_lock );
+		tempFileName.Format(
+			TXT( "%s.%" ) PRIu32 TXT( ".%" ) PRIu64 TXT( ".tmp" ),
+			*fileName,
+			GetCurrentProcessIdentifier(),
+			++m_tempFileCounter );
+	}
+
+	FileStream* pStream = FileStream::OpenFileStream( tempFileName, FileStream::MODE_WRITE, true );
+	if( !pStream )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "DerivedDataCache: Failed to open \"%s\" for writing.\n" ),
+			*tempFileName );
+
+		return false;
+	}
+
+	DerivedDataHeader header;
+	header.signature = DERIVED_DATA_SIGNATURE;
+	header.version = DERIVED_DATA_FORMAT_VERSION;
+	header.key = key;
+	header.dataSize = size;
+
+	bool bWritten =
+		pStream->Write( &header, sizeof( header ), 1 ) == 1 &&
+		( size == 0 || pStream->Write( pData, 1, size ) == size );
+
+	delete pStream;
+
+	if( !bWritten || !FilePath( *tempFileName ).Move( FilePath( *fileName ) ) )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "DerivedDataCache: Failed to write entry \"%s\".\n" ),
+			*fileName );
+
+		FilePath( *tempFileName ).Delete();
+
+		return false;
+	}
+
+	MutexScopeLock scopeLock( m_lock );
+
+	SetEntry( key, sizeof( header ) + size );
+	++m_stats.storeCount;
+
+	EvictEntries();
+
+	return true;
+}
+
+/// Get the cache usage statistics.
+///
+/// @param[out] rStats  Cache statistics.
+void DerivedDataCache::GetStats( Stats& rStats ) const
+{
+	MutexScopeLock scopeLock( m_lock );
+	rStats = m_stats;
+}
+
+/// Gather information about the entries already in the cache directory.
+///
+/// Entries are given a use order based on their file modification times, so that the oldest entries are evicted
+/// first.  Temporary files older than TEMP_FILE_EXPIRATION_TIME are deleted; newer ones may still be being written by
+/// another process sharing the cache directory.
+void DerivedDataCache::ScanDirectory()
+{
+	/// Entry found on disk.
+	struct ScannedEntry
+	{
+		/// Entry information.
+		Entry entry;
+		/// File modification time.
+		int64_t modifiedTime;
+
+		/// Modification time ordering.
+		bool operator<( const ScannedEntry& rOther ) const
+		{
+			return ( modifiedTime < rOther.modifiedTime );
+		}
+	};
+
+	DynamicArray< ScannedEntry > scannedEntries;
+	int64_t currentTime = static_cast< int64_t >( time( NULL ) );
+
+	DirectoryIterator directory( FilePath( *m_directory ) );
+	for( ; !directory.IsDone(); directory.Next() )
+	{
+		const DirectoryIteratorItem& item = directory.GetItem();
+		if( item.m_Path.IsDirectory() )
+		{
+			continue;
+		}
+
+		// Clean up temporary files left behind by interrupted runs.
+		std::string extension = item.m_Path.Extension();
+		if( extension == TXT( "tmp" ) )
+		{
+			Status tempStatus;
+			if( tempStatus.Read( item.m_Path.c_str() ) &&
+				currentTime - static_cast< int64_t >( tempStatus.m_ModifiedTime ) > TEMP_FILE_EXPIRATION_TIME )
+			{
+				FilePath( item.m_Path ).Delete();
+			}
+
+			continue;
+		}
+
+		if( extension != HELIUM_DERIVED_DATA_CACHE_EXTENSION )
+		{
+			continue;
+		}
+
+		// Entry file names are the keys in hexadecimal.
+		std::string baseName = item.m_Path.Basename();
+		if( baseName.size() != 16 )
+		{
+			continue;
+		}
+
+		uint64_t key = 0;
+		bool bValidName = true;
+		for( size_t characterIndex = 0; characterIndex < baseName.size(); ++characterIndex )
+		{
+			char character = baseName[ characterIndex ];
+			uint64_t digit;
+			if( character >= '0' && character <= '9' )
+			{
+				digit = character - '0';
+			}
+			else if( character >= 'a' && character <= 'f' )
+			{
+				digit = character - 'a' + 10;
+			}
+			else
+			{
+				bValidName = false;
+
+				break;
+			}
+
+			key = ( key << 4 ) | digit;
+		}
+
+		if( !bValidName )
+		{
+			continue;
+		}
+
+		Status status;
+		status.Read( item.m_Path.c_str() );
+
+		ScannedEntry* pScannedEntry = scannedEntries.New();
+		HELIUM_ASSERT( pScannedEntry );
+		pScannedEntry->entry.key = key;
+		pScannedEntry->entry.size = static_cast< uint64_t >( item.m_Size );
+		pScannedEntry->modifiedTime = status.m_ModifiedTime;
+	}
+
+	std::sort( scannedEntries.Begin(), scannedEntries.End() );
+
+	size_t entryCount = scannedEntries.GetSize();
+	for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+	{
+		const Entry& rEntry = scannedEntries[ entryIndex ].entry;
+		SetEntry( rEntry.key, rEntry.size );
+	}
+}
+
+/// Find an entry.
+///
+/// The cache lock must be held when calling this.
+///
+/// @param[in] key  Cache key.
+///
+/// @return  Entry if found, null if not found.
+DerivedDataCache::Entry* DerivedDataCache::FindEntry( uint64_t key ) const
+{
+	HashMap< uint64_t, Entry* >::ConstIterator entryIterator = m_entryMap.Find( key );
+
+	return ( entryIterator != m_entryMap.End() ? entryIterator->Second() : NULL );
+}
+
+/// Add or update an entry, marking it as the most recently used.
+///
+/// The cache lock must be held when calling this.
+///
+/// @param[in] key   Cache key.
+/// @param[in] size  Entry file size, in bytes.
+void DerivedDataCache::SetEntry( uint64_t key, uint64_t size )
+{
+	Entry* pEntry = FindEntry( key );
+	if( pEntry )
+	{
+		Unlink( pEntry );
+	}
+	else
+	{
+		pEntry = m_entryPool.Allocate();
+		HELIUM_ASSERT( pEntry );
+		pEntry->key = key;
+		pEntry->size = 0;
+
+		HashMap< uint64_t, Entry* >::Iterator entryIterator;
+		HELIUM_VERIFY( m_entryMap.Insert( entryIterator, KeyValue< uint64_t, Entry* >( key, pEntry ) ) );
+
+		++m_stats.entryCount;
+	}
+
+	m_stats.totalSize -= pEntry->size;
+	m_stats.totalSize += size;
+	pEntry->size = size;
+
+	LinkNewest( pEntry );
+}
+
+/// Remove an entry.
+///
+/// The cache lock must be held when calling this.  The entry file is not deleted.
+///
+/// @param[in] key  Cache key.
+void DerivedDataCache::RemoveEntry( uint64_t key )
+{
+	Entry* pEntry = FindEntry( key );
+	if( pEntry )
+	{
+		m_stats.totalSize -= pEntry->size;
+		--m_stats.entryCount;
+
+		Unlink( pEntry );
+		m_entryMap.Remove( key );
+		m_entryPool.Release( pEntry );
+	}
+}
+
+/// Delete the least recently used entries until the cache fits within the size budget.
+///
+/// The cache lock must be held when calling this.
+void DerivedDataCache::EvictEntries()
+{
+	while( m_stats.totalSize > m_sizeBudget && m_pOldest )
+	{
+		uint64_t key = m_pOldest->key;
+
+		String fileName;
+		GetEntryFileName( key, fileName );
+		FilePath( *fileName ).Delete();
+
+		RemoveEntry( key );
+		++m_stats.evictCount;
+	}
+}
+
+/// Add an entry to the most recently used end of the entry list.
+///
+/// The cache lock must be held when calling this.
+///
+/// @param[in] pEntry  Entry to add.
+///
+/// @see Unlink()
+void DerivedDataCache::LinkNewest( Entry* pEntry )
+{
+	HELIUM_ASSERT( pEntry );
+
+	pEntry->pNewer = NULL;
+	pEntry->pOlder = m_pNewest;
+	if( m_pNewest )
+	{
+		m_pNewest->pNewer = pEntry;
+	}
+	else
+	{
+		m_pOldest = pEntry;
+	}
+
+	m_pNewest = pEntry;
+}
+
+/// Remove an entry from the entry list.
+///
+/// The cache lock must be held when calling this.
+///
+/// @param[in] pEntry  Entry to remove.
+///
+/// @see LinkNewest()
+void DerivedDataCache::Unlink( Entry* pEntry )
+{
+	HELIUM_ASSERT( pEntry );
+
+	if( pEntry->pNewer )
+	{
+		pEntry->pNewer->pOlder = pEntry->pOlder;
+	}
+	else
+	{
+		HELIUM_ASSERT( m_pNewest == pEntry );
+		m_pNewest = pEntry->pOlder;
+	}
+
+	if( pEntry->pOlder )
+	{
+		pEntry->pOlder->pNewer = pEntry->pNewer;
+	}
+	else
+	{
+		HELIUM_ASSERT( m_pOldest == pEntry );
+		m_pOldest = pEntry->pNewer;
+	}
+
+	pEntry->pNewer = NULL;
+	pEntry->pOlder = NULL;
+}
+
+/// Get the name of the file in which an entry is stored.
+///
+/// @param[in]  key        Cache key.
+/// @param[out] rFileName  Entry file name.
+void DerivedDataCache::GetEntryFileName( uint64_t key, String& rFileName ) const
+{
+	rFileName.Format( TXT( "%s%016" ) PRIx64 TXT( "." ) HELIUM_DERIVED_DATA_CACHE_EXTENSION, *m_directory, key );
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "PcSupport/PcSupport.h"
+
+#include "Platform/Locks.h"
+#include "Foundation/DynamicArray.h"
+#include "Foundation/HashMap.h"
+#include "Foundation/ObjectPool.h"
+#include "Foundation/String.h"
+#include "Engine/Fnv1aHasher.h"
+
+namespace Helium
+{
+    /// Local content-addressed store for preprocessed resource data.
+    ///
+    /// Entries are keyed by a hash of everything that affects the preprocessed output (the source file contents, the
+    /// resource handler and its derived data version, and the resource settings), so identical inputs are only ever
+    /// preprocessed once, no matter which branch or cache file they were first cooked for.  Each entry is stored as a
+    /// separate file in the cache directory.  Once the total size of the entries exceeds the size budget, the least
+    /// recently used entries are deleted.  Entries loaded from disk at startup are ordered by their file modification
+    /// times.  Entries are written to temporary files named after the writing process first, so several processes can
+    /// share the same cache directory.
+    class HELIUM_PC_SUPPORT_API DerivedDataCache : NonCopyable
+    {
+    public:
+        /// Default size budget, in bytes.
+        static const uint64_t DEFAULT_SIZE_BUDGET = 4ULL * 1024 * 1024 * 1024;
+        /// Age after which temporary files left in the cache directory are assumed to be abandoned, in seconds.
+        static const int64_t TEMP_FILE_EXPIRATION_TIME = 60 * 60;
+        /// Number of entries to allocate in each block of the entry pool.
+        static const size_t ENTRY_POOL_BLOCK_SIZE = 256;
+
+        /// Cache key builder.
+        class HELIUM_PC_SUPPORT_API KeyBuilder
+        {
+        public:
+            /// @name Construction/Destruction
+            //@{
+            KeyBuilder();
+            //@}
+
+            /// @name Key Building
+            //@{
+            void Add( const void* pData, size_t size );
+            void Add( const String& rString );
+            void Add( uint32_t value );
+            bool AddFile( const String& rFileName );
+
+            inline uint64_t GetKey() const;
+            //@}
+
+        private:
+            /// Running 64-bit FNV-1a hash.
+            Fnv1aHasher m_hasher;
+        };
+
+        /// Cache usage statistics.
+        struct Stats
+        {
+            /// Number of entries in the cache.
+            size_t entryCount;
+            /// Total size of all entries, in bytes.
+            uint64_t totalSize;
+
+            /// Number of successful lookups.
+            uint32_t hitCount;
+            /// Number of failed lookups.
+            uint32_t missCount;
+            /// Number of entries stored.
+            uint32_t storeCount;
+            /// Number of entries evicted to stay within the size budget.
+            uint32_t evictCount;
+        };
+
+        /// @name Construction/Destruction
+        //@{
+        DerivedDataCache( const String& rDirectory, uint64_t sizeBudget = DEFAULT_SIZE_BUDGET );
+        ~DerivedDataCache();
+        //@}
+
+        /// @name Cache Access
+        //@{
+        bool Load( uint64_t key, DynamicArray< uint8_t >& rData );
+        bool Store( uint64_t key, const void* pData, size_t size );
+
+        inline const String& GetDirectory() const;
+        inline uint64_t GetSizeBudget() const;
+
+        void GetStats( Stats& rStats ) const;
+        //@}
+
+    private:
+        /// Cache entry information.
+        struct Entry
+        {
+            /// Cache key.
+            uint64_t key;
+            /// Entry file size, in bytes.
+            uint64_t size;
+
+            /// Next more recently used entry.
+            Entry* pNewer;
+            /// Next less recently used entry.
+            Entry* pOlder;
+        };
+
+        /// Cache directory (with a trailing slash).
+        String m_directory;
+        /// Size budget, in bytes.
+        uint64_t m_sizeBudget;
+
+        /// Entries, by key.
+        HashMap< uint64_t, Entry* > m_entryMap;
+        /// Entry pool.
+        ObjectPool< Entry > m_entryPool;
+        /// Most recently used entry.
+        Entry* m_pNewest;
+        /// Least recently used entry.
+        Entry* m_pOldest;
+
+        /// Counter used for naming temporary entry files.
+        uint64_t m_tempFileCounter;
+
+        /// Usage statistics.
+        Stats m_stats;
+
+        /// Lock for synchronizing access from multiple preprocessing threads.
+        mutable Mutex m_lock;
+
+        /// @name Private Utility Functions
+        //@{
+        void ScanDirectory();
+        Entry* FindEntry( uint64_t key ) const;
+        void SetEntry( uint64_t key, uint64_t size );
+        void RemoveEntry( uint64_t key );
+        void EvictEntries();
+        void LinkNewest( Entry* pEntry );
+        void Unlink( Entry* pEntry );
+        void GetEntryFileName( uint64_t key, String& rFileName ) const;
+        //@}
+    };
+}
+
+#include "PcSupport/DerivedDataCache.inl"
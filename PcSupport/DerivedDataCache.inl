@@ -0,0 +1,26 @@
+namespace Helium
+{
+    /// Get the cache key for the data added so far.
+    ///
+    /// @return  Cache key.
+    uint64_t DerivedDataCache::KeyBuilder::GetKey() const
+    {
+        return m_hasher.GetHash();
+    }
+
+    /// Get the directory in which cache entries are stored.
+    ///
+    /// @return  Cache directory.
+    const String& DerivedDataCache::GetDirectory() const
+    {
+        return m_directory;
+    }
+
+    /// Get the total size the cache entries are allowed to take up before the least recently used entries are evicted.
+    ///
+    /// @return  Size budget, in bytes.
+    uint64_t DerivedDataCache::GetSizeBudget() const
+    {
+        return m_sizeBudget;
+    }
+}
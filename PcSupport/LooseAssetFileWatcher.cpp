@@ -1,12 +1,20 @@
 #include "PcSupportPch.h"
 #include "LooseAssetFileWatcher.h"
 
+#include "Platform/Timer.h"
 #include "Foundation/DirectoryIterator.h"
 #include "PcSupport/LoosePackageLoader.h"
 #include "Foundation/Log.h"
 #include "Persist/ArchiveJson.h"
 #include "PcSupport/ResourceHandler.h"
 
+#if HELIUM_OS_LINUX
+#include <errno.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
 using namespace Helium;
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -27,14 +35,26 @@ inline void SleepBetweenTracking( bool* cancel = NULL, const uint32_t minutes =
 	//	}
 	//}
 
-	Thread::Sleep( 1000 );
+	Thread::Sleep( LooseAssetFileWatcher::POLL_MILLISECONDS );
 }
 
 LooseAssetFileWatcher::LooseAssetFileWatcher() 
 : m_StopTracking( false )
 , m_InterruptTracking( 0 )
+, m_NotifyHandle( -1 )
+, m_RescanRequested( 0 )
+, m_LastPollTickCount( 0 )
 {
-
+#if HELIUM_OS_LINUX
+	m_NotifyHandle = inotify_init1( IN_NONBLOCK | IN_CLOEXEC );
+	if ( m_NotifyHandle < 0 )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "LooseAssetFileWatcher: Failed to initialize inotify (errno %d).  Packages will be polled for changes.\n" ),
+			errno );
+	}
+#endif
 }
 
 LooseAssetFileWatcher::~LooseAssetFileWatcher()
@@ -43,12 +63,19 @@ LooseAssetFileWatcher::~LooseAssetFileWatcher()
 	{
 		StopThread();
 	}
+
+#if HELIUM_OS_LINUX
+	if ( m_NotifyHandle >= 0 )
+	{
+		close( m_NotifyHandle );
+	}
+#endif
 }
 
 void LooseAssetFileWatcher::AddPackage( LoosePackageLoader *pPackageLoader )
 {
 	AtomicIncrement( m_InterruptTracking );
-	SpinLock lock( m_PathsToWatchLock );
+	MutexScopeLock lock( m_PathsToWatchLock );
 
 #if HELIUM_ASSERT_ENABLED
 	for ( DynamicArray<WatchedPackage>::Iterator iter = m_PathsToWatch.Begin(); iter != m_PathsToWatch.End(); ++iter )
@@ -61,23 +88,39 @@ void LooseAssetFileWatcher::AddPackage( LoosePackageLoader *pPackageLoader )
 	WatchedPackage *pWatchedPackage = m_PathsToWatch.New();
 	pWatchedPackage->m_Path = pPackageLoader->m_packageDirPath;
 	pWatchedPackage->m_Loader = pPackageLoader;
+	pWatchedPackage->m_WatchHandle = AddWatch( pWatchedPackage->m_Path );
 	AtomicDecrement( m_InterruptTracking );
 }
 
 void LooseAssetFileWatcher::RemovePackage( LoosePackageLoader *pPackageLoader )
 {
 	AtomicIncrement( m_InterruptTracking );
-	SpinLock lock( m_PathsToWatchLock );
+	MutexScopeLock lock( m_PathsToWatchLock );
 
 	for ( size_t i = 0; i < m_PathsToWatch.GetSize(); ++i)
 	{
 		if (pPackageLoader == m_PathsToWatch[i].m_Loader)
 		{
+			RemoveWatch( m_PathsToWatch[i].m_WatchHandle );
 			m_PathsToWatch.RemoveSwap(i);
 			break;
 		}
 	}
 
+	// Drop any changes still waiting on the debounce time, as the loader is going away.
+	MutexScopeLock pendingLock( m_PendingChangesLock );
+	for ( size_t i = 0; i < m_PendingChanges.GetSize(); )
+	{
+		if (pPackageLoader == m_PendingChanges[i].m_Loader)
+		{
+			m_PendingChanges.RemoveSwap(i);
+		}
+		else
+		{
+			++i;
+		}
+	}
+
 #if HELIUM_ASSERT_ENABLED
 	for ( DynamicArray<WatchedPackage>::Iterator iter = m_PathsToWatch.Begin(); iter != m_PathsToWatch.End(); ++iter )
 	{
@@ -119,151 +162,468 @@ void LooseAssetFileWatcher::TrackEverything()
 
 	while ( !m_StopTracking )
 	{
-		Log::Print( Log::Levels::Default, TXT("Tracker: Scanning packages for changes...\n"));
-
 		// Do this once outside the inner loop in case we are iterating over nothing
 		assetSync.Sync();
 
+		// Collect change events (waiting up to NOTIFY_WAIT_MILLISECONDS for some to arrive), and check the files that
+		// have settled.
+		if ( m_NotifyHandle >= 0 )
+		{
+			ReadChangeEvents();
+			CheckPendingChanges();
+		}
+
+		// Scan any packages that aren't being watched, or all of them if change events were lost.
+		bool bRescanAll = false;
+		if ( BeginScan( Timer::GetTickCount(), bRescanAll ) )
 		{
-			SpinLock lock( m_PathsToWatchLock );
+			MutexScopeLock lock( m_PathsToWatchLock );
 
 			// Go through all the packages we're tracking
 			for ( DynamicArray<WatchedPackage>::Iterator packageIter = m_PathsToWatch.Begin(); packageIter != m_PathsToWatch.End(); ++packageIter )
 			{
-				assetSync.Sync();
-
-				//Log::Print( Log::Levels::Default, TXT("Tracker: Scanning package %s\n"), packageIter->m_Path.c_str() );
-
-				SimpleTimer packageTimer;
-				Helium::DirectoryIterator directory( packageIter->m_Path );
-
-				// For each file
-				for( ; !directory.IsDone(); directory.Next() )
+				if ( packageIter->m_WatchHandle >= 0 && !bRescanAll )
 				{
-					// If our thread is supposed to die, bail early
-					if ( m_StopTracking )
-					{
-						break;
-					}
-
-					const DirectoryIteratorItem& item = directory.GetItem();
-
-					bool isNewFile = true;
-					bool isChangedFile = false;
-
-					Name objectName;
-					size_t objectIndex = Invalid< size_t >();
-
-					if ( item.m_Path.IsDirectory() )
-					{
-						// Skip directories
-						continue;
-					}
-					else if ( item.m_Path.Extension() == Persist::ArchiveExtensions[ Persist::ArchiveTypes::Json ] )
-					{
-						// JSON files get handled special
-						objectName.Set( item.m_Path.Basename().c_str() );
-						objectIndex = packageIter->m_Loader->FindObjectByName( objectName );
-					}
-					else
-					{
-						// See if it's a raw asset that we can handle
-						String objectNameString( item.m_Path.Filename().c_str() );
-
-						ResourceHandler* pBestHandler = ResourceHandler::GetBestResourceHandlerForFile( objectNameString );
-
-						if (!pBestHandler)
-						{
-							// We don't know what this file is.. skip it
-							continue;
-						}
-
-						objectName.Set( item.m_Path.Filename().c_str() );
-						objectIndex = packageIter->m_Loader->FindObjectByName( objectName );
-					}
-
-					// If the package says it loaded something as fresh as the file, do nothing
-					if ( objectIndex != Invalid< size_t >() &&
-						packageIter->m_Loader->m_objects[objectIndex].fileTimeStamp >= static_cast<int64_t>( directory.GetItem().m_ModTime ))
-					{
-						continue;
-					}
-
-					// If we have already emitted a message for this object, skip it
-					HashMap< Name, WatchedAsset >::Iterator watchedAssetItr = packageIter->m_Assets.Find( objectName );
-					if (watchedAssetItr != packageIter->m_Assets.End())
-					{
-						if (watchedAssetItr->Second().m_LastMessageTime >= static_cast<int64_t>( directory.GetItem().m_ModTime ) )
-						{
-							// We already emitted a message for this file change, so don't do anything
-							continue;
-						}
-
-						// We've emitted a message, but it's been modified again. Emit another message and update the timestamp
-						watchedAssetItr->Second().m_LastMessageTime = static_cast<int64_t>( directory.GetItem().m_ModTime );
-					}
-					else
-					{
-						// We've never emitted a message, so record that we will
-						WatchedAsset watchedAsset;
-						watchedAsset.m_LastMessageTime = static_cast<int64_t>( directory.GetItem().m_ModTime );
-
-						packageIter->m_Assets.Insert(
-							watchedAssetItr, 
-							KeyValue< Name, WatchedAsset >( objectName, watchedAsset ) );
-					}
-				
-					// We know the file is changed and we should throw an event.. choose a different event based on new vs. changed
-					if (objectIndex != Invalid< size_t >())
-					{
-						m_ChangeNotifications.Add( packageIter->m_Loader->GetAssetPath( objectIndex ) );
-					}
-					else
-					{
-						AssetPath path;
-						path.Set( objectName, false, packageIter->m_Loader->GetPackagePath());
-
-						m_NewNotifications.Add( path );
-					}
+					continue;
 				}
 
+				assetSync.Sync();
+
+				ScanPackage( *packageIter );
+
 				if ( m_StopTracking || m_InterruptTracking != 0 )
 				{
-					// Our thread is supposed to die, bail early
-					//Log::Print( Log::Levels::Default, TXT("Tracker: Pre-empted after %.2fm\n"), packageTimer.Elapsed() / 1000.f / 60.f );
+					// Our thread is supposed to die, or a package is being added or removed, so bail early
 					break;
 				}
-				else 
+			}
+		}
+
+		SendNotifications();
+
+		if ( !m_StopTracking && m_NotifyHandle < 0 )
+		{
+			// Sleep between runs and yield to other threads
+			SleepBetweenTracking( &m_StopTracking );
+		}
+	}
+}
+
+/// Scan a package directory for files newer than the ones loaded.
+///
+/// @param[in] rPackage  Package to scan.
+void LooseAssetFileWatcher::ScanPackage( WatchedPackage &rPackage )
+{
+	Helium::DirectoryIterator directory( rPackage.m_Path );
+
+	// For each file
+	for( ; !directory.IsDone(); directory.Next() )
+	{
+		// If our thread is supposed to die, bail early
+		if ( m_StopTracking )
+		{
+			break;
+		}
+
+		const DirectoryIteratorItem& item = directory.GetItem();
+		if ( item.m_Path.IsDirectory() )
+		{
+			// Skip directories
+			continue;
+		}
+
+		CheckFile( rPackage, item.m_Path, static_cast<int64_t>( item.m_ModTime ) );
+	}
+}
+
+/// Check whether a file in a package directory is newer than the loaded asset, queuing a change or new asset
+/// notification if so.
+///
+/// @param[in] rPackage      Package containing the file.
+/// @param[in] rFilePath     File path.
+/// @param[in] modifiedTime  File modification time.
+void LooseAssetFileWatcher::CheckFile( WatchedPackage &rPackage, const FilePath &rFilePath, int64_t modifiedTime )
+{
+	Name objectName;
+	size_t objectIndex = Invalid< size_t >();
+
+	if ( rFilePath.Extension() == Persist::ArchiveExtensions[ Persist::ArchiveTypes::Json ] )
+	{
+		// JSON files get handled special
+		objectName.Set( rFilePath.Basename().c_str() );
+		objectIndex = rPackage.m_Loader->FindObjectByName( objectName );
+	}
+	else
+	{
+		// See if it's a raw asset that we can handle
+		String objectNameString( rFilePath.Filename().c_str() );
+
+		ResourceHandler* pBestHandler = ResourceHandler::GetBestResourceHandlerForFile( objectNameString );
+
+		if (!pBestHandler)
+		{
+			// We don't know what this file is.. skip it
+			return;
+		}
+
+		objectName.Set( rFilePath.Filename().c_str() );
+		objectIndex = rPackage.m_Loader->FindObjectByName( objectName );
+	}
+
+	// If the package says it loaded something as fresh as the file, do nothing
+	if ( objectIndex != Invalid< size_t >() &&
+		rPackage.m_Loader->m_objects[objectIndex].fileTimeStamp >= modifiedTime )
+	{
+		return;
+	}
+
+	// If we have already emitted a message for this object, skip it
+	HashMap< Name, WatchedAsset >::Iterator watchedAssetItr = rPackage.m_Assets.Find( objectName );
+	if (watchedAssetItr != rPackage.m_Assets.End())
+	{
+		if (watchedAssetItr->Second().m_LastMessageTime >= modifiedTime )
+		{
+			// We already emitted a message for this file change, so don't do anything
+			return;
+		}
+
+		// We've emitted a message, but it's been modified again. Emit another message and update the timestamp
+		watchedAssetItr->Second().m_LastMessageTime = modifiedTime;
+	}
+	else
+	{
+		// We've never emitted a message, so record that we will
+		WatchedAsset watchedAsset;
+		watchedAsset.m_LastMessageTime = modifiedTime;
+
+		rPackage.m_Assets.Insert(
+			watchedAssetItr, 
+			KeyValue< Name, WatchedAsset >( objectName, watchedAsset ) );
+	}
+
+	// We know the file is changed and we should throw an event.. choose a different event based on new vs. changed
+	if (objectIndex != Invalid< size_t >())
+	{
+		m_ChangeNotifications.Add( rPackage.m_Loader->GetAssetPath( objectIndex ) );
+	}
+	else
+	{
+		AssetPath path;
+		path.Set( objectName, false, rPackage.m_Loader->GetPackagePath());
+
+		m_NewNotifications.Add( path );
+	}
+}
+
+/// Start watching a package directory for changes.
+///
+/// @param[in] rPath  Package directory.
+///
+/// @return  Watch handle, or -1 if the directory could not be watched and needs to be polled.
+int LooseAssetFileWatcher::AddWatch( const FilePath &rPath )
+{
+#if HELIUM_OS_LINUX
+	if ( m_NotifyHandle < 0 )
+	{
+		return -1;
+	}
+
+	// Files written in place end with IN_CLOSE_WRITE, and files saved by renaming a temporary file over them show up
+	// as IN_MOVED_TO.  IN_MODIFY events keep pushing the debounce time back while a large file is being written.
+	int watchHandle = inotify_add_watch(
+		m_NotifyHandle,
+		rPath.c_str(),
+		IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_TO | IN_CREATE | IN_ONLYDIR );
+	if ( watchHandle < 0 )
+	{
+		// Most likely the per-user watch limit (fs.inotify.max_user_watches) has been reached.
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "LooseAssetFileWatcher: Failed to watch \"%s\" (errno %d).  It will be polled for changes.\n" ),
+			rPath.c_str(),
+			errno );
+	}
+
+	return watchHandle;
+#else
+	HELIUM_UNREF( rPath );
+
+	return -1;
+#endif
+}
+
+/// Stop watching a package directory.
+///
+/// @param[in] watchHandle  Watch handle returned by AddWatch().
+void LooseAssetFileWatcher::RemoveWatch( int watchHandle )
+{
+#if HELIUM_OS_LINUX
+	if ( m_NotifyHandle >= 0 && watchHandle >= 0 )
+	{
+		inotify_rm_watch( m_NotifyHandle, watchHandle );
+	}
+#else
+	HELIUM_UNREF( watchHandle );
+#endif
+}
+
+/// Wait up to NOTIFY_WAIT_MILLISECONDS for change events, adding the files they refer to to the pending changes.
+///
+/// @see QueueChange()
+void LooseAssetFileWatcher::ReadChangeEvents()
+{
+#if HELIUM_OS_LINUX
+	HELIUM_ASSERT( m_NotifyHandle >= 0 );
+
+	pollfd pollDescriptor;
+	pollDescriptor.fd = m_NotifyHandle;
+	pollDescriptor.events = POLLIN;
+	pollDescriptor.revents = 0;
+	if ( poll( &pollDescriptor, 1, NOTIFY_WAIT_MILLISECONDS ) <= 0 )
+	{
+		return;
+	}
+
+	uint64_t tickCount = Timer::GetTickCount();
+
+	MutexScopeLock lock( m_PathsToWatchLock );
+
+	alignas( inotify_event ) char eventBuffer[ 16 * 1024 ];
+	for ( ; ; )
+	{
+		ssize_t readSize = read( m_NotifyHandle, eventBuffer, sizeof( eventBuffer ) );
+		if ( readSize <= 0 )
+		{
+			// EAGAIN once the queue has been drained.
+			break;
+		}
+
+		for ( const char* pEventData = eventBuffer; pEventData < eventBuffer + readSize; )
+		{
+			const inotify_event* pEvent = reinterpret_cast< const inotify_event* >( pEventData );
+			pEventData += sizeof( inotify_event ) + pEvent->len;
+
+			if ( pEvent->mask & IN_Q_OVERFLOW )
+			{
+				RequestRescan();
+				continue;
+			}
+
+			if ( pEvent->len == 0 || ( pEvent->mask & IN_ISDIR ) )
+			{
+				continue;
+			}
+
+			WatchedPackage* pPackage = NULL;
+			for ( size_t i = 0; i < m_PathsToWatch.GetSize(); ++i )
+			{
+				if ( m_PathsToWatch[i].m_WatchHandle == pEvent->wd )
 				{
-					//Log::Print( Log::Levels::Default, TXT("Tracker: Package scanned in %.2fm\n") , packageTimer.Elapsed() / 1000.f / 60.f );
+					pPackage = &m_PathsToWatch[i];
+					break;
 				}
 			}
+
+			if ( !pPackage )
+			{
+				// Event for a package that has since been removed.
+				continue;
+			}
+
+			QueueChange( pPackage->m_Loader, FilePath( pPackage->m_Path + pEvent->name ), tickCount );
 		}
+	}
+#endif
+}
 
-		for ( DynamicArray<AssetPath>::Iterator changedAssetIter = m_ChangeNotifications.Begin(); changedAssetIter != m_ChangeNotifications.End(); ++changedAssetIter )
+/// Check the pending changes that have gone DEBOUNCE_MILLISECONDS without further change events.
+void LooseAssetFileWatcher::CheckPendingChanges()
+{
+	TakeSettledChanges( Timer::GetTickCount(), m_SettledChanges );
+	if ( m_SettledChanges.IsEmpty() )
+	{
+		return;
+	}
+
+	MutexScopeLock lock( m_PathsToWatchLock );
+
+	for ( DynamicArray<PendingChange>::Iterator changeIter = m_SettledChanges.Begin(); changeIter != m_SettledChanges.End(); ++changeIter )
+	{
+		for ( size_t i = 0; i < m_PathsToWatch.GetSize(); ++i )
 		{
-			HELIUM_TRACE( TraceLevels::Info, TXT(" %s IS MODIFIED\n"), *changedAssetIter->ToString());
-			AssetTracker::GetStaticInstance()->NotifyAssetChangedExternally( *changedAssetIter );
+			if ( m_PathsToWatch[i].m_Loader == changeIter->m_Loader )
+			{
+				// The file may have been moved away or deleted again since the event.
+				if ( changeIter->m_Path.Exists() && !changeIter->m_Path.IsDirectory() )
+				{
+					Status status;
+					status.Read( changeIter->m_Path.c_str() );
+
+					CheckFile( m_PathsToWatch[i], changeIter->m_Path, static_cast<int64_t>( status.m_ModifiedTime ) );
+				}
 
-			AssetPtr asset;
-			AssetLoader::GetStaticInstance()->LoadObject( *changedAssetIter, asset, true );
-			Asset::ReplaceAsset( asset.Get(), *changedAssetIter );
+				break;
+			}
 		}
+	}
 
-		for ( DynamicArray<AssetPath>::Iterator newAssetIter = m_NewNotifications.Begin(); newAssetIter != m_NewNotifications.End(); ++newAssetIter )
+	m_SettledChanges.Resize( 0 );
+}
+
+/// Queue a change event for a file, to be checked once it has gone DEBOUNCE_MILLISECONDS without further events.
+///
+/// Repeated events for the same file are coalesced into a single pending change, whose debounce time restarts with
+/// each event.
+///
+/// @param[in] pPackageLoader  Loader of the package containing the file.
+/// @param[in] rFilePath       File path.
+/// @param[in] tickCount       Tick count at which the event was received.
+///
+/// @see TakeSettledChanges()
+void LooseAssetFileWatcher::QueueChange( LoosePackageLoader *pPackageLoader, const FilePath &rFilePath, uint64_t tickCount )
+{
+	MutexScopeLock lock( m_PendingChangesLock );
+
+	PendingChange* pChange = NULL;
+	for ( size_t i = 0; i < m_PendingChanges.GetSize(); ++i )
+	{
+		if ( m_PendingChanges[i].m_Loader == pPackageLoader && m_PendingChanges[i].m_Path == rFilePath )
 		{
-			HELIUM_TRACE( TraceLevels::Info, TXT(" %s IS MODIFIED\n"), *newAssetIter->ToString());
-			AssetTracker::GetStaticInstance()->NotifyAssetCreatedExternally( *newAssetIter );
+			pChange = &m_PendingChanges[i];
+			break;
 		}
+	}
+
+	if ( !pChange )
+	{
+		pChange = m_PendingChanges.New();
+		pChange->m_Loader = pPackageLoader;
+		pChange->m_Path = rFilePath;
+	}
+
+	pChange->m_LastEventTickCount = tickCount;
+}
 
-		m_ChangeNotifications.Clear();
-		m_NewNotifications.Clear();
+/// Take the pending changes that have gone DEBOUNCE_MILLISECONDS without further change events.
+///
+/// @param[in]  tickCount  Current tick count.
+/// @param[out] rChanges   Settled changes (any existing contents are replaced).
+///
+/// @see QueueChange()
+void LooseAssetFileWatcher::TakeSettledChanges( uint64_t tickCount, DynamicArray<PendingChange> &rChanges )
+{
+	rChanges.Resize( 0 );
+
+	uint64_t debounceTicks = MillisecondsToTicks( DEBOUNCE_MILLISECONDS );
+
+	MutexScopeLock lock( m_PendingChangesLock );
 
-		if ( !m_StopTracking )
+	for ( size_t changeIndex = 0; changeIndex < m_PendingChanges.GetSize(); )
+	{
+		if ( tickCount - m_PendingChanges[changeIndex].m_LastEventTickCount < debounceTicks )
 		{
-			// Sleep between runs and yield to other threads
-			// The complex loop is to prevent Editor from hanging on exit (max hang will be "increments" seconds)
-			SleepBetweenTracking( &m_StopTracking );
+			++changeIndex;
+			continue;
 		}
+
+		rChanges.Push( m_PendingChanges[changeIndex] );
+		m_PendingChanges.RemoveSwap( changeIndex );
+	}
+}
+
+/// Get the number of changes still waiting on the debounce time.
+///
+/// @return  Pending change count.
+size_t LooseAssetFileWatcher::GetPendingChangeCount()
+{
+	MutexScopeLock lock( m_PendingChangesLock );
+
+	return m_PendingChanges.GetSize();
+}
+
+/// Request a scan of all packages, including the watched ones, as change events have been lost.
+///
+/// @see BeginScan()
+void LooseAssetFileWatcher::RequestRescan()
+{
+	AtomicExchangeRelease( m_RescanRequested, 1 );
+}
+
+/// Determine whether packages need to be scanned for changes.
+///
+/// Packages that aren't being watched are scanned every POLL_MILLISECONDS, and all packages are scanned once after
+/// a rescan has been requested.  If a scan is due, the poll time restarts and any rescan request is consumed.
+///
+/// @param[in]  tickCount    Current tick count.
+/// @param[out] rbRescanAll  Set to true if all packages need to be scanned, false if only the ones not being watched.
+///
+/// @return  True if a scan is due, false if not.
+///
+/// @see RequestRescan()
+bool LooseAssetFileWatcher::BeginScan( uint64_t tickCount, bool &rbRescanAll )
+{
+	rbRescanAll = ( AtomicExchangeAcquire( m_RescanRequested, 0 ) != 0 );
+
+	bool bPoll = ( tickCount - m_LastPollTickCount >= MillisecondsToTicks( POLL_MILLISECONDS ) );
+	if ( !bPoll && !rbRescanAll )
+	{
+		return false;
+	}
+
+	m_LastPollTickCount = tickCount;
+
+	return true;
+}
+
+/// Convert a time in milliseconds to timer ticks.
+///
+/// @param[in] milliseconds  Time in milliseconds.
+///
+/// @return  Time in timer ticks.
+uint64_t LooseAssetFileWatcher::MillisecondsToTicks( uint32_t milliseconds )
+{
+	return static_cast< uint64_t >( static_cast< float64_t >( milliseconds ) * 0.001 / Timer::GetSecondsPerTick() );
+}
+
+/// Queue reloads of changed assets and notify the asset tracker of changed and new assets found since the last call.
+///
+/// Reloads are only queued here, as loading has to happen on the thread ticking the asset loader.
+///
+/// @see TakeReloadRequests()
+void LooseAssetFileWatcher::SendNotifications()
+{
+	for ( DynamicArray<AssetPath>::Iterator changedAssetIter = m_ChangeNotifications.Begin(); changedAssetIter != m_ChangeNotifications.End(); ++changedAssetIter )
+	{
+		HELIUM_TRACE( TraceLevels::Info, TXT(" %s IS MODIFIED\n"), *changedAssetIter->ToString());
+		AssetTracker::GetStaticInstance()->NotifyAssetChangedExternally( *changedAssetIter );
 	}
-}
\ No newline at end of file
+
+	if ( !m_ChangeNotifications.IsEmpty() )
+	{
+		MutexScopeLock lock( m_ReloadLock );
+		m_ReloadRequests.AddArray( m_ChangeNotifications.GetData(), m_ChangeNotifications.GetSize() );
+	}
+
+	for ( DynamicArray<AssetPath>::Iterator newAssetIter = m_NewNotifications.Begin(); newAssetIter != m_NewNotifications.End(); ++newAssetIter )
+	{
+		HELIUM_TRACE( TraceLevels::Info, TXT(" %s IS MODIFIED\n"), *newAssetIter->ToString());
+		AssetTracker::GetStaticInstance()->NotifyAssetCreatedExternally( *newAssetIter );
+	}
+
+	m_ChangeNotifications.Clear();
+	m_NewNotifications.Clear();
+}
+
+/// Take the paths of the changed assets that need to be reloaded.
+///
+/// This should be called from the thread ticking the asset loader, which then reloads each asset with a forced
+/// reload.
+///
+/// @param[out] rPaths  Paths of the assets to reload (any existing contents are replaced).
+void LooseAssetFileWatcher::TakeReloadRequests( DynamicArray<AssetPath> &rPaths )
+{
+	rPaths.Resize( 0 );
+
+	MutexScopeLock lock( m_ReloadLock );
+	rPaths.Swap( m_ReloadRequests );
+}
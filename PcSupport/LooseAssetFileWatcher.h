@@ -1,12 +1,39 @@
 #pragma once
 
+#include "Platform/Locks.h"
+
 namespace Helium
 {
 	class LoosePackageLoader;
 
+	/// Watches the directories of loose packages for changed and new asset files, queueing changed assets to be
+	/// reloaded by the LooseAssetLoader and notifying the asset tracker of new ones.
+	///
+	/// On Linux, each package directory gets an inotify watch, so only files that actually changed are looked at.
+	/// Events are coalesced per file, and a file is only checked once it has gone DEBOUNCE_MILLISECONDS without
+	/// further events, so the burst of writes from a single save produces a single reload.  Elsewhere, or for any
+	/// package that could not be watched, the package directories are rescanned every POLL_MILLISECONDS for files
+	/// newer than the ones loaded.  All packages are rescanned if the inotify event queue overflows.
 	class HELIUM_PC_SUPPORT_API LooseAssetFileWatcher
 	{
 	public:
+		/// Time a file must go without change events before it is checked.
+		static const uint32_t DEBOUNCE_MILLISECONDS = 250;
+		/// Time to wait for change events before checking pending changes and whether the thread should stop.
+		static const uint32_t NOTIFY_WAIT_MILLISECONDS = 100;
+		/// Time between scans of packages that are not being watched.
+		static const uint32_t POLL_MILLISECONDS = 1000;
+
+		/// File with change events waiting for the debounce time to pass.
+		struct PendingChange
+		{
+			LoosePackageLoader *m_Loader;
+			FilePath m_Path;
+
+			/// Tick count of the most recent change event for the file.
+			uint64_t m_LastEventTickCount;
+		};
+
 		LooseAssetFileWatcher();
 		virtual ~LooseAssetFileWatcher();
 
@@ -19,6 +46,20 @@ namespace Helium
 
 		void TrackEverything();
 
+		void TakeReloadRequests( DynamicArray<AssetPath> &rPaths );
+
+		/// @name Change Event Handling
+		//@{
+		void QueueChange( LoosePackageLoader *pPackageLoader, const FilePath &rFilePath, uint64_t tickCount );
+		void TakeSettledChanges( uint64_t tickCount, DynamicArray<PendingChange> &rChanges );
+		size_t GetPendingChangeCount();
+
+		void RequestRescan();
+		bool BeginScan( uint64_t tickCount, bool &rbRescanAll );
+		//@}
+
+		static uint64_t MillisecondsToTicks( uint32_t milliseconds );
+
 	protected:
 		Helium::CallbackThread m_Thread;
 		bool m_StopTracking;
@@ -34,15 +75,46 @@ namespace Helium
 			FilePath m_Path;
 			LoosePackageLoader *m_Loader;
 
+			/// Change notification watch on the package directory (-1 if the package is polled).
+			int m_WatchHandle;
+
 			HashMap< Name, WatchedAsset > m_Assets;
 		};
 
 		DynamicArray<WatchedPackage> m_PathsToWatch;
-		SpinLock m_PathsToWatchLock;
+		Mutex m_PathsToWatchLock;
+
+		/// Change notification handle (-1 if change notifications are not supported, and all packages are polled).
+		int m_NotifyHandle;
+		/// Files with change events that have yet to be checked.
+		DynamicArray<PendingChange> m_PendingChanges;
+		/// Lock guarding the pending changes (taken after m_PathsToWatchLock if both are needed).
+		Mutex m_PendingChangesLock;
+		/// Pending changes that have settled, waiting to be checked.
+		DynamicArray<PendingChange> m_SettledChanges;
+		/// Non-zero if change events were lost, and all packages need to be rescanned.
+		volatile int32_t m_RescanRequested;
+		/// Tick count of the last scan of polled packages.
+		uint64_t m_LastPollTickCount;
 
 		DynamicArray<AssetPath> m_ChangeNotifications;
 		DynamicArray<AssetPath> m_NewNotifications;
+
+		/// Changed assets waiting to be reloaded by the loading thread.
+		DynamicArray<AssetPath> m_ReloadRequests;
+		/// Lock guarding the reload requests.
+		Mutex m_ReloadLock;
+
+		void ScanPackage( WatchedPackage &rPackage );
+		void CheckFile( WatchedPackage &rPackage, const FilePath &rFilePath, int64_t modifiedTime );
+
+		int AddWatch( const FilePath &rPath );
+		void RemoveWatch( int watchHandle );
+		void ReadChangeEvents();
+		void CheckPendingChanges();
+
+		void SendNotifications();
 	};
 }
 
-#include "LooseAssetFileWatcher.inl"
\ No newline at end of file
+#include "LooseAssetFileWatcher.inl"
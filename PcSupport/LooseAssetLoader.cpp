@@ -2,6 +2,7 @@
 #include "LooseAssetLoader.h"
 
 #include "Platform/File.h"
+#include "Platform/Thread.h"
 #include "Foundation/FilePath.h"
 #include "Engine/FileLocations.h"
 #include "Engine/Config.h"
@@ -13,40 +14,54 @@
 
 using namespace Helium;
 
-#define USE_LOOSE_ASSET_FILE_WATCHER (0)
-
-#if USE_LOOSE_ASSET_FILE_WATCHER
-LooseAssetFileWatcher g_FileWatcher;
-#endif
-
 /// Constructor.
-LooseAssetLoader::LooseAssetLoader()
+///
+/// @param[in] bWatchFiles  True to watch the loaded packages for changed asset files and reload them.
+LooseAssetLoader::LooseAssetLoader( bool bWatchFiles )
+: m_pFileWatcher( NULL )
 {
-#if USE_LOOSE_ASSET_FILE_WATCHER
-	g_FileWatcher.StartThread();
-#endif
+	if( bWatchFiles )
+	{
+		m_pFileWatcher = new LooseAssetFileWatcher;
+		HELIUM_ASSERT( m_pFileWatcher );
+		m_pFileWatcher->StartThread();
+	}
 }
 
 /// Destructor.
 LooseAssetLoader::~LooseAssetLoader()
 {
-#if USE_LOOSE_ASSET_FILE_WATCHER
-	g_FileWatcher.StopThread();
-#endif
+	if( m_pFileWatcher )
+	{
+		m_pFileWatcher->StopThread();
+		delete m_pFileWatcher;
+		m_pFileWatcher = NULL;
+	}
+
+	// Reloads hold references to their load requests, so they must finish before the loader goes away.
+	while( !m_reloadLoadIds.IsEmpty() )
+	{
+		Tick();
+		Thread::Yield();
+	}
 }
 
 /// Initialize the static object loader instance as an LooseAssetLoader.
 ///
+/// @param[in] bWatchFiles  True to watch the loaded packages for changed asset files and reload them.  On Linux, this
+///                         uses inotify and costs next to nothing while files are unchanged, elsewhere the package
+///                         directories are polled.
+///
 /// @return  True if the loader was initialized successfully, false if not or another object loader instance already
 ///          exists.
-bool LooseAssetLoader::InitializeStaticInstance()
+bool LooseAssetLoader::InitializeStaticInstance( bool bWatchFiles )
 {
 	if( sm_pInstance )
 	{
 		return false;
 	}
 
-	sm_pInstance = new LooseAssetLoader;
+	sm_pInstance = new LooseAssetLoader( bWatchFiles );
 	HELIUM_ASSERT( sm_pInstance );
 
 	return true;
@@ -60,12 +75,59 @@ PackageLoader* LooseAssetLoader::GetPackageLoader( AssetPath path )
 	return pLoader;
 }
 
+/// @copydoc AssetLoader::Tick()
+void LooseAssetLoader::Tick()
+{
+	AssetLoader::Tick();
+
+	// Reload assets changed on disk.  Each reload is loaded into a new instance, which replaces the live asset once it
+	// has been fully loaded.
+	if( m_pFileWatcher )
+	{
+		m_pFileWatcher->TakeReloadRequests( m_reloadPaths );
+		size_t reloadPathCount = m_reloadPaths.GetSize();
+		for( size_t pathIndex = 0; pathIndex < reloadPathCount; ++pathIndex )
+		{
+			size_t loadId = BeginLoadObject( m_reloadPaths[ pathIndex ], true );
+			if( IsValid( loadId ) )
+			{
+				m_reloadLoadIds.Push( loadId );
+			}
+		}
+	}
+
+	size_t reloadIndex = m_reloadLoadIds.GetSize();
+	while( reloadIndex != 0 )
+	{
+		--reloadIndex;
+
+		AssetPtr spAsset;
+		if( TryFinishLoad( m_reloadLoadIds[ reloadIndex ], spAsset ) )
+		{
+			m_reloadLoadIds.RemoveSwap( reloadIndex );
+		}
+	}
+}
+
 /// @copydoc AssetLoader::TickPackageLoaders()
 void LooseAssetLoader::TickPackageLoaders()
 {
 	m_packageLoaderMap.TickPackageLoaders();
 }
 
+/// @copydoc AssetLoader::OnLinkComplete()
+void LooseAssetLoader::OnLinkComplete( const AssetPath &path, Asset* pObject, PackageLoader* pPackageLoader )
+{
+	HELIUM_ASSERT( pObject );
+
+	// Keep the binary form of objects just parsed from their object files, so they can skip parsing next time.  This
+	// is done as soon as their references are in place, before precaching and finalization modify them.
+	if( pPackageLoader )
+	{
+		static_cast< LoosePackageLoader* >( pPackageLoader )->UpdateSidecarEntry( path, pObject );
+	}
+}
+
 /// @copydoc AssetLoader::OnLoadComplete()
 void LooseAssetLoader::OnLoadComplete( const AssetPath &path, Asset* pObject, PackageLoader* /*pPackageLoader*/ )
 {
@@ -237,9 +299,16 @@ void Helium::LooseAssetLoader::EnumerateRootPackages( DynamicArray< AssetPath >
 	}
 }
 
+/// Start watching a package for changed asset files once it has been preloaded.
+///
+/// @param[in] pPackageLoader  Loader of the preloaded package.
 void LooseAssetLoader::OnPackagePreloaded( LoosePackageLoader *pPackageLoader )
 {
-#if USE_LOOSE_ASSET_FILE_WATCHER
-	g_FileWatcher.AddPackage( pPackageLoader );
-#endif
+	HELIUM_ASSERT( pPackageLoader );
+
+	LooseAssetLoader* pAssetLoader = static_cast< LooseAssetLoader* >( AssetLoader::GetStaticInstance() );
+	if( pAssetLoader && pAssetLoader->m_pFileWatcher )
+	{
+		pAssetLoader->m_pFileWatcher->AddPackage( pPackageLoader );
+	}
 }
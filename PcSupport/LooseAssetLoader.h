@@ -19,7 +19,7 @@ namespace Helium
 	public:
 		/// @name Construction/Destruction
 		//@{
-		LooseAssetLoader();
+		explicit LooseAssetLoader( bool bWatchFiles = false );
 		~LooseAssetLoader();
 		//@}
 
@@ -30,22 +30,33 @@ namespace Helium
 
 		/// @name Static Initialization
 		//@{
-		static bool InitializeStaticInstance();
+		static bool InitializeStaticInstance( bool bWatchFiles = false );
 		//@}
 
 		virtual void EnumerateRootPackages( DynamicArray< AssetPath > &packagePaths );
 
+		virtual void Tick();
+
 		static void OnPackagePreloaded( LoosePackageLoader *pPackageLoader );
 
 	private:
 		/// XML package loader map.
 		LoosePackageLoaderMap m_packageLoaderMap;
 
+		/// Watcher reloading assets changed on disk (null if files are not being watched).
+		LooseAssetFileWatcher* m_pFileWatcher;
+
+		/// Load IDs of forced reloads of assets changed on disk.
+		DynamicArray< size_t > m_reloadLoadIds;
+		/// Scratch list of the changed assets to reload.
+		DynamicArray< AssetPath > m_reloadPaths;
+
 		/// @name Loading Implementation
 		//@{
 		virtual PackageLoader* GetPackageLoader( AssetPath path );
 		virtual void TickPackageLoaders();
 
+		virtual void OnLinkComplete( const AssetPath &path, Asset* pObject, PackageLoader* pPackageLoader );
 		virtual void OnPrecacheReady( const AssetPath &path, Asset* pObject, PackageLoader* pPackageLoader );
 		virtual void OnLoadComplete( const AssetPath &path, Asset* pObject, PackageLoader* pPackageLoader );
 		//@}
@@ -6,26 +6,77 @@
 #include "Foundation/DirectoryIterator.h"
 #include "Foundation/FileStream.h"
 #include "Foundation/MemoryStream.h"
+#include "Foundation/Stream.h"
 #include "Engine/AsyncLoader.h"
 #include "Engine/CacheManager.h"
 #include "Engine/Config.h"
 #include "Engine/AssetLoader.h"
+#include "Engine/Fnv1aHasher.h"
 #include "Engine/Resource.h"
+#include "Engine/StreamString.h"
 #include "PcSupport/AssetPreprocessor.h"
 #include "PcSupport/ResourceHandler.h"
 #include "Reflect/TranslatorDeduction.h"
 #include "Persist/ArchiveJson.h"
+#include "Persist/ArchiveMessagePack.h"
 
 #include "LooseAssetLoader.h"
 
 using namespace Helium;
 
+/// Sidecar file magic number.
+static const uint32_t SIDECAR_MAGIC = 0x51dec4a0;
+/// Sidecar file format version number.
+static const uint32_t SIDECAR_VERSION = 1;
+
+/// Directory, relative to the PC platform data directory, under which package sidecar files are stored.
+#define HELIUM_LOOSE_SIDECAR_DIRECTORY TXT( "LooseObjects" )
+/// Extension of package sidecar files.
+#define HELIUM_LOOSE_SIDECAR_EXTENSION TXT( ".dat" )
+
+/// Add a string to a hash, prefixed with its length so that consecutive strings can't run together.
+///
+/// @param[in] rHasher  Hasher to update.
+/// @param[in] rString  String to add.
+static void AddHashString( Fnv1aHasher& rHasher, const String& rString )
+{
+	uint32_t length = static_cast< uint32_t >( rString.GetSize() );
+	rHasher.Add( &length, sizeof( length ) );
+	rHasher.Add( rString.GetData(), length * sizeof( char ) );
+}
+
+/// Compute a stamp identifying the state of the non-default templates an object is loaded on top of.
+///
+/// Objects are stored in sidecar files relative to their templates, so a sidecar entry built on top of templates
+/// whose object files have since changed cannot be used.
+///
+/// @param[in] pTemplate  Template of the object.
+///
+/// @return  Template stamp.
+static uint64_t GetTemplateStamp( Asset* pTemplate )
+{
+	Fnv1aHasher hasher;
+
+	for( ;
+		pTemplate && !pTemplate->IsDefaultTemplate();
+		pTemplate = Reflect::AssertCast< Asset >( pTemplate->GetTemplate() ) )
+	{
+		AddHashString( hasher, pTemplate->GetPath().ToString() );
+
+		uint64_t timeStamp = pTemplate->GetAssetFileTimeStamp();
+		hasher.Add( &timeStamp, sizeof( timeStamp ) );
+	}
+
+	return hasher.GetHash();
+}
+
 /// Constructor.
 LoosePackageLoader::LoosePackageLoader()
 	: m_startPreloadCounter( 0 )
 	, m_preloadedCounter( 0 )
 	, m_loadRequestPool( LOAD_REQUEST_POOL_BLOCK_SIZE )
 	, m_parentPackageLoadId( Invalid< size_t >() )
+	, m_bSidecarDirty( false )
 	//, m_pTocLoadBuffer( 0 )
 	//, m_tocAsyncLoadId( Invalid<size_t>() )
 	//, m_packageTocFileSize( 0 )
@@ -75,6 +126,12 @@ bool LoosePackageLoader::Initialize( AssetPath packagePath )
 	// Store the package path.
 	m_packagePath = packagePath;
 
+	// Pre-parsed objects are kept in a sidecar file under the PC platform data directory, mirroring the package tree.
+	m_sidecarFileName = CacheManager::GetStaticInstance().GetPlatformDataDirectory( Cache::PLATFORM_PC );
+	m_sidecarFileName += HELIUM_LOOSE_SIDECAR_DIRECTORY;
+	m_sidecarFileName += packagePath.ToFilePathString();
+	m_sidecarFileName += HELIUM_LOOSE_SIDECAR_EXTENSION;
+
 	// Attempt to locate the specified package if it already happens to exist.
 	m_spPackage = Asset::Find< Package >( packagePath );
 	Package* pPackage = m_spPackage;
@@ -229,6 +286,8 @@ void LoosePackageLoader::Shutdown()
 	
 	HELIUM_ASSERT( IsInvalid( m_parentPackageLoadId ) );
 
+	SaveSidecar();
+
 	// Unset the reference back to this loader in the package.
 	Package* pPackage = m_spPackage;
 	if( pPackage )
@@ -244,6 +303,8 @@ void LoosePackageLoader::Shutdown()
 
 	m_objects.Clear();
 
+	AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
+
 	size_t loadRequestCount = m_loadRequests.GetSize();
 	for( size_t requestIndex = 0; requestIndex < loadRequestCount; ++requestIndex )
 	{
@@ -251,6 +312,47 @@ void LoosePackageLoader::Shutdown()
 		{
 			LoadRequest* pRequest = m_loadRequests[ requestIndex ];
 			HELIUM_ASSERT( pRequest );
+
+			if( IsValid( pRequest->asyncFileLoadId ) )
+			{
+				rAsyncLoader.SyncRequest( pRequest->asyncFileLoadId );
+				SetInvalid( pRequest->asyncFileLoadId );
+			}
+
+			// Deserialization reads from the load buffer and writes into the object, so it must finish before either
+			// is released.
+			if( IsValid( pRequest->deserializeWorkId ) )
+			{
+				rAsyncLoader.SyncRequest( pRequest->deserializeWorkId );
+				SetInvalid( pRequest->deserializeWorkId );
+			}
+
+			if( IsValid( pRequest->persistentResourceDataLoadId ) )
+			{
+				rAsyncLoader.SyncRequest( pRequest->persistentResourceDataLoadId );
+				SetInvalid( pRequest->persistentResourceDataLoadId );
+			}
+
+			if( pRequest->pAsyncFileLoadBuffer )
+			{
+				DefaultAllocator().Free( pRequest->pAsyncFileLoadBuffer );
+				pRequest->pAsyncFileLoadBuffer = NULL;
+				pRequest->asyncFileLoadBufferSize = 0;
+			}
+
+			if( pRequest->pCachedObjectDataBuffer )
+			{
+				DefaultAllocator().Free( pRequest->pCachedObjectDataBuffer );
+				pRequest->pCachedObjectDataBuffer = NULL;
+				pRequest->cachedObjectDataBufferSize = 0;
+			}
+
+			pRequest->deferredResolver.Clear();
+			pRequest->spObject.Release();
+			pRequest->spType.Release();
+			pRequest->spTemplate.Release();
+			pRequest->spOwner.Release();
+
 			m_loadRequestPool.Release( pRequest );
 		}
 	}
@@ -258,10 +360,17 @@ void LoosePackageLoader::Shutdown()
 	m_loadRequests.Clear();
 
 	m_packageDirPath.Clear();
+
+	m_sidecarEntries.Clear();
+	m_sidecarFileName.Clear();
+	m_bSidecarDirty = false;
 }
 
 /// Begin asynchronous pre-loading of package information.
 ///
+/// Object files with an up-to-date entry in the package sidecar file take their metadata from the sidecar, and are
+/// not read during preloading.
+///
 /// @see TryFinishPreload()
 bool LoosePackageLoader::BeginPreload()
 {
@@ -300,6 +409,8 @@ bool LoosePackageLoader::BeginPreload()
 	}
 	else
 	{
+		LoadSidecar();
+
 		DirectoryIterator packageDirectory( m_packageDirPath );
 
 		HELIUM_TRACE( TraceLevels::Info, TXT(" LoosePackageLoader::BeginPreload - Issuing read requests for all files in %s\n"), m_packageDirPath.c_str() );
@@ -321,6 +432,20 @@ bool LoosePackageLoader::BeginPreload()
 #endif
 			if ( item.m_Path.Extension() == Persist::ArchiveExtensions[ Persist::ArchiveTypes::Json ] )
 			{
+				Name objectName( item.m_Path.Basename().c_str() );
+
+				HashMap< Name, SidecarEntry >::ConstIterator sidecarIterator = m_sidecarEntries.Find( objectName );
+				if( sidecarIterator != m_sidecarEntries.End() &&
+					sidecarIterator->Second().fileSize == static_cast< int64_t >( item.m_Size ) &&
+					sidecarIterator->Second().fileTimeStamp == static_cast< int64_t >( item.m_ModTime ) )
+				{
+					HELIUM_TRACE( TraceLevels::Info, TXT("- Using sidecar entry for file [%s]\n"), item.m_Path.c_str() );
+
+					AddSidecarObject( objectName, sidecarIterator->Second(), item.m_Path );
+
+					continue;
+				}
+
 				HELIUM_TRACE( TraceLevels::Info, TXT("- Reading file [%s]\n"), item.m_Path.c_str() );
 
 				FileReadRequest *request = m_fileReadRequests.New();
@@ -403,6 +528,9 @@ size_t LoosePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 		SetInvalid( pRequest->asyncFileLoadId );
 		pRequest->pAsyncFileLoadBuffer = NULL;
 		pRequest->asyncFileLoadBufferSize = 0;
+		SetInvalid( pRequest->deserializeWorkId );
+		pRequest->bSidecarObjectData = false;
+		pRequest->objectFileTimeStamp = 0;
 		pRequest->pResolver = NULL;
 		pRequest->forceReload = forceReload;
 
@@ -500,6 +628,9 @@ size_t LoosePackageLoader::BeginLoadObject( AssetPath path, Reflect::ObjectResol
 	SetInvalid( pRequest->asyncFileLoadId );
 	pRequest->pAsyncFileLoadBuffer = NULL;
 	pRequest->asyncFileLoadBufferSize = 0;
+	SetInvalid( pRequest->deserializeWorkId );
+	pRequest->bSidecarObjectData = false;
+	pRequest->objectFileTimeStamp = 0;
 	pRequest->pResolver = pResolver;
 	pRequest->forceReload = forceReload;
 
@@ -773,6 +904,35 @@ void LoosePackageLoader::TickPreload()
 			// the name is deduced from the file name (bad idea to store it in the file)
 			Name name ( m_fileReadRequests[i].filePath.Basename().c_str() );
 
+			Fnv1aHasher hasher;
+			hasher.Add( rRequest.pLoadBuffer, bytes_read );
+			uint64_t fileHash = hasher.GetHash();
+
+			HashMap< Name, SidecarEntry >::Iterator sidecarIterator = m_sidecarEntries.Find( name );
+			if( sidecarIterator != m_sidecarEntries.End() )
+			{
+				SidecarEntry& rEntry = sidecarIterator->Second();
+				if( rEntry.fileSize == static_cast< int64_t >( bytes_read ) && rEntry.fileHash == fileHash )
+				{
+					// Only the modification time of the file changed (such as from switching to a branch with the
+					// same content), so the sidecar entry is still good.
+					rEntry.fileTimeStamp = static_cast< int64_t >( rRequest.fileTimestamp );
+					m_bSidecarDirty = true;
+
+					AddSidecarObject( name, rEntry, rRequest.filePath );
+
+					DefaultAllocator().Free( rRequest.pLoadBuffer );
+					rRequest.pLoadBuffer = NULL;
+					SetInvalid(rRequest.asyncLoadId);
+					m_fileReadRequests.RemoveSwap(i);
+
+					continue;
+				}
+
+				m_sidecarEntries.Remove( name );
+				m_bSidecarDirty = true;
+			}
+
 			// read some preliminary data from the json
 			struct PreliminaryObjectHandler : rapidjson::BaseReaderHandler<>
 			{
@@ -837,6 +997,19 @@ void LoosePackageLoader::TickPreload()
 				pObjectData->fileTimeStamp = rRequest.fileTimestamp;
 				pObjectData->bMetadataGood = true;
 
+				// Start a new sidecar entry for the object.  Its binary form is filled in once it has been deserialized
+				// and linked.
+				SidecarEntry entry;
+				entry.fileSize = static_cast< int64_t >( bytes_read );
+				entry.fileTimeStamp = static_cast< int64_t >( rRequest.fileTimestamp );
+				entry.fileHash = fileHash;
+				entry.typeName = pObjectData->typeName;
+				entry.templatePath = pObjectData->templatePath;
+				entry.templateStamp = 0;
+				entry.typeStamp = 0;
+
+				m_sidecarEntries.Insert( sidecarIterator, KeyValue< Name, SidecarEntry >( name, entry ) );
+
 				HELIUM_TRACE(
 					TraceLevels::Debug,
 					TXT( "LoosePackageLoader: Success reading preliminary data for object '%s' from file '%s'.\n" ),
@@ -961,6 +1134,9 @@ void LoosePackageLoader::TickPreload()
 	AtomicExchangeRelease( m_preloadedCounter, 1 );
 
 	LooseAssetLoader::OnPackagePreloaded( this );
+
+	// Let the asset loader know load requests waiting on this package can now proceed.
+	AssetLoader::GetStaticInstance()->WakePackageLoadRequests( this );
 }
 
 /// Update load processing of object load requests.
@@ -977,6 +1153,12 @@ void LoosePackageLoader::TickLoadRequests()
 		LoadRequest* pRequest = m_loadRequests[ loadRequestIndex ];
 		HELIUM_ASSERT( pRequest );
 
+		// Requests already preloaded are just waiting to be synced.
+		if( ( pRequest->flags & LOAD_FLAG_PRELOADED ) == LOAD_FLAG_PRELOADED )
+		{
+			continue;
+		}
+
 		if( !( pRequest->flags & LOAD_FLAG_PROPERTY_PRELOADED ) )
 		{
 			if( !TickDeserialize( pRequest ) )
@@ -996,6 +1178,10 @@ void LoosePackageLoader::TickLoadRequests()
 				continue;
 			}
 		}
+
+		// Let the asset loader know the request is ready to be synced (this includes requests that failed to
+		// deserialize, which are flagged as preloaded along with the error).
+		AssetLoader::GetStaticInstance()->WakeLoadRequest( m_objects[ pRequest->index ].objectPath );
 	}
 }
 
@@ -1041,6 +1227,22 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 	HELIUM_ASSERT( pRequest );
 	HELIUM_ASSERT( !( pRequest->flags & LOAD_FLAG_PROPERTY_PRELOADED ) );
 
+	AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
+
+	// Wait for the object file to be deserialized on a worker thread.
+	if( IsValid( pRequest->deserializeWorkId ) )
+	{
+		size_t workBytesRead;
+		if( !rAsyncLoader.TrySyncRequest( pRequest->deserializeWorkId, workBytesRead ) )
+		{
+			return false;
+		}
+
+		SetInvalid( pRequest->deserializeWorkId );
+
+		return FinishDeserialize( pRequest, false );
+	}
+
 	Asset* pObject = pRequest->spObject;
 
 	HELIUM_ASSERT( pRequest->index < m_objects.GetSize() );
@@ -1125,7 +1327,6 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 	HELIUM_ASSERT( !pOwner || pOwner->IsFullyLoaded() );
 	HELIUM_ASSERT( !pTemplate || pTemplate->IsFullyLoaded() );
 
-	AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
 	FilePath object_file_path = m_packageDirPath + *rObjectData.objectPath.GetName() + TXT( "." ) + Persist::ArchiveExtensions[ Persist::ArchiveTypes::Json ];
 
 	bool load_properties_from_file = true;
@@ -1160,6 +1361,7 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 			Status status;
 			status.Read( object_file_path.Get().c_str() );
 			int64_t i64_object_file_size = status.m_Size;
+			pRequest->objectFileTimeStamp = static_cast< int64_t >( status.m_ModifiedTime );
 
 			if( i64_object_file_size == -1 )
 			{
@@ -1193,6 +1395,17 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 				object_file_size = static_cast< size_t >(i64_object_file_size);
 			}
 		}
+
+		const SidecarEntry* pSidecarEntry = NULL;
+		if (load_properties_from_file && object_file_size)
+		{
+			pSidecarEntry = FindSidecarEntry(
+				pRequest->index,
+				static_cast< int64_t >( object_file_size ),
+				pRequest->objectFileTimeStamp,
+				pTemplate,
+				pType );
+		}
 		
 		if (!load_properties_from_file)
 		{
@@ -1203,6 +1416,21 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 			pRequest->flags |= LOAD_FLAG_PRELOADED | LOAD_FLAG_ERROR;
 			return true;
 		}
+		else if( pSidecarEntry )
+		{
+			// The sidecar holds the object already parsed from the current contents of its object file, so use that
+			// instead of reading and parsing the object file.  The data is copied, as the sidecar entries may change
+			// while the object is being deserialized.
+			size_t objectDataSize = pSidecarEntry->objectData.GetSize();
+
+			HELIUM_ASSERT( !pRequest->pAsyncFileLoadBuffer );
+			pRequest->pAsyncFileLoadBuffer = DefaultAllocator().Allocate( objectDataSize );
+			HELIUM_ASSERT( pRequest->pAsyncFileLoadBuffer );
+			MemoryCopy( pRequest->pAsyncFileLoadBuffer, pSidecarEntry->objectData.GetData(), objectDataSize );
+
+			pRequest->asyncFileLoadBufferSize = objectDataSize;
+			pRequest->bSidecarObjectData = true;
+		}
 		else
 		{
 			HELIUM_ASSERT( !pRequest->pAsyncFileLoadBuffer );
@@ -1221,7 +1449,11 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 	}
 	
 	size_t bytesRead = 0;
-	if (load_properties_from_file)
+	if (pRequest->bSidecarObjectData)
+	{
+		bytesRead = pRequest->asyncFileLoadBufferSize;
+	}
+	else if (load_properties_from_file)
 	{
 		HELIUM_ASSERT( IsValid( pRequest->asyncFileLoadId ) );
 
@@ -1231,8 +1463,8 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 		}
 	}
 
-	/////// POINT OF NO RETURN: We *will* return true after this point, and the object *will* be finished preloading,
-	/////// for good or for bad.
+	/////// POINT OF NO RETURN: The object *will* be finished preloading after this point (once any deserialization
+	/////// work queued below has been synced), for good or for bad.
 
 	SetInvalid(pRequest->asyncFileLoadId);
 	bool object_creation_failure = false;
@@ -1261,9 +1493,10 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 	else
 	{
 		bool bCreateResult = false;
-		if (pRequest->forceReload)
+		if (pRequest->forceReload && Asset::FindObject( rObjectData.objectPath ))
 		{
-			// Create the object.
+			// Reload into a fresh, unnamed instance so that the live object is never touched while a worker is
+			// deserializing.  The AssetLoader swaps the new instance in on the loading thread once it is fully loaded.
 			bCreateResult = Asset::CreateObject(
 				pRequest->spObject,
 				pType,
@@ -1320,31 +1553,74 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 		}
 		else
 		{
-			StaticMemoryStream archiveStream ( pRequest->pAsyncFileLoadBuffer, pRequest->asyncFileLoadBufferSize );
-
 			HELIUM_TRACE(
 				TraceLevels::Info,
-				TXT( "LoosePackageLoader: Reading %s. pResolver = %x\n"), 
+				TXT( "LoosePackageLoader: Reading %s%s. pResolver = %x\n"), 
 				object_file_path.c_str(),
+				pRequest->bSidecarObjectData ? TXT( " (from sidecar)" ) : TXT( "" ),
 				pRequest->pResolver);
 
-			DynamicArray< Reflect::ObjectPtr > objects;
-			objects.Push( pRequest->spObject.Get() ); // use existing objects
-			Persist::ArchiveReaderJson::ReadFromStream( archiveStream, objects, pRequest->pResolver );
-			HELIUM_ASSERT( objects[0].Get() == pRequest->spObject.Get() );
+			if( !pRequest->bSidecarObjectData )
+			{
+				ResetSidecarEntry(
+					pRequest->index,
+					static_cast< int64_t >( bytesRead ),
+					pRequest->objectFileTimeStamp,
+					pRequest->pAsyncFileLoadBuffer );
+			}
+
+			// Parse the object file on a worker thread so that independent objects are deserialized in parallel.
+			pRequest->deserializeWorkId = rAsyncLoader.QueueWork( DeserializeObjectFile, pRequest );
+			if( IsValid( pRequest->deserializeWorkId ) )
+			{
+				return false;
+			}
+
+			// No workers are available, so deserialize on this thread.
+			DeserializeObjectFile( pRequest );
 		}
 	}
 
-	if (load_properties_from_file)
+	return FinishDeserialize( pRequest, object_creation_failure );
+}
+
+/// Finish object property preloading for a given load request once its object file has been deserialized.
+///
+/// @param[in] pRequest               Load request to process.
+/// @param[in] bObjectCreationFailure  True if the object could not be created or reused for loading.
+///
+/// @return  True, as object property preloading for the given load request is always complete at this point.
+bool LoosePackageLoader::FinishDeserialize( LoadRequest* pRequest, bool bObjectCreationFailure )
+{
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( IsInvalid( pRequest->deserializeWorkId ) );
+
+	Asset* pObject = pRequest->spObject;
+	HELIUM_ASSERT( pObject );
+
+	HELIUM_ASSERT( pRequest->index < m_objects.GetSize() );
+	SerializedObjectData& rObjectData = m_objects[ pRequest->index ];
+
+	// Pass on any references found while deserializing, beginning the loads of the referenced objects.
+	if( pRequest->pResolver )
+	{
+		pRequest->deferredResolver.ResolveDeferred( pRequest->pResolver );
+	}
+
+	pRequest->deferredResolver.Clear();
+
+	if( pRequest->pAsyncFileLoadBuffer )
 	{
 		DefaultAllocator().Free(pRequest->pAsyncFileLoadBuffer);
 		pRequest->pAsyncFileLoadBuffer = NULL;
 		pRequest->asyncFileLoadBufferSize = 0;
 	}
 
+	pRequest->bSidecarObjectData = false;
+
 	pRequest->flags |= LOAD_FLAG_PROPERTY_PRELOADED;
 
-	if( object_creation_failure )
+	if( bObjectCreationFailure )
 	{
 		HELIUM_TRACE(
 			TraceLevels::Error,
@@ -1381,11 +1657,9 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 				HELIUM_ASSERT( pRequest->pCachedObjectDataBuffer );
 				pRequest->cachedObjectDataBufferSize = pEntry->size;
 
-				AsyncLoader& rAsyncLoader = AsyncLoader::GetStaticInstance();
-				pRequest->persistentResourceDataLoadId = rAsyncLoader.QueueRequest(
+				pRequest->persistentResourceDataLoadId = pCache->QueueEntryLoad(
+					*pEntry,
 					pRequest->pCachedObjectDataBuffer,
-					pCache->GetCacheFileName(),
-					pEntry->offset,
 					pEntry->size );
 				HELIUM_ASSERT( IsValid( pRequest->persistentResourceDataLoadId ) );
 			}
@@ -1403,6 +1677,40 @@ bool LoosePackageLoader::TickDeserialize( LoadRequest* pRequest )
 	return true;
 }
 
+/// Deserialize the object file loaded for a given load request into its object.
+///
+/// This runs on an async loader worker thread, so references to other objects are only recorded, and are resolved
+/// by FinishDeserialize() once back on the loading thread.  If the object was found in the package sidecar, its
+/// binary form is deserialized instead.
+///
+/// @param[in] pData  Load request to process.
+void LoosePackageLoader::DeserializeObjectFile( void* pData )
+{
+	LoadRequest* pRequest = static_cast< LoadRequest* >( pData );
+	HELIUM_ASSERT( pRequest );
+	HELIUM_ASSERT( pRequest->pAsyncFileLoadBuffer );
+
+	StaticMemoryStream archiveStream ( pRequest->pAsyncFileLoadBuffer, pRequest->asyncFileLoadBufferSize );
+
+	DynamicArray< Reflect::ObjectPtr > objects;
+	objects.Push( pRequest->spObject.Get() ); // use existing objects
+	if( pRequest->bSidecarObjectData )
+	{
+		Persist::ArchiveReaderMessagePack::ReadFromStream(
+			archiveStream,
+			objects,
+			pRequest->pResolver ? &pRequest->deferredResolver : NULL );
+	}
+	else
+	{
+		Persist::ArchiveReaderJson::ReadFromStream(
+			archiveStream,
+			objects,
+			pRequest->pResolver ? &pRequest->deferredResolver : NULL );
+	}
+	HELIUM_ASSERT( objects[0].Get() == pRequest->spObject.Get() );
+}
+
 /// Update processing of persistent resource data loading for a given load request.
 ///
 /// @param[in] pRequest  Load request to process.
@@ -1525,3 +1833,404 @@ bool LoosePackageLoader::TickPersistentResourcePreload( LoadRequest* pRequest )
 
 	return true;
 }
+
+/// Store the binary form of an object in the package sidecar once it has been deserialized from its object file and
+/// its references have been linked, so that its object file does not need to be parsed the next time it is loaded.
+///
+/// This should be called before the object is precached or finalized, as either may modify it.  Objects already
+/// loaded from the sidecar, or that have changed since they were loaded, are left alone.
+///
+/// @param[in] path     Asset path.
+/// @param[in] pObject  Loaded object.
+///
+/// @see SaveSidecar()
+void LoosePackageLoader::UpdateSidecarEntry( const AssetPath &path, Asset *pObject )
+{
+	HELIUM_ASSERT( pObject );
+
+	MutexScopeLock scopeLock( m_accessLock );
+
+	if( !( path.GetParent() == m_packagePath ) ||
+		pObject->IsDefaultTemplate() ||
+		pObject->GetAnyFlagSet( Asset::FLAG_BROKEN | Asset::FLAG_CHANGED_SINCE_LOADED ) )
+	{
+		return;
+	}
+
+	HashMap< Name, SidecarEntry >::Iterator sidecarIterator = m_sidecarEntries.Find( path.GetName() );
+	if( sidecarIterator == m_sidecarEntries.End() )
+	{
+		return;
+	}
+
+	SidecarEntry& rEntry = sidecarIterator->Second();
+	if( rEntry.objectData.GetSize() != 0 )
+	{
+		return;
+	}
+
+	AssetIdentifier assetIdentifier;
+	DynamicMemoryStream archiveStream( &rEntry.objectData );
+	Persist::ArchiveWriterMessagePack::WriteToStream( pObject, archiveStream, &assetIdentifier );
+
+	rEntry.templateStamp = GetTemplateStamp( Reflect::AssertCast< Asset >( pObject->GetTemplate() ) );
+	rEntry.typeStamp = GetTypeStamp( pObject->GetMetaClass() );
+
+	m_bSidecarDirty = true;
+}
+
+/// Get whether the sidecar entry for an object holds its binary form.
+///
+/// @param[in] objectName  Object name.
+///
+/// @return  True if the object has a filled-in sidecar entry, false if not.
+bool LoosePackageLoader::HasSidecarObjectData( Name objectName ) const
+{
+	MutexScopeLock scopeLock( m_accessLock );
+
+	HashMap< Name, SidecarEntry >::ConstIterator sidecarIterator = m_sidecarEntries.Find( objectName );
+
+	return ( sidecarIterator != m_sidecarEntries.End() && sidecarIterator->Second().objectData.GetSize() != 0 );
+}
+
+/// Compute a stamp identifying the reflected layout of a type.
+///
+/// Sidecar entries hold objects in binary form, which can't be read back correctly once fields of their type have
+/// been added, removed, renamed or resized, so entries built with a different stamp are not used.
+///
+/// @param[in] pStruct  Type.
+///
+/// @return  Type stamp.
+uint64_t LoosePackageLoader::GetTypeStamp( const Reflect::MetaStruct* pStruct )
+{
+	Fnv1aHasher hasher;
+
+	for( ; pStruct; pStruct = pStruct->m_Base )
+	{
+		AddHashString( hasher, String( pStruct->m_Name ) );
+
+		uint32_t fieldCount = static_cast< uint32_t >( pStruct->m_Fields.GetSize() );
+		hasher.Add( &fieldCount, sizeof( fieldCount ) );
+
+		DynamicArray< Reflect::Field >::ConstIterator fieldEnd = pStruct->m_Fields.End();
+		for( DynamicArray< Reflect::Field >::ConstIterator fieldIterator = pStruct->m_Fields.Begin();
+			fieldIterator != fieldEnd;
+			++fieldIterator )
+		{
+			AddHashString( hasher, String( fieldIterator->m_Name ) );
+
+			uint32_t fieldLayout[ 2 ] =
+			{
+				static_cast< uint32_t >( fieldIterator->m_Size ),
+				static_cast< uint32_t >( fieldIterator->m_Count )
+			};
+			hasher.Add( fieldLayout, sizeof( fieldLayout ) );
+		}
+	}
+
+	return hasher.GetHash();
+}
+
+/// Save the package sidecar file, if any of its entries have changed since it was loaded or last saved.
+///
+/// Only entries for objects that still exist in the package and have their binary form filled in are saved.
+///
+/// @return  True if the sidecar was saved successfully or had no changes to save, false if saving failed.
+///
+/// @see UpdateSidecarEntry()
+bool LoosePackageLoader::SaveSidecar()
+{
+	MutexScopeLock scopeLock( m_accessLock );
+
+	if( !m_bSidecarDirty || m_sidecarFileName.IsEmpty() )
+	{
+		return true;
+	}
+
+	DynamicArray< const KeyValue< Name, SidecarEntry >* > savedEntries;
+
+	HashMap< Name, SidecarEntry >::ConstIterator sidecarEnd = m_sidecarEntries.End();
+	for( HashMap< Name, SidecarEntry >::ConstIterator sidecarIterator = m_sidecarEntries.Begin();
+		sidecarIterator != sidecarEnd;
+		++sidecarIterator )
+	{
+		if( sidecarIterator->Second().objectData.GetSize() != 0 &&
+			IsValid( FindObjectByName( sidecarIterator->First() ) ) )
+		{
+			savedEntries.Push( &*sidecarIterator );
+		}
+	}
+
+	FilePath sidecarFilePath( *m_sidecarFileName );
+	if( !sidecarFilePath.MakePath() )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "LoosePackageLoader: Failed to create the directory for sidecar file \"%s\".\n" ),
+			*m_sidecarFileName );
+	}
+
+	FileStream* pFileStream = FileStream::OpenFileStream( m_sidecarFileName, FileStream::MODE_WRITE, true );
+	if( !pFileStream )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "LoosePackageLoader: Failed to open sidecar file \"%s\" for writing.\n" ),
+			*m_sidecarFileName );
+
+		return false;
+	}
+
+	BufferedStream* pBufferedStream = new BufferedStream( pFileStream );
+	HELIUM_ASSERT( pBufferedStream );
+
+	uint32_t entryCount = static_cast< uint32_t >( savedEntries.GetSize() );
+	bool bWriteSuccess = ( pBufferedStream->Write( &SIDECAR_MAGIC, sizeof( SIDECAR_MAGIC ), 1 ) == 1 &&
+		pBufferedStream->Write( &SIDECAR_VERSION, sizeof( SIDECAR_VERSION ), 1 ) == 1 &&
+		pBufferedStream->Write( &entryCount, sizeof( entryCount ), 1 ) == 1 );
+
+	String templatePathString;
+	for( uint32_t entryIndex = 0; bWriteSuccess && entryIndex < entryCount; ++entryIndex )
+	{
+		const SidecarEntry& rEntry = savedEntries[ entryIndex ]->Second();
+
+		templatePathString.Clear();
+		if( !rEntry.templatePath.IsEmpty() )
+		{
+			rEntry.templatePath.ToString( templatePathString );
+		}
+
+		uint32_t objectDataSize = static_cast< uint32_t >( rEntry.objectData.GetSize() );
+		bWriteSuccess = ( WriteLengthPrefixedString( *pBufferedStream, String( *savedEntries[ entryIndex ]->First() ) ) &&
+			pBufferedStream->Write( &rEntry.fileSize, sizeof( rEntry.fileSize ), 1 ) == 1 &&
+			pBufferedStream->Write( &rEntry.fileTimeStamp, sizeof( rEntry.fileTimeStamp ), 1 ) == 1 &&
+			pBufferedStream->Write( &rEntry.fileHash, sizeof( rEntry.fileHash ), 1 ) == 1 &&
+			WriteLengthPrefixedString( *pBufferedStream, String( *rEntry.typeName ) ) &&
+			WriteLengthPrefixedString( *pBufferedStream, templatePathString ) &&
+			pBufferedStream->Write( &rEntry.templateStamp, sizeof( rEntry.templateStamp ), 1 ) == 1 &&
+			pBufferedStream->Write( &rEntry.typeStamp, sizeof( rEntry.typeStamp ), 1 ) == 1 &&
+			pBufferedStream->Write( &objectDataSize, sizeof( objectDataSize ), 1 ) == 1 &&
+			pBufferedStream->Write( rEntry.objectData.GetData(), 1, objectDataSize ) == objectDataSize );
+	}
+
+	delete pBufferedStream;
+	delete pFileStream;
+
+	if( !bWriteSuccess )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "LoosePackageLoader: Failed to write sidecar file \"%s\".\n" ),
+			*m_sidecarFileName );
+
+		sidecarFilePath.Delete();
+
+		return false;
+	}
+
+	m_bSidecarDirty = false;
+
+	HELIUM_TRACE(
+		TraceLevels::Debug,
+		TXT( "LoosePackageLoader: Saved %" ) PRIu32 TXT( " objects to sidecar file \"%s\".\n" ),
+		entryCount,
+		*m_sidecarFileName );
+
+	return true;
+}
+
+/// Replace the sidecar entries of this package with the contents of its sidecar file.
+///
+/// Entries are only used once they have been validated against the object files they were built from, so a
+/// missing or unreadable sidecar file just means that every object file is parsed.
+void LoosePackageLoader::LoadSidecar()
+{
+	m_sidecarEntries.Clear();
+	m_bSidecarDirty = false;
+
+	if( m_sidecarFileName.IsEmpty() )
+	{
+		return;
+	}
+
+	FileStream* pFileStream = FileStream::OpenFileStream( m_sidecarFileName, FileStream::MODE_READ );
+	if( !pFileStream )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Debug,
+			TXT( "LoosePackageLoader: Sidecar file \"%s\" does not exist.\n" ),
+			*m_sidecarFileName );
+
+		return;
+	}
+
+	BufferedStream* pBufferedStream = new BufferedStream( pFileStream );
+	HELIUM_ASSERT( pBufferedStream );
+
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	uint32_t entryCount = 0;
+	bool bReadSuccess = ( pBufferedStream->Read( &magic, sizeof( magic ), 1 ) == 1 &&
+		pBufferedStream->Read( &version, sizeof( version ), 1 ) == 1 &&
+		pBufferedStream->Read( &entryCount, sizeof( entryCount ), 1 ) == 1 &&
+		magic == SIDECAR_MAGIC &&
+		version == SIDECAR_VERSION );
+
+	DynamicArray< char > nameString;
+	DynamicArray< char > typeNameString;
+	DynamicArray< char > templatePathString;
+	for( uint32_t entryIndex = 0; bReadSuccess && entryIndex < entryCount; ++entryIndex )
+	{
+		SidecarEntry entry;
+		uint32_t objectDataSize = 0;
+		bReadSuccess = ( ReadLengthPrefixedString( *pBufferedStream, nameString ) &&
+			pBufferedStream->Read( &entry.fileSize, sizeof( entry.fileSize ), 1 ) == 1 &&
+			pBufferedStream->Read( &entry.fileTimeStamp, sizeof( entry.fileTimeStamp ), 1 ) == 1 &&
+			pBufferedStream->Read( &entry.fileHash, sizeof( entry.fileHash ), 1 ) == 1 &&
+			ReadLengthPrefixedString( *pBufferedStream, typeNameString ) &&
+			ReadLengthPrefixedString( *pBufferedStream, templatePathString ) &&
+			pBufferedStream->Read( &entry.templateStamp, sizeof( entry.templateStamp ), 1 ) == 1 &&
+			pBufferedStream->Read( &entry.typeStamp, sizeof( entry.typeStamp ), 1 ) == 1 &&
+			pBufferedStream->Read( &objectDataSize, sizeof( objectDataSize ), 1 ) == 1 );
+		if( bReadSuccess )
+		{
+			entry.objectData.Resize( objectDataSize );
+			bReadSuccess = ( pBufferedStream->Read( entry.objectData.GetData(), 1, objectDataSize ) == objectDataSize );
+		}
+
+		if( !bReadSuccess )
+		{
+			break;
+		}
+
+		entry.typeName = Name( typeNameString.GetData() );
+		if( templatePathString[ 0 ] != TXT( '\0' ) && !entry.templatePath.Set( templatePathString.GetData() ) )
+		{
+			// The template may have been renamed since the entry was written, so just skip the entry.
+			continue;
+		}
+
+		HashMap< Name, SidecarEntry >::Iterator sidecarIterator;
+		m_sidecarEntries.Insert( sidecarIterator, KeyValue< Name, SidecarEntry >( Name( nameString.GetData() ), entry ) );
+	}
+
+	delete pBufferedStream;
+	delete pFileStream;
+
+	if( !bReadSuccess )
+	{
+		HELIUM_TRACE(
+			TraceLevels::Warning,
+			TXT( "LoosePackageLoader: Sidecar file \"%s\" is invalid or out of date.  All objects will be parsed.\n" ),
+			*m_sidecarFileName );
+
+		m_sidecarEntries.Clear();
+
+		return;
+	}
+
+	HELIUM_TRACE(
+		TraceLevels::Debug,
+		TXT( "LoosePackageLoader: Loaded %" ) PRIuSZ TXT( " entries from sidecar file \"%s\".\n" ),
+		m_sidecarEntries.GetSize(),
+		*m_sidecarFileName );
+}
+
+/// Add an object to this package using the metadata stored in its sidecar entry.
+///
+/// @param[in] name       Object name.
+/// @param[in] rEntry     Sidecar entry for the object.
+/// @param[in] rFilePath  Object file path.
+void LoosePackageLoader::AddSidecarObject( Name name, const SidecarEntry& rEntry, const FilePath& rFilePath )
+{
+	SerializedObjectData* pObjectData = m_objects.New();
+	HELIUM_ASSERT( pObjectData );
+	HELIUM_VERIFY( pObjectData->objectPath.Set( name, false, m_packagePath ) );
+	pObjectData->templatePath = rEntry.templatePath;
+	pObjectData->typeName = rEntry.typeName;
+	pObjectData->filePath = rFilePath;
+	pObjectData->fileTimeStamp = rEntry.fileTimeStamp;
+	pObjectData->bMetadataGood = true;
+}
+
+/// Find the sidecar entry for an object, if it can be used in place of the object file.
+///
+/// @param[in] objectIndex    Index of the object.
+/// @param[in] fileSize       Current size of the object file.
+/// @param[in] fileTimeStamp  Current modification time of the object file.
+/// @param[in] pTemplate      Template the object is being loaded on top of.
+/// @param[in] pType          Type of the object.
+///
+/// @return  Sidecar entry for the object, or null if there is no entry, the entry was built from different object
+///          file contents, templates or type layout, or the entry has yet to be filled in.
+const LoosePackageLoader::SidecarEntry* LoosePackageLoader::FindSidecarEntry(
+	size_t objectIndex,
+	int64_t fileSize,
+	int64_t fileTimeStamp,
+	Asset* pTemplate,
+	AssetType* pType ) const
+{
+	HELIUM_ASSERT( objectIndex < m_objects.GetSize() );
+
+	HashMap< Name, SidecarEntry >::ConstIterator sidecarIterator =
+		m_sidecarEntries.Find( m_objects[ objectIndex ].objectPath.GetName() );
+	if( sidecarIterator == m_sidecarEntries.End() )
+	{
+		return NULL;
+	}
+
+	const SidecarEntry& rEntry = sidecarIterator->Second();
+	if( rEntry.objectData.GetSize() == 0 ||
+		rEntry.fileSize != fileSize ||
+		rEntry.fileTimeStamp != fileTimeStamp ||
+		rEntry.templateStamp != GetTemplateStamp( pTemplate ) ||
+		rEntry.typeStamp != GetTypeStamp( pType->GetMetaClass() ) )
+	{
+		return NULL;
+	}
+
+	return &rEntry;
+}
+
+/// Prepare the sidecar entry for an object being loaded from its object file.
+///
+/// The entry is kept, with its binary form cleared so that UpdateSidecarEntry() rebuilds it, only if it describes the
+/// same object file contents being loaded.  Otherwise, the metadata in the entry can't be trusted, so it is removed.
+///
+/// @param[in] objectIndex    Index of the object.
+/// @param[in] fileSize       Size of the object file contents.
+/// @param[in] fileTimeStamp  Modification time of the object file.
+/// @param[in] pData          Object file contents.
+void LoosePackageLoader::ResetSidecarEntry(
+	size_t objectIndex,
+	int64_t fileSize,
+	int64_t fileTimeStamp,
+	const void* pData )
+{
+	HELIUM_ASSERT( objectIndex < m_objects.GetSize() );
+	HELIUM_ASSERT( pData );
+
+	Name name = m_objects[ objectIndex ].objectPath.GetName();
+
+	HashMap< Name, SidecarEntry >::Iterator sidecarIterator = m_sidecarEntries.Find( name );
+	if( sidecarIterator == m_sidecarEntries.End() )
+	{
+		return;
+	}
+
+	SidecarEntry& rEntry = sidecarIterator->Second();
+	if( rEntry.fileSize == fileSize && rEntry.fileTimeStamp == fileTimeStamp )
+	{
+		Fnv1aHasher hasher;
+		hasher.Add( pData, static_cast< size_t >( fileSize ) );
+		if( rEntry.fileHash == hasher.GetHash() )
+		{
+			rEntry.objectData.Resize( 0 );
+
+			return;
+		}
+	}
+
+	m_sidecarEntries.Remove( name );
+	m_bSidecarDirty = true;
+}
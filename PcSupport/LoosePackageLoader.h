@@ -2,9 +2,11 @@
 
 #include "Engine/Engine.h"
 #include "Engine/Asset.h"
+#include "Engine/AssetLoader.h"
 #include "Engine/PackageLoader.h"
 
 #include "Foundation/FilePath.h"
+#include "Foundation/HashMap.h"
 
 namespace Helium
 {
@@ -81,6 +83,15 @@ namespace Helium
 		virtual bool SaveAsset( Asset *pAsset ) const;
 #endif
 
+		/// @name Sidecar Support
+		//@{
+		void UpdateSidecarEntry( const AssetPath &path, Asset *pObject );
+		bool SaveSidecar();
+		bool HasSidecarObjectData( Name objectName ) const;
+
+		static uint64_t GetTypeStamp( const Reflect::MetaStruct* pStruct );
+		//@}
+
 	private:
 		/// Load request flags.
 		enum ELoadFlag
@@ -130,6 +141,16 @@ namespace Helium
 			void* pAsyncFileLoadBuffer;
 			size_t asyncFileLoadBufferSize;
 
+			/// Async loader work ID for deserializing the object file.
+			size_t deserializeWorkId;
+			/// References found while deserializing the object file.
+			DeferredAssetResolver deferredResolver;
+			/// True if the object file load buffer holds the binary form of the object from the package sidecar
+			/// instead of the contents of the object file.
+			bool bSidecarObjectData;
+			/// Modification time of the object file when its size was checked.
+			int64_t objectFileTimeStamp;
+
 			/// Load flags.
 			uint32_t flags;
 
@@ -175,6 +196,34 @@ namespace Helium
 		/// Parent package load request ID.
 		size_t m_parentPackageLoadId;
 
+		/// Pre-parsed object stored in the package sidecar file.
+		struct SidecarEntry
+		{
+			/// Size of the object file the entry was built from.
+			int64_t fileSize;
+			/// Modification time of the object file the entry was built from.
+			int64_t fileTimeStamp;
+			/// Hash of the contents of the object file the entry was built from.
+			uint64_t fileHash;
+			/// Type name.
+			Name typeName;
+			/// Template path.
+			AssetPath templatePath;
+			/// Stamp of the non-default templates the object data was built on top of.
+			uint64_t templateStamp;
+			/// Stamp of the reflected layout of the object type when the object data was built.
+			uint64_t typeStamp;
+			/// Object data in binary form (empty until the object has been loaded from its object file).
+			DynamicArray< uint8_t > objectData;
+		};
+
+		/// Sidecar file name.
+		String m_sidecarFileName;
+		/// Sidecar entries, by object name.
+		HashMap< Name, SidecarEntry > m_sidecarEntries;
+		/// True if the sidecar entries have changed since the sidecar file was loaded or saved.
+		bool m_bSidecarDirty;
+
 		/// Mutex for synchronizing access between threads.
 		mutable Mutex m_accessLock;
 
@@ -184,7 +233,16 @@ namespace Helium
 
 		void TickLoadRequests();
 		bool TickDeserialize( LoadRequest* pRequest );
+		bool FinishDeserialize( LoadRequest* pRequest, bool bObjectCreationFailure );
 		bool TickPersistentResourcePreload( LoadRequest* pRequest );
+
+		static void DeserializeObjectFile( void* pData );
+
+		void LoadSidecar();
+		void AddSidecarObject( Name name, const SidecarEntry& rEntry, const FilePath& rFilePath );
+		const SidecarEntry* FindSidecarEntry(
+			size_t objectIndex, int64_t fileSize, int64_t fileTimeStamp, Asset* pTemplate, AssetType* pType ) const;
+		void ResetSidecarEntry( size_t objectIndex, int64_t fileSize, int64_t fileTimeStamp, const void* pData );
 		//@}
 
 		size_t FindObjectByPath( const AssetPath &path ) const;
@@ -20,20 +20,21 @@ PlatformPreprocessor::~PlatformPreprocessor()
 ///
 /// @see CompileShader()
 
-/// @fn bool PlatformPreprocessor::CompileShader( size_t profileIndex, RShader::EType type, const void* pShaderCode, size_t shaderCodeSize, const ShaderToken* pTokens, size_t tokenCount, DynamicArray< uint8_t >& rMicrocode, DynamicArray< String >* pErrorMessages )
+/// @fn bool PlatformPreprocessor::CompileShader( size_t profileIndex, RShader::EType type, const void* pShaderCode, size_t shaderCodeSize, const ShaderToken* pTokens, size_t tokenCount, DynamicArray< uint8_t >& rMicrocode, DynamicArray< String >* pErrorMessages, DynamicArray< String >* pIncludeFileNames )
 /// Compile a shader for the target platform.
 ///
-/// @param[in]  rShaderPath     FilePath to the shader file being compiled.
-/// @param[in]  profileIndex    Index of the target shader profile (must be a value less than that returned by
-///                             GetShaderProfileCount()).
-/// @param[in]  type            Shader type.
-/// @param[in]  pShaderCode     Pointer to the loaded shader code to compile.
-/// @param[in]  shaderCodeSize  Size of the shader code, in bytes.
-/// @param[in]  pTokens         Array of shader preprocessor tokens.
-/// @param[in]  tokenCount      Number of shader preprocessor tokens in the given array.
-/// @param[out] rCompiledCode   Buffer in which the compiled shader code will be stored.
-/// @param[out] pErrorMessages  Optional array in which to store error messages generated during the shader
-///                             compilation process.
+/// @param[in]  rShaderPath        FilePath to the shader file being compiled.
+/// @param[in]  profileIndex       Index of the target shader profile (must be a value less than that returned by
+///                                GetShaderProfileCount()).
+/// @param[in]  type               Shader type.
+/// @param[in]  pShaderCode        Pointer to the loaded shader code to compile.
+/// @param[in]  shaderCodeSize     Size of the shader code, in bytes.
+/// @param[in]  pTokens            Array of shader preprocessor tokens.
+/// @param[in]  tokenCount         Number of shader preprocessor tokens in the given array.
+/// @param[out] rCompiledCode      Buffer in which the compiled shader code will be stored.
+/// @param[out] pErrorMessages     Optional array in which to store error messages generated during the shader
+///                                compilation process.
+/// @param[out] pIncludeFileNames  Optional array in which to store the names of the files included by the shader.
 ///
 /// @return  True if the shader was compiled successfully, false if not.
 ///
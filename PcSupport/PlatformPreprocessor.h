@@ -63,7 +63,7 @@ namespace Helium
         virtual bool CompileShader(
             const FilePath& rShaderPath, size_t profileIndex, RShader::EType type, const void* pShaderCode,
             size_t shaderCodeSize, const ShaderToken* pTokens, size_t tokenCount, DynamicArray< uint8_t >& rCompiledCode,
-            DynamicArray< String >* pErrorMessages ) = 0;
+            DynamicArray< String >* pErrorMessages, DynamicArray< String >* pIncludeFileNames ) = 0;
         virtual bool FillShaderReflectionData(
             size_t profileIndex, const void* pCompiledCode, size_t compiledCodeSize,
             DynamicArray< ShaderConstantBufferInfo >& rConstantBuffers, DynamicArray< ShaderSamplerInfo >& rSamplers,
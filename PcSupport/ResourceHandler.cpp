@@ -34,6 +34,48 @@ void ResourceHandler::GetSourceExtensions( const char* const*& rppExtensions, si
 }
 
 #if HELIUM_TOOLS
+/// Get the version of this handler's output, for recording with the inputs each resource was cooked from.
+///
+/// Resources are recooked when the version recorded with their cook record differs from the current one, so the
+/// version must be changed whenever the handler changes its output.  Unlike GetDerivedDataVersion(), every handler
+/// has a valid cook version, whether or not its output can be reused from the derived data cache.
+///
+/// @return  Cook version.
+///
+/// @see AssetPreprocessor::SetCookRecordTable()
+uint32_t ResourceHandler::GetCookVersion() const
+{
+    return 0;
+}
+
+/// Get the version of the preprocessed data produced by this handler for use in derived data cache keys.
+///
+/// Handlers whose output depends only on the source file contents and the resource settings can return a valid
+/// version to have their output reused from the derived data cache.  The version must be changed whenever the
+/// handler changes its output, which invalidates all previously cached data.  Handlers whose output depends on other
+/// assets or files keep the default invalid version, which disables caching.
+///
+/// @return  Derived data version, or an invalid value if the output of this handler should not be cached.
+uint32_t ResourceHandler::GetDerivedDataVersion() const
+{
+    return Invalid< uint32_t >();
+}
+
+/// Get whether CacheResource() can be called for different resources on several threads at once.
+///
+/// Handlers that only read their source file and resource settings, and synchronize access to any state shared
+/// between calls, can return true to have their resources preprocessed on worker threads while deferred
+/// preprocessing is enabled.  Handlers that load other assets must keep the default, as asset loading is only
+/// supported on the main thread.
+///
+/// @return  True if resources can be preprocessed concurrently, false if they must be preprocessed on the main thread.
+///
+/// @see AssetPreprocessor::BeginDeferredPreprocessing()
+bool ResourceHandler::CanCacheConcurrently() const
+{
+    return false;
+}
+
 /// Preprocess and cache the resource data for the given resource for all enabled target platforms.
 ///
 /// @param[in] pAssetPreprocessor  Asset preprocessor instance.
@@ -32,6 +32,10 @@ namespace Helium
         virtual void GetSourceExtensions( const char* const*& rppExtensions, size_t& rExtensionCount ) const;
 
 #if HELIUM_TOOLS
+        virtual uint32_t GetCookVersion() const;
+        virtual uint32_t GetDerivedDataVersion() const;
+        virtual bool CanCacheConcurrently() const;
+
         virtual bool CacheResource(
             AssetPreprocessor* pAssetPreprocessor, Resource* pResource, const String& rSourceFilePath );
         
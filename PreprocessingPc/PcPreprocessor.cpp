@@ -31,7 +31,7 @@ class D3DIncludeHandler : public ID3D10Include
 public:
     /// @name Construction/Destruction
     //@{
-    explicit D3DIncludeHandler( const FilePath& rShaderPath );
+    D3DIncludeHandler( const FilePath& rShaderPath, DynamicArray< String >* pIncludeFileNames );
     virtual ~D3DIncludeHandler();
     //@}
 
@@ -44,12 +44,16 @@ public:
 private:
     /// Directory containing the shader file being processed.
     FilePath m_shaderDirectory;
+    /// Array in which to store the names of included files (null if not needed).
+    DynamicArray< String >* m_pIncludeFileNames;
 };
 
 /// Constructor.
 ///
-/// @param[in] rShaderPath  FilePath to the shader file being processed.
-D3DIncludeHandler::D3DIncludeHandler( const FilePath& rShaderPath )
+/// @param[in] rShaderPath        FilePath to the shader file being processed.
+/// @param[in] pIncludeFileNames  Optional array in which to store the names of the files opened for inclusion.
+D3DIncludeHandler::D3DIncludeHandler( const FilePath& rShaderPath, DynamicArray< String >* pIncludeFileNames )
+    : m_pIncludeFileNames( pIncludeFileNames )
 {
     m_shaderDirectory.Set( rShaderPath.Directory() );
 }
@@ -148,6 +152,11 @@ HRESULT D3DIncludeHandler::Open(
 
     delete pIncludeFileStream;
 
+    if( m_pIncludeFileNames )
+    {
+        m_pIncludeFileNames->Push( String( includePath.c_str() ) );
+    }
+
     *ppData = pBuffer;
     *pBytes = fileSize;
 
@@ -204,7 +213,8 @@ bool PcPreprocessor::CompileShader(
 								   const ShaderToken* pTokens,
 								   size_t tokenCount,
 								   DynamicArray< uint8_t >& rCompiledCode,
-								   DynamicArray< String >* pErrorMessages )
+								   DynamicArray< String >* pErrorMessages,
+								   DynamicArray< String >* pIncludeFileNames )
 {
 	HELIUM_ASSERT( profileIndex < static_cast< size_t >( ShaderProfile::PC_MAX ) );
 	HELIUM_ASSERT( static_cast< size_t >( type ) < static_cast< size_t >( RShader::TYPE_MAX ) );
@@ -217,6 +227,11 @@ bool PcPreprocessor::CompileShader(
 		pErrorMessages->Resize( 0 );
 	}
 
+	if( pIncludeFileNames )
+	{
+		pIncludeFileNames->Resize( 0 );
+	}
+
 #if HELIUM_DIRECT3D
 
 	DynamicArray< D3D10_SHADER_MACRO > defines;
@@ -333,7 +348,7 @@ bool PcPreprocessor::CompileShader(
 	macro.Definition = NULL;
 	defines.Push( macro );
 
-	D3DIncludeHandler includeHandler( rShaderPath );
+	D3DIncludeHandler includeHandler( rShaderPath, pIncludeFileNames );
 	ID3D10Blob* pCompiledCodeBlob = NULL;
 	ID3D10Blob* pErrorMessageBlob = NULL;
 	// XXX TMC: Always use row-major packing, since that's the only option with Cg.
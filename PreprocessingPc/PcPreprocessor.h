@@ -26,7 +26,7 @@ namespace Helium
         virtual bool CompileShader(
             const FilePath& rShaderPath, size_t profileIndex, RShader::EType type, const void* pShaderCode,
             size_t shaderCodeSize, const ShaderToken* pTokens, size_t tokenCount, DynamicArray< uint8_t >& rCompiledCode,
-            DynamicArray< String >* pErrorMessages );
+            DynamicArray< String >* pErrorMessages, DynamicArray< String >* pIncludeFileNames );
         virtual bool FillShaderReflectionData(
             size_t profileIndex, const void* pCompiledCode, size_t compiledCodeSize,
             DynamicArray< ShaderConstantBufferInfo >& rConstantBuffers, DynamicArray< ShaderSamplerInfo >& rSamplers,
@@ -12,6 +12,25 @@ project( prefix .. "Engine" )
 		"Engine/*",
 	}
 
+	includedirs
+	{
+		"Dependencies/zlib",
+	}
+
+	configuration "windows"
+		excludes
+		{
+			"Engine/*Lin.*",
+		}
+
+	configuration "macosx"
+		excludes
+		{
+			"Engine/*Lin.*",
+		}
+
+	configuration {}
+
 	configuration "SharedLib"
 		links
 		{
@@ -22,6 +41,8 @@ project( prefix .. "Engine" )
 			prefix .. "Persist",
 			prefix .. "Math",
 			prefix .. "MathSimd",
+
+			"zlib",
 		}
 
 project( prefix .. "EngineJobs" )
@@ -584,6 +605,7 @@ project( prefix .. "TestApp" )
 		"bullet",
 		"mongo-c",
 		"ois",
+		"zlib",
 	}
 
 	configuration { "linux", "SharedLib or *App" }
@@ -864,6 +886,7 @@ project( prefix .. "EmptyMain" )
 		"bullet",
 		"mongo-c",
 		"ois",
+		"zlib",
 	}
 
 	configuration { "linux", "SharedLib or *App" }
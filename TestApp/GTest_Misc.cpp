@@ -368,4 +368,2083 @@ TEST(Engine, PackageObjectTest)
     }
 }
 
-#endif
\ No newline at end of file
+/// Repeatedly looks up a set of interned asset paths, interning a few new paths of its own along the way.
+class AssetPathLookupRunnable : public Runnable
+{
+public:
+    AssetPathLookupRunnable(
+        const DynamicArray< String >& rPathStrings, const DynamicArray< AssetPath >& rPaths, uint32_t threadIndex,
+        size_t lookupCount )
+        : m_rPathStrings( rPathStrings )
+        , m_rPaths( rPaths )
+        , m_threadIndex( threadIndex )
+        , m_lookupCount( lookupCount )
+        , m_mismatchCount( 0 )
+    {
+    }
+
+    virtual void Run()
+    {
+        size_t pathCount = m_rPaths.GetSize();
+        char newPathString[ 64 ];
+
+        for( size_t lookupIndex = 0; lookupIndex < m_lookupCount; ++lookupIndex )
+        {
+            size_t pathIndex = ( lookupIndex * 7 + m_threadIndex ) % pathCount;
+
+            AssetPath path;
+            if( !path.Set( m_rPathStrings[ pathIndex ] ) || path != m_rPaths[ pathIndex ] )
+            {
+                ++m_mismatchCount;
+            }
+
+            // Occasionally add a path nobody else has seen to exercise insertion and table growth alongside lookups.
+            if( lookupIndex % 64 == 0 )
+            {
+                StringPrint(
+                    newPathString,
+                    TXT( "/Benchmark/Thread%" ) PRIu32 TXT( ":Object%" ) PRIuSZ,
+                    m_threadIndex,
+                    lookupIndex );
+                newPathString[ HELIUM_ARRAY_COUNT( newPathString ) - 1 ] = TXT( '\0' );
+
+                AssetPath newPath;
+                AssetPath repeatPath;
+                if( !newPath.Set( newPathString ) || !repeatPath.Set( newPathString ) || newPath != repeatPath )
+                {
+                    ++m_mismatchCount;
+                }
+            }
+        }
+    }
+
+    size_t GetMismatchCount() const
+    {
+        return m_mismatchCount;
+    }
+
+private:
+    const DynamicArray< String >& m_rPathStrings;
+    const DynamicArray< AssetPath >& m_rPaths;
+    uint32_t m_threadIndex;
+    size_t m_lookupCount;
+    size_t m_mismatchCount;
+};
+
+TEST(Engine, AssetPathConcurrentLookup)
+{
+    const size_t pathCount = 4096;
+    const size_t threadCount = 4;
+    const size_t lookupCount = 200000;
+
+    DynamicArray< String > pathStrings;
+    DynamicArray< AssetPath > paths;
+    pathStrings.Reserve( pathCount );
+    paths.Reserve( pathCount );
+
+    String pathString;
+    for( size_t pathIndex = 0; pathIndex < pathCount; ++pathIndex )
+    {
+        pathString.Format(
+            TXT( "/Benchmark/Package%" ) PRIuSZ TXT( ":Object%" ) PRIuSZ,
+            pathIndex % 32,
+            pathIndex );
+        pathStrings.Push( pathString );
+
+        AssetPath path;
+        HELIUM_VERIFY( path.Set( pathString ) );
+        paths.Push( path );
+    }
+
+    AssetPathLookupRunnable* runnables[ threadCount ];
+    RunnableThread* threads[ threadCount ];
+    for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+    {
+        runnables[ threadIndex ] = new AssetPathLookupRunnable(
+            pathStrings, paths, static_cast< uint32_t >( threadIndex ), lookupCount );
+        threads[ threadIndex ] = new RunnableThread( runnables[ threadIndex ] );
+    }
+
+    uint64_t startTickCount = Timer::GetTickCount();
+
+    for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+    {
+        HELIUM_VERIFY( threads[ threadIndex ]->Start( TXT( "AssetPath Lookup" ) ) );
+    }
+
+    for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+    {
+        HELIUM_VERIFY( threads[ threadIndex ]->Join() );
+    }
+
+    uint64_t elapsedTicks = Timer::GetTickCount() - startTickCount;
+
+    size_t mismatchCount = 0;
+    for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+    {
+        mismatchCount += runnables[ threadIndex ]->GetMismatchCount();
+
+        delete threads[ threadIndex ];
+        delete runnables[ threadIndex ];
+    }
+
+    float64_t seconds = static_cast< float64_t >( elapsedTicks ) * Timer::GetSecondsPerTick();
+    HELIUM_TRACE(
+        TraceLevels::Info,
+        TXT( "AssetPath lookups: %" ) PRIuSZ TXT( " threads, %" ) PRIuSZ TXT( " lookups in %.3f s (%.0f lookups/s)\n" ),
+        threadCount,
+        threadCount * lookupCount,
+        seconds,
+        ( seconds > 0.0 ? static_cast< float64_t >( threadCount * lookupCount ) / seconds : 0.0 ) );
+
+    EXPECT_EQ( static_cast< size_t >( 0 ), mismatchCount );
+}
+
+/// Registers assets under a shared package while looking up both its own assets and those of the other threads.
+class AssetRegistryRunnable : public Runnable
+{
+public:
+    AssetRegistryRunnable( Package* pOwner, uint32_t threadIndex, uint32_t threadCount, size_t assetCount )
+        : m_pOwner( pOwner )
+        , m_threadIndex( threadIndex )
+        , m_threadCount( threadCount )
+        , m_assetCount( assetCount )
+        , m_mismatchCount( 0 )
+    {
+    }
+
+    virtual void Run()
+    {
+        m_assets.Reserve( m_assetCount );
+
+        for( size_t assetIndex = 0; assetIndex < m_assetCount; ++assetIndex )
+        {
+            PackagePtr spAsset;
+            if( !Asset::Create< Package >( spAsset, GetAssetName( m_threadIndex, assetIndex ), m_pOwner ) )
+            {
+                ++m_mismatchCount;
+                continue;
+            }
+
+            m_assets.Push( spAsset );
+
+            if( Asset::FindObject( spAsset->GetPath() ) != spAsset.Get() )
+            {
+                ++m_mismatchCount;
+            }
+
+            // Look up an asset another thread may or may not have registered yet; if found, it must be the right one.
+            uint32_t otherThreadIndex = ( m_threadIndex + 1 ) % m_threadCount;
+            AssetPath otherPath;
+            otherPath.Set( GetAssetName( otherThreadIndex, assetIndex ), true, m_pOwner->GetPath() );
+
+            Asset* pOtherAsset = Asset::FindObject( otherPath );
+            if( pOtherAsset && pOtherAsset->GetPath() != otherPath )
+            {
+                ++m_mismatchCount;
+            }
+        }
+    }
+
+    static Name GetAssetName( uint32_t threadIndex, size_t assetIndex )
+    {
+        char nameString[ 64 ];
+        StringPrint(
+            nameString,
+            TXT( "Thread%" ) PRIu32 TXT( "Object%" ) PRIuSZ,
+            threadIndex,
+            assetIndex );
+        nameString[ HELIUM_ARRAY_COUNT( nameString ) - 1 ] = TXT( '\0' );
+
+        return Name( nameString );
+    }
+
+    const DynamicArray< PackagePtr >& GetAssets() const
+    {
+        return m_assets;
+    }
+
+    size_t GetMismatchCount() const
+    {
+        return m_mismatchCount;
+    }
+
+private:
+    Package* m_pOwner;
+    uint32_t m_threadIndex;
+    uint32_t m_threadCount;
+    size_t m_assetCount;
+    DynamicArray< PackagePtr > m_assets;
+    size_t m_mismatchCount;
+};
+
+TEST(Engine, AssetRegistryConcurrentRegisterAndFind)
+{
+    const size_t threadCount = 4;
+    const size_t assetCount = 512;
+
+    PackagePtr spPackage;
+    HELIUM_VERIFY( Asset::Create< Package >( spPackage, Name( TXT( "RegistryTest" ) ), NULL ) );
+    HELIUM_ASSERT( spPackage );
+
+    AssetRegistryRunnable* runnables[ threadCount ];
+    RunnableThread* threads[ threadCount ];
+    for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+    {
+        runnables[ threadIndex ] = new AssetRegistryRunnable(
+            spPackage, static_cast< uint32_t >( threadIndex ), static_cast< uint32_t >( threadCount ), assetCount );
+        threads[ threadIndex ] = new RunnableThread( runnables[ threadIndex ] );
+    }
+
+    for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+    {
+        HELIUM_VERIFY( threads[ threadIndex ]->Start( TXT( "Asset Registry" ) ) );
+    }
+
+    for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+    {
+        HELIUM_VERIFY( threads[ threadIndex ]->Join() );
+    }
+
+    // Once every thread is done, every asset must be registered and findable by path.
+    size_t mismatchCount = 0;
+    for( size_t threadIndex = 0; threadIndex < threadCount; ++threadIndex )
+    {
+        mismatchCount += runnables[ threadIndex ]->GetMismatchCount();
+
+        const DynamicArray< PackagePtr >& rAssets = runnables[ threadIndex ]->GetAssets();
+        EXPECT_EQ( assetCount, rAssets.GetSize() );
+
+        for( size_t assetIndex = 0; assetIndex < rAssets.GetSize(); ++assetIndex )
+        {
+            Package* pAsset = rAssets[ assetIndex ];
+            EXPECT_EQ( static_cast< Asset* >( pAsset ), Asset::FindObject( pAsset->GetPath() ) );
+        }
+
+        delete threads[ threadIndex ];
+        delete runnables[ threadIndex ];
+    }
+
+    EXPECT_EQ( static_cast< size_t >( 0 ), mismatchCount );
+}
+
+// Walks a fake population one item at a time using the same cursor protocol as QueryComponentsTimeSliced
+static const size_t TIME_SLICE_TEST_ITEM_COUNT = 4096;
+static const uint32_t TIME_SLICE_TEST_BUDGET_MICROSECONDS = 500;
+static uint32_t g_TimeSliceTestVisits[ TIME_SLICE_TEST_ITEM_COUNT ];
+
+static void SpinMicroseconds( uint32_t microseconds )
+{
+    uint64_t endTickCount = Timer::GetTickCount() + ( microseconds * Timer::GetTicksPerSecond() ) / 1000000;
+    while( Timer::GetTickCount() < endTickCount )
+    {
+    }
+}
+
+static void TimeSliceTestFunc( DynamicArray< WorldPtr >& /*rWorlds*/ )
+{
+    TaskTimeSlice& rSlice = TaskScheduler::GetCurrentTimeSlice();
+
+    while( !rSlice.IsExpired() )
+    {
+        ++g_TimeSliceTestVisits[ rSlice.m_CursorComponentIndex ];
+        SpinMicroseconds( 2 );
+
+        if( ++rSlice.m_CursorComponentIndex >= TIME_SLICE_TEST_ITEM_COUNT )
+        {
+            rSlice.ResetCursor();
+            ++rSlice.m_CompletedPasses;
+            return;
+        }
+    }
+}
+
+// Never picked up by CalculateSchedule; the test builds its schedule by hand
+struct TimeSliceTestTask : public TaskDefinition
+{
+    HELIUM_DECLARE_TASK( TimeSliceTestTask );
+    virtual void DefineContract( TaskContract& /*rContract*/ )
+    {
+    }
+};
+
+HELIUM_DEFINE_TIME_SLICED_TASK( TimeSliceTestTask, TimeSliceTestFunc, TickTypes::Never, TIME_SLICE_TEST_BUDGET_MICROSECONDS )
+
+TEST(Framework, TimeSlicedTaskBudgetAndResume)
+{
+    MemoryZero( g_TimeSliceTestVisits, sizeof( g_TimeSliceTestVisits ) );
+
+    const TaskDefinition& rTask = TimeSliceTestTask::m_This;
+    TaskTimeSlice& rSlice = rTask.m_TimeSlice;
+    rSlice = TaskTimeSlice();
+
+    TaskSchedule schedule;
+    schedule.m_ScheduleInfo.Push( &rTask );
+    schedule.m_ScheduleFunc.Push( rTask.m_Func );
+
+    DynamicArray< WorldPtr > worlds;
+
+    const uint32_t savedFrameBudget = TaskScheduler::GetFrameBudget();
+    TaskScheduler::SetFrameBudget( 0 );
+
+    // One frame must stop partway through the population once the nominal budget is spent
+    TaskScheduler::ExecuteSchedule( schedule, worlds );
+    EXPECT_EQ( TIME_SLICE_TEST_BUDGET_MICROSECONDS, rSlice.m_GrantedMicroseconds );
+    EXPECT_GE( rSlice.m_UsedMicroseconds, rSlice.m_GrantedMicroseconds );
+    EXPECT_EQ( 0U, rSlice.m_CompletedPasses );
+    EXPECT_GT( rSlice.m_CursorComponentIndex, static_cast< size_t >( 0 ) );
+    EXPECT_LT( rSlice.m_CursorComponentIndex, TIME_SLICE_TEST_ITEM_COUNT );
+
+    // Later frames resume from the cursor, so a full pass visits every item exactly once
+    size_t frameCount = 1;
+    while( rSlice.m_CompletedPasses == 0 && frameCount < 10000 )
+    {
+        TaskScheduler::ExecuteSchedule( schedule, worlds );
+        ++frameCount;
+    }
+
+    EXPECT_EQ( 1U, rSlice.m_CompletedPasses );
+    EXPECT_GT( frameCount, static_cast< size_t >( 1 ) );
+    EXPECT_EQ( static_cast< size_t >( 0 ), rSlice.m_CursorComponentIndex );
+
+    size_t badVisitCount = 0;
+    for( size_t itemIndex = 0; itemIndex < TIME_SLICE_TEST_ITEM_COUNT; ++itemIndex )
+    {
+        if( g_TimeSliceTestVisits[ itemIndex ] != 1 )
+        {
+            ++badVisitCount;
+        }
+    }
+
+    EXPECT_EQ( static_cast< size_t >( 0 ), badVisitCount );
+
+    // A frame budget that is already blown squeezes the task down to its minimum grant, but it still runs
+    TaskScheduler::SetFrameBudget( 1 );
+    const size_t cursorBefore = rSlice.m_CursorComponentIndex;
+    TaskScheduler::ExecuteSchedule( schedule, worlds );
+    EXPECT_LT( rSlice.m_GrantedMicroseconds, TIME_SLICE_TEST_BUDGET_MICROSECONDS );
+    EXPECT_GT( rSlice.m_GrantedMicroseconds, 0U );
+    EXPECT_GT( rSlice.m_CursorComponentIndex, cursorBefore );
+
+    TaskScheduler::SetFrameBudget( savedFrameBudget );
+}
+
+TEST(Components, SimulationLodBucketsAndTimeStep)
+{
+    SimulationLodComponent lod;
+    lod.m_FullRateDistanceSquared = 10.0f * 10.0f;
+    lod.m_MaxBucket = SimulationLodBuckets::Every8thFrame;
+
+    // Every bucket doubles the distance covered by the previous one, up to the maximum
+    EXPECT_EQ( SimulationLodBuckets::EveryFrame, lod.CalculateBucket( 0.0f ) );
+    EXPECT_EQ( SimulationLodBuckets::EveryFrame, lod.CalculateBucket( 10.0f * 10.0f ) );
+    EXPECT_EQ( SimulationLodBuckets::Every2ndFrame, lod.CalculateBucket( 15.0f * 15.0f ) );
+    EXPECT_EQ( SimulationLodBuckets::Every4thFrame, lod.CalculateBucket( 35.0f * 35.0f ) );
+    EXPECT_EQ( SimulationLodBuckets::Every8thFrame, lod.CalculateBucket( 1000.0f * 1000.0f ) );
+
+    // Drive a distant entity for a while and check it is updated every 8th frame with 8 frames worth of time
+    const uint64_t ticksPerFrame = Timer::GetTicksPerSecond() / 60;
+    const float32_t distanceSquared = 1000.0f * 1000.0f;
+
+    lod.m_LastUpdateTickCount = 0;
+    lod.m_DeltaSeconds = 0.0f;
+    lod.m_Bucket = SimulationLodBuckets::Every8thFrame;
+    lod.m_Phase = 3;
+    lod.m_bDue = false;
+
+    uint32_t dueCount = 0;
+    float32_t totalSeconds = 0.0f;
+    for( uint32_t frameIndex = 1; frameIndex <= 64; ++frameIndex )
+    {
+        lod.Advance( frameIndex, frameIndex * ticksPerFrame, distanceSquared );
+        if( lod.IsDue() )
+        {
+            EXPECT_EQ( 0U, ( frameIndex + lod.m_Phase ) % 8 );
+            ++dueCount;
+            totalSeconds += lod.GetDeltaSeconds();
+        }
+    }
+
+    EXPECT_EQ( 8U, dueCount );
+
+    // The time steps handed out add up to the time since the first update, so nothing is lost to skipped frames
+    const float32_t elapsedSeconds = static_cast< float32_t >(
+        static_cast< float64_t >( lod.m_LastUpdateTickCount ) * Timer::GetSecondsPerTick() );
+    EXPECT_NEAR( elapsedSeconds, totalSeconds, 0.001f );
+
+    // Coming close drops the entity back to full rate on its next due frame
+    uint32_t frameIndex = 65;
+    for( ; frameIndex < 65 + 8; ++frameIndex )
+    {
+        lod.Advance( frameIndex, frameIndex * ticksPerFrame, 0.0f );
+        if( lod.IsDue() )
+        {
+            break;
+        }
+    }
+
+    EXPECT_EQ( SimulationLodBuckets::EveryFrame, lod.GetBucket() );
+    lod.Advance( frameIndex + 1, ( frameIndex + 1 ) * ticksPerFrame, 0.0f );
+    EXPECT_TRUE( lod.IsDue() );
+}
+
+TEST(Framework, CloneWorldRebuildsPhysics)
+{
+    PackagePtr spPackage;
+    HELIUM_VERIFY( Asset::Create< Package >( spPackage, Name( TXT( "CloneWorldTest" ) ), NULL ) );
+
+    StrongPtr< BulletWorldComponentDefinition > spWorldDefinition;
+    HELIUM_VERIFY( Asset::Create< BulletWorldComponentDefinition >( spWorldDefinition, Name( TXT( "PhysicsWorld" ) ), spPackage ) );
+    spWorldDefinition->m_WorldDefinition.m_Gravity = Simd::Vector3::Zero;
+
+    StrongPtr< BulletShapeSphere > spSphere( new BulletShapeSphere() );
+    spSphere->m_Mass = 1.0f;
+
+    StrongPtr< BulletBodyComponentDefinition > spBodyDefinition;
+    HELIUM_VERIFY( Asset::Create< BulletBodyComponentDefinition >( spBodyDefinition, Name( TXT( "Body" ) ), spPackage ) );
+    spBodyDefinition->m_BodyDefinition.m_Shapes.Push( spSphere );
+
+    EntityDefinitionPtr spEntityDefinition;
+    HELIUM_VERIFY( Asset::Create< EntityDefinition >( spEntityDefinition, Name( TXT( "Entity" ) ), spPackage ) );
+
+    // Source world with a physics world and a single moving body that tracks contacts
+    WorldPtr spSource( new World() );
+    ASSERT_TRUE( spSource->Initialize() );
+
+    spWorldDefinition->CreateComponent( *spSource );
+    spWorldDefinition->FinalizeComponent();
+
+    Entity *pSourceEntity = spSource->GetRootSlice()->CreateEntity( spEntityDefinition );
+    ASSERT_TRUE( pSourceEntity != NULL );
+    pSourceEntity->Allocate< TransformComponent >()->SetPosition( Simd::Vector3( 5.0f, 0.0f, 0.0f ) );
+
+    spBodyDefinition->CreateComponent( *pSourceEntity );
+    spBodyDefinition->FinalizeComponent();
+
+    BulletBodyComponent *pSourceBody = pSourceEntity->GetComponents().GetFirst< BulletBodyComponent >();
+    ASSERT_TRUE( pSourceBody != NULL );
+    pSourceBody->SetVelocity( Simd::Vector3( 1.0f, 0.0f, 0.0f ) );
+    HasPhysicalContactsComponent *pSourceContacts = pSourceBody->GetOrCreateHasPhysicalContactsComponent();
+
+    WorldPtr spClone( new World() );
+    ASSERT_TRUE( spClone->InitializeAsCloneOf( *spSource ) );
+
+    // The clone gets a physics world and body of its own, carrying the source body's motion
+    BulletWorldComponent *pSourcePhysics = spSource->GetComponents().GetFirst< BulletWorldComponent >();
+    BulletWorldComponent *pClonePhysics = spClone->GetComponents().GetFirst< BulletWorldComponent >();
+    ASSERT_TRUE( pClonePhysics != NULL );
+    ASSERT_TRUE( pClonePhysics->GetBulletWorld() != NULL );
+    EXPECT_NE( pSourcePhysics->GetBulletWorld(), pClonePhysics->GetBulletWorld() );
+
+    ASSERT_EQ( 1U, spClone->GetRootSlice()->GetEntityCount() );
+    Entity *pCloneEntity = spClone->GetRootSlice()->GetEntity( 0 );
+    BulletBodyComponent *pCloneBody = pCloneEntity->GetComponents().GetFirst< BulletBodyComponent >();
+    ASSERT_TRUE( pCloneBody != NULL );
+    ASSERT_TRUE( pCloneBody->GetBody().HasBody() );
+    EXPECT_NE( pSourceBody->GetBody().GetBody(), pCloneBody->GetBody().GetBody() );
+    EXPECT_EQ( pCloneBody, pCloneBody->GetBody().GetBody()->getUserPointer() );
+    EXPECT_EQ( 1.0f, pCloneBody->GetBody().GetBody()->getLinearVelocity().x() );
+
+    // References between components were repointed at the clone
+    HasPhysicalContactsComponent *pCloneContacts = pCloneBody->GetOrCreateHasPhysicalContactsComponent();
+    EXPECT_NE( pSourceContacts, pCloneContacts );
+    EXPECT_EQ( pCloneContacts, pCloneEntity->GetComponents().GetFirst< HasPhysicalContactsComponent >() );
+
+    // Simulating the clone leaves the source alone
+    pClonePhysics->Simulate( 1.0f );
+
+    Simd::Vector3 sourcePosition;
+    Simd::Vector3 clonePosition;
+    pSourceBody->GetBody().GetPosition( sourcePosition );
+    pCloneBody->GetBody().GetPosition( clonePosition );
+    EXPECT_NEAR( 5.0f, sourcePosition.GetElement( 0 ), 0.001f );
+    EXPECT_GT( clonePosition.GetElement( 0 ), 5.5f );
+
+    spClone->Shutdown();
+    spSource->Shutdown();
+}
+
+TEST(Bullet, ProjectileSystemSpawnUpdateDespawn)
+{
+    PackagePtr spPackage;
+    HELIUM_VERIFY( Asset::Create< Package >( spPackage, Name( TXT( "ProjectileSystemTest" ) ), NULL ) );
+
+    StrongPtr< BulletWorldComponentDefinition > spWorldDefinition;
+    HELIUM_VERIFY( Asset::Create< BulletWorldComponentDefinition >( spWorldDefinition, Name( TXT( "PhysicsWorld" ) ), spPackage ) );
+    spWorldDefinition->m_WorldDefinition.m_Gravity = Simd::Vector3::Zero;
+
+    StrongPtr< BulletProjectileSystemComponentDefinition > spProjectilesDefinition;
+    HELIUM_VERIFY( Asset::Create< BulletProjectileSystemComponentDefinition >( spProjectilesDefinition, Name( TXT( "Projectiles" ) ), spPackage ) );
+    spProjectilesDefinition->m_MaxProjectiles = 3;
+
+    // A static sphere of radius 1 at x = 100 for projectiles to hit
+    StrongPtr< BulletBodyComponentDefinition > spTargetDefinition;
+    HELIUM_VERIFY( Asset::Create< BulletBodyComponentDefinition >( spTargetDefinition, Name( TXT( "Target" ) ), spPackage ) );
+    spTargetDefinition->m_BodyDefinition.m_Shapes.Push( BulletShapePtr( new BulletShapeSphere() ) );
+
+    EntityDefinitionPtr spEntityDefinition;
+    HELIUM_VERIFY( Asset::Create< EntityDefinition >( spEntityDefinition, Name( TXT( "Entity" ) ), spPackage ) );
+
+    WorldPtr spWorld( new World() );
+    ASSERT_TRUE( spWorld->Initialize() );
+
+    spWorldDefinition->CreateComponent( *spWorld );
+    spWorldDefinition->FinalizeComponent();
+    spProjectilesDefinition->CreateComponent( *spWorld );
+    spProjectilesDefinition->FinalizeComponent();
+
+    Entity *pTargetEntity = spWorld->GetRootSlice()->CreateEntity( spEntityDefinition );
+    ASSERT_TRUE( pTargetEntity != NULL );
+    pTargetEntity->Allocate< TransformComponent >()->SetPosition( Simd::Vector3( 100.0f, 0.0f, 0.0f ) );
+    spTargetDefinition->CreateComponent( *pTargetEntity );
+    spTargetDefinition->FinalizeComponent();
+    BulletBodyComponent *pTargetBody = pTargetEntity->GetComponents().GetFirst< BulletBodyComponent >();
+    ASSERT_TRUE( pTargetBody != NULL );
+
+    BulletWorld *pPhysicsWorld = spWorld->GetComponents().GetFirst< BulletWorldComponent >()->GetBulletWorld();
+    BulletProjectileSystemComponent *pProjectiles = spWorld->GetComponents().GetFirst< BulletProjectileSystemComponent >();
+    ASSERT_TRUE( pPhysicsWorld != NULL );
+    ASSERT_TRUE( pProjectiles != NULL );
+    EXPECT_EQ( 3U, pProjectiles->GetCapacity() );
+
+    // Spawn: one toward the target, one that expires early and one that flies off; a spawn past capacity or with
+    // no lifetime is refused
+    EXPECT_FALSE( pProjectiles->Spawn( Simd::Vector3::Zero, Simd::Vector3::Zero, 0.0f, 0 ) );
+    EXPECT_TRUE( pProjectiles->Spawn( Simd::Vector3( 0.0f, 0.0f, 0.0f ), Simd::Vector3( 100.0f, 0.0f, 0.0f ), 10.0f, 1 ) );
+    EXPECT_TRUE( pProjectiles->Spawn( Simd::Vector3( 0.0f, 50.0f, 0.0f ), Simd::Vector3( 0.0f, 10.0f, 0.0f ), 0.6f, 2 ) );
+    EXPECT_TRUE( pProjectiles->Spawn( Simd::Vector3( 0.0f, -50.0f, 0.0f ), Simd::Vector3( -10.0f, 0.0f, 0.0f ), 10.0f, 3 ) );
+    EXPECT_FALSE( pProjectiles->Spawn( Simd::Vector3::Zero, Simd::Vector3::Zero, 10.0f, 4 ) );
+    EXPECT_EQ( 3U, pProjectiles->GetCount() );
+
+    // Update: everything moves by velocity * dt
+    pProjectiles->Simulate( *pPhysicsWorld, 0.25f );
+    EXPECT_EQ( 3U, pProjectiles->GetCount() );
+    EXPECT_TRUE( pProjectiles->GetHits().IsEmpty() );
+    for( uint32_t index = 0; index < pProjectiles->GetCount(); ++index )
+    {
+        switch( pProjectiles->GetUserData( index ) )
+        {
+        case 1:
+            EXPECT_NEAR( 25.0f, pProjectiles->GetPosition( index ).GetElement( 0 ), 0.001f );
+            break;
+        case 2:
+            EXPECT_NEAR( 52.5f, pProjectiles->GetPosition( index ).GetElement( 1 ), 0.001f );
+            break;
+        case 3:
+            EXPECT_NEAR( -2.5f, pProjectiles->GetPosition( index ).GetElement( 0 ), 0.001f );
+            break;
+        default:
+            ADD_FAILURE();
+        }
+    }
+
+    // Despawn on expiry
+    pProjectiles->Simulate( *pPhysicsWorld, 0.25f );
+    pProjectiles->Simulate( *pPhysicsWorld, 0.25f );
+    EXPECT_EQ( 2U, pProjectiles->GetCount() );
+    EXPECT_TRUE( pProjectiles->GetHits().IsEmpty() );
+
+    // Despawn on hit, reporting the body that was hit; the segment from x = 75 to x = 100 crosses the sphere at x = 99
+    pProjectiles->Simulate( *pPhysicsWorld, 0.25f );
+    ASSERT_EQ( 1U, pProjectiles->GetHits().GetSize() );
+    EXPECT_EQ( pTargetBody, pProjectiles->GetHits()[ 0 ].m_pBody );
+    EXPECT_EQ( 1U, pProjectiles->GetHits()[ 0 ].m_UserData );
+    EXPECT_NEAR( 99.0f, pProjectiles->GetHits()[ 0 ].m_Position.GetElement( 0 ), 0.01f );
+    ASSERT_EQ( 1U, pProjectiles->GetCount() );
+    EXPECT_EQ( 3U, pProjectiles->GetUserData( 0 ) );
+
+    pProjectiles->Clear();
+    EXPECT_EQ( 0U, pProjectiles->GetCount() );
+
+    spWorld->Shutdown();
+}
+
+// Fills a cache test entry with a pattern unique to the entry and the pass that wrote it
+static void FillCacheTestEntry( uint8_t* pData, size_t size, size_t entryIndex, size_t pass )
+{
+    for( size_t byteIndex = 0; byteIndex < size; ++byteIndex )
+    {
+        pData[ byteIndex ] = static_cast< uint8_t >( entryIndex * 31 + pass * 7 + byteIndex );
+    }
+}
+
+// Reads every entry back both synchronously and through the async loader and checks it against the expected data
+static void CheckCacheTestEntries(
+    Cache& rCache, const AssetPath* pPaths, size_t entryCount, const uint8_t ( *pExpected )[ 256 ] )
+{
+    DynamicArray< uint8_t > readData;
+    uint8_t loadBuffer[ 256 ];
+
+    for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+    {
+        const Cache::Entry* pEntry = rCache.FindEntry( pPaths[ entryIndex ], 0 );
+        ASSERT_TRUE( pEntry != NULL );
+        ASSERT_EQ( static_cast< uint32_t >( sizeof( loadBuffer ) ), pEntry->size );
+
+        ASSERT_TRUE( rCache.ReadEntry( *pEntry, readData ) );
+        ASSERT_EQ( sizeof( loadBuffer ), readData.GetSize() );
+        EXPECT_EQ( 0, MemoryCompare( pExpected[ entryIndex ], readData.GetData(), sizeof( loadBuffer ) ) );
+
+        MemoryZero( loadBuffer, sizeof( loadBuffer ) );
+        size_t loadId = rCache.QueueEntryLoad( *pEntry, loadBuffer, sizeof( loadBuffer ) );
+        ASSERT_TRUE( IsValid( loadId ) );
+        EXPECT_EQ( sizeof( loadBuffer ), AsyncLoader::GetStaticInstance().SyncRequest( loadId ) );
+        EXPECT_EQ( 0, MemoryCompare( pExpected[ entryIndex ], loadBuffer, sizeof( loadBuffer ) ) );
+    }
+}
+
+TEST(Engine, CacheCompactReadBack)
+{
+    FilePath basePath;
+    HELIUM_VERIFY( FileLocations::GetUserDataDirectory( basePath ) );
+    String tocFileName( ( basePath + TXT( "CacheCompactTest.toc" ) ).c_str() );
+    String cacheFileName( ( basePath + TXT( "CacheCompactTest.cache" ) ).c_str() );
+    FilePath( tocFileName ).Delete();
+    FilePath( cacheFileName ).Delete();
+
+    const size_t entryCount = 4;
+    AssetPath paths[ entryCount ];
+    uint8_t entryData[ entryCount ][ 256 ];
+
+    String pathString;
+    for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+    {
+        pathString.Format( TXT( "/CacheCompactTest:Entry%" ) PRIuSZ, entryIndex );
+        HELIUM_VERIFY( paths[ entryIndex ].Set( pathString ) );
+    }
+
+    {
+        Cache cache;
+        ASSERT_TRUE( cache.Initialize( Name( TXT( "CacheCompactTest" ) ), Cache::PLATFORM_PC, *tocFileName, *cacheFileName ) );
+        cache.EnforceTocLoad();
+
+        for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+        {
+            FillCacheTestEntry( entryData[ entryIndex ], sizeof( entryData[ entryIndex ] ), entryIndex, 0 );
+            ASSERT_TRUE( cache.CacheEntry( paths[ entryIndex ], 0, entryData[ entryIndex ], 1, sizeof( entryData[ entryIndex ] ) ) );
+        }
+
+        // Replace every other entry, leaving holes at the front and in the middle of the cache file.
+        for( size_t entryIndex = 0; entryIndex < entryCount; entryIndex += 2 )
+        {
+            FillCacheTestEntry( entryData[ entryIndex ], sizeof( entryData[ entryIndex ] ), entryIndex, 1 );
+            ASSERT_TRUE( cache.CacheEntry( paths[ entryIndex ], 0, entryData[ entryIndex ], 2, sizeof( entryData[ entryIndex ] ) ) );
+        }
+
+        CheckCacheTestEntries( cache, paths, entryCount, entryData );
+
+        // Queue reads of the old offsets right before compacting; they have to be serviced from the old file.
+        uint8_t pendingBuffer[ 256 ];
+        const Cache::Entry* pPendingEntry = cache.FindEntry( paths[ 1 ], 0 );
+        ASSERT_TRUE( pPendingEntry != NULL );
+        size_t pendingLoadId = cache.QueueEntryLoad( *pPendingEntry, pendingBuffer, sizeof( pendingBuffer ) );
+        ASSERT_TRUE( IsValid( pendingLoadId ) );
+
+        uint64_t reclaimedBytes = 0;
+        ASSERT_TRUE( cache.Compact( reclaimedBytes ) );
+        EXPECT_LE( static_cast< uint64_t >( 2 * sizeof( entryData[ 0 ] ) ), reclaimedBytes );
+
+        EXPECT_EQ( sizeof( pendingBuffer ), AsyncLoader::GetStaticInstance().SyncRequest( pendingLoadId ) );
+        EXPECT_EQ( 0, MemoryCompare( entryData[ 1 ], pendingBuffer, sizeof( pendingBuffer ) ) );
+
+        CheckCacheTestEntries( cache, paths, entryCount, entryData );
+
+        cache.Shutdown();
+    }
+
+    // The rewritten TOC has to match the compacted file as well.
+    {
+        Cache cache;
+        ASSERT_TRUE( cache.Initialize( Name( TXT( "CacheCompactTest" ) ), Cache::PLATFORM_PC, *tocFileName, *cacheFileName ) );
+        cache.EnforceTocLoad();
+        EXPECT_EQ( static_cast< uint32_t >( entryCount ), cache.GetEntryCount() );
+
+        CheckCacheTestEntries( cache, paths, entryCount, entryData );
+
+        cache.Shutdown();
+    }
+
+    FilePath( tocFileName ).Delete();
+    FilePath( cacheFileName ).Delete();
+}
+
+TEST(Engine, CompressionRoundTrip)
+{
+    // Repetitive data compresses well, random data shouldn't compress at all.
+    uint8_t sourceData[ 4096 ];
+    for( size_t byteIndex = 0; byteIndex < sizeof( sourceData ); ++byteIndex )
+    {
+        sourceData[ byteIndex ] = static_cast< uint8_t >( ( byteIndex / 16 ) % 7 );
+    }
+
+    DynamicArray< uint8_t > compressed;
+    ASSERT_TRUE( Compression::CompressBlock( CompressionCodecs::Zlib, sourceData, sizeof( sourceData ), compressed ) );
+    EXPECT_GT( sizeof( sourceData ), compressed.GetSize() );
+
+    uint8_t decompressed[ sizeof( sourceData ) ];
+    EXPECT_EQ(
+        sizeof( decompressed ),
+        Compression::DecompressBlock(
+            CompressionCodecs::Zlib, compressed.GetData(), compressed.GetSize(), decompressed, sizeof( decompressed ) ) );
+    EXPECT_EQ( 0, MemoryCompare( sourceData, decompressed, sizeof( sourceData ) ) );
+
+    // Partial decompression only fills the leading bytes.
+    MemoryZero( decompressed, sizeof( decompressed ) );
+    EXPECT_EQ(
+        static_cast< size_t >( 100 ),
+        Compression::DecompressBlock( CompressionCodecs::Zlib, compressed.GetData(), compressed.GetSize(), decompressed, 100 ) );
+    EXPECT_EQ( 0, MemoryCompare( sourceData, decompressed, 100 ) );
+
+    uint8_t noiseData[ 256 ];
+    uint32_t noiseState = 0x12345678;
+    for( size_t byteIndex = 0; byteIndex < sizeof( noiseData ); ++byteIndex )
+    {
+        noiseState = noiseState * 1664525 + 1013904223;
+        noiseData[ byteIndex ] = static_cast< uint8_t >( noiseState >> 24 );
+    }
+
+    EXPECT_FALSE( Compression::CompressBlock( CompressionCodecs::Zlib, noiseData, sizeof( noiseData ), compressed ) );
+    EXPECT_FALSE( Compression::CompressBlock( CompressionCodecs::None, sourceData, sizeof( sourceData ), compressed ) );
+
+    // Caches only compress entries when asked to, and compressed entries read back through both read paths.
+    EXPECT_EQ( CompressionCodecs::None, CacheManager::GetStaticInstance().GetCompressionPolicy( Name( TXT( "CompressionTest" ) ) ) );
+
+    FilePath basePath;
+    HELIUM_VERIFY( FileLocations::GetUserDataDirectory( basePath ) );
+    String tocFileName( ( basePath + TXT( "CompressionTest.toc" ) ).c_str() );
+    String cacheFileName( ( basePath + TXT( "CompressionTest.cache" ) ).c_str() );
+    FilePath( tocFileName ).Delete();
+    FilePath( cacheFileName ).Delete();
+
+    AssetPath path;
+    HELIUM_VERIFY( path.Set( TXT( "/CompressionTest:Entry" ) ) );
+
+    {
+        Cache cache;
+        ASSERT_TRUE( cache.Initialize( Name( TXT( "CompressionTest" ) ), Cache::PLATFORM_PC, *tocFileName, *cacheFileName ) );
+        cache.EnforceTocLoad();
+        cache.SetCompression( CompressionCodecs::Zlib );
+        ASSERT_TRUE( cache.CacheEntry( path, 0, sourceData, 1, sizeof( sourceData ) ) );
+
+        const Cache::Entry* pEntry = cache.FindEntry( path, 0 );
+        ASSERT_TRUE( pEntry != NULL );
+        EXPECT_EQ( CompressionCodecs::Zlib, pEntry->compression );
+        EXPECT_EQ( static_cast< uint32_t >( sizeof( sourceData ) ), pEntry->size );
+        EXPECT_GT( pEntry->size, pEntry->storedSize );
+        EXPECT_TRUE( cache.GetMappedEntryData( *pEntry ) == NULL );
+
+        DynamicArray< uint8_t > readData;
+        ASSERT_TRUE( cache.ReadEntry( *pEntry, readData ) );
+        ASSERT_EQ( sizeof( sourceData ), readData.GetSize() );
+        EXPECT_EQ( 0, MemoryCompare( sourceData, readData.GetData(), sizeof( sourceData ) ) );
+
+        MemoryZero( decompressed, sizeof( decompressed ) );
+        size_t loadId = cache.QueueEntryLoad( *pEntry, decompressed, sizeof( decompressed ) );
+        ASSERT_TRUE( IsValid( loadId ) );
+        EXPECT_EQ( sizeof( decompressed ), AsyncLoader::GetStaticInstance().SyncRequest( loadId ) );
+        EXPECT_EQ( 0, MemoryCompare( sourceData, decompressed, sizeof( sourceData ) ) );
+
+        cache.Shutdown();
+    }
+
+    FilePath( tocFileName ).Delete();
+    FilePath( cacheFileName ).Delete();
+}
+
+TEST(Engine, CacheConfigCompressionPolicies)
+{
+    // The default configuration compresses mesh data, which is loaded through the read path anyway.
+    StrongPtr< CacheConfig > spDefaultConfig(
+        Config::GetStaticInstance().GetConfigObject< CacheConfig >( Name( TXT( "CacheConfig" ) ) ) );
+    ASSERT_TRUE( spDefaultConfig );
+    EXPECT_EQ( CompressionCodecs::Zlib, CacheManager::GetStaticInstance().GetCompressionPolicy( Name( TXT( "Mesh" ) ) ) );
+
+    PackagePtr spPackage;
+    HELIUM_VERIFY( Asset::Create< Package >( spPackage, Name( TXT( "CacheConfigTest" ) ), NULL ) );
+
+    StrongPtr< CacheConfig > spCacheConfig;
+    HELIUM_VERIFY( Asset::Create< CacheConfig >( spCacheConfig, Name( TXT( "CacheConfig" ) ), spPackage ) );
+
+    CacheCompressionPolicy policy;
+    policy.cacheName = Name( TXT( "CacheConfigTest" ) );
+    policy.compression = CacheCompressionPolicy::ECompression::ZLIB;
+    spCacheConfig->m_compressionPolicies.Push( policy );
+
+    CacheManager& rCacheManager = CacheManager::GetStaticInstance();
+    EXPECT_EQ( CompressionCodecs::None, rCacheManager.GetCompressionPolicy( policy.cacheName ) );
+
+    spCacheConfig->ApplyCompressionPolicies();
+    EXPECT_EQ( CompressionCodecs::Zlib, rCacheManager.GetCompressionPolicy( policy.cacheName ) );
+
+    spCacheConfig->m_compressionPolicies[ 0 ].compression = CacheCompressionPolicy::ECompression::NONE;
+    spCacheConfig->ApplyCompressionPolicies();
+    EXPECT_EQ( CompressionCodecs::None, rCacheManager.GetCompressionPolicy( policy.cacheName ) );
+}
+
+TEST(Engine, CacheIndexReadBack)
+{
+    FilePath basePath;
+    HELIUM_VERIFY( FileLocations::GetUserDataDirectory( basePath ) );
+    String tocFileName( ( basePath + TXT( "CacheIndexTest.toc" ) ).c_str() );
+    String cacheFileName( ( basePath + TXT( "CacheIndexTest.cache" ) ).c_str() );
+    String indexFileName( ( basePath + TXT( "CacheIndexTest.cacheidx" ) ).c_str() );
+    FilePath( tocFileName ).Delete();
+    FilePath( cacheFileName ).Delete();
+    FilePath( indexFileName ).Delete();
+
+    const size_t entryCount = 8;
+    AssetPath paths[ entryCount ];
+    uint8_t entryData[ entryCount ][ 256 ];
+
+    String pathString;
+    for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+    {
+        pathString.Format( TXT( "/CacheIndexTest:Entry%" ) PRIuSZ, entryIndex );
+        HELIUM_VERIFY( paths[ entryIndex ].Set( pathString ) );
+        FillCacheTestEntry( entryData[ entryIndex ], sizeof( entryData[ entryIndex ] ), entryIndex, 0 );
+    }
+
+    {
+        Cache cache;
+        ASSERT_TRUE( cache.Initialize( Name( TXT( "CacheIndexTest" ) ), Cache::PLATFORM_PC, *tocFileName, *cacheFileName, *indexFileName ) );
+        cache.EnforceTocLoad();
+
+        for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+        {
+            ASSERT_TRUE( cache.CacheEntry( paths[ entryIndex ], 0, entryData[ entryIndex ], 1, sizeof( entryData[ entryIndex ] ) ) );
+        }
+
+        ASSERT_TRUE( cache.WriteIndex() );
+        cache.Shutdown();
+    }
+
+    // Runtime builds look entries up in the index rather than loading the TOC; either way, every entry has to match.
+    {
+        Cache cache;
+        ASSERT_TRUE( cache.Initialize( Name( TXT( "CacheIndexTest" ) ), Cache::PLATFORM_PC, *tocFileName, *cacheFileName, *indexFileName ) );
+        cache.EnforceTocLoad();
+#if !HELIUM_TOOLS
+        EXPECT_TRUE( cache.IsIndexMapped() );
+#endif
+        ASSERT_EQ( static_cast< uint32_t >( entryCount ), cache.GetEntryCount() );
+
+        CheckCacheTestEntries( cache, paths, entryCount, entryData );
+
+        // Iterating over the entries returns the same entry objects each time, and the same ones FindEntry() does.
+        for( uint32_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+        {
+            const Cache::Entry& rEntry = cache.GetEntry( entryIndex );
+            EXPECT_EQ( &rEntry, &cache.GetEntry( entryIndex ) );
+            EXPECT_EQ( &rEntry, cache.FindEntry( rEntry.path, rEntry.subDataIndex ) );
+        }
+
+        cache.Shutdown();
+    }
+
+    // An index written with the opposite byte order is rejected in favor of the TOC.
+    {
+        FileStream* pIndexStream = FileStream::OpenFileStream( *indexFileName, FileStream::MODE_WRITE, false );
+        ASSERT_TRUE( pIndexStream != NULL );
+
+        const uint32_t swappedMagic = 0x3c1dc4ca;
+        EXPECT_EQ( static_cast< int64_t >( 0 ), pIndexStream->Seek( 0, SeekOrigins::Begin ) );
+        EXPECT_EQ( static_cast< size_t >( 1 ), pIndexStream->Write( &swappedMagic, sizeof( swappedMagic ), 1 ) );
+
+        delete pIndexStream;
+
+        Cache cache;
+        ASSERT_TRUE( cache.Initialize( Name( TXT( "CacheIndexTest" ) ), Cache::PLATFORM_PC, *tocFileName, *cacheFileName, *indexFileName ) );
+        cache.EnforceTocLoad();
+        EXPECT_FALSE( cache.IsIndexMapped() );
+        ASSERT_EQ( static_cast< uint32_t >( entryCount ), cache.GetEntryCount() );
+
+        CheckCacheTestEntries( cache, paths, entryCount, entryData );
+
+        cache.Shutdown();
+    }
+
+    FilePath( tocFileName ).Delete();
+    FilePath( cacheFileName ).Delete();
+    FilePath( indexFileName ).Delete();
+}
+
+TEST(Graphics, TextureStreamerMipSelection)
+{
+    // The wanted level is the smallest one still covering the on-screen size, but never smaller than the minimum
+    // resident level.
+    EXPECT_EQ( 0u, TextureStreamer::SelectWantedBaseMip( 1024, 4, 1024.0f ) );
+    EXPECT_EQ( 0u, TextureStreamer::SelectWantedBaseMip( 1024, 4, 600.0f ) );
+    EXPECT_EQ( 1u, TextureStreamer::SelectWantedBaseMip( 1024, 4, 512.0f ) );
+    EXPECT_EQ( 2u, TextureStreamer::SelectWantedBaseMip( 1024, 4, 200.0f ) );
+    EXPECT_EQ( 4u, TextureStreamer::SelectWantedBaseMip( 1024, 4, 1.0f ) );
+    EXPECT_EQ( 4u, TextureStreamer::SelectWantedBaseMip( 1024, 4, 0.0f ) );
+
+    // Two 1024x1024 RGBA textures, keeping 64x64 and below resident at all times.
+    const uint32_t mipCount = 11;
+    size_t mipSizes[ mipCount ];
+    for( uint32_t mipIndex = 0; mipIndex < mipCount; ++mipIndex )
+    {
+        size_t mipWidth = static_cast< size_t >( 1024 >> mipIndex );
+        mipSizes[ mipIndex ] = mipWidth * mipWidth * 4;
+    }
+
+    size_t chainSizes[ mipCount + 1 ];
+    chainSizes[ mipCount ] = 0;
+    for( uint32_t mipIndex = mipCount; mipIndex-- > 0; )
+    {
+        chainSizes[ mipIndex ] = chainSizes[ mipIndex + 1 ] + mipSizes[ mipIndex ];
+    }
+
+    TextureStreamer::MipChain chains[ 2 ];
+    for( size_t chainIndex = 0; chainIndex < HELIUM_ARRAY_COUNT( chains ); ++chainIndex )
+    {
+        chains[ chainIndex ].pMipSizes = mipSizes;
+        chains[ chainIndex ].mipCount = mipCount;
+        chains[ chainIndex ].wantedBaseMip = 0;
+        chains[ chainIndex ].minResidentBaseMip = 4;
+    }
+
+    // Nothing is dropped while everything fits, and the budget is met exactly at each step.
+    EXPECT_EQ( 0u, TextureStreamer::ComputeMipBias( chains, 2, 2 * chainSizes[ 0 ] ) );
+    EXPECT_EQ( 1u, TextureStreamer::ComputeMipBias( chains, 2, 2 * chainSizes[ 0 ] - 1 ) );
+    EXPECT_EQ( 1u, TextureStreamer::ComputeMipBias( chains, 2, 2 * chainSizes[ 1 ] ) );
+    EXPECT_EQ( 2u, TextureStreamer::ComputeMipBias( chains, 2, 2 * chainSizes[ 1 ] - 1 ) );
+
+    // Textures never drop below their minimum resident level, even if that exceeds the budget.
+    EXPECT_EQ( 4u, TextureStreamer::ComputeMipBias( chains, 2, 0 ) );
+
+    // The bias applies to every texture, so one drawn small only drops once the bias passes its wanted level.
+    chains[ 1 ].wantedBaseMip = 3;
+    EXPECT_EQ( 0u, TextureStreamer::ComputeMipBias( chains, 2, chainSizes[ 0 ] + chainSizes[ 3 ] ) );
+    EXPECT_EQ( 1u, TextureStreamer::ComputeMipBias( chains, 2, chainSizes[ 1 ] + chainSizes[ 4 ] ) );
+    EXPECT_EQ( 3u, TextureStreamer::ComputeMipBias( chains, 2, chainSizes[ 3 ] + chainSizes[ 4 ] ) );
+
+    // Levels with no cached data don't count toward the budget.
+    mipSizes[ 0 ] = Invalid< size_t >();
+    EXPECT_EQ( 0u, TextureStreamer::ComputeMipBias( chains, 2, chainSizes[ 1 ] + chainSizes[ 3 ] ) );
+
+    EXPECT_EQ( 0u, TextureStreamer::ComputeMipBias( NULL, 0, 0 ) );
+}
+
+// Work callback that holds up a loader worker for a moment before recording that it ran
+static void DelayedCompletionWork( void* pData )
+{
+    Thread::Sleep( 20 );
+    AtomicIncrementRelease( *static_cast< volatile int32_t* >( pData ) );
+}
+
+TEST(Engine, AsyncLoaderWaitForCompletion)
+{
+    AsyncLoader& rLoader = AsyncLoader::GetStaticInstance();
+    rLoader.Flush();
+
+    // With nothing pending and nothing completed, there is nothing to wait on.
+    EXPECT_FALSE( rLoader.WaitForCompletion( rLoader.GetCompletionCount() ) );
+
+    // Waiting on a count read before queueing returns once the work has run, and never before.
+    volatile int32_t runCount = 0;
+    int32_t completionCount = rLoader.GetCompletionCount();
+    size_t workId = rLoader.QueueWork( DelayedCompletionWork, const_cast< int32_t* >( &runCount ) );
+    ASSERT_TRUE( IsValid( workId ) );
+
+    EXPECT_TRUE( rLoader.WaitForCompletion( completionCount ) );
+    EXPECT_EQ( 1, runCount );
+    EXPECT_NE( completionCount, rLoader.GetCompletionCount() );
+    rLoader.SyncRequest( workId );
+
+    // A completion that happened before the wait is still reported once the queue has drained.
+    EXPECT_TRUE( rLoader.WaitForCompletion( completionCount ) );
+}
+
+TEST(Engine, AssetLoaderDependencyOrdering)
+{
+    AssetPath referencingPath;
+    AssetPath referencedPath;
+    HELIUM_VERIFY( referencingPath.Set( TXT( "/EngineTest/ChildPackage:TestObject2" ) ) );
+    HELIUM_VERIFY( referencedPath.Set( TXT( "/EngineTest/ChildPackage:TestObject3" ) ) );
+
+    // Finish the asset holding the reference first, so that it has to wait on the load of the asset it refers to.
+    size_t referencingLoadId = gAssetLoader->BeginLoadObject( referencingPath );
+    size_t referencedLoadId = gAssetLoader->BeginLoadObject( referencedPath );
+    ASSERT_TRUE( IsValid( referencingLoadId ) );
+    ASSERT_TRUE( IsValid( referencedLoadId ) );
+
+    AssetPtr spReferencing;
+    gAssetLoader->FinishLoad( referencingLoadId, spReferencing );
+    ASSERT_TRUE( spReferencing );
+    EXPECT_TRUE( spReferencing->IsFullyLoaded() );
+
+    TestAsset2* pTestAsset2 = Reflect::SafeCast< TestAsset2 >( spReferencing.Get() );
+    ASSERT_TRUE( pTestAsset2 != NULL );
+    ASSERT_TRUE( pTestAsset2->m_TestReference );
+    EXPECT_TRUE( pTestAsset2->m_TestReference->IsFullyLoaded() );
+
+    // The referenced asset's own request resolves to the same instance.
+    AssetPtr spReferenced;
+    gAssetLoader->FinishLoad( referencedLoadId, spReferenced );
+    EXPECT_EQ( spReferenced.Get(), pTestAsset2->m_TestReference.Get() );
+    EXPECT_EQ( 320.0f, pTestAsset2->m_TestReference->m_TestValue1 );
+}
+
+TEST(Engine, LoadManifestRoundTrip)
+{
+    AssetPath objectPaths[ 2 ];
+    HELIUM_VERIFY( objectPaths[ 0 ].Set( TXT( "/ManifestTest:Object0" ) ) );
+    HELIUM_VERIFY( objectPaths[ 1 ].Set( TXT( "/ManifestTest:Object1" ) ) );
+    Name cacheNames[ 2 ] = { Name( TXT( "ManifestTestA" ) ), Name( TXT( "ManifestTestB" ) ) };
+
+    // Repeated loads and reads are only recorded the first time they happen.
+    LoadManifest manifest;
+    manifest.AddObjectLoad( objectPaths[ 0 ] );
+    manifest.AddSubDataLoad( cacheNames[ 0 ], objectPaths[ 0 ], 1 );
+    manifest.AddObjectLoad( objectPaths[ 1 ] );
+    manifest.AddObjectLoad( objectPaths[ 0 ] );
+    manifest.AddSubDataLoad( cacheNames[ 0 ], objectPaths[ 0 ], 1 );
+    manifest.AddSubDataLoad( cacheNames[ 0 ], objectPaths[ 0 ], 2 );
+    manifest.AddSubDataLoad( cacheNames[ 1 ], objectPaths[ 0 ], 1 );
+    ASSERT_EQ( static_cast< size_t >( 5 ), manifest.GetRecordCount() );
+
+    FilePath basePath;
+    HELIUM_VERIFY( FileLocations::GetUserDataDirectory( basePath ) );
+    String manifestFileName( ( basePath + TXT( "LoadManifestTest.dat" ) ).c_str() );
+    ASSERT_TRUE( manifest.Save( manifestFileName ) );
+
+    LoadManifest loadedManifest;
+    ASSERT_TRUE( loadedManifest.Load( manifestFileName ) );
+    ASSERT_EQ( manifest.GetRecordCount(), loadedManifest.GetRecordCount() );
+    for( size_t recordIndex = 0; recordIndex < manifest.GetRecordCount(); ++recordIndex )
+    {
+        EXPECT_TRUE( manifest.GetRecord( recordIndex ) == loadedManifest.GetRecord( recordIndex ) );
+    }
+
+    EXPECT_TRUE( IsInvalid( loadedManifest.GetRecord( 0 ).subDataIndex ) );
+    EXPECT_EQ( objectPaths[ 1 ], loadedManifest.GetRecord( 2 ).path );
+    EXPECT_EQ( cacheNames[ 1 ], loadedManifest.GetRecord( 4 ).cacheName );
+
+    FilePath( manifestFileName ).Delete();
+    EXPECT_FALSE( loadedManifest.Load( manifestFileName ) );
+    EXPECT_EQ( static_cast< size_t >( 0 ), loadedManifest.GetRecordCount() );
+}
+
+TEST(Engine, Fnv1aHasher)
+{
+    // Reference values from the FNV test suite.
+    Fnv1aHasher emptyHasher;
+    EXPECT_EQ( static_cast< uint64_t >( Fnv1aHasher::OFFSET_BASIS ), emptyHasher.GetHash() );
+
+    Fnv1aHasher hasher;
+    hasher.Add( "a", 1 );
+    EXPECT_EQ( 0xaf63dc4c8601ec8cULL, hasher.GetHash() );
+
+    // Hashing incrementally gives the same result as hashing everything at once.
+    Fnv1aHasher wholeHasher;
+    wholeHasher.Add( "foobar", 6 );
+    EXPECT_EQ( 0x85944171f73967e8ULL, wholeHasher.GetHash() );
+
+    Fnv1aHasher partHasher;
+    partHasher.Add( "foo", 3 );
+    partHasher.Add( "bar", 3 );
+    EXPECT_EQ( wholeHasher.GetHash(), partHasher.GetHash() );
+}
+
+TEST(Engine, LengthPrefixedStringRoundTrip)
+{
+    String strings[ 3 ] = { String( TXT( "/Package:Object" ) ), String(), String( TXT( "Trailing" ) ) };
+
+    DynamicArray< uint8_t > buffer;
+    DynamicMemoryStream writeStream( &buffer );
+    for( size_t stringIndex = 0; stringIndex < HELIUM_ARRAY_COUNT( strings ); ++stringIndex )
+    {
+        EXPECT_TRUE( WriteLengthPrefixedString( writeStream, strings[ stringIndex ] ) );
+    }
+
+    StaticMemoryStream readStream( buffer.GetData(), buffer.GetSize() );
+    DynamicArray< char > readString;
+    for( size_t stringIndex = 0; stringIndex < HELIUM_ARRAY_COUNT( strings ); ++stringIndex )
+    {
+        ASSERT_TRUE( ReadLengthPrefixedString( readStream, readString ) );
+        EXPECT_TRUE( strings[ stringIndex ] == String( readString.GetData() ) );
+    }
+
+    // Reading past the end fails instead of returning garbage.
+    EXPECT_FALSE( ReadLengthPrefixedString( readStream, readString ) );
+}
+
+TEST(Engine, AssetLoaderManifestPrefetch)
+{
+    FilePath basePath;
+    HELIUM_VERIFY( FileLocations::GetUserDataDirectory( basePath ) );
+    String manifestFileName( ( basePath + TXT( "PrefetchManifestTest.dat" ) ).c_str() );
+
+    AssetPath assetPath;
+    HELIUM_VERIFY( assetPath.Set( TXT( "/EngineTest/ChildPackage:TestObject2" ) ) );
+
+    // Resource sub-data to prefetch.
+    Name cacheName( TXT( "PrefetchTest" ) );
+    Cache* pCache = CacheManager::GetStaticInstance().GetCache( cacheName );
+    ASSERT_TRUE( pCache != NULL );
+    FilePath( pCache->GetTocFileName() ).Delete();
+    FilePath( pCache->GetCacheFileName() ).Delete();
+    pCache->EnforceTocLoad();
+
+    uint8_t subData[ 256 ];
+    FillCacheTestEntry( subData, sizeof( subData ), 0, 0 );
+    ASSERT_TRUE( pCache->CacheEntry( assetPath, 1, subData, 1, sizeof( subData ) ) );
+
+    EXPECT_FALSE( gAssetLoader->IsRecordingManifest() );
+    gAssetLoader->BeginRecordingManifest();
+    EXPECT_TRUE( gAssetLoader->IsRecordingManifest() );
+
+    AssetPtr spAsset;
+    gAssetLoader->LoadObject( assetPath, spAsset );
+    ASSERT_TRUE( spAsset );
+    gAssetLoader->RecordSubDataLoad( cacheName, assetPath, 1 );
+    gAssetLoader->RecordSubDataLoad( cacheName, assetPath, 1 );
+
+    ASSERT_TRUE( gAssetLoader->EndRecordingManifest( manifestFileName ) );
+    EXPECT_FALSE( gAssetLoader->IsRecordingManifest() );
+
+    LoadManifest manifest;
+    ASSERT_TRUE( manifest.Load( manifestFileName ) );
+    ASSERT_LE( static_cast< size_t >( 2 ), manifest.GetRecordCount() );
+    EXPECT_EQ( assetPath, manifest.GetRecord( 0 ).path );
+    EXPECT_TRUE( IsInvalid( manifest.GetRecord( 0 ).subDataIndex ) );
+
+    size_t subDataRecordCount = 0;
+    for( size_t recordIndex = 0; recordIndex < manifest.GetRecordCount(); ++recordIndex )
+    {
+        if( IsValid( manifest.GetRecord( recordIndex ).subDataIndex ) )
+        {
+            ++subDataRecordCount;
+        }
+    }
+
+    EXPECT_EQ( static_cast< size_t >( 1 ), subDataRecordCount );
+
+    // Replaying the manifest issues the recorded loads and reads, and ending it waits for them.
+    ASSERT_TRUE( gAssetLoader->BeginPrefetch( manifestFileName ) );
+    EXPECT_TRUE( gAssetLoader->IsPrefetching() );
+    gAssetLoader->Tick();
+    gAssetLoader->EndPrefetch();
+    EXPECT_FALSE( gAssetLoader->IsPrefetching() );
+
+    FilePath( manifestFileName ).Delete();
+    EXPECT_FALSE( gAssetLoader->BeginPrefetch( manifestFileName ) );
+    EXPECT_FALSE( gAssetLoader->IsPrefetching() );
+
+    FilePath( pCache->GetTocFileName() ).Delete();
+    FilePath( pCache->GetCacheFileName() ).Delete();
+}
+
+TEST(Engine, AssetLoaderPrefetchRelease)
+{
+    FilePath basePath;
+    HELIUM_VERIFY( FileLocations::GetUserDataDirectory( basePath ) );
+    String manifestFileName( ( basePath + TXT( "PrefetchReleaseTest.dat" ) ).c_str() );
+
+    PackagePtr spPackage;
+    HELIUM_VERIFY( Asset::Create< Package >( spPackage, Name( TXT( "PrefetchReleaseTest" ) ), NULL ) );
+
+    // One more object than can be prefetched at once, so that the manifest is not exhausted after the first update.
+    const size_t objectCount = AssetLoader::PREFETCH_LOAD_COUNT_MAX + 1;
+    DynamicArray< PackagePtr > objects;
+    DynamicArray< uint16_t > baseRefCounts;
+    LoadManifest manifest;
+    String nameString;
+    for( size_t objectIndex = 0; objectIndex < objectCount; ++objectIndex )
+    {
+        nameString.Format( TXT( "Object%" ) PRIuSZ, objectIndex );
+        PackagePtr spObject;
+        HELIUM_VERIFY( Asset::Create< Package >( spObject, Name( nameString ), spPackage ) );
+        spObject->SetFlags( Asset::FLAG_PRELOADED | Asset::FLAG_LINKED | Asset::FLAG_PRECACHED | Asset::FLAG_LOADED );
+
+        objects.Push( spObject );
+        baseRefCounts.Push( spObject->GetRefCountProxy()->GetStrongRefCount() );
+        manifest.AddObjectLoad( spObject->GetPath() );
+    }
+
+    ASSERT_TRUE( manifest.Save( manifestFileName ) );
+
+    // The first update syncs the first batch of prefetch loads, holding on to their objects until they are requested.
+    ASSERT_TRUE( gAssetLoader->BeginPrefetch( manifestFileName ) );
+    gAssetLoader->Tick();
+    EXPECT_TRUE( gAssetLoader->IsPrefetching() );
+    EXPECT_EQ( baseRefCounts[ 0 ] + 1, objects[ 0 ]->GetRefCountProxy()->GetStrongRefCount() );
+    EXPECT_EQ( baseRefCounts[ 1 ] + 1, objects[ 1 ]->GetRefCountProxy()->GetStrongRefCount() );
+
+    // Once the object is requested for real, the prefetched reference is dropped.
+    size_t loadId = gAssetLoader->BeginLoadObject( objects[ 0 ]->GetPath() );
+    ASSERT_TRUE( IsValid( loadId ) );
+    AssetPtr spLoaded;
+    gAssetLoader->FinishLoad( loadId, spLoaded );
+    EXPECT_EQ( objects[ 0 ].Get(), spLoaded.Get() );
+    spLoaded.Release();
+    EXPECT_EQ( baseRefCounts[ 0 ], objects[ 0 ]->GetRefCountProxy()->GetStrongRefCount() );
+    EXPECT_EQ( baseRefCounts[ 1 ] + 1, objects[ 1 ]->GetRefCountProxy()->GetStrongRefCount() );
+
+    // Prefetching ends on its own once the last record has completed, releasing the objects never requested.
+    gAssetLoader->Tick();
+    EXPECT_FALSE( gAssetLoader->IsPrefetching() );
+    for( size_t objectIndex = 0; objectIndex < objectCount; ++objectIndex )
+    {
+        EXPECT_EQ( baseRefCounts[ objectIndex ], objects[ objectIndex ]->GetRefCountProxy()->GetStrongRefCount() );
+    }
+
+    FilePath( manifestFileName ).Delete();
+}
+
+TEST(Engine, ResidencyManagerEviction)
+{
+    PackagePtr spPackage;
+    HELIUM_VERIFY( Asset::Create< Package >( spPackage, Name( TXT( "ResidencyTest" ) ), NULL ) );
+
+    const size_t resourceCount = 3;
+    StrongPtr< Resource > spResources[ resourceCount ];
+    AssetPath resourcePaths[ resourceCount ];
+    String nameString;
+    for( size_t resourceIndex = 0; resourceIndex < resourceCount; ++resourceIndex )
+    {
+        nameString.Format( TXT( "Resource%" ) PRIuSZ, resourceIndex );
+        HELIUM_VERIFY( Asset::Create< Resource >( spResources[ resourceIndex ], Name( nameString ), spPackage ) );
+        resourcePaths[ resourceIndex ] = spResources[ resourceIndex ]->GetPath();
+    }
+
+    size_t resourceSize = spResources[ 0 ]->GetResidentSize();
+    ASSERT_NE( static_cast< size_t >( 0 ), resourceSize );
+
+    // Nothing is tracked until a budget is set.
+    ResidencyManager residencyManager;
+    EXPECT_FALSE( residencyManager.IsEnabled() );
+    residencyManager.Track( spResources[ 0 ] );
+    EXPECT_EQ( static_cast< size_t >( 0 ), residencyManager.GetTrackedCount() );
+
+    residencyManager.SetBudget( 2 * resourceSize );
+    EXPECT_TRUE( residencyManager.IsEnabled() );
+    EXPECT_EQ( 2 * resourceSize, residencyManager.GetBudget() );
+
+    for( size_t resourceIndex = 0; resourceIndex < resourceCount; ++resourceIndex )
+    {
+        residencyManager.Track( spResources[ resourceIndex ] );
+    }
+
+    EXPECT_EQ( resourceCount, residencyManager.GetTrackedCount() );
+    EXPECT_EQ( resourceCount * resourceSize, residencyManager.GetResidentSize() );
+
+    // The first resource is the least recently used, but is still referenced, so the third one goes first once the
+    // second one has been used again.
+    residencyManager.Touch( spResources[ 1 ] );
+    spResources[ 1 ].Release();
+    spResources[ 2 ].Release();
+
+    residencyManager.Tick();
+    EXPECT_EQ( static_cast< uint64_t >( 1 ), residencyManager.GetEvictionCount() );
+    EXPECT_EQ( resourceCount - 1, residencyManager.GetTrackedCount() );
+    EXPECT_EQ( 2 * resourceSize, residencyManager.GetResidentSize() );
+    EXPECT_TRUE( Asset::FindObject( resourcePaths[ 0 ] ) != NULL );
+    EXPECT_TRUE( Asset::FindObject( resourcePaths[ 1 ] ) != NULL );
+    EXPECT_TRUE( Asset::FindObject( resourcePaths[ 2 ] ) == NULL );
+
+    // Within budget, nothing else is evicted.
+    residencyManager.Tick();
+    EXPECT_EQ( static_cast< uint64_t >( 1 ), residencyManager.GetEvictionCount() );
+
+    // Disabling residency releases everything kept resident.
+    residencyManager.SetBudget( Invalid< size_t >() );
+    EXPECT_FALSE( residencyManager.IsEnabled() );
+    EXPECT_EQ( static_cast< size_t >( 0 ), residencyManager.GetTrackedCount() );
+    EXPECT_TRUE( Asset::FindObject( resourcePaths[ 1 ] ) == NULL );
+    EXPECT_TRUE( Asset::FindObject( resourcePaths[ 0 ] ) != NULL );
+}
+
+TEST(Engine, LoadProfilerReport)
+{
+    // Profile as a headless run would, recording loads with known times instead of loading anything.
+    ASSERT_TRUE( LoadProfiler::GetStaticInstance() == NULL );
+    HELIUM_VERIFY( LoadProfiler::InitializeStaticInstance() );
+    LoadProfiler* pProfiler = LoadProfiler::GetStaticInstance();
+    ASSERT_TRUE( pProfiler != NULL );
+
+    const size_t pathCount = 5;
+    AssetPath paths[ pathCount ];
+    String pathString;
+    for( size_t pathIndex = 0; pathIndex < pathCount; ++pathIndex )
+    {
+        pathString.Format( TXT( "/ProfilerTest:Object%" ) PRIuSZ, pathIndex );
+        HELIUM_VERIFY( paths[ pathIndex ].Set( *pathString ) );
+    }
+
+    Name typeNameA( TXT( "ProfilerTypeA" ) );
+    Name typeNameB( TXT( "ProfilerTypeB" ) );
+
+    // Object0 waits on Object1 and Object2, Object2 waits on Object3 and back on Object0, and Object4 never finishes.
+    pProfiler->BeginLoad( paths[ 0 ], 100 );
+    pProfiler->BeginLoad( paths[ 1 ], 150 );
+    pProfiler->BeginLoad( paths[ 2 ], 160 );
+    pProfiler->BeginLoad( paths[ 3 ], 170 );
+    pProfiler->BeginLoad( paths[ 4 ], 200 );
+    pProfiler->AddDependency( paths[ 0 ], paths[ 1 ] );
+    pProfiler->AddDependency( paths[ 0 ], paths[ 2 ] );
+    pProfiler->AddDependency( paths[ 2 ], paths[ 0 ] );
+    pProfiler->AddDependency( paths[ 2 ], paths[ 3 ] );
+    pProfiler->AddPhaseTicks( paths[ 0 ], LoadProfiler::PHASE_PRELOAD, 300 );
+    pProfiler->AddPhaseTicks( paths[ 0 ], LoadProfiler::PHASE_DESERIALIZE, 200 );
+    pProfiler->AddPhaseTicks( paths[ 2 ], LoadProfiler::PHASE_PRELOAD, 40 );
+    pProfiler->AddPhaseTicks( paths[ 3 ], LoadProfiler::PHASE_PRELOAD, 60 );
+    pProfiler->EndLoad( paths[ 3 ], typeNameB, 400 );
+    pProfiler->EndLoad( paths[ 1 ], typeNameB, 500 );
+    pProfiler->EndLoad( paths[ 2 ], typeNameB, 900 );
+    pProfiler->EndLoad( paths[ 0 ], typeNameA, 1100 );
+    EXPECT_EQ( pathCount, pProfiler->GetRecordCount() );
+
+    // The slowest loads come first, loads in progress are left out, and the list is capped at the requested count.
+    DynamicArray< LoadProfiler::Record > records;
+    pProfiler->GetSlowestRecords( records, 10 );
+    ASSERT_EQ( static_cast< size_t >( 4 ), records.GetSize() );
+    EXPECT_EQ( paths[ 0 ], records[ 0 ].path );
+    EXPECT_EQ( paths[ 2 ], records[ 1 ].path );
+    EXPECT_EQ( paths[ 1 ], records[ 2 ].path );
+    EXPECT_EQ( paths[ 3 ], records[ 3 ].path );
+
+    pProfiler->GetSlowestRecords( records, 2 );
+    ASSERT_EQ( static_cast< size_t >( 2 ), records.GetSize() );
+    EXPECT_EQ( paths[ 0 ], records[ 0 ].path );
+    EXPECT_EQ( paths[ 2 ], records[ 1 ].path );
+
+    // The chain follows the dependency that finished last, and skips the reference back to Object0.
+    pProfiler->GetCriticalChain( paths[ 0 ], records );
+    ASSERT_EQ( static_cast< size_t >( 3 ), records.GetSize() );
+    EXPECT_EQ( paths[ 0 ], records[ 0 ].path );
+    EXPECT_EQ( paths[ 2 ], records[ 1 ].path );
+    EXPECT_EQ( paths[ 3 ], records[ 2 ].path );
+
+    DynamicArray< LoadProfiler::TypeTotals > typeTotals;
+    pProfiler->GetTypeTotals( typeTotals );
+    ASSERT_EQ( static_cast< size_t >( 2 ), typeTotals.GetSize() );
+    for( size_t typeIndex = 0; typeIndex < typeTotals.GetSize(); ++typeIndex )
+    {
+        const LoadProfiler::TypeTotals& rTotals = typeTotals[ typeIndex ];
+        if( rTotals.typeName == typeNameA )
+        {
+            EXPECT_EQ( static_cast< size_t >( 1 ), rTotals.loadCount );
+            EXPECT_EQ( static_cast< uint64_t >( 1000 ), rTotals.loadTicks );
+            EXPECT_EQ( static_cast< uint64_t >( 300 ), rTotals.phaseTicks[ LoadProfiler::PHASE_PRELOAD ] );
+            EXPECT_EQ( static_cast< uint64_t >( 200 ), rTotals.phaseTicks[ LoadProfiler::PHASE_DESERIALIZE ] );
+        }
+        else
+        {
+            EXPECT_EQ( typeNameB, rTotals.typeName );
+            EXPECT_EQ( static_cast< size_t >( 3 ), rTotals.loadCount );
+            EXPECT_EQ( static_cast< uint64_t >( 350 + 740 + 230 ), rTotals.loadTicks );
+            EXPECT_EQ( static_cast< uint64_t >( 100 ), rTotals.phaseTicks[ LoadProfiler::PHASE_PRELOAD ] );
+        }
+    }
+
+    String report;
+    pProfiler->WriteReport( report, 2 );
+    std::string reportString( *report );
+    EXPECT_NE( std::string::npos, reportString.find( "4 completed loads, 1 in progress" ) );
+    EXPECT_NE( std::string::npos, reportString.find( "ProfilerTypeA" ) );
+    EXPECT_NE( std::string::npos, reportString.find( "ProfilerTypeB" ) );
+    paths[ 3 ].ToString( pathString );
+    EXPECT_NE( std::string::npos, reportString.find( std::string( "waited on " ) + *pathString ) );
+
+    LoadProfiler::DestroyStaticInstance();
+    EXPECT_TRUE( LoadProfiler::GetStaticInstance() == NULL );
+}
+
+// Writes one frame in the input recording format documented in OisSystem.cpp
+static void WriteTestInputFrame( FileStream* pStream, uint8_t flags, const uint8_t* pKeyStates, const int32_t* pMouseState )
+{
+    uint32_t deltaTickCount = static_cast< uint32_t >( Timer::GetTicksPerSecond() / 60 );
+    pStream->Write( &flags, sizeof( flags ), 1 );
+    pStream->Write( &deltaTickCount, sizeof( deltaTickCount ), 1 );
+
+    if( flags & 1 )
+    {
+        pStream->Write( pKeyStates, 1, 32 );
+    }
+
+    if( flags & 2 )
+    {
+        pStream->Write( pMouseState, sizeof( int32_t ), 7 );
+    }
+}
+
+static void CheckReplayedInputFrame( size_t frameIndex )
+{
+    if( frameIndex < 2 )
+    {
+        EXPECT_TRUE( Input::IsKeyDown( Input::KeyCodes::KC_A ) );
+        EXPECT_FALSE( Input::IsKeyDown( Input::KeyCodes::KC_W ) );
+    }
+    else
+    {
+        EXPECT_FALSE( Input::IsKeyDown( Input::KeyCodes::KC_A ) );
+        EXPECT_TRUE( Input::IsKeyDown( Input::KeyCodes::KC_W ) );
+        EXPECT_TRUE( Input::WasKeyPressedThisFrame( Input::KeyCodes::KC_W ) );
+    }
+
+    EXPECT_TRUE( Input::IsMouseButtonDown( Input::MouseButtons::Left ) );
+    EXPECT_FALSE( Input::IsMouseButtonDown( Input::MouseButtons::Right ) );
+
+    Point mousePos = Input::GetMousePos();
+    EXPECT_EQ( 10, mousePos.x );
+    EXPECT_EQ( 20, mousePos.y );
+
+    Simd::Vector2 mouseDelta = Input::GetMousePosDelta();
+    EXPECT_EQ( 1.0f, mouseDelta.GetX() );
+    EXPECT_EQ( -2.0f, mouseDelta.GetY() );
+}
+
+TEST(Ois, InputRecordingRoundTrip)
+{
+    FilePath basePath;
+    HELIUM_VERIFY( FileLocations::GetUserDataDirectory( basePath ) );
+    String sourceFileName( ( basePath + TXT( "InputRecordingTestSource.bin" ) ).c_str() );
+    String recordedFileName( ( basePath + TXT( "InputRecordingTestRecorded.bin" ) ).c_str() );
+
+    // Hand-build a three frame recording: a keyframe, an unchanged frame, then a frame where only the keys change
+    {
+        FileStream* pStream = FileStream::OpenFileStream( *sourceFileName, FileStream::MODE_WRITE, true );
+        ASSERT_TRUE( pStream != NULL );
+
+        uint32_t magic = 0x48494e50;
+        uint32_t version = 1;
+        uint64_t ticksPerSecond = Timer::GetTicksPerSecond();
+        pStream->Write( &magic, sizeof( magic ), 1 );
+        pStream->Write( &version, sizeof( version ), 1 );
+        pStream->Write( &ticksPerSecond, sizeof( ticksPerSecond ), 1 );
+
+        uint8_t keyStates[ 32 ];
+        MemoryZero( keyStates, sizeof( keyStates ) );
+        keyStates[ Input::KeyCodes::KC_A >> 3 ] |= static_cast< uint8_t >( 1 << ( Input::KeyCodes::KC_A & 7 ) );
+
+        const int32_t mouseState[ 7 ] = { Input::MouseButtons::Left, 10, 20, 1, -2, 640, 480 };
+
+        WriteTestInputFrame( pStream, 3, keyStates, mouseState );
+        WriteTestInputFrame( pStream, 0, keyStates, mouseState );
+
+        MemoryZero( keyStates, sizeof( keyStates ) );
+        keyStates[ Input::KeyCodes::KC_W >> 3 ] |= static_cast< uint8_t >( 1 << ( Input::KeyCodes::KC_W & 7 ) );
+        WriteTestInputFrame( pStream, 1, keyStates, mouseState );
+
+        delete pStream;
+    }
+
+    const size_t frameCount = 3;
+
+    // Re-record the replay, then replay that and make sure every frame comes back the same. The first recorded frame
+    // has to be a full keyframe for this to work, since replays start from a blank state.
+    ASSERT_TRUE( Input::StartReplay( *sourceFileName ) );
+    ASSERT_TRUE( Input::StartRecording( *recordedFileName ) );
+
+    for( size_t frameIndex = 0; frameIndex < frameCount; ++frameIndex )
+    {
+        EXPECT_TRUE( Input::IsReplaying() );
+        Input::Capture();
+        CheckReplayedInputFrame( frameIndex );
+    }
+
+    EXPECT_FALSE( Input::IsReplaying() );
+    Input::StopRecording();
+
+    ASSERT_TRUE( Input::StartReplay( *recordedFileName ) );
+
+    for( size_t frameIndex = 0; frameIndex < frameCount; ++frameIndex )
+    {
+        EXPECT_TRUE( Input::IsReplaying() );
+        Input::Capture();
+        CheckReplayedInputFrame( frameIndex );
+    }
+
+    EXPECT_FALSE( Input::IsReplaying() );
+}
+
+#if HELIUM_TOOLS
+// Deletes the files of a cache managed by the cache manager
+static void DeleteCacheTestFiles( const Cache* pCache )
+{
+    FilePath( pCache->GetTocFileName() ).Delete();
+    FilePath( pCache->GetCacheFileName() ).Delete();
+    FilePath( pCache->GetIndexFileName() ).Delete();
+}
+
+TEST(Engine, CacheBundleWriteAndLoad)
+{
+    CacheManager& rCacheManager = CacheManager::GetStaticInstance();
+    Name sourceCacheName( TXT( "BundleTestSource" ) );
+    Name bundleName( TXT( "BundleTestBundle" ) );
+
+    Cache* pSourceCache = rCacheManager.GetCache( sourceCacheName );
+    Cache* pBundleCache = rCacheManager.GetCache( bundleName );
+    ASSERT_TRUE( pSourceCache != NULL );
+    ASSERT_TRUE( pBundleCache != NULL );
+    DeleteCacheTestFiles( pSourceCache );
+    DeleteCacheTestFiles( pBundleCache );
+
+    AssetPath packagePath;
+    HELIUM_VERIFY( packagePath.Set( TXT( "/BundleTest" ) ) );
+    EXPECT_EQ( Name( TXT( "Bundle_BundleTest" ) ), CachePackageLoader::GetBundleName( packagePath ) );
+
+    const size_t entryCount = 3;
+    AssetPath paths[ entryCount ];
+    uint8_t entryData[ entryCount ][ 256 ];
+
+    AssetPath otherPath;
+    HELIUM_VERIFY( otherPath.Set( TXT( "/OtherBundleTest:Entry" ) ) );
+
+    CachePackageLoader loader;
+    ASSERT_TRUE( loader.Initialize( sourceCacheName ) );
+    pSourceCache->EnforceTocLoad();
+
+    String pathString;
+    for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+    {
+        pathString.Format( TXT( "/BundleTest:Entry%" ) PRIuSZ, entryIndex );
+        HELIUM_VERIFY( paths[ entryIndex ].Set( pathString ) );
+
+        // An empty property stream, so the entries parse as having no dependencies.
+        FillCacheTestEntry( entryData[ entryIndex ], sizeof( entryData[ entryIndex ] ), entryIndex, 0 );
+        MemoryZero( entryData[ entryIndex ], sizeof( uint32_t ) );
+        ASSERT_TRUE( pSourceCache->CacheEntry( paths[ entryIndex ], 0, entryData[ entryIndex ], 1, sizeof( entryData[ entryIndex ] ) ) );
+    }
+
+    ASSERT_TRUE( pSourceCache->CacheEntry( paths[ 0 ], 1, entryData[ 1 ], 1, sizeof( entryData[ 1 ] ) ) );
+    ASSERT_TRUE( pSourceCache->CacheEntry( otherPath, 0, entryData[ 2 ], 1, sizeof( entryData[ 2 ] ) ) );
+
+    // Only the main entries of the objects within the package are bundled.
+    ASSERT_TRUE( loader.WriteBundle( packagePath, bundleName ) );
+    EXPECT_EQ( static_cast< uint32_t >( entryCount ), pBundleCache->GetEntryCount() );
+    EXPECT_TRUE( pBundleCache->FindEntry( paths[ 0 ], 1 ) == NULL );
+    EXPECT_TRUE( pBundleCache->FindEntry( otherPath, 0 ) == NULL );
+    CheckCacheTestEntries( *pBundleCache, paths, entryCount, entryData );
+
+    ASSERT_TRUE( loader.BeginLoadBundle( bundleName ) );
+    while( !loader.TryFinishLoadBundle( bundleName ) )
+    {
+    }
+
+    for( size_t entryIndex = 0; entryIndex < entryCount; ++entryIndex )
+    {
+        EXPECT_TRUE( loader.IsBundled( paths[ entryIndex ] ) );
+    }
+
+    EXPECT_FALSE( loader.IsBundled( otherPath ) );
+
+    // Recaching an object leaves its bundled copy stale, so it has to be loaded from the main cache instead.
+    ASSERT_TRUE( pSourceCache->CacheEntry( paths[ 1 ], 0, entryData[ 1 ], 2, sizeof( entryData[ 1 ] ) ) );
+    EXPECT_TRUE( loader.IsBundled( paths[ 0 ] ) );
+    EXPECT_FALSE( loader.IsBundled( paths[ 1 ] ) );
+
+    EXPECT_TRUE( loader.UnloadBundle( bundleName ) );
+    EXPECT_FALSE( loader.IsBundled( paths[ 0 ] ) );
+
+    loader.Shutdown();
+
+    DeleteCacheTestFiles( pSourceCache );
+    DeleteCacheTestFiles( pBundleCache );
+}
+
+/// Build a cache entry for an object in the layout read by CachePackageLoader (property stream size, type and object
+/// link tables, type/template/owner link indices, then the serialized properties).
+static void BuildCacheTestObjectEntry( Asset* pObject, AssetPath ownerPath, DynamicArray< uint8_t >& rEntry )
+{
+    DynamicArray< uint8_t > propertyData;
+    Cache::WriteCacheObjectToBuffer( pObject, propertyData );
+
+    DynamicMemoryStream stream( &rEntry );
+    uint32_t propertyStreamSize = 0;
+    stream.Write( &propertyStreamSize, sizeof( propertyStreamSize ), 1 );
+
+    uint32_t linkTableSize = 1;
+    stream.Write( &linkTableSize, sizeof( linkTableSize ), 1 );
+    HELIUM_VERIFY( WriteLengthPrefixedString( stream, String( *pObject->GetAssetType()->GetName() ) ) );
+    stream.Write( &linkTableSize, sizeof( linkTableSize ), 1 );
+    HELIUM_VERIFY( WriteLengthPrefixedString( stream, ownerPath.ToString() ) );
+
+    uint32_t typeLinkIndex = 0;
+    uint32_t templateLinkIndex = Invalid< uint32_t >();
+    uint32_t ownerLinkIndex = 0;
+    stream.Write( &typeLinkIndex, sizeof( typeLinkIndex ), 1 );
+    stream.Write( &templateLinkIndex, sizeof( templateLinkIndex ), 1 );
+    stream.Write( &ownerLinkIndex, sizeof( ownerLinkIndex ), 1 );
+
+    stream.Write( propertyData.GetData(), 1, propertyData.GetSize() );
+    stream.Close();
+
+    propertyStreamSize = static_cast< uint32_t >( rEntry.GetSize() - sizeof( propertyStreamSize ) );
+    MemoryCopy( rEntry.GetData(), &propertyStreamSize, sizeof( propertyStreamSize ) );
+}
+
+/// Load an object through a cache package loader, ticking the asset loader for its owner dependency.
+static AssetPtr LoadCacheTestObject( CachePackageLoader& rLoader, AssetPath path )
+{
+    AssetPtr spObject;
+
+    size_t requestId = rLoader.BeginLoadObject( path, NULL );
+    if( IsInvalid( requestId ) )
+    {
+        return spObject;
+    }
+
+    while( !rLoader.TryFinishLoadObject( requestId, spObject ) )
+    {
+        rLoader.Tick();
+        gAssetLoader->Tick();
+    }
+
+    if( spObject )
+    {
+        spObject->SetFlags( Asset::FLAG_LINKED );
+        spObject->ConditionalFinalizeLoad();
+    }
+
+    return spObject;
+}
+
+TEST(Engine, CacheMappedLoadMatchesRead)
+{
+    CacheManager& rCacheManager = CacheManager::GetStaticInstance();
+    Name cacheName( TXT( "MappedLoadTest" ) );
+
+    // No compression policy is set for the test cache, so its entries can be deserialized in place.
+    Cache* pCache = rCacheManager.GetCache( cacheName );
+    ASSERT_TRUE( pCache != NULL );
+    DeleteCacheTestFiles( pCache );
+    pCache->EnforceTocLoad();
+
+    PackagePtr spPackage;
+    HELIUM_VERIFY( Asset::Create< Package >( spPackage, Name( TXT( "MappedLoadTest" ) ), NULL ) );
+    spPackage->SetFlags( Asset::FLAG_PRELOADED | Asset::FLAG_LINKED | Asset::FLAG_PRECACHED | Asset::FLAG_LOADED );
+
+    StrongPtr< CacheConfig > spSource;
+    HELIUM_VERIFY( Asset::Create< CacheConfig >( spSource, Name( TXT( "Source" ) ), spPackage ) );
+
+    CacheCompressionPolicy policy;
+    policy.cacheName = Name( TXT( "Mesh" ) );
+    policy.compression = CacheCompressionPolicy::ECompression::ZLIB;
+    spSource->m_compressionPolicies.Push( policy );
+    policy.cacheName = Name( TXT( "Texture" ) );
+    policy.compression = CacheCompressionPolicy::ECompression::NONE;
+    spSource->m_compressionPolicies.Push( policy );
+
+    DynamicArray< uint8_t > entryData;
+    BuildCacheTestObjectEntry( spSource, spPackage->GetPath(), entryData );
+
+    // Load the same data under two names, one through each read path.
+    AssetPath readPath;
+    AssetPath mappedPath;
+    HELIUM_VERIFY( readPath.Set( TXT( "/MappedLoadTest:Read" ) ) );
+    HELIUM_VERIFY( mappedPath.Set( TXT( "/MappedLoadTest:Mapped" ) ) );
+    uint32_t entrySize = static_cast< uint32_t >( entryData.GetSize() );
+    ASSERT_TRUE( pCache->CacheEntry( readPath, 0, entryData.GetData(), 1, entrySize ) );
+    ASSERT_TRUE( pCache->CacheEntry( mappedPath, 0, entryData.GetData(), 1, entrySize ) );
+
+    CachePackageLoader readLoader;
+    ASSERT_TRUE( readLoader.Initialize( cacheName ) );
+    CachePackageLoader mappedLoader;
+    ASSERT_TRUE( mappedLoader.Initialize( cacheName, true ) );
+#if HELIUM_OS_LINUX
+    EXPECT_TRUE( pCache->IsCacheFileMapped() );
+#endif
+
+    // The mapping holds the same bytes as a buffered read of the entry.
+    const Cache::Entry* pMappedEntry = pCache->FindEntry( mappedPath, 0 );
+    ASSERT_TRUE( pMappedEntry != NULL );
+    const uint8_t* pMappedData = pCache->GetMappedEntryData( *pMappedEntry );
+    if( pCache->IsCacheFileMapped() )
+    {
+        ASSERT_TRUE( pMappedData != NULL );
+
+        DynamicArray< uint8_t > readData;
+        ASSERT_TRUE( pCache->ReadEntry( *pMappedEntry, readData ) );
+        ASSERT_EQ( entryData.GetSize(), readData.GetSize() );
+        EXPECT_EQ( 0, MemoryCompare( pMappedData, readData.GetData(), readData.GetSize() ) );
+    }
+
+    StrongPtr< CacheConfig > spRead( Reflect::SafeCast< CacheConfig >( LoadCacheTestObject( readLoader, readPath ) ) );
+    StrongPtr< CacheConfig > spMapped( Reflect::SafeCast< CacheConfig >( LoadCacheTestObject( mappedLoader, mappedPath ) ) );
+    ASSERT_TRUE( spRead );
+    ASSERT_TRUE( spMapped );
+    EXPECT_FALSE( spRead->GetAnyFlagSet( Asset::FLAG_BROKEN ) );
+    EXPECT_FALSE( spMapped->GetAnyFlagSet( Asset::FLAG_BROKEN ) );
+    EXPECT_EQ( spPackage.Get(), spMapped->GetOwner() );
+
+    EXPECT_TRUE( spSource->m_compressionPolicies == spRead->m_compressionPolicies );
+    EXPECT_TRUE( spRead->m_compressionPolicies == spMapped->m_compressionPolicies );
+
+    mappedLoader.Shutdown();
+    EXPECT_FALSE( pCache->IsCacheFileMapped() );
+    readLoader.Shutdown();
+
+    DeleteCacheTestFiles( pCache );
+}
+
+TEST(PcSupport, DerivedDataCache)
+{
+    FilePath cachePath;
+    HELIUM_VERIFY( FileLocations::GetUserDataDirectory( cachePath ) );
+    cachePath += TXT( "DerivedDataCacheTest/" );
+    String cacheDirectory( cachePath.c_str() );
+
+    // A zero budget evicts any entries left over from previous runs.
+    {
+        DerivedDataCache emptyCache( cacheDirectory, 0 );
+    }
+
+    uint8_t entryData[ 3 ][ 100 ];
+    for( size_t entryIndex = 0; entryIndex < 3; ++entryIndex )
+    {
+        MemorySet( entryData[ entryIndex ], static_cast< int >( entryIndex + 1 ), sizeof( entryData[ entryIndex ] ) );
+    }
+
+    DynamicArray< uint8_t > loadedData;
+
+    // Budget enough room for two entries plus their headers, but not three.
+    {
+        DerivedDataCache cache( cacheDirectory, 2 * ( sizeof( entryData[ 0 ] ) + 64 ) );
+
+        EXPECT_FALSE( cache.Load( 1, loadedData ) );
+        EXPECT_TRUE( cache.Store( 1, entryData[ 0 ], sizeof( entryData[ 0 ] ) ) );
+        EXPECT_TRUE( cache.Store( 2, entryData[ 1 ], sizeof( entryData[ 1 ] ) ) );
+
+        // Using the first entry makes the second one the least recently used, so it gets evicted by the third.
+        EXPECT_TRUE( cache.Load( 1, loadedData ) );
+        EXPECT_TRUE( cache.Store( 3, entryData[ 2 ], sizeof( entryData[ 2 ] ) ) );
+
+        EXPECT_FALSE( cache.Load( 2, loadedData ) );
+        EXPECT_TRUE( cache.Load( 3, loadedData ) );
+        ASSERT_EQ( sizeof( entryData[ 2 ] ), loadedData.GetSize() );
+        EXPECT_EQ( 0, MemoryCompare( entryData[ 2 ], loadedData.GetData(), sizeof( entryData[ 2 ] ) ) );
+
+        DerivedDataCache::Stats stats;
+        cache.GetStats( stats );
+        EXPECT_EQ( static_cast< size_t >( 2 ), stats.entryCount );
+        EXPECT_EQ( static_cast< uint32_t >( 1 ), stats.evictCount );
+    }
+
+    // Entries persist across cache instances.
+    {
+        DerivedDataCache cache( cacheDirectory, 2 * ( sizeof( entryData[ 0 ] ) + 64 ) );
+
+        EXPECT_TRUE( cache.Load( 1, loadedData ) );
+        ASSERT_EQ( sizeof( entryData[ 0 ] ), loadedData.GetSize() );
+        EXPECT_EQ( 0, MemoryCompare( entryData[ 0 ], loadedData.GetData(), sizeof( entryData[ 0 ] ) ) );
+    }
+
+    {
+        DerivedDataCache emptyCache( cacheDirectory, 0 );
+    }
+
+    // A recent temporary file may still be being written by another process, so scanning must leave it alone.
+    String tempFileName( cacheDirectory );
+    tempFileName += TXT( "0000000000000001.ddc.1.1.tmp" );
+
+    FileStream* pTempStream = FileStream::OpenFileStream( tempFileName, FileStream::MODE_WRITE, true );
+    ASSERT_TRUE( pTempStream != NULL );
+    EXPECT_EQ( sizeof( entryData[ 0 ] ), pTempStream->Write( entryData[ 0 ], 1, sizeof( entryData[ 0 ] ) ) );
+    delete pTempStream;
+
+    {
+        DerivedDataCache cache( cacheDirectory );
+    }
+
+    FilePath tempFilePath( *tempFileName );
+    EXPECT_TRUE( tempFilePath.Exists() );
+    tempFilePath.Delete();
+
+    // Keys depend on both the contents and the boundaries of the data added.
+    DerivedDataCache::KeyBuilder keyBuilderA;
+    keyBuilderA.Add( String( TXT( "ab" ) ) );
+    keyBuilderA.Add( String( TXT( "c" ) ) );
+
+    DerivedDataCache::KeyBuilder keyBuilderB;
+    keyBuilderB.Add( String( TXT( "a" ) ) );
+    keyBuilderB.Add( String( TXT( "bc" ) ) );
+
+    EXPECT_NE( keyBuilderA.GetKey(), keyBuilderB.GetKey() );
+}
+
+// Writes the given text to a cook record test input file, replacing any existing contents.
+static void WriteCookRecordTestInput( const String& rFileName, const char* pText )
+{
+    FileStream* pStream = FileStream::OpenFileStream( rFileName, FileStream::MODE_WRITE, true );
+    ASSERT_TRUE( pStream != NULL );
+
+    size_t textSize = StringLength( pText );
+    EXPECT_EQ( textSize, pStream->Write( pText, sizeof( char ), textSize ) );
+
+    delete pStream;
+}
+
+TEST(PcSupport, CookRecordTable)
+{
+    FilePath basePath;
+    HELIUM_VERIFY( FileLocations::GetUserDataDirectory( basePath ) );
+
+    String tableFileName( basePath.c_str() );
+    tableFileName += TXT( "CookRecordTest.dat" );
+    FilePath( *tableFileName ).Delete();
+
+    DynamicArray< String > inputFileNames;
+    inputFileNames.Push( String( basePath.c_str() ) );
+    inputFileNames[ 0 ] += TXT( "CookRecordTestInputA.txt" );
+    inputFileNames.Push( String( basePath.c_str() ) );
+    inputFileNames[ 1 ] += TXT( "CookRecordTestInputB.txt" );
+    WriteCookRecordTestInput( inputFileNames[ 0 ], TXT( "first input" ) );
+    WriteCookRecordTestInput( inputFileNames[ 1 ], TXT( "second input" ) );
+
+    AssetPath assetPath;
+    HELIUM_VERIFY( assetPath.Set( TXT( "/CookRecordTest:Asset" ) ) );
+
+    String reason;
+    {
+        CookRecordTable table( tableFileName );
+
+        EXPECT_FALSE( table.CheckRecord( assetPath, 1, inputFileNames, reason ) );
+        EXPECT_FALSE( reason.IsEmpty() );
+
+        EXPECT_TRUE( table.SetRecord( assetPath, 1, inputFileNames ) );
+        EXPECT_TRUE( table.CheckRecord( assetPath, 1, inputFileNames, reason ) );
+        EXPECT_TRUE( reason.IsEmpty() );
+
+        // Changing the handler version invalidates the record.
+        EXPECT_FALSE( table.CheckRecord( assetPath, 2, inputFileNames, reason ) );
+
+        // Rewriting an input with the same contents does not, but changing its contents does.
+        WriteCookRecordTestInput( inputFileNames[ 0 ], TXT( "first input" ) );
+        EXPECT_TRUE( table.CheckRecord( assetPath, 1, inputFileNames, reason ) );
+
+        WriteCookRecordTestInput( inputFileNames[ 0 ], TXT( "first input, changed" ) );
+        EXPECT_FALSE( table.CheckRecord( assetPath, 1, inputFileNames, reason ) );
+
+        EXPECT_TRUE( table.SetRecord( assetPath, 1, inputFileNames ) );
+        EXPECT_TRUE( table.Save() );
+    }
+
+    // Records persist across table instances.
+    {
+        CookRecordTable table( tableFileName );
+        EXPECT_EQ( static_cast< size_t >( 1 ), table.GetRecordCount() );
+        EXPECT_TRUE( table.CheckRecord( assetPath, 1, inputFileNames, reason ) );
+
+        CookRecordTable::Record record;
+        ASSERT_TRUE( table.GetRecord( assetPath, record ) );
+        EXPECT_EQ( static_cast< uint32_t >( 1 ), record.handlerVersion );
+        EXPECT_EQ( inputFileNames.GetSize(), record.inputs.GetSize() );
+
+        // An input that was not recorded makes the asset out of date.
+        DynamicArray< String > newInputFileNames( inputFileNames );
+        newInputFileNames.Push( String( basePath.c_str() ) );
+        newInputFileNames[ 2 ] += TXT( "CookRecordTestInputC.txt" );
+        EXPECT_FALSE( table.CheckRecord( assetPath, 1, newInputFileNames, reason ) );
+
+        table.RemoveRecord( assetPath );
+        EXPECT_FALSE( table.GetRecord( assetPath, record ) );
+        EXPECT_FALSE( table.CheckRecord( assetPath, 1, inputFileNames, reason ) );
+    }
+
+    // The asset preprocessor leaves the table on disk untouched in dry-run mode.
+    AssetPreprocessor* pAssetPreprocessor = AssetPreprocessor::GetStaticInstance();
+    ASSERT_TRUE( pAssetPreprocessor != NULL );
+
+    FilePath( *tableFileName ).Delete();
+
+    ASSERT_TRUE( pAssetPreprocessor->GetCookRecordTable() == NULL );
+
+    CookRecordTable* pTable = new CookRecordTable( tableFileName );
+    EXPECT_TRUE( pTable->SetRecord( assetPath, 1, inputFileNames ) );
+
+    bool bWasDryRun = pAssetPreprocessor->IsDryRun();
+    pAssetPreprocessor->SetDryRun( true );
+    pAssetPreprocessor->SetCookRecordTable( pTable );
+    pAssetPreprocessor->SetCookRecordTable( NULL );
+    pAssetPreprocessor->SetDryRun( bWasDryRun );
+
+    EXPECT_FALSE( FilePath( *tableFileName ).Exists() );
+
+    FilePath( *inputFileNames[ 0 ] ).Delete();
+    FilePath( *inputFileNames[ 1 ] ).Delete();
+}
+
+TEST(PcSupport, DeferredPreprocessingFlush)
+{
+    AssetPreprocessor* pAssetPreprocessor = AssetPreprocessor::GetStaticInstance();
+    ASSERT_TRUE( pAssetPreprocessor != NULL );
+
+    const char* const texturePathStrings[ 2 ][ 2 ] =
+    {
+        { TXT( "/Textures:Triangle.png" ), TXT( "/Textures:Helium.png" ) },
+        { TXT( "/Textures/ShapeShooter:Ship.png" ), TXT( "/Textures/ShapeShooter:Enemy.png" ) },
+    };
+
+    DynamicArray< AssetPtr > textures;
+
+    // Load the textures in two batches, flushing the queued resources after each one as the cook command does.
+    pAssetPreprocessor->BeginDeferredPreprocessing();
+
+    for( size_t batchIndex = 0; batchIndex < HELIUM_ARRAY_COUNT( texturePathStrings ); ++batchIndex )
+    {
+        size_t loadIds[ HELIUM_ARRAY_COUNT( texturePathStrings[ 0 ] ) ];
+        for( size_t textureIndex = 0; textureIndex < HELIUM_ARRAY_COUNT( loadIds ); ++textureIndex )
+        {
+            AssetPath texturePath;
+            HELIUM_VERIFY( texturePath.Set( texturePathStrings[ batchIndex ][ textureIndex ] ) );
+            loadIds[ textureIndex ] = gAssetLoader->BeginLoadObject( texturePath );
+            EXPECT_TRUE( IsValid( loadIds[ textureIndex ] ) );
+        }
+
+        for( size_t textureIndex = 0; textureIndex < HELIUM_ARRAY_COUNT( loadIds ); ++textureIndex )
+        {
+            AssetPtr spTexture;
+            if( IsValid( loadIds[ textureIndex ] ) )
+            {
+                gAssetLoader->FinishLoad( loadIds[ textureIndex ], spTexture );
+            }
+
+            EXPECT_TRUE( spTexture.Get() != NULL );
+            textures.Push( spTexture );
+        }
+
+        // Flushing preprocesses and caches everything queued so far on the worker pool, but keeps deferring.
+        EXPECT_TRUE( pAssetPreprocessor->FlushDeferredPreprocessing( 2 ) );
+        EXPECT_EQ( static_cast< size_t >( 0 ), pAssetPreprocessor->GetDeferredResourceCount() );
+        EXPECT_TRUE( pAssetPreprocessor->IsDeferringPreprocessing() );
+    }
+
+    EXPECT_TRUE( pAssetPreprocessor->EndDeferredPreprocessing( 2 ) );
+    EXPECT_FALSE( pAssetPreprocessor->IsDeferringPreprocessing() );
+
+    for( size_t textureIndex = 0; textureIndex < textures.GetSize(); ++textureIndex )
+    {
+        Asset* pTexture = textures[ textureIndex ];
+        if( pTexture )
+        {
+            EXPECT_FALSE( pTexture->GetAnyFlagSet( Asset::FLAG_BROKEN ) );
+        }
+    }
+}
+
+TEST(PcSupport, LooseAssetFileWatcherDebounce)
+{
+    LooseAssetFileWatcher watcher;
+
+    const uint64_t debounceTicks = LooseAssetFileWatcher::MillisecondsToTicks( LooseAssetFileWatcher::DEBOUNCE_MILLISECONDS );
+    ASSERT_GT( debounceTicks, static_cast< uint64_t >( 1 ) );
+
+    const uint64_t startTicks = 1000;
+    FilePath changedFile( TXT( "Data/WatcherTest/Changed.json" ) );
+    FilePath otherFile( TXT( "Data/WatcherTest/Other.json" ) );
+
+    // A burst of events for the same file coalesces into a single pending change.
+    watcher.QueueChange( NULL, changedFile, startTicks );
+    watcher.QueueChange( NULL, changedFile, startTicks + debounceTicks / 2 );
+    watcher.QueueChange( NULL, otherFile, startTicks + debounceTicks );
+    EXPECT_EQ( static_cast< size_t >( 2 ), watcher.GetPendingChangeCount() );
+
+    DynamicArray< LooseAssetFileWatcher::PendingChange > settledChanges;
+
+    // The debounce time restarts with each event, so the first event's deadline doesn't count.
+    watcher.TakeSettledChanges( startTicks + debounceTicks, settledChanges );
+    EXPECT_TRUE( settledChanges.IsEmpty() );
+
+    watcher.TakeSettledChanges( startTicks + debounceTicks / 2 + debounceTicks - 1, settledChanges );
+    EXPECT_TRUE( settledChanges.IsEmpty() );
+
+    // Once the last event for a file is old enough, the file settles on its own.
+    watcher.TakeSettledChanges( startTicks + debounceTicks / 2 + debounceTicks, settledChanges );
+    ASSERT_EQ( static_cast< size_t >( 1 ), settledChanges.GetSize() );
+    EXPECT_TRUE( settledChanges[ 0 ].m_Path == changedFile );
+    EXPECT_EQ( static_cast< size_t >( 1 ), watcher.GetPendingChangeCount() );
+
+    watcher.TakeSettledChanges( startTicks + 2 * debounceTicks, settledChanges );
+    ASSERT_EQ( static_cast< size_t >( 1 ), settledChanges.GetSize() );
+    EXPECT_TRUE( settledChanges[ 0 ].m_Path == otherFile );
+    EXPECT_EQ( static_cast< size_t >( 0 ), watcher.GetPendingChangeCount() );
+
+    // Settled changes are only handed out once.
+    watcher.TakeSettledChanges( startTicks + 10 * debounceTicks, settledChanges );
+    EXPECT_TRUE( settledChanges.IsEmpty() );
+}
+
+TEST(PcSupport, LooseAssetFileWatcherOverflowRescan)
+{
+    LooseAssetFileWatcher watcher;
+
+    const uint64_t pollTicks = LooseAssetFileWatcher::MillisecondsToTicks( LooseAssetFileWatcher::POLL_MILLISECONDS );
+    ASSERT_GT( pollTicks, static_cast< uint64_t >( 2 ) );
+
+    // The first check polls the packages that aren't being watched.
+    const uint64_t startTicks = pollTicks * 4;
+    bool bRescanAll = true;
+    EXPECT_TRUE( watcher.BeginScan( startTicks, bRescanAll ) );
+    EXPECT_FALSE( bRescanAll );
+
+    // Nothing is due until the poll time has passed again.
+    EXPECT_FALSE( watcher.BeginScan( startTicks + 1, bRescanAll ) );
+    EXPECT_FALSE( bRescanAll );
+
+    // Losing change events (an inotify queue overflow) forces a scan of every package right away.
+    watcher.RequestRescan();
+    EXPECT_TRUE( watcher.BeginScan( startTicks + 2, bRescanAll ) );
+    EXPECT_TRUE( bRescanAll );
+
+    // The request is consumed, and the rescan restarted the poll time.
+    EXPECT_FALSE( watcher.BeginScan( startTicks + 2 + pollTicks - 1, bRescanAll ) );
+    EXPECT_FALSE( bRescanAll );
+
+    EXPECT_TRUE( watcher.BeginScan( startTicks + 2 + pollTicks, bRescanAll ) );
+    EXPECT_FALSE( bRescanAll );
+}
+
+TEST(PcSupport, SidecarTypeStamp)
+{
+    const Reflect::MetaStruct* pTestAssetStruct = Reflect::GetMetaClass< TestAsset2 >();
+    const Reflect::MetaStruct* pPackageStruct = Reflect::GetMetaClass< Package >();
+
+    // The stamp only depends on the reflected layout, so it is the same every time it is computed.
+    uint64_t testAssetStamp = LoosePackageLoader::GetTypeStamp( pTestAssetStruct );
+    EXPECT_EQ( testAssetStamp, LoosePackageLoader::GetTypeStamp( pTestAssetStruct ) );
+
+    // Types with different fields, including a type and its base, get different stamps.
+    EXPECT_NE( testAssetStamp, LoosePackageLoader::GetTypeStamp( pPackageStruct ) );
+    EXPECT_NE( testAssetStamp, LoosePackageLoader::GetTypeStamp( pTestAssetStruct->m_Base ) );
+}
+
+TEST(PcSupport, SidecarCaptureAfterLink)
+{
+    AssetPath assetPath;
+    HELIUM_VERIFY( assetPath.Set( TXT( "/EngineTest/ChildPackage:TestObject2" ) ) );
+
+    size_t loadId = gAssetLoader->BeginLoadObject( assetPath );
+    ASSERT_TRUE( IsValid( loadId ) );
+
+    AssetPtr spAsset;
+    gAssetLoader->FinishLoad( loadId, spAsset );
+    ASSERT_TRUE( spAsset );
+
+    Package* pPackage = Reflect::SafeCast< Package >( spAsset->GetOwner() );
+    ASSERT_TRUE( pPackage != NULL );
+    LoosePackageLoader* pPackageLoader = static_cast< LoosePackageLoader* >( pPackage->GetLoader() );
+    ASSERT_TRUE( pPackageLoader != NULL );
+
+    // The binary form is captured as soon as the asset is linked.
+    EXPECT_TRUE( pPackageLoader->HasSidecarObjectData( assetPath.GetName() ) );
+
+    // A forced reload is read back from the sidecar, and must come back with its references in place.
+    size_t reloadId = gAssetLoader->BeginLoadObject( assetPath, true );
+    ASSERT_TRUE( IsValid( reloadId ) );
+
+    AssetPtr spReloaded;
+    gAssetLoader->FinishLoad( reloadId, spReloaded );
+    ASSERT_TRUE( spReloaded );
+    EXPECT_FALSE( spReloaded->GetAnyFlagSet( Asset::FLAG_BROKEN ) );
+
+    TestAsset2* pTestAsset2 = Reflect::SafeCast< TestAsset2 >( spReloaded.Get() );
+    ASSERT_TRUE( pTestAsset2 != NULL );
+    ASSERT_TRUE( pTestAsset2->m_TestReference );
+    EXPECT_EQ( 320.0f, pTestAsset2->m_TestReference->m_TestValue1 );
+}
+#endif  // HELIUM_TOOLS
+
+#endif
@@ -112,7 +112,19 @@ int main( int argc, const char* argv[] )
 		HELIUM_ASSERT( pPlatformPreprocessor );
 		pAssetPreprocessor->SetPlatformPreprocessor( Cache::PLATFORM_PC, pPlatformPreprocessor );
 #else
-		HELIUM_VERIFY( CacheAssetLoader::InitializeStaticInstance() );
+		// "-mapcache" loads objects straight from memory mapped cache files.
+		bool bMapCacheFiles = false;
+#if !HELIUM_OS_WIN
+		for( int argumentIndex = 1; argumentIndex < argc; ++argumentIndex )
+		{
+			if( String( argv[ argumentIndex ] ) == TXT( "-mapcache" ) )
+			{
+				bMapCacheFiles = true;
+			}
+		}
+#endif
+
+		HELIUM_VERIFY( CacheAssetLoader::InitializeStaticInstance( bMapCacheFiles ) );
 #endif
 
 #if !GTEST
@@ -133,6 +145,15 @@ int main( int argc, const char* argv[] )
 		ConfigPc::SaveUserConfig();
 #endif
 
+		{
+			StrongPtr< CacheConfig > spCacheConfig(
+				rConfig.GetConfigObject< CacheConfig >( Name( TXT( "CacheConfig" ) ) ) );
+			if( spCacheConfig )
+			{
+				spCacheConfig->ApplyCompressionPolicies();
+			}
+		}
+
 		uint32_t displayWidth;
 		uint32_t displayHeight;
 		//bool bFullscreen;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "TestApp/TestApp.h"
+#include "TestApp/TestAsset.h"
 
 #include "Platform/System.h"
 #include "Platform/Socket.h"
@@ -9,6 +10,7 @@
 #include "Engine/FileLocations.h"
 #include "Foundation/FilePath.h"
 #include "Foundation/FileStream.h"
+#include "Foundation/MemoryStream.h"
 #include "Engine/AsyncLoader.h"
 #include "Foundation/Map.h"
 #include "Foundation/SortedMap.h"
@@ -21,7 +23,16 @@
 #include "Math/Float16.h"
 #include "Engine/Asset.h"
 #include "Engine/Config.h"
+#include "Engine/Cache.h"
 #include "Engine/CacheManager.h"
+#include "Engine/CachePackageLoader.h"
+#include "Engine/Compression.h"
+#include "Engine/CacheConfig.h"
+#include "Engine/Fnv1aHasher.h"
+#include "Engine/LoadManifest.h"
+#include "Engine/LoadProfiler.h"
+#include "Engine/Resource.h"
+#include "Engine/StreamString.h"
 #include "EngineJobs/EngineJobsInterface.h"
 #include "PcSupport/ConfigPc.h"
 #include "Rendering/RRenderCommandProxy.h"
@@ -33,11 +44,20 @@
 #include "Graphics/GraphicsConfig.h"
 #include "Graphics/Material.h"
 #include "Graphics/RenderResourceManager.h"
+#include "Graphics/TextureStreamer.h"
 #include "GraphicsJobs/GraphicsJobs.h"
 #include "Framework/Slice.h"
 #include "Graphics/Mesh.h"
 #include "Framework/World.h"
 #include "Framework/WorldManager.h"
+#include "Components/SimulationLodComponent.h"
+#include "Ois/OisSystem.h"
+#include "Framework/EntityDefinition.h"
+#include "Components/TransformComponent.h"
+#include "Bullet/BulletWorldComponent.h"
+#include "Bullet/BulletBodyComponent.h"
+#include "Bullet/BulletShapes.h"
+#include "Bullet/BulletProjectileSystemComponent.h"
 
 #if HELIUM_DIRECT3D
 # include "RenderingD3D9/D3D9Renderer.h"
@@ -47,7 +67,11 @@
 
 #if HELIUM_TOOLS
 #include "PcSupport/AssetPreprocessor.h"
+#include "PcSupport/CookRecordTable.h"
+#include "PcSupport/DerivedDataCache.h"
+#include "PcSupport/LooseAssetFileWatcher.h"
 #include "PcSupport/LooseAssetLoader.h"
+#include "PcSupport/LoosePackageLoader.h"
 #include "EditorSupport/FontResourceHandler.h"
 #include "PreprocessingPc/PcPreprocessor.h"
 #endif
@@ -262,6 +262,7 @@ project( prefix .. "Editor" )
 		"bullet",
 		"mongo-c",
 		"ois",
+		"zlib",
 	}
 
 	configuration "linux"